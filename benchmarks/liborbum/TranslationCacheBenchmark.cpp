@@ -0,0 +1,187 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <Caches.hpp>
+
+#include "Common/Types/Mips/MmuAccess.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/TranslationCache/TranslationCache.hpp"
+
+/// Compares the page indexed TranslationCache (software TLB) against the
+/// small associative caches in Caches.hpp, which the EE and IOP cores used
+/// previously (6 entry TimestampLruCache per context).
+/// Each cache is run over the same virtual address streams, with a fallback
+/// that searches a 48 entry TLB like the EE Core does.
+/// ClockCache is not included, it never marks its slots as used on insert.
+/// OrderedLruCache drops an entry on hits away from the front (see its get()),
+/// so it misses even on working sets it should hold.
+
+namespace
+{
+constexpr int NUMBER_CONTEXTS = 4;
+constexpr uptr PAGE_MASK = 0xFFF;
+constexpr size_t NUMBER_LOOKUPS = 5000000;
+
+/// Previous translation cache front end: a Caches.hpp policy per context,
+/// with the fallback set as a std::function.
+template <int Size, template <int, typename, typename> class CacheTy>
+class PolicyTranslationCache
+{
+public:
+    using FallbackFn = std::function<std::optional<uptr>(const uptr, const MmuRwAccess)>;
+
+    explicit PolicyTranslationCache(const FallbackFn& fallback_fn) :
+        fallback_fn(fallback_fn)
+    {
+    }
+
+    std::optional<uptr> lookup(const uptr virtual_address, const MmuRwAccess rw_access, const int context)
+    {
+        const uptr key = virtual_address & ~PAGE_MASK;
+        auto& cache = caches[context];
+        std::optional<uptr> result = cache.get(key);
+        if (!result)
+        {
+            result = fallback_fn(key, rw_access);
+            if (result)
+                cache.insert(key, *result);
+        }
+        if (result)
+            *result = *result | (virtual_address & PAGE_MASK);
+        return result;
+    }
+
+private:
+    FallbackFn fallback_fn;
+    std::array<CacheTy<Size, uptr, uptr>, NUMBER_CONTEXTS> caches;
+};
+
+/// Stand in for the full translation: searches 48 TLB entries for the page,
+/// then maps it to physical memory.
+struct Tlb
+{
+    std::array<uptr, 48> virtual_pages;
+    mutable size_t number_lookups = 0;
+
+    Tlb()
+    {
+        for (size_t i = 0; i < virtual_pages.size(); i++)
+            virtual_pages[i] = 0x70000000 + (i << 12);
+    }
+
+    std::optional<uptr> operator()(const uptr virtual_address, const MmuRwAccess) const
+    {
+        number_lookups++;
+        const uptr page = virtual_address & ~PAGE_MASK;
+        for (size_t i = 0; i < virtual_pages.size(); i++)
+        {
+            if (virtual_pages[i] == page)
+                return std::make_optional((i << 12) | (virtual_address & PAGE_MASK));
+        }
+        return std::make_optional(virtual_address & 0x1FFFFFFF);
+    }
+};
+
+/// Virtual address stream, with a read/write mix of 3:1.
+struct Access
+{
+    uptr address;
+    MmuRwAccess rw_access;
+};
+
+udword random_state = 0x2545F4914F6CDD1D;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Accesses spread over the given number of pages starting at base, walking
+/// through each page in word steps (a loop over a few arrays).
+std::vector<Access> make_stream(const uptr base, const size_t number_pages, const bool random_pages)
+{
+    std::vector<Access> stream(1 << 16);
+    size_t page = 0;
+    uptr offset = 0;
+    for (auto& access : stream)
+    {
+        page = random_pages ? (random() % number_pages) : ((page + 1) % number_pages);
+        offset = (offset + 4) & PAGE_MASK;
+        access.address = base + uptr(page << 12) + offset;
+        access.rw_access = (random() & 3) ? READ : WRITE;
+    }
+    return stream;
+}
+
+template <typename LookupFn>
+void run(const char* name, const std::vector<Access>& stream, const Tlb& tlb, LookupFn&& lookup)
+{
+    tlb.number_lookups = 0;
+    uptr checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUMBER_LOOKUPS; i++)
+    {
+        const Access& access = stream[i & (stream.size() - 1)];
+        checksum += *lookup(access.address, access.rw_access);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("  %-22s %7.2f ns/lookup  %6.2f%% misses  (checksum %08X)\n",
+                name, ns / NUMBER_LOOKUPS, 100.0 * tlb.number_lookups / NUMBER_LOOKUPS, checksum);
+}
+
+void run_all(const char* workload, const std::vector<Access>& stream)
+{
+    std::printf("%s:\n", workload);
+
+    const Tlb tlb;
+    const auto fallback = [&tlb](const uptr address, const MmuRwAccess rw_access) { return tlb(address, rw_access); };
+
+    {
+        TranslationCache<NUMBER_CONTEXTS> cache;
+        run("TranslationCache", stream, tlb, [&](const uptr address, const MmuRwAccess rw_access) {
+            return cache.lookup(address, rw_access, 0, fallback);
+        });
+    }
+    {
+        PolicyTranslationCache<6, TimestampLruCache> cache(fallback);
+        run("TimestampLruCache<6>", stream, tlb, [&](const uptr address, const MmuRwAccess rw_access) {
+            return cache.lookup(address, rw_access, 0);
+        });
+    }
+    {
+        PolicyTranslationCache<6, CounterLfuCache> cache(fallback);
+        run("CounterLfuCache<6>", stream, tlb, [&](const uptr address, const MmuRwAccess rw_access) {
+            return cache.lookup(address, rw_access, 0);
+        });
+    }
+    {
+        PolicyTranslationCache<6, OrderedLruCache> cache(fallback);
+        run("OrderedLruCache<6>", stream, tlb, [&](const uptr address, const MmuRwAccess rw_access) {
+            return cache.lookup(address, rw_access, 0);
+        });
+    }
+    {
+        PolicyTranslationCache<64, HashedLruCache> cache(fallback);
+        run("HashedLruCache<64>", stream, tlb, [&](const uptr address, const MmuRwAccess rw_access) {
+            return cache.lookup(address, rw_access, 0);
+        });
+    }
+}
+} // namespace
+
+int main()
+{
+    run_all("2 pages, sequential (tight loop)", make_stream(0x00100000, 2, false));
+    run_all("6 pages, sequential (fits the small caches)", make_stream(0x00100000, 6, false));
+    run_all("16 pages, sequential (code + stack + data)", make_stream(0x00100000, 16, false));
+    run_all("256 pages, random (1 MB working set)", make_stream(0x70000000, 256, true));
+    return 0;
+}
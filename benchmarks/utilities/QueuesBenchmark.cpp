@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Parking.hpp>
+#include <Queues.hpp>
+
+/// Compares the lock-free queue shapes (MpscQueue, SpmcQueue, SpscQueue)
+/// against the mutex based MpmcQueue they replaced, and the Parking::Event
+/// wait/notify against a mutex + condition variable.
+
+namespace
+{
+constexpr size_t QUEUE_CAPACITY = 128;
+constexpr size_t NUMBER_ITEMS = 1000000;
+constexpr size_t NUMBER_ROUND_TRIPS = 100000;
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Push then pop on the same thread: the uncontended cost of a queue operation pair.
+template <typename QueueTy>
+double run_uncontended()
+{
+    QueueTy queue;
+    size_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUMBER_ITEMS; i++)
+    {
+        size_t item;
+        queue.push(i);
+        queue.pop(item);
+        sum += item;
+    }
+    const double ns = elapsed_ns(start);
+    return (sum == 1) ? 0.0 : ns / NUMBER_ITEMS;
+}
+
+/// Items pushed by each producer thread and popped by each consumer thread,
+/// with blocking push/pop. Returns ns per item.
+template <typename QueueTy>
+double run_threaded(const size_t number_producers, const size_t number_consumers)
+{
+    QueueTy queue;
+    std::atomic<size_t> sum(0);
+    std::vector<std::thread> threads;
+
+    const size_t items_per_producer = NUMBER_ITEMS / number_producers;
+    const size_t items_per_consumer = (items_per_producer * number_producers) / number_consumers;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < number_producers; p++)
+    {
+        threads.emplace_back([&queue, items_per_producer] {
+            for (size_t i = 0; i < items_per_producer; i++)
+                queue.push(i);
+        });
+    }
+    for (size_t c = 0; c < number_consumers; c++)
+    {
+        threads.emplace_back([&queue, &sum, items_per_consumer] {
+            size_t local_sum = 0;
+            for (size_t i = 0; i < items_per_consumer; i++)
+            {
+                size_t item;
+                queue.pop(item);
+                local_sum += item;
+            }
+            sum.fetch_add(local_sum);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const double ns = elapsed_ns(start);
+    return (sum.load() == 1) ? 0.0 : ns / (items_per_producer * number_producers);
+}
+
+/// Two threads handing a token back and forth, parking with Parking::Event.
+double run_event_ping_pong()
+{
+    std::atomic<size_t> turn(0);
+    Parking::Event events[2];
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread other([&] {
+        for (size_t i = 0; i < NUMBER_ROUND_TRIPS; i++)
+        {
+            events[1].wait_until([&] { return turn.load(std::memory_order_acquire) == 2 * i + 1; });
+            turn.store(2 * i + 2, std::memory_order_release);
+            events[0].notify();
+        }
+    });
+    for (size_t i = 0; i < NUMBER_ROUND_TRIPS; i++)
+    {
+        turn.store(2 * i + 1, std::memory_order_release);
+        events[1].notify();
+        events[0].wait_until([&] { return turn.load(std::memory_order_acquire) == 2 * i + 2; });
+    }
+    other.join();
+
+    return elapsed_ns(start) / NUMBER_ROUND_TRIPS;
+}
+
+/// As above, with a mutex and condition variable.
+double run_condition_variable_ping_pong()
+{
+    size_t turn = 0;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread other([&] {
+        for (size_t i = 0; i < NUMBER_ROUND_TRIPS; i++)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return turn == 2 * i + 1; });
+            turn = 2 * i + 2;
+            condition.notify_all();
+        }
+    });
+    for (size_t i = 0; i < NUMBER_ROUND_TRIPS; i++)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        turn = 2 * i + 1;
+        condition.notify_all();
+        condition.wait(lock, [&] { return turn == 2 * i + 2; });
+    }
+    other.join();
+
+    return elapsed_ns(start) / NUMBER_ROUND_TRIPS;
+}
+} // namespace
+
+int main()
+{
+    using LockingQueue = MpmcQueue<size_t, QUEUE_CAPACITY>;
+
+    std::printf("%u hardware threads, %zu items, ns/item:\n", std::thread::hardware_concurrency(), NUMBER_ITEMS);
+    std::printf("  %-24s %12s %12s\n", "", "lock-free", "MpmcQueue");
+    std::printf("  %-24s %12.1f %12.1f\n", "SPSC uncontended", run_uncontended<SpscQueue<size_t, QUEUE_CAPACITY>>(), run_uncontended<LockingQueue>());
+    std::printf("  %-24s %12.1f %12.1f\n", "MPSC uncontended", run_uncontended<MpscQueue<size_t, QUEUE_CAPACITY>>(), run_uncontended<LockingQueue>());
+    std::printf("  %-24s %12.1f %12.1f\n", "SPSC 1:1", run_threaded<SpscQueue<size_t, QUEUE_CAPACITY>>(1, 1), run_threaded<LockingQueue>(1, 1));
+    std::printf("  %-24s %12.1f %12.1f\n", "MPSC 3:1", run_threaded<MpscQueue<size_t, QUEUE_CAPACITY>>(3, 1), run_threaded<LockingQueue>(3, 1));
+    std::printf("  %-24s %12.1f %12.1f\n", "SPMC 1:2", run_threaded<SpmcQueue<size_t, QUEUE_CAPACITY>>(1, 2), run_threaded<LockingQueue>(1, 2));
+
+    std::printf("%zu round trips, ns/round trip:\n", NUMBER_ROUND_TRIPS);
+    std::printf("  %-24s %12.1f\n", "Parking::Event", run_event_ping_pong());
+    std::printf("  %-24s %12.1f\n", "condition_variable", run_condition_variable_ping_pong());
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+#include <TaskExecutor.hpp>
+#include <WorkStealingTaskExecutor.hpp>
+
+/// Compares the per-run synchronisation cost of TaskExecutor and
+/// WorkStealingTaskExecutor: a run enqueues a batch of tasks, dispatches them
+/// and waits for idle, as Core::run does once per time slice.
+/// Tasks either do nothing (sync overhead only) or spin for a fixed amount of
+/// work (a controller running a short time slice).
+
+namespace
+{
+constexpr size_t NUMBER_RUNS = 20000;
+
+std::atomic<size_t> checksum(0);
+
+/// Spins for roughly the number of iterations given.
+void do_work(const size_t iterations)
+{
+    size_t value = 0;
+    for (size_t i = 0; i < iterations; i++)
+        value = value * 31 + i;
+    checksum.fetch_add(value, std::memory_order_relaxed);
+}
+
+template <typename ExecutorTy>
+double run(ExecutorTy& executor, const size_t number_tasks, const size_t work)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t run = 0; run < NUMBER_RUNS; run++)
+    {
+        for (size_t i = 0; i < number_tasks; i++)
+            executor.enqueue_task([work] { do_work(work); });
+        executor.dispatch();
+        executor.wait_for_idle();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / NUMBER_RUNS;
+}
+} // namespace
+
+int main()
+{
+    std::printf("%u hardware threads, %zu runs each, us/run:\n", std::thread::hardware_concurrency(), NUMBER_RUNS);
+    std::printf("  %-8s %-6s %-6s %14s %14s\n", "workers", "tasks", "work", "TaskExecutor", "WorkStealing");
+
+    for (const size_t number_workers : {1, 2, 4})
+    {
+        for (const size_t number_tasks : {4, 17, 64})
+        {
+            for (const size_t work : {0, 1000})
+            {
+                double default_us;
+                double work_stealing_us;
+                {
+                    TaskExecutor executor(number_workers);
+                    default_us = run(executor, number_tasks, work);
+                }
+                {
+                    WorkStealingTaskExecutor executor(number_workers);
+                    work_stealing_us = run(executor, number_tasks, work);
+                }
+                std::printf("  %-8zu %-6zu %-6zu %14.2f %14.2f\n", number_workers, number_tasks, work, default_us, work_stealing_us);
+            }
+        }
+    }
+
+    return (checksum.load() == 1) ? 1 : 0;
+}
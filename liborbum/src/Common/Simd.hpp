@@ -0,0 +1,12 @@
+#pragma once
+
+/// Host SIMD support for the kernels which have an SSE2 version and an
+/// equivalent scalar version (ie: EeCoreMmi, VuVector, VifUnpack, GsSwizzle).
+/// SSE2 is the x86-64 baseline, so it is detected at compile time and no
+/// runtime dispatch is needed.
+/// Defining SIMD_SCALAR before the first include selects the scalar versions
+/// on SSE2 hosts too (the tests check both versions against each other).
+#if !defined(SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SIMD_SSE2
+#include <emmintrin.h>
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Tracks writes made through a ByteBus on a per-page basis, used by
+/// emulator caches that derive state from memory contents (eg: the EE Core
+/// block cache) to cheaply check if their cached state is still valid.
+/// Each page holds a generation counter, which is bumped on a write only if
+/// the page is currently being watched - unwatched pages cost a single
+/// relaxed load per write. Thread safe, as writes can come from any
+/// controller (eg: the DMAC writing to main memory).
+/// Entry format: [generation (31 bits) | watched (1 bit)].
+class BusWriteTracker
+{
+public:
+    static constexpr int PAGE_BITS = 12; // 4KB pages.
+    static constexpr usize PAGE_SIZE = static_cast<usize>(1) << PAGE_BITS;
+
+    /// Tracks the address range [0, tracked_size). Writes outside of this
+    /// range are ignored.
+    BusWriteTracker(const usize tracked_size) :
+        number_pages(tracked_size >> PAGE_BITS),
+        pages(new std::atomic<uword>[tracked_size >> PAGE_BITS]())
+    {
+    }
+
+    /// Returns if the address is within the tracked range.
+    bool is_tracked(const usize address) const
+    {
+        return (address >> PAGE_BITS) < number_pages;
+    }
+
+    /// Notifies the tracker that a write occured at the given address.
+    void notify_write(const usize address)
+    {
+        const usize page_index = address >> PAGE_BITS;
+        if (page_index >= number_pages)
+            return;
+
+        // Adding 1 to a watched entry clears the watched bit and carries
+        // into the generation.
+        auto& page = pages[page_index];
+        if (page.load(std::memory_order_relaxed) & 1)
+            page.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Marks the page containing the address as watched and returns the
+    /// current generation. This must be done before the memory contents are
+    /// read, so that any concurrent write will invalidate the result.
+    uword watch(const usize address)
+    {
+        return pages[address >> PAGE_BITS].fetch_or(1, std::memory_order_acquire) >> 1;
+    }
+
+    /// Returns the current generation of the page containing the address.
+    uword generation(const usize address) const
+    {
+        return pages[address >> PAGE_BITS].load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    usize number_pages;
+    std::unique_ptr<std::atomic<uword>[]> pages;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
 #include <vector>
@@ -9,7 +11,9 @@
 
 #include "Common/Types/Bitfield.hpp"
 #include "Common/Types/Bus/BusContext.hpp"
+#include "Common/Types/Bus/BusWriteTracker.hpp"
 #include "Common/Types/Bus/ByteBusMappable.hpp"
+#include "Common/Types/Bus/FastmemArena.hpp"
 #include "Common/Types/Primitive.hpp"
 #include "Utilities/Utilities.hpp"
 
@@ -21,6 +25,12 @@
 /// It is byte-addressable, and can map the full range of the address type used.
 /// The mapping method is actually just a 2 level (directory and pages) page table!
 /// The page size is variable per directory, allowing for minimal memory usage.
+/// Objects that are plain host memory (see ByteBusMappable::byte_bus_host_memory())
+/// are accessed directly through the page's host pointer, skipping the virtual
+/// call - only MMIO registers, FIFOs, etc go through the object's methods.
+/// Write tracking can optionally be enabled, see BusWriteTracker.
+/// Fastmem can optionally be enabled, where shareable host memory is accessed
+/// through a FastmemArena instead of the page table, see enable_fastmem().
 template <typename AddressTy>
 class ByteBus
 {
@@ -29,6 +39,13 @@ public:
     {
         AddressTy base_address;
         ByteBusMappable* object;
+
+        /// Direct host memory of the object (at the base address), or nullptr
+        /// if all accesses must go through the object.
+        ubyte* host_memory;
+
+        /// Writes must go through the object if set (ie: ROMs).
+        bool host_read_only;
     };
 
     struct Directory
@@ -40,6 +57,11 @@ public:
 
     ByteBus(const int directory_mask_length) :
         directory_mask(Bitfield(size_bits<AddressTy>() - directory_mask_length, directory_mask_length)) // Directory mask always occupies most upper bits.
+#if defined(BUILD_DEBUG)
+        ,
+        fast_path_accesses(0),
+        slow_path_accesses(0)
+#endif
     {
         // Initialise directories, number of directories is fixed.
         // Initially we assume a page size of 1 byte (ie: 0 page index bits),
@@ -105,6 +127,8 @@ public:
 
                 page.base_address = address;
                 page.object = object;
+                page.host_memory = object->byte_bus_host_memory();
+                page.host_read_only = object->byte_bus_host_read_only();
                 page_index++;
 
                 map_size += page_size;
@@ -151,20 +175,266 @@ public:
 
     /// Read or write to a mapped object.
     ubyte read_ubyte(const BusContext context, const AddressTy address) const
+    {
+        ubyte value;
+        if (fastmem && FastmemArena::load(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return value;
+        }
+
+        return read_ubyte_page(context, address);
+    }
+
+    void write_ubyte(const BusContext context, const AddressTy address, const ubyte value) const
+    {
+        notify_write(address);
+
+        if (fastmem && FastmemArena::store(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return;
+        }
+
+        write_ubyte_page(context, address, value);
+    }
+
+    uhword read_uhword(const BusContext context, const AddressTy address) const
+    {
+        uhword value;
+        if (fastmem && FastmemArena::load(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return value;
+        }
+
+        return read_uhword_page(context, address);
+    }
+
+    void write_uhword(const BusContext context, const AddressTy address, const uhword value) const
+    {
+        notify_write(address);
+
+        if (fastmem && FastmemArena::store(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return;
+        }
+
+        write_uhword_page(context, address, value);
+    }
+
+    uword read_uword(const BusContext context, const AddressTy address) const
+    {
+        uword value;
+        if (fastmem && FastmemArena::load(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return value;
+        }
+
+        return read_uword_page(context, address);
+    }
+
+    void write_uword(const BusContext context, const AddressTy address, const uword value) const
+    {
+        notify_write(address);
+
+        if (fastmem && FastmemArena::store(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return;
+        }
+
+        write_uword_page(context, address, value);
+    }
+
+    udword read_udword(const BusContext context, const AddressTy address) const
+    {
+        udword value;
+        if (fastmem && FastmemArena::load(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return value;
+        }
+
+        return read_udword_page(context, address);
+    }
+
+    void write_udword(const BusContext context, const AddressTy address, const udword value) const
+    {
+        notify_write(address);
+
+        if (fastmem && FastmemArena::store(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return;
+        }
+
+        write_udword_page(context, address, value);
+    }
+
+    uqword read_uqword(const BusContext context, const AddressTy address) const
+    {
+        uqword value;
+        if (fastmem && FastmemArena::load(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return value;
+        }
+
+        return read_uqword_page(context, address);
+    }
+
+    void write_uqword(const BusContext context, const AddressTy address, const uqword value) const
+    {
+        notify_write(address);
+
+        if (fastmem && FastmemArena::store(get_fastmem_pointer(address), value))
+        {
+            count_access(true);
+            return;
+        }
+
+        write_uqword_page(context, address, value);
+    }
+
+    /// Enables write tracking over the address range [0, tracked_size).
+    /// See BusWriteTracker for details.
+    void enable_write_tracking(const usize tracked_size)
+    {
+        write_tracker = std::make_unique<BusWriteTracker>(tracked_size);
+    }
+
+    /// Returns the write tracker, or nullptr if tracking is not enabled.
+    BusWriteTracker* get_write_tracker() const
+    {
+        return write_tracker.get();
+    }
+
+    /// Enables fastmem, where the shareable host memory objects currently mapped
+    /// (see ByteBusMappable::byte_bus_host_memory_fd()) are mapped into a
+    /// FastmemArena at their bus addresses, including any mirrors. Must be
+    /// called after all objects have been mapped. Objects that can't be mapped
+    /// (ie: smaller than the host page size) continue to use the page table.
+    /// Returns false if fastmem is not supported on this host.
+    bool enable_fastmem()
+    {
+        fastmem = std::make_unique<FastmemArena>(static_cast<size_t>(1) << size_bits<AddressTy>());
+        if (!fastmem->is_valid())
+        {
+            fastmem.reset();
+            return false;
+        }
+
+        // Each page of a mapping shares the same base address - only map once.
+        for (size_t vdn = 0; vdn < table.size(); vdn++)
+        {
+            const auto& directory = table[vdn];
+            for (size_t page_index = 0; page_index < directory.page_table.size(); page_index++)
+            {
+                const auto& page = directory.page_table[page_index];
+                if (!page.host_memory)
+                    continue;
+
+                const AddressTy address = static_cast<AddressTy>((vdn << directory_mask.start) | (page_index << directory.page_mask.start));
+                if (address != page.base_address)
+                    continue;
+
+                const int fd = page.object->byte_bus_host_memory_fd();
+                if (fd == -1)
+                    continue;
+
+                fastmem->map(page.base_address, fd, page.object->byte_bus_map_size(), page.host_read_only);
+            }
+        }
+
+        return true;
+    }
+
+    /// Returns if fastmem is enabled, see enable_fastmem().
+    bool is_fastmem_enabled() const
+    {
+        return fastmem != nullptr;
+    }
+
+#if defined(BUILD_DEBUG)
+    /// Returns the number of accesses that were performed directly on host
+    /// memory (fast path) or through the mapped object (slow path).
+    size_t get_fast_path_accesses() const
+    {
+        return fast_path_accesses.load(std::memory_order_relaxed);
+    }
+
+    size_t get_slow_path_accesses() const
+    {
+        return slow_path_accesses.load(std::memory_order_relaxed);
+    }
+#endif
+
+    /// Culls the page table to reduce memory footprint.
+    /// Achieves this by resizing all page tables to use the optimal alignment.
+    void optimise()
+    {
+        // Make the page table within each directory have a page size
+        // as coarse as possible (page size becomes optimal alignment).
+        for (auto& directory : table)
+        {
+            if (directory.page_mask.start != directory.optimal_alignment)
+            {
+                const Bitfield optimal_page_mask = Bitfield(directory.optimal_alignment, size_bits<AddressTy>() - directory_mask.length - directory.optimal_alignment);
+                auto optimal_page_table = std::vector<Page>(static_cast<size_t>(1) << optimal_page_mask.length);
+
+                const size_t index_offset = static_cast<size_t>(1) << directory.optimal_alignment;
+                for (size_t index = 0; index < directory.page_table.size(); index += index_offset)
+                    optimal_page_table[index / index_offset] = directory.page_table[index];
+
+                directory.page_table.swap(optimal_page_table);
+                directory.page_mask = optimal_page_mask;
+            }
+        }
+    }
+
+private:
+    /// Returns the VDN (virtual directory number) for the address
+    /// given using this Bus' context.
+    size_t get_vdn(const AddressTy address) const
+    {
+        return directory_mask.extract_from(address);
+    }
+
+    /// Performs the access through the page table (ie: when fastmem is not
+    /// enabled or not applicable). Write notifications are made by the caller.
+    ubyte read_ubyte_page(const BusContext context, const AddressTy address) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
+        if (page.host_memory)
+        {
+            count_access(true);
+            return *reinterpret_cast<const ubyte*>(page.host_memory + offset);
+        }
+
+        count_access(false);
         return page.object->byte_bus_read_ubyte(context, offset);
     }
 
-    void write_ubyte(const BusContext context, const AddressTy address, const ubyte value) const
+    void write_ubyte_page(const BusContext context, const AddressTy address, const ubyte value) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
+        if (page.host_memory && !page.host_read_only)
+        {
+            count_access(true);
+            *reinterpret_cast<ubyte*>(page.host_memory + offset) = value;
+            return;
+        }
+
+        count_access(false);
         page.object->byte_bus_write_ubyte(context, offset, value);
     }
 
-    uhword read_uhword(const BusContext context, const AddressTy address) const
+    uhword read_uhword_page(const BusContext context, const AddressTy address) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -174,10 +444,17 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+        {
+            count_access(true);
+            return *reinterpret_cast<const uhword*>(page.host_memory + offset);
+        }
+
+        count_access(false);
         return page.object->byte_bus_read_uhword(context, offset);
     }
 
-    void write_uhword(const BusContext context, const AddressTy address, const uhword value) const
+    void write_uhword_page(const BusContext context, const AddressTy address, const uhword value) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -187,10 +464,18 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory && !page.host_read_only)
+        {
+            count_access(true);
+            *reinterpret_cast<uhword*>(page.host_memory + offset) = value;
+            return;
+        }
+
+        count_access(false);
         page.object->byte_bus_write_uhword(context, offset, value);
     }
 
-    uword read_uword(const BusContext context, const AddressTy address) const
+    uword read_uword_page(const BusContext context, const AddressTy address) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -200,10 +485,17 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+        {
+            count_access(true);
+            return *reinterpret_cast<const uword*>(page.host_memory + offset);
+        }
+
+        count_access(false);
         return page.object->byte_bus_read_uword(context, offset);
     }
 
-    void write_uword(const BusContext context, const AddressTy address, const uword value) const
+    void write_uword_page(const BusContext context, const AddressTy address, const uword value) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -213,10 +505,18 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory && !page.host_read_only)
+        {
+            count_access(true);
+            *reinterpret_cast<uword*>(page.host_memory + offset) = value;
+            return;
+        }
+
+        count_access(false);
         page.object->byte_bus_write_uword(context, offset, value);
     }
 
-    udword read_udword(const BusContext context, const AddressTy address) const
+    udword read_udword_page(const BusContext context, const AddressTy address) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -226,10 +526,17 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+        {
+            count_access(true);
+            return *reinterpret_cast<const udword*>(page.host_memory + offset);
+        }
+
+        count_access(false);
         return page.object->byte_bus_read_udword(context, offset);
     }
 
-    void write_udword(const BusContext context, const AddressTy address, const udword value) const
+    void write_udword_page(const BusContext context, const AddressTy address, const udword value) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -239,10 +546,18 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory && !page.host_read_only)
+        {
+            count_access(true);
+            *reinterpret_cast<udword*>(page.host_memory + offset) = value;
+            return;
+        }
+
+        count_access(false);
         page.object->byte_bus_write_udword(context, offset, value);
     }
 
-    uqword read_uqword(const BusContext context, const AddressTy address) const
+    uqword read_uqword_page(const BusContext context, const AddressTy address) const
     {
         auto& page = get_page(address);
         usize offset = address - page.base_address;
@@ -252,12 +567,19 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+        {
+            count_access(true);
+            return *reinterpret_cast<const uqword*>(page.host_memory + offset);
+        }
+
+        count_access(false);
         return page.object->byte_bus_read_uqword(context, offset);
     }
 
-    void write_uqword(const BusContext context, const AddressTy address, const uqword value) const
+    void write_uqword_page(const BusContext context, const AddressTy address, const uqword value) const
     {
-        const auto& page = get_page(address);
+        auto& page = get_page(address);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -265,38 +587,42 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory && !page.host_read_only)
+        {
+            count_access(true);
+            *reinterpret_cast<uqword*>(page.host_memory + offset) = value;
+            return;
+        }
+
+        count_access(false);
         page.object->byte_bus_write_uqword(context, offset, value);
     }
 
-    /// Culls the page table to reduce memory footprint.
-    /// Achieves this by resizing all page tables to use the optimal alignment.
-    void optimise()
+    /// Returns the host address of the address in the fastmem arena.
+    /// The arena covers the whole address space, so the mask only zero extends
+    /// the address.
+    ubyte* get_fastmem_pointer(const AddressTy address) const
     {
-        // Make the page table within each directory have a page size
-        // as coarse as possible (page size becomes optimal alignment).
-        for (auto& directory : table)
-        {
-            if (directory.page_mask.start != directory.optimal_alignment)
-            {
-                const Bitfield optimal_page_mask = Bitfield(directory.optimal_alignment, size_bits<AddressTy>() - directory_mask.length - directory.optimal_alignment);
-                auto optimal_page_table = std::vector<Page>(static_cast<size_t>(1) << optimal_page_mask.length);
-
-                const size_t index_offset = static_cast<size_t>(1) << directory.optimal_alignment;
-                for (size_t index = 0; index < directory.page_table.size(); index += index_offset)
-                    optimal_page_table[index / index_offset] = directory.page_table[index];
+        return fastmem->get_base() + (static_cast<size_t>(address) & fastmem->get_mask());
+    }
 
-                directory.page_table.swap(optimal_page_table);
-                directory.page_mask = optimal_page_mask;
-            }
-        }
+    /// Updates the fast/slow path access statistics (debug builds only).
+    /// Fastmem accesses that fault are counted by the page table path.
+    void count_access(const bool fast_path) const
+    {
+#if defined(BUILD_DEBUG)
+        if (fast_path)
+            fast_path_accesses.fetch_add(1, std::memory_order_relaxed);
+        else
+            slow_path_accesses.fetch_add(1, std::memory_order_relaxed);
+#endif
     }
 
-private:
-    /// Returns the VDN (virtual directory number) for the address
-    /// given using this Bus' context.
-    size_t get_vdn(const AddressTy address) const
+    /// Forwards a write notification to the write tracker if enabled.
+    void notify_write(const AddressTy address) const
     {
-        return directory_mask.extract_from(address);
+        if (write_tracker)
+            write_tracker->notify_write(static_cast<usize>(address));
     }
 
     /// Constant directory mask (set at construction). This can't change
@@ -310,4 +636,16 @@ private:
     /// Call cull_memory() after all mappings have been made to increase
     /// this page size to the optimal value.
     std::vector<Directory> table;
+
+    /// Optional write tracker, see enable_write_tracking().
+    std::unique_ptr<BusWriteTracker> write_tracker;
+
+    /// Optional fastmem arena, see enable_fastmem().
+    std::unique_ptr<FastmemArena> fastmem;
+
+#if defined(BUILD_DEBUG)
+    /// Access statistics, see count_access().
+    mutable std::atomic<size_t> fast_path_accesses;
+    mutable std::atomic<size_t> slow_path_accesses;
+#endif
 };
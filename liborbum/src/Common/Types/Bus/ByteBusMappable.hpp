@@ -11,6 +11,30 @@ struct ByteBusMappable
     /// Total byte bus map size in bytes.
     virtual usize byte_bus_map_size() const = 0;
 
+    /// Returns the backing host memory if this object is plain memory (ie:
+    /// accesses have no side effects), in which case the bus will read/write
+    /// it directly instead of calling the methods below. The pointer must stay
+    /// valid for the lifetime of the object.
+    /// By default returns nullptr (all accesses go through the methods below).
+    virtual ubyte* byte_bus_host_memory()
+    {
+        return nullptr;
+    }
+
+    /// Returns if writes to the host memory must go through the methods below
+    /// (ie: read-only memory discarding writes).
+    virtual bool byte_bus_host_read_only() const
+    {
+        return false;
+    }
+
+    /// Returns a file descriptor the host memory can be mapped from (offset 0),
+    /// allowing a bus to place it in its fastmem arena, or -1 if not possible.
+    virtual int byte_bus_host_memory_fd() const
+    {
+        return -1;
+    }
+
     /// Read/write to this object with the byte-addressed offset.
     /// Needs to be overriden by sub-types - by default it will throw a runtime error.
     /// These functions should never called directly, only though a ByteBus.
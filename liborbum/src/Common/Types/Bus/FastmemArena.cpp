@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "Common/Types/Bus/FastmemArena.hpp"
+
+#if FASTMEM_SUPPORTED
+#include <csignal>
+#include <mutex>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/// Exception table entries emitted by the accesses (see FASTMEM_EXTABLE_ENTRY),
+/// bounds provided by the linker. Weak in case no accesses were linked in.
+struct FastmemExtableEntry
+{
+    sword access;
+    sword fixup;
+};
+
+extern "C" const FastmemExtableEntry __start_fastmem_extable[] __attribute__((weak));
+extern "C" const FastmemExtableEntry __stop_fastmem_extable[] __attribute__((weak));
+
+namespace
+{
+/// Active arenas, checked by the signal handler.
+constexpr int MAX_ARENAS = 8;
+std::array<std::atomic<FastmemArena*>, MAX_ARENAS> arenas;
+
+/// Absolute (access, fixup) host addresses of the exception table, sorted by
+/// access address so the signal handler can binary search it. Built once
+/// before the handler is installed.
+std::vector<std::pair<const void*, const void*>> fixups;
+
+struct sigaction previous_action;
+std::once_flag signal_handler_installed;
+
+void fastmem_signal_handler(int signal, siginfo_t* info, void* raw_context)
+{
+    ucontext_t* context = static_cast<ucontext_t*>(raw_context);
+    const void* fault_instruction = reinterpret_cast<const void*>(context->uc_mcontext.gregs[REG_RIP]);
+
+    for (auto& entry : arenas)
+    {
+        FastmemArena* arena = entry.load(std::memory_order_acquire);
+        if (!arena)
+            continue;
+
+        // Resume in the fixup code, which flags the fault to the caller.
+        const void* fixup = arena->get_fault_fixup(fault_instruction, info->si_addr);
+        if (fixup)
+        {
+            context->uc_mcontext.gregs[REG_RIP] = reinterpret_cast<greg_t>(fixup);
+            return;
+        }
+    }
+
+    // Not ours - pass it on.
+    if (previous_action.sa_flags & SA_SIGINFO)
+    {
+        previous_action.sa_sigaction(signal, info, raw_context);
+    }
+    else if (previous_action.sa_handler == SIG_DFL || previous_action.sa_handler == SIG_IGN)
+    {
+        // Restore the previous handler and return - the fault will happen again.
+        sigaction(SIGSEGV, &previous_action, nullptr);
+    }
+    else
+    {
+        previous_action.sa_handler(signal);
+    }
+}
+
+void install_signal_handler()
+{
+    // Entries are relative to their own location (position independent).
+    for (const FastmemExtableEntry* entry = __start_fastmem_extable; entry < __stop_fastmem_extable; entry++)
+    {
+        const ubyte* access = reinterpret_cast<const ubyte*>(&entry->access) + entry->access;
+        const ubyte* fixup = reinterpret_cast<const ubyte*>(&entry->fixup) + entry->fixup;
+        fixups.emplace_back(access, fixup);
+    }
+    std::sort(fixups.begin(), fixups.end());
+
+    struct sigaction action = {};
+    action.sa_sigaction = fastmem_signal_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, &previous_action);
+}
+} // namespace
+#endif
+
+FastmemArena::FastmemArena(const size_t size) :
+    size(size),
+    base(nullptr)
+{
+#if FASTMEM_SUPPORTED
+    // Offsets are masked by size - 1.
+    if (!size || (size & (size - 1)))
+        return;
+
+    // Find a free slot for the signal handler.
+    std::atomic<FastmemArena*>* slot = nullptr;
+    for (auto& entry : arenas)
+    {
+        FastmemArena* expected = nullptr;
+        if (entry.compare_exchange_strong(expected, this))
+        {
+            slot = &entry;
+            break;
+        }
+    }
+    if (!slot)
+        return;
+
+    void* region = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        slot->store(nullptr);
+        return;
+    }
+
+    std::call_once(signal_handler_installed, install_signal_handler);
+    base = static_cast<ubyte*>(region);
+#endif
+}
+
+FastmemArena::~FastmemArena()
+{
+#if FASTMEM_SUPPORTED
+    for (auto& entry : arenas)
+    {
+        FastmemArena* expected = this;
+        entry.compare_exchange_strong(expected, nullptr);
+    }
+
+    if (base)
+        munmap(base, size);
+#endif
+}
+
+bool FastmemArena::map(const size_t address, const int fd, const size_t length, const bool read_only)
+{
+#if FASTMEM_SUPPORTED
+    const size_t host_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (!base || fd == -1 || !length || (address + length) > size)
+        return false;
+    if ((address % host_page_size) || (length % host_page_size))
+        return false;
+
+    const int protection = read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+    return mmap(base + address, length, protection, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+#else
+    return false;
+#endif
+}
+
+const void* FastmemArena::get_fault_fixup(const void* fault_instruction, const void* fault_address) const
+{
+#if FASTMEM_SUPPORTED
+    const ubyte* address = static_cast<const ubyte*>(fault_address);
+    if (!base || address < base || address >= (base + size))
+        return nullptr;
+
+    auto entry = std::lower_bound(fixups.begin(), fixups.end(), std::make_pair(fault_instruction, static_cast<const void*>(nullptr)));
+    if (entry == fixups.end() || entry->first != fault_instruction)
+        return nullptr;
+
+    return entry->second;
+#else
+    return nullptr;
+#endif
+}
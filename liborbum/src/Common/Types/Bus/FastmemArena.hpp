@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <Macros.hpp>
+
+#include "Common/Types/Primitive.hpp"
+
+#if defined(ENV_UNIX) && defined(__linux__) && defined(__x86_64__)
+#define FASTMEM_SUPPORTED 1
+#include <emmintrin.h>
+#else
+#define FASTMEM_SUPPORTED 0
+#endif
+
+/// Emits an exception table entry for the access instruction at label 1,
+/// resuming at label 3 (which sets the fault flag and jumps back to label 2)
+/// if it faults. The fixup code and table entry are placed in the same section
+/// group as the access ("?" flag), so they are discarded along with it when an
+/// inline function is deduplicated by the linker.
+#define FASTMEM_EXTABLE_ENTRY                              \
+    ".pushsection .text.fastmem_fixup, \"ax?\"\n"          \
+    "3: movl $1, %k[fault]\n"                              \
+    "   jmp 2b\n"                                          \
+    ".popsection\n"                                        \
+    ".pushsection fastmem_extable, \"a?\"\n"               \
+    "   .balign 4\n"                                       \
+    "   .long 1b - ., 3b - .\n"                            \
+    ".popsection\n"
+
+/// Fastmem arena, used by a ByteBus to access plain memory with a single
+/// base + offset host access instead of a page table lookup.
+/// A host virtual address range the size of the bus' address space is reserved
+/// (inaccessible), into which shared host memory objects (see HostMemory) are
+/// mapped at their bus addresses - including any mirrors. Everything else (ie:
+/// MMIO registers) is left unmapped.
+///
+/// Accesses are made inline by the caller (see load() and store()), each
+/// registering its host instruction in an exception table. When one faults
+/// (unmapped address, or a write to read-only memory) inside an arena, the
+/// SIGSEGV handler resumes execution at the access' fixup code, which reports
+/// the fault back to the caller - the caller then performs the access through
+/// the normal bus path. Host faults that are not from an access in the table
+/// are passed on to the previous handler.
+/// Faulting accesses cost a signal delivery (a few microseconds), so this only
+/// pays off when most accesses are to plain memory.
+///
+/// Only supported on x86-64 Linux hosts for now - is_valid() will return false otherwise.
+class FastmemArena
+{
+public:
+    FastmemArena(const size_t size);
+    ~FastmemArena();
+
+    FastmemArena(const FastmemArena&) = delete;
+    FastmemArena& operator=(const FastmemArena&) = delete;
+
+    /// Returns if the arena was setup successfully.
+    bool is_valid() const
+    {
+        return base != nullptr;
+    }
+
+    /// Returns the host address of the start of the arena.
+    ubyte* get_base() const
+    {
+        return base;
+    }
+
+    /// Returns the mask applied to an address to get its offset in the arena.
+    size_t get_mask() const
+    {
+        return size - 1;
+    }
+
+    /// Maps [0, length) of the memory file into the arena at the given address.
+    /// Returns false if not possible (ie: not aligned to the host page size).
+    bool map(const size_t address, const int fd, const size_t length, const bool read_only);
+
+    /// Performs an access of the arena at the host address, returning false
+    /// (with nothing read or written) if it faulted.
+    /// Only valid to call on an arena that is_valid().
+    template <typename T>
+    static bool load(const ubyte* address, T& value)
+    {
+#if FASTMEM_SUPPORTED
+        int fault = 0;
+        T result;
+        asm volatile(
+            "1: mov%z[value] %[memory], %[value]\n"
+            "2:\n" FASTMEM_EXTABLE_ENTRY
+            : [value] "=r"(result), [fault] "+r"(fault)
+            : [memory] "m"(*reinterpret_cast<const T*>(address)));
+        value = result;
+        return !fault;
+#else
+        return false;
+#endif
+    }
+
+    template <typename T>
+    static bool store(ubyte* address, const T value)
+    {
+#if FASTMEM_SUPPORTED
+        int fault = 0;
+        asm volatile(
+            "1: mov%z[value] %[value], %[memory]\n"
+            "2:\n" FASTMEM_EXTABLE_ENTRY
+            : [memory] "=m"(*reinterpret_cast<T*>(address)), [fault] "+r"(fault)
+            : [value] "r"(value)
+            : "memory");
+        return !fault;
+#else
+        return false;
+#endif
+    }
+
+    /// Returns the host address of the fixup for the faulting host instruction,
+    /// or nullptr if the fault is not from an access to this arena.
+    /// Used by the signal handler.
+    const void* get_fault_fixup(const void* fault_instruction, const void* fault_address) const;
+
+private:
+    size_t size;
+    ubyte* base;
+};
+
+/// Qword accesses use a single SSE move.
+template <>
+inline bool FastmemArena::load<uqword>(const ubyte* address, uqword& value)
+{
+#if FASTMEM_SUPPORTED
+    int fault = 0;
+    __m128i result;
+    asm volatile(
+        "1: movdqu %[memory], %[value]\n"
+        "2:\n" FASTMEM_EXTABLE_ENTRY
+        : [value] "=x"(result), [fault] "+r"(fault)
+        : [memory] "m"(*reinterpret_cast<const __m128i*>(address)));
+    std::memcpy(&value.uw[0], &result, sizeof(value.uw));
+    return !fault;
+#else
+    return false;
+#endif
+}
+
+template <>
+inline bool FastmemArena::store<uqword>(ubyte* address, const uqword value)
+{
+#if FASTMEM_SUPPORTED
+    int fault = 0;
+    __m128i data;
+    std::memcpy(&data, &value.uw[0], sizeof(data));
+    asm volatile(
+        "1: movdqu %[value], %[memory]\n"
+        "2:\n" FASTMEM_EXTABLE_ENTRY
+        : [memory] "=m"(*reinterpret_cast<__m128i*>(address)), [fault] "+r"(fault)
+        : [value] "x"(data)
+        : "memory");
+    return !fault;
+#else
+    return false;
+#endif
+}
@@ -1,68 +1,149 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 
 #include <cereal/cereal.hpp>
 
-#include <Queues.hpp>
-
 #include "Common/Types/FifoQueue/FifoQueue.hpp"
 
-/// SPSC-backed DMA FIFO queue.
+/// Lock-free SPSC DMA FIFO queue.
+/// The storage is a ring of qwords (Size bytes), addressed at byte granularity
+/// with free running read/write positions. Bulk reads and writes copy the
+/// contiguous spans (at most 2 due to wrap around) directly, so a qword
+/// transfer is a couple of memcpy's and a single atomic store.
+/// Only 1 producer and 1 consumer thread allowed.
 template <size_t Size = 1024>
 class DmaFifoQueue : public FifoQueue
 {
 public:
-    using QueueTy = SpscQueue<ubyte, Size>;
+    static_assert((Size % NUMBER_BYTES_IN_QWORD) == 0, "DmaFifoQueue size must be a multiple of a qword.");
+
+    DmaFifoQueue() :
+        read_position(0),
+        write_position(0)
+    {
+    }
 
     /// Initialise FIFO queue (set to empty).
     void initialize() override
     {
-        fifo_queue.reset();
+        read_position.store(0, std::memory_order_relaxed);
+        write_position.store(0, std::memory_order_relaxed);
     }
 
     /// Reads byte(s) from the FIFO queue (pop).
     ubyte read_ubyte() override
     {
         ubyte data;
-        if (!fifo_queue.try_pop(data))
-            throw std::runtime_error("Could not pop from DMA fifo queue.");
+        DmaFifoQueue::read(&data, 1);
         return data;
     }
 
     /// Writes push bytes(s) to the end of the FIFO queue.
     void write_ubyte(const ubyte data) override
     {
-        if (!fifo_queue.try_push(data))
+        DmaFifoQueue::write(&data, 1);
+    }
+
+    /// Bulk reads/writes - throws if there is not enough data/space for the
+    /// whole transfer (check with has_read_available()/has_write_available() first).
+    void read(ubyte* buffer, const size_t length) override
+    {
+        const size_t position = read_position.load(std::memory_order_relaxed);
+        if ((write_position.load(std::memory_order_acquire) - position) < length)
+            throw std::runtime_error("Could not pop from DMA fifo queue.");
+
+        copy_out(position, buffer, length);
+        read_position.store(position + length, std::memory_order_release);
+    }
+
+    void write(const ubyte* buffer, const size_t length) override
+    {
+        const size_t position = write_position.load(std::memory_order_relaxed);
+        if ((Size - (position - read_position.load(std::memory_order_acquire))) < length)
             throw std::runtime_error("Could not push to DMA fifo queue.");
+
+        copy_in(position, buffer, length);
+        write_position.store(position + length, std::memory_order_release);
     }
 
     /// Returns if there are at least the specified number of bytes
     /// remaining in the queue available for reading.
-    /// Use only from a consumer thread (Boost requirement).
+    /// Exact only from the consumer thread (SPSC requirement).
     bool has_read_available(const size_t n_bytes) const override
     {
-        return fifo_queue.has_read_available(n_bytes);
+        return read_available() >= n_bytes;
     }
 
     /// Returns if there are at least the specified number of bytes
     /// available in the queue available for writing.
-    /// Use only from a producer thread (Boost requirement).
+    /// Exact only from the producer thread (SPSC requirement).
     bool has_write_available(const size_t n_bytes) const override
     {
-        return fifo_queue.has_write_available(n_bytes);
+        return (Size - read_available()) >= n_bytes;
+    }
+
+    template<class Archive>
+    void save(Archive & archive) const
+    {
+        size_t length = read_available();
+        std::vector<ubyte> vec(length);
+        copy_out(read_position.load(std::memory_order_acquire), vec.data(), length);
+
+        archive(CEREAL_NVP(length));
+        archive.saveBinaryValue(vec.data(), vec.size(), "data");
     }
 
     template<class Archive>
-    void serialize(Archive & archive)
+    void load(Archive & archive)
     {
-        archive(
-            CEREAL_NVP(fifo_queue)
-        );
+        initialize();
+
+        size_t length;
+        archive(CEREAL_NVP(length));
+
+        std::vector<ubyte> vec(length);
+        archive.loadBinaryValue(vec.data(), vec.size(), "data");
+
+        DmaFifoQueue::write(vec.data(), vec.size());
     }
 
 private:
+    size_t read_available() const
+    {
+        const size_t read = read_position.load(std::memory_order_acquire);
+        const size_t write = write_position.load(std::memory_order_acquire);
+        return (write > read) ? (write - read) : 0;
+    }
+
+    /// Copies between the ring and the buffer, starting at the (free running) position.
+    void copy_out(const size_t position, ubyte* buffer, const size_t length) const
+    {
+        const ubyte* storage = reinterpret_cast<const ubyte*>(queue);
+        const size_t offset = position % Size;
+        const size_t first_length = std::min(length, Size - offset);
+        std::memcpy(buffer, storage + offset, first_length);
+        std::memcpy(buffer + first_length, storage, length - first_length);
+    }
+
+    void copy_in(const size_t position, const ubyte* buffer, const size_t length)
+    {
+        ubyte* storage = reinterpret_cast<ubyte*>(queue);
+        const size_t offset = position % Size;
+        const size_t first_length = std::min(length, Size - offset);
+        std::memcpy(storage + offset, buffer, first_length);
+        std::memcpy(storage, buffer + first_length, length - first_length);
+    }
+
+    /// Free running positions (in bytes), each only written by one side.
+    alignas(64) std::atomic<size_t> read_position;
+    alignas(64) std::atomic<size_t> write_position;
+
     /// The backend for the FIFO queue.
-    QueueTy fifo_queue;
+    alignas(64) uqword queue[Size / NUMBER_BYTES_IN_QWORD];
 };
@@ -21,16 +21,18 @@ public:
     virtual void write_ubyte(const ubyte data) = 0;
 
     /// Reads bytes to the buffer given.
-    /// This is a wrapper around the read_ubyte function, and should not be treated as a separate interface (not made virtual).
-    void read(ubyte* buffer, const size_t length)
+    /// By default this is a wrapper around the read_ubyte function - override
+    /// to provide bulk transfers (must be equivalent to the byte-wise version).
+    virtual void read(ubyte* buffer, const size_t length)
     {
         for (size_t i = 0; i < length; i++)
             buffer[i] = read_ubyte();
     }
 
     /// Writes bytes from the buffer given.
-    /// This is a wrapper around the write_ubyte function, and should not be treated as a separate interface (not made virtual).
-    void write(const ubyte* buffer, const size_t length)
+    /// By default this is a wrapper around the write_ubyte function - override
+    /// to provide bulk transfers (must be equivalent to the byte-wise version).
+    virtual void write(const ubyte* buffer, const size_t length)
     {
         for (size_t i = 0; i < length; i++)
             write_ubyte(buffer[i]);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Macros.hpp>
+
+#if defined(ENV_UNIX)
+#include <sys/mman.h>
+#endif
+
+#include "Common/Types/Primitive.hpp"
+
+/// Host executable memory region, used by the recompilers to hold generated code.
+/// Allocated once up front, and handed out through a simple bump allocator.
+/// When the region is exhausted, the owner is expected to reset() it and
+/// invalidate everything that referenced it.
+/// Only supported on Unix hosts for now - is_valid() will return false otherwise.
+class ExecutableMemory
+{
+public:
+    ExecutableMemory(const size_t size) :
+        size(size),
+        used(0),
+        memory(nullptr)
+    {
+#if defined(ENV_UNIX)
+        void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED)
+            memory = static_cast<ubyte*>(region);
+#endif
+    }
+
+    ~ExecutableMemory()
+    {
+#if defined(ENV_UNIX)
+        if (memory)
+            munmap(memory, size);
+#endif
+    }
+
+    ExecutableMemory(const ExecutableMemory&) = delete;
+    ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+    /// Returns if the memory region was allocated successfully.
+    bool is_valid() const
+    {
+        return memory != nullptr;
+    }
+
+    /// Returns a pointer to the next free byte, and the amount of bytes available.
+    ubyte* get_free_pointer() const
+    {
+        return memory + used;
+    }
+
+    size_t get_free_size() const
+    {
+        return size - used;
+    }
+
+    /// Marks the given number of bytes (from the free pointer) as used.
+    /// Keeps 16-byte alignment for the next allocation.
+    void commit(const size_t length)
+    {
+        used += (length + 15) & ~static_cast<size_t>(15);
+        if (used > size)
+            used = size;
+    }
+
+    /// Releases all allocations.
+    void reset()
+    {
+        used = 0;
+    }
+
+    /// Returns the total size and used amount in bytes.
+    size_t get_size() const
+    {
+        return size;
+    }
+
+    size_t get_used_size() const
+    {
+        return used;
+    }
+
+private:
+    size_t size;
+    size_t used;
+    ubyte* memory;
+};
@@ -0,0 +1,718 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Minimal x86-64 machine code emitter, used by the recompilers and the GS
+/// pixel pipeline compiler.
+/// Only the instructions needed by those are implemented.
+/// Code is written directly into a caller supplied buffer (usually from an
+/// ExecutableMemory region). If the buffer overflows, emission stops and
+/// has_overflowed() returns true - the caller must discard the result.
+class X64Emitter
+{
+public:
+    /// General purpose registers, numbered by their encoding.
+    enum class Reg
+    {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15
+    };
+
+    /// Condition codes, used with jcc.
+    enum class Cond
+    {
+        O = 0x0,
+        NO = 0x1,
+        B = 0x2,
+        AE = 0x3,
+        E = 0x4,
+        NE = 0x5,
+        BE = 0x6,
+        A = 0x7,
+        S = 0x8,
+        NS = 0x9,
+        L = 0xC,
+        GE = 0xD,
+        LE = 0xE,
+        G = 0xF
+    };
+
+    /// SSE registers, numbered by their encoding (only the ones not needing a REX prefix).
+    enum class Xmm
+    {
+        XMM0 = 0,
+        XMM1,
+        XMM2,
+        XMM3,
+        XMM4,
+        XMM5,
+        XMM6,
+        XMM7
+    };
+
+    /// Integer ALU operations, numbered by their ModRM opcode extension.
+    enum class AluOp
+    {
+        ADD = 0,
+        OR = 1,
+        AND = 4,
+        SUB = 5,
+        XOR = 6,
+        CMP = 7
+    };
+
+    /// Shift operations, numbered by their ModRM opcode extension.
+    enum class ShiftOp
+    {
+        SHL = 4,
+        SHR = 5,
+        SAR = 7
+    };
+
+    /// Memory access widths, used with load/store.
+    enum class Width
+    {
+        Byte,
+        Hword,
+        Word,
+        Dword
+    };
+
+    X64Emitter(ubyte* buffer, const size_t capacity) :
+        buffer(buffer),
+        capacity(capacity),
+        position(0),
+        overflowed(false)
+    {
+    }
+
+    /// Returns the start of the code buffer.
+    ubyte* get_code() const
+    {
+        return buffer;
+    }
+
+    /// Returns the current emission position (also used as a label).
+    size_t get_position() const
+    {
+        return position;
+    }
+
+    /// Returns if the buffer was too small for the emitted code.
+    bool has_overflowed() const
+    {
+        return overflowed;
+    }
+
+    /// push r64 / pop r64.
+    void push(const Reg reg)
+    {
+        rex_b(reg);
+        emit_ubyte(0x50 + low(reg));
+    }
+
+    void pop(const Reg reg)
+    {
+        rex_b(reg);
+        emit_ubyte(0x58 + low(reg));
+    }
+
+    /// ret.
+    void ret()
+    {
+        emit_ubyte(0xC3);
+    }
+
+    /// mov r64, r64.
+    void mov_r64_r64(const Reg dst, const Reg src)
+    {
+        emit_ubyte(0x48 | (high(src) << 2) | high(dst));
+        emit_ubyte(0x89);
+        emit_ubyte(0xC0 | (low(src) << 3) | low(dst));
+    }
+
+    /// mov r32, imm32 (zero extends into the upper 32 bits).
+    void mov_r32_imm32(const Reg dst, const uword imm)
+    {
+        rex_b(dst);
+        emit_ubyte(0xB8 + low(dst));
+        emit_uword(imm);
+    }
+
+    /// mov r64, imm64.
+    void mov_r64_imm64(const Reg dst, const udword imm)
+    {
+        emit_ubyte(0x48 | high(dst));
+        emit_ubyte(0xB8 + low(dst));
+        emit_udword(imm);
+    }
+
+    /// call r64.
+    void call_r64(const Reg reg)
+    {
+        rex_b(reg);
+        emit_ubyte(0xFF);
+        emit_ubyte(0xD0 | low(reg));
+    }
+
+    /// Calls an absolute host function address (clobbers RAX).
+    void call(const void* function)
+    {
+        mov_r64_imm64(Reg::RAX, reinterpret_cast<udword>(function));
+        call_r64(Reg::RAX);
+    }
+
+    /// test r8, r8 (low byte registers AL, CL, DL, BL only).
+    void test_r8_r8(const Reg a, const Reg b)
+    {
+        emit_ubyte(0x84);
+        emit_ubyte(0xC0 | (low(b) << 3) | low(a));
+    }
+
+    /// mov r32, r32 (zero extends into the upper 32 bits).
+    void mov_r32_r32(const Reg dst, const Reg src)
+    {
+        rex(false, src, Reg::RAX, dst, false);
+        emit_ubyte(0x89);
+        emit_ubyte(0xC0 | (low(src) << 3) | low(dst));
+    }
+
+    /// mov r32, [base + disp] / mov r64, [base + disp] / mov [base + disp], r32 / mov [base + disp], r64.
+    void mov_r32_m32(const Reg dst, const Reg base, const sword disp)
+    {
+        rex(false, dst, Reg::RAX, base, false);
+        emit_ubyte(0x8B);
+        modrm_base_disp(low(dst), base, disp);
+    }
+
+    void mov_r64_m64(const Reg dst, const Reg base, const sword disp)
+    {
+        rex(true, dst, Reg::RAX, base, false);
+        emit_ubyte(0x8B);
+        modrm_base_disp(low(dst), base, disp);
+    }
+
+    void mov_m32_r32(const Reg base, const sword disp, const Reg src)
+    {
+        rex(false, src, Reg::RAX, base, false);
+        emit_ubyte(0x89);
+        modrm_base_disp(low(src), base, disp);
+    }
+
+    void mov_m64_r64(const Reg base, const sword disp, const Reg src)
+    {
+        rex(true, src, Reg::RAX, base, false);
+        emit_ubyte(0x89);
+        modrm_base_disp(low(src), base, disp);
+    }
+
+    /// movsxd r64, r32 (sign extends the lower 32 bits).
+    void movsxd_r64_r32(const Reg dst, const Reg src)
+    {
+        rex(true, dst, Reg::RAX, src, false);
+        emit_ubyte(0x63);
+        emit_ubyte(0xC0 | (low(dst) << 3) | low(src));
+    }
+
+    /// op r32, r32 (ie: add eax, ecx) / op r64, r64.
+    void alu_r32_r32(const AluOp op, const Reg dst, const Reg src)
+    {
+        rex(false, src, Reg::RAX, dst, false);
+        emit_ubyte((static_cast<ubyte>(op) << 3) | 0x01);
+        emit_ubyte(0xC0 | (low(src) << 3) | low(dst));
+    }
+
+    void alu_r64_r64(const AluOp op, const Reg dst, const Reg src)
+    {
+        rex(true, src, Reg::RAX, dst, false);
+        emit_ubyte((static_cast<ubyte>(op) << 3) | 0x01);
+        emit_ubyte(0xC0 | (low(src) << 3) | low(dst));
+    }
+
+    /// not r64.
+    void not_r64(const Reg reg)
+    {
+        rex(true, Reg::RAX, Reg::RAX, reg, false);
+        emit_ubyte(0xF7);
+        emit_ubyte(0xD0 | low(reg));
+    }
+
+    /// op r32, imm32 / op r64, imm32 (sign extended).
+    void alu_r32_imm32(const AluOp op, const Reg dst, const uword imm)
+    {
+        rex(false, Reg::RAX, Reg::RAX, dst, false);
+        emit_ubyte(0x81);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(dst));
+        emit_uword(imm);
+    }
+
+    void alu_r64_imm32(const AluOp op, const Reg dst, const uword imm)
+    {
+        rex(true, Reg::RAX, Reg::RAX, dst, false);
+        emit_ubyte(0x81);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(dst));
+        emit_uword(imm);
+    }
+
+    /// op r32, [base + disp].
+    void alu_r32_m32(const AluOp op, const Reg dst, const Reg base, const sword disp)
+    {
+        rex(false, dst, Reg::RAX, base, false);
+        emit_ubyte((static_cast<ubyte>(op) << 3) | 0x03);
+        modrm_base_disp(low(dst), base, disp);
+    }
+
+    /// shl / shr / sar r32, imm8 / r64, imm8.
+    void shift_r32_imm8(const ShiftOp op, const Reg reg, const ubyte imm)
+    {
+        rex(false, Reg::RAX, Reg::RAX, reg, false);
+        emit_ubyte(0xC1);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(reg));
+        emit_ubyte(imm);
+    }
+
+    void shift_r64_imm8(const ShiftOp op, const Reg reg, const ubyte imm)
+    {
+        rex(true, Reg::RAX, Reg::RAX, reg, false);
+        emit_ubyte(0xC1);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(reg));
+        emit_ubyte(imm);
+    }
+
+    /// shl / shr / sar r32, cl / r64, cl (the count is masked to 5 or 6 bits).
+    void shift_r32_cl(const ShiftOp op, const Reg reg)
+    {
+        rex(false, Reg::RAX, Reg::RAX, reg, false);
+        emit_ubyte(0xD3);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(reg));
+    }
+
+    void shift_r64_cl(const ShiftOp op, const Reg reg)
+    {
+        rex(true, Reg::RAX, Reg::RAX, reg, false);
+        emit_ubyte(0xD3);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(op) << 3) | low(reg));
+    }
+
+    /// test r32, r32 / test r64, r64.
+    void test_r32_r32(const Reg a, const Reg b)
+    {
+        rex(false, b, Reg::RAX, a, false);
+        emit_ubyte(0x85);
+        emit_ubyte(0xC0 | (low(b) << 3) | low(a));
+    }
+
+    void test_r64_r64(const Reg a, const Reg b)
+    {
+        rex(true, b, Reg::RAX, a, false);
+        emit_ubyte(0x85);
+        emit_ubyte(0xC0 | (low(b) << 3) | low(a));
+    }
+
+    /// setcc r8 (low byte registers AL, CL, DL, BL only).
+    void setcc(const Cond cond, const Reg reg)
+    {
+        emit_ubyte(0x0F);
+        emit_ubyte(0x90 | static_cast<ubyte>(cond));
+        emit_ubyte(0xC0 | low(reg));
+    }
+
+    /// cmovcc r64, r64.
+    void cmov_r64_r64(const Cond cond, const Reg dst, const Reg src)
+    {
+        rex(true, dst, Reg::RAX, src, false);
+        emit_ubyte(0x0F);
+        emit_ubyte(0x40 | static_cast<ubyte>(cond));
+        emit_ubyte(0xC0 | (low(dst) << 3) | low(src));
+    }
+
+    /// Zero extending load: dst = [base + (index << scale)].
+    /// Byte, hword and word loads write the 32-bit register (upper bits cleared).
+    /// The base can't be RBP or R13, and the index can't be RSP.
+    void load_base_index(const Width width, const Reg dst, const Reg base, const Reg index, const ubyte scale = 0)
+    {
+        rex(width == Width::Dword, dst, index, base, false);
+        switch (width)
+        {
+        case Width::Byte:
+            emit_ubyte(0x0F);
+            emit_ubyte(0xB6);
+            break;
+        case Width::Hword:
+            emit_ubyte(0x0F);
+            emit_ubyte(0xB7);
+            break;
+        case Width::Word:
+        case Width::Dword:
+            emit_ubyte(0x8B);
+            break;
+        }
+        modrm_sib(dst, base, index, scale);
+    }
+
+    /// Store: [base + (index << scale)] = src (lower bits of src for widths < Dword).
+    /// The base can't be RBP or R13, and the index can't be RSP.
+    void store_base_index(const Width width, const Reg base, const Reg index, const Reg src, const ubyte scale = 0)
+    {
+        if (width == Width::Hword)
+            emit_ubyte(0x66);
+        // Byte stores from SPL, BPL, SIL, DIL need a REX prefix to be encodable.
+        rex(width == Width::Dword, src, index, base, (width == Width::Byte) && (low(src) >= 4));
+        emit_ubyte((width == Width::Byte) ? 0x88 : 0x89);
+        modrm_sib(src, base, index, scale);
+    }
+
+    /// movaps xmm, [base] / movaps [base], xmm (16-byte aligned).
+    /// The base can't be RSP, RBP, R12 or R13.
+    void movaps_xmm_m128(const Xmm dst, const Reg base)
+    {
+        rex_b(base);
+        emit_ubyte(0x0F);
+        emit_ubyte(0x28);
+        emit_ubyte((static_cast<ubyte>(dst) << 3) | low(base));
+    }
+
+    void movaps_m128_xmm(const Reg base, const Xmm src)
+    {
+        rex_b(base);
+        emit_ubyte(0x0F);
+        emit_ubyte(0x29);
+        emit_ubyte((static_cast<ubyte>(src) << 3) | low(base));
+    }
+
+    /// andps / andnps / orps xmm, xmm.
+    void andps(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x54, dst, src);
+    }
+
+    void andnps(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x55, dst, src);
+    }
+
+    void orps(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x56, dst, src);
+    }
+
+    /// shufps xmm, xmm, imm8.
+    void shufps(const Xmm dst, const Xmm src, const ubyte imm)
+    {
+        sse_r_r(0xC6, dst, src);
+        emit_ubyte(imm);
+    }
+
+    /// addps / mulps xmm, [base + disp] (16-byte aligned).
+    void addps_xmm_m128(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0x00, 0x58, dst, base, disp);
+    }
+
+    void mulps_xmm_m128(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0x00, 0x59, dst, base, disp);
+    }
+
+    /// addsd / mulsd / maxsd / minsd xmm, [base + disp].
+    void addsd_xmm_m64(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0xF2, 0x58, dst, base, disp);
+    }
+
+    void mulsd_xmm_m64(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0xF2, 0x59, dst, base, disp);
+    }
+
+    void maxsd_xmm_m64(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0xF2, 0x5F, dst, base, disp);
+    }
+
+    void minsd_xmm_m64(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0xF2, 0x5D, dst, base, disp);
+    }
+
+    /// cvtsi2ss / cvtsi2sd xmm, r32.
+    void cvtsi2ss_xmm_r32(const Xmm dst, const Reg src)
+    {
+        sse_xmm_gpr(0xF3, 0x2A, false, dst, src);
+    }
+
+    void cvtsi2sd_xmm_r32(const Xmm dst, const Reg src)
+    {
+        sse_xmm_gpr(0xF2, 0x2A, false, dst, src);
+    }
+
+    /// cvttsd2si r64, xmm (truncating).
+    void cvttsd2si_r64_xmm(const Reg dst, const Xmm src)
+    {
+        emit_ubyte(0xF2);
+        rex(true, dst, Reg::RAX, Reg::RAX, false);
+        emit_ubyte(0x0F);
+        emit_ubyte(0x2C);
+        emit_ubyte(0xC0 | (low(dst) << 3) | static_cast<ubyte>(src));
+    }
+
+    /// cvttps2dq xmm, xmm (truncating).
+    void cvttps2dq(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0xF3, 0x5B, dst, src);
+    }
+
+    /// movd xmm, r32 / movd r32, xmm.
+    void movd_xmm_r32(const Xmm dst, const Reg src)
+    {
+        sse_xmm_gpr(0x66, 0x6E, false, dst, src);
+    }
+
+    void movd_r32_xmm(const Reg dst, const Xmm src)
+    {
+        sse_xmm_gpr(0x66, 0x7E, false, src, dst);
+    }
+
+    /// Packed integer operations, xmm, xmm.
+    void movdqa(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0x6F, dst, src);
+    }
+
+    void punpcklbw(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0x60, dst, src);
+    }
+
+    void punpcklwd(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0x61, dst, src);
+    }
+
+    void packssdw(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0x6B, dst, src);
+    }
+
+    void packuswb(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0x67, dst, src);
+    }
+
+    void pand(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0xDB, dst, src);
+    }
+
+    /// pand xmm, [base + disp] (16-byte aligned).
+    void pand_xmm_m128(const Xmm dst, const Reg base, const sword disp)
+    {
+        sse_r_m(0x66, 0xDB, dst, base, disp);
+    }
+
+    void pxor(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0xEF, dst, src);
+    }
+
+    void paddd(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0xFE, dst, src);
+    }
+
+    void psubd(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0xFA, dst, src);
+    }
+
+    void pmaddwd(const Xmm dst, const Xmm src)
+    {
+        sse_r_r(0x66, 0xF5, dst, src);
+    }
+
+    /// pshufd xmm, xmm, imm8.
+    void pshufd(const Xmm dst, const Xmm src, const ubyte imm)
+    {
+        sse_r_r(0x66, 0x70, dst, src);
+        emit_ubyte(imm);
+    }
+
+    /// psrad xmm, imm8.
+    void psrad(const Xmm reg, const ubyte imm)
+    {
+        emit_ubyte(0x66);
+        emit_ubyte(0x0F);
+        emit_ubyte(0x72);
+        emit_ubyte(0xE0 | static_cast<ubyte>(reg));
+        emit_ubyte(imm);
+    }
+
+    /// jcc rel32 / jmp rel32.
+    /// Returns the position of the rel32 field, to be later bound with bind().
+    size_t jcc(const Cond cond)
+    {
+        emit_ubyte(0x0F);
+        emit_ubyte(0x80 | static_cast<ubyte>(cond));
+        const size_t fixup = position;
+        emit_uword(0);
+        return fixup;
+    }
+
+    size_t jmp()
+    {
+        emit_ubyte(0xE9);
+        const size_t fixup = position;
+        emit_uword(0);
+        return fixup;
+    }
+
+    /// Binds a previously emitted jump (see jcc() and jmp()) to the target position.
+    void bind(const size_t fixup, const size_t target)
+    {
+        if (overflowed)
+            return;
+
+        const sword rel = static_cast<sword>(target) - static_cast<sword>(fixup + 4);
+        std::memcpy(buffer + fixup, &rel, sizeof(rel));
+    }
+
+    /// Raw byte emission.
+    void emit_ubyte(const ubyte value)
+    {
+        if (position + 1 > capacity)
+        {
+            overflowed = true;
+            return;
+        }
+
+        buffer[position++] = value;
+    }
+
+    void emit_uword(const uword value)
+    {
+        emit_bytes(&value, sizeof(value));
+    }
+
+    void emit_udword(const udword value)
+    {
+        emit_bytes(&value, sizeof(value));
+    }
+
+private:
+    void emit_bytes(const void* data, const size_t length)
+    {
+        if (position + length > capacity)
+        {
+            overflowed = true;
+            return;
+        }
+
+        std::memcpy(buffer + position, data, length);
+        position += length;
+    }
+
+    /// Emits a REX prefix for a ModRM + SIB encoded instruction, if needed.
+    void rex(const bool w, const Reg reg, const Reg index, const Reg base, const bool force)
+    {
+        const ubyte prefix = 0x40 | (w << 3) | (high(reg) << 2) | (high(index) << 1) | high(base);
+        if (force || (prefix != 0x40))
+            emit_ubyte(prefix);
+    }
+
+    /// Emits a ModRM + SIB pair for [base + (index << scale)] addressing (no displacement).
+    void modrm_sib(const Reg reg, const Reg base, const Reg index, const ubyte scale = 0)
+    {
+        emit_ubyte(0x04 | (low(reg) << 3));
+        emit_ubyte((scale << 6) | (low(index) << 3) | low(base));
+    }
+
+    /// Emits the ModRM (+ SIB) and displacement for [base + disp] addressing.
+    /// The reg field is the register or opcode extension.
+    void modrm_base_disp(const ubyte reg_field, const Reg base, const sword disp)
+    {
+        const bool is_disp8 = (disp >= -128) && (disp <= 127);
+        emit_ubyte((is_disp8 ? 0x40 : 0x80) | (reg_field << 3) | low(base));
+        // RSP and R12 can only be encoded as a base through a SIB byte.
+        if (low(base) == 4)
+            emit_ubyte(0x24);
+        if (is_disp8)
+            emit_ubyte(static_cast<ubyte>(disp));
+        else
+            emit_uword(static_cast<uword>(disp));
+    }
+
+    /// Emits a packed single SSE instruction with register operands.
+    void sse_r_r(const ubyte opcode, const Xmm dst, const Xmm src)
+    {
+        emit_ubyte(0x0F);
+        emit_ubyte(opcode);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(dst) << 3) | static_cast<ubyte>(src));
+    }
+
+    /// Emits a prefixed (66, F2, F3) SSE instruction with register operands.
+    void sse_r_r(const ubyte prefix, const ubyte opcode, const Xmm dst, const Xmm src)
+    {
+        emit_ubyte(prefix);
+        sse_r_r(opcode, dst, src);
+    }
+
+    /// Emits an SSE instruction with a [base + disp] memory operand (prefix 0 = none).
+    void sse_r_m(const ubyte prefix, const ubyte opcode, const Xmm dst, const Reg base, const sword disp)
+    {
+        if (prefix)
+            emit_ubyte(prefix);
+        rex_b(base);
+        emit_ubyte(0x0F);
+        emit_ubyte(opcode);
+        modrm_base_disp(static_cast<ubyte>(dst), base, disp);
+    }
+
+    /// Emits an SSE instruction between an xmm (ModRM reg) and a general purpose register (ModRM rm).
+    void sse_xmm_gpr(const ubyte prefix, const ubyte opcode, const bool w, const Xmm xmm, const Reg gpr)
+    {
+        emit_ubyte(prefix);
+        rex(w, Reg::RAX, Reg::RAX, gpr, false);
+        emit_ubyte(0x0F);
+        emit_ubyte(opcode);
+        emit_ubyte(0xC0 | (static_cast<ubyte>(xmm) << 3) | low(gpr));
+    }
+
+    /// Emits a REX.B prefix if the register is one of R8 -> R15.
+    void rex_b(const Reg reg)
+    {
+        if (high(reg))
+            emit_ubyte(0x41);
+    }
+
+    static ubyte low(const Reg reg)
+    {
+        return static_cast<ubyte>(reg) & 0x7;
+    }
+
+    static ubyte high(const Reg reg)
+    {
+        return (static_cast<ubyte>(reg) >> 3) & 0x1;
+    }
+
+    ubyte* buffer;
+    size_t capacity;
+    size_t position;
+    bool overflowed;
+};
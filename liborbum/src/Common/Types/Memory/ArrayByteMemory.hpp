@@ -1,27 +1,32 @@
 #pragma once
 
+#include <algorithm>
 #include <fstream>
-#include <vector>
 
 #include "Common/Types/Memory/ByteMemory.hpp"
+#include "Common/Types/Memory/HostMemory.hpp"
 
 /// Array backed byte-addressed memory.
 /// Can be optionally initialised with a byte value, copied across the whole array.
+/// Can optionally be allocated as shared host memory, which allows a ByteBus
+/// to map it into its fastmem arena (see FastmemArena).
 class ArrayByteMemory : public ByteMemory
 {
 public:
-    ArrayByteMemory(const size_t size, const ubyte initial_value = 0, const bool read_only = false) :
+    ArrayByteMemory(const size_t size, const ubyte initial_value = 0, const bool read_only = false, const bool shared = false) :
         size(size),
-        memory(size, initial_value),
+        memory(size, shared),
         initial_value(initial_value),
         read_only(read_only)
     {
+        std::fill(memory.data(), memory.data() + size, initial_value);
     }
 
     /// Initialise memory.
     void initialize() override
     {
-        std::vector<ubyte>(size, initial_value).swap(memory);
+        // Keep the same storage, it may be directly accessed through a ByteBus.
+        std::fill(memory.data(), memory.data() + size, initial_value);
     }
 
     /// Read in a raw file to the memory (byte copy).
@@ -31,7 +36,7 @@ public:
         std::ifstream file(path, std::ios_base::binary);
         if (!file)
             throw std::runtime_error("Unable to read file");
-        file.read(reinterpret_cast<char*>(&memory[0]), file_length);
+        file.read(reinterpret_cast<char*>(memory.data()), file_length);
     }
 
     /// Dumps the memory contents to a file.
@@ -41,7 +46,7 @@ public:
         std::ofstream file(path, std::ios_base::binary);
         if (!file)
             throw std::runtime_error("Unable to write file");
-        file.write(reinterpret_cast<char*>(&memory[0]), size);
+        file.write(reinterpret_cast<char*>(memory.data()), size);
     }
 
     /// Read or write a value of a given type, to the specified byte index (offset).
@@ -52,7 +57,7 @@ public:
             throw std::runtime_error("Tried to access ArrayByteMemory with an invalid offset.");
 #endif
 
-        return *reinterpret_cast<ubyte*>(&memory[offset]);
+        return *reinterpret_cast<ubyte*>(memory.data() + offset);
     }
 
     void write_ubyte(const size_t offset, const ubyte value) override
@@ -63,7 +68,7 @@ public:
 #endif
 
         if (!read_only)
-            *reinterpret_cast<ubyte*>(&memory[offset]) = value;
+            *reinterpret_cast<ubyte*>(memory.data() + offset) = value;
     }
 
     uhword read_uhword(const size_t offset) override
@@ -73,7 +78,7 @@ public:
             throw std::runtime_error("Tried to access ArrayByteMemory with an invalid offset.");
 #endif
 
-        return *reinterpret_cast<uhword*>(&memory[offset]);
+        return *reinterpret_cast<uhword*>(memory.data() + offset);
     }
 
     void write_uhword(const size_t offset, const uhword value) override
@@ -84,7 +89,7 @@ public:
 #endif
 
         if (!read_only)
-            *reinterpret_cast<uhword*>(&memory[offset]) = value;
+            *reinterpret_cast<uhword*>(memory.data() + offset) = value;
     }
 
     uword read_uword(const size_t offset) override
@@ -94,7 +99,7 @@ public:
             throw std::runtime_error("Tried to access ArrayByteMemory with an invalid offset.");
 #endif
 
-        return *reinterpret_cast<uword*>(&memory[offset]);
+        return *reinterpret_cast<uword*>(memory.data() + offset);
     }
 
     void write_uword(const size_t offset, const uword value) override
@@ -105,7 +110,7 @@ public:
 #endif
 
         if (!read_only)
-            *reinterpret_cast<uword*>(&memory[offset]) = value;
+            *reinterpret_cast<uword*>(memory.data() + offset) = value;
     }
 
     udword read_udword(const size_t offset) override
@@ -115,7 +120,7 @@ public:
             throw std::runtime_error("Tried to access ArrayByteMemory with an invalid offset.");
 #endif
 
-        return *reinterpret_cast<udword*>(&memory[offset]);
+        return *reinterpret_cast<udword*>(memory.data() + offset);
     }
 
     void write_udword(const size_t offset, const udword value) override
@@ -126,7 +131,7 @@ public:
 #endif
 
         if (!read_only)
-            *reinterpret_cast<udword*>(&memory[offset]) = value;
+            *reinterpret_cast<udword*>(memory.data() + offset) = value;
     }
 
     uqword read_uqword(const size_t offset) override
@@ -136,7 +141,7 @@ public:
             throw std::runtime_error("Tried to access ArrayByteMemory with an invalid offset.");
 #endif
 
-        return *reinterpret_cast<uqword*>(&memory[offset]);
+        return *reinterpret_cast<uqword*>(memory.data() + offset);
     }
 
     void write_uqword(const size_t offset, const uqword value) override
@@ -147,7 +152,7 @@ public:
 #endif
 
         if (!read_only)
-            *reinterpret_cast<uqword*>(&memory[offset]) = value;
+            *reinterpret_cast<uqword*>(memory.data() + offset) = value;
     }
 
     /// ByteBusMappable overrides.
@@ -156,11 +161,28 @@ public:
         return static_cast<usize>(size);
     }
 
-    /// Get a reference to the memory storage.
+    /// Plain memory - allow direct access from the bus.
+    /// Sub-types with special functionality must disable this.
+    ubyte* byte_bus_host_memory() override
+    {
+        return memory.data();
+    }
+
+    bool byte_bus_host_read_only() const override
+    {
+        return read_only;
+    }
+
+    int byte_bus_host_memory_fd() const override
+    {
+        return memory.get_fd();
+    }
+
+    /// Get a pointer to the memory storage.
     /// Used for the emulator: sometimes we need to peek and poke directly.
-    std::vector<ubyte>& get_memory()
+    ubyte* get_memory()
     {
-        return memory;
+        return memory.data();
     }
 
 private:
@@ -168,7 +190,7 @@ private:
     size_t size;
 
     /// Array backend for the byte memory.
-    std::vector<ubyte> memory;
+    HostMemory memory;
 
     /// Initial value.
     ubyte initial_value;
@@ -181,12 +203,12 @@ public:
     template<class Archive>
     void save(Archive & archive) const
     {
-        archive.saveBinaryValue(memory.data(), memory.size(), "memory");
+        archive.saveBinaryValue(memory.data(), size, "memory");
     }
 
     template<class Archive>
     void load(Archive & archive)
     {     
-        archive.loadBinaryValue(memory.data(), memory.size(), "memory");
+        archive.loadBinaryValue(memory.data(), size, "memory");
     }
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#include <Macros.hpp>
+
+#if defined(ENV_UNIX) && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Types/Primitive.hpp"
+
+/// Zero initialised host memory storage, used as the backing storage of the
+/// byte memories.
+/// When shared is requested, the storage is allocated from an anonymous memory
+/// file (memfd) where possible, which allows it to be mapped into other host
+/// address ranges as well (see FastmemArena). The file descriptor is available
+/// through get_fd(), which returns -1 if the storage is not shareable.
+class HostMemory
+{
+public:
+    HostMemory(const size_t size, const bool shared = false) :
+        size(size),
+        memory(nullptr),
+        fd(-1)
+    {
+#if defined(ENV_UNIX) && defined(__linux__)
+        if (shared && size)
+        {
+            fd = memfd_create("orbum", MFD_CLOEXEC);
+            if (fd != -1)
+            {
+                void* region = MAP_FAILED;
+                if (ftruncate(fd, size) == 0)
+                    region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+                if (region != MAP_FAILED)
+                {
+                    memory = static_cast<ubyte*>(region);
+                }
+                else
+                {
+                    close(fd);
+                    fd = -1;
+                }
+            }
+        }
+#endif
+
+        if (!memory)
+        {
+            heap_memory = std::make_unique<ubyte[]>(size);
+            memory = heap_memory.get();
+        }
+    }
+
+    ~HostMemory()
+    {
+#if defined(ENV_UNIX) && defined(__linux__)
+        if (fd != -1)
+        {
+            munmap(memory, size);
+            close(fd);
+        }
+#endif
+    }
+
+    HostMemory(const HostMemory&) = delete;
+    HostMemory& operator=(const HostMemory&) = delete;
+
+    /// Returns the storage. Stays valid for the lifetime of this object.
+    ubyte* data() const
+    {
+        return memory;
+    }
+
+    size_t get_size() const
+    {
+        return size;
+    }
+
+    /// Returns the memory file descriptor, or -1 if not shareable.
+    int get_fd() const
+    {
+        return fd;
+    }
+
+private:
+    size_t size;
+    ubyte* memory;
+    int fd;
+    std::unique_ptr<ubyte[]> heap_memory;
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Mips/MipsInstruction.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Idle (busy-wait) loop detection for the MIPS cores.
+/// An idle loop is a short loop that branches back to its start, whose only
+/// inputs are loads (ie: polling an MMIO register or a flag in RAM), with no
+/// side effects (stores, coprocessor operations, exceptions, etc) and no
+/// state carried between iterations (every register read is either not
+/// written in the loop, or written earlier in the same iteration).
+/// Every iteration of such a loop does exactly the same thing until the
+/// memory it polls is changed by something else (another controller, or an
+/// interrupt handler), so once an iteration has run without exiting, the
+/// core can skip ahead (fast-forward) to the next point where that may have
+/// happened - the end of the time slice, the next scheduled event, or a
+/// pending interrupt.
+/// This only holds for memory which is written to by the other controllers:
+/// I/O registers may change by themselves, or have read side effects. The
+/// load addresses are recorded (see Loads), so the core can check that they
+/// are in RAM before skipping.
+/// Only the MIPS I instructions common to the R3000 and R5900 are recognised.
+namespace MipsIdleLoop
+{
+/// Maximum number of instructions in an idle loop (including the delay slot).
+static constexpr size_t MAX_LOOP_LENGTH = 16;
+
+/// Register usage of a single instruction, as bitmasks of GPR's.
+struct RegisterUsage
+{
+    uword reads;
+    uword writes;
+};
+
+/// Loads made by an idle loop, as the base register and offset. Each base
+/// register holds the same value on every iteration, and is not written after
+/// the load in the loop, so the addresses can be computed from the register
+/// state at the end of an iteration.
+struct Loads
+{
+    struct Load
+    {
+        int base;
+        shword offset;
+    };
+
+    size_t count;
+    std::array<Load, MAX_LOOP_LENGTH> loads;
+};
+
+/// Returns the register usage of a side effect free instruction, or false if
+/// the instruction is not allowed in an idle loop.
+inline bool get_register_usage(const MipsInstruction inst, RegisterUsage& usage)
+{
+    const uword rs = 1u << inst.rs();
+    const uword rt = 1u << inst.rt();
+    const uword rd = 1u << inst.rd();
+
+    switch (inst.opcode())
+    {
+    case 0x00: // SPECIAL.
+    {
+        switch (inst.funct())
+        {
+        case 0x00: // SLL (NOP).
+        case 0x02: // SRL.
+        case 0x03: // SRA.
+            usage = {rt, rd};
+            return true;
+        case 0x04: // SLLV.
+        case 0x06: // SRLV.
+        case 0x07: // SRAV.
+        case 0x21: // ADDU.
+        case 0x23: // SUBU.
+        case 0x24: // AND.
+        case 0x25: // OR.
+        case 0x26: // XOR.
+        case 0x27: // NOR.
+        case 0x2A: // SLT.
+        case 0x2B: // SLTU.
+            usage = {rs | rt, rd};
+            return true;
+        default:
+            return false;
+        }
+    }
+    case 0x09: // ADDIU.
+    case 0x0A: // SLTI.
+    case 0x0B: // SLTIU.
+    case 0x0C: // ANDI.
+    case 0x0D: // ORI.
+    case 0x0E: // XORI.
+    case 0x20: // LB.
+    case 0x21: // LH.
+    case 0x23: // LW.
+    case 0x24: // LBU.
+    case 0x25: // LHU.
+        usage = {rs, rt};
+        return true;
+    case 0x0F: // LUI.
+        usage = {0, rt};
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns the register usage of a conditional I-type branch, or false if
+/// the instruction is not one (jumps and linking branches are not allowed).
+inline bool get_branch_register_usage(const MipsInstruction inst, RegisterUsage& usage)
+{
+    switch (inst.opcode())
+    {
+    case 0x01: // REGIMM.
+    {
+        // BLTZ, BGEZ, BLTZL, BGEZL.
+        if (inst.rt() > 0x03)
+            return false;
+        usage = {1u << inst.rs(), 0};
+        return true;
+    }
+    case 0x04: // BEQ.
+    case 0x05: // BNE.
+    case 0x14: // BEQL.
+    case 0x15: // BNEL.
+        usage = {(1u << inst.rs()) | (1u << inst.rt()), 0};
+        return true;
+    case 0x06: // BLEZ.
+    case 0x07: // BGTZ.
+    case 0x16: // BLEZL.
+    case 0x17: // BGTZL.
+        usage = {1u << inst.rs(), 0};
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns if the instruction is one of the loads allowed in an idle loop (see get_register_usage()).
+inline bool is_load(const MipsInstruction inst)
+{
+    switch (inst.opcode())
+    {
+    case 0x20: // LB.
+    case 0x21: // LH.
+    case 0x23: // LW.
+    case 0x24: // LBU.
+    case 0x25: // LHU.
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns if the raw instructions, starting at the address given, form an
+/// idle loop: the second last instruction must be a branch back to the start,
+/// followed by its delay slot. Addresses may be either virtual or physical,
+/// as only relative branches are considered.
+/// The loads made by the loop are returned through loads.
+inline bool is_idle_loop(const uword* raw_instructions, const size_t count, const uptr start_address, Loads& loads)
+{
+    loads.count = 0;
+
+    if (count < 2 || count > MAX_LOOP_LENGTH)
+        return false;
+
+    const size_t branch_index = count - 2;
+    const MipsInstruction branch(raw_instructions[branch_index]);
+    RegisterUsage branch_usage;
+    if (!get_branch_register_usage(branch, branch_usage))
+        return false;
+
+    const uptr branch_address = start_address + static_cast<uptr>(branch_index * Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+    const uptr target_address = branch_address + Constants::MIPS::SIZE_MIPS_INSTRUCTION + (static_cast<sword>(branch.s_imm()) << 2);
+    if (target_address != start_address)
+        return false;
+
+    // Gather the register usage (in program order - the branch condition is
+    // evaluated before the delay slot runs).
+    std::array<RegisterUsage, MAX_LOOP_LENGTH> usages;
+    uword written = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i == branch_index)
+            usages[i] = branch_usage;
+        else if (!get_register_usage(MipsInstruction(raw_instructions[i]), usages[i]))
+            return false;
+        written |= usages[i].writes;
+    }
+
+    // No state may be carried over from the previous iteration ($zero is constant).
+    uword written_this_iteration = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        const RegisterUsage& usage = usages[i];
+        if (usage.reads & written & ~written_this_iteration)
+            return false;
+        written_this_iteration |= usage.writes;
+    }
+
+    // Record the loads, which need a base register that still holds the
+    // address at the end of the iteration.
+    for (size_t i = 0; i < count; i++)
+    {
+        const MipsInstruction inst(raw_instructions[i]);
+        if (i == branch_index || !is_load(inst))
+            continue;
+
+        uword written_after = 0;
+        for (size_t j = i + 1; j < count; j++)
+            written_after |= usages[j].writes;
+        if (written_after & (1u << inst.rs()))
+            return false;
+
+        loads.loads[loads.count++] = {inst.rs(), inst.s_imm()};
+    }
+
+    return true;
+}
+
+/// Idle loop skip statistics, per loop start PC.
+class Stats
+{
+public:
+    struct Entry
+    {
+        size_t number_skips;
+        udword ticks_skipped;
+    };
+
+    Stats() :
+        number_skips(0),
+        ticks_skipped(0)
+    {
+    }
+
+    void record(const uptr pc, const int ticks)
+    {
+        Entry& entry = entries[pc];
+        entry.number_skips++;
+        entry.ticks_skipped += static_cast<udword>(ticks);
+        number_skips++;
+        ticks_skipped += static_cast<udword>(ticks);
+    }
+
+    /// Returns the entries with the most ticks skipped first, up to the number given.
+    std::vector<std::pair<uptr, Entry>> get_top_entries(const size_t number) const
+    {
+        std::vector<std::pair<uptr, Entry>> sorted(entries.begin(), entries.end());
+        std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.ticks_skipped > rhs.second.ticks_skipped;
+        });
+        if (sorted.size() > number)
+            sorted.resize(number);
+        return sorted;
+    }
+
+    size_t get_number_skips() const
+    {
+        return number_skips;
+    }
+
+    udword get_ticks_skipped() const
+    {
+        return ticks_skipped;
+    }
+
+private:
+    std::unordered_map<uptr, Entry> entries;
+    size_t number_skips;
+    udword ticks_skipped;
+};
+} // namespace MipsIdleLoop
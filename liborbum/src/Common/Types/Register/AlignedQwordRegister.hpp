@@ -0,0 +1,229 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/Register/QwordRegister.hpp"
+
+/// Flat, 16-byte aligned qword register, for the register files of the
+/// execution units (ie: EE Core GPR's, VU VF's) which are accessed on every
+/// instruction.
+/// Unlike SizedQwordRegister, the accessors are not virtual (so they can be
+/// inlined and vectorised), and the register is exactly 16 bytes (an array
+/// of them is a contiguous, aligned register file). There is no read-only
+/// mode - constant registers (ie: GPR $zero) are maintained by the owner.
+/// Use MapperAlignedQwordRegister to map the register on a bus.
+class alignas(16) AlignedQwordRegister
+{
+public:
+    AlignedQwordRegister(const uqword initial_value = uqword()) :
+        q(initial_value)
+    {
+    }
+
+    /// Initialise register (to 0).
+    void initialize()
+    {
+        q = uqword();
+    }
+
+    /// Read/write functions to access the register.
+    ubyte read_ubyte(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        return q.ub[offset];
+    }
+
+    void write_ubyte(const size_t offset, const ubyte value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        q.ub[offset] = value;
+    }
+
+    uhword read_uhword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        return q.uh[offset];
+    }
+
+    void write_uhword(const size_t offset, const uhword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        q.uh[offset] = value;
+    }
+
+    uword read_uword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_WORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        return q.uw[offset];
+    }
+
+    void write_uword(const size_t offset, const uword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_WORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        q.uw[offset] = value;
+    }
+
+    udword read_udword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_DWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        return q.ud[offset];
+    }
+
+    void write_udword(const size_t offset, const udword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_DWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access AlignedQwordRegister with an invalid offset.");
+#endif
+
+        q.ud[offset] = value;
+    }
+
+    uqword read_uqword() const
+    {
+        return q;
+    }
+
+    void write_uqword(const uqword value)
+    {
+        q = value;
+    }
+
+    /// Read/write floats - wrappers around read/write uword.
+    f32 read_float(const size_t offset) const
+    {
+        const uword raw = read_uword(offset);
+        return *reinterpret_cast<const f32*>(&raw);
+    }
+
+    void write_float(const size_t offset, const f32 value)
+    {
+        write_uword(offset, *reinterpret_cast<const uword*>(&value));
+    }
+
+    /// Returns the underlying (16-byte aligned) storage, for vectorised access.
+    ubyte* data()
+    {
+        return q.ub;
+    }
+
+    const ubyte* data() const
+    {
+        return q.ub;
+    }
+
+private:
+    /// Primitive (sized) storage for register.
+    uqword q;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(q)
+        );
+    }
+};
+
+static_assert(sizeof(AlignedQwordRegister) == NUMBER_BYTES_IN_QWORD, "AlignedQwordRegister must be exactly a qword.");
+
+/// Maps an AlignedQwordRegister onto a bus (as a QwordRegister).
+class MapperAlignedQwordRegister : public QwordRegister
+{
+public:
+    MapperAlignedQwordRegister() :
+        qword_register(nullptr)
+    {
+    }
+
+    /// Initialise register (initialize underlying register).
+    void initialize() override
+    {
+        qword_register->initialize();
+    }
+
+    ubyte read_ubyte(const size_t offset) override
+    {
+        return qword_register->read_ubyte(offset);
+    }
+
+    void write_ubyte(const size_t offset, const ubyte value) override
+    {
+        qword_register->write_ubyte(offset, value);
+    }
+
+    uhword read_uhword(const size_t offset) override
+    {
+        return qword_register->read_uhword(offset);
+    }
+
+    void write_uhword(const size_t offset, const uhword value) override
+    {
+        qword_register->write_uhword(offset, value);
+    }
+
+    uword read_uword(const size_t offset) override
+    {
+        return qword_register->read_uword(offset);
+    }
+
+    void write_uword(const size_t offset, const uword value) override
+    {
+        qword_register->write_uword(offset, value);
+    }
+
+    udword read_udword(const size_t offset) override
+    {
+        return qword_register->read_udword(offset);
+    }
+
+    void write_udword(const size_t offset, const udword value) override
+    {
+        qword_register->write_udword(offset, value);
+    }
+
+    uqword read_uqword() override
+    {
+        return qword_register->read_uqword();
+    }
+
+    void write_uqword(const uqword value) override
+    {
+        qword_register->write_uqword(value);
+    }
+
+    /// Reference to mapped qword register.
+    AlignedQwordRegister* qword_register;
+};
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/Register/SizedWordRegister.hpp"
+#include "Common/Types/ScopeLock.hpp"
+
+/// Counter register that is derived on demand from a master cycle counter,
+/// instead of being incremented on every clock.
+/// While counting, the value is the count at the last rebase plus the number
+/// of increments since then (the master cycles elapsed times the rate),
+/// wrapped around at the range (overflow) and optionally reset to 0 once it
+/// reaches a target (ie: timer ZRET mode). Compare and overflow conditions
+/// are computed analytically, so the owner can schedule an event at the
+/// master cycle they next occur instead of checking every increment.
+/// Writes (and range/target changes) rebase the count at the current cycle.
+/// The counting state is accessed by both the timers controller and the CPU
+/// bus, so all accesses are scope locked (a read can't see a half done rebase).
+class LazyCountRegister : public SizedWordRegister, public ScopeLock
+{
+public:
+    /// Returned by the next event functions when there is none.
+    static constexpr udword NO_EVENT = ~static_cast<udword>(0);
+
+    LazyCountRegister(const udword range) :
+        master_cycle(nullptr),
+        range(range),
+        increments_per_cycle(0.0),
+        compare(0),
+        reset_on_compare(false),
+        start_cycle(0),
+        start_count(0),
+        checked_increments(0),
+        is_rebased(false)
+    {
+    }
+
+    /// Sets the master cycle counter the count is derived from.
+    void set_master_cycle_source(const std::atomic<udword>* master_cycle)
+    {
+        this->master_cycle = master_cycle;
+    }
+
+    /// Returns if the count is being derived from the master cycle counter.
+    bool is_counting() const
+    {
+        auto _lock = scope_lock();
+        return increments_per_cycle > 0.0;
+    }
+
+    /// Starts counting from the current value at the rate given (increments
+    /// per master cycle), checking against the compare value given.
+    void start_counting(const double increments_per_cycle, const uword compare, const bool reset_on_compare)
+    {
+        auto _lock = scope_lock();
+        const uword value = read_uword();
+        this->increments_per_cycle = increments_per_cycle;
+        this->compare = compare;
+        this->reset_on_compare = reset_on_compare;
+        rebase(value);
+    }
+
+    /// Stops counting, keeping the current value.
+    void stop_counting()
+    {
+        auto _lock = scope_lock();
+        const uword value = read_uword();
+        increments_per_cycle = 0.0;
+        SizedWordRegister::write_uword(value);
+    }
+
+    /// Returns the compare value used for the events, see start_counting().
+    uword get_compare() const
+    {
+        auto _lock = scope_lock();
+        return compare;
+    }
+
+    /// Returns if the count was written to (rebased) since the last call.
+    /// The owner should reschedule its events when this happens.
+    bool is_rebased_and_reset()
+    {
+        auto _lock = scope_lock();
+        const bool temp = is_rebased;
+        is_rebased = false;
+        return temp;
+    }
+
+    /// Returns if the compare value was reached and/or the count overflowed
+    /// since the last call (or since counting started).
+    void check_events(bool& reached_compare, bool& overflowed)
+    {
+        auto _lock = scope_lock();
+        reached_compare = false;
+        overflowed = false;
+        if (!is_counting())
+            return;
+
+        const udword increments = get_increments();
+        reached_compare = next_compare_increment(checked_increments) <= increments;
+        overflowed = next_overflow_increment(checked_increments) <= increments;
+        checked_increments = increments;
+    }
+
+    /// Returns the master cycle at which the next compare or overflow event
+    /// (after the last check_events() call) occurs, or NO_EVENT if there is none.
+    udword get_next_event_cycle() const
+    {
+        auto _lock = scope_lock();
+        if (!is_counting())
+            return NO_EVENT;
+
+        const udword next_increment = std::min(next_compare_increment(checked_increments), next_overflow_increment(checked_increments));
+        if (next_increment == NO_EVENT)
+            return NO_EVENT;
+
+        // Find the first cycle the increment has happened by (the conversion
+        // back may be off by one either way due to rounding).
+        udword cycle = start_cycle + static_cast<udword>(std::ceil(static_cast<double>(next_increment) / increments_per_cycle));
+        while (increments_at(cycle) < next_increment)
+            cycle++;
+        while ((cycle > start_cycle) && (increments_at(cycle - 1) >= next_increment))
+            cycle--;
+        return cycle;
+    }
+
+    /// Initialise register (stops counting).
+    void initialize() override
+    {
+        auto _lock = scope_lock();
+        SizedWordRegister::initialize();
+        increments_per_cycle = 0.0;
+        is_rebased = false;
+    }
+
+    /// Read/write functions to access the register.
+    /// Reads return the current count, writes rebase the count.
+    ubyte read_ubyte(const size_t offset) override
+    {
+        auto _lock = scope_lock();
+        sync();
+        return SizedWordRegister::read_ubyte(offset);
+    }
+
+    void write_ubyte(const size_t offset, const ubyte value) override
+    {
+        auto _lock = scope_lock();
+        sync();
+        SizedWordRegister::write_ubyte(offset, value);
+        rebase(SizedWordRegister::read_uword());
+    }
+
+    uhword read_uhword(const size_t offset) override
+    {
+        auto _lock = scope_lock();
+        sync();
+        return SizedWordRegister::read_uhword(offset);
+    }
+
+    void write_uhword(const size_t offset, const uhword value) override
+    {
+        auto _lock = scope_lock();
+        sync();
+        SizedWordRegister::write_uhword(offset, value);
+        rebase(SizedWordRegister::read_uword());
+    }
+
+    uword read_uword() override
+    {
+        auto _lock = scope_lock();
+        if (!is_counting())
+            return SizedWordRegister::read_uword();
+        return static_cast<uword>(value_at(get_increments()));
+    }
+
+    void write_uword(const uword value) override
+    {
+        auto _lock = scope_lock();
+        rebase(value);
+    }
+
+private:
+    /// Master cycle counter, see set_master_cycle_source().
+    const std::atomic<udword>* master_cycle;
+
+    /// Count range (the count wraps around to 0 when it reaches this).
+    udword range;
+
+    /// Counting parameters, see start_counting().
+    /// A rate of 0 means the count is not being derived (holds its value).
+    double increments_per_cycle;
+    uword compare;
+    bool reset_on_compare;
+
+    /// Master cycle and count at the last rebase.
+    udword start_cycle;
+    udword start_count;
+
+    /// Increments (since the last rebase) up to which events have been checked.
+    udword checked_increments;
+
+    /// Set on rebase, see is_rebased_and_reset().
+    bool is_rebased;
+
+    udword get_current_cycle() const
+    {
+        return master_cycle ? master_cycle->load(std::memory_order_relaxed) : 0;
+    }
+
+    udword increments_at(const udword cycle) const
+    {
+        return static_cast<udword>(static_cast<double>(cycle - start_cycle) * increments_per_cycle);
+    }
+
+    udword get_increments() const
+    {
+        return increments_at(get_current_cycle());
+    }
+
+    /// Restarts counting from the value at the current cycle.
+    void rebase(const uword value)
+    {
+        SizedWordRegister::write_uword(value);
+        start_cycle = get_current_cycle();
+        start_count = static_cast<udword>(value) % range;
+        checked_increments = 0;
+        is_rebased = true;
+    }
+
+    /// Writes the current count to the backing storage (for partial accesses).
+    void sync()
+    {
+        if (is_counting())
+            SizedWordRegister::write_uword(read_uword());
+    }
+
+    /// Returns if the count resets on reaching the compare value. A compare
+    /// value of 0 is never reached by incrementing (the count overflows
+    /// instead), and neither is one outside of the range.
+    bool has_reset_target() const
+    {
+        return reset_on_compare && (compare > 0) && (compare < range);
+    }
+
+    /// Returns the count after the number of increments (since the last rebase).
+    udword value_at(const udword increments) const
+    {
+        if (!has_reset_target())
+            return (start_count + increments) % range;
+
+        // Counts up to the compare value (which resets it), unless it starts
+        // above it, in which case it first runs up to the overflow.
+        if (start_count < compare)
+            return (start_count + increments) % compare;
+
+        const udword overflow_increment = range - start_count;
+        if (increments < overflow_increment)
+            return start_count + increments;
+        return (increments - overflow_increment) % compare;
+    }
+
+    /// Returns the first increment (1-based, after the one given) at which
+    /// a periodic event occurs, or NO_EVENT.
+    static udword next_periodic_increment(const udword after, const udword first, const udword period)
+    {
+        if (after < first)
+            return first;
+        if (!period)
+            return NO_EVENT;
+        return first + ((after - first) / period + 1) * period;
+    }
+
+    udword next_compare_increment(const udword after) const
+    {
+        if (compare >= range)
+            return NO_EVENT;
+
+        if (!has_reset_target())
+        {
+            const udword first = (compare >= start_count) ? (compare - start_count) : (compare + range - start_count);
+            return next_periodic_increment(after, first ? first : range, range);
+        }
+
+        if (start_count < compare)
+            return next_periodic_increment(after, compare - start_count, compare);
+        return next_periodic_increment(after, range - start_count + compare, compare);
+    }
+
+    udword next_overflow_increment(const udword after) const
+    {
+        if (!has_reset_target())
+            return next_periodic_increment(after, range - start_count, range);
+
+        if (start_count < compare)
+            return NO_EVENT;
+        return next_periodic_increment(after, range - start_count, 0);
+    }
+
+public:
+    /// Saves the current count (counting state is restored by the owner).
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        auto _lock = scope_lock();
+        sync();
+        archive(
+            cereal::base_class<SizedWordRegister>(this)
+        );
+    }
+};
@@ -10,12 +10,12 @@ class ScopeLock
 {
 public:
     /// Locks the mutex and returns a guard.
-    std::unique_lock<std::recursive_mutex> scope_lock()
+    std::unique_lock<std::recursive_mutex> scope_lock() const
     {
         return std::unique_lock<std::recursive_mutex>(mutex);
     }
 
 private:
-    /// Recursive mutex.
-    std::recursive_mutex mutex;
+    /// Recursive mutex (lockable from const accessors).
+    mutable std::recursive_mutex mutex;
 };
\ No newline at end of file
@@ -1,77 +1,147 @@
 #pragma once
 
-#include <functional>
-#include <utility>
+#include <array>
+#include <memory>
+#include <optional>
 
-#include <Caches.hpp>
-
-#include "Common/Types/Mips/MipsCoprocessor0.hpp"
 #include "Common/Types/Mips/MmuAccess.hpp"
+#include "Common/Types/Primitive.hpp"
 
-using OperatingContext = MipsCoprocessor0::OperatingContext;
-
-/// Emulator translation cache, used to speed up virtual address translation.
+/// Emulator translation cache (software TLB), used to speed up virtual address translation.
 /// Based around the MIPS translation process, using the current operating
 /// context and instruction/data access. This works as there is a minimum TLB
 /// page size (ie: 4KB on the EE Core), and everything else is a multiple of it.
 /// The unmapped memory regions are usually aligned to this value (care must be taken).
-template <int Size, typename AddressTy, AddressTy CacheMask, template <int, typename, typename> class CacheTy>
+///
+/// The cache is page indexed over the whole 32-bit virtual address space, as a
+/// 2-level table (1024 directory entries x 1024 page entries), where the page
+/// tables are allocated on first use. A lookup is therefore a couple of array
+/// indexes, and every page touched stays cached until the next flush.
+///
+/// Results are kept separately for each translation context (a value in the range
+/// [0, NumberContexts) supplied by the caller, derived from the COP0 operating
+/// context), so switching contexts (ie: on an exception) does not require a flush.
+/// Only changes to the translation process itself (ie: TLB writes, ASID changes)
+/// require a flush. Flushing is done by bumping a generation counter rather than
+/// clearing the tables - an entry is only valid if its generation matches.
+///
+/// Entries record if the translation has been performed for a read and/or a
+/// write, as the result of the fallback may differ (ie: TLB modified exception),
+/// so a write through a page only ever read from will invoke the fallback.
+template <int NumberContexts>
 class TranslationCache
 {
-private:
-    using CacheTy_ = CacheTy<Size, AddressTy, AddressTy>;
-
 public:
-    using FallbackFn = std::function<std::optional<AddressTy>(const AddressTy, const MmuRwAccess)>;
+    static constexpr int PAGE_BITS = 12;
+    static constexpr uptr PAGE_MASK = (static_cast<uptr>(1) << PAGE_BITS) - 1;
+    static constexpr int TABLE_BITS = 10;
+    static constexpr int DIRECTORY_BITS = 32 - PAGE_BITS - TABLE_BITS;
 
     TranslationCache() :
-        fallback_fn(nullptr)
+        generation(1)
+#if defined(BUILD_DEBUG)
+        ,
+        hits(0),
+        misses(0)
+#endif
     {
     }
 
-    /// Performs the virtual address to physical address translation.
-    std::optional<AddressTy> lookup(const AddressTy virtual_address, const MmuRwAccess rw_access)
+    /// Performs the virtual address to physical address translation, within the
+    /// given translation context. If the page is not cached, the fallback is
+    /// invoked with the virtual address and the access type, which should return
+    /// the physical address (or std::nullopt on error).
+    template <typename FallbackFn>
+    std::optional<uptr> lookup(const uptr virtual_address, const MmuRwAccess rw_access, const int context, FallbackFn&& fallback)
     {
-        const AddressTy key = virtual_address & (~CacheMask);
-
-        std::optional<AddressTy> result = cache.get(key);
-
+        const uword access_flag = (rw_access == READ) ? FLAG_READ : FLAG_WRITE;
+        const uptr page = virtual_address >> PAGE_BITS;
+
+        auto& table = directory[context][page >> TABLE_BITS];
+        if (table)
+        {
+            const Entry& entry = (*table)[page & TABLE_MASK];
+            if ((entry.generation == generation) && (entry.value & access_flag))
+            {
+#if defined(BUILD_DEBUG)
+                hits++;
+#endif
+                return std::make_optional((entry.value & ~PAGE_MASK) | (virtual_address & PAGE_MASK));
+            }
+        }
+
+#if defined(BUILD_DEBUG)
+        misses++;
+#endif
+
+        std::optional<uptr> result = fallback(virtual_address, rw_access);
         if (!result)
-            result = handle_fallback(key, rw_access);
+            return std::nullopt;
+
+        // The fallback may have flushed the cache (eg: updated the ASID), so the
+        // generation is only read here.
+        if (!table)
+            table = std::make_unique<Table>();
 
-        if (result)
-            *result = (*result | (virtual_address & CacheMask));
+        const uptr physical_page = *result & ~PAGE_MASK;
+        Entry& entry = (*table)[page & TABLE_MASK];
+        if ((entry.generation != generation) || ((entry.value & ~PAGE_MASK) != physical_page))
+            entry.value = physical_page;
+        entry.value |= access_flag;
+        entry.generation = generation;
 
         return result;
     }
 
-    /// Flushes the caches of all translation results.
+    /// Flushes the caches of all translation results, in all contexts.
     void flush()
     {
-        cache = CacheTy_();
+        generation++;
+
+        // Upon wrap around, old entries could become valid again - clear everything.
+        if (!generation)
+        {
+            for (auto& context_directory : directory)
+                for (auto& table : context_directory)
+                    table.reset();
+            generation = 1;
+        }
     }
 
-    /// Sets the translation fallback function.
-    void set_fallback_lookup(const FallbackFn& fallback_fn)
+#if defined(BUILD_DEBUG)
+    /// Translation cache statistics.
+    size_t get_hits() const
     {
-        this->fallback_fn = fallback_fn;
+        return hits;
     }
 
+    size_t get_misses() const
+    {
+        return misses;
+    }
+#endif
+
 private:
-    /// Performs a fallback lookup and inserts the result into the cache if its found.
-    /// Returns the fallback result.
-    std::optional<AddressTy> handle_fallback(const AddressTy key, const MmuRwAccess rw_access)
+    static constexpr uword FLAG_READ = 1 << 0;
+    static constexpr uword FLAG_WRITE = 1 << 1;
+    static constexpr uptr TABLE_MASK = (static_cast<uptr>(1) << TABLE_BITS) - 1;
+
+    /// Cached translation for a page.
+    /// Value format: [physical page address (upper bits) | access flags (lower bits)].
+    struct Entry
     {
-        if (!fallback_fn)
-            throw std::runtime_error("No fallback address translation function defined");
+        uword value;
+        uword generation;
+    };
 
-        std::optional<AddressTy> result = fallback_fn(key, rw_access);
-        if (result)
-            cache.insert(key, *result);
+    using Table = std::array<Entry, static_cast<size_t>(1) << TABLE_BITS>;
+    using Directory = std::array<std::unique_ptr<Table>, static_cast<size_t>(1) << DIRECTORY_BITS>;
 
-        return result;
-    }
+    std::array<Directory, NumberContexts> directory;
+    uword generation;
 
-    FallbackFn fallback_fn;
-    CacheTy_ cache;
-};
\ No newline at end of file
+#if defined(BUILD_DEBUG)
+    size_t hits;
+    size_t misses;
+#endif
+};
@@ -24,6 +24,14 @@ public:
 
     virtual void handle_event(const ControllerEvent& e) = 0;
 
+    /// Returns if the controller is sent a time event on every run.
+    /// Controllers that are driven entirely by scheduled events (see
+    /// EventScheduler) return false, and are not run at all while idle.
+    virtual bool is_time_driven() const
+    {
+        return true;
+    }
+
     void handle_event_marshall_(const ControllerEvent& e)
     {
         // Used for inserting pre/post-event hooks (debugging).
@@ -18,10 +18,7 @@ void CCdvd::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
-        while (ticks_remaining > 0)
-            ticks_remaining -= time_step(ticks_remaining);
-
+        handle_commands();
         handle_rtc_increment(event.data.time_us);
 
         break;
@@ -33,24 +30,7 @@ void CCdvd::handle_event(const ControllerEvent& event)
     }
 }
 
-int CCdvd::time_to_ticks(const double time_us)
-{
-    int ticks = static_cast<int>(time_us / 1.0e6 * Constants::CDVD::CDVD_CLK_SPEED * core->get_options().system_bias_cdvd);
-
-    if (ticks < 5)
-    {
-        static bool warned = false;
-        if (!warned)
-        {
-            BOOST_LOG(Core::get_logger()) << "CDVD ticks too low - increase time delta";
-            warned = true;
-        }
-    }
-
-    return ticks;
-}
-
-int CCdvd::time_step(const int ticks_available)
+void CCdvd::handle_commands()
 {
     auto& r = core->get_resources();
 
@@ -77,8 +57,6 @@ int CCdvd::time_step(const int ticks_available)
         r.cdvd.s_rdy_din.ready.insert_field(CdvdRegister_Ns_Rdy_Din::READY_BUSY, 0);
         r.cdvd.s_command.write_latch = false;
     }
-
-    return 1;
 }
 
 void CCdvd::handle_rtc_increment(const double time_us)
@@ -15,11 +15,10 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
-    /// Converts a time duration into the number of ticks that would have occurred.
-    int time_to_ticks(const double time_us);
-
-    /// Checks and processes the CDVD state for any actions to be performed.
-    int time_step(const int ticks_available);
+    /// Processes the pending N-type and S-type commands, if any.
+    /// Commands complete immediately, so this is done once per time event
+    /// rather than per CDVD clock tick (runs may be shorter than a tick).
+    void handle_commands();
 
     /// Increments the RTC state by the microseconds specified.
     void handle_rtc_increment(const double time_us);
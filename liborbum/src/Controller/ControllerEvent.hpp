@@ -9,12 +9,14 @@ struct ControllerEvent
     {
         Time,
         HBlank,
-        VBlank
+        VBlank,
+        Scheduled
     } type;
 
     /// Additional data, context determined from type.
     union {
         double time_us; // Time event: time passed in microseconds.
         int amount;     // HBlank, VBlank: amount of times it occurred.
+        int id;         // Scheduled: controller defined identifier (ie: timer unit).
     } data;
 };
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sstream>
 
 #include <boost/format.hpp>
@@ -19,12 +20,6 @@ std::atomic_bool DEBUG_IN_CONTROLLER_EECORE = false;
 CEeCore::CEeCore(Core* core) :
     CController(core)
 {
-    auto translation_fallback = [this](const uptr virtual_address, const MmuRwAccess rw_access) {
-        return translate_address_fallback(virtual_address, rw_access);
-    };
-
-    translation_cache_data.set_fallback_lookup(translation_fallback);
-    translation_cache_inst.set_fallback_lookup(translation_fallback);
 }
 
 CEeCore::~CEeCore()
@@ -34,6 +29,11 @@ CEeCore::~CEeCore()
     BOOST_LOG(Core::get_logger()) << boost::format("EE Core exiting @ Cycle = 0x%llX, PC = 0x%08X.")
                                          % DEBUG_LOOP_COUNTER
                                          % r.ee.core.r5900.pc.read_uword();
+    BOOST_LOG(Core::get_logger()) << boost::format("EE Core translation cache: data hits = %d, data misses = %d, inst hits = %d, inst misses = %d.")
+                                         % translation_cache_data.get_hits()
+                                         % translation_cache_data.get_misses()
+                                         % translation_cache_inst.get_hits()
+                                         % translation_cache_inst.get_misses();
 #endif
 }
 
@@ -122,7 +122,7 @@ void CEeCore::handle_interrupt_check()
     // Interrupt exception checking follows the process on page 74 of the EE Core Users Manual.
     if (!cop0.status.interrupts_masked)
     {
-        uword ip_cause = cop0.cause.extract_field(EeCoreCop0Register_Cause::IP);
+        uword ip_cause = cop0.cause.get_irq_lines();
         uword im_status = cop0.status.extract_field(EeCoreCop0Register_Status::IM);
         if (ip_cause & im_status)
         {
@@ -136,6 +136,44 @@ void CEeCore::handle_interrupt_check()
     }
 }
 
+bool CEeCore::is_interrupt_pending()
+{
+    auto& r = core->get_resources();
+    auto& cop0 = r.ee.core.cop0;
+
+    if (cop0.cause.get_irq_lines() & cop0.status.extract_field(EeCoreCop0Register_Status::IM))
+        return true;
+
+    auto _lock = r.ee.intc.stat.scope_lock();
+    return (r.ee.intc.stat.read_uword() & r.ee.intc.mask.read_uword()) != 0;
+}
+
+int CEeCore::ticks_to_next_event(const int ticks_remaining)
+{
+    // The time slice ends at the current scheduler cycle, and events up to it
+    // were delivered at the start - only events scheduled since can fall within it.
+    auto& scheduler = core->get_scheduler();
+    const udword slice_end_cycle = scheduler.get_current_cycle();
+    udword next_event_cycle;
+    if (!scheduler.get_next_event_cycle(next_event_cycle) || next_event_cycle >= slice_end_cycle)
+        return ticks_remaining;
+
+    const double time_after_event_us = EventScheduler::cycles_to_time(slice_end_cycle - next_event_cycle);
+    const int ticks_after_event = static_cast<int>(time_after_event_us / 1.0e6 * Constants::EE::EECore::EECORE_CLK_SPEED * core->get_options().system_bias_eecore);
+    return std::max(0, ticks_remaining - ticks_after_event);
+}
+
+void CEeCore::handle_asid_update(const uword previous_asid)
+{
+    auto& r = core->get_resources();
+
+    if (r.ee.core.cop0.entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID) != previous_asid)
+    {
+        translation_cache_data.flush();
+        translation_cache_inst.flush();
+    }
+}
+
 #if defined(BUILD_DEBUG)
 void CEeCore::debug_print_interrupt_info()
 {
@@ -426,9 +464,8 @@ void CEeCore::handle_exception(const EeCoreException exception)
     if (exception != EeCoreException::EX_INTERRUPT)
         pc.offset(-static_cast<sword>(Constants::MIPS::SIZE_MIPS_INSTRUCTION));
 
-    // Flush translation caches (context change).
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
+    // No need to flush the translation caches - the context change is handled
+    // by the translation context tag (see COP0.Status).
 }
 
 std::optional<uptr> CEeCore::translate_address_data(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -455,7 +492,10 @@ std::optional<uptr> CEeCore::translate_address_data(const uptr virtual_address,
 	}
 #endif
 
-    return translation_cache_data.lookup(virtual_address, rw_access);
+    auto& r = core->get_resources();
+    return translation_cache_data.lookup(virtual_address, rw_access, r.ee.core.cop0.status.translation_context, [this](const uptr virtual_address, const MmuRwAccess rw_access) {
+        return translate_address_fallback(virtual_address, rw_access);
+    });
 }
 
 std::optional<uptr> CEeCore::translate_address_inst(const uptr virtual_address)
@@ -481,7 +521,10 @@ std::optional<uptr> CEeCore::translate_address_inst(const uptr virtual_address)
     }
 #endif
 
-    return translation_cache_inst.lookup(virtual_address, READ);
+    auto& r = core->get_resources();
+    return translation_cache_inst.lookup(virtual_address, READ, r.ee.core.cop0.status.translation_context, [this](const uptr virtual_address, const MmuRwAccess rw_access) {
+        return translate_address_fallback(virtual_address, rw_access);
+    });
 }
 
 std::optional<uptr> CEeCore::translate_address_fallback(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -503,7 +546,11 @@ std::optional<uptr> CEeCore::translate_address_fallback(const uptr virtual_addre
 
         // Set only if tlb entry index valid.
         if (tlb_entry_index > 0)
+        {
+            const uword previous_asid = cop0.entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID);
             cop0.entryhi.insert_field(EeCoreCop0Register_EntryHi::ASID, tlb.tlb_entry_at(tlb_entry_index).asid);
+            handle_asid_update(previous_asid);
+        }
 
         // Pass exception to handler.
         handle_exception(exception);
@@ -2,12 +2,11 @@
 
 #include <optional>
 
-#include <Caches.hpp>
-
 #include "Common/Types/Mips/MmuAccess.hpp"
 #include "Common/Types/Primitive.hpp"
 #include "Common/Types/TranslationCache/TranslationCache.hpp"
 #include "Controller/CController.hpp"
+#include "Resources/Ee/Core/EeCoreCop0Registers.hpp"
 #include "Resources/Ee/Core/EeCoreException.hpp"
 
 class Core;
@@ -52,8 +51,25 @@ protected:
     void handle_count_update(const int cycles);
 
     /// Checks if any of the interrupt lines have an IRQ pending, and raises an interrupt exception.
+    /// The IRQ lines are raised/cleared by the interrupt sources as their state changes, so this
+    /// is cheap enough to call before every block (a lock free load, plus the Status register).
     void handle_interrupt_check();
 
+    /// Returns if an interrupt is pending, either on the COP0 IRQ lines (not yet
+    /// taken), or at the INTC (not yet passed on to the COP0).
+    /// Idle loop skips (see MipsIdleLoop) stop here, as the interrupt ends the loop.
+    bool is_interrupt_pending();
+
+    /// Returns the number of ticks out of the ticks remaining in the time slice
+    /// that run before the next scheduled event (see EventScheduler).
+    /// Idle loop skips stop here, as the event may change the memory polled.
+    int ticks_to_next_event(const int ticks_remaining);
+
+    /// Flushes the translation caches if the COP0.EntryHi ASID differs from the
+    /// previous value given, as non-global TLB mappings depend on it.
+    /// To be called after anything that writes to COP0.EntryHi.
+    void handle_asid_update(const uword previous_asid);
+
 #if defined(BUILD_DEBUG)
     /// Prints debug information about interrupt sources.
     void debug_print_interrupt_info();
@@ -62,14 +78,15 @@ protected:
     /// Performs a cached translation lookup from the given virtual address
     /// and access type, and returns the physical address. If the address is not
     /// found within the cache the full lookup process will be invoked.
-    /// If the EE Core's TLB is modified, the whole cache is flushed.
+    /// If the EE Core's TLB or ASID is modified, the whole cache is flushed.
     std::optional<uptr> translate_address_data(const uptr virtual_address, const MmuRwAccess rw_access);
     std::optional<uptr> translate_address_inst(const uptr virtual_address);
 
     /// Address translation cache, see translate_address().
-    /// Note: caches will be flushed when the operating context changes or EE TLB is modified (visibility).
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_data;
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_inst;
+    /// Entries are tagged by the COP0 translation context, so they remain valid
+    /// across exceptions. Note: caches will be flushed when the EE TLB or ASID is modified (visibility).
+    TranslationCache<EeCoreCop0Register_Status::NUMBER_TRANSLATION_CONTEXTS> translation_cache_data;
+    TranslationCache<EeCoreCop0Register_Status::NUMBER_TRANSLATION_CONTEXTS> translation_cache_inst;
 
 private:
     /// Converts a time duration into the number of ticks that would have occurred.
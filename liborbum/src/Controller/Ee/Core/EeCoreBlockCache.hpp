@@ -0,0 +1,198 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Bus/BusWriteTracker.hpp"
+#include "Common/Types/Mips/MipsIdleLoop.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Ee/Core/EeCoreInstruction.hpp"
+
+/// A pre-decoded EE Core instruction.
+/// The instruction info lookup has already been performed, so the
+/// implementation index and CPI are readily available.
+struct EeCoreDecodedInstruction
+{
+    EeCoreInstruction inst;
+    int impl_index;
+    int cpi;
+};
+
+/// A basic block of pre-decoded EE Core instructions, starting at a physical
+/// address and running up to (and including) the next branch + delay slot.
+/// Blocks never cross a 4KB page boundary, so that a single page write
+/// generation is sufficient to check validity, and so that the virtual ->
+/// physical mapping stays linear across the whole block.
+struct EeCoreBlock
+{
+    /// Physical address of the first instruction.
+    uptr physical_address;
+
+    /// Page write generation at the time the block was decoded, see BusWriteTracker.
+    uword page_generation;
+
+    /// Block cache generation at the time the block was decoded, see EeCoreBlockCache::flush().
+    uword cache_generation;
+
+    /// Decoded instruction stream.
+    std::vector<EeCoreDecodedInstruction> instructions;
+
+    /// Recompiled host code for this block, or nullptr if not compiled.
+    /// See CEeCoreRecompiler.
+    void* compiled_code;
+
+    /// If the block is an idle loop (branches back to itself), and the loads
+    /// it makes, see MipsIdleLoop.
+    bool is_idle_loop;
+    MipsIdleLoop::Loads idle_loop_loads;
+};
+
+/// Block cache keyed by physical PC, used by the EE Core to avoid fetching and
+/// decoding the same instructions over and over again.
+/// Invalidation is done through generation counters rather than destroying
+/// blocks, which means it is safe to flush the cache while a block is
+/// being executed (the block is rebuilt on the next lookup).
+/// Only addresses within the bus' write tracked range (see BusWriteTracker)
+/// are able to be cached.
+class EeCoreBlockCache
+{
+public:
+    /// Maximum number of instructions in a block.
+    static constexpr size_t MAX_BLOCK_LENGTH = 64;
+
+    /// Classification of an instruction with regards to terminating a block.
+    enum class BlockEnd
+    {
+        None,     // Execution continues sequentially.
+        Branch,   // Branch or jump - the block ends after the delay slot.
+        Immediate // Control flow changes without a delay slot (ERET, SYSCALL, BREAK, etc) - the block ends here.
+    };
+
+    EeCoreBlockCache() :
+        cache_generation(0),
+        hits(0),
+        misses(0)
+    {
+    }
+
+    /// Returns a valid cached block starting at the physical address, or nullptr
+    /// if it does not exist (or was invalidated). Updates the hit/miss counters.
+    EeCoreBlock* lookup(const uptr physical_address, const BusWriteTracker& tracker)
+    {
+        auto it = blocks.find(physical_address);
+        if (it != blocks.end())
+        {
+            EeCoreBlock& block = it->second;
+            if (block.cache_generation == cache_generation
+                && block.page_generation == tracker.generation(physical_address))
+            {
+                hits++;
+                return &block;
+            }
+        }
+
+        misses++;
+        return nullptr;
+    }
+
+    /// Returns a (cleared) block entry for the physical address to be filled in
+    /// by the caller, overwriting any previous block.
+    /// Must not be called while a block is being executed.
+    EeCoreBlock& allocate(const uptr physical_address, const uword page_generation)
+    {
+        EeCoreBlock& block = blocks[physical_address];
+        block.physical_address = physical_address;
+        block.page_generation = page_generation;
+        block.cache_generation = cache_generation;
+        block.instructions.clear();
+        block.compiled_code = nullptr;
+        block.is_idle_loop = false;
+        block.idle_loop_loads.count = 0;
+        return block;
+    }
+
+    /// Invalidates all cached blocks (ie: upon a TLB change).
+    void flush()
+    {
+        cache_generation++;
+    }
+
+    /// Returns how the given instruction affects the extent of a block.
+    static BlockEnd classify(const EeCoreInstruction& inst)
+    {
+        switch (inst.opcode())
+        {
+        case 0x00: // SPECIAL.
+        {
+            switch (inst.funct())
+            {
+            case 0x08: // JR.
+            case 0x09: // JALR.
+                return BlockEnd::Branch;
+            case 0x0C: // SYSCALL.
+            case 0x0D: // BREAK.
+                return BlockEnd::Immediate;
+            default:
+                return BlockEnd::None;
+            }
+        }
+        case 0x01: // REGIMM.
+        {
+            // BLTZ, BGEZ, BLTZL, BGEZL, BLTZAL, BGEZAL, BLTZALL, BGEZALL.
+            const int rt = inst.rt();
+            return ((rt & 0x0C) == 0) ? BlockEnd::Branch : BlockEnd::None;
+        }
+        case 0x02: // J.
+        case 0x03: // JAL.
+        case 0x04: // BEQ.
+        case 0x05: // BNE.
+        case 0x06: // BLEZ.
+        case 0x07: // BGTZ.
+        case 0x14: // BEQL.
+        case 0x15: // BNEL.
+        case 0x16: // BLEZL.
+        case 0x17: // BGTZL.
+            return BlockEnd::Branch;
+        case 0x10: // COP0.
+        {
+            if (inst.rs() == 0x08) // BC0.
+                return BlockEnd::Branch;
+            if (inst.rs() == 0x10) // C0.
+            {
+                // ERET changes the PC directly, EI may unmask a pending interrupt.
+                if (inst.funct() == 0x18 || inst.funct() == 0x38)
+                    return BlockEnd::Immediate;
+            }
+            return BlockEnd::None;
+        }
+        case 0x11: // COP1.
+        case 0x12: // COP2.
+            return (inst.rs() == 0x08) ? BlockEnd::Branch : BlockEnd::None; // BC1/BC2.
+        default:
+            return BlockEnd::None;
+        }
+    }
+
+    /// Block cache statistics.
+    size_t get_hits() const
+    {
+        return hits;
+    }
+
+    size_t get_misses() const
+    {
+        return misses;
+    }
+
+    size_t get_number_blocks() const
+    {
+        return blocks.size();
+    }
+
+private:
+    std::unordered_map<uptr, EeCoreBlock> blocks;
+    uword cache_generation;
+    size_t hits;
+    size_t misses;
+};
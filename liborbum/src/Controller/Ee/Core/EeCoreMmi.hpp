@@ -0,0 +1,723 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+
+#include "Common/Simd.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Kernels for the EE Core MMI (multimedia) parallel instructions, which
+/// operate on all of the packed lanes of the 128-bit GPR's at once.
+/// Each kernel maps directly onto SSE2 instructions when the host has them,
+/// with an equivalent per-lane scalar version for other hosts (see Simd.hpp).
+/// All lanes are treated as the EE does: saturation is done at the lane
+/// width and signed/unsigned comparisons match the instruction.
+/// The operand naming follows the instruction manual: a = Rs, b = Rt.
+namespace EeCoreMmi
+{
+#if defined(SIMD_SSE2)
+inline __m128i load(const uqword& q)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&q));
+}
+
+inline uqword store(const __m128i v)
+{
+    uqword q;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&q), v);
+    return q;
+}
+
+/// Returns (mask ? x : y) for each bit.
+inline __m128i select(const __m128i mask, const __m128i x, const __m128i y)
+{
+    return _mm_or_si128(_mm_and_si128(mask, x), _mm_andnot_si128(mask, y));
+}
+#else
+template <typename T>
+T get(const uqword& q, const size_t i)
+{
+    T value;
+    std::memcpy(&value, q.ub + i * sizeof(T), sizeof(T));
+    return value;
+}
+
+template <typename T>
+void set(uqword& q, const size_t i, const T value)
+{
+    std::memcpy(q.ub + i * sizeof(T), &value, sizeof(T));
+}
+
+/// Applies the function given to each lane of type T.
+template <typename T, typename F>
+uqword map(const uqword& a, const uqword& b, F f)
+{
+    uqword d;
+    for (size_t i = 0; i < sizeof(uqword) / sizeof(T); i++)
+        set<T>(d, i, static_cast<T>(f(get<T>(a, i), get<T>(b, i))));
+    return d;
+}
+
+template <typename T, typename F>
+uqword map(const uqword& a, F f)
+{
+    return map<T>(a, a, [&f](const T x, const T) { return f(x); });
+}
+
+/// Returns the value clamped to the range of type T.
+template <typename T, typename V>
+T saturate(const V value)
+{
+    if (value > static_cast<V>(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    if (value < static_cast<V>(std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    return static_cast<T>(value);
+}
+
+/// Returns a qword made up of the lanes of type T at the indexes given.
+/// Indexes 0 -> N-1 select from a, N -> 2N-1 select from b.
+template <typename T, typename... I>
+uqword permute(const uqword& a, const uqword& b, const I... indexes)
+{
+    constexpr size_t n = sizeof(uqword) / sizeof(T);
+    const size_t lanes[] = {static_cast<size_t>(indexes)...};
+    static_assert(sizeof...(I) == n, "Permute needs an index for every lane.");
+    uqword d;
+    for (size_t i = 0; i < n; i++)
+        set<T>(d, i, (lanes[i] < n) ? get<T>(a, lanes[i]) : get<T>(b, lanes[i] - n));
+    return d;
+}
+#endif
+
+////////////////////////////////
+// Add / subtract.
+////////////////////////////////
+
+inline uqword paddb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_add_epi8(load(a), load(b)));
+#else
+    return map<ubyte>(a, b, [](const ubyte x, const ubyte y) { return x + y; });
+#endif
+}
+
+inline uqword paddh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_add_epi16(load(a), load(b)));
+#else
+    return map<uhword>(a, b, [](const uhword x, const uhword y) { return x + y; });
+#endif
+}
+
+inline uqword paddw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_add_epi32(load(a), load(b)));
+#else
+    return map<uword>(a, b, [](const uword x, const uword y) { return x + y; });
+#endif
+}
+
+inline uqword paddsb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_adds_epi8(load(a), load(b)));
+#else
+    return map<sbyte>(a, b, [](const sbyte x, const sbyte y) { return saturate<sbyte>(shword(x) + shword(y)); });
+#endif
+}
+
+inline uqword paddsh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_adds_epi16(load(a), load(b)));
+#else
+    return map<shword>(a, b, [](const shword x, const shword y) { return saturate<shword>(sword(x) + sword(y)); });
+#endif
+}
+
+inline uqword paddsw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // Overflow occurs when both operands have the same sign and the sum has
+    // the other, in which case it saturates towards the sign of the operands.
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i sum = _mm_add_epi32(x, y);
+    const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(x, y), _mm_xor_si128(x, sum)), 31);
+    const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(VALUE_SWORD_MAX));
+    return store(select(overflow, saturated, sum));
+#else
+    return map<sword>(a, b, [](const sword x, const sword y) { return saturate<sword>(sdword(x) + sdword(y)); });
+#endif
+}
+
+inline uqword paddub(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_adds_epu8(load(a), load(b)));
+#else
+    return map<ubyte>(a, b, [](const ubyte x, const ubyte y) { return saturate<ubyte>(sword(x) + sword(y)); });
+#endif
+}
+
+inline uqword padduh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_adds_epu16(load(a), load(b)));
+#else
+    return map<uhword>(a, b, [](const uhword x, const uhword y) { return saturate<uhword>(sword(x) + sword(y)); });
+#endif
+}
+
+inline uqword padduw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // A carry out occurred if the (unsigned) sum is less than an operand.
+    const __m128i bias = _mm_set1_epi32(VALUE_SWORD_MIN);
+    const __m128i x = load(a);
+    const __m128i sum = _mm_add_epi32(x, load(b));
+    const __m128i carry = _mm_cmpgt_epi32(_mm_xor_si128(x, bias), _mm_xor_si128(sum, bias));
+    return store(_mm_or_si128(sum, carry));
+#else
+    return map<uword>(a, b, [](const uword x, const uword y) { return saturate<uword>(sdword(x) + sdword(y)); });
+#endif
+}
+
+inline uqword psubb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sub_epi8(load(a), load(b)));
+#else
+    return map<ubyte>(a, b, [](const ubyte x, const ubyte y) { return x - y; });
+#endif
+}
+
+inline uqword psubh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sub_epi16(load(a), load(b)));
+#else
+    return map<uhword>(a, b, [](const uhword x, const uhword y) { return x - y; });
+#endif
+}
+
+inline uqword psubw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sub_epi32(load(a), load(b)));
+#else
+    return map<uword>(a, b, [](const uword x, const uword y) { return x - y; });
+#endif
+}
+
+inline uqword psubsb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_subs_epi8(load(a), load(b)));
+#else
+    return map<sbyte>(a, b, [](const sbyte x, const sbyte y) { return saturate<sbyte>(shword(x) - shword(y)); });
+#endif
+}
+
+inline uqword psubsh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_subs_epi16(load(a), load(b)));
+#else
+    return map<shword>(a, b, [](const shword x, const shword y) { return saturate<shword>(sword(x) - sword(y)); });
+#endif
+}
+
+inline uqword psubsw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // Overflow occurs when the operands have different signs and the
+    // difference has the sign of the subtrahend.
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i difference = _mm_sub_epi32(x, y);
+    const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(x, y), _mm_xor_si128(x, difference)), 31);
+    const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(VALUE_SWORD_MAX));
+    return store(select(overflow, saturated, difference));
+#else
+    return map<sword>(a, b, [](const sword x, const sword y) { return saturate<sword>(sdword(x) - sdword(y)); });
+#endif
+}
+
+inline uqword psubub(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_subs_epu8(load(a), load(b)));
+#else
+    return map<ubyte>(a, b, [](const ubyte x, const ubyte y) { return saturate<ubyte>(sword(x) - sword(y)); });
+#endif
+}
+
+inline uqword psubuh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_subs_epu16(load(a), load(b)));
+#else
+    return map<uhword>(a, b, [](const uhword x, const uhword y) { return saturate<uhword>(sword(x) - sword(y)); });
+#endif
+}
+
+inline uqword psubuw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // A borrow occurred if the subtrahend is (unsigned) greater.
+    const __m128i bias = _mm_set1_epi32(VALUE_SWORD_MIN);
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i borrow = _mm_cmpgt_epi32(_mm_xor_si128(y, bias), _mm_xor_si128(x, bias));
+    return store(_mm_andnot_si128(borrow, _mm_sub_epi32(x, y)));
+#else
+    return map<uword>(a, b, [](const uword x, const uword y) { return saturate<uword>(sdword(x) - sdword(y)); });
+#endif
+}
+
+inline uqword padsbh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // Subtract for the lower 4 hwords, add for the upper 4 hwords.
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i sum = _mm_add_epi16(x, y);
+    return store(_mm_unpacklo_epi64(_mm_sub_epi16(x, y), _mm_unpackhi_epi64(sum, sum)));
+#else
+    uqword d = paddh(a, b);
+    d.lo = psubh(a, b).lo;
+    return d;
+#endif
+}
+
+////////////////////////////////
+// Min / max.
+////////////////////////////////
+
+inline uqword pmaxh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_max_epi16(load(a), load(b)));
+#else
+    return map<shword>(a, b, [](const shword x, const shword y) { return (x > y) ? x : y; });
+#endif
+}
+
+inline uqword pmaxw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    return store(select(_mm_cmpgt_epi32(x, y), x, y));
+#else
+    return map<sword>(a, b, [](const sword x, const sword y) { return (x > y) ? x : y; });
+#endif
+}
+
+inline uqword pminh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_min_epi16(load(a), load(b)));
+#else
+    return map<shword>(a, b, [](const shword x, const shword y) { return (x < y) ? x : y; });
+#endif
+}
+
+inline uqword pminw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    return store(select(_mm_cmpgt_epi32(x, y), y, x));
+#else
+    return map<sword>(a, b, [](const sword x, const sword y) { return (x < y) ? x : y; });
+#endif
+}
+
+////////////////////////////////
+// Compare.
+////////////////////////////////
+
+inline uqword pceqb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpeq_epi8(load(a), load(b)));
+#else
+    return map<ubyte>(a, b, [](const ubyte x, const ubyte y) { return (x == y) ? VALUE_UBYTE_MAX : 0; });
+#endif
+}
+
+inline uqword pceqh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpeq_epi16(load(a), load(b)));
+#else
+    return map<uhword>(a, b, [](const uhword x, const uhword y) { return (x == y) ? VALUE_UHWORD_MAX : 0; });
+#endif
+}
+
+inline uqword pceqw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpeq_epi32(load(a), load(b)));
+#else
+    return map<uword>(a, b, [](const uword x, const uword y) { return (x == y) ? VALUE_UWORD_MAX : 0; });
+#endif
+}
+
+inline uqword pcgtb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpgt_epi8(load(a), load(b)));
+#else
+    return map<sbyte>(a, b, [](const sbyte x, const sbyte y) { return (x > y) ? -1 : 0; });
+#endif
+}
+
+inline uqword pcgth(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpgt_epi16(load(a), load(b)));
+#else
+    return map<shword>(a, b, [](const shword x, const shword y) { return (x > y) ? -1 : 0; });
+#endif
+}
+
+inline uqword pcgtw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_cmpgt_epi32(load(a), load(b)));
+#else
+    return map<sword>(a, b, [](const sword x, const sword y) { return (x > y) ? -1 : 0; });
+#endif
+}
+
+////////////////////////////////
+// Shift (by immediate).
+////////////////////////////////
+
+inline uqword psllh(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sll_epi16(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<uhword>(b, [shamt](const uhword x) { return x << shamt; });
+#endif
+}
+
+inline uqword psrlh(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_srl_epi16(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<uhword>(b, [shamt](const uhword x) { return x >> shamt; });
+#endif
+}
+
+inline uqword psrah(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sra_epi16(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<shword>(b, [shamt](const shword x) { return x >> shamt; });
+#endif
+}
+
+inline uqword psllw(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sll_epi32(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<uword>(b, [shamt](const uword x) { return x << shamt; });
+#endif
+}
+
+inline uqword psrlw(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_srl_epi32(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<uword>(b, [shamt](const uword x) { return x >> shamt; });
+#endif
+}
+
+inline uqword psraw(const uqword& b, const int shamt)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_sra_epi32(load(b), _mm_cvtsi32_si128(shamt)));
+#else
+    return map<sword>(b, [shamt](const sword x) { return x >> shamt; });
+#endif
+}
+
+////////////////////////////////
+// Reordering.
+////////////////////////////////
+
+inline uqword pextlb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpacklo_epi8(load(b), load(a)));
+#else
+    return permute<ubyte>(b, a, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+#endif
+}
+
+inline uqword pextlh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpacklo_epi16(load(b), load(a)));
+#else
+    return permute<uhword>(b, a, 0, 8, 1, 9, 2, 10, 3, 11);
+#endif
+}
+
+inline uqword pextlw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpacklo_epi32(load(b), load(a)));
+#else
+    return permute<uword>(b, a, 0, 4, 1, 5);
+#endif
+}
+
+inline uqword pextub(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpackhi_epi8(load(b), load(a)));
+#else
+    return permute<ubyte>(b, a, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+#endif
+}
+
+inline uqword pextuh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpackhi_epi16(load(b), load(a)));
+#else
+    return permute<uhword>(b, a, 4, 12, 5, 13, 6, 14, 7, 15);
+#endif
+}
+
+inline uqword pextuw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpackhi_epi32(load(b), load(a)));
+#else
+    return permute<uword>(b, a, 2, 6, 3, 7);
+#endif
+}
+
+inline uqword ppacb(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // The (truncated) even bytes are in range, so the saturating pack is exact.
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    return store(_mm_packus_epi16(_mm_and_si128(load(b), mask), _mm_and_si128(load(a), mask)));
+#else
+    return permute<ubyte>(b, a, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+#endif
+}
+
+inline uqword ppach(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    // Sign extend the even hwords, so the saturating pack is exact.
+    const __m128i x = _mm_srai_epi32(_mm_slli_epi32(load(a), 16), 16);
+    const __m128i y = _mm_srai_epi32(_mm_slli_epi32(load(b), 16), 16);
+    return store(_mm_packs_epi32(y, x));
+#else
+    return permute<uhword>(b, a, 0, 2, 4, 6, 8, 10, 12, 14);
+#endif
+}
+
+inline uqword ppacw(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    const __m128 x = _mm_castsi128_ps(load(a));
+    const __m128 y = _mm_castsi128_ps(load(b));
+    return store(_mm_castps_si128(_mm_shuffle_ps(y, x, _MM_SHUFFLE(2, 0, 2, 0))));
+#else
+    return permute<uword>(b, a, 0, 2, 4, 6);
+#endif
+}
+
+inline uqword pcpyh(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shufflehi_epi16(_mm_shufflelo_epi16(load(b), 0), 0));
+#else
+    return permute<uhword>(b, b, 0, 0, 0, 0, 4, 4, 4, 4);
+#endif
+}
+
+inline uqword pcpyld(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpacklo_epi64(load(b), load(a)));
+#else
+    return uqword(b.lo, a.lo);
+#endif
+}
+
+inline uqword pcpyud(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_unpackhi_epi64(load(a), load(b)));
+#else
+    return uqword(a.hi, b.hi);
+#endif
+}
+
+inline uqword pexch(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shufflehi_epi16(_mm_shufflelo_epi16(load(b), _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0)));
+#else
+    return permute<uhword>(b, b, 0, 2, 1, 3, 4, 6, 5, 7);
+#endif
+}
+
+inline uqword pexcw(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shuffle_epi32(load(b), _MM_SHUFFLE(3, 1, 2, 0)));
+#else
+    return permute<uword>(b, b, 0, 2, 1, 3);
+#endif
+}
+
+inline uqword pexeh(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shufflehi_epi16(_mm_shufflelo_epi16(load(b), _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2)));
+#else
+    return permute<uhword>(b, b, 2, 1, 0, 3, 6, 5, 4, 7);
+#endif
+}
+
+inline uqword pexew(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shuffle_epi32(load(b), _MM_SHUFFLE(3, 0, 1, 2)));
+#else
+    return permute<uword>(b, b, 2, 1, 0, 3);
+#endif
+}
+
+inline uqword pinteh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_or_si128(_mm_and_si128(load(b), _mm_set1_epi32(0x0000FFFF)), _mm_slli_epi32(load(a), 16)));
+#else
+    return permute<uhword>(b, a, 0, 8, 2, 10, 4, 12, 6, 14);
+#endif
+}
+
+inline uqword pinth(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    const __m128i x = load(a);
+    return store(_mm_unpacklo_epi16(load(b), _mm_unpackhi_epi64(x, x)));
+#else
+    return permute<uhword>(b, a, 0, 12, 1, 13, 2, 14, 3, 15);
+#endif
+}
+
+inline uqword prevh(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shufflehi_epi16(_mm_shufflelo_epi16(load(b), _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3)));
+#else
+    return permute<uhword>(b, b, 3, 2, 1, 0, 7, 6, 5, 4);
+#endif
+}
+
+inline uqword prot3w(const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    return store(_mm_shuffle_epi32(load(b), _MM_SHUFFLE(3, 0, 2, 1)));
+#else
+    return permute<uword>(b, b, 1, 2, 0, 3);
+#endif
+}
+
+////////////////////////////////
+// Multiply / add.
+////////////////////////////////
+
+/// PMADDH/PMSUBH: the products of the 8 signed hwords are accumulated onto
+/// (HI,LO): lanes 0,1,4,5 use LO words 0,1,2,3 and lanes 2,3,6,7 use HI
+/// words 0,1,2,3 (see EE Core Instruction Manual page 216). Returns Rd,
+/// which is made up of the even lanes.
+template <bool Subtract>
+uqword pmaddh(const uqword& a, const uqword& b, uqword& lo, uqword& hi)
+{
+#if defined(SIMD_SSE2)
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i products_lo = _mm_mullo_epi16(x, y);
+    const __m128i products_hi = _mm_mulhi_epi16(x, y);
+    const __m128i products_0123 = _mm_unpacklo_epi16(products_lo, products_hi);
+    const __m128i products_4567 = _mm_unpackhi_epi16(products_lo, products_hi);
+
+    const __m128i c_lo = load(lo);
+    const __m128i c_hi = load(hi);
+    const __m128i c_0123 = _mm_unpacklo_epi64(c_lo, c_hi);
+    const __m128i c_4567 = _mm_unpackhi_epi64(c_lo, c_hi);
+
+    const __m128i values_0123 = Subtract ? _mm_sub_epi32(c_0123, products_0123) : _mm_add_epi32(c_0123, products_0123);
+    const __m128i values_4567 = Subtract ? _mm_sub_epi32(c_4567, products_4567) : _mm_add_epi32(c_4567, products_4567);
+
+    lo = store(_mm_unpacklo_epi64(values_0123, values_4567));
+    hi = store(_mm_unpackhi_epi64(values_0123, values_4567));
+    return store(_mm_unpacklo_epi64(_mm_shuffle_epi32(values_0123, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_epi32(values_4567, _MM_SHUFFLE(3, 1, 2, 0))));
+#else
+    const uqword c = permute<uword>(lo, hi, 0, 1, 4, 5);
+    const uqword c_4567 = permute<uword>(lo, hi, 2, 3, 6, 7);
+    uword values[8];
+    for (size_t i = 0; i < 8; i++)
+    {
+        const sword product = sword(get<shword>(a, i)) * sword(get<shword>(b, i));
+        const uword accumulator = (i < 4) ? get<uword>(c, i) : get<uword>(c_4567, i - 4);
+        values[i] = Subtract ? (accumulator - uword(product)) : (accumulator + uword(product));
+    }
+    lo = uqword(values[0], values[1], values[4], values[5]);
+    hi = uqword(values[2], values[3], values[6], values[7]);
+    return uqword(values[0], values[2], values[4], values[6]);
+#endif
+}
+
+/// PHMADH/PHMSBH: the signed hword products of each word are added
+/// (odd + even) or subtracted (odd - even), giving 4 word results.
+template <bool Subtract>
+uqword phmadh(const uqword& a, const uqword& b)
+{
+#if defined(SIMD_SSE2)
+    if (!Subtract)
+        return store(_mm_madd_epi16(load(a), load(b)));
+
+    // Mask out one product at a time (each is exact on its own).
+    const __m128i x = load(a);
+    const __m128i y = load(b);
+    const __m128i even_mask = _mm_set1_epi32(0x0000FFFF);
+    const __m128i even = _mm_madd_epi16(x, _mm_and_si128(y, even_mask));
+    const __m128i odd = _mm_madd_epi16(x, _mm_andnot_si128(even_mask, y));
+    return store(_mm_sub_epi32(odd, even));
+#else
+    uqword d;
+    for (size_t i = 0; i < 4; i++)
+    {
+        const uword even = uword(sword(get<shword>(a, 2 * i)) * sword(get<shword>(b, 2 * i)));
+        const uword odd = uword(sword(get<shword>(a, 2 * i + 1)) * sword(get<shword>(b, 2 * i + 1)));
+        set<uword>(d, i, Subtract ? (odd - even) : (odd + even));
+    }
+    return d;
+#endif
+}
+} // namespace EeCoreMmi
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/format.hpp>
 
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
@@ -12,20 +14,49 @@ CEeCoreInterpreter::CEeCoreInterpreter(Core* core) :
 {
 }
 
+CEeCoreInterpreter::~CEeCoreInterpreter()
+{
+#if defined(BUILD_DEBUG)
+    const size_t total = block_cache.get_hits() + block_cache.get_misses();
+    BOOST_LOG(Core::get_logger()) << boost::format("EE Core block cache: blocks = %d, hits = %d, misses = %d (%.2f%% hit rate).")
+                                         % block_cache.get_number_blocks()
+                                         % block_cache.get_hits()
+                                         % block_cache.get_misses()
+                                         % (total ? (100.0 * block_cache.get_hits() / total) : 0.0);
+    BOOST_LOG(Core::get_logger()) << boost::format("EE Core idle loops: skips = %d, ticks skipped = %d.")
+                                         % idle_loop_stats.get_number_skips()
+                                         % idle_loop_stats.get_ticks_skipped();
+    for (const auto& [pc, entry] : idle_loop_stats.get_top_entries(8))
+        BOOST_LOG(Core::get_logger()) << boost::format("    PC = 0x%08X: skips = %d, ticks skipped = %d.") % pc % entry.number_skips % entry.ticks_skipped;
+#endif
+}
+
 int CEeCoreInterpreter::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
 
     // Check if any external interrupts are pending and immediately handle exception if there is one.
-    if (ticks_available % 16 == 0)
-        handle_interrupt_check();
+    handle_interrupt_check();
 
-    // Set the instruction holder to the instruction at the current PC, and get instruction details.
-    const uptr pc_address = r.ee.core.r5900.pc.read_uword();
-    uptr physical_address = translate_address_inst(pc_address).value();
-    uword raw_inst = r.ee.bus.read_uword(BusContext::Ee, physical_address);
-    EeCoreInstruction inst = EeCoreInstruction(raw_inst);
+    // Get the block of instructions starting at the current PC and run it.
+    uptr physical_address = translate_address_inst(r.ee.core.r5900.pc.read_uword()).value();
+    const EeCoreBlock& block = lookup_block(physical_address);
+
+    return execute_block(block, ticks_available);
+}
+
+int CEeCoreInterpreter::execute_block(const EeCoreBlock& block, const int ticks_available)
+{
+    auto& r = core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+    auto& bdelay = r.ee.core.r5900.bdelay;
 
+    const uptr pc_address = pc.read_uword();
+    int instructions_executed = 0;
+    int cycles_executed = 0;
+    uptr next_pc_address = pc_address;
+    for (const auto& decoded : block.instructions)
+    {
 #if 0 //defined(BUILD_DEBUG)
 	static size_t DEBUG_LOOP_BREAKPOINT = 0x1000000143DE40;
 	static uptr DEBUG_PC_BREAKPOINT = 0x0;
@@ -35,42 +66,159 @@ int CEeCoreInterpreter::time_step(const int ticks_available)
 		BOOST_LOG(Core::get_logger()) << 
 			boost::format("EeCore cycle = 0x%llX: PC = 0x%08X, BD = %d, IntEn = %d, Instruction = %s")
 			% DEBUG_LOOP_COUNTER
-			% pc_address
+			% pc.read_uword()
 			% r.ee.core.r5900.bdelay.is_branch_pending() 
 			% !r.ee.core.cop0.status.interrupts_masked
-			% ((!inst.value) ? "SLL (NOP)" : inst.get_info()->mnemonic);
+			% ((!decoded.inst.value) ? "SLL (NOP)" : EeCoreInstruction(decoded.inst.value).get_info()->mnemonic);
 	}
 
 	if (DEBUG_LOOP_COUNTER >= (DEBUG_LOOP_BREAKPOINT + 0x1000))
 	{
-		BOOST_LOG(Core::get_logger()) << boost::format("EeCore loop breakpoint hit @ cycle = 0x%llX, PC = 0x%08X.") % DEBUG_LOOP_COUNTER % pc_address;
+		BOOST_LOG(Core::get_logger()) << boost::format("EeCore loop breakpoint hit @ cycle = 0x%llX, PC = 0x%08X.") % DEBUG_LOOP_COUNTER % pc.read_uword();
 	}
 
-	if (pc_address == DEBUG_PC_BREAKPOINT || pc_address == 0x0)
+	if (pc.read_uword() == DEBUG_PC_BREAKPOINT || pc.read_uword() == 0x0)
 	{
-		BOOST_LOG(Core::get_logger()) << boost::format("EeCore pc breakpoint hit @ cycle = 0x%llX, PC = 0x%08X.") % DEBUG_LOOP_COUNTER % pc_address;
+		BOOST_LOG(Core::get_logger()) << boost::format("EeCore pc breakpoint hit @ cycle = 0x%llX, PC = 0x%08X.") % DEBUG_LOOP_COUNTER % pc.read_uword();
 	}
 #endif
 
-    // Run the instruction, which is based on the implementation index.
-    const int impl_index = inst.get_info()->impl_index;
-    (this->*EECORE_INSTRUCTION_TABLE[impl_index])(inst);
+        // Run the instruction, which is based on the implementation index.
+        (this->*EECORE_INSTRUCTION_TABLE[decoded.impl_index])(decoded.inst);
+        r.ee.core.r5900.reset_zero_register();
 
-    // Increment PC.
-    r.ee.core.r5900.bdelay.advance_pc(r.ee.core.r5900.pc);
+        // Increment PC.
+        bdelay.advance_pc(pc);
 
-    // Update the COP0.Count register, and check for interrupt.
-    // See EE Core Users Manual page 70.
-    if (ticks_available % 16 == 0)
-        handle_count_update(inst.get_info()->cpi * 16);
+        instructions_executed++;
+        cycles_executed += decoded.cpi;
 
 #if defined(BUILD_DEBUG)
-    // Debug increment loop counter.
-    DEBUG_LOOP_COUNTER++;
+        // Debug increment loop counter.
+        DEBUG_LOOP_COUNTER++;
 #endif
 
+        // Stop executing the block if the control flow changed (branch taken,
+        // branch likely nullified, exception raised, etc), or if we have run
+        // out of time.
+        next_pc_address += Constants::MIPS::SIZE_MIPS_INSTRUCTION;
+        if (pc.read_uword() != next_pc_address)
+            break;
+        if ((instructions_executed * 3) >= ticks_available)
+            break;
+    }
+
+    // Fast-forward if spinning in an idle loop.
+    const int ticks_skipped = handle_idle_loop_skip(block, pc_address, instructions_executed, ticks_available - instructions_executed * 3);
+
+    // Update the COP0.Count register, and check for interrupt.
+    // See EE Core Users Manual page 70.
+    handle_count_update(cycles_executed + ticks_skipped);
+
     // Return the number of cycles completed.
-    return 3; // TODO: fix CPI's. inst.get_info()->cpi;
+    return instructions_executed * 3 + ticks_skipped; // TODO: fix CPI's. cycles_executed;
+}
+
+int CEeCoreInterpreter::handle_idle_loop_skip(const EeCoreBlock& block, const uptr pc_address, const size_t instructions_executed, const int ticks_remaining)
+{
+    auto& r = core->get_resources();
+
+    if (!block.is_idle_loop || !core->get_options().idle_loop_skip)
+        return 0;
+
+    // A full iteration must have run, without leaving the loop (or raising an exception).
+    if (instructions_executed != block.instructions.size() || r.ee.core.r5900.pc.read_uword() != pc_address)
+        return 0;
+
+    // Only loops polling main memory are skipped, see MipsIdleLoop::Loads.
+    // The loads have just run, so their translations are cached.
+    for (size_t i = 0; i < block.idle_loop_loads.count; i++)
+    {
+        const auto& load = block.idle_loop_loads.loads[i];
+        const uptr virtual_address = r.ee.core.r5900.gpr[load.base].read_uword(0) + load.offset;
+        const std::optional<uptr> physical_address = translate_address_data(virtual_address, READ);
+        if (!physical_address || *physical_address >= Constants::EE::MainMemory::SIZE_MAIN_MEMORY)
+            return 0;
+    }
+
+    // A pending interrupt ends the loop straight away.
+    if (is_interrupt_pending())
+        return 0;
+
+    // Stop at the next scheduled event, and at the COP0 count interrupt, so
+    // they are handled on time.
+    int ticks = ticks_to_next_event(ticks_remaining);
+    if (r.ee.core.cop0.status.count_interrupts_enabled)
+    {
+        const uword count_value = r.ee.core.cop0.count.read_uword();
+        const uword compare_value = r.ee.core.cop0.compare.read_uword();
+        if (compare_value > count_value)
+            ticks = static_cast<int>(std::min<uword>(static_cast<uword>(ticks), compare_value - count_value));
+    }
+
+    if (ticks <= 0)
+        return 0;
+
+    idle_loop_stats.record(pc_address, ticks);
+    return ticks;
+}
+
+EeCoreBlock& CEeCoreInterpreter::lookup_block(const uptr physical_address)
+{
+    auto& r = core->get_resources();
+    const BusWriteTracker* tracker = r.ee.bus.get_write_tracker();
+
+    // Uncacheable address, decode a single instruction only.
+    if (!tracker || !tracker->is_tracked(physical_address))
+    {
+        uncached_block.physical_address = physical_address;
+        uncached_block.instructions.clear();
+        uncached_block.compiled_code = nullptr;
+        uncached_block.is_idle_loop = false;
+        uncached_block.idle_loop_loads.count = 0;
+
+        EeCoreInstruction inst = EeCoreInstruction(r.ee.bus.read_uword(BusContext::Ee, physical_address));
+        const MipsInstructionInfo* info = inst.get_info();
+        uncached_block.instructions.push_back({inst, info->impl_index, info->cpi});
+        return uncached_block;
+    }
+
+    if (EeCoreBlock* block = block_cache.lookup(physical_address, *tracker))
+        return *block;
+
+    // Decode a new block. The page is marked as watched before it is read,
+    // so any write made after this point will invalidate the block.
+    const uword page_generation = r.ee.bus.get_write_tracker()->watch(physical_address);
+    EeCoreBlock& block = block_cache.allocate(physical_address, page_generation);
+
+    const uptr page_end_address = (physical_address & ~static_cast<uptr>(BusWriteTracker::PAGE_SIZE - 1)) + BusWriteTracker::PAGE_SIZE;
+    bool in_delay_slot = false;
+    for (uptr address = physical_address; address < page_end_address; address += Constants::MIPS::SIZE_MIPS_INSTRUCTION)
+    {
+        EeCoreInstruction inst = EeCoreInstruction(r.ee.bus.read_uword(BusContext::Ee, address));
+        const MipsInstructionInfo* info = inst.get_info();
+        block.instructions.push_back({inst, info->impl_index, info->cpi});
+
+        if (in_delay_slot || block.instructions.size() >= EeCoreBlockCache::MAX_BLOCK_LENGTH)
+            break;
+
+        const auto block_end = EeCoreBlockCache::classify(inst);
+        if (block_end == EeCoreBlockCache::BlockEnd::Immediate)
+            break;
+        if (block_end == EeCoreBlockCache::BlockEnd::Branch)
+            in_delay_slot = true;
+    }
+
+    // Check for a block that loops back onto itself, see MipsIdleLoop.
+    if (in_delay_slot && block.instructions.size() <= MipsIdleLoop::MAX_LOOP_LENGTH)
+    {
+        uword raw_instructions[MipsIdleLoop::MAX_LOOP_LENGTH];
+        for (size_t i = 0; i < block.instructions.size(); i++)
+            raw_instructions[i] = block.instructions[i].inst.value;
+        block.is_idle_loop = MipsIdleLoop::is_idle_loop(raw_instructions, block.instructions.size(), physical_address, block.idle_loop_loads);
+    }
+
+    return block;
 }
 
 void CEeCoreInterpreter::INSTRUCTION_UNKNOWN(const EeCoreInstruction inst)
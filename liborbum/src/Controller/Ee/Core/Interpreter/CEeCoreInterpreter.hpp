@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Common/Constants.hpp"
+#include "Common/Types/Mips/MipsIdleLoop.hpp"
 #include "Controller/Ee/Core/CEeCore.hpp"
+#include "Controller/Ee/Core/EeCoreBlockCache.hpp"
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
 #include "Resources/Ee/Core/EeCoreInstruction.hpp"
 
@@ -15,10 +17,40 @@ class CEeCoreInterpreter : public CEeCore
 {
 public:
     CEeCoreInterpreter(Core* core);
+    ~CEeCoreInterpreter();
 
-    /// Steps through the EE Core state, executing instructions.
+    /// Steps through the EE Core state, executing a whole block of instructions
+    /// at a time (see EeCoreBlockCache).
     int time_step(const int ticks_available) override;
 
+    /// Pre-decoded instruction block cache, keyed by physical PC.
+    /// Blocks are invalidated on writes to the cached pages (see BusWriteTracker),
+    /// and flushed on TLB changes.
+    EeCoreBlockCache block_cache;
+
+    /// Returns the block starting at the physical address, decoding (and caching)
+    /// it first if required. Addresses outside of the write tracked range are not
+    /// cached, and are decoded one instruction at a time.
+    EeCoreBlock& lookup_block(const uptr physical_address);
+
+    /// Executes the given block (starting at the current PC), stopping early if
+    /// the control flow changes or the available ticks run out.
+    /// Returns the number of ticks completed.
+    int execute_block(const EeCoreBlock& block, const int ticks_available);
+
+    /// Scratch block used for uncacheable addresses.
+    EeCoreBlock uncached_block;
+
+    /// Returns the number of ticks to fast-forward by, if the block just run
+    /// is an idle loop that has looped back to its start (see MipsIdleLoop).
+    /// Skips up to the end of the time slice, the next scheduled event or the
+    /// COP0 count interrupt, and not at all if an interrupt is pending or the
+    /// loop reads outside of main memory.
+    int handle_idle_loop_skip(const EeCoreBlock& block, const uptr pc_address, const size_t instructions_executed, const int ticks_remaining);
+
+    /// Idle loop skip statistics, per loop start PC.
+    MipsIdleLoop::Stats idle_loop_stats;
+
     /// The VU interpreter, used to call any COP2 instructions prefixed with V* as the mnemonic.
     /// TODO: Will change in future when VU's are implemented.
     CVuInterpreter c_vu_interpreter;
@@ -231,8 +231,4 @@ void CEeCoreInterpreter::ERET(const EeCoreInstruction inst)
     // be the last instruction executed before interrupts can occur
     // again.
     r.ee.core.cop0.cause.clear_all_irq();
-
-    // Flush translation caches (context change).
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
 }
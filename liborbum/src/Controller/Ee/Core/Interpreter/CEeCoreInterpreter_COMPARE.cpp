@@ -1,3 +1,4 @@
+#include "Controller/Ee/Core/EeCoreMmi.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
@@ -83,13 +84,7 @@ void CEeCoreInterpreter::PCEQB(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        ubyte val_source1 = reg_source1.read_ubyte(i);
-        ubyte val_source2 = reg_source2.read_ubyte(i);
-        ubyte result = (val_source1 == val_source2) ? 0xFF : 0x00;
-        reg_dest.write_ubyte(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pceqb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PCEQH(const EeCoreInstruction inst)
@@ -102,13 +97,7 @@ void CEeCoreInterpreter::PCEQH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        uhword val_source1 = reg_source1.read_uhword(i);
-        uhword val_source2 = reg_source2.read_uhword(i);
-        uhword result = (val_source1 == val_source2) ? 0xFFFF : 0x0000;
-        reg_dest.write_uhword(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pceqh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PCEQW(const EeCoreInstruction inst)
@@ -121,13 +110,7 @@ void CEeCoreInterpreter::PCEQW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        uword val_source1 = reg_source1.read_uword(i);
-        uword val_source2 = reg_source2.read_uword(i);
-        uword result = (val_source1 == val_source2) ? 0xFFFFFFFF : 0x00000000;
-        reg_dest.write_uword(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pceqw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PCGTB(const EeCoreInstruction inst)
@@ -140,13 +123,7 @@ void CEeCoreInterpreter::PCGTB(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        ubyte val_source1 = reg_source1.read_ubyte(i);
-        ubyte val_source2 = reg_source2.read_ubyte(i);
-        ubyte result = (val_source1 > val_source2) ? 0xFF : 0x00;
-        reg_dest.write_ubyte(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pcgtb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PCGTH(const EeCoreInstruction inst)
@@ -159,13 +136,7 @@ void CEeCoreInterpreter::PCGTH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        uhword val_source1 = reg_source1.read_uhword(i);
-        uhword val_source2 = reg_source2.read_uhword(i);
-        uhword result = (val_source1 > val_source2) ? 0xFFFF : 0x0000;
-        reg_dest.write_uhword(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pcgth(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PCGTW(const EeCoreInstruction inst)
@@ -178,13 +149,7 @@ void CEeCoreInterpreter::PCGTW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        uword val_source1 = reg_source1.read_uword(i);
-        uword val_source2 = reg_source2.read_uword(i);
-        uword result = (val_source1 > val_source2) ? 0xFFFFFFFF : 0x00000000;
-        reg_dest.write_uword(i, result);
-    }
+    reg_dest.write_uqword(EeCoreMmi::pcgtw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::C_EQ_S(const EeCoreInstruction inst)
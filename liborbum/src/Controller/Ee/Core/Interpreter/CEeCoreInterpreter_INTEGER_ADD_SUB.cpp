@@ -1,3 +1,4 @@
+#include "Controller/Ee/Core/EeCoreMmi.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
@@ -224,13 +225,7 @@ void CEeCoreInterpreter::PADDB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        value[i] = reg_source1.read_ubyte(i) + reg_source2.read_ubyte(i);
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::paddb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDH(const EeCoreInstruction inst)
@@ -242,13 +237,7 @@ void CEeCoreInterpreter::PADDH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) + reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::paddh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDSB(const EeCoreInstruction inst)
@@ -260,21 +249,7 @@ void CEeCoreInterpreter::PADDSB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<sbyte>(reg_source1.read_ubyte(i)))
-                   + static_cast<shword>(static_cast<sbyte>(reg_source2.read_ubyte(i)));
-
-        if (value[i] > VALUE_SBYTE_MAX)
-            value[i] = VALUE_SBYTE_MAX;
-        else if (value[i] < VALUE_SBYTE_MIN)
-            value[i] = VALUE_SBYTE_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<sbyte>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::paddsb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDSH(const EeCoreInstruction inst)
@@ -286,21 +261,7 @@ void CEeCoreInterpreter::PADDSH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<shword>(reg_source1.read_uhword(i)))
-                   + static_cast<sword>(static_cast<shword>(reg_source2.read_uhword(i)));
-
-        if (value[i] > VALUE_SHWORD_MAX)
-            value[i] = VALUE_SHWORD_MAX;
-        else if (value[i] < VALUE_SHWORD_MIN)
-            value[i] = VALUE_SHWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<shword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::paddsh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDSW(const EeCoreInstruction inst)
@@ -312,21 +273,7 @@ void CEeCoreInterpreter::PADDSW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<sword>(reg_source1.read_uword(i)))
-                   + static_cast<sdword>(static_cast<sword>(reg_source2.read_uword(i)));
-
-        if (value[i] > VALUE_SWORD_MAX)
-            value[i] = VALUE_SWORD_MAX;
-        else if (value[i] < VALUE_SWORD_MIN)
-            value[i] = VALUE_SWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<sword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::paddsw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDUB(const EeCoreInstruction inst)
@@ -338,19 +285,7 @@ void CEeCoreInterpreter::PADDUB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<uhword>(reg_source1.read_ubyte(i))
-                   + static_cast<uhword>(reg_source2.read_ubyte(i));
-
-        if (value[i] > VALUE_UBYTE_MAX)
-            value[i] = VALUE_UBYTE_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<ubyte>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::paddub(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDUH(const EeCoreInstruction inst)
@@ -362,19 +297,7 @@ void CEeCoreInterpreter::PADDUH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<uword>(reg_source1.read_uhword(i))
-                   + static_cast<uhword>(reg_source2.read_uhword(i));
-
-        if (value[i] > VALUE_UHWORD_MAX)
-            value[i] = VALUE_UHWORD_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<uhword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::padduh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDUW(const EeCoreInstruction inst)
@@ -386,19 +309,7 @@ void CEeCoreInterpreter::PADDUW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    udword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<udword>(reg_source1.read_uword(i))
-                   + static_cast<udword>(reg_source2.read_uword(i));
-
-        if (value[i] > VALUE_UWORD_MAX)
-            value[i] = VALUE_UWORD_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<uword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::padduw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADDW(const EeCoreInstruction inst)
@@ -411,13 +322,7 @@ void CEeCoreInterpreter::PADDW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) + reg_source2.read_uword(i);
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::paddw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PADSBH(const EeCoreInstruction inst)
@@ -429,18 +334,7 @@ void CEeCoreInterpreter::PADSBH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    // Sub
-    for (int i = 0; i < (NUMBER_HWORDS_IN_QWORD / 2); i++)
-        value[i] = reg_source1.read_uhword(i) - reg_source2.read_uhword(i);
-
-    // Add
-    for (int i = (NUMBER_HWORDS_IN_QWORD / 2); i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) + reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::padsbh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBB(const EeCoreInstruction inst)
@@ -452,13 +346,7 @@ void CEeCoreInterpreter::PSUBB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        value[i] = reg_source1.read_ubyte(i) - reg_source2.read_ubyte(i);
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psubb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBH(const EeCoreInstruction inst)
@@ -470,13 +358,7 @@ void CEeCoreInterpreter::PSUBH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) - reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psubh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBSB(const EeCoreInstruction inst)
@@ -488,21 +370,7 @@ void CEeCoreInterpreter::PSUBSB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<sbyte>(reg_source1.read_ubyte(i)))
-                   - static_cast<shword>(static_cast<sbyte>(reg_source2.read_ubyte(i)));
-
-        if (value[i] > VALUE_SBYTE_MAX)
-            value[i] = VALUE_SBYTE_MAX;
-        else if (value[i] < VALUE_SBYTE_MIN)
-            value[i] = VALUE_SBYTE_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<sbyte>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubsb(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBSH(const EeCoreInstruction inst)
@@ -514,21 +382,7 @@ void CEeCoreInterpreter::PSUBSH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<shword>(reg_source1.read_uhword(i)))
-                   - static_cast<sword>(static_cast<shword>(reg_source2.read_uhword(i)));
-
-        if (value[i] > VALUE_SHWORD_MAX)
-            value[i] = VALUE_SHWORD_MAX;
-        else if (value[i] < VALUE_SHWORD_MIN)
-            value[i] = VALUE_SHWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<shword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubsh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBSW(const EeCoreInstruction inst)
@@ -540,21 +394,7 @@ void CEeCoreInterpreter::PSUBSW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<sword>(reg_source1.read_uword(i)))
-                   - static_cast<sdword>(static_cast<sword>(reg_source2.read_uword(i)));
-
-        if (value[i] > VALUE_SWORD_MAX)
-            value[i] = VALUE_SWORD_MAX;
-        else if (value[i] < VALUE_SWORD_MIN)
-            value[i] = VALUE_SWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<sword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubsw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBUB(const EeCoreInstruction inst)
@@ -566,19 +406,7 @@ void CEeCoreInterpreter::PSUBUB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<uhword>(reg_source1.read_ubyte(i)))
-                   - static_cast<shword>(static_cast<uhword>(reg_source2.read_ubyte(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<ubyte>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubub(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBUH(const EeCoreInstruction inst)
@@ -590,19 +418,7 @@ void CEeCoreInterpreter::PSUBUH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<uword>(reg_source1.read_uhword(i)))
-                   - static_cast<sword>(static_cast<uhword>(reg_source2.read_uhword(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<uhword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubuh(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBUW(const EeCoreInstruction inst)
@@ -614,19 +430,7 @@ void CEeCoreInterpreter::PSUBUW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<udword>(reg_source1.read_uword(i)))
-                   - static_cast<sdword>(static_cast<udword>(reg_source2.read_uword(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<uword>(value[i]));
+    reg_dest.write_uqword(EeCoreMmi::psubuw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
 
 void CEeCoreInterpreter::PSUBW(const EeCoreInstruction inst)
@@ -638,11 +442,5 @@ void CEeCoreInterpreter::PSUBW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) - reg_source2.read_uword(i);
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psubw(reg_source1.read_uqword(), reg_source2.read_uqword()));
 }
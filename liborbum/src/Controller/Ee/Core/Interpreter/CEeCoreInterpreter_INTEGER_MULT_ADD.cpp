@@ -1,3 +1,4 @@
+#include "Controller/Ee/Core/EeCoreMmi.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
@@ -73,39 +74,15 @@ void CEeCoreInterpreter::PHMADH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    sword value[NUMBER_WORDS_IN_QWORD];
+    const uqword value = EeCoreMmi::phmadh<false>(reg_source1.read_uqword(), reg_source2.read_uqword());
 
-    auto madd = [](const uhword a0, const uhword b0, const uhword a1, const uhword b1) -> sword {
-        sword sa0 = static_cast<sword>(static_cast<shword>(a0));
-        sword sb0 = static_cast<sword>(static_cast<shword>(b0));
-        sword sa1 = static_cast<sword>(static_cast<shword>(a1));
-        sword sb1 = static_cast<sword>(static_cast<shword>(b1));
-        return ((sa1 * sb1) + (sa0 * sb0));
-    };
+    reg_dest.write_uqword(value);
+
+    lo.write_uword(0, value.uw[0]);
+    lo.write_uword(2, value.uw[2]);
 
-    value[0] = madd(
-        reg_source1.read_uhword(0), reg_source2.read_uhword(0),
-        reg_source1.read_uhword(1), reg_source2.read_uhword(1));
-    value[1] = madd(
-        reg_source1.read_uhword(2), reg_source2.read_uhword(2),
-        reg_source1.read_uhword(3), reg_source2.read_uhword(3));
-    value[2] = madd(
-        reg_source1.read_uhword(4), reg_source2.read_uhword(4),
-        reg_source1.read_uhword(5), reg_source2.read_uhword(5));
-    value[3] = madd(
-        reg_source1.read_uhword(6), reg_source2.read_uhword(6),
-        reg_source1.read_uhword(7), reg_source2.read_uhword(7));
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[1]);
-    reg_dest.write_uword(2, value[2]);
-    reg_dest.write_uword(3, value[3]);
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(2, value[2]);
-
-    hi.write_uword(0, value[1]);
-    hi.write_uword(2, value[3]);
+    hi.write_uword(0, value.uw[1]);
+    hi.write_uword(2, value.uw[3]);
 }
 
 void CEeCoreInterpreter::PHMSBH(const EeCoreInstruction inst)
@@ -120,39 +97,15 @@ void CEeCoreInterpreter::PHMSBH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    sword value[NUMBER_WORDS_IN_QWORD];
+    const uqword value = EeCoreMmi::phmadh<true>(reg_source1.read_uqword(), reg_source2.read_uqword());
 
-    auto madd = [](const uhword a0, const uhword b0, const uhword a1, const uhword b1) -> sword {
-        sword sa0 = static_cast<sword>(static_cast<shword>(a0));
-        sword sb0 = static_cast<sword>(static_cast<shword>(b0));
-        sword sa1 = static_cast<sword>(static_cast<shword>(a1));
-        sword sb1 = static_cast<sword>(static_cast<shword>(b1));
-        return ((sa1 * sb1) - (sa0 * sb0));
-    };
+    reg_dest.write_uqword(value);
 
-    value[0] = madd(
-        reg_source1.read_uhword(0), reg_source2.read_uhword(0),
-        reg_source1.read_uhword(1), reg_source2.read_uhword(1));
-    value[1] = madd(
-        reg_source1.read_uhword(2), reg_source2.read_uhword(2),
-        reg_source1.read_uhword(3), reg_source2.read_uhword(3));
-    value[2] = madd(
-        reg_source1.read_uhword(4), reg_source2.read_uhword(4),
-        reg_source1.read_uhword(5), reg_source2.read_uhword(5));
-    value[3] = madd(
-        reg_source1.read_uhword(6), reg_source2.read_uhword(6),
-        reg_source1.read_uhword(7), reg_source2.read_uhword(7));
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[1]);
-    reg_dest.write_uword(2, value[2]);
-    reg_dest.write_uword(3, value[3]);
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(2, value[2]);
-
-    hi.write_uword(0, value[1]);
-    hi.write_uword(2, value[3]);
+    lo.write_uword(0, value.uw[0]);
+    lo.write_uword(2, value.uw[2]);
+
+    hi.write_uword(0, value.uw[1]);
+    hi.write_uword(2, value.uw[3]);
 }
 
 void CEeCoreInterpreter::PMADDH(const EeCoreInstruction inst)
@@ -168,38 +121,11 @@ void CEeCoreInterpreter::PMADDH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    uword value[NUMBER_WORDS_IN_QWORD * 2];
-
-    auto madd = [](const uhword a, const uhword b, const uword c) -> sword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        sword sc = static_cast<sword>(c);
-        return ((sa * sb) + sc);
-    };
-
-    value[0] = madd(reg_source1.read_uhword(0), reg_source2.read_uhword(0), lo.read_uword(0));
-    value[1] = madd(reg_source1.read_uhword(1), reg_source2.read_uhword(1), lo.read_uword(1));
-    value[2] = madd(reg_source1.read_uhword(2), reg_source2.read_uhword(2), hi.read_uword(0));
-    value[3] = madd(reg_source1.read_uhword(3), reg_source2.read_uhword(3), hi.read_uword(1));
-    value[4] = madd(reg_source1.read_uhword(4), reg_source2.read_uhword(4), lo.read_uword(2));
-    value[5] = madd(reg_source1.read_uhword(5), reg_source2.read_uhword(5), lo.read_uword(3));
-    value[6] = madd(reg_source1.read_uhword(6), reg_source2.read_uhword(6), hi.read_uword(2));
-    value[7] = madd(reg_source1.read_uhword(7), reg_source2.read_uhword(7), hi.read_uword(3));
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(1, value[1]);
-    lo.write_uword(2, value[4]);
-    lo.write_uword(3, value[5]);
-
-    hi.write_uword(0, value[2]);
-    hi.write_uword(1, value[3]);
-    hi.write_uword(2, value[6]);
-    hi.write_uword(3, value[7]);
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[2]);
-    reg_dest.write_uword(2, value[4]);
-    reg_dest.write_uword(3, value[5]);
+    uqword lo_value = lo.read_uqword();
+    uqword hi_value = hi.read_uqword();
+    reg_dest.write_uqword(EeCoreMmi::pmaddh<false>(reg_source1.read_uqword(), reg_source2.read_uqword(), lo_value, hi_value));
+    lo.write_uqword(lo_value);
+    hi.write_uqword(hi_value);
 }
 
 void CEeCoreInterpreter::PMADDUW(const EeCoreInstruction inst)
@@ -289,38 +215,11 @@ void CEeCoreInterpreter::PMSUBH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    uword value[NUMBER_WORDS_IN_QWORD * 2];
-
-    auto madd = [](const uhword a, const uhword b, const uword c) -> sword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        sword sc = static_cast<sword>(c);
-        return (sc - (sa * sb));
-    };
-
-    value[0] = madd(reg_source1.read_uhword(0), reg_source2.read_uhword(0), lo.read_uword(0));
-    value[1] = madd(reg_source1.read_uhword(1), reg_source2.read_uhword(1), lo.read_uword(1));
-    value[2] = madd(reg_source1.read_uhword(2), reg_source2.read_uhword(2), hi.read_uword(0));
-    value[3] = madd(reg_source1.read_uhword(3), reg_source2.read_uhword(3), hi.read_uword(1));
-    value[4] = madd(reg_source1.read_uhword(4), reg_source2.read_uhword(4), lo.read_uword(2));
-    value[5] = madd(reg_source1.read_uhword(5), reg_source2.read_uhword(5), lo.read_uword(3));
-    value[6] = madd(reg_source1.read_uhword(6), reg_source2.read_uhword(6), hi.read_uword(2));
-    value[7] = madd(reg_source1.read_uhword(7), reg_source2.read_uhword(7), hi.read_uword(3));
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(1, value[1]);
-    lo.write_uword(2, value[4]);
-    lo.write_uword(3, value[5]);
-
-    hi.write_uword(0, value[2]);
-    hi.write_uword(1, value[3]);
-    hi.write_uword(2, value[6]);
-    hi.write_uword(3, value[7]);
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[2]);
-    reg_dest.write_uword(2, value[4]);
-    reg_dest.write_uword(3, value[5]);
+    uqword lo_value = lo.read_uqword();
+    uqword hi_value = hi.read_uqword();
+    reg_dest.write_uqword(EeCoreMmi::pmaddh<true>(reg_source1.read_uqword(), reg_source2.read_uqword(), lo_value, hi_value));
+    lo.write_uqword(lo_value);
+    hi.write_uqword(hi_value);
 }
 
 void CEeCoreInterpreter::PMSUBW(const EeCoreInstruction inst)
@@ -97,8 +97,10 @@ void CEeCoreInterpreter::TLBR(const EeCoreInstruction inst)
     pagemask.insert_field(EeCoreCop0Register_PageMask::MASK, tlb_entry.mask.pagemask);
 
     // EntryHi.
+    const uword previous_asid = entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID);
     entryhi.insert_field(EeCoreCop0Register_EntryHi::ASID, static_cast<uword>(tlb_entry.asid));
     entryhi.insert_field(EeCoreCop0Register_EntryHi::VPN2, tlb_entry.vpn2);
+    handle_asid_update(previous_asid);
 
     // EntryLo0 (even).
     entrylo0.insert_field(EeCoreCop0Register_EntryLo0::S, static_cast<uword>(tlb_entry.s));
@@ -156,10 +158,11 @@ void CEeCoreInterpreter::TLBWI(const EeCoreInstruction inst)
     // G bit (and of Lo0 and Lo1)
     tlb_entry.g = (entrylo0.extract_field(EeCoreCop0Register_EntryLo0::G) & entrylo1.extract_field(EeCoreCop0Register_EntryLo1::G)) > 0;
 
-    // Write to TLB and flush emulator cache.
+    // Write to TLB and flush emulator caches.
     tlb.set_tlb_entry_at(tlb_entry, index.extract_field(EeCoreCop0Register_Index::INDEX));
     translation_cache_data.flush();
     translation_cache_inst.flush();
+    block_cache.flush();
 }
 
 void CEeCoreInterpreter::TLBWR(const EeCoreInstruction inst)
@@ -202,8 +205,9 @@ void CEeCoreInterpreter::TLBWR(const EeCoreInstruction inst)
     // G bit (and of Lo0 and Lo1)
     tlb_entry.g = (entrylo0.extract_field(EeCoreCop0Register_EntryLo0::G) & entrylo1.extract_field(EeCoreCop0Register_EntryLo1::G)) > 0;
 
-    // Write to TLB and flush emulator cache.
+    // Write to TLB and flush emulator caches.
     tlb.set_tlb_entry_at(tlb_entry, random.extract_field(EeCoreCop0Register_Random::RANDOM));
     translation_cache_data.flush();
     translation_cache_inst.flush();
+    block_cache.flush();
 }
@@ -1,5 +1,6 @@
 #include <bitset>
 
+#include "Controller/Ee/Core/EeCoreMmi.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
@@ -222,13 +223,7 @@ void CEeCoreInterpreter::PSLLH(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt() & 0xF;
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) << shamt;
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psllh(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::PSLLVW(const EeCoreInstruction inst)
@@ -268,13 +263,7 @@ void CEeCoreInterpreter::PSLLW(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt();
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) << shamt;
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psllw(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::PSRAH(const EeCoreInstruction inst)
@@ -287,13 +276,7 @@ void CEeCoreInterpreter::PSRAH(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt() & 0xF;
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = static_cast<uhword>(static_cast<shword>(reg_source1.read_uhword(i)) >> shamt);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psrah(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::PSRAVW(const EeCoreInstruction inst)
@@ -333,13 +316,7 @@ void CEeCoreInterpreter::PSRAW(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt();
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = static_cast<uword>(static_cast<sword>(reg_source1.read_uword(i)) >> shamt);
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psraw(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::PSRLH(const EeCoreInstruction inst)
@@ -352,13 +329,7 @@ void CEeCoreInterpreter::PSRLH(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt() & 0xF;
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) >> shamt;
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psrlh(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::PSRLVW(const EeCoreInstruction inst)
@@ -398,13 +369,7 @@ void CEeCoreInterpreter::PSRLW(const EeCoreInstruction inst)
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     int shamt = inst.shamt();
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) >> shamt;
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    reg_dest.write_uqword(EeCoreMmi::psrlw(reg_source1.read_uqword(), shamt));
 }
 
 void CEeCoreInterpreter::QFSRV(const EeCoreInstruction inst)
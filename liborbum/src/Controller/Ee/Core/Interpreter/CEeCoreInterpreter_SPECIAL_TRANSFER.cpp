@@ -199,7 +199,9 @@ void CEeCoreInterpreter::MTC0(const EeCoreInstruction inst)
     auto& reg_source = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.cop0.registers[inst.rd()];
 
+    const uword previous_asid = r.ee.core.cop0.entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID);
     reg_dest->write_uword(reg_source.read_uword(0));
+    handle_asid_update(previous_asid);
 }
 
 void CEeCoreInterpreter::MTDAB(const EeCoreInstruction inst)
@@ -0,0 +1,949 @@
+#include <algorithm>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "Controller/Ee/Core/Recompiler/CEeCoreRecompiler.hpp"
+
+#include "Core.hpp"
+#include "Resources/RResources.hpp"
+
+#if defined(ENV_UNIX) && defined(__x86_64__)
+#define EECORE_RECOMPILER_SUPPORTED 1
+#else
+#define EECORE_RECOMPILER_SUPPORTED 0
+#endif
+
+namespace
+{
+using Reg = X64Emitter::Reg;
+using Cond = X64Emitter::Cond;
+using AluOp = X64Emitter::AluOp;
+using ShiftOp = X64Emitter::ShiftOp;
+
+/// Host registers used by compiled blocks (all callee saved):
+/// the GPR file base, the virtual address of the block, and the registers the
+/// cached GPR's are kept in. RAX, RCX, RDX are used as scratch registers, and
+/// [RSP] as a scratch slot (loaded values, branch targets).
+constexpr Reg GPR_BASE = Reg::RBX;
+constexpr Reg BLOCK_PC = Reg::R12;
+constexpr Reg CACHE_REGS[CEeCoreRecompiler::NUMBER_CACHED_GPRS] = {Reg::RBP, Reg::R13, Reg::R14, Reg::R15};
+
+/// The GPR's form a flat register file, see AlignedQwordRegister.
+static_assert(sizeof(AlignedQwordRegister) == NUMBER_BYTES_IN_QWORD, "GPR's are expected to be 16 bytes each.");
+
+sword get_gpr_offset(const int index)
+{
+    return static_cast<sword>(index * NUMBER_BYTES_IN_QWORD);
+}
+
+/// Returns the opposite condition (the conditions are encoded in pairs).
+Cond invert(const Cond cond)
+{
+    return static_cast<Cond>(static_cast<int>(cond) ^ 1);
+}
+} // namespace
+
+/// Compilation state of a block: the GPR's cached in host registers, and the
+/// exits taken from within the block (emitted after the block body).
+struct CEeCoreRecompiler::CompileContext
+{
+    struct Exit
+    {
+        /// Jump to the exit code.
+        size_t fixup;
+
+        /// Cached GPR's to write back (bitmask by register index).
+        uword dirty;
+
+        /// Number of instructions executed.
+        uword instructions;
+
+        /// If the PC was already updated, otherwise the next PC is the block
+        /// address + pc_offset.
+        bool pc_written;
+        uword pc_offset;
+    };
+
+    CompileContext(X64Emitter& emitter) :
+        emitter(emitter),
+        dirty(0)
+    {
+        std::fill(std::begin(host_index), std::end(host_index), -1);
+    }
+
+    X64Emitter& emitter;
+
+    /// Index of the host register (see CACHE_REGS) holding each GPR, or -1 if not cached.
+    int host_index[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
+
+    /// Cached GPR's modified since they were last written back (bitmask by register index).
+    uword dirty;
+
+    std::vector<Exit> exits;
+
+    /// Reads the lower 64-bits of a GPR into the host register.
+    void read_gpr(const Reg dst, const int index)
+    {
+        if (!index)
+            emitter.alu_r32_r32(AluOp::XOR, dst, dst);
+        else if (host_index[index] != -1)
+            emitter.mov_r64_r64(dst, CACHE_REGS[host_index[index]]);
+        else
+            emitter.mov_r64_m64(dst, GPR_BASE, get_gpr_offset(index));
+    }
+
+    /// Writes the host register to the lower 64-bits of a GPR. Writes to $zero are discarded.
+    void write_gpr(const int index, const Reg src)
+    {
+        if (!index)
+            return;
+
+        if (host_index[index] != -1)
+        {
+            emitter.mov_r64_r64(CACHE_REGS[host_index[index]], src);
+            dirty |= 1u << index;
+        }
+        else
+        {
+            emitter.mov_m64_r64(GPR_BASE, get_gpr_offset(index), src);
+        }
+    }
+
+    /// Writes back the given cached GPR's to the register file.
+    void write_back(const uword mask)
+    {
+        for (int index = 1; index < Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS; index++)
+        {
+            if (mask & (1u << index))
+                emitter.mov_m64_r64(GPR_BASE, get_gpr_offset(index), CACHE_REGS[host_index[index]]);
+        }
+    }
+
+    /// Writes back all modified GPR's, ie: before an interpreted instruction.
+    void flush()
+    {
+        write_back(dirty);
+        dirty = 0;
+    }
+
+    /// (Re)loads all cached GPR's from the register file.
+    void reload()
+    {
+        for (int index = 1; index < Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS; index++)
+        {
+            if (host_index[index] != -1)
+                emitter.mov_r64_m64(CACHE_REGS[host_index[index]], GPR_BASE, get_gpr_offset(index));
+        }
+    }
+
+    /// Exits the block if the condition (of the flags) is met.
+    void exit_if(const Cond cond, const size_t instructions, const bool pc_written, const uword pc_offset)
+    {
+        exits.push_back({emitter.jcc(cond), dirty, static_cast<uword>(instructions), pc_written, pc_offset});
+    }
+
+    /// Makes the block result from the next PC in EAX (see BlockFn).
+    void make_result(const size_t instructions)
+    {
+        emitter.mov_r64_imm64(Reg::RCX, static_cast<udword>(instructions) << 32);
+        emitter.alu_r64_r64(AluOp::OR, Reg::RAX, Reg::RCX);
+    }
+
+    /// Loads EAX with the block address + offset.
+    void make_pc(const uword pc_offset)
+    {
+        emitter.mov_r32_r32(Reg::RAX, BLOCK_PC);
+        emitter.alu_r32_imm32(AluOp::ADD, Reg::RAX, pc_offset);
+    }
+};
+
+CEeCoreRecompiler::CEeCoreRecompiler(Core* core) :
+    CEeCoreInterpreter(core),
+    code_memory(EECORE_RECOMPILER_SUPPORTED ? CODE_MEMORY_SIZE : 0),
+    pending_exception(nullptr),
+    number_blocks_compiled(0),
+    number_code_flushes(0),
+    number_native_instructions(0),
+    number_interpreted_instructions(0)
+{
+    if (!code_memory.is_valid())
+        BOOST_LOG(Core::get_logger()) << "EE Core recompiler not supported on this host - falling back to the interpreter";
+
+    // Map the implementations to the native operations.
+    const std::pair<void (CEeCoreInterpreter::*)(const EeCoreInstruction), NativeOp> NATIVE_IMPLEMENTATIONS[] =
+        {
+            {&CEeCoreInterpreter::ADDIU, NativeOp::ADDIU},
+            {&CEeCoreInterpreter::DADDIU, NativeOp::DADDIU},
+            {&CEeCoreInterpreter::ADDU, NativeOp::ADDU},
+            {&CEeCoreInterpreter::DADDU, NativeOp::DADDU},
+            {&CEeCoreInterpreter::SUBU, NativeOp::SUBU},
+            {&CEeCoreInterpreter::DSUBU, NativeOp::DSUBU},
+            {&CEeCoreInterpreter::AND, NativeOp::AND},
+            {&CEeCoreInterpreter::OR, NativeOp::OR},
+            {&CEeCoreInterpreter::XOR, NativeOp::XOR},
+            {&CEeCoreInterpreter::NOR, NativeOp::NOR},
+            {&CEeCoreInterpreter::ANDI, NativeOp::ANDI},
+            {&CEeCoreInterpreter::ORI, NativeOp::ORI},
+            {&CEeCoreInterpreter::XORI, NativeOp::XORI},
+            {&CEeCoreInterpreter::LUI, NativeOp::LUI},
+            {&CEeCoreInterpreter::SLL, NativeOp::SLL},
+            {&CEeCoreInterpreter::SRL, NativeOp::SRL},
+            {&CEeCoreInterpreter::SRA, NativeOp::SRA},
+            {&CEeCoreInterpreter::DSLL, NativeOp::DSLL},
+            {&CEeCoreInterpreter::DSRL, NativeOp::DSRL},
+            {&CEeCoreInterpreter::DSRA, NativeOp::DSRA},
+            {&CEeCoreInterpreter::DSLL32, NativeOp::DSLL32},
+            {&CEeCoreInterpreter::DSRL32, NativeOp::DSRL32},
+            {&CEeCoreInterpreter::DSRA32, NativeOp::DSRA32},
+            {&CEeCoreInterpreter::SLLV, NativeOp::SLLV},
+            {&CEeCoreInterpreter::SRLV, NativeOp::SRLV},
+            {&CEeCoreInterpreter::SRAV, NativeOp::SRAV},
+            {&CEeCoreInterpreter::DSLLV, NativeOp::DSLLV},
+            {&CEeCoreInterpreter::DSRLV, NativeOp::DSRLV},
+            {&CEeCoreInterpreter::DSRAV, NativeOp::DSRAV},
+            {&CEeCoreInterpreter::SLT, NativeOp::SLT},
+            {&CEeCoreInterpreter::SLTU, NativeOp::SLTU},
+            {&CEeCoreInterpreter::SLTI, NativeOp::SLTI},
+            {&CEeCoreInterpreter::SLTIU, NativeOp::SLTIU},
+            {&CEeCoreInterpreter::MOVZ, NativeOp::MOVZ},
+            {&CEeCoreInterpreter::MOVN, NativeOp::MOVN},
+            {&CEeCoreInterpreter::LB, NativeOp::LB},
+            {&CEeCoreInterpreter::LBU, NativeOp::LBU},
+            {&CEeCoreInterpreter::LH, NativeOp::LH},
+            {&CEeCoreInterpreter::LHU, NativeOp::LHU},
+            {&CEeCoreInterpreter::LW, NativeOp::LW},
+            {&CEeCoreInterpreter::LWU, NativeOp::LWU},
+            {&CEeCoreInterpreter::LD, NativeOp::LD},
+            {&CEeCoreInterpreter::SB, NativeOp::SB},
+            {&CEeCoreInterpreter::SH, NativeOp::SH},
+            {&CEeCoreInterpreter::SW, NativeOp::SW},
+            {&CEeCoreInterpreter::SD, NativeOp::SD},
+            {&CEeCoreInterpreter::BEQ, NativeOp::BEQ},
+            {&CEeCoreInterpreter::BNE, NativeOp::BNE},
+            {&CEeCoreInterpreter::BLEZ, NativeOp::BLEZ},
+            {&CEeCoreInterpreter::BGTZ, NativeOp::BGTZ},
+            {&CEeCoreInterpreter::BLTZ, NativeOp::BLTZ},
+            {&CEeCoreInterpreter::BGEZ, NativeOp::BGEZ},
+            {&CEeCoreInterpreter::BEQL, NativeOp::BEQL},
+            {&CEeCoreInterpreter::BNEL, NativeOp::BNEL},
+            {&CEeCoreInterpreter::BLEZL, NativeOp::BLEZL},
+            {&CEeCoreInterpreter::BGTZL, NativeOp::BGTZL},
+            {&CEeCoreInterpreter::BLTZL, NativeOp::BLTZL},
+            {&CEeCoreInterpreter::BGEZL, NativeOp::BGEZL},
+            {&CEeCoreInterpreter::J, NativeOp::J},
+            {&CEeCoreInterpreter::JAL, NativeOp::JAL},
+            {&CEeCoreInterpreter::JR, NativeOp::JR},
+            {&CEeCoreInterpreter::JALR, NativeOp::JALR}};
+
+    for (int impl_index = 0; impl_index < Constants::EE::EECore::NUMBER_INSTRUCTIONS; impl_index++)
+    {
+        native_ops[impl_index] = NativeOp::None;
+        for (const auto& implementation : NATIVE_IMPLEMENTATIONS)
+        {
+            if (EECORE_INSTRUCTION_TABLE[impl_index] == implementation.first)
+                native_ops[impl_index] = implementation.second;
+        }
+    }
+}
+
+CEeCoreRecompiler::~CEeCoreRecompiler()
+{
+#if defined(BUILD_DEBUG)
+    BOOST_LOG(Core::get_logger()) << boost::format("EE Core recompiler: blocks compiled = %d, native instructions = %d, interpreted instructions = %d, code flushes = %d, code memory used = %d bytes.")
+                                         % number_blocks_compiled
+                                         % number_native_instructions
+                                         % number_interpreted_instructions
+                                         % number_code_flushes
+                                         % code_memory.get_used_size();
+#endif
+}
+
+int CEeCoreRecompiler::time_step(const int ticks_available)
+{
+    auto& r = core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    // Check if any external interrupts are pending and immediately handle exception if there is one.
+    handle_interrupt_check();
+
+    // Get the block of instructions starting at the current PC.
+    uptr physical_address = translate_address_inst(pc.read_uword()).value();
+    EeCoreBlock& block = lookup_block(physical_address);
+
+    // Uncached blocks can't be compiled (they are not tracked for invalidation).
+    // Compiled code doesn't check the time or keep the branch delay slot state,
+    // so blocks that the interpreter would stop early for time, or that start
+    // in a delay slot, are interpreted.
+    const int block_ticks = static_cast<int>(block.instructions.size() - 1) * 3;
+    if (!code_memory.is_valid() || (&block == &uncached_block) || (block_ticks >= ticks_available) || r.ee.core.r5900.bdelay.is_branch_pending())
+        return execute_block(block, ticks_available);
+
+    if (!block.compiled_code)
+        block.compiled_code = reinterpret_cast<void*>(compile_block(block));
+
+    // Compiling may have failed (out of code memory) and caused the cache to
+    // be flushed - just interpret this time around.
+    if (!block.compiled_code)
+        return execute_block(block, ticks_available);
+
+    const uword pc_address = pc.read_uword();
+    const udword result = reinterpret_cast<BlockFn>(block.compiled_code)(pc_address);
+    if (!(result & PC_WRITTEN))
+        pc.write_uword(static_cast<uword>(result));
+
+    if (pending_exception)
+    {
+        std::exception_ptr exception = pending_exception;
+        pending_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+
+    const int instructions_executed = static_cast<int>((result & ~PC_WRITTEN) >> 32);
+    int cycles_executed = 0;
+    for (int i = 0; i < instructions_executed; i++)
+        cycles_executed += block.instructions[i].cpi;
+
+#if defined(BUILD_DEBUG)
+    // Debug increment loop counter.
+    DEBUG_LOOP_COUNTER += instructions_executed;
+#endif
+
+    // Fast-forward if spinning in an idle loop.
+    const int ticks_skipped = handle_idle_loop_skip(block, pc_address, instructions_executed, ticks_available - instructions_executed * 3);
+
+    // Update the COP0.Count register, and check for interrupt.
+    // See EE Core Users Manual page 70.
+    handle_count_update(cycles_executed + ticks_skipped);
+
+    // Return the number of cycles completed.
+    return instructions_executed * 3 + ticks_skipped; // TODO: fix CPI's. cycles_executed;
+}
+
+uword CEeCoreRecompiler::get_gprs_used(const NativeOp op, const EeCoreInstruction inst)
+{
+    const uword rs = 1u << inst.rs();
+    const uword rt = 1u << inst.rt();
+    const uword rd = 1u << inst.rd();
+
+    switch (op)
+    {
+    case NativeOp::ADDU:
+    case NativeOp::DADDU:
+    case NativeOp::SUBU:
+    case NativeOp::DSUBU:
+    case NativeOp::AND:
+    case NativeOp::OR:
+    case NativeOp::XOR:
+    case NativeOp::NOR:
+    case NativeOp::SLLV:
+    case NativeOp::SRLV:
+    case NativeOp::SRAV:
+    case NativeOp::DSLLV:
+    case NativeOp::DSRLV:
+    case NativeOp::DSRAV:
+    case NativeOp::SLT:
+    case NativeOp::SLTU:
+    case NativeOp::MOVZ:
+    case NativeOp::MOVN:
+        return rs | rt | rd;
+    case NativeOp::SLL:
+    case NativeOp::SRL:
+    case NativeOp::SRA:
+    case NativeOp::DSLL:
+    case NativeOp::DSRL:
+    case NativeOp::DSRA:
+    case NativeOp::DSLL32:
+    case NativeOp::DSRL32:
+    case NativeOp::DSRA32:
+        return rt | rd;
+    case NativeOp::LUI:
+        return rt;
+    case NativeOp::BLEZ:
+    case NativeOp::BGTZ:
+    case NativeOp::BLTZ:
+    case NativeOp::BGEZ:
+    case NativeOp::BLEZL:
+    case NativeOp::BGTZL:
+    case NativeOp::BLTZL:
+    case NativeOp::BGEZL:
+    case NativeOp::JR:
+        return rs;
+    case NativeOp::JALR:
+        return rs | rd;
+    case NativeOp::J:
+        return 0;
+    case NativeOp::JAL:
+        return 1u << 31;
+    case NativeOp::None:
+        return 0;
+    default:
+        // Immediate ALU, loads/stores and BEQ/BNE(L).
+        return rs | rt;
+    }
+}
+
+CEeCoreRecompiler::BlockFn CEeCoreRecompiler::compile_block(const EeCoreBlock& block)
+{
+    const size_t count = block.instructions.size();
+
+    // Make sure there is enough space for the worst case block size, otherwise
+    // discard everything compiled so far.
+    constexpr size_t MAX_INSTRUCTION_CODE_SIZE = 192;
+    constexpr size_t MAX_OVERHEAD_CODE_SIZE = 128;
+    const size_t max_code_size = count * MAX_INSTRUCTION_CODE_SIZE + MAX_OVERHEAD_CODE_SIZE;
+    if (code_memory.get_free_size() < max_code_size)
+    {
+        code_memory.reset();
+        block_cache.flush();
+        number_code_flushes++;
+        return nullptr;
+    }
+
+    // Select the native operation for each instruction. The branch delay slot
+    // state is only kept in host registers, so a branch is only translated if
+    // its delay slot is an ALU instruction - otherwise both are interpreted.
+    NativeOp ops[EeCoreBlockCache::MAX_BLOCK_LENGTH];
+    for (size_t i = 0; i < count; i++)
+        ops[i] = native_ops[block.instructions[i].impl_index];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (EeCoreBlockCache::classify(block.instructions[i].inst) != EeCoreBlockCache::BlockEnd::Branch)
+            continue;
+
+        const bool is_delay_alu = ((i + 1) < count)
+                                  && (ops[i + 1] != NativeOp::None)
+                                  && !is_load(ops[i + 1]) && !is_store(ops[i + 1]) && !is_branch(ops[i + 1]);
+        if (!is_branch(ops[i]) || !is_delay_alu)
+        {
+            ops[i] = NativeOp::None;
+            if ((i + 1) < count)
+                ops[i + 1] = NativeOp::None;
+        }
+    }
+
+    // Cache the GPR's used most by the native instructions (at least twice).
+    size_t uses[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS] = {0};
+    for (size_t i = 0; i < count; i++)
+    {
+        const uword gprs = get_gprs_used(ops[i], block.instructions[i].inst);
+        for (int index = 1; index < Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS; index++)
+            uses[index] += (gprs >> index) & 1;
+    }
+
+    X64Emitter emitter(code_memory.get_free_pointer(), code_memory.get_free_size());
+    CompileContext context(emitter);
+    for (int host_index = 0; host_index < NUMBER_CACHED_GPRS; host_index++)
+    {
+        const size_t* most_used = std::max_element(std::begin(uses) + 1, std::end(uses));
+        if (*most_used < 2)
+            break;
+        context.host_index[most_used - std::begin(uses)] = host_index;
+        uses[most_used - std::begin(uses)] = 0;
+    }
+
+    // Prologue: save the callee saved registers, with an extra slot used as
+    // scratch space which also realigns the stack to 16 bytes for the calls.
+    auto& r = core->get_resources();
+    emitter.push(Reg::RBX);
+    emitter.push(Reg::RBP);
+    emitter.push(Reg::R12);
+    emitter.push(Reg::R13);
+    emitter.push(Reg::R14);
+    emitter.push(Reg::R15);
+    emitter.push(Reg::RAX);
+    emitter.mov_r32_r32(BLOCK_PC, Reg::RDI);
+    emitter.mov_r64_imm64(GPR_BASE, reinterpret_cast<udword>(&r.ee.core.r5900.gpr[0]));
+    context.reload();
+
+    // Body.
+    bool is_branch_emitted = false;
+    for (size_t i = 0; i < count; i++)
+    {
+        const EeCoreDecodedInstruction& decoded = block.instructions[i];
+        const NativeOp op = ops[i];
+        if (op == NativeOp::None)
+        {
+            emit_interpreted(context, decoded, i);
+            number_interpreted_instructions++;
+        }
+        else if (is_load(op) || is_store(op))
+        {
+            emit_memory_access(context, op, decoded.inst, i);
+            number_native_instructions++;
+        }
+        else if (is_branch(op))
+        {
+            emit_branch(context, op, decoded.inst, ops[i + 1], block.instructions[i + 1].inst, i);
+            number_native_instructions += 2;
+            is_branch_emitted = true;
+            break;
+        }
+        else
+        {
+            emit_alu(context, op, decoded.inst);
+            number_native_instructions++;
+        }
+    }
+
+    // Ran off the end of the block (no branch).
+    if (!is_branch_emitted)
+    {
+        context.flush();
+        context.make_pc(static_cast<uword>(count * Constants::MIPS::SIZE_MIPS_INSTRUCTION));
+        context.make_result(count);
+    }
+
+    // Epilogue.
+    const size_t exit_position = emitter.get_position();
+    emitter.pop(Reg::RCX);
+    emitter.pop(Reg::R15);
+    emitter.pop(Reg::R14);
+    emitter.pop(Reg::R13);
+    emitter.pop(Reg::R12);
+    emitter.pop(Reg::RBP);
+    emitter.pop(Reg::RBX);
+    emitter.ret();
+
+    // Exits from within the block.
+    for (const auto& exit : context.exits)
+    {
+        emitter.bind(exit.fixup, emitter.get_position());
+        context.write_back(exit.dirty);
+        if (exit.pc_written)
+        {
+            emitter.mov_r64_imm64(Reg::RAX, PC_WRITTEN | (static_cast<udword>(exit.instructions) << 32));
+        }
+        else
+        {
+            context.make_pc(exit.pc_offset);
+            context.make_result(exit.instructions);
+        }
+        emitter.bind(emitter.jmp(), exit_position);
+    }
+
+    if (emitter.has_overflowed())
+        return nullptr;
+
+    BlockFn fn = reinterpret_cast<BlockFn>(emitter.get_code());
+    code_memory.commit(emitter.get_position());
+    number_blocks_compiled++;
+    return fn;
+}
+
+void CEeCoreRecompiler::emit_alu(CompileContext& context, const NativeOp op, const EeCoreInstruction inst)
+{
+    X64Emitter& emitter = context.emitter;
+    const int rs = inst.rs();
+    const int rt = inst.rt();
+    const int rd = inst.rd();
+    const uword s_imm = static_cast<uword>(static_cast<sword>(inst.s_imm()));
+    const uword u_imm = inst.u_imm();
+    const ubyte shamt = static_cast<ubyte>(inst.shamt());
+
+    // I-type instructions write Rt, R-type instructions write Rd.
+    // Nothing to do if the result is discarded (ie: NOPs).
+    const bool is_itype = (op == NativeOp::ADDIU) || (op == NativeOp::DADDIU)
+                          || (op == NativeOp::ANDI) || (op == NativeOp::ORI) || (op == NativeOp::XORI)
+                          || (op == NativeOp::LUI) || (op == NativeOp::SLTI) || (op == NativeOp::SLTIU);
+    const int dest = is_itype ? rt : rd;
+    if (!dest)
+        return;
+
+    switch (op)
+    {
+    case NativeOp::ADDIU:
+        context.read_gpr(Reg::RAX, rs);
+        emitter.alu_r32_imm32(AluOp::ADD, Reg::RAX, s_imm);
+        emitter.movsxd_r64_r32(Reg::RAX, Reg::RAX);
+        break;
+    case NativeOp::DADDIU:
+        context.read_gpr(Reg::RAX, rs);
+        emitter.alu_r64_imm32(AluOp::ADD, Reg::RAX, s_imm);
+        break;
+    case NativeOp::ADDU:
+    case NativeOp::SUBU:
+        context.read_gpr(Reg::RAX, rs);
+        context.read_gpr(Reg::RCX, rt);
+        emitter.alu_r32_r32((op == NativeOp::ADDU) ? AluOp::ADD : AluOp::SUB, Reg::RAX, Reg::RCX);
+        emitter.movsxd_r64_r32(Reg::RAX, Reg::RAX);
+        break;
+    case NativeOp::DADDU:
+    case NativeOp::DSUBU:
+    case NativeOp::AND:
+    case NativeOp::OR:
+    case NativeOp::XOR:
+    case NativeOp::NOR:
+    {
+        const AluOp alu_op = (op == NativeOp::DADDU) ? AluOp::ADD
+                             : (op == NativeOp::DSUBU) ? AluOp::SUB
+                             : (op == NativeOp::AND) ? AluOp::AND
+                             : (op == NativeOp::XOR) ? AluOp::XOR
+                             : AluOp::OR;
+        context.read_gpr(Reg::RAX, rs);
+        context.read_gpr(Reg::RCX, rt);
+        emitter.alu_r64_r64(alu_op, Reg::RAX, Reg::RCX);
+        if (op == NativeOp::NOR)
+            emitter.not_r64(Reg::RAX);
+        break;
+    }
+    case NativeOp::ANDI:
+    case NativeOp::ORI:
+    case NativeOp::XORI:
+    {
+        // The immediate is zero extended (bit 31 is never set, so the sign extension by the host is fine).
+        const AluOp alu_op = (op == NativeOp::ANDI) ? AluOp::AND : (op == NativeOp::ORI) ? AluOp::OR : AluOp::XOR;
+        context.read_gpr(Reg::RAX, rs);
+        emitter.alu_r64_imm32(alu_op, Reg::RAX, u_imm);
+        break;
+    }
+    case NativeOp::LUI:
+        emitter.mov_r64_imm64(Reg::RAX, static_cast<udword>(static_cast<sdword>(static_cast<sword>(u_imm << 16))));
+        break;
+    case NativeOp::SLL:
+    case NativeOp::SRL:
+    case NativeOp::SRA:
+    {
+        const ShiftOp shift_op = (op == NativeOp::SLL) ? ShiftOp::SHL : (op == NativeOp::SRL) ? ShiftOp::SHR : ShiftOp::SAR;
+        context.read_gpr(Reg::RAX, rt);
+        emitter.shift_r32_imm8(shift_op, Reg::RAX, shamt);
+        emitter.movsxd_r64_r32(Reg::RAX, Reg::RAX);
+        break;
+    }
+    case NativeOp::DSLL:
+    case NativeOp::DSRL:
+    case NativeOp::DSRA:
+    case NativeOp::DSLL32:
+    case NativeOp::DSRL32:
+    case NativeOp::DSRA32:
+    {
+        const ShiftOp shift_op = ((op == NativeOp::DSLL) || (op == NativeOp::DSLL32)) ? ShiftOp::SHL
+                                 : ((op == NativeOp::DSRL) || (op == NativeOp::DSRL32)) ? ShiftOp::SHR
+                                 : ShiftOp::SAR;
+        const bool is_32 = (op == NativeOp::DSLL32) || (op == NativeOp::DSRL32) || (op == NativeOp::DSRA32);
+        context.read_gpr(Reg::RAX, rt);
+        emitter.shift_r64_imm8(shift_op, Reg::RAX, is_32 ? (shamt + 32) : shamt);
+        break;
+    }
+    case NativeOp::SLLV:
+    case NativeOp::SRLV:
+    case NativeOp::SRAV:
+    {
+        // The host masks the shift amount to 5 bits, as the EE does.
+        const ShiftOp shift_op = (op == NativeOp::SLLV) ? ShiftOp::SHL : (op == NativeOp::SRLV) ? ShiftOp::SHR : ShiftOp::SAR;
+        context.read_gpr(Reg::RAX, rt);
+        context.read_gpr(Reg::RCX, rs);
+        emitter.shift_r32_cl(shift_op, Reg::RAX);
+        emitter.movsxd_r64_r32(Reg::RAX, Reg::RAX);
+        break;
+    }
+    case NativeOp::DSLLV:
+    case NativeOp::DSRLV:
+    case NativeOp::DSRAV:
+    {
+        // The host masks the shift amount to 6 bits, as the EE does.
+        const ShiftOp shift_op = (op == NativeOp::DSLLV) ? ShiftOp::SHL : (op == NativeOp::DSRLV) ? ShiftOp::SHR : ShiftOp::SAR;
+        context.read_gpr(Reg::RAX, rt);
+        context.read_gpr(Reg::RCX, rs);
+        emitter.shift_r64_cl(shift_op, Reg::RAX);
+        break;
+    }
+    case NativeOp::SLT:
+    case NativeOp::SLTU:
+    case NativeOp::SLTI:
+    case NativeOp::SLTIU:
+    {
+        // The result register is cleared before the compare, as xor changes the flags.
+        const bool is_signed = (op == NativeOp::SLT) || (op == NativeOp::SLTI);
+        context.read_gpr(Reg::RCX, rs);
+        if ((op == NativeOp::SLT) || (op == NativeOp::SLTU))
+            context.read_gpr(Reg::RDX, rt);
+        emitter.alu_r32_r32(AluOp::XOR, Reg::RAX, Reg::RAX);
+        if ((op == NativeOp::SLT) || (op == NativeOp::SLTU))
+            emitter.alu_r64_r64(AluOp::CMP, Reg::RCX, Reg::RDX);
+        else
+            emitter.alu_r64_imm32(AluOp::CMP, Reg::RCX, s_imm);
+        emitter.setcc(is_signed ? Cond::L : Cond::B, Reg::RAX);
+        break;
+    }
+    case NativeOp::MOVZ:
+    case NativeOp::MOVN:
+        context.read_gpr(Reg::RAX, rd);
+        context.read_gpr(Reg::RCX, rs);
+        context.read_gpr(Reg::RDX, rt);
+        emitter.test_r64_r64(Reg::RDX, Reg::RDX);
+        emitter.cmov_r64_r64((op == NativeOp::MOVZ) ? Cond::E : Cond::NE, Reg::RAX, Reg::RCX);
+        break;
+    default:
+        throw std::runtime_error("EE Core recompiler: not an ALU instruction.");
+    }
+
+    context.write_gpr(dest, Reg::RAX);
+}
+
+void CEeCoreRecompiler::emit_memory_access(CompileContext& context, const NativeOp op, const EeCoreInstruction inst, const size_t index)
+{
+    X64Emitter& emitter = context.emitter;
+    const uword pc_offset = static_cast<uword>(index * Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+
+    // Arguments: (self, op, virtual address, PC, value pointer / value).
+    // The virtual address wraps around at 32-bits, as in the interpreter.
+    if (is_store(op))
+        context.read_gpr(Reg::R8, inst.rt());
+    else
+        emitter.mov_r64_r64(Reg::R8, Reg::RSP);
+    context.read_gpr(Reg::RDX, inst.rs());
+    emitter.alu_r32_imm32(AluOp::ADD, Reg::RDX, static_cast<uword>(static_cast<sword>(inst.s_imm())));
+    emitter.mov_r32_r32(Reg::RCX, BLOCK_PC);
+    emitter.alu_r32_imm32(AluOp::ADD, Reg::RCX, pc_offset);
+    emitter.mov_r32_imm32(Reg::RSI, static_cast<uword>(op));
+    emitter.mov_r64_imm64(Reg::RDI, reinterpret_cast<udword>(this));
+    emitter.call(is_store(op) ? reinterpret_cast<const void*>(&CEeCoreRecompiler::store_memory) : reinterpret_cast<const void*>(&CEeCoreRecompiler::load_memory));
+
+    // The helper updates the PC if the access raised an exception.
+    emitter.test_r8_r8(Reg::RAX, Reg::RAX);
+    context.exit_if(Cond::E, index + 1, true, 0);
+
+    if (is_load(op))
+    {
+        emitter.mov_r64_m64(Reg::RAX, Reg::RSP, 0);
+        context.write_gpr(inst.rt(), Reg::RAX);
+    }
+}
+
+void CEeCoreRecompiler::emit_branch(CompileContext& context, const NativeOp op, const EeCoreInstruction inst, const NativeOp delay_op, const EeCoreInstruction delay_inst, const size_t index)
+{
+    X64Emitter& emitter = context.emitter;
+    const uword branch_offset = static_cast<uword>(index * Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+    const uword delay_offset = branch_offset + Constants::MIPS::SIZE_MIPS_INSTRUCTION;
+    const uword fall_through_offset = delay_offset + Constants::MIPS::SIZE_MIPS_INSTRUCTION;
+    const uword target_offset = delay_offset + (static_cast<sword>(inst.s_imm()) << 2);
+
+    // Work out the next PC into EAX (before the delay slot runs, which may
+    // change the operands).
+    switch (op)
+    {
+    case NativeOp::J:
+    case NativeOp::JAL:
+        if (op == NativeOp::JAL)
+        {
+            context.make_pc(fall_through_offset);
+            context.write_gpr(31, Reg::RAX);
+        }
+        context.make_pc(delay_offset);
+        emitter.alu_r32_imm32(AluOp::AND, Reg::RAX, 0xF0000000);
+        emitter.alu_r32_imm32(AluOp::OR, Reg::RAX, inst.addr() << 2);
+        break;
+    case NativeOp::JR:
+    case NativeOp::JALR:
+        // The link is written before the target is read, as in the interpreter.
+        if (op == NativeOp::JALR)
+        {
+            context.make_pc(fall_through_offset);
+            context.write_gpr(inst.rd(), Reg::RAX);
+        }
+        context.read_gpr(Reg::RAX, inst.rs());
+        break;
+    default:
+    {
+        Cond cond;
+        context.read_gpr(Reg::RCX, inst.rs());
+        switch (op)
+        {
+        case NativeOp::BEQ:
+        case NativeOp::BEQL:
+        case NativeOp::BNE:
+        case NativeOp::BNEL:
+            context.read_gpr(Reg::RDX, inst.rt());
+            emitter.alu_r64_r64(AluOp::CMP, Reg::RCX, Reg::RDX);
+            cond = ((op == NativeOp::BEQ) || (op == NativeOp::BEQL)) ? Cond::E : Cond::NE;
+            break;
+        case NativeOp::BLEZ:
+        case NativeOp::BLEZL:
+            emitter.alu_r64_imm32(AluOp::CMP, Reg::RCX, 0);
+            cond = Cond::LE;
+            break;
+        case NativeOp::BGTZ:
+        case NativeOp::BGTZL:
+            emitter.alu_r64_imm32(AluOp::CMP, Reg::RCX, 0);
+            cond = Cond::G;
+            break;
+        case NativeOp::BLTZ:
+        case NativeOp::BLTZL:
+            emitter.alu_r64_imm32(AluOp::CMP, Reg::RCX, 0);
+            cond = Cond::L;
+            break;
+        default:
+            emitter.alu_r64_imm32(AluOp::CMP, Reg::RCX, 0);
+            cond = Cond::GE;
+            break;
+        }
+
+        if (is_branch_likely(op))
+        {
+            // Not taken: the delay slot is nullified, only the branch has run.
+            context.exit_if(invert(cond), index + 1, false, fall_through_offset);
+            context.make_pc(target_offset);
+        }
+        else
+        {
+            // Keep the condition in DL, as working out the PC's changes the flags.
+            emitter.setcc(cond, Reg::RDX);
+            context.make_pc(target_offset);
+            emitter.mov_r32_r32(Reg::RCX, BLOCK_PC);
+            emitter.alu_r32_imm32(AluOp::ADD, Reg::RCX, fall_through_offset);
+            emitter.test_r8_r8(Reg::RDX, Reg::RDX);
+            emitter.cmov_r64_r64(Cond::E, Reg::RAX, Reg::RCX);
+        }
+        break;
+    }
+    }
+
+    // Keep the next PC in the scratch slot while the delay slot runs.
+    emitter.mov_m32_r32(Reg::RSP, 0, Reg::RAX);
+    emit_alu(context, delay_op, delay_inst);
+
+    context.flush();
+    emitter.mov_r32_m32(Reg::RAX, Reg::RSP, 0);
+    context.make_result(index + 2);
+}
+
+void CEeCoreRecompiler::emit_interpreted(CompileContext& context, const EeCoreDecodedInstruction& decoded, const size_t index)
+{
+    X64Emitter& emitter = context.emitter;
+    const uword pc_offset = static_cast<uword>(index * Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+
+    // The interpreter works on the register file directly.
+    context.flush();
+
+    emitter.mov_r64_imm64(Reg::RDI, reinterpret_cast<udword>(this));
+    emitter.mov_r32_imm32(Reg::RSI, decoded.inst.value);
+    emitter.mov_r32_imm32(Reg::RDX, static_cast<uword>(decoded.impl_index));
+    emitter.mov_r32_r32(Reg::RCX, BLOCK_PC);
+    emitter.alu_r32_imm32(AluOp::ADD, Reg::RCX, pc_offset);
+    emitter.call(reinterpret_cast<const void*>(&CEeCoreRecompiler::run_instruction));
+    emitter.test_r8_r8(Reg::RAX, Reg::RAX);
+    context.exit_if(Cond::E, index + 1, true, 0);
+
+    context.reload();
+}
+
+bool CEeCoreRecompiler::run_instruction(CEeCoreRecompiler* self, const uword raw_inst, const int impl_index, const uword pc_address)
+{
+    auto& r = self->core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    // Compiled code doesn't keep the PC up to date.
+    pc.write_uword(pc_address);
+
+    try
+    {
+        (self->*(self->EECORE_INSTRUCTION_TABLE[impl_index]))(EeCoreInstruction(raw_inst));
+        r.ee.core.r5900.reset_zero_register();
+    }
+    catch (...)
+    {
+        self->pending_exception = std::current_exception();
+        return false;
+    }
+
+    // Increment PC.
+    r.ee.core.r5900.bdelay.advance_pc(pc);
+
+    // Stop executing the block if the control flow changed (branch taken,
+    // branch likely nullified, exception raised, etc).
+    return pc.read_uword() == (pc_address + Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+}
+
+bool CEeCoreRecompiler::load_memory(CEeCoreRecompiler* self, const int op, const uword virtual_address, const uword pc_address, udword* value)
+{
+    auto& r = self->core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    try
+    {
+        // The PC is used as the EPC if an exception is raised, in which case
+        // it is then advanced into the handler (as in the interpreter).
+        pc.write_uword(pc_address);
+        const std::optional<uptr> physical_address = self->translate_address_data(virtual_address, READ);
+        if (!physical_address)
+        {
+            r.ee.core.r5900.bdelay.advance_pc(pc);
+            return false;
+        }
+
+        switch (static_cast<NativeOp>(op))
+        {
+        case NativeOp::LB:
+            *value = static_cast<udword>(static_cast<sdword>(static_cast<sbyte>(r.ee.bus.read_ubyte(BusContext::Ee, *physical_address))));
+            break;
+        case NativeOp::LBU:
+            *value = r.ee.bus.read_ubyte(BusContext::Ee, *physical_address);
+            break;
+        case NativeOp::LH:
+            *value = static_cast<udword>(static_cast<sdword>(static_cast<shword>(r.ee.bus.read_uhword(BusContext::Ee, *physical_address))));
+            break;
+        case NativeOp::LHU:
+            *value = r.ee.bus.read_uhword(BusContext::Ee, *physical_address);
+            break;
+        case NativeOp::LW:
+            *value = static_cast<udword>(static_cast<sdword>(static_cast<sword>(r.ee.bus.read_uword(BusContext::Ee, *physical_address))));
+            break;
+        case NativeOp::LWU:
+            *value = r.ee.bus.read_uword(BusContext::Ee, *physical_address);
+            break;
+        default:
+            *value = r.ee.bus.read_udword(BusContext::Ee, *physical_address);
+            break;
+        }
+    }
+    catch (...)
+    {
+        self->pending_exception = std::current_exception();
+        return false;
+    }
+
+    return true;
+}
+
+bool CEeCoreRecompiler::store_memory(CEeCoreRecompiler* self, const int op, const uword virtual_address, const uword pc_address, const udword value)
+{
+    auto& r = self->core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    try
+    {
+        // See load_memory().
+        pc.write_uword(pc_address);
+        const std::optional<uptr> physical_address = self->translate_address_data(virtual_address, WRITE);
+        if (!physical_address)
+        {
+            r.ee.core.r5900.bdelay.advance_pc(pc);
+            return false;
+        }
+
+        switch (static_cast<NativeOp>(op))
+        {
+        case NativeOp::SB:
+            r.ee.bus.write_ubyte(BusContext::Ee, *physical_address, static_cast<ubyte>(value));
+            break;
+        case NativeOp::SH:
+            r.ee.bus.write_uhword(BusContext::Ee, *physical_address, static_cast<uhword>(value));
+            break;
+        case NativeOp::SW:
+            r.ee.bus.write_uword(BusContext::Ee, *physical_address, static_cast<uword>(value));
+            break;
+        default:
+            r.ee.bus.write_udword(BusContext::Ee, *physical_address, value);
+            break;
+        }
+    }
+    catch (...)
+    {
+        self->pending_exception = std::current_exception();
+        return false;
+    }
+
+    return true;
+}
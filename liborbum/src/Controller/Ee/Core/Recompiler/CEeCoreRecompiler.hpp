@@ -0,0 +1,192 @@
+#pragma once
+
+#include <exception>
+
+#include "Common/Types/Jit/ExecutableMemory.hpp"
+#include "Common/Types/Jit/X64Emitter.hpp"
+#include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
+
+class Core;
+
+/// The EE Core recompiler. Translates the blocks from the interpreter's block
+/// cache (see EeCoreBlockCache) into host x86-64 code, which are then run
+/// directly instead of dispatching each instruction through the interpreter loop.
+/// The common integer ALU, shift, compare, conditional move, load/store and
+/// branch/jump instructions are translated into native code (see NativeOp).
+/// The lower 64-bits of the most used GPR's of a block are kept in host
+/// registers across the block, and only written back when the block exits or
+/// before an interpreted instruction. Loads and stores work out the address
+/// natively, and call a helper for the address translation and bus access.
+/// The interpreter instruction implementations are used for all other
+/// instructions, so this inherits from the interpreter.
+/// Compiled code is tied to the block it was generated from - it is discarded
+/// whenever the block is invalidated (page write, TLB change).
+/// Compiled code always runs the whole block (unless the control flow changes),
+/// so blocks that would be cut short by the time slice, or that start in a
+/// branch delay slot, are interpreted instead.
+/// Only x86-64 Unix (SysV ABI) hosts are supported, on other hosts (or if the
+/// executable memory could not be allocated) this falls back to interpreting.
+class CEeCoreRecompiler : public CEeCoreInterpreter
+{
+public:
+    /// Size of the host code buffer. Once full, all compiled code is discarded.
+    static constexpr size_t CODE_MEMORY_SIZE = 32 * 1024 * 1024;
+
+    /// Number of GPR's kept in host registers per block.
+    static constexpr int NUMBER_CACHED_GPRS = 4;
+
+    CEeCoreRecompiler(Core* core);
+    ~CEeCoreRecompiler();
+
+    /// Steps through the EE Core state, running a whole (compiled) block at a time.
+    int time_step(const int ticks_available) override;
+
+private:
+    /// Compiled block function signature. Takes the virtual address of the
+    /// block, and returns the number of instructions executed in the upper 32
+    /// bits and the next PC in the lower 32 bits - unless PC_WRITTEN is set,
+    /// in which case the PC has already been updated (ie: an interpreted
+    /// instruction or an exception changed the control flow).
+    using BlockFn = udword (*)(const uword pc_address);
+    static constexpr udword PC_WRITTEN = static_cast<udword>(1) << 63;
+
+    /// Instructions translated into native code.
+    enum class NativeOp
+    {
+        None,
+        ADDIU,
+        DADDIU,
+        ADDU,
+        DADDU,
+        SUBU,
+        DSUBU,
+        AND,
+        OR,
+        XOR,
+        NOR,
+        ANDI,
+        ORI,
+        XORI,
+        LUI,
+        SLL,
+        SRL,
+        SRA,
+        DSLL,
+        DSRL,
+        DSRA,
+        DSLL32,
+        DSRL32,
+        DSRA32,
+        SLLV,
+        SRLV,
+        SRAV,
+        DSLLV,
+        DSRLV,
+        DSRAV,
+        SLT,
+        SLTU,
+        SLTI,
+        SLTIU,
+        MOVZ,
+        MOVN,
+        LB,
+        LBU,
+        LH,
+        LHU,
+        LW,
+        LWU,
+        LD,
+        SB,
+        SH,
+        SW,
+        SD,
+        BEQ,
+        BNE,
+        BLEZ,
+        BGTZ,
+        BLTZ,
+        BGEZ,
+        BEQL,
+        BNEL,
+        BLEZL,
+        BGTZL,
+        BLTZL,
+        BGEZL,
+        J,
+        JAL,
+        JR,
+        JALR
+    };
+
+    static bool is_load(const NativeOp op)
+    {
+        return (op >= NativeOp::LB) && (op <= NativeOp::LD);
+    }
+
+    static bool is_store(const NativeOp op)
+    {
+        return (op >= NativeOp::SB) && (op <= NativeOp::SD);
+    }
+
+    static bool is_branch(const NativeOp op)
+    {
+        return op >= NativeOp::BEQ;
+    }
+
+    static bool is_branch_likely(const NativeOp op)
+    {
+        return (op >= NativeOp::BEQL) && (op <= NativeOp::BGEZL);
+    }
+
+    /// Returns the GPR's (bitmask by register index) the instruction reads or writes natively.
+    static uword get_gprs_used(const NativeOp op, const EeCoreInstruction inst);
+
+    /// Native operation of each implementation index (see EECORE_INSTRUCTION_TABLE).
+    NativeOp native_ops[Constants::EE::EECore::NUMBER_INSTRUCTIONS];
+
+    /// Compilation state of a block (register cache, exits), see the .cpp.
+    struct CompileContext;
+
+    /// Translates the block into host code, returning nullptr on failure.
+    BlockFn compile_block(const EeCoreBlock& block);
+
+    /// Emits native code for an ALU, shift, compare or conditional move instruction.
+    void emit_alu(CompileContext& context, const NativeOp op, const EeCoreInstruction inst);
+
+    /// Emits native code for a load or store instruction at the index in the block.
+    void emit_memory_access(CompileContext& context, const NativeOp op, const EeCoreInstruction inst, const size_t index);
+
+    /// Emits native code for the branch or jump instruction at the index in
+    /// the block, followed by its delay slot instruction (an ALU instruction),
+    /// and exits the block.
+    void emit_branch(CompileContext& context, const NativeOp op, const EeCoreInstruction inst, const NativeOp delay_op, const EeCoreInstruction delay_inst, const size_t index);
+
+    /// Emits a call to the interpreter implementation of the instruction at the index in the block.
+    void emit_interpreted(CompileContext& context, const EeCoreDecodedInstruction& decoded, const size_t index);
+
+    /// Runs a single instruction at the PC given through the interpreter
+    /// implementation, and advances the PC. Called from compiled code.
+    /// Returns if the block should continue executing (ie: no control flow
+    /// change, no host exception thrown).
+    static bool run_instruction(CEeCoreRecompiler* self, const uword raw_inst, const int impl_index, const uword pc_address);
+
+    /// Performs the memory access of a load or store instruction (see NativeOp)
+    /// at the PC given. Called from compiled code. Returns false if the access
+    /// raised an EE Core exception (the PC is updated), or a host exception was
+    /// thrown, in which case the block should stop.
+    static bool load_memory(CEeCoreRecompiler* self, const int op, const uword virtual_address, const uword pc_address, udword* value);
+    static bool store_memory(CEeCoreRecompiler* self, const int op, const uword virtual_address, const uword pc_address, const udword value);
+
+    /// Host code buffer.
+    ExecutableMemory code_memory;
+
+    /// C++ exceptions can't unwind through generated code, so they are caught
+    /// in the helpers and rethrown after the compiled block returns.
+    std::exception_ptr pending_exception;
+
+    /// Recompiler statistics.
+    size_t number_blocks_compiled;
+    size_t number_code_flushes;
+    size_t number_native_instructions;
+    size_t number_interpreted_instructions;
+};
@@ -21,6 +21,10 @@ void CEeDmac::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
+        // Nothing to transfer (the interrupt line is updated by D_STAT writes).
+        if (is_idle())
+            break;
+
         int ticks_remaining = time_to_ticks(event.data.time_us);
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
@@ -93,12 +97,25 @@ int CEeDmac::time_step(const int ticks_available)
         }
     }
 
-    // Check for D_STAT interrupt bit status, send interrupt to EE Core (INT1 line) if not masked.
-    handle_interrupt_check();
-
     return 1;
 }
 
+bool CEeDmac::is_idle()
+{
+    auto& r = core->get_resources();
+
+    if (!r.ee.dmac.ctrl.extract_field(EeDmacRegister_Ctrl::DMAE))
+        return true;
+
+    for (auto& channel : r.ee.dmac.channels)
+    {
+        if (channel.chcr->extract_field(EeDmacChannelRegister_Chcr::STR))
+            return false;
+    }
+
+    return true;
+}
+
 int CEeDmac::transfer_data(EeDmacChannel& channel)
 {
     // Determine the runtime direction of data flow by checking the CHCR.DIR field.
@@ -417,18 +434,6 @@ bool CEeDmac::transfer_interleaved(EeDmacChannel& channel)
 	*/
 }
 
-void CEeDmac::handle_interrupt_check()
-{
-    auto& r = core->get_resources();
-    auto _lock = r.ee.dmac.stat.scope_lock();
-
-    // Set the interrupt line if there was a condition set, otherwise clear the interrupt line.
-    if (r.ee.dmac.stat.is_interrupt_pending())
-        r.ee.core.cop0.cause.set_irq_line(3);
-    else
-        r.ee.core.cop0.cause.clear_irq_line(3);
-}
-
 bool CEeDmac::is_source_stall_control_on(EeDmacChannel& channel)
 {
     auto& r = core->get_resources();
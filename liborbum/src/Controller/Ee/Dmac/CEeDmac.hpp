@@ -31,6 +31,10 @@ public:
     /// If a channel is enabled for transfer, data units (128-bit) are sent.
     int time_step(const int ticks_available);
 
+    /// Returns if no channel has a transfer started (or DMA is disabled), in
+    /// which case the time slice is skipped rather than ticked through.
+    bool is_idle();
+
     /////////////////////////////////
     // DMAC Logical Mode Functions //
     /////////////////////////////////
@@ -48,10 +52,6 @@ public:
     // DMAC Helper Functions //
     ///////////////////////////
 
-    /// Checks if there is an DMA transfer interrupt pending, and handles the interrupting of the EE Core (through the INT1 line).
-    /// See EE Core Users Manual page 73-75 for the EE Core details. Note that on page 75, there is a typo, where the INTx lines are mixed up on bits 10 and 11 (verified through running through bios code).
-    void handle_interrupt_check();
-
     /// Transfers data units (128-bits) between mem <-> channel.
     /// Returns the number of data units transfered.
     /// On the condition that the channel FIFO is empty (source) or full (drain), returns 0.
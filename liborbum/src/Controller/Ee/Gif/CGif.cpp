@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/format.hpp>
+
 #include "Controller/Ee/Gif/CGif.hpp"
 
 #include "Core.hpp"
@@ -6,6 +13,24 @@
 CGif::CGif(Core* core) :
     CController(core)
 {
+    batch.number_writes = 0;
+}
+
+CGif::~CGif()
+{
+#if defined(BUILD_DEBUG)
+    const double emulated_time_s = DEBUG_EMULATED_TIME_US / 1.0e6;
+    const double host_time_s = DEBUG_HOST_TIME_US / 1.0e6;
+    for (int i = 0; i < RGif::NUMBER_PATHS; i++)
+    {
+        BOOST_LOG(Core::get_logger()) << boost::format("GIF PATH%d: qwords = %d, %.0f qwords/s (emulated), %.0f qwords/s (host).")
+                                             % (i + 1)
+                                             % DEBUG_PATH_QWORDS[i]
+                                             % (emulated_time_s > 0.0 ? (DEBUG_PATH_QWORDS[i] / emulated_time_s) : 0.0)
+                                             % (host_time_s > 0.0 ? (DEBUG_PATH_QWORDS[i] / host_time_s) : 0.0);
+    }
+    BOOST_LOG(Core::get_logger()) << boost::format("GIF: GS register write batches = %d.") % DEBUG_BATCHES;
+#endif
 }
 
 void CGif::handle_event(const ControllerEvent& event)
@@ -14,6 +39,9 @@ void CGif::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
+#if defined(BUILD_DEBUG)
+        DEBUG_EMULATED_TIME_US += event.data.time_us;
+#endif
         int ticks_remaining = time_to_ticks(event.data.time_us);
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
@@ -46,6 +74,374 @@ int CGif::time_to_ticks(const double time_us)
 
 int CGif::time_step(const int ticks_available)
 {
-    // Not yet implemented.
+#if defined(BUILD_DEBUG)
+    const auto debug_start = std::chrono::high_resolution_clock::now();
+#endif
+
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    if (gif.ctrl.extract_field(GifRegister_Ctrl::RST))
+    {
+        reset();
+        gif.ctrl.insert_field(GifRegister_Ctrl::RST, 0);
+    }
+
+    // Each data qword produces at most 2 register writes (REGLIST, IMAGE),
+    // and each GIFtag at most 1 (PRE), so chunks are sized to always fit in
+    // the batch.
+    ubyte buffer[GsRegisterWriteBatch::MAX_WRITES / 2 * NUMBER_BYTES_IN_QWORD];
+    int ticks = 0;
+    while (!gif.ctrl.extract_field(GifRegister_Ctrl::PSE) && (ticks < ticks_available))
+    {
+        if ((GsRegisterWriteBatch::MAX_WRITES - batch.number_writes) < 2)
+        {
+            // Stall until the GS has caught up.
+            if (!send_batch())
+                break;
+        }
+
+        const int path_index = select_path();
+        if (!path_index)
+            break;
+
+        // PATH3 stops at each point it can be interrupted at, so PATH1/2 get
+        // to take over there (see select_path()).
+        GifPathState& path = gif.paths[path_index - 1];
+        size_t max_qwords = std::min({(GsRegisterWriteBatch::MAX_WRITES - batch.number_writes) / 2,
+                                      get_qwords_remaining(path),
+                                      static_cast<size_t>(ticks_available - ticks)});
+        if (path_index == 3)
+        {
+            const size_t imt_qwords = get_path3_imt_qwords();
+            max_qwords = std::min(max_qwords, imt_qwords ? imt_qwords : IMT_QWORDS);
+        }
+        const size_t qwords = read_path(path_index, buffer, max_qwords);
+        if (!qwords)
+            break;
+
+        for (size_t i = 0; i < qwords; i++)
+            process_qword(path, buffer + i * NUMBER_BYTES_IN_QWORD);
+        ticks += static_cast<int>(qwords);
+
+#if defined(BUILD_DEBUG)
+        DEBUG_PATH_QWORDS[path_index - 1] += qwords;
+#endif
+    }
+
+    // Let the GS start on whatever has been converted so far.
+    send_batch();
+    update_stat();
+
+#if defined(BUILD_DEBUG)
+    DEBUG_HOST_TIME_US += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - debug_start).count();
+#endif
+
+    // Idle for the rest of the time slice once there is nothing to do.
     return ticks_available;
-}
\ No newline at end of file
+}
+
+void CGif::reset()
+{
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    for (auto& path : gif.paths)
+        path = GifPathState();
+    gif.active_path = 0;
+    gif.path1_buffer.initialize();
+    gif.path2_buffer.initialize();
+}
+
+int CGif::select_path()
+{
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    const bool is_path12_pending = gif.path1_buffer.has_read_available() || gif.path2_buffer.has_read_available();
+    if (gif.active_path && gif.paths[gif.active_path - 1].is_packet_active)
+    {
+        // In intermittent mode PATH3 gives way to PATH1/2 between each 8
+        // qwords of IMAGE data, recording where it was interrupted.
+        // See EE Users Manual page 150.
+        if ((gif.active_path != 3) || !is_path12_pending || get_path3_imt_qwords())
+            return gif.active_path;
+
+        const GifPathState& path3 = gif.paths[2];
+        gif.p3cnt.insert_field(GifRegister_P3cnt::P3CNT, path3.loops_remaining);
+        gif.p3tag.insert_field(GifRegister_P3tag::LOOPCNT, path3.tag.nloop());
+        gif.p3tag.insert_field(GifRegister_P3tag::EOP, path3.tag.eop());
+    }
+
+    // PATH3 can be masked by MODE.M3R or the VIF1 MSKPATH3 VIFcode, which
+    // only takes effect between packets - an interrupted packet is resumed.
+    const bool is_path3_masked = gif.mode.extract_field(GifRegister_Mode::M3R)
+                                 || gif.stat.extract_field(GifRegister_Stat::M3P);
+    const bool is_path3_interrupted = gif.paths[2].is_packet_active;
+
+    if (gif.path1_buffer.has_read_available())
+        gif.active_path = 1;
+    else if (gif.path2_buffer.has_read_available())
+        gif.active_path = 2;
+    else if ((is_path3_interrupted || !is_path3_masked) && r.fifo_gif.has_read_available(NUMBER_BYTES_IN_QWORD))
+        gif.active_path = 3;
+    else
+        gif.active_path = 0;
+
+    return gif.active_path;
+}
+
+size_t CGif::get_path3_imt_qwords() const
+{
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    const GifPathState& path = gif.paths[2];
+    if (!gif.mode.extract_field(GifRegister_Mode::IMT) || !path.loops_remaining || (path.tag.flg() != Giftag::FLG_IMAGE))
+        return SIZE_MAX;
+
+    const size_t qwords_transferred = path.tag.nloop() - path.loops_remaining;
+    return (IMT_QWORDS - qwords_transferred % IMT_QWORDS) % IMT_QWORDS;
+}
+
+size_t CGif::get_qwords_remaining(const GifPathState& path)
+{
+    if (!path.loops_remaining)
+        return 1;
+
+    const size_t nreg = path.tag.nreg();
+    switch (path.tag.flg())
+    {
+    case Giftag::FLG_PACKED:
+        return path.loops_remaining * nreg - path.register_index;
+    case Giftag::FLG_REGLIST:
+        return (path.loops_remaining * nreg - path.register_index + 1) / 2;
+    default:
+        return path.loops_remaining;
+    }
+}
+
+size_t CGif::read_path(const int path_index, ubyte* buffer, const size_t max_qwords)
+{
+    auto& r = core->get_resources();
+
+    switch (path_index)
+    {
+    case 1:
+        return r.ee.gif.path1_buffer.read(buffer, max_qwords);
+    case 2:
+        return r.ee.gif.path2_buffer.read(buffer, max_qwords);
+    default:
+    {
+        size_t qwords = 0;
+        while ((qwords < max_qwords) && r.fifo_gif.has_read_available(NUMBER_BYTES_IN_QWORD))
+        {
+            r.fifo_gif.read(buffer + qwords * NUMBER_BYTES_IN_QWORD, NUMBER_BYTES_IN_QWORD);
+            qwords++;
+        }
+        return qwords;
+    }
+    }
+}
+
+void CGif::process_qword(GifPathState& path, const ubyte* qword)
+{
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    udword lo, hi;
+    std::memcpy(&lo, qword, NUMBER_BYTES_IN_DWORD);
+    std::memcpy(&hi, qword + NUMBER_BYTES_IN_DWORD, NUMBER_BYTES_IN_DWORD);
+
+    if (!path.loops_remaining)
+    {
+        // New GIFtag.
+        path.tag = Giftag(lo, hi);
+        path.loops_remaining = path.tag.nloop();
+        path.register_index = 0;
+        path.q = 0x3F800000;
+        path.is_packet_active = true;
+
+        gif.tag0.write_uword(static_cast<uword>(lo));
+        gif.tag1.write_uword(static_cast<uword>(lo >> 32));
+        gif.tag2.write_uword(static_cast<uword>(hi));
+        gif.tag3.write_uword(static_cast<uword>(hi >> 32));
+
+        if (path.tag.pre() && (path.tag.flg() == Giftag::FLG_PACKED))
+            write_register(GsRegisterAddress::PRIM, path.tag.prim());
+    }
+    else
+    {
+        switch (path.tag.flg())
+        {
+        case Giftag::FLG_PACKED:
+        {
+            process_packed(path, path.tag.reg(path.register_index), lo, hi);
+            advance_register(path);
+            break;
+        }
+        case Giftag::FLG_REGLIST:
+        {
+            // Two descriptors per qword, with the last qword padded if the
+            // total is odd. A+D and NOP descriptors write nothing.
+            const udword halves[2] = {lo, hi};
+            for (const udword data : halves)
+            {
+                if (!path.loops_remaining)
+                    break;
+                const ubyte descriptor = path.tag.reg(path.register_index);
+                if (descriptor < GsRegisterAddress::AD)
+                    write_register(descriptor, data);
+                advance_register(path);
+            }
+            break;
+        }
+        default:
+        {
+            write_register(GsRegisterAddress::HWREG, lo);
+            write_register(GsRegisterAddress::HWREG, hi);
+            path.loops_remaining--;
+            break;
+        }
+        }
+    }
+
+    if (!path.loops_remaining && path.tag.eop())
+        path.is_packet_active = false;
+
+    gif.cnt.insert_field(GifRegister_Cnt::LOOPCNT, path.loops_remaining);
+    gif.cnt.insert_field(GifRegister_Cnt::REGCNT, path.register_index);
+}
+
+void CGif::process_packed(GifPathState& path, const ubyte descriptor, const udword lo, const udword hi)
+{
+    switch (descriptor)
+    {
+    case GsRegisterAddress::PRIM:
+    {
+        write_register(GsRegisterAddress::PRIM, lo & 0x7FF);
+        break;
+    }
+    case GsRegisterAddress::RGBAQ:
+    {
+        const udword rgba = (lo & 0xFF)
+                            | (((lo >> 32) & 0xFF) << 8)
+                            | ((hi & 0xFF) << 16)
+                            | (((hi >> 32) & 0xFF) << 24);
+        write_register(GsRegisterAddress::RGBAQ, rgba | (static_cast<udword>(path.q) << 32));
+        break;
+    }
+    case GsRegisterAddress::ST:
+    {
+        path.q = static_cast<uword>(hi);
+        write_register(GsRegisterAddress::ST, lo);
+        break;
+    }
+    case GsRegisterAddress::UV:
+    {
+        write_register(GsRegisterAddress::UV, (lo & 0x3FFF) | (((lo >> 32) & 0x3FFF) << 16));
+        break;
+    }
+    case GsRegisterAddress::XYZF2:
+    case GsRegisterAddress::XYZF3:
+    {
+        // ADC (bit 111) disables the drawing kick.
+        const bool adc = ((hi >> 47) & 0x1) != 0;
+        const udword xyzf = (lo & 0xFFFF)
+                            | (((lo >> 32) & 0xFFFF) << 16)
+                            | (((hi >> 4) & 0xFFFFFF) << 32)
+                            | (((hi >> 36) & 0xFF) << 56);
+        const bool is_kick = (descriptor == GsRegisterAddress::XYZF2) && !adc;
+        write_register(is_kick ? GsRegisterAddress::XYZF2 : GsRegisterAddress::XYZF3, xyzf);
+        break;
+    }
+    case GsRegisterAddress::XYZ2:
+    case GsRegisterAddress::XYZ3:
+    {
+        const bool adc = ((hi >> 47) & 0x1) != 0;
+        const udword xyz = (lo & 0xFFFF)
+                           | (((lo >> 32) & 0xFFFF) << 16)
+                           | ((hi & 0xFFFFFFFF) << 32);
+        const bool is_kick = (descriptor == GsRegisterAddress::XYZ2) && !adc;
+        write_register(is_kick ? GsRegisterAddress::XYZ2 : GsRegisterAddress::XYZ3, xyz);
+        break;
+    }
+    case GsRegisterAddress::FOG:
+    {
+        write_register(GsRegisterAddress::FOG, ((hi >> 36) & 0xFF) << 56);
+        break;
+    }
+    case GsRegisterAddress::AD:
+    {
+        write_register(static_cast<ubyte>(hi & 0xFF), lo);
+        break;
+    }
+    case GsRegisterAddress::NOP:
+    {
+        break;
+    }
+    default:
+    {
+        // TEX0_1/2, CLAMP_1/2 and the reserved descriptor: the lower 64 bits as is.
+        write_register(descriptor, lo);
+        break;
+    }
+    }
+}
+
+void CGif::advance_register(GifPathState& path)
+{
+    path.register_index++;
+    if (path.register_index == path.tag.nreg())
+    {
+        path.register_index = 0;
+        path.loops_remaining--;
+    }
+}
+
+void CGif::write_register(const ubyte address, const udword data)
+{
+    batch.writes[batch.number_writes++] = {address, data};
+}
+
+bool CGif::send_batch()
+{
+    if (!batch.number_writes)
+        return true;
+
+    auto& r = core->get_resources();
+    if (!r.gs.command_ring.try_push(batch))
+        return false;
+
+    batch.number_writes = 0;
+#if defined(BUILD_DEBUG)
+    DEBUG_BATCHES++;
+#endif
+    return true;
+}
+
+void CGif::update_stat()
+{
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    const int active_path = (gif.active_path && gif.paths[gif.active_path - 1].is_packet_active) ? gif.active_path : 0;
+    const bool is_path3_masked = gif.mode.extract_field(GifRegister_Mode::M3R)
+                                 || gif.stat.extract_field(GifRegister_Stat::M3P);
+    const bool is_path3_interrupted = gif.paths[2].is_packet_active;
+
+    size_t fifo_qwords = 0;
+    while ((fifo_qwords < 16) && r.fifo_gif.has_read_available((fifo_qwords + 1) * NUMBER_BYTES_IN_QWORD))
+        fifo_qwords++;
+
+    gif.stat.insert_field(GifRegister_Stat::M3R, gif.mode.extract_field(GifRegister_Mode::M3R));
+    gif.stat.insert_field(GifRegister_Stat::IMT, gif.mode.extract_field(GifRegister_Mode::IMT));
+    gif.stat.insert_field(GifRegister_Stat::PSE, gif.ctrl.extract_field(GifRegister_Ctrl::PSE));
+    gif.stat.insert_field(GifRegister_Stat::IP3, (active_path != 3) && is_path3_interrupted);
+    gif.stat.insert_field(GifRegister_Stat::P3Q, (active_path != 3) && (is_path3_interrupted || !is_path3_masked) && fifo_qwords);
+    gif.stat.insert_field(GifRegister_Stat::P2Q, (active_path != 2) && gif.path2_buffer.has_read_available());
+    gif.stat.insert_field(GifRegister_Stat::P1Q, (active_path != 1) && gif.path1_buffer.has_read_available());
+    gif.stat.insert_field(GifRegister_Stat::OPH, active_path != 0);
+    gif.stat.insert_field(GifRegister_Stat::APATH, active_path);
+    gif.stat.insert_field(GifRegister_Stat::FQC, fifo_qwords);
+}
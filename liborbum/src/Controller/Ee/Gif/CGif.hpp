@@ -1,16 +1,92 @@
 #pragma once
 
 #include "Controller/CController.hpp"
+#include "Resources/Gs/RGs.hpp"
 
+struct GifPathState;
+
+/// The GIF, which reads GIF packets from PATH1 (VU1 XGKICK), PATH2 (VIF1
+/// DIRECT/DIRECTHL) and PATH3 (DMAC channel 2), and converts them into GS
+/// general register writes.
+/// Paths are arbitrated between packets, with PATH1 having the highest
+/// priority and PATH3 the lowest. In intermittent mode (MODE.IMT), PATH3
+/// IMAGE data can also be interrupted by PATH1/2 every 8 qwords, resuming
+/// once they have no more packets. Register writes are sent to the GS in
+/// batches (see RGs::command_ring); when the GS queue is full the GIF
+/// stalls until the GS catches up.
+/// See EE Users Manual page 149 onwards.
 class CGif : public CController
 {
 public:
     CGif(Core* core);
+    ~CGif();
 
     void handle_event(const ControllerEvent& event) override;
 
     /// Converts a time duration into the number of ticks that would have occurred.
     int time_to_ticks(const double time_us);
 
+    /// Transfers packet data from the paths, one qword per tick.
     int time_step(const int ticks_available);
+
+    /// Resets the path state and input, as done by CTRL.RST.
+    void reset();
+
+    /// Number of qwords of IMAGE data PATH3 transfers between the points it
+    /// can be interrupted at in intermittent mode.
+    static constexpr size_t IMT_QWORDS = 8;
+
+    /// Returns the path (1 -> 3) which should transfer next, or 0 if none has
+    /// data. The active path keeps priority until the end of its packet,
+    /// except for PATH3 in intermittent mode (see get_path3_imt_qwords()).
+    int select_path();
+
+    /// Returns the number of PATH3 qwords until the next point PATH1/2 can
+    /// interrupt it at (0 if at one now), or SIZE_MAX if it can't be
+    /// interrupted (not in intermittent mode or not in IMAGE data).
+    size_t get_path3_imt_qwords() const;
+
+    /// Returns the number of qwords left to read until the end of the current
+    /// GIFtag's data (1 if a new GIFtag is to be read). Reading is limited to
+    /// this so data of the next packet is never taken out of a path before
+    /// arbitration has happened.
+    static size_t get_qwords_remaining(const GifPathState& path);
+
+    /// Reads up to max_qwords qwords from the path given (1 -> 3), returning
+    /// the number read.
+    size_t read_path(const int path_index, ubyte* buffer, const size_t max_qwords);
+
+    /// Processes a qword of the path given, being either a GIFtag or data.
+    void process_qword(GifPathState& path, const ubyte* qword);
+
+    /// Converts a PACKED mode qword into a GS register write according to the
+    /// register descriptor. See EE Users Manual page 153.
+    void process_packed(GifPathState& path, const ubyte descriptor, const udword lo, const udword hi);
+
+    /// Moves on to the next register descriptor, and to the next loop once
+    /// all NREG descriptors have been processed.
+    static void advance_register(GifPathState& path);
+
+    /// Queues a GS register write in the current batch. There is always space
+    /// (see time_step()).
+    void write_register(const ubyte address, const udword data);
+
+    /// Sends the current batch to the GS, returning false if the GS queue is full.
+    bool send_batch();
+
+    /// Updates STAT with the state of the paths.
+    void update_stat();
+
+private:
+    /// Register writes not yet sent to the GS.
+    GsRegisterWriteBatch batch;
+
+#if defined(BUILD_DEBUG)
+    /// Throughput statistics: qwords transferred per path (including GIFtags),
+    /// emulated time elapsed and host time spent in time_step() (us).
+    size_t DEBUG_PATH_QWORDS[3] = {0, 0, 0};
+    size_t DEBUG_BATCHES = 0;
+    double DEBUG_EMULATED_TIME_US = 0.0;
+    double DEBUG_HOST_TIME_US = 0.0;
+#endif
 };
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Controller/Ee/Timers/CEeTimers.hpp"
 
 #include "Core.hpp"
@@ -6,17 +8,24 @@
 CEeTimers::CEeTimers(Core* core) :
     CController(core)
 {
+    auto& r = core->get_resources();
+
+    for (auto& unit : r.ee.timers.units)
+    {
+        unit.count->set_master_cycle_source(core->get_scheduler().get_cycle_counter());
+        scheduled_cycles[*unit.unit_id] = 0;
+    }
 }
 
 void CEeTimers::handle_event(const ControllerEvent& event)
 {
+    auto& r = core->get_resources();
+
     switch (event.type)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks = time_to_ticks(event.data.time_us);
-        for (int i = 0; i < ticks; i++)
-            tick_timer(ControllerEvent::Type::Time);
+        update_units();
         break;
     }
     case ControllerEvent::Type::HBlank:
@@ -25,6 +34,11 @@ void CEeTimers::handle_event(const ControllerEvent& event)
             tick_timer(ControllerEvent::Type::HBlank);
         break;
     }
+    case ControllerEvent::Type::Scheduled:
+    {
+        handle_timer_events(r.ee.timers.units[event.data.id]);
+        break;
+    }
     default:
     {
         throw std::runtime_error("CEeTimers event handler not implemented - please fix!");
@@ -32,22 +46,26 @@ void CEeTimers::handle_event(const ControllerEvent& event)
     }
 }
 
-int CEeTimers::time_to_ticks(const double time_us)
+void CEeTimers::update_units()
 {
-    // TODO: find out for sure.
-    int ticks = static_cast<int>(time_us / 1.0e6 * Constants::EE::EEBUS_CLK_SPEED * core->get_options().system_bias_eetimers);
+    auto& r = core->get_resources();
 
-    if (ticks < 10)
+    for (auto& unit : r.ee.timers.units)
     {
-        static bool warned = false;
-        if (!warned)
+        auto _lock = unit.mode->scope_lock();
+
+        if (handle_timer_write_latch(unit))
+            continue;
+
+        // Derived units need to be restarted when the count or compare value is written to.
+        if (unit.count->is_counting())
         {
-            BOOST_LOG(Core::get_logger()) << "EeTimers ticks too low - increase time delta";
-            warned = true;
+            bool count_written = unit.count->is_rebased_and_reset();
+            bool compare_written = unit.compare->read_uword() != unit.count->get_compare();
+            if (count_written || compare_written)
+                program_timer(unit);
         }
     }
-
-    return ticks;
 }
 
 void CEeTimers::tick_timer(const ControllerEvent::Type ce_type)
@@ -58,17 +76,10 @@ void CEeTimers::tick_timer(const ControllerEvent::Type ce_type)
     for (auto& unit : r.ee.timers.units)
     {
         auto _lock = unit.mode->scope_lock();
-        
-        auto[prescale, event_type] = unit.mode->get_properties();
 
-        // Check if we need to perform reset proceedures.
-        if (unit.mode->write_latch)
-        {
-            // Reset the count register.
-            unit.count->reset_prescale(prescale);
+        handle_timer_write_latch(unit);
 
-            unit.mode->write_latch = false;
-        }
+        auto[prescale, event_type] = unit.mode->get_properties();
 
         // Count only if enabled.
         bool unit_enabled = unit.mode->extract_field(EeTimersUnitRegister_Mode::CUE);
@@ -90,14 +101,93 @@ void CEeTimers::tick_timer(const ControllerEvent::Type ce_type)
         }
 
         // Check for interrupt conditions on the timer.
-        handle_timer_interrupt(unit);
+        bool has_reached_compare = unit.count->read_uword() == unit.compare->read_uword();
+        bool has_overflowed = unit.count->is_overflowed_and_reset();
+        handle_timer_interrupt(unit, has_reached_compare, has_overflowed);
 
         // Check for zero return (ZRET) conditions (perform after interrupt check, otherwise this may cause interrupt to be missed).
         handle_timer_zret(unit);
     }
 }
 
-void CEeTimers::handle_timer_interrupt(EeTimersUnit& unit)
+bool CEeTimers::handle_timer_write_latch(EeTimersUnit& unit)
+{
+    if (!unit.mode->write_latch)
+        return false;
+
+    auto[prescale, event_type] = unit.mode->get_properties();
+
+    // Reset the count register.
+    unit.count->reset_prescale(prescale);
+    program_timer(unit);
+
+    unit.mode->write_latch = false;
+    return true;
+}
+
+void CEeTimers::program_timer(EeTimersUnit& unit)
+{
+    auto[prescale, event_type] = unit.mode->get_properties();
+
+    // H-BLNK clocked units are ticked (see tick_timer()).
+    bool unit_enabled = unit.mode->extract_field(EeTimersUnitRegister_Mode::CUE);
+    if (!unit_enabled || event_type != ControllerEvent::Type::Time)
+    {
+        unit.count->stop_counting();
+        return;
+    }
+
+    bool gated_mode = unit.mode->extract_field(EeTimersUnitRegister_Mode::GATE) > 0;
+    if (gated_mode)
+        throw std::runtime_error("EE Timers gated mode not fully implemented.");
+
+    // TODO: find out the bus clock bias for sure.
+    const double clk_speed = Constants::EE::EEBUS_CLK_SPEED * core->get_options().system_bias_eetimers / prescale;
+    bool zret = unit.mode->extract_field(EeTimersUnitRegister_Mode::ZRET) > 0;
+    unit.count->start_counting(clk_speed / EventScheduler::MASTER_CLK_SPEED, static_cast<uword>(unit.compare->read_uword()), zret);
+    unit.count->is_rebased_and_reset();
+
+    schedule_timer_event(unit);
+}
+
+void CEeTimers::handle_timer_events(EeTimersUnit& unit)
+{
+    auto _lock = unit.mode->scope_lock();
+
+    bool has_reached_compare, has_overflowed;
+    unit.count->check_events(has_reached_compare, has_overflowed);
+    handle_timer_interrupt(unit, has_reached_compare, has_overflowed);
+
+    schedule_timer_event(unit);
+}
+
+void CEeTimers::schedule_timer_event(EeTimersUnit& unit)
+{
+    // Events are only needed for interrupts (ZRET is part of the derived count).
+    bool cmpe = unit.mode->extract_field(EeTimersUnitRegister_Mode::CMPE) > 0;
+    bool ovfe = unit.mode->extract_field(EeTimersUnitRegister_Mode::OVFE) > 0;
+    if (!cmpe && !ovfe)
+        return;
+
+    udword cycle = unit.count->get_next_event_cycle();
+    if (cycle == LazyCountRegister::NO_EVENT)
+        return;
+
+    // An event that is still pending and not later than the next condition
+    // will check the unit in time (and schedule again) - stale events are harmless.
+    auto& scheduler = core->get_scheduler();
+    const udword current_cycle = scheduler.get_current_cycle();
+    udword& scheduled_cycle = scheduled_cycles[*unit.unit_id];
+    if ((scheduled_cycle > current_cycle) && (scheduled_cycle <= cycle))
+        return;
+
+    scheduled_cycle = std::max(cycle, current_cycle + 1);
+    ControllerEvent event{ControllerEvent::Type::Scheduled, {}};
+    event.data.id = *unit.unit_id;
+    scheduler.schedule_at(ControllerType::Type::EeTimers, event, scheduled_cycle);
+}
+
+void CEeTimers::handle_timer_interrupt(EeTimersUnit& unit, const bool has_reached_compare, const bool has_overflowed)
 {
     auto& r = core->get_resources();
 
@@ -106,14 +196,14 @@ void CEeTimers::handle_timer_interrupt(EeTimersUnit& unit)
     // Check for Compare-Interrupt.
     if (unit.mode->extract_field(EeTimersUnitRegister_Mode::CMPE))
     {
-        if (unit.count->read_uword() == unit.compare->read_uword())
+        if (has_reached_compare)
             interrupt = true;
     }
 
     // Check for Overflow-Interrupt.
     if (unit.mode->extract_field(EeTimersUnitRegister_Mode::OVFE))
     {
-        if (unit.count->is_overflowed_and_reset())
+        if (has_overflowed)
             interrupt = true;
     }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/Constants.hpp"
+#include "Common/Types/Primitive.hpp"
 #include "Controller/CController.hpp"
 #include "Resources/Ee/Timers/EeTimersUnits.hpp"
 
@@ -8,6 +10,8 @@ class Core;
 /// EE Timers updates the 4 timer units as defined in the EE Users Manual, starting on page 33.
 /// If interrupt conditions are met, sets the corresponding interrupt bit in the EE INTC.
 /// The EE Timers are dynamic and can be updated on the BUSCLK, BUSCLK16, BUSCLK256 or HBLNK clocks.
+/// Units following a bus clock are not ticked: their count is derived on demand from the
+/// master cycle count, and the compare/overflow conditions are scheduled as future events.
 class CEeTimers : public CController
 {
 public:
@@ -15,15 +19,32 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
-    /// Converts a time duration into the number of ticks that would have occurred.
-    int time_to_ticks(const double time_us);
+    /// Handles any unit mode, count or compare writes since the last time slice.
+    void update_units();
 
-    /// Updates the timers with the specified clock source type.
+    /// Updates the timers with the specified clock source type (H-BLNK).
     void tick_timer(const ControllerEvent::Type ce_type);
 
+    /// Resets the unit if the mode register was written to.
+    /// Returns true if it was reset.
+    bool handle_timer_write_latch(EeTimersUnit& unit);
+
+    /// (Re)starts or stops deriving the unit count from the master cycle count, according to its mode.
+    void program_timer(EeTimersUnit& unit);
+
+    /// Checks a derived unit for compare/overflow conditions since the last check, and schedules the next one.
+    void handle_timer_events(EeTimersUnit& unit);
+
+    /// Schedules an event for when the next compare/overflow condition occurs on a derived unit.
+    void schedule_timer_event(EeTimersUnit& unit);
+
     /// Checks the timer status and count values for interrupt conditions.
-    void handle_timer_interrupt(EeTimersUnit& unit);
+    void handle_timer_interrupt(EeTimersUnit& unit, const bool has_reached_compare, const bool has_overflowed);
 
     /// Check for the ZRET condition and reset counter if enabled/met.
     void handle_timer_zret(EeTimersUnit& unit);
+
+private:
+    /// Master cycle of the last event scheduled for each unit, see schedule_timer_event().
+    udword scheduled_cycles[Constants::EE::Timers::NUMBER_TIMERS];
 };
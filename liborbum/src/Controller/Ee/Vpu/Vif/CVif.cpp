@@ -1,8 +1,13 @@
+#include <algorithm>
+#include <cstring>
+
 #include <boost/format.hpp>
 
 #include "Controller/Ee/Vpu/Vif/CVif.hpp"
+#include "Controller/Ee/Vpu/Vif/VifUnpack.hpp"
 
 #include "Core.hpp"
+#include "Resources/Ee/Vpu/Vu/VuUnits.hpp"
 #include "Resources/RResources.hpp"
 
 CVif::CVif(Core* core) :
@@ -55,22 +60,51 @@ int CVif::time_step(const int ticks_available)
         if (unit->stat.is_stalled())
             continue;
 
-        // Check the FIFO queue for incoming DMA packet. Exit early if there is nothing to process.
-        if (!unit->dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
-            continue;
-        uqword packet;
-        unit->dma_fifo_queue->read(reinterpret_cast<ubyte*>(&packet), NUMBER_BYTES_IN_QWORD);
+        // Check if the VIF is waiting for the VU micro program to end (see wait_for_vu()),
+        // or for the GIF. Once it has, retry the VIFcode (held in the CODE register),
+        // which checks again for the GIF.
+        if (unit->stat.extract_field(VifUnitRegister_Stat::VEW) || unit->stat.extract_field(VifUnitRegister_Stat::VGW))
+        {
+            if (unit->stat.extract_field(VifUnitRegister_Stat::VEW) && unit->vu_unit->micro_sync.is_running())
+                continue;
+
+            unit->stat.insert_field(VifUnitRegister_Stat::VEW, 0);
+            unit->stat.insert_field(VifUnitRegister_Stat::VGW, 0);
+            VifcodeInstruction inst = VifcodeInstruction(unit->code.read_uword());
+            (this->*INSTRUCTION_TABLE[inst.get_info()->impl_index])(unit, inst);
+            if (unit->stat.extract_field(VifUnitRegister_Stat::VGW))
+                continue;
+        }
+
+        // Check the FIFO queue for incoming DMA packet, if we have finished with the last one. Exit early if there is nothing to process.
+        // In the VIF1 -> memory direction (STAT.FDR) the FIFO carries GS local -> host data to the DMAC instead.
+        if (unit->packet_position == NUMBER_WORDS_IN_QWORD)
+        {
+            if (unit->stat.extract_field(VifUnitRegister_Stat::FDR))
+                continue;
+
+            if (!unit->dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
+                continue;
+            unit->dma_fifo_queue->read(reinterpret_cast<ubyte*>(&unit->packet), NUMBER_BYTES_IN_QWORD);
+            unit->packet_position = 0;
+        }
 
         // We have an incoming DMA unit of data, now we must split it into 4 x 32-bit and process each one. // TODO: check wih pcsx2's code.
-        for (auto& data : packet.uw)
+        while (unit->packet_position < NUMBER_WORDS_IN_QWORD)
         {
-            // Check the NUM register, to determine if we are continuing a VIFcode instruction instead of reading a VIFcode.
-            if (unit->num.extract_field(VifUnitRegister_Num::NUM))
+            // Check if we are continuing a VIFcode instruction (receiving its data) instead of reading a VIFcode.
+            // The data words are processed together, as far as the end of this unit.
+            if (unit->data_words_remaining)
             {
+                const int count = std::min(NUMBER_WORDS_IN_QWORD - unit->packet_position, static_cast<int>(unit->data_words_remaining));
+                transfer_data(unit, &unit->packet.uw[unit->packet_position], count);
+                unit->packet_position += count;
             }
             else
             {
                 // Set the current data as the VIFcode.
+                const uword data = unit->packet.uw[unit->packet_position++];
+                unit->code.write_uword(data);
                 VifcodeInstruction inst = VifcodeInstruction(data);
 
                 // Process the VIFcode by calling the instruction handler.
@@ -84,6 +118,10 @@ int CVif::time_step(const int ticks_available)
                     r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VIF, 1);
                 }
                 */
+
+                // Stop processing the packet if the VIFcode has to wait for the VU or GIF - the rest is processed once it is retried.
+                if (unit->stat.extract_field(VifUnitRegister_Stat::VEW) || unit->stat.extract_field(VifUnitRegister_Stat::VGW))
+                    break;
             }
         }
     }
@@ -92,6 +130,176 @@ int CVif::time_step(const int ticks_available)
     return 1;
 }
 
+bool CVif::wait_for_vu(VifUnit_Base* unit)
+{
+    if (!unit->vu_unit->micro_sync.is_running())
+        return false;
+
+    unit->stat.insert_field(VifUnitRegister_Stat::VEW, 1);
+    return true;
+}
+
+bool CVif::wait_for_gif(VifUnit_Base* unit, const bool path1, const bool path2, const bool path3)
+{
+    // STAT is kept up to date by the GIF at the end of each of its steps, the
+    // path inputs are checked directly for anything queued since.
+    auto& r = core->get_resources();
+    auto& gif = r.ee.gif;
+
+    const int active_path = gif.stat.extract_field(GifRegister_Stat::OPH) ? gif.stat.extract_field(GifRegister_Stat::APATH) : 0;
+    const bool is_path3_masked = gif.mode.extract_field(GifRegister_Mode::M3R)
+                                 || gif.stat.extract_field(GifRegister_Stat::M3P);
+
+    const bool is_path1_busy = path1 && ((active_path == 1) || gif.path1_buffer.has_read_available());
+    const bool is_path2_busy = path2 && ((active_path == 2) || gif.path2_buffer.has_read_available());
+    const bool is_path3_busy = path3 && ((active_path == 3)
+                                         || gif.stat.extract_field(GifRegister_Stat::IP3)
+                                         || (!is_path3_masked && r.fifo_gif.has_read_available(NUMBER_BYTES_IN_QWORD)));
+    if (!is_path1_busy && !is_path2_busy && !is_path3_busy)
+        return false;
+
+    unit->stat.insert_field(VifUnitRegister_Stat::VGW, 1);
+    return true;
+}
+
+void CVif::transfer_data(VifUnit_Base* unit, const uword* data, const int count)
+{
+    const VifcodeInstruction inst = VifcodeInstruction(unit->code.read_uword());
+
+    // UNPACK covers CMD 0x60 -> 0x7F.
+    if (inst.cmdhi() == 0x3)
+    {
+        const size_t size = count * NUMBER_BYTES_IN_WORD;
+        unit->data_words_remaining -= count;
+
+        // Unpack straight from the packet when there is no partial vector
+        // left over, otherwise append to it first.
+        size_t remaining;
+        if (!unit->unpack_buffer_size)
+        {
+            const ubyte* bytes = reinterpret_cast<const ubyte*>(data);
+            const size_t consumed = unpack(unit, bytes, size);
+            remaining = size - consumed;
+            std::memcpy(unit->unpack_buffer, bytes + consumed, remaining);
+        }
+        else
+        {
+            std::memcpy(unit->unpack_buffer + unit->unpack_buffer_size, data, size);
+            const size_t buffered = unit->unpack_buffer_size + size;
+            const size_t consumed = unpack(unit, unit->unpack_buffer, buffered);
+            remaining = buffered - consumed;
+            std::memmove(unit->unpack_buffer, unit->unpack_buffer + consumed, remaining);
+        }
+
+        // Anything left after the last data word is padding.
+        unit->unpack_buffer_size = unit->data_words_remaining ? static_cast<int>(remaining) : 0;
+        return;
+    }
+
+    // Ignore the interrupt bit of the CMD field.
+    switch (inst.cmd() & 0x7F)
+    {
+    case CMD_STMASK:
+    {
+        unit->mask.write_uword(data[0]);
+        unit->data_words_remaining--;
+        break;
+    }
+    case CMD_STROW:
+    case CMD_STCOL:
+    {
+        // Written in order R0/C0 -> R3/C3.
+        SizedWordRegister* registers[2][NUMBER_WORDS_IN_QWORD] =
+            {
+                {&unit->r0, &unit->r1, &unit->r2, &unit->r3},
+                {&unit->c0, &unit->c1, &unit->c2, &unit->c3},
+            };
+        const int set = ((inst.cmd() & 0x7F) == CMD_STCOL) ? 1 : 0;
+        for (int i = 0; i < count; i++)
+        {
+            registers[set][NUMBER_WORDS_IN_QWORD - unit->data_words_remaining]->write_uword(data[i]);
+            unit->data_words_remaining--;
+        }
+        break;
+    }
+    case CMD_MPG:
+    {
+        // Micro memory writes are tracked by the memory itself (see VuMicroMemory).
+        VuMicroMemory* memory = unit->vu_unit->instruction_memory;
+        for (int i = 0; i < count; i++)
+        {
+            memory->write_uword(unit->data_address & (memory->byte_bus_map_size() - 1), data[i]);
+            unit->data_address += NUMBER_BYTES_IN_WORD;
+            unit->data_words_remaining--;
+
+            // NUM holds the number of instructions (64-bit) remaining.
+            if (!(unit->data_words_remaining % 2))
+                unit->num.insert_field(VifUnitRegister_Num::NUM, unit->data_words_remaining / 2);
+        }
+        break;
+    }
+    case CMD_DIRECT:
+    case CMD_DIRECTHL:
+    {
+        // Passed on as is to the GIF (PATH2).
+        auto& r = core->get_resources();
+        r.ee.gif.path2_buffer.write(reinterpret_cast<const ubyte*>(data), count * NUMBER_BYTES_IN_WORD);
+        unit->data_words_remaining -= count;
+        break;
+    }
+    default:
+    {
+        throw std::runtime_error(str(boost::format("VIF data transfer not implemented for VIFcode CMD 0x%X. Please fix.") % static_cast<uword>(inst.cmd())));
+    }
+    }
+}
+
+size_t CVif::unpack(VifUnit_Base* unit, const ubyte* data, const size_t size)
+{
+    const VifcodeInstruction inst = VifcodeInstruction(unit->code.read_uword());
+    ArrayByteMemory* memory = unit->vu_unit->data_memory;
+
+    VifUnpack::Job job;
+    job.memory = memory->get_memory();
+    job.memory_mask = static_cast<uword>(memory->byte_bus_map_size() - 1);
+    job.address = unit->data_address;
+    job.cl = unit->cycle.extract_field(VifUnitRegister_Cycle::CL);
+    job.wl = unit->cycle.extract_field(VifUnitRegister_Cycle::WL);
+    job.cycle = unit->unpack_cycle;
+    job.vectors_remaining = unit->unpack_vectors_remaining;
+    job.row[0] = unit->r0.read_uword();
+    job.row[1] = unit->r1.read_uword();
+    job.row[2] = unit->r2.read_uword();
+    job.row[3] = unit->r3.read_uword();
+    job.col[0] = unit->c0.read_uword();
+    job.col[1] = unit->c1.read_uword();
+    job.col[2] = unit->c2.read_uword();
+    job.col[3] = unit->c3.read_uword();
+    job.mask = unit->mask.read_uword();
+
+    // A WL of 0 is not valid, treat it as continuous writing.
+    if (!job.wl)
+        job.cl = job.wl = 1;
+
+    const int mode = unit->mode.extract_field(VifUnitRegister_Mode::MOD);
+    const VifUnpack::Kernel kernel = VifUnpack::get_kernel(inst.cmd() & 0xF, (inst.imm() & UNPACK_USN) != 0, mode, (inst.cmd() & UNPACK_M) != 0);
+    const size_t consumed = kernel(job, data, size);
+
+    unit->data_address = job.address;
+    unit->unpack_cycle = job.cycle;
+    unit->unpack_vectors_remaining = job.vectors_remaining;
+    unit->num.insert_field(VifUnitRegister_Num::NUM, job.vectors_remaining);
+    if (mode == VifUnpack::MODE_DIFFERENCE)
+    {
+        unit->r0.write_uword(job.row[0]);
+        unit->r1.write_uword(job.row[1]);
+        unit->r2.write_uword(job.row[2]);
+        unit->r3.write_uword(job.row[3]);
+    }
+
+    return consumed;
+}
+
 void CVif::INSTRUCTION_UNSUPPORTED(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
     throw std::runtime_error("VIFcode CMD field was invalid! Please fix.");
@@ -168,7 +376,10 @@ void CVif::MSKPATH3(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this when GIF is implemented
+    // Masks (or unmasks) PATH3 according to bit 15 of CODE.IMMEDIATE, which
+    // takes effect once the GIF reaches the end of the current PATH3 packet.
+    auto& r = core->get_resources();
+    r.ee.gif.stat.insert_field(GifRegister_Stat::M3P, (inst.imm() >> 15) & 0x1);
 }
 
 void CVif::MARK(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -177,8 +388,11 @@ void CVif::MARK(VifUnit_Base* unit, const VifcodeInstruction inst)
     unit->mark.insert_field(VifUnitRegister_Mark::MARK, immediate);
 }
 
+// Refer to EE Users Manual pg 110.
 void CVif::FLUSHE(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // Wait for the end of the micro program.
+    wait_for_vu(unit);
 }
 
 void CVif::FLUSH(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -189,7 +403,11 @@ void CVif::FLUSH(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this
+    // Wait for the end of the micro program, then the PATH1/PATH2 transfers.
+    if (wait_for_vu(unit))
+        return;
+
+    wait_for_gif(unit, true, true, false);
 }
 
 void CVif::FLUSHA(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -200,15 +418,34 @@ void CVif::FLUSHA(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this
+    // Wait for the end of the micro program, then the PATH1/PATH2/PATH3 transfers.
+    if (wait_for_vu(unit))
+        return;
+
+    wait_for_gif(unit, true, true, true);
 }
 
+// Refer to EE Users Manual pg 113.
 void CVif::MSCAL(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // Wait for the end of the previous micro program.
+    if (wait_for_vu(unit))
+        return;
+
+    // Start the micro program at CODE.IMMEDIATE (in units of 64-bit instructions).
+    unit->vu_unit->pc.write_uword(inst.imm() * Constants::EE::VPU::SIZE_VU_INSTRUCTION);
+    unit->vu_unit->micro_sync.start();
 }
 
+// Refer to EE Users Manual pg 115.
 void CVif::MSCNT(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // Wait for the end of the previous micro program.
+    if (wait_for_vu(unit))
+        return;
+
+    // Continue the micro program from where it ended (TPC).
+    unit->vu_unit->micro_sync.start();
 }
 
 void CVif::MSCALF(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -219,23 +456,47 @@ void CVif::MSCALF(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this
+    // Wait for the end of the previous micro program and the PATH1/PATH2
+    // transfers, then start the micro program as MSCAL does.
+    if (wait_for_vu(unit) || wait_for_gif(unit, true, true, false))
+        return;
+
+    MSCAL(unit, inst);
 }
 
+// Refer to EE Users Manual pg 116.
 void CVif::STMASK(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // The following word is written to MASK.
+    unit->data_words_remaining = 1;
 }
 
+// Refer to EE Users Manual pg 117.
 void CVif::STROW(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // The following 4 words are written to R0 -> R3.
+    unit->data_words_remaining = NUMBER_WORDS_IN_QWORD;
 }
 
+// Refer to EE Users Manual pg 118.
 void CVif::STCOL(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // The following 4 words are written to C0 -> C3.
+    unit->data_words_remaining = NUMBER_WORDS_IN_QWORD;
 }
 
+// Refer to EE Users Manual pg 119.
 void CVif::MPG(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    // Wait for the end of the micro program, as it may be overwritten.
+    if (wait_for_vu(unit))
+        return;
+
+    // Receive CODE.NUM instructions (64-bit, 0 means 256) into micro memory at CODE.IMMEDIATE (in units of instructions).
+    const uword number_instructions = inst.num() ? inst.num() : 256;
+    unit->num.insert_field(VifUnitRegister_Num::NUM, inst.num());
+    unit->data_address = inst.imm() * Constants::EE::VPU::SIZE_VU_INSTRUCTION;
+    unit->data_words_remaining = number_instructions * (Constants::EE::VPU::SIZE_VU_INSTRUCTION / NUMBER_BYTES_IN_WORD);
 }
 
 void CVif::DIRECT(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -246,7 +507,9 @@ void CVif::DIRECT(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this
+    // The following CODE.IMMEDIATE qwords (0 means 65536) are sent to the GIF through PATH2.
+    const uword number_qwords = inst.imm() ? inst.imm() : 65536;
+    unit->data_words_remaining = number_qwords * NUMBER_WORDS_IN_QWORD;
 }
 
 void CVif::DIRECTHL(VifUnit_Base* unit, const VifcodeInstruction inst)
@@ -257,61 +520,53 @@ void CVif::DIRECTHL(VifUnit_Base* unit, const VifcodeInstruction inst)
         return;
     }
 
-    // TODO: Implement this
-}
-
-void CVif::UNPACK(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_S_32(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_S_16(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_S_8(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V2_32(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V2_16(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V2_8(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V3_32(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V3_16(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V3_8(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V4_32(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
-
-void CVif::UNPACK_V4_16(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
-}
+    // Unlike DIRECT, DIRECTHL doesn't interrupt PATH3 IMAGE data in intermittent
+    // mode, it waits for the PATH3 packet to end (see CGif::select_path()).
+    // Outside of intermittent mode PATH3 packets are never interrupted anyway.
+    auto& gif = core->get_resources().ee.gif;
+    const bool is_path3_active = gif.stat.extract_field(GifRegister_Stat::IP3)
+                                 || (gif.stat.extract_field(GifRegister_Stat::OPH) && (gif.stat.extract_field(GifRegister_Stat::APATH) == 3));
+    if (gif.stat.extract_field(GifRegister_Stat::IMT) && is_path3_active)
+    {
+        unit->stat.insert_field(VifUnitRegister_Stat::VGW, 1);
+        return;
+    }
 
-void CVif::UNPACK_V4_8(VifUnit_Base* unit, const VifcodeInstruction inst)
-{
+    // The following CODE.IMMEDIATE qwords (0 means 65536) are sent to the GIF through PATH2.
+    const uword number_qwords = inst.imm() ? inst.imm() : 65536;
+    unit->data_words_remaining = number_qwords * NUMBER_WORDS_IN_QWORD;
 }
 
-void CVif::UNPACK_V4_5(VifUnit_Base* unit, const VifcodeInstruction inst)
+// Refer to EE Users Manual pg 124.
+void CVif::UNPACK(VifUnit_Base* unit, const VifcodeInstruction inst)
 {
+    const int vnvl = inst.cmd() & 0xF;
+    if (!VifUnpack::is_valid_format(vnvl))
+        throw std::runtime_error(str(boost::format("VIF UNPACK format invalid (VN = %d, VL = %d). Please fix.") % (vnvl >> 2) % (vnvl & 0x3)));
+
+    // Destination is CODE.ADDR (in units of qwords), relative to TOPS for VIF1 if CODE.FLG is set.
+    uword address = (inst.imm() & UNPACK_ADDR) * NUMBER_BYTES_IN_QWORD;
+    if ((unit->core_id == 1) && (inst.imm() & UNPACK_FLG))
+        address += unit->tops.extract_field(VifUnitRegister_Tops::TOPS) * NUMBER_BYTES_IN_QWORD;
+
+    // Writes CODE.NUM vectors (0 means 256). When filling (CL < WL), only
+    // the first CL vectors of each WL write cycles are read from the packet.
+    const uword number_vectors = inst.num() ? inst.num() : 256;
+    uword cl = unit->cycle.extract_field(VifUnitRegister_Cycle::CL);
+    uword wl = unit->cycle.extract_field(VifUnitRegister_Cycle::WL);
+    if (!wl)
+        cl = wl = 1;
+    const uword number_input_vectors = (cl >= wl) ? number_vectors : ((number_vectors / wl) * cl + std::min(number_vectors % wl, cl));
+    const size_t input_size = number_input_vectors * VifUnpack::vector_size(vnvl);
+
+    unit->num.insert_field(VifUnitRegister_Num::NUM, inst.num());
+    unit->data_address = address;
+    unit->data_words_remaining = static_cast<uword>((input_size + NUMBER_BYTES_IN_WORD - 1) / NUMBER_BYTES_IN_WORD);
+    unit->unpack_buffer_size = 0;
+    unit->unpack_cycle = 0;
+    unit->unpack_vectors_remaining = number_vectors;
+
+    // Nothing to read if only filling (CL = 0).
+    if (!unit->data_words_remaining)
+        unpack(unit, nullptr, 0);
 }
@@ -24,6 +24,44 @@ public:
     /// - Check the FIFO queue and process data if available.
     int time_step(const int ticks_available);
 
+    /// Checks if the VU micro program is still running, in which case the
+    /// VIF must wait for it to end: sets STAT.VEW and returns true. The
+    /// VIFcode is retried by time_step() once the program has ended.
+    /// See EE Users Manual page 110.
+    bool wait_for_vu(VifUnit_Base* unit);
+
+    /// Checks if any of the GIF paths given are transferring a packet or have
+    /// data queued, in which case the VIF must wait for them: sets STAT.VGW
+    /// and returns true. Queued PATH3 data is ignored while PATH3 is masked,
+    /// as it can't be transferred until the VIF unmasks it.
+    /// The VIFcode is retried by time_step(), which checks again.
+    /// See EE Users Manual page 110.
+    bool wait_for_gif(VifUnit_Base* unit, const bool path1, const bool path2, const bool path3);
+
+    /// Processes data words of the current VIFcode (held in CODE), ie: the
+    /// instructions following MPG or the vectors following UNPACK.
+    /// The number of words given must not be more than the remaining data.
+    void transfer_data(VifUnit_Base* unit, const uword* data, const int count);
+
+    /// Unpacks vectors from the input bytes given into VU data memory, using
+    /// the UNPACK settings (see VifUnpack). Returns the number of bytes consumed,
+    /// the rest belong to a vector which isn't complete yet.
+    size_t unpack(VifUnit_Base* unit, const ubyte* data, const size_t size);
+
+    /// VIFcode CMD values needed for the data transfers.
+    static constexpr ubyte CMD_STMASK = 0x20;
+    static constexpr ubyte CMD_STROW = 0x30;
+    static constexpr ubyte CMD_STCOL = 0x31;
+    static constexpr ubyte CMD_MPG = 0x4A;
+    static constexpr ubyte CMD_DIRECT = 0x50;
+    static constexpr ubyte CMD_DIRECTHL = 0x51;
+
+    /// UNPACK CMD and IMMEDIATE fields.
+    static constexpr ubyte UNPACK_M = 0x10;
+    static constexpr uhword UNPACK_ADDR = 0x3FF;
+    static constexpr uhword UNPACK_USN = 0x4000;
+    static constexpr uhword UNPACK_FLG = 0x8000;
+
     /// VIFcode handler functions.
     /// See EE Users Manual page 87 onwards.
     void INSTRUCTION_UNSUPPORTED(VifUnit_Base* unit, const VifcodeInstruction inst);
@@ -48,19 +86,6 @@ public:
     void DIRECT(VifUnit_Base* unit, const VifcodeInstruction inst);
     void DIRECTHL(VifUnit_Base* unit, const VifcodeInstruction inst);
     void UNPACK(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_S_32(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_S_16(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_S_8(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V2_32(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V2_16(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V2_8(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V3_32(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V3_16(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V3_8(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V4_32(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V4_16(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V4_8(VifUnit_Base* unit, const VifcodeInstruction inst);
-    void UNPACK_V4_5(VifUnit_Base* unit, const VifcodeInstruction inst);
 
     /// Static arrays needed to call the appropriate VIFcode handler function.
     /// In total there are 34 unique instructions, based on the VIFcodeInstructionTable unique index.
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "Common/Simd.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Kernels for the VIF UNPACK VIFcode, which decompresses vectors from the
+/// VIF packet into 128-bit qwords of VU data memory.
+/// A kernel is specialised for each combination of the data format (CMD.VN
+/// and CMD.VL), sign extension (IMMEDIATE.USN), addition decompression mode
+/// (MODE.MOD) and masking (CMD.M), so there is no per vector branching on
+/// any of these. See get_kernel().
+/// Each kernel handles the write cycle (CYCLE.CL/WL) skipping and filling,
+/// stopping when the input runs out part way through a vector so it can be
+/// resumed once more data arrives.
+/// Maps onto SSE2 when the host has it, with an equivalent per-field scalar
+/// version otherwise (see Simd.hpp).
+/// See EE Users Manual page 120 onwards.
+namespace VifUnpack
+{
+/// Addition decompression modes (MODE.MOD).
+static constexpr int MODE_NONE = 0;
+static constexpr int MODE_OFFSET = 1;
+static constexpr int MODE_DIFFERENCE = 2;
+
+/// Mask register (MASK) settings for each field of a write cycle.
+static constexpr uword MASK_DATA = 0;
+static constexpr uword MASK_ROW = 1;
+static constexpr uword MASK_COL = 2;
+static constexpr uword MASK_PROTECT = 3;
+
+/// Returns if the format (CMD.VN << 2 | CMD.VL) is valid. A VL of 3 (5-bit
+/// elements) is only valid with a VN of 3 (V4-5).
+constexpr bool is_valid_format(const int vnvl)
+{
+    return ((vnvl & 0x3) != 0x3) || (vnvl == 0xF);
+}
+
+/// Returns the size of an input vector in bytes, for the (valid) format given.
+constexpr size_t vector_size(const int vnvl)
+{
+    return (vnvl == 0xF) ? 2 : (((vnvl >> 2) + 1) * (4 >> (vnvl & 0x3)));
+}
+
+/// UNPACK state, loaded from and stored back to the VIF unit around each
+/// kernel call.
+struct Job
+{
+    /// VU data memory, written to at the qword address given (wrapped by the mask).
+    ubyte* memory;
+    uword memory_mask;
+    uword address;
+
+    /// Write cycle settings (CYCLE.CL/WL, WL must not be 0), and the current write cycle.
+    uword cl;
+    uword wl;
+    uword cycle;
+
+    /// Number of vectors still to be written (including fill writes).
+    uword vectors_remaining;
+
+    /// Row (R0 -> R3) and column (C0 -> C3) registers. The row is updated by
+    /// the difference mode.
+    uword row[NUMBER_WORDS_IN_QWORD];
+    uword col[NUMBER_WORDS_IN_QWORD];
+
+    /// Mask register (MASK), 8 bits for each of the first 4 write cycles
+    /// (later cycles use the 4th).
+    uword mask;
+};
+
+/// Kernel function signature. Writes vectors from the input given, returning
+/// the number of bytes consumed.
+using Kernel = size_t (*)(Job& job, const ubyte* data, const size_t size);
+
+#if defined(SIMD_SSE2)
+using Lanes = __m128i;
+
+inline Lanes load(const uword* value)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(value));
+}
+
+inline void store(uword* value, const Lanes lanes)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(value), lanes);
+}
+
+inline Lanes add(const Lanes a, const Lanes b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+inline Lanes and_(const Lanes a, const Lanes b)
+{
+    return _mm_and_si128(a, b);
+}
+
+inline Lanes or_(const Lanes a, const Lanes b)
+{
+    return _mm_or_si128(a, b);
+}
+
+/// Selects a where the selector lanes are set, b otherwise.
+inline Lanes select(const Lanes selector, const Lanes a, const Lanes b)
+{
+    return _mm_or_si128(_mm_and_si128(selector, a), _mm_andnot_si128(selector, b));
+}
+
+/// Returns the lanes where the 2-bit mask field equals the setting given.
+inline Lanes mask_selector(const uword mask, const uword setting)
+{
+    const __m128i fields = _mm_setr_epi32(mask & 0x3, (mask >> 2) & 0x3, (mask >> 4) & 0x3, (mask >> 6) & 0x3);
+    return _mm_cmpeq_epi32(fields, _mm_set1_epi32(setting));
+}
+
+inline bool is_any(const Lanes lanes)
+{
+    return _mm_movemask_epi8(lanes) != 0;
+}
+
+/// Decodes an input vector into the xyzw fields.
+/// S formats are broadcast to all fields, V2 formats are written as xyxy and
+/// V3 formats with w = 0 (the unwritten fields are indeterminate on hardware).
+template <int VNVL, bool USN>
+inline Lanes decode(const ubyte* data)
+{
+    constexpr int VN = VNVL >> 2;
+    constexpr int VL = VNVL & 0x3;
+    constexpr size_t SIZE = vector_size(VNVL);
+
+    if constexpr (VNVL == 0xF)
+    {
+        // V4-5: RGBA 5:5:5:1 -> 8:8:8:8.
+        uhword value;
+        std::memcpy(&value, data, sizeof(value));
+        return _mm_setr_epi32((value & 0x1F) << 3, ((value >> 5) & 0x1F) << 3, ((value >> 10) & 0x1F) << 3, ((value >> 15) & 0x1) << 7);
+    }
+    else
+    {
+        __m128i value;
+        if constexpr (SIZE == 16)
+        {
+            value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        }
+        else if constexpr (SIZE == 12)
+        {
+            udword xy;
+            uword z;
+            std::memcpy(&xy, data, sizeof(xy));
+            std::memcpy(&z, data + sizeof(xy), sizeof(z));
+            value = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&xy)), _mm_cvtsi32_si128(z));
+        }
+        else
+        {
+            udword bytes = 0;
+            std::memcpy(&bytes, data, SIZE);
+            value = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+        }
+
+        // Widen each element to 32-bits in the upper bits, then shift down.
+        if constexpr (VL == 1)
+        {
+            value = _mm_unpacklo_epi16(value, value);
+            value = USN ? _mm_srli_epi32(value, 16) : _mm_srai_epi32(value, 16);
+        }
+        else if constexpr (VL == 2)
+        {
+            value = _mm_unpacklo_epi8(value, value);
+            value = _mm_unpacklo_epi16(value, value);
+            value = USN ? _mm_srli_epi32(value, 24) : _mm_srai_epi32(value, 24);
+        }
+
+        if constexpr (VN == 0)
+            value = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 0, 0, 0));
+        else if constexpr (VN == 1)
+            value = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 1, 0));
+
+        return value;
+    }
+}
+
+#else
+struct Lanes
+{
+    uword w[NUMBER_WORDS_IN_QWORD];
+};
+
+inline Lanes load(const uword* value)
+{
+    Lanes lanes;
+    std::memcpy(lanes.w, value, sizeof(lanes.w));
+    return lanes;
+}
+
+inline void store(uword* value, const Lanes lanes)
+{
+    std::memcpy(value, lanes.w, sizeof(lanes.w));
+}
+
+inline Lanes add(const Lanes a, const Lanes b)
+{
+    Lanes result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.w[i] = a.w[i] + b.w[i];
+    return result;
+}
+
+inline Lanes and_(const Lanes a, const Lanes b)
+{
+    Lanes result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.w[i] = a.w[i] & b.w[i];
+    return result;
+}
+
+inline Lanes or_(const Lanes a, const Lanes b)
+{
+    Lanes result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.w[i] = a.w[i] | b.w[i];
+    return result;
+}
+
+inline Lanes select(const Lanes selector, const Lanes a, const Lanes b)
+{
+    Lanes result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.w[i] = (selector.w[i] & a.w[i]) | (~selector.w[i] & b.w[i]);
+    return result;
+}
+
+inline Lanes mask_selector(const uword mask, const uword setting)
+{
+    Lanes result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.w[i] = (((mask >> (i * 2)) & 0x3) == setting) ? 0xFFFFFFFF : 0;
+    return result;
+}
+
+inline bool is_any(const Lanes lanes)
+{
+    return (lanes.w[0] | lanes.w[1] | lanes.w[2] | lanes.w[3]) != 0;
+}
+
+template <int VNVL, bool USN>
+inline Lanes decode(const ubyte* data)
+{
+    constexpr int VN = VNVL >> 2;
+    constexpr int VL = VNVL & 0x3;
+
+    Lanes value = {{0, 0, 0, 0}};
+    if constexpr (VNVL == 0xF)
+    {
+        uhword v;
+        std::memcpy(&v, data, sizeof(v));
+        value = {{static_cast<uword>((v & 0x1F) << 3), static_cast<uword>(((v >> 5) & 0x1F) << 3), static_cast<uword>(((v >> 10) & 0x1F) << 3), static_cast<uword>(((v >> 15) & 0x1) << 7)}};
+        return value;
+    }
+    else
+    {
+        for (int i = 0; i <= VN; i++)
+        {
+            if constexpr (VL == 0)
+            {
+                std::memcpy(&value.w[i], data + i * 4, sizeof(uword));
+            }
+            else if constexpr (VL == 1)
+            {
+                uhword element;
+                std::memcpy(&element, data + i * 2, sizeof(element));
+                value.w[i] = USN ? static_cast<uword>(element) : static_cast<uword>(static_cast<sword>(static_cast<shword>(element)));
+            }
+            else
+            {
+                const ubyte element = data[i];
+                value.w[i] = USN ? static_cast<uword>(element) : static_cast<uword>(static_cast<sword>(static_cast<sbyte>(element)));
+            }
+        }
+
+        if constexpr (VN == 0)
+            value.w[1] = value.w[2] = value.w[3] = value.w[0];
+        else if constexpr (VN == 1)
+            value.w[2] = value.w[0], value.w[3] = value.w[1];
+
+        return value;
+    }
+}
+#endif
+
+/// UNPACK kernel for the format, sign extension, mode and masking given.
+/// Data (mask 0) fields have the mode applied, then the row/column/protected
+/// fields are merged in. Filling writes (write cycles past CL) read no input,
+/// their data fields are written with the row register.
+template <int VNVL, bool USN, int MODE, bool MASKED>
+size_t unpack(Job& job, const ubyte* data, const size_t size)
+{
+    constexpr size_t SIZE = vector_size(VNVL);
+
+    Lanes row = load(job.row);
+
+    // Mask lane selectors for each of the write cycles, and the column
+    // values (C0 -> C3 for write cycles 1 -> 4 and on, broadcast to the fields).
+    constexpr int NUMBER_MASK_CYCLES = MASKED ? 4 : 1;
+    Lanes data_selectors[NUMBER_MASK_CYCLES];
+    Lanes row_selectors[NUMBER_MASK_CYCLES];
+    Lanes protect_selectors[NUMBER_MASK_CYCLES];
+    Lanes cols[NUMBER_MASK_CYCLES];
+    bool is_protected[NUMBER_MASK_CYCLES];
+    if constexpr (MASKED)
+    {
+        for (int c = 0; c < NUMBER_MASK_CYCLES; c++)
+        {
+            const uword mask = (job.mask >> (c * 8)) & 0xFF;
+            const uword col[NUMBER_WORDS_IN_QWORD] = {job.col[c], job.col[c], job.col[c], job.col[c]};
+            data_selectors[c] = mask_selector(mask, MASK_DATA);
+            row_selectors[c] = mask_selector(mask, MASK_ROW);
+            protect_selectors[c] = mask_selector(mask, MASK_PROTECT);
+            cols[c] = and_(mask_selector(mask, MASK_COL), load(col));
+            is_protected[c] = is_any(protect_selectors[c]);
+        }
+    }
+
+    // The job is kept in locals, as the memory stores could otherwise alias it.
+    ubyte* const memory = job.memory;
+    const uword memory_mask = job.memory_mask;
+    const uword cl = job.cl;
+    const uword wl = job.wl;
+    const uword skip = (cl > wl) ? ((cl - wl) * NUMBER_BYTES_IN_QWORD) : 0;
+    uword address = job.address;
+    uword cycle = job.cycle;
+    uword vectors_remaining = job.vectors_remaining;
+
+    size_t consumed = 0;
+    while (vectors_remaining)
+    {
+        Lanes value;
+        if (cycle < cl)
+        {
+            if (size - consumed < SIZE)
+                break;
+            value = decode<VNVL, USN>(data + consumed);
+            consumed += SIZE;
+
+            if constexpr (MODE == MODE_OFFSET)
+            {
+                value = add(value, row);
+            }
+            else if constexpr (MODE == MODE_DIFFERENCE)
+            {
+                value = add(value, row);
+                if constexpr (MASKED)
+                    row = select(data_selectors[std::min<uword>(cycle, 3)], value, row);
+                else
+                    row = value;
+            }
+        }
+        else
+        {
+            value = row;
+        }
+
+        uword* qword = reinterpret_cast<uword*>(memory + (address & memory_mask));
+        if constexpr (MASKED)
+        {
+            // The row fields use the (possibly just updated) row register.
+            const uword c = std::min<uword>(cycle, 3);
+            value = or_(select(data_selectors[c], value, and_(row_selectors[c], row)), cols[c]);
+            if (is_protected[c])
+                value = select(protect_selectors[c], load(qword), value);
+        }
+        store(qword, value);
+
+        // Advance, skipping the unwritten qwords at the end of a write cycle block if CL > WL.
+        address += NUMBER_BYTES_IN_QWORD;
+        vectors_remaining--;
+        if (++cycle == wl)
+        {
+            address += skip;
+            cycle = 0;
+        }
+    }
+
+    job.address = address;
+    job.cycle = cycle;
+    job.vectors_remaining = vectors_remaining;
+
+    if constexpr (MODE == MODE_DIFFERENCE)
+        store(job.row, row);
+
+    return consumed;
+}
+
+/// Kernel table, indexed by ((format * 2 + usn) * 3 + mode) * 2 + masked.
+/// Invalid formats have no kernel.
+static constexpr size_t NUMBER_FORMATS = 16;
+static constexpr size_t NUMBER_MODES = 3;
+static constexpr size_t NUMBER_KERNELS = NUMBER_FORMATS * 2 * NUMBER_MODES * 2;
+
+template <size_t I>
+constexpr Kernel make_kernel()
+{
+    constexpr int VNVL = static_cast<int>(I / (2 * NUMBER_MODES * 2));
+    constexpr bool USN = ((I / (NUMBER_MODES * 2)) % 2) != 0;
+    constexpr int MODE = static_cast<int>((I / 2) % NUMBER_MODES);
+    constexpr bool MASKED = (I % 2) != 0;
+    if constexpr (is_valid_format(VNVL))
+        return &unpack<VNVL, USN, MODE, MASKED>;
+    else
+        return nullptr;
+}
+
+template <size_t... I>
+constexpr std::array<Kernel, NUMBER_KERNELS> make_kernels(std::index_sequence<I...>)
+{
+    return {{make_kernel<I>()...}};
+}
+
+static constexpr std::array<Kernel, NUMBER_KERNELS> KERNELS = make_kernels(std::make_index_sequence<NUMBER_KERNELS>());
+
+/// Returns the kernel for the UNPACK settings given, or nullptr if the
+/// format is invalid. The undefined mode (3) is treated as no mode.
+inline Kernel get_kernel(const int vnvl, const bool usn, const int mode, const bool masked)
+{
+    const int kernel_mode = (mode < static_cast<int>(NUMBER_MODES)) ? mode : MODE_NONE;
+    return KERNELS[((vnvl * 2 + usn) * NUMBER_MODES + kernel_mode) * 2 + masked];
+}
+} // namespace VifUnpack
@@ -1,11 +1,24 @@
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
+#include "Controller/Ee/Vpu/Vu/VuFlagLiveness.hpp"
 
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 
 CVuInterpreter::CVuInterpreter(Core* core) :
-    CController(core)
+    CController(core),
+    fmac_flags_live{true, true},
+    micro_blocks{},
+    current_micro_blocks{nullptr, nullptr}
+{
+}
+
+CVuInterpreter::~CVuInterpreter()
 {
+    stop_vu1_thread();
 }
 
 void CVuInterpreter::handle_event(const ControllerEvent& event)
@@ -14,6 +27,16 @@ void CVuInterpreter::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
+        start_vu1_thread();
+
+        // Rethrow any errors from the VU1 thread on the controller thread.
+        if (!vu1_thread_error_queue.is_empty())
+        {
+            std::string error_str;
+            vu1_thread_error_queue.pop(error_str);
+            throw std::runtime_error(error_str);
+        }
+
         int ticks_remaining = time_to_ticks(event.data.time_us);
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
@@ -45,9 +68,152 @@ int CVuInterpreter::time_to_ticks(const double time_us)
 
 int CVuInterpreter::time_step(const int ticks_available)
 {
-    // TODO: Not yet implemented.
+    auto& r = core->get_resources();
+
+    int ticks = 1;
+    for (auto& unit : r.ee.vpu.vu.units)
+    {
+        // Micro programs run asynchronously are executed by the VU1 thread instead.
+        if (unit->micro_sync.is_asynchronous.load(std::memory_order_relaxed) || !unit->micro_sync.is_running())
+            continue;
+
+        ticks = std::max(ticks, execute_micro(unit));
+    }
+
 #if defined(BUILD_DEBUG)
     DEBUG_LOOP_COUNTER++;
 #endif
+
+    return ticks;
+}
+
+int CVuInterpreter::execute_micro(VuUnit_Base* unit)
+{
+    execute_micro_pair(unit);
     return 1;
 }
+
+void CVuInterpreter::execute_micro_pair(VuUnit_Base* unit)
+{
+    // Fetch the instruction pair (upper instruction in the high word).
+    const uword pc = unit->pc.read_uword() & (unit->instruction_memory->byte_bus_map_size() - 1);
+    const udword pair = unit->instruction_memory->read_udword(pc);
+    const VuInstruction upper = VuFlagLiveness::get_upper(pair);
+    const VuInstruction lower = VuFlagLiveness::get_lower(pair);
+
+    // The upper instruction is executed first, with the lower instruction
+    // seeing its results (see VuFlagLiveness). Dead CLIP judgements are
+    // skipped, and dead MAC updates only accumulate the sticky Status flags.
+    // When the I bit is set, the lower instruction is an immediate for the I register.
+    const VuFlagLiveness::Liveness& liveness = get_micro_liveness(unit, pc);
+    const int upper_impl_index = upper.upper_lookup().impl_index;
+    if (liveness.clipping_live || !VuFlagLiveness::is_clip(upper_impl_index))
+    {
+        fmac_flags_live[unit->core_id] = liveness.mac_live;
+        try
+        {
+            (this->*VU_INSTRUCTION_TABLE[upper_impl_index])(unit, upper);
+        }
+        catch (...)
+        {
+            fmac_flags_live[unit->core_id] = true;
+            throw;
+        }
+        fmac_flags_live[unit->core_id] = true;
+    }
+
+    if (VuFlagLiveness::has_lower(pair))
+        (this->*VU_INSTRUCTION_TABLE[lower.lower_lookup().impl_index])(unit, lower);
+    else
+        LOI(unit, lower);
+
+    advance_micro_pair(unit, (upper.value & VuFlagLiveness::UPPER_E_BIT) != 0);
+}
+
+const VuFlagLiveness::Liveness& CVuInterpreter::get_micro_liveness(VuUnit_Base* unit, const uword pc)
+{
+    VuMicroMemory& memory = *unit->instruction_memory;
+    const uword generation = memory.get_generation();
+
+    // Sequential pairs are usually within the block of the previous pair.
+    const MicroBlock* block = current_micro_blocks[unit->core_id];
+    if (block && block->memory_generation == generation && pc >= block->start_pc)
+    {
+        const size_t index = (pc - block->start_pc) / Constants::EE::VPU::SIZE_VU_INSTRUCTION;
+        if (index < block->count)
+            return block->liveness[index];
+    }
+
+    MicroBlock& entry = micro_blocks[unit->core_id][(pc / Constants::EE::VPU::SIZE_VU_INSTRUCTION) % NUMBER_MICRO_BLOCKS];
+    if (!entry.is_valid || entry.start_pc != pc || entry.memory_generation != generation)
+    {
+        // Fetch and analyse the block (wrapping around the end of micro memory isn't followed).
+        const size_t memory_size = memory.byte_bus_map_size();
+        udword pairs[VuFlagLiveness::MAX_BLOCK_LENGTH];
+        const size_t max_count = std::min((memory_size - pc) / Constants::EE::VPU::SIZE_VU_INSTRUCTION, VuFlagLiveness::MAX_BLOCK_LENGTH);
+        for (size_t i = 0; i < max_count; i++)
+            pairs[i] = memory.read_udword(pc + i * Constants::EE::VPU::SIZE_VU_INSTRUCTION);
+
+        entry.start_pc = pc;
+        entry.count = VuFlagLiveness::get_block_length(pairs, max_count);
+        entry.memory_generation = generation;
+        entry.is_valid = true;
+        VuFlagLiveness::analyse(pairs, entry.count, entry.liveness);
+    }
+
+    current_micro_blocks[unit->core_id] = &entry;
+    return entry.liveness[0];
+}
+
+void CVuInterpreter::advance_micro_pair(VuUnit_Base* unit, const bool is_end)
+{
+    unit->bdelay.advance_pc(unit->pc);
+
+    // The E bit ends the program after the next instruction pair (delay slot).
+    if (unit->micro_sync.is_end_pending)
+        unit->micro_sync.finish();
+    else if (is_end)
+        unit->micro_sync.is_end_pending = true;
+}
+
+void CVuInterpreter::start_vu1_thread()
+{
+    if (!core->get_options().vu1_thread || vu1_thread.joinable())
+        return;
+
+    core->get_resources().ee.vpu.vu.unit_1.micro_sync.is_asynchronous.store(true, std::memory_order_release);
+    vu1_thread = std::thread(std::bind(&CVuInterpreter::vu1_thread_main, this));
+}
+
+void CVuInterpreter::stop_vu1_thread()
+{
+    if (!vu1_thread.joinable())
+        return;
+
+    auto& micro_sync = core->get_resources().ee.vpu.vu.unit_1.micro_sync;
+    micro_sync.request_exit();
+    vu1_thread.join();
+    micro_sync.is_asynchronous.store(false, std::memory_order_release);
+}
+
+void CVuInterpreter::vu1_thread_main()
+{
+    VuUnit_Base* unit = &core->get_resources().ee.vpu.vu.unit_1;
+
+    while (unit->micro_sync.wait_for_start())
+    {
+        try
+        {
+            while (unit->micro_sync.is_running() && !unit->micro_sync.is_exit_requested())
+                execute_micro(unit);
+        }
+        catch (const std::exception& error)
+        {
+            // Add exception to the queue for the controller to deal with, and
+            // end the program so nothing waits on it forever.
+            std::string error_str(error.what());
+            vu1_thread_error_queue.push(error_str);
+            unit->micro_sync.finish();
+        }
+    }
+}
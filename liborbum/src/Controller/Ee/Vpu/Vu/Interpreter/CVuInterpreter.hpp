@@ -1,25 +1,67 @@
 #pragma once
 
+#include <string>
+#include <thread>
+
+#include <Queues.hpp>
+
 #include "Controller/CController.hpp"
+#include "Controller/Ee/Vpu/Vu/VuFlagLiveness.hpp"
+#include "Controller/Ee/Vpu/Vu/VuVector.hpp"
 #include "Resources/Ee/Vpu/Vu/VuInstruction.hpp"
 #include "Resources/Ee/Vpu/Vu/VuUnits.hpp"
 
 class Core;
 
 /// The VU0/1 interpreter.
+/// When enabled (see CoreOptions::vu1_thread), VU1 micro programs are run on a
+/// dedicated thread instead of in step with the VU controller, see VuMicroSync.
 class CVuInterpreter : public CController
 {
 public:
     CVuInterpreter(Core* core);
+    ~CVuInterpreter();
 
     void handle_event(const ControllerEvent& event) override;
 
     /// Converts a time duration into the number of ticks that would have occurred.
     int time_to_ticks(const double time_us);
 
-    /// Steps through the VU core state, executing one macro and one micro instruction.
+    /// Steps through the VU core state, executing micro instructions for each
+    /// unit running a micro program (not run asynchronously).
     int time_step(const int ticks_available);
 
+    /// Executes the next micro instruction(s) of the unit, returning the number
+    /// of instruction pairs executed. The interpreter executes one pair at a time.
+    virtual int execute_micro(VuUnit_Base* unit);
+
+    /// Executes the micro instruction pair at the PC of the unit, ending the
+    /// micro program after the pair following the one with the E bit set.
+    /// Flag updates which are never observed are skipped (see get_micro_liveness()).
+    /// See VU Users Manual page 60.
+    void execute_micro_pair(VuUnit_Base* unit);
+
+    /// Returns the flag liveness of the instruction pair at the PC given (masked
+    /// to the micro memory), analysing the block starting at it if it isn't
+    /// within a block analysed for the current micro memory contents.
+    const VuFlagLiveness::Liveness& get_micro_liveness(VuUnit_Base* unit, const uword pc);
+
+    /// Advances the PC after an instruction pair, and ends the micro program
+    /// if the previous pair had the E bit set (given for the current pair).
+    void advance_micro_pair(VuUnit_Base* unit, const bool is_end);
+
+    /// Starts the VU1 thread, if it is enabled and not already running.
+    /// This is done on the first event, so that instances only used for macro
+    /// mode (ie: from the EE Core interpreter) don't own a thread.
+    void start_vu1_thread();
+
+    /// Stops the VU1 thread, if it is running. Must be called by derived
+    /// classes on destruction, as the thread calls execute_micro().
+    void stop_vu1_thread();
+
+    /// VU1 thread entry point, runs each micro program to its end after it is started.
+    void vu1_thread_main();
+
     //////////////////////////
     // Common Functionality //
     //////////////////////////
@@ -29,6 +71,42 @@ public:
     size_t DEBUG_LOOP_COUNTER = 0;
 #endif
 
+    /// VU1 thread, and the errors raised on it (rethrown by the controller).
+    std::thread vu1_thread;
+    MpscQueue<std::string, 32> vu1_thread_error_queue;
+
+    /// If the MAC flags of the FMAC operations are observable, per unit.
+    /// When not set, only the sticky Status flags are updated (see VuFlagLiveness).
+    /// Set around the upper instruction of each micro pair, always set in macro mode.
+    bool fmac_flags_live[Constants::EE::VPU::VU::NUMBER_VU_CORES];
+
+    /// Flag liveness of the micro blocks last executed, per unit. Direct mapped
+    /// by the block start PC, and discarded when the micro memory is written to.
+    /// Only accessed by the thread running the unit's micro programs.
+    struct MicroBlock
+    {
+        uword start_pc;
+        size_t count;
+        uword memory_generation;
+        bool is_valid;
+        VuFlagLiveness::Liveness liveness[VuFlagLiveness::MAX_BLOCK_LENGTH];
+    };
+    static constexpr size_t NUMBER_MICRO_BLOCKS = 16;
+    MicroBlock micro_blocks[Constants::EE::VPU::VU::NUMBER_VU_CORES][NUMBER_MICRO_BLOCKS];
+
+    /// The block the previous pair was in, per unit (nullptr if none).
+    const MicroBlock* current_micro_blocks[Constants::EE::VPU::VU::NUMBER_VU_CORES];
+
+    /// Formats the result of an FMAC (float) operation into PS2 floats, and
+    /// updates the MAC (and Status) flags for the dest fields given - the
+    /// flags of the other fields are cleared.
+    VuVector::Vector format_fmac_result(VuUnit_Base* unit, const ubyte dest, const VuVector::Vector value);
+
+    /// Waits for the VU1 micro program to end before VU0 accesses the VU1
+    /// registers through its bus (0x4000 onwards), if it is run asynchronously.
+    /// See EE Users Manual page 84.
+    void sync_vu1_register_access(VuUnit_Base* unit, const uword address);
+
     ///////////////////////////////
     // Instruction Functionality //
     ///////////////////////////////
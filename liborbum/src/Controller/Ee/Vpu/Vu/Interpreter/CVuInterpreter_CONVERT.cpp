@@ -13,8 +13,8 @@
 
 void CVuInterpreter::FTOI0(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -31,8 +31,8 @@ void CVuInterpreter::FTOI0(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::FTOI4(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -55,8 +55,8 @@ void CVuInterpreter::FTOI12(VuUnit_Base* unit, const VuInstruction inst)
 {
     // See FTOI4 for more details on how the code works.
 
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -74,8 +74,8 @@ void CVuInterpreter::FTOI15(VuUnit_Base* unit, const VuInstruction inst)
 {
     // See FTOI4 for more details on how the code works.
 
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -91,8 +91,8 @@ void CVuInterpreter::FTOI15(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::ITOF0(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -111,8 +111,8 @@ void CVuInterpreter::ITOF0(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::ITOF4(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -139,8 +139,8 @@ void CVuInterpreter::ITOF12(VuUnit_Base* unit, const VuInstruction inst)
 {
     // See ITOF4 for more details
 
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -159,8 +159,8 @@ void CVuInterpreter::ITOF15(VuUnit_Base* unit, const VuInstruction inst)
 {
     // See ITOF4 for more details
 
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
     ubyte dest = inst.dest();
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -11,7 +11,7 @@ void CVuInterpreter::ESADD(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = VF[fs](x)^2 + VF[fs](y)^2 + VF[fs](z)^2
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -26,7 +26,7 @@ void CVuInterpreter::ERSADD(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = 1 / (VF[fs](x)^2 + VF[fs](y)^2 + VF[fs](z)^2)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -41,7 +41,7 @@ void CVuInterpreter::ELENG(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = sqrt(VF[fs](x)^2 + VF[fs](y)^2 + VF[fs](z)^2)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -56,7 +56,7 @@ void CVuInterpreter::ERLENG(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = 1 / sqrt(VF[fs](x)^2 + VF[fs](y)^2 + VF[fs](z)^2)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -71,7 +71,7 @@ void CVuInterpreter::EATANxy(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = arctan(VF[fs](y) / VF[fs](x))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -85,7 +85,7 @@ void CVuInterpreter::EATANxz(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = arctan(VF[fs](y) / VF[fs](x))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -99,7 +99,7 @@ void CVuInterpreter::ESUM(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = VF[fs](w) + VF[fs](x) + VF[fs](y) + VF[fs](z)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(VuVectorField::X);
@@ -115,7 +115,7 @@ void CVuInterpreter::ERCPR(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = 1 / VF[fs](fsf)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -128,7 +128,7 @@ void CVuInterpreter::ESQRT(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = sqrt(VF[fs](fsf))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -141,7 +141,7 @@ void CVuInterpreter::ERSQRT(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = 1 / sqrt(VF[fs](fsf))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -154,7 +154,7 @@ void CVuInterpreter::ESIN(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = sin(VF[fs](fsf))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -167,7 +167,7 @@ void CVuInterpreter::EATAN(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = arctan(VF[fs](fsf))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -180,7 +180,7 @@ void CVuInterpreter::EEXP(VuUnit_Base* unit, const VuInstruction inst)
 {
     // P = exp(-VF[fs](fsf))
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->p;
 
     const f32 a = reg_source.read_float(inst.fsf());
@@ -15,140 +15,78 @@
 // VF[x](f) - the f field of the x-th register of VF, if not specified
 //            then the operation is applied to all fields (xyzw)
 
+VuVector::Vector CVuInterpreter::format_fmac_result(VuUnit_Base* unit, const ubyte dest, const VuVector::Vector value)
+{
+    uhword mac_flags;
+    const VuVector::Vector result = VuVector::to_ps2(value, mac_flags);
+    if (fmac_flags_live[unit->core_id])
+        unit->mac.update_vector_fields(mac_flags & VuVector::dest_mac_mask(dest));
+    else
+        unit->mac.update_sticky_fields(mac_flags & VuVector::dest_mac_mask(dest));
+    return result;
+}
+
 void CVuInterpreter::ABS(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[ft] = abs(VF[fs]) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
-
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            // std::abs uses compiler intrinsics internally, and hence it's
-            // sometimes faster than bit ops ...
-            // const f32 val = reg_source.read_float(field);
-            // const f32 result = to_ps2_float(std::abs(val), flags);
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
-            // ... but it might screw the PS2 floats out, so we do bit ops by
-            // ANDing the value with 0x7FFFFFFF, setting the first bit to 0 (positive).
-            const uword raw = reg_source.read_uword(field) & 0x7FFFFFFF;
-            const f32 result = *reinterpret_cast<const f32*>(&raw);
-
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    VuVector::store(reg_dest, VuVector::abs(VuVector::load(reg_source)), inst.dest());
 }
 
 void CVuInterpreter::ADD(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] + VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] + I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] + Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = VF[fs] + VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -179,106 +117,53 @@ void CVuInterpreter::ADDA(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] + VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDAi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] + I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDAq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] + Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // ACC = VF[fs] + VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::add(a, b)), inst.dest());
 }
 
 void CVuInterpreter::ADDAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -309,104 +194,53 @@ void CVuInterpreter::SUB(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] - VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-            unit->mac.clear_vector_field(field);
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] - I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] - Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = VF[fs] - VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -437,106 +271,53 @@ void CVuInterpreter::SUBA(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] - VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBAi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] - I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBAq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] - Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // ACC = VF[fs] - VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::sub(a, b)), inst.dest());
 }
 
 void CVuInterpreter::SUBAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -567,106 +348,53 @@ void CVuInterpreter::MUL(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];    
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -697,106 +425,53 @@ void CVuInterpreter::MULA(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULAi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULAq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // ACC = VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->acc;
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->acc;
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, format_fmac_result(unit, inst.dest(), VuVector::mul(a, b)), inst.dest());
 }
 
 void CVuInterpreter::MULAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -827,137 +502,79 @@ void CVuInterpreter::MADD(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = ACC + VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-
-            // According to the VU manual,
-            // MAC flag and status flag are set according to the final result
-            // and the sticky flags indicate the exceptions raised during multiplication
-            const f32 multiplied = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    const VuVector::Vector c = VuVector::load(reg_source_3);
 
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    // According to the VU manual,
+    // MAC flag and status flag are set according to the final result
+    // and the sticky flags indicate the exceptions raised during multiplication
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = ACC + VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = ACC + VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = ACC + VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -988,134 +605,77 @@ void CVuInterpreter::MADDA(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = ACC + VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDAi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = ACC + VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDAq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = ACC + VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // ACC = ACC + VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::add(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MADDAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1146,134 +706,77 @@ void CVuInterpreter::MSUB(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1304,134 +807,77 @@ void CVuInterpreter::MSUBA(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * VF[ft] for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBAi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * I for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBAq(VuUnit_Base* unit, const VuInstruction inst)
 {
     // ACC = VF[fs] * Q for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->q;
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // ACC = VF[fs] * VF[ft](bc) for each field if (dest[field] == 1)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_source_3 = unit->acc;
-    SizedQwordRegister& reg_dest = unit->acc;
-    // const ubyte bc = inst.bc();
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_3 = unit->acc;
+    AlignedQwordRegister& reg_dest = unit->acc;
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    const VuVector::Vector c = VuVector::load(reg_source_3);
+
+    // See MADD for details
+    const VuVector::Vector multiplied = format_fmac_result(unit, inst.dest(), VuVector::mul(a, b));
+    const VuVector::Vector result = format_fmac_result(unit, inst.dest(), VuVector::sub(c, multiplied));
+    VuVector::store(reg_dest, result, inst.dest());
 }
 
 void CVuInterpreter::MSUBAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1462,71 +908,41 @@ void CVuInterpreter::MAX(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = max(VF[fs], VF[ft])
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            reg_dest.write_float(field, std::max(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, VuVector::max(a, b), inst.dest());
 }
 
 void CVuInterpreter::MAXi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = max(VF[fs], i)
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            reg_dest.write_float(field, std::max(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, VuVector::max(a, b), inst.dest());
 }
 
 void CVuInterpreter::MAXbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = max(VF[fs], VF[ft])
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
     const ubyte bc = static_cast<ubyte>(idx);
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            reg_dest.write_float(field, std::max(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, VuVector::max(a, b), inst.dest());
 }
 
 void CVuInterpreter::MAXbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1557,71 +973,41 @@ void CVuInterpreter::MINI(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = min(VF[fs], VF[ft])
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            reg_dest.write_float(field, std::min(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::load(reg_source_2);
+    VuVector::store(reg_dest, VuVector::min(a, b), inst.dest());
 }
 
 void CVuInterpreter::MINIi(VuUnit_Base* unit, const VuInstruction inst)
 {
     // VF[fd] = min(VF[fs], VF[ft])
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedWordRegister& reg_source_2 = unit->i;
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            reg_dest.write_float(field, std::min(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float());
+    VuVector::store(reg_dest, VuVector::min(a, b), inst.dest());
 }
 
 void CVuInterpreter::MINIbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
 {
     // VF[fd] = min(VF[fs], VF[ft])
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
     const ubyte bc = static_cast<ubyte>(idx);
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            reg_dest.write_float(field, std::min(a, b));
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const VuVector::Vector a = VuVector::load(reg_source_1);
+    const VuVector::Vector b = VuVector::broadcast(reg_source_2.read_float(bc));
+    VuVector::store(reg_dest, VuVector::min(a, b), inst.dest());
 }
 
 void CVuInterpreter::MINIbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1654,22 +1040,13 @@ void CVuInterpreter::OPMULA(VuUnit_Base* unit, const VuInstruction inst)
     // ACCy = VF[fs](z) * VF[ft](x)
     // ACCz = VF[fs](x) * VF[ft](y)
 
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& acc = unit->acc;
-
-    FpuFlags flags;
-
-    acc.write_float(VuVectorField::X, to_ps2_float(fs.read_float(VuVectorField::Y) * ft.read_float(VuVectorField::Z), flags));
-    unit->mac.update_vector_field(VuVectorField::X, flags);
-
-    acc.write_float(VuVectorField::Y, to_ps2_float(fs.read_float(VuVectorField::Z) * ft.read_float(VuVectorField::X), flags));
-    unit->mac.update_vector_field(VuVectorField::Y, flags);
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& acc = unit->acc;
 
-    acc.write_float(VuVectorField::Z, to_ps2_float(fs.read_float(VuVectorField::X) * ft.read_float(VuVectorField::Y), flags));
-    unit->mac.update_vector_field(VuVectorField::Z, flags);
-
-    unit->mac.clear_vector_field(VuVectorField::W);
+    const VuVector::Vector a = VuVector::shuffle_yzx(VuVector::load(fs));
+    const VuVector::Vector b = VuVector::shuffle_zxy(VuVector::load(ft));
+    VuVector::store(acc, format_fmac_result(unit, VuVector::DEST_XYZ, VuVector::mul(a, b)), VuVector::DEST_XYZ);
 }
 
 void CVuInterpreter::OPMSUB(VuUnit_Base* unit, const VuInstruction inst)
@@ -1678,22 +1055,15 @@ void CVuInterpreter::OPMSUB(VuUnit_Base* unit, const VuInstruction inst)
     // VF[fd](y) = ACC(y) - VF[fs](z) * VF[ft](x)
     // VF[fd](z) = ACC(z) - VF[fs](x) * VF[ft](y)
 
-    SizedQwordRegister& fd = unit->vf[inst.fd()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& acc = unit->acc;
-
-    FpuFlags flags;
-    fd.write_float(VuVectorField::X, to_ps2_float(acc.read_float(VuVectorField::X) - fs.read_float(VuVectorField::Y) * ft.read_float(VuVectorField::Z), flags));
-    unit->mac.update_vector_field(VuVectorField::X, flags);
-
-    fd.write_float(VuVectorField::Y, to_ps2_float(acc.read_float(VuVectorField::Y) - fs.read_float(VuVectorField::Z) * ft.read_float(VuVectorField::X), flags));
-    unit->mac.update_vector_field(VuVectorField::Y, flags);
-
-    fd.write_float(VuVectorField::Z, to_ps2_float(acc.read_float(VuVectorField::Z) - fs.read_float(VuVectorField::X) * ft.read_float(VuVectorField::Y), flags));
-    unit->mac.update_vector_field(VuVectorField::Z, flags);
+    AlignedQwordRegister& fd = unit->vf[inst.fd()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& acc = unit->acc;
 
-    unit->mac.clear_vector_field(VuVectorField::W);
+    const VuVector::Vector a = VuVector::shuffle_yzx(VuVector::load(fs));
+    const VuVector::Vector b = VuVector::shuffle_zxy(VuVector::load(ft));
+    const VuVector::Vector c = VuVector::load(acc);
+    VuVector::store(fd, format_fmac_result(unit, VuVector::DEST_XYZ, VuVector::sub(c, VuVector::mul(a, b))), VuVector::DEST_XYZ);
 }
 
 void CVuInterpreter::DIV(VuUnit_Base* unit, const VuInstruction inst)
@@ -1701,8 +1071,8 @@ void CVuInterpreter::DIV(VuUnit_Base* unit, const VuInstruction inst)
     // Q = vf[fs] / vs[ft]
     
     SizedWordRegister& q = unit->q;
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
 
     FpuFlags flags;
     const f32 result = to_ps2_float(fs.read_float(inst.fsf()) / ft.read_float(inst.ftf()), flags);
@@ -1730,7 +1100,7 @@ void CVuInterpreter::SQRT(VuUnit_Base* unit, const VuInstruction inst)
     // Q = sqrt(abs(VF[ft]))
 
     SizedWordRegister& q = unit->q;
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
 
     const f32 result = std::sqrt(std::abs(ft.read_float(inst.ftf())));
 
@@ -1750,8 +1120,8 @@ void CVuInterpreter::RSQRT(VuUnit_Base* unit, const VuInstruction inst)
 {
     // Q = VF[fs] / sqrt(abs(VF[ft]))
     SizedWordRegister& q = unit->q;
-    SizedQwordRegister& ft = unit->vf[inst.ft()];
-    SizedQwordRegister& fs = unit->vf[inst.fs()];
+    AlignedQwordRegister& ft = unit->vf[inst.ft()];
+    AlignedQwordRegister& fs = unit->vf[inst.fs()];
 
     const f32 result = std::sqrt(std::abs(ft.read_float(inst.ftf())));
 
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <boost/format.hpp>
 #include <cmath>
+#include <cstring>
 
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
 #include "Core.hpp"
@@ -23,24 +25,19 @@ void CVuInterpreter::CLIP(VuUnit_Base* unit, const VuInstruction inst)
     // Left-shifts CLIP by 6 bits, compares the fields of FS with w field of FT,
     // and sets the corresponding flags
 
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     VuUnitRegister_Clipping& clip = unit->clipping;
 
     const f32 ft = std::abs(reg_source_2.read_float(VuVectorField::W));
 
-    clip.shift_judgement();
-    clip.insert_field(VuUnitRegister_Clipping::POSX_0, reg_source_1.read_float(VuVectorField::X) >  ft);
-    clip.insert_field(VuUnitRegister_Clipping::NEGX_0, reg_source_1.read_float(VuVectorField::X) < -ft);
-    clip.insert_field(VuUnitRegister_Clipping::POSY_0, reg_source_1.read_float(VuVectorField::Y) >  ft);
-    clip.insert_field(VuUnitRegister_Clipping::NEGY_0, reg_source_1.read_float(VuVectorField::Y) < -ft);
-    clip.insert_field(VuUnitRegister_Clipping::POSZ_0, reg_source_1.read_float(VuVectorField::Z) >  ft);
-    clip.insert_field(VuUnitRegister_Clipping::NEGZ_0, reg_source_1.read_float(VuVectorField::Z) < -ft);
+    // The judgement is deferred until the register is accessed.
+    clip.add_judgement(reg_source_1.read_float(VuVectorField::X), reg_source_1.read_float(VuVectorField::Y), reg_source_1.read_float(VuVectorField::Z), ft);
 }
 
 void CVuInterpreter::RINIT(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedWordRegister& reg_dest = unit->r;
     
     // Writes a float consisting 23 bits of R as mantissa and 001111111 as exp+sign.
@@ -52,7 +49,7 @@ void CVuInterpreter::RINIT(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::RGET(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedWordRegister& reg_source = unit->r;
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
@@ -66,7 +63,7 @@ void CVuInterpreter::RGET(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::RNEXT(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedWordRegister& reg_R = unit->r;
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     // A Galois form M-series LFSR adapted from PCSX2 (advance_r() in pcsx2/vu.cpp)
     const int x = (reg_R.read_uword() >> 4) & 1;
@@ -80,7 +77,7 @@ void CVuInterpreter::RNEXT(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::RXOR(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedWordRegister& reg_source_1 = unit->r;
-    SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedWordRegister& reg_dest = unit->r;
 
     const uword a = reg_source_1.read_uword();
@@ -241,13 +238,56 @@ void CVuInterpreter::WAITP(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::XGKICK(VuUnit_Base* unit, const VuInstruction inst)
 {
-    // TODO: Wait for GIF to be implemented
+    // VU1 only
+    if (unit->core_id != 1)
+    {
+        BOOST_LOG(Core::get_logger()) << boost::format("Warning: VU%d called a VU1-only instruction: XGKICK") % unit->core_id;
+        return;
+    }
 
-#if defined(BUILD_DEBUG)
-    BOOST_LOG(Core::get_logger()) << boost::format("(%s, %d) XGKICK: Not implemented. (GIF not implemented)") % __FILENAME__ % __LINE__;
-#else
-    throw std::runtime_error("XGKICK: Not implemented. (GIF not implemented)");
-#endif
+    // Sends the GIF packet starting at VI[is] (in qwords) in data memory to
+    // the GIF through PATH1. The packet is found by walking its GIFtags up to
+    // the one with EOP set, wrapping around the end of data memory.
+    // The packet is copied out at the kick, so unlike the real VU1 a second
+    // XGKICK never has to stall for the previous PATH1 transfer to end: the
+    // GIF arbitrates the queued packets in order (see CGif::select_path()).
+    RResources& r = core->get_resources();
+    const ubyte* memory = unit->data_memory->get_memory();
+    const size_t memory_qwords = unit->data_memory->byte_bus_map_size() / NUMBER_BYTES_IN_QWORD;
+    const size_t start = unit->vi[inst.is()].read_uhword() % memory_qwords;
+
+    size_t packet_qwords = 0;
+    while (packet_qwords < memory_qwords)
+    {
+        udword tag0, tag1;
+        const ubyte* tag_address = memory + ((start + packet_qwords) % memory_qwords) * NUMBER_BYTES_IN_QWORD;
+        std::memcpy(&tag0, tag_address, NUMBER_BYTES_IN_DWORD);
+        std::memcpy(&tag1, tag_address + NUMBER_BYTES_IN_DWORD, NUMBER_BYTES_IN_DWORD);
+        const Giftag tag(tag0, tag1);
+
+        size_t data_qwords;
+        switch (tag.flg())
+        {
+        case Giftag::FLG_PACKED:
+            data_qwords = static_cast<size_t>(tag.nloop()) * tag.nreg();
+            break;
+        case Giftag::FLG_REGLIST:
+            data_qwords = (static_cast<size_t>(tag.nloop()) * tag.nreg() + 1) / 2;
+            break;
+        default:
+            data_qwords = tag.nloop();
+            break;
+        }
+
+        packet_qwords += 1 + data_qwords;
+        if (tag.eop())
+            break;
+    }
+    packet_qwords = std::min(packet_qwords, memory_qwords);
+
+    const size_t first_qwords = std::min(packet_qwords, memory_qwords - start);
+    r.ee.gif.path1_buffer.write(memory + start * NUMBER_BYTES_IN_QWORD, first_qwords * NUMBER_BYTES_IN_QWORD);
+    r.ee.gif.path1_buffer.write(memory, (packet_qwords - first_qwords) * NUMBER_BYTES_IN_QWORD);
 }
 
 void CVuInterpreter::XTOP(VuUnit_Base* unit, const VuInstruction inst)
@@ -3,15 +3,23 @@
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/Ee/Vpu/Vu/VuUnits.hpp"
+#include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
 
 // All instructions here are related to registers.
 // Particularly load/store
 
+void CVuInterpreter::sync_vu1_register_access(VuUnit_Base* unit, const uword address)
+{
+    // The bus address is 16-bit, anything above the VU0 memory (and mirrors) is the VU1 registers.
+    if (unit->core_id == 0 && static_cast<uhword>(address) >= 0x4000)
+        core->get_resources().ee.vpu.vu.unit_1.micro_sync.wait_for_finish();
+}
+
 void CVuInterpreter::MOVE(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
@@ -25,7 +33,7 @@ void CVuInterpreter::MOVE(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::MFIR(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedHwordRegister& reg_source = unit->vi[inst.is()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
@@ -38,7 +46,7 @@ void CVuInterpreter::MFIR(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::MTIR(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedHwordRegister& reg_dest = unit->vi[inst.it()];
 
     reg_dest.write_uhword(reg_source.read_uword(inst.fsf()) & 0xFFFF);
@@ -46,8 +54,8 @@ void CVuInterpreter::MTIR(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::MR32(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source = unit->vf[inst.fs()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_source = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     reg_dest.write_uword(reg_source.read_uword(VuVectorField::W), VuVectorField::X);
     reg_dest.write_uword(reg_source.read_uword(VuVectorField::X), VuVectorField::Y);
@@ -58,10 +66,11 @@ void CVuInterpreter::MR32(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::LQ(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedHwordRegister& reg_source = unit->vi[inst.is()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
     
     const shword offset = extend_integer<uhword, shword, 11>(inst.imm11());
     const uword address = (offset + reg_source.read_uhword()) * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
     const uqword source = unit->bus.read_uqword(BusContext::Vu, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
@@ -77,12 +86,13 @@ void CVuInterpreter::LQ(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::LQD(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedHwordRegister& reg_source = unit->vi[inst.is()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
     
     // Pre-decrement VI first
     reg_source.write_uhword(reg_source.read_uhword() - 1);
 
     const uword address = reg_source.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
     const uqword source = unit->bus.read_uqword(BusContext::Vu, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
@@ -98,9 +108,10 @@ void CVuInterpreter::LQD(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::LQI(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedHwordRegister& reg_source = unit->vi[inst.is()];
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     const uword address = reg_source.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
     const uqword source = unit->bus.read_uqword(BusContext::Vu, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
@@ -118,11 +129,12 @@ void CVuInterpreter::LQI(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::SQ(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedHwordRegister& reg_source_2 = unit->vi[inst.it()];
     
     const shword offset = extend_integer<uhword, shword, 11>(inst.imm11());
     const uword address = (offset + reg_source_2.read_uhword()) * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
@@ -135,12 +147,13 @@ void CVuInterpreter::SQ(VuUnit_Base* unit, const VuInstruction inst)
 
 void CVuInterpreter::SQD(VuUnit_Base* unit, const VuInstruction inst)
 {
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedHwordRegister& reg_source_2 = unit->vi[inst.it()];
     
     reg_source_2.write_uhword(reg_source_2.read_uhword() - 1);
 
     const uword address = reg_source_2.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
@@ -154,11 +167,12 @@ void CVuInterpreter::SQD(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::SQI(VuUnit_Base* unit, const VuInstruction inst)
 {
     // MEM(Ft) = Fs
-    SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
+    AlignedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedHwordRegister& reg_source_2 = unit->vi[inst.ft()]; // Mem Addr.
 
     // Real address obtained by VI * 16 (qword addressing).
     const uword address = reg_source_2.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
     {
@@ -179,6 +193,7 @@ void CVuInterpreter::ILW(VuUnit_Base* unit, const VuInstruction inst)
 
     const shword offset = extend_integer<uhword, shword, 11>(inst.imm11());
     const uword address = (offset + reg_source.read_uhword()) * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     // Note: the operation is undefined when multiple fields are specified
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -198,6 +213,7 @@ void CVuInterpreter::ISW(VuUnit_Base* unit, const VuInstruction inst)
 
     const shword offset = extend_integer<uhword, shword, 11>(inst.imm11());
     const uword address = (offset + reg_source_2.read_uhword()) * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     for (auto field : VuVectorField::VECTOR_FIELDS)
     {
@@ -215,6 +231,7 @@ void CVuInterpreter::ILWR(VuUnit_Base* unit, const VuInstruction inst)
 
     // Note: the operation is undefined when multiple fields are specified
     const uword address = reg_source.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
     for (auto field : VuVectorField::VECTOR_FIELDS)
     {
         if (inst.test_dest_field(field))
@@ -233,6 +250,7 @@ void CVuInterpreter::ISWR(VuUnit_Base* unit, const VuInstruction inst)
 
     // Real address obtained by VI * 16.
     const uword address = reg_source_2.read_uhword() * NUMBER_BYTES_IN_QWORD;
+    sync_vu1_register_access(unit, address);
 
     // 32-bit write for each dest subfield. Upper 16-bits of VI[Ft] value is set to 0.
     for (auto field : VuVectorField::VECTOR_FIELDS)
@@ -259,7 +277,7 @@ void CVuInterpreter::LOI(VuUnit_Base* unit, const VuInstruction inst)
 void CVuInterpreter::MFP(VuUnit_Base* unit, const VuInstruction inst)
 {
     SizedWordRegister& reg_source = unit->p;
-    SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
+    AlignedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
     for (auto field : VuVectorField::VECTOR_FIELDS) 
     {
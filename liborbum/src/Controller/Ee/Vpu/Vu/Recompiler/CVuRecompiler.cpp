@@ -0,0 +1,289 @@
+#include <algorithm>
+
+#include <boost/format.hpp>
+
+#include "Controller/Ee/Vpu/Vu/Recompiler/CVuRecompiler.hpp"
+
+#include "Core.hpp"
+#include "Resources/RResources.hpp"
+
+#if defined(ENV_UNIX) && defined(__x86_64__)
+#define VU_RECOMPILER_SUPPORTED 1
+#else
+#define VU_RECOMPILER_SUPPORTED 0
+#endif
+
+namespace
+{
+/// Implementation indexes of the natively emitted instructions, see VuInstruction.cpp.
+constexpr int NOP_IMPL_INDEX = 85;
+constexpr int MOVE_IMPL_INDEX = 105;
+
+/// Lane masks for each dest field value (bit 3 -> 0 = x -> w), used to blend
+/// the fields of a result into the destination register.
+alignas(16) const uword DEST_MASKS[16][NUMBER_WORDS_IN_QWORD] =
+    {
+        {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+        {0x00000000, 0x00000000, 0x00000000, 0xFFFFFFFF},
+        {0x00000000, 0x00000000, 0xFFFFFFFF, 0x00000000},
+        {0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF},
+        {0x00000000, 0xFFFFFFFF, 0x00000000, 0x00000000},
+        {0x00000000, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF},
+        {0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000},
+        {0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+        {0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000},
+        {0xFFFFFFFF, 0x00000000, 0x00000000, 0xFFFFFFFF},
+        {0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0x00000000},
+        {0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF},
+        {0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000},
+        {0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF},
+        {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000},
+        {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}};
+} // namespace
+
+CVuRecompiler::UnitContext::UnitContext(const size_t code_memory_size) :
+    code_memory(code_memory_size),
+    block_pairs_executed(0),
+    pending_exception(nullptr),
+    number_blocks_compiled(0),
+    number_code_flushes(0)
+{
+}
+
+CVuRecompiler::CVuRecompiler(Core* core) :
+    CVuInterpreter(core)
+{
+    for (auto& context : contexts)
+        context = std::make_unique<UnitContext>(VU_RECOMPILER_SUPPORTED ? CODE_MEMORY_SIZE : 0);
+
+    if (!contexts[0]->code_memory.is_valid())
+        BOOST_LOG(Core::get_logger()) << "VU recompiler not supported on this host - falling back to the interpreter";
+}
+
+CVuRecompiler::~CVuRecompiler()
+{
+    // The VU1 thread runs compiled code, stop it before the code is released.
+    stop_vu1_thread();
+
+#if defined(BUILD_DEBUG)
+    for (int i = 0; i < Constants::EE::VPU::VU::NUMBER_VU_CORES; i++)
+    {
+        const UnitContext& context = *contexts[i];
+        const VuProgramCache& cache = context.program_cache;
+        const size_t lookups = cache.get_hits() + cache.get_misses();
+        BOOST_LOG(Core::get_logger()) << boost::format("VU%d recompiler: blocks compiled = %d, cache hits = %d, misses = %d (hit rate = %.1f%%), memory rehashes = %d, code flushes = %d, code memory used = %d bytes.")
+                                             % i
+                                             % context.number_blocks_compiled
+                                             % cache.get_hits()
+                                             % cache.get_misses()
+                                             % (lookups ? (100.0 * cache.get_hits() / lookups) : 0.0)
+                                             % cache.get_number_rehashes()
+                                             % context.number_code_flushes
+                                             % context.code_memory.get_used_size();
+    }
+#endif
+}
+
+int CVuRecompiler::execute_micro(VuUnit_Base* unit)
+{
+    UnitContext& context = *contexts[unit->core_id];
+    if (!context.code_memory.is_valid())
+        return CVuInterpreter::execute_micro(unit);
+
+    // Get the compiled block starting at the current PC.
+    const uword pc = unit->pc.read_uword();
+    BlockFn block = reinterpret_cast<BlockFn>(context.program_cache.lookup(*unit->instruction_memory, pc));
+    if (!block)
+    {
+        block = compile_block(unit, context);
+        if (!block)
+            return CVuInterpreter::execute_micro(unit);
+        context.program_cache.insert(pc, reinterpret_cast<void*>(block));
+    }
+
+    context.block_pairs_executed = 0;
+
+    block(this, unit);
+
+    if (context.pending_exception)
+    {
+        std::exception_ptr exception = context.pending_exception;
+        context.pending_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+
+    return std::max(context.block_pairs_executed, 1);
+}
+
+CVuRecompiler::BlockFn CVuRecompiler::compile_block(VuUnit_Base* unit, UnitContext& context)
+{
+    using Reg = X64Emitter::Reg;
+
+    // Fetch the block (wrapping around the end of micro memory isn't followed).
+    VuMicroMemory& memory = *unit->instruction_memory;
+    const size_t memory_size = memory.byte_bus_map_size();
+    const uword start_pc = unit->pc.read_uword();
+    const size_t start_offset = start_pc & (memory_size - 1);
+
+    udword pairs[VuFlagLiveness::MAX_BLOCK_LENGTH];
+    const size_t max_count = std::min((memory_size - start_offset) / Constants::EE::VPU::SIZE_VU_INSTRUCTION, VuFlagLiveness::MAX_BLOCK_LENGTH);
+    for (size_t i = 0; i < max_count; i++)
+        pairs[i] = memory.read_udword(start_offset + i * Constants::EE::VPU::SIZE_VU_INSTRUCTION);
+
+    const size_t count = VuFlagLiveness::get_block_length(pairs, max_count);
+    VuFlagLiveness::Liveness liveness[VuFlagLiveness::MAX_BLOCK_LENGTH];
+    VuFlagLiveness::analyse(pairs, count, liveness);
+
+    // Make sure there is enough space for the worst case block size, otherwise
+    // discard everything compiled so far for this unit (nothing is running it).
+    constexpr size_t MAX_PAIR_CODE_SIZE = 160;
+    constexpr size_t MAX_OVERHEAD_CODE_SIZE = 32;
+    const size_t max_code_size = count * MAX_PAIR_CODE_SIZE + MAX_OVERHEAD_CODE_SIZE;
+    if (context.code_memory.get_free_size() < max_code_size)
+    {
+        context.code_memory.reset();
+        context.program_cache.flush();
+        context.number_code_flushes++;
+        if (context.code_memory.get_free_size() < max_code_size)
+            return nullptr;
+    }
+
+    X64Emitter emitter(context.code_memory.get_free_pointer(), context.code_memory.get_free_size());
+    std::vector<size_t> exit_fixups;
+
+    // Calls a helper with (self, unit, edx, ecx, r8d), exiting the block if it returns false.
+    const auto emit_call = [&](const void* function, const uword arg_2, const uword arg_3, const uword arg_4) {
+        emitter.mov_r64_r64(Reg::RDI, Reg::RBX);
+        emitter.mov_r64_r64(Reg::RSI, Reg::R12);
+        emitter.mov_r32_imm32(Reg::RDX, arg_2);
+        emitter.mov_r32_imm32(Reg::RCX, arg_3);
+        emitter.mov_r32_imm32(Reg::R8, arg_4);
+        emitter.call(function);
+        emitter.test_r8_r8(Reg::RAX, Reg::RAX);
+        exit_fixups.push_back(emitter.jcc(X64Emitter::Cond::E));
+    };
+
+    // Prologue: keep 'this' and the unit in callee saved registers. The
+    // pushes also realign the stack to 16 bytes for the calls below.
+    emitter.push(Reg::RBX);
+    emitter.push(Reg::R12);
+    emitter.push(Reg::RBP);
+    emitter.mov_r64_r64(Reg::RBX, Reg::RDI);
+    emitter.mov_r64_r64(Reg::R12, Reg::RSI);
+
+    // Body: the upper instruction, then the lower instruction (or immediate),
+    // then the PC update for each pair.
+    for (size_t i = 0; i < count; i++)
+    {
+        const VuInstruction upper = VuFlagLiveness::get_upper(pairs[i]);
+        const VuInstruction lower = VuFlagLiveness::get_lower(pairs[i]);
+
+        const int upper_impl_index = upper.upper_lookup().impl_index;
+        const bool is_dead_clip = VuFlagLiveness::is_clip(upper_impl_index) && !liveness[i].clipping_live;
+        if (upper_impl_index != NOP_IMPL_INDEX && !is_dead_clip)
+            emit_call(reinterpret_cast<const void*>(&CVuRecompiler::run_instruction), upper.value, static_cast<uword>(upper_impl_index), liveness[i].mac_live);
+
+        if (!VuFlagLiveness::has_lower(pairs[i]))
+        {
+            emit_call(reinterpret_cast<const void*>(&CVuRecompiler::run_instruction), lower.value, static_cast<uword>(LOI_IMPL_INDEX), true);
+        }
+        else
+        {
+            const int lower_impl_index = lower.lower_lookup().impl_index;
+            if (lower_impl_index == MOVE_IMPL_INDEX)
+                emit_move(emitter, unit, lower);
+            else
+                emit_call(reinterpret_cast<const void*>(&CVuRecompiler::run_instruction), lower.value, static_cast<uword>(lower_impl_index), true);
+        }
+
+        const bool is_end = (upper.value & VuFlagLiveness::UPPER_E_BIT) != 0;
+        const uword next_pc = start_pc + static_cast<uword>((i + 1) * Constants::EE::VPU::SIZE_VU_INSTRUCTION);
+        emit_call(reinterpret_cast<const void*>(&CVuRecompiler::end_pair), is_end, next_pc, 0);
+    }
+
+    // Epilogue.
+    const size_t exit_position = emitter.get_position();
+    emitter.pop(Reg::RBP);
+    emitter.pop(Reg::R12);
+    emitter.pop(Reg::RBX);
+    emitter.ret();
+
+    for (const auto fixup : exit_fixups)
+        emitter.bind(fixup, exit_position);
+
+    if (emitter.has_overflowed())
+        return nullptr;
+
+    BlockFn fn = reinterpret_cast<BlockFn>(emitter.get_code());
+    context.code_memory.commit(emitter.get_position());
+    context.number_blocks_compiled++;
+    return fn;
+}
+
+void CVuRecompiler::emit_move(X64Emitter& emitter, VuUnit_Base* unit, const VuInstruction inst)
+{
+    using Reg = X64Emitter::Reg;
+    using Xmm = X64Emitter::Xmm;
+
+    const ubyte dest = inst.dest();
+    if (!dest)
+        return;
+
+    // The registers never move, so their addresses are baked in.
+    emitter.mov_r64_imm64(Reg::RAX, reinterpret_cast<udword>(unit->vf[inst.fs()].data()));
+    emitter.movaps_xmm_m128(Xmm::XMM0, Reg::RAX);
+    emitter.mov_r64_imm64(Reg::RCX, reinterpret_cast<udword>(unit->vf[inst.ft()].data()));
+
+    // Blend in the unselected fields of the destination.
+    if (dest != 0xF)
+    {
+        emitter.mov_r64_imm64(Reg::RDX, reinterpret_cast<udword>(DEST_MASKS[dest]));
+        emitter.movaps_xmm_m128(Xmm::XMM1, Reg::RDX);
+        emitter.movaps_xmm_m128(Xmm::XMM2, Reg::RCX);
+        emitter.andps(Xmm::XMM0, Xmm::XMM1);
+        emitter.andnps(Xmm::XMM1, Xmm::XMM2);
+        emitter.orps(Xmm::XMM0, Xmm::XMM1);
+    }
+
+    emitter.movaps_m128_xmm(Reg::RCX, Xmm::XMM0);
+}
+
+bool CVuRecompiler::run_instruction(CVuRecompiler* self, VuUnit_Base* unit, const uword raw_inst, const int impl_index, const bool is_mac_live)
+{
+    try
+    {
+        if (impl_index == LOI_IMPL_INDEX)
+        {
+            self->LOI(unit, VuInstruction(raw_inst));
+        }
+        else
+        {
+            self->fmac_flags_live[unit->core_id] = is_mac_live;
+            (self->*(self->VU_INSTRUCTION_TABLE[impl_index]))(unit, VuInstruction(raw_inst));
+            self->fmac_flags_live[unit->core_id] = true;
+        }
+    }
+    catch (...)
+    {
+        self->fmac_flags_live[unit->core_id] = true;
+        self->contexts[unit->core_id]->pending_exception = std::current_exception();
+        return false;
+    }
+
+    return true;
+}
+
+bool CVuRecompiler::end_pair(CVuRecompiler* self, VuUnit_Base* unit, const bool is_end, const uword next_pc)
+{
+    self->advance_micro_pair(unit, is_end);
+    self->contexts[unit->core_id]->block_pairs_executed++;
+
+    // Stop executing the block if the program ended, or the control flow
+    // changed (branch taken).
+    if (!unit->micro_sync.is_running())
+        return false;
+    if (unit->pc.read_uword() != next_pc)
+        return false;
+
+    return true;
+}
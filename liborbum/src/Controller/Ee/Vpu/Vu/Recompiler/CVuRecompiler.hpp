@@ -0,0 +1,85 @@
+#pragma once
+
+#include <exception>
+#include <memory>
+
+#include "Common/Types/Jit/ExecutableMemory.hpp"
+#include "Common/Types/Jit/X64Emitter.hpp"
+#include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
+#include "Controller/Ee/Vpu/Vu/Recompiler/VuProgramCache.hpp"
+#include "Controller/Ee/Vpu/Vu/VuFlagLiveness.hpp"
+
+class Core;
+
+/// The VU micro mode recompiler. Translates blocks of micro instruction pairs
+/// (see VuFlagLiveness::get_block_length()) into host x86-64 code, which are
+/// cached per unit by the micro memory contents and entry PC (see VuProgramCache).
+/// Simple instructions are emitted as SSE code directly (NOP, MOVE), the rest
+/// are dispatched to the interpreter implementations with their operands baked
+/// in, so this inherits from the interpreter. Flag updates which are never
+/// observed are skipped, see VuFlagLiveness.
+/// Macro mode (COP2) is not affected - it is always interpreted by the EE Core.
+/// Only x86-64 Unix (SysV ABI) hosts are supported, on other hosts (or if the
+/// executable memory could not be allocated) this falls back to interpreting.
+class CVuRecompiler : public CVuInterpreter
+{
+public:
+    /// Size of the host code buffer, per unit. Once full, all compiled code of the unit is discarded.
+    static constexpr size_t CODE_MEMORY_SIZE = 4 * 1024 * 1024;
+
+    CVuRecompiler(Core* core);
+    ~CVuRecompiler();
+
+    /// Executes a whole (compiled) block of the micro program of the unit.
+    int execute_micro(VuUnit_Base* unit) override;
+
+private:
+    /// Compiled block function signature.
+    using BlockFn = void (*)(CVuRecompiler* self, VuUnit_Base* unit);
+
+    /// Implementation index used for the lower immediate (LOI) when the I bit is set.
+    static constexpr int LOI_IMPL_INDEX = -1;
+
+    /// Recompiler state, per unit. Each unit has its own code memory and cache
+    /// so VU0 and VU1 can run on different threads (see CoreOptions::vu1_thread).
+    struct UnitContext
+    {
+        UnitContext(const size_t code_memory_size);
+
+        /// Host code buffer.
+        ExecutableMemory code_memory;
+
+        /// Compiled blocks.
+        VuProgramCache program_cache;
+
+        /// Number of instruction pairs executed by the current compiled block.
+        int block_pairs_executed;
+
+        /// C++ exceptions can't unwind through generated code, so they are caught
+        /// in run_instruction() and rethrown after the compiled block returns.
+        std::exception_ptr pending_exception;
+
+        /// Recompiler statistics.
+        size_t number_blocks_compiled;
+        size_t number_code_flushes;
+    };
+
+    /// Translates the block starting at the current PC of the unit into host
+    /// code, returning nullptr on failure.
+    BlockFn compile_block(VuUnit_Base* unit, UnitContext& context);
+
+    /// Emits native code for a MOVE instruction (VF[ft] = VF[fs] for the dest fields).
+    void emit_move(X64Emitter& emitter, VuUnit_Base* unit, const VuInstruction inst);
+
+    /// Runs a single (upper or lower) instruction through the interpreter
+    /// implementation. Called from compiled code. Returns false if a host
+    /// exception was thrown, which stops the block.
+    static bool run_instruction(CVuRecompiler* self, VuUnit_Base* unit, const uword raw_inst, const int impl_index, const bool is_mac_live);
+
+    /// Advances the PC and handles the E bit after an instruction pair.
+    /// Called from compiled code. Returns if the block should continue
+    /// executing (ie: no branch taken, program still running).
+    static bool end_pair(CVuRecompiler* self, VuUnit_Base* unit, const bool is_end, const uword next_pc);
+
+    std::unique_ptr<UnitContext> contexts[Constants::EE::VPU::VU::NUMBER_VU_CORES];
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstring>
+#include <unordered_map>
+
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Ee/Vpu/Vu/VuMicroMemory.hpp"
+
+/// Cache of the compiled blocks of VU micro programs (see CVuRecompiler),
+/// keyed by a hash of the whole micro memory and the entry PC of the block.
+/// Keying by the memory contents (rather than just the PC) means a program
+/// which is uploaded again (ie: by MPG, as games swap programs in and out
+/// every frame) reuses the code compiled the last time it was resident.
+/// The memory is only rehashed when it was written to since the last lookup
+/// (see VuMicroMemory::get_generation()), not on every program start.
+/// Entries are only removed by flush(), when the code memory is exhausted.
+class VuProgramCache
+{
+public:
+    VuProgramCache() :
+        memory_generation(0),
+        memory_hash(0),
+        is_hash_valid(false),
+        hits(0),
+        misses(0),
+        number_rehashes(0)
+    {
+    }
+
+    /// Returns the compiled code for the block starting at the PC given, or
+    /// nullptr if it has not been compiled for the current memory contents.
+    /// Updates the hit/miss counters.
+    void* lookup(VuMicroMemory& memory, const uword pc)
+    {
+        // The generation is read before hashing, so a concurrent write
+        // causes a rehash on the next lookup.
+        const uword generation = memory.get_generation();
+        if (!is_hash_valid || generation != memory_generation)
+        {
+            memory_hash = hash_memory(memory);
+            memory_generation = generation;
+            is_hash_valid = true;
+            number_rehashes++;
+        }
+
+        auto it = blocks.find(Key{memory_hash, pc});
+        if (it != blocks.end())
+        {
+            hits++;
+            return it->second;
+        }
+
+        misses++;
+        return nullptr;
+    }
+
+    /// Adds the compiled code for the block starting at the PC given, for the
+    /// memory contents of the last lookup().
+    void insert(const uword pc, void* code)
+    {
+        blocks[Key{memory_hash, pc}] = code;
+    }
+
+    /// Removes all entries (ie: when the code memory is reset).
+    void flush()
+    {
+        blocks.clear();
+    }
+
+    /// Program cache statistics.
+    size_t get_hits() const
+    {
+        return hits;
+    }
+
+    size_t get_misses() const
+    {
+        return misses;
+    }
+
+    size_t get_number_rehashes() const
+    {
+        return number_rehashes;
+    }
+
+    size_t get_number_blocks() const
+    {
+        return blocks.size();
+    }
+
+private:
+    struct Key
+    {
+        udword memory_hash;
+        uword pc;
+
+        bool operator==(const Key& other) const
+        {
+            return (memory_hash == other.memory_hash) && (pc == other.pc);
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return static_cast<size_t>(key.memory_hash ^ (static_cast<udword>(key.pc) * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    /// 64-bit hash of the whole micro memory, processed 8 bytes at a time.
+    static udword hash_memory(VuMicroMemory& memory)
+    {
+        constexpr udword PRIME_1 = 0x9E3779B185EBCA87ULL;
+        constexpr udword PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+        const ubyte* data = memory.get_memory();
+        const size_t size = memory.byte_bus_map_size();
+
+        udword hash = size * PRIME_1;
+        for (size_t offset = 0; offset < size; offset += NUMBER_BYTES_IN_DWORD)
+        {
+            udword value;
+            std::memcpy(&value, data + offset, sizeof(value));
+            hash ^= value * PRIME_2;
+            hash = ((hash << 31) | (hash >> 33)) * PRIME_1;
+        }
+
+        // Final avalanche.
+        hash ^= hash >> 33;
+        hash *= PRIME_2;
+        hash ^= hash >> 29;
+        return hash;
+    }
+
+    std::unordered_map<Key, void*, KeyHash> blocks;
+
+    uword memory_generation;
+    udword memory_hash;
+    bool is_hash_valid;
+
+    size_t hits;
+    size_t misses;
+    size_t number_rehashes;
+};
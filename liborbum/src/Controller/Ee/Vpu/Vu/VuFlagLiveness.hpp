@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Ee/Vpu/Vu/VuInstruction.hpp"
+#include "Resources/Ee/Vpu/Vu/VuUnitRegisters.hpp"
+
+/// Static flag liveness analysis for VU micro programs.
+/// Most FMAC results never have their MAC flags inspected - they are
+/// overwritten by the next FMAC instruction before any of the flag
+/// instructions (FMAND, FSAND, etc) run. Similarly, CLIP judgements are
+/// often shifted out of the Clipping register before they are read.
+/// This pass works out, for a block of straight-line code (up to and
+/// including the next branch or end of program), which flag updates are
+/// observable, so the executor can skip the dead ones:
+/// - A dead MAC update only needs to accumulate the sticky Status flags
+///   (see VuUnitRegister_Mac::update_sticky_fields()), as these are never
+///   cleared by the micro program and so can't be proven dead.
+/// - A dead CLIP can be skipped entirely.
+/// Everything is assumed to be live at the end of the block, as the flags
+/// can be read by the next block, CFC2 or the bus after the program ends.
+/// Instruction pairs are given as the raw 64-bit values (upper instruction in
+/// the high word), as stored in micro memory.
+/// See VU Users Manual page 39 (flags) and page 60 (instruction format).
+namespace VuFlagLiveness
+{
+/// Maximum number of instruction pairs in a block.
+static constexpr size_t MAX_BLOCK_LENGTH = 64;
+
+/// Bits of the upper instruction.
+static constexpr uword UPPER_I_BIT = 1u << 31; // Lower instruction is an immediate float (for the I register).
+static constexpr uword UPPER_E_BIT = 1u << 30; // End of program (after the next instruction pair).
+
+/// Liveness of the flag updates of an instruction pair.
+/// Pairs which don't update the flags are always marked live.
+struct Liveness
+{
+    bool mac_live;
+    bool clipping_live;
+};
+
+inline VuInstruction get_upper(const udword pair)
+{
+    return VuInstruction(static_cast<uword>(pair >> 32));
+}
+
+inline VuInstruction get_lower(const udword pair)
+{
+    return VuInstruction(static_cast<uword>(pair));
+}
+
+/// Returns if the lower instruction is an actual instruction (not an immediate).
+inline bool has_lower(const udword pair)
+{
+    return !(get_upper(pair).value & UPPER_I_BIT);
+}
+
+/// Upper instructions which update the MAC (and Status) flags:
+/// ADD, ADDA, SUB, SUBA, MUL, MULA, MADD, MADDA, MSUB, MSUBA (all variants),
+/// OPMULA and OPMSUB. See the implementation indexes in VuInstruction.cpp.
+inline bool writes_mac(const int upper_impl_index)
+{
+    return (upper_impl_index >= 1 && upper_impl_index <= 70) || upper_impl_index == 83 || upper_impl_index == 84;
+}
+
+inline bool is_clip(const int upper_impl_index)
+{
+    return upper_impl_index == 94;
+}
+
+/// Lower instructions which read the MAC or Status flags:
+/// FSAND, FSEQ, FSOR, FSSET, FMAND, FMEQ and FMOR.
+inline bool reads_mac(const int lower_impl_index)
+{
+    return lower_impl_index >= 124 && lower_impl_index <= 130;
+}
+
+/// Lower instructions which read the Clipping flags: FCAND, FCEQ, FCOR and FCGET.
+inline bool reads_clipping(const int lower_impl_index)
+{
+    return (lower_impl_index >= 131 && lower_impl_index <= 133) || lower_impl_index == 135;
+}
+
+/// FCSET, which overwrites all of the Clipping flags.
+inline bool writes_clipping(const int lower_impl_index)
+{
+    return lower_impl_index == 134;
+}
+
+/// Branches and jumps: B, BAL, JR, JALR, IBEQ, IBNE, IBLTZ, IBGTZ, IBLEZ and IBGEZ.
+inline bool is_branch(const int lower_impl_index)
+{
+    return lower_impl_index >= 136 && lower_impl_index <= 145;
+}
+
+/// Returns the length of the block starting at the instruction pairs given,
+/// which ends after the delay slot of the first branch, or the pair following
+/// the one with the E bit set.
+inline size_t get_block_length(const udword* pairs, const size_t max_count)
+{
+    const size_t count = std::min(max_count, MAX_BLOCK_LENGTH);
+    for (size_t i = 0; i < count; i++)
+    {
+        const bool is_end = (get_upper(pairs[i]).value & UPPER_E_BIT) != 0;
+        if (is_end || (has_lower(pairs[i]) && is_branch(get_lower(pairs[i]).lower_lookup().impl_index)))
+            return std::min(i + 2, count);
+    }
+    return count;
+}
+
+/// Analyses the block given (see get_block_length()), filling in the
+/// liveness of each pair. The lower instruction of a pair is treated as
+/// reading the flags after the upper instruction has updated them.
+inline void analyse(const udword* pairs, const size_t count, Liveness* liveness)
+{
+    // Work backwards from the end of the block, where everything is live.
+    bool mac_live = true;
+    size_t clipping_judgements_live = VuUnitRegister_Clipping::NUMBER_JUDGEMENTS;
+
+    for (size_t i = count; i-- > 0;)
+    {
+        if (has_lower(pairs[i]))
+        {
+            const int lower_impl_index = get_lower(pairs[i]).lower_lookup().impl_index;
+            if (reads_mac(lower_impl_index))
+                mac_live = true;
+            if (reads_clipping(lower_impl_index))
+                clipping_judgements_live = VuUnitRegister_Clipping::NUMBER_JUDGEMENTS;
+            else if (writes_clipping(lower_impl_index))
+                clipping_judgements_live = 0;
+        }
+
+        liveness[i] = {true, true};
+
+        const int upper_impl_index = get_upper(pairs[i]).upper_lookup().impl_index;
+        if (writes_mac(upper_impl_index))
+        {
+            // The whole MAC register is written, regardless of the dest fields.
+            liveness[i].mac_live = mac_live;
+            mac_live = false;
+        }
+        else if (is_clip(upper_impl_index))
+        {
+            // The judgement is live if it is still within the register when it is
+            // read - each CLIP shifts the older judgements along by one.
+            liveness[i].clipping_live = clipping_judgements_live > 0;
+            if (clipping_judgements_live > 0)
+                clipping_judgements_live--;
+        }
+    }
+}
+} // namespace VuFlagLiveness
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstring>
+
+#include "Common/Constants.hpp"
+#include "Common/Simd.hpp"
+#include "Common/Types/FpuFlags.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/Register/AlignedQwordRegister.hpp"
+#include "Utilities/Utilities.hpp"
+
+/// 4-wide (xyzw) float operations for the VU FMAC units, operating on all of
+/// the fields of a VF register at once.
+/// Maps directly onto SSE when the host has it, with an equivalent per-field
+/// scalar version for other hosts (see Simd.hpp).
+/// Results are IEEE 754 floats until formatted by to_ps2(), which clamps them
+/// to PS2 floats (see to_ps2_float()) and generates the MAC flags.
+/// Field selection uses the instruction dest layout (bit 3 -> 0 = x -> w),
+/// which is also the layout of each group of flags in the MAC register.
+namespace VuVector
+{
+/// The dest field for the x, y and z fields only (ie: OPMULA/OPMSUB).
+static constexpr ubyte DEST_XYZ = 0xE;
+
+/// Returns the MAC flag bits (Z, S, U and O) for the dest fields given.
+inline uhword dest_mac_mask(const ubyte dest)
+{
+    return static_cast<uhword>(dest * 0x1111);
+}
+
+/// Reverses the order of the fields within each group of 4 flags, converting
+/// between lane order (bit 0 -> 3 = x -> w) and the dest/MAC layout.
+inline uhword reverse_fields(const uhword flags)
+{
+    return static_cast<uhword>(((flags & 0x1111) << 3) | ((flags & 0x2222) << 1) | ((flags & 0x4444) >> 1) | ((flags & 0x8888) >> 3));
+}
+
+#if defined(SIMD_SSE2)
+using Vector = __m128;
+
+inline Vector load(const AlignedQwordRegister& reg)
+{
+    return _mm_load_ps(reinterpret_cast<const f32*>(reg.data()));
+}
+
+inline void store(AlignedQwordRegister& reg, const Vector value)
+{
+    _mm_store_ps(reinterpret_cast<f32*>(reg.data()), value);
+}
+
+/// Returns a lane mask for the dest fields given.
+inline __m128i dest_mask(const ubyte dest)
+{
+    const __m128i bits = _mm_setr_epi32(0x8, 0x4, 0x2, 0x1);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(dest), bits), bits);
+}
+
+/// Writes only the dest fields given to the register.
+inline void store(AlignedQwordRegister& reg, const Vector value, const ubyte dest)
+{
+    if (dest == 0xF)
+    {
+        store(reg, value);
+        return;
+    }
+
+    const __m128 mask = _mm_castsi128_ps(dest_mask(dest));
+    store(reg, _mm_or_ps(_mm_and_ps(mask, value), _mm_andnot_ps(mask, load(reg))));
+}
+
+inline Vector broadcast(const f32 value)
+{
+    return _mm_set1_ps(value);
+}
+
+inline Vector add(const Vector a, const Vector b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline Vector sub(const Vector a, const Vector b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline Vector mul(const Vector a, const Vector b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+/// Max/min, with the same operand preference as std::max/std::min.
+inline Vector max(const Vector a, const Vector b)
+{
+    return _mm_max_ps(b, a);
+}
+
+inline Vector min(const Vector a, const Vector b)
+{
+    return _mm_min_ps(b, a);
+}
+
+/// Clears the sign bits (no formatting is done).
+inline Vector abs(const Vector a)
+{
+    return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+
+/// Rotations of the xyz fields used by the outer product (w is unchanged).
+inline Vector shuffle_yzx(const Vector a)
+{
+    return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+inline Vector shuffle_zxy(const Vector a)
+{
+    return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+}
+
+/// Formats the IEEE 754 floats given into PS2 floats, returning the MAC
+/// flags for every field. Matches to_ps2_float() for each field: NaN's and
+/// +/-Inf are clamped to +/-Fmax (O flag), denormals are flushed to +/-0
+/// (U flag), the Z flag is set for +/-0 and the S flag for negative values.
+inline Vector to_ps2(const Vector value, uhword& mac_flags)
+{
+    const __m128i bits = _mm_castps_si128(value);
+    const __m128i exponent_mask = _mm_set1_epi32(0x7F800000);
+    const __m128i exponent = _mm_and_si128(bits, exponent_mask);
+    const __m128i is_mantissa_zero = _mm_cmpeq_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_setzero_si128());
+    const __m128i is_exponent_zero = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+
+    const __m128i zf = _mm_and_si128(is_exponent_zero, is_mantissa_zero);
+    const __m128i sf = _mm_castps_si128(_mm_cmplt_ps(value, _mm_setzero_ps()));
+    const __m128i uf = _mm_andnot_si128(is_mantissa_zero, is_exponent_zero);
+    const __m128i of = _mm_cmpeq_epi32(exponent, exponent_mask);
+
+    // The clamped values take the sign of the S flag (not the sign bit, as for NaN's).
+    const __m128i sign = _mm_and_si128(sf, _mm_set1_epi32(Constants::EE::EECore::FPU::ZERO_NEG));
+    const __m128i fmax = _mm_or_si128(sign, _mm_set1_epi32(Constants::EE::EECore::FPU::FMAX_POS));
+    __m128i result = _mm_or_si128(_mm_and_si128(uf, sign), _mm_andnot_si128(uf, bits));
+    result = _mm_or_si128(_mm_and_si128(of, fmax), _mm_andnot_si128(of, result));
+
+    // Pack the lane masks down to bytes (Z, S, U, O groups in order), so all
+    // of the flags are gathered with a single movemask.
+    const __m128i flags = _mm_packs_epi16(_mm_packs_epi32(zf, sf), _mm_packs_epi32(uf, of));
+    mac_flags = reverse_fields(static_cast<uhword>(_mm_movemask_epi8(flags)));
+
+    return _mm_castsi128_ps(result);
+}
+#else
+struct Vector
+{
+    f32 f[4];
+};
+
+inline Vector load(const AlignedQwordRegister& reg)
+{
+    Vector value;
+    std::memcpy(value.f, reg.data(), sizeof(value.f));
+    return value;
+}
+
+inline void store(AlignedQwordRegister& reg, const Vector value)
+{
+    std::memcpy(reg.data(), value.f, sizeof(value.f));
+}
+
+/// Writes only the dest fields given to the register.
+inline void store(AlignedQwordRegister& reg, const Vector value, const ubyte dest)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (dest & (0x8 >> i))
+            reg.write_float(i, value.f[i]);
+    }
+}
+
+inline Vector broadcast(const f32 value)
+{
+    return Vector{{value, value, value, value}};
+}
+
+template <typename F>
+Vector map(const Vector a, const Vector b, F f)
+{
+    return Vector{{f(a.f[0], b.f[0]), f(a.f[1], b.f[1]), f(a.f[2], b.f[2]), f(a.f[3], b.f[3])}};
+}
+
+inline Vector add(const Vector a, const Vector b)
+{
+    return map(a, b, [](const f32 x, const f32 y) { return x + y; });
+}
+
+inline Vector sub(const Vector a, const Vector b)
+{
+    return map(a, b, [](const f32 x, const f32 y) { return x - y; });
+}
+
+inline Vector mul(const Vector a, const Vector b)
+{
+    return map(a, b, [](const f32 x, const f32 y) { return x * y; });
+}
+
+/// Max/min, with the same operand preference as std::max/std::min.
+inline Vector max(const Vector a, const Vector b)
+{
+    return map(a, b, [](const f32 x, const f32 y) { return (x < y) ? y : x; });
+}
+
+inline Vector min(const Vector a, const Vector b)
+{
+    return map(a, b, [](const f32 x, const f32 y) { return (y < x) ? y : x; });
+}
+
+/// Clears the sign bits (no formatting is done).
+inline Vector abs(const Vector a)
+{
+    Vector value;
+    for (int i = 0; i < 4; i++)
+    {
+        uword raw;
+        std::memcpy(&raw, &a.f[i], sizeof(raw));
+        raw &= 0x7FFFFFFF;
+        std::memcpy(&value.f[i], &raw, sizeof(raw));
+    }
+    return value;
+}
+
+/// Rotations of the xyz fields used by the outer product (w is unchanged).
+inline Vector shuffle_yzx(const Vector a)
+{
+    return Vector{{a.f[1], a.f[2], a.f[0], a.f[3]}};
+}
+
+inline Vector shuffle_zxy(const Vector a)
+{
+    return Vector{{a.f[2], a.f[0], a.f[1], a.f[3]}};
+}
+
+/// Formats the IEEE 754 floats given into PS2 floats, returning the MAC
+/// flags for every field (see to_ps2_float()).
+inline Vector to_ps2(const Vector value, uhword& mac_flags)
+{
+    Vector result;
+    mac_flags = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        FpuFlags flags;
+        result.f[i] = to_ps2_float(value.f[i], flags);
+        const int field = 0x8 >> i;
+        mac_flags |= (flags.ZF ? field : 0) | (flags.SF ? field << 4 : 0) | (flags.UF ? field << 8 : 0) | (flags.OF ? field << 12 : 0);
+    }
+    return result;
+}
+#endif
+} // namespace VuVector
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Controller/ControllerEvent.hpp"
+#include "Controller/ControllerType.hpp"
+
+/// Central event scheduler, keyed by the master cycle count (EE Core clock).
+/// Controllers schedule future events for any controller (including
+/// themselves), which the core delivers at the start of the run beginning at
+/// the scheduled cycle, alongside the usual time events. Runs are cut short to
+/// end at the next scheduled event (see get_time_to_next_event()), so events
+/// are delivered on time. This allows controllers that only act at known
+/// points in time (ie: CRTC blanking) to not be ticked at all.
+/// Events scheduled for the same cycle are delivered in the order scheduled.
+/// Scheduling is thread safe (controllers run in parallel), delivering and
+/// advancing are not.
+class EventScheduler
+{
+public:
+    /// Master clock speed.
+    static constexpr double MASTER_CLK_SPEED = Constants::EE::EECore::EECORE_CLK_SPEED;
+
+    struct ScheduledEvent
+    {
+        udword cycle;
+        udword sequence;
+        ControllerType::Type target;
+        ControllerEvent event;
+    };
+
+    EventScheduler() :
+        current_cycle(0),
+        time_elapsed_us(0.0),
+        next_sequence(0)
+#if defined(BUILD_DEBUG)
+        ,
+        number_events_scheduled(0)
+#endif
+    {
+    }
+
+    /// Converts between time and master cycles.
+    static udword time_to_cycles(const double time_us)
+    {
+        return static_cast<udword>(time_us / 1.0e6 * MASTER_CLK_SPEED);
+    }
+
+    static double cycles_to_time(const udword cycles)
+    {
+        return static_cast<double>(cycles) / MASTER_CLK_SPEED * 1.0e6;
+    }
+
+    /// Returns the master cycle count at the end of the last advance.
+    udword get_current_cycle() const
+    {
+        return current_cycle.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the master cycle counter itself, for state that is derived from
+    /// it on demand (ie: timer counts), without depending on the scheduler.
+    const std::atomic<udword>* get_cycle_counter() const
+    {
+        return &current_cycle;
+    }
+
+    /// Schedules an event at an absolute master cycle. Events in the past are
+    /// delivered on the next run.
+    void schedule_at(const ControllerType::Type target, const ControllerEvent& event, const udword cycle)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push({cycle, next_sequence++, target, event});
+#if defined(BUILD_DEBUG)
+        number_events_scheduled++;
+#endif
+    }
+
+    /// Schedules an event relative to the current master cycle.
+    void schedule_in(const ControllerType::Type target, const ControllerEvent& event, const udword cycles)
+    {
+        schedule_at(target, event, get_current_cycle() + cycles);
+    }
+
+    /// Returns the cycle of the next scheduled event, or false if there is none.
+    bool get_next_event_cycle(udword& cycle) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (events.empty())
+            return false;
+        cycle = events.top().cycle;
+        return true;
+    }
+
+    /// Returns the time from the current master cycle to the next scheduled
+    /// event, clamped to the range given. Used to end a run at the next event.
+    double get_time_to_next_event(const double min_time_us, const double max_time_us) const
+    {
+        udword cycle;
+        if (!get_next_event_cycle(cycle))
+            return max_time_us;
+
+        // Half a cycle over, so that the event cycle is reached despite rounding.
+        const double time_us = cycles_to_time(cycle) + cycles_to_time(1) / 2 - time_elapsed_us;
+        return std::clamp(time_us, min_time_us, max_time_us);
+    }
+
+    /// Advances the master cycle count by the time given.
+    void advance(const double time_us)
+    {
+        // Work from the total time elapsed to avoid accumulating rounding errors.
+        time_elapsed_us += time_us;
+        current_cycle.store(time_to_cycles(time_elapsed_us), std::memory_order_relaxed);
+    }
+
+    /// Passes each event that is due (at or before the current master cycle)
+    /// to the handler, in order.
+    template <typename HandlerFn>
+    void deliver_due_events(HandlerFn&& handler)
+    {
+        const udword cycle = get_current_cycle();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!events.empty() && (events.top().cycle <= cycle))
+        {
+            const ScheduledEvent scheduled_event = events.top();
+            events.pop();
+
+            // The handler may schedule new events.
+            lock.unlock();
+            handler(scheduled_event);
+            lock.lock();
+        }
+    }
+
+#if defined(BUILD_DEBUG)
+    size_t get_number_events_scheduled() const
+    {
+        return number_events_scheduled;
+    }
+#endif
+
+private:
+    struct Later
+    {
+        bool operator()(const ScheduledEvent& lhs, const ScheduledEvent& rhs) const
+        {
+            if (lhs.cycle != rhs.cycle)
+                return lhs.cycle > rhs.cycle;
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    /// Read by other threads (see get_cycle_counter()).
+    std::atomic<udword> current_cycle;
+    double time_elapsed_us;
+    udword next_sequence;
+
+    mutable std::mutex mutex;
+    std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, Later> events;
+
+#if defined(BUILD_DEBUG)
+    size_t number_events_scheduled;
+#endif
+};
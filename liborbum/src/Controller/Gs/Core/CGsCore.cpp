@@ -1,11 +1,107 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/format.hpp>
+
 #include "Controller/Gs/Core/CGsCore.hpp"
 
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 
+namespace
+{
+/// Number of vertices needed for each primitive type (PRIM.PRIM), 0 for the reserved type.
+constexpr int PRIMITIVE_VERTICES[8] = {1, 2, 2, 3, 3, 3, 2, 0};
+
+f32 to_f32(const uword value)
+{
+    f32 result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+/// Returns if the texture format is indexed with 4 bits.
+bool is_4bit_indexed(const uword psm)
+{
+    return psm == GsLocalMemory::PSMT4 || psm == GsLocalMemory::PSMT4HL || psm == GsLocalMemory::PSMT4HH;
+}
+
+/// Returns if the texture format is indexed with 8 bits.
+bool is_8bit_indexed(const uword psm)
+{
+    return psm == GsLocalMemory::PSMT8 || psm == GsLocalMemory::PSMT8H;
+}
+
+/// Returns the number of bits of local memory a texel of the format occupies
+/// (24-bit and the 8H/4HL/4HH formats use whole words).
+uword texel_storage_bits(const uword psm)
+{
+    switch (psm)
+    {
+    case GsLocalMemory::PSMT8:
+        return 8;
+    case GsLocalMemory::PSMT4:
+        return 4;
+    default:
+        return (GsLocalMemory::transfer_bits_per_pixel(psm) == 16) ? 16 : 32;
+    }
+}
+} // namespace
+
 CGsCore::CGsCore(Core* core) :
-    CController(core)
+    CController(core),
+    is_draw_state_dirty(true),
+    draw_state()
+{
+    size_t number_threads = core->get_options().number_gs_threads;
+    if (!number_threads)
+        number_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    rasterizer = std::make_unique<GsRasterizer>(core->get_resources().gs.memory, static_cast<int>(number_threads), core->get_options().gs_pipeline_compiler);
+}
+
+CGsCore::~CGsCore()
 {
+    stop_gs_thread();
+
+#if defined(BUILD_DEBUG)
+    const auto& ring = core->get_resources().gs.command_ring;
+    BOOST_LOG(Core::get_logger()) << boost::format("GS command ring: batches = %d, occupancy = %.1f average, %d max (of %d), GIF stalls (ring full) = %d, syncs = %d (%.0f us stalled), readback parks = %d.")
+                                         % ring.get_number_pushed()
+                                         % ring.get_average_occupancy()
+                                         % ring.get_max_occupancy()
+                                         % GsCommandRing::CAPACITY
+                                         % ring.get_number_push_stalls()
+                                         % ring.get_number_syncs()
+                                         % ring.get_sync_time_us()
+                                         % ring.get_number_parks();
+
+    const size_t flushes = rasterizer->get_number_flushes();
+    BOOST_LOG(Core::get_logger()) << boost::format("GS rasterizer: threads = %d, primitives = %d, flushes = %d, tile bins = %d, tiles drawn = %d (%.1f per flush).")
+                                         % rasterizer->get_number_threads()
+                                         % rasterizer->get_number_primitives()
+                                         % flushes
+                                         % rasterizer->get_number_tile_bins()
+                                         % rasterizer->get_number_tiles_drawn()
+                                         % (flushes ? (static_cast<double>(rasterizer->get_number_tiles_drawn()) / flushes) : 0.0);
+
+    const GsPixelPipelineCompiler& compiler = rasterizer->get_pipeline_compiler();
+    const size_t lookups = compiler.get_hits() + compiler.get_misses();
+    BOOST_LOG(Core::get_logger()) << boost::format("GS pixel pipelines: compiled = %d (%.0f us), cache size = %d, hits = %d, misses = %d (hit rate = %.1f%%), interpreted draw states = %d, code flushes = %d, code memory used = %d bytes.")
+                                         % compiler.get_number_compiled()
+                                         % compiler.get_compile_time_us()
+                                         % compiler.get_number_pipelines()
+                                         % compiler.get_hits()
+                                         % compiler.get_misses()
+                                         % (lookups ? (100.0 * compiler.get_hits() / lookups) : 0.0)
+                                         % compiler.get_number_interpreted()
+                                         % compiler.get_number_code_flushes()
+                                         % compiler.get_code_memory_used();
+#endif
 }
 
 void CGsCore::handle_event(const ControllerEvent& event)
@@ -14,9 +110,36 @@ void CGsCore::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
+        start_gs_thread();
+
+        // Rethrow any errors from the GS thread on the controller thread.
+        if (!gs_thread_error_queue.is_empty())
+        {
+            std::string error_str;
+            gs_thread_error_queue.pop(error_str);
+            throw std::runtime_error(error_str);
+        }
+
+        // The register writes are processed by the GS thread, which leaves
+        // sending out local -> host transmissions to here.
+        auto& r = core->get_resources();
+        if (r.gs.command_ring.is_asynchronous.load(std::memory_order_acquire))
+        {
+            if (r.gs.command_ring.is_parked())
+            {
+                send_readback();
+                if (!r.gs.core_state.readback_active)
+                    r.gs.command_ring.unpark();
+            }
+            break;
+        }
+
         int ticks_remaining = time_to_ticks(event.data.time_us);
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+
+        // Make everything drawn this time slice visible.
+        rasterizer->flush();
         break;
     }
     default:
@@ -45,6 +168,911 @@ int CGsCore::time_to_ticks(const double time_us)
 
 int CGsCore::time_step(const int ticks_available)
 {
-    // Not yet implemented.
-    return ticks_available;
-}
\ No newline at end of file
+    auto& r = core->get_resources();
+
+    // Drawing time isn't modelled: each register write takes one tick.
+    // Batches are always processed whole, so may run over the time available.
+    GsRegisterWriteBatch batch;
+    int ticks = 0;
+    while (ticks < ticks_available && r.gs.command_ring.try_pop(batch))
+    {
+        write_registers(batch.writes, batch.number_writes);
+        ticks += static_cast<int>(batch.number_writes);
+    }
+
+    if (r.gs.core_state.readback_active)
+        send_readback();
+
+    // Idle for the rest of the time when there's nothing to do.
+    return std::max(ticks, ticks_available);
+}
+
+void CGsCore::write_registers(const GsRegisterWrite* writes, const size_t count)
+{
+    size_t i = 0;
+    while (i < count)
+    {
+        // IMAGE data arrives as runs of HWREG writes, which are buffered together.
+        if (writes[i].address == GsRegisterAddress::HWREG)
+        {
+            size_t end = i + 1;
+            while (end < count && writes[end].address == GsRegisterAddress::HWREG)
+                end++;
+            write_hwreg(writes + i, end - i);
+            i = end;
+        }
+        else
+        {
+            write_register(writes[i].address, writes[i].data);
+            i++;
+        }
+    }
+}
+
+void CGsCore::write_register(const ubyte address, const udword data)
+{
+    auto& r = core->get_resources();
+
+    switch (address)
+    {
+    case GsRegisterAddress::PRIM:
+    {
+        r.gs.prim.write_udword(data);
+        r.gs.core_state.number_vertices = 0;
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::RGBAQ:
+    {
+        r.gs.rgbaq.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::ST:
+    {
+        r.gs.st.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::UV:
+    {
+        r.gs.uv.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::XYZF2:
+    case GsRegisterAddress::XYZF3:
+    {
+        auto& xyzf = (address == GsRegisterAddress::XYZF2) ? r.gs.xyzf2 : r.gs.xyzf3;
+        xyzf.write_udword(data);
+        const udword xyz = GsRegister_Xyz::Z.insert_into(data, GsRegister_Xyz::ZF.extract_from(data));
+        kick_vertex(xyz, static_cast<ubyte>(GsRegister_Xyz::F.extract_from(data)), address == GsRegisterAddress::XYZF2);
+        break;
+    }
+    case GsRegisterAddress::XYZ2:
+    case GsRegisterAddress::XYZ3:
+    {
+        auto& xyz = (address == GsRegisterAddress::XYZ2) ? r.gs.xyz2 : r.gs.xyz3;
+        xyz.write_udword(data);
+        kick_vertex(data, static_cast<ubyte>(r.gs.fog.extract_field(GsRegister_Fog::F)), address == GsRegisterAddress::XYZ2);
+        break;
+    }
+    case GsRegisterAddress::FOG:
+    {
+        r.gs.fog.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::TEX0_1:
+    case GsRegisterAddress::TEX0_2:
+    {
+        auto& context = r.gs.contexts[address - GsRegisterAddress::TEX0_1];
+        context.tex0.write_udword(data);
+        load_clut(context);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEX2_1:
+    case GsRegisterAddress::TEX2_2:
+    {
+        // Only the PSM and CLUT fields are written.
+        constexpr udword TEX2_MASK = 0xFFFFFFE003F00000;
+        auto& context = r.gs.contexts[address - GsRegisterAddress::TEX2_1];
+        context.tex0.write_udword((context.tex0.read_udword() & ~TEX2_MASK) | (data & TEX2_MASK));
+        load_clut(context);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::CLAMP_1:
+    case GsRegisterAddress::CLAMP_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::CLAMP_1].clamp.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEX1_1:
+    case GsRegisterAddress::TEX1_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::TEX1_1].tex1.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::XYOFFSET_1:
+    case GsRegisterAddress::XYOFFSET_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::XYOFFSET_1].xyoffset.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::PRMODECONT:
+    {
+        r.gs.prmodecont.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::PRMODE:
+    {
+        r.gs.prmode.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEXCLUT:
+    {
+        r.gs.texclut.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::SCANMSK:
+    {
+        r.gs.scanmsk.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::MIPTBP1_1:
+    case GsRegisterAddress::MIPTBP1_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::MIPTBP1_1].miptbp1.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::MIPTBP2_1:
+    case GsRegisterAddress::MIPTBP2_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::MIPTBP2_1].miptbp2.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEXA:
+    {
+        r.gs.texa.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::FOGCOL:
+    {
+        r.gs.fogcol.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEXFLUSH:
+    {
+        // Textures drawn to must be visible to the primitives after this.
+        r.gs.texflush.write_udword(data);
+        rasterizer->flush();
+        break;
+    }
+    case GsRegisterAddress::SCISSOR_1:
+    case GsRegisterAddress::SCISSOR_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::SCISSOR_1].scissor.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::ALPHA_1:
+    case GsRegisterAddress::ALPHA_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::ALPHA_1].alpha.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::DIMX:
+    {
+        r.gs.dimx.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::DTHE:
+    {
+        r.gs.dthe.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::COLCLAMP:
+    {
+        r.gs.colclamp.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::TEST_1:
+    case GsRegisterAddress::TEST_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::TEST_1].test.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::PABE:
+    {
+        r.gs.pabe.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::FBA_1:
+    case GsRegisterAddress::FBA_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::FBA_1].fba.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::FRAME_1:
+    case GsRegisterAddress::FRAME_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::FRAME_1].frame.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::ZBUF_1:
+    case GsRegisterAddress::ZBUF_2:
+    {
+        r.gs.contexts[address - GsRegisterAddress::ZBUF_1].zbuf.write_udword(data);
+        is_draw_state_dirty = true;
+        break;
+    }
+    case GsRegisterAddress::BITBLTBUF:
+    {
+        r.gs.bitbltbuf.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::TRXPOS:
+    {
+        r.gs.trxpos.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::TRXREG:
+    {
+        r.gs.trxreg.write_udword(data);
+        break;
+    }
+    case GsRegisterAddress::TRXDIR:
+    {
+        r.gs.trxdir.write_udword(data);
+        start_transmission();
+        break;
+    }
+    case GsRegisterAddress::HWREG:
+    {
+        const GsRegisterWrite write = {address, data};
+        write_hwreg(&write, 1);
+        break;
+    }
+    case GsRegisterAddress::SIGNAL:
+    {
+        r.gs.signal.write_udword(data);
+        const udword mask = GsRegister_Signal::IDMSK.extract_from(data);
+        const udword id = GsRegister_Signal::ID.extract_from(data);
+        const udword sigid = r.gs.siglblid.extract_field(GsRegister_Siglblid::SIGID);
+        r.gs.siglblid.insert_field(GsRegister_Siglblid::SIGID, (sigid & ~mask) | (id & mask));
+        raise_event(GsRegister_Csr::SIGNAL, GsRegister_Imr::SIGMSK);
+        break;
+    }
+    case GsRegisterAddress::FINISH:
+    {
+        // Raised once all drawing before it has completed.
+        r.gs.finish.write_udword(data);
+        rasterizer->flush();
+        raise_event(GsRegister_Csr::FINISH, GsRegister_Imr::FINISHMSK);
+        break;
+    }
+    case GsRegisterAddress::LABEL:
+    {
+        r.gs.label.write_udword(data);
+        const udword mask = GsRegister_Signal::IDMSK.extract_from(data);
+        const udword id = GsRegister_Signal::ID.extract_from(data);
+        const udword lblid = r.gs.siglblid.extract_field(GsRegister_Siglblid::LBLID);
+        r.gs.siglblid.insert_field(GsRegister_Siglblid::LBLID, (lblid & ~mask) | (id & mask));
+        break;
+    }
+    default:
+    {
+        // Unused addresses (and NOP) are ignored.
+        break;
+    }
+    }
+}
+
+void CGsCore::kick_vertex(const udword xyz, const ubyte f, const bool drawing_kick)
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    const udword type = r.gs.prim.extract_field(GsRegister_Prim::PRIM);
+    const int needed_vertices = PRIMITIVE_VERTICES[type];
+    if (!needed_vertices)
+        return;
+
+    GsVertexRegisters& vertex = state.vertices[state.number_vertices++];
+    vertex.xyz = xyz;
+    vertex.rgbaq = r.gs.rgbaq.read_udword();
+    vertex.st = r.gs.st.read_udword();
+    vertex.uv = r.gs.uv.read_udword();
+    vertex.f = f;
+
+    if (state.number_vertices < needed_vertices)
+        return;
+
+    if (drawing_kick)
+        draw_primitive(type);
+
+    // Keep the vertices shared with the next primitive for strips and fans.
+    switch (type)
+    {
+    case GsRegister_Prim::LINE_STRIP:
+        state.vertices[0] = state.vertices[1];
+        state.number_vertices = 1;
+        break;
+    case GsRegister_Prim::TRIANGLE_STRIP:
+        state.vertices[0] = state.vertices[1];
+        state.vertices[1] = state.vertices[2];
+        state.number_vertices = 2;
+        break;
+    case GsRegister_Prim::TRIANGLE_FAN:
+        state.vertices[1] = state.vertices[2];
+        state.number_vertices = 2;
+        break;
+    default:
+        state.number_vertices = 0;
+        break;
+    }
+}
+
+void CGsCore::draw_primitive(const udword type)
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    if (is_draw_state_dirty)
+        update_draw_state();
+
+    const udword attributes = r.gs.prmodecont.extract_field(GsRegister_Prmodecont::AC) ? r.gs.prim.read_udword() : r.gs.prmode.read_udword();
+    GsContext& context = r.gs.contexts[GsRegister_Prim::CTXT.extract_from(attributes)];
+
+    GsVertex vertices[3];
+    for (int i = 0; i < state.number_vertices; i++)
+        vertices[i] = make_vertex(state.vertices[i], context, draw_state.fst);
+
+    switch (type)
+    {
+    case GsRegister_Prim::POINT:
+        rasterizer->add_point(vertices[0]);
+        break;
+    case GsRegister_Prim::LINE:
+    case GsRegister_Prim::LINE_STRIP:
+        rasterizer->add_line(vertices[0], vertices[1]);
+        break;
+    case GsRegister_Prim::TRIANGLE:
+    case GsRegister_Prim::TRIANGLE_STRIP:
+    case GsRegister_Prim::TRIANGLE_FAN:
+        rasterizer->add_triangle(vertices[0], vertices[1], vertices[2]);
+        break;
+    case GsRegister_Prim::SPRITE:
+        rasterizer->add_sprite(vertices[0], vertices[1]);
+        break;
+    default:
+        break;
+    }
+}
+
+GsVertex CGsCore::make_vertex(const GsVertexRegisters& vertex, GsContext& context, const bool fst)
+{
+    GsVertex result;
+
+    // Window coordinates (12.4 fixed point).
+    const udword xyoffset = context.xyoffset.read_udword();
+    const sword offset_x = static_cast<sword>(GsRegister_Xyoffset::OFX.extract_from(xyoffset));
+    const sword offset_y = static_cast<sword>(GsRegister_Xyoffset::OFY.extract_from(xyoffset));
+    result.x = static_cast<sword>(GsRegister_Xyz::X.extract_from(vertex.xyz)) - offset_x;
+    result.y = static_cast<sword>(GsRegister_Xyz::Y.extract_from(vertex.xyz)) - offset_y;
+    result.z = static_cast<double>(GsRegister_Xyz::Z.extract_from(vertex.xyz));
+
+    result.attributes[GsPixelPipeline::ATTR_R] = static_cast<float>(GsRegister_Rgbaq::R.extract_from(vertex.rgbaq));
+    result.attributes[GsPixelPipeline::ATTR_G] = static_cast<float>(GsRegister_Rgbaq::G.extract_from(vertex.rgbaq));
+    result.attributes[GsPixelPipeline::ATTR_B] = static_cast<float>(GsRegister_Rgbaq::B.extract_from(vertex.rgbaq));
+    result.attributes[GsPixelPipeline::ATTR_A] = static_cast<float>(GsRegister_Rgbaq::A.extract_from(vertex.rgbaq));
+    result.attributes[GsPixelPipeline::ATTR_F] = static_cast<float>(vertex.f);
+
+    if (fst)
+    {
+        result.attributes[GsPixelPipeline::ATTR_S] = static_cast<float>(GsRegister_Uv::U.extract_from(vertex.uv)) / 16.0f;
+        result.attributes[GsPixelPipeline::ATTR_T] = static_cast<float>(GsRegister_Uv::V.extract_from(vertex.uv)) / 16.0f;
+        result.attributes[GsPixelPipeline::ATTR_Q] = 1.0f;
+    }
+    else
+    {
+        result.attributes[GsPixelPipeline::ATTR_S] = to_f32(static_cast<uword>(GsRegister_St::S.extract_from(vertex.st)));
+        result.attributes[GsPixelPipeline::ATTR_T] = to_f32(static_cast<uword>(GsRegister_St::T.extract_from(vertex.st)));
+        result.attributes[GsPixelPipeline::ATTR_Q] = to_f32(static_cast<uword>(GsRegister_Rgbaq::Q.extract_from(vertex.rgbaq)));
+    }
+
+    return result;
+}
+
+void CGsCore::update_draw_state()
+{
+    auto& r = core->get_resources();
+
+    const udword attributes = r.gs.prmodecont.extract_field(GsRegister_Prmodecont::AC) ? r.gs.prim.read_udword() : r.gs.prmode.read_udword();
+    GsContext& context = r.gs.contexts[GsRegister_Prim::CTXT.extract_from(attributes)];
+
+    GsDrawState state;
+    state.iip = GsRegister_Prim::IIP.extract_from(attributes);
+    state.tme = GsRegister_Prim::TME.extract_from(attributes);
+    state.fge = GsRegister_Prim::FGE.extract_from(attributes);
+    state.abe = GsRegister_Prim::ABE.extract_from(attributes);
+    state.fst = GsRegister_Prim::FST.extract_from(attributes);
+
+    // FBP and ZBP are in units of 2048 words (32 blocks).
+    state.fbp = static_cast<uword>(context.frame.extract_field(GsRegister_Frame::FBP)) * 32;
+    state.fbw = static_cast<uword>(context.frame.extract_field(GsRegister_Frame::FBW));
+    state.fpsm = static_cast<uword>(context.frame.extract_field(GsRegister_Frame::PSM));
+    state.fbmsk = static_cast<uword>(context.frame.extract_field(GsRegister_Frame::FBMSK));
+    state.zbp = static_cast<uword>(context.zbuf.extract_field(GsRegister_Zbuf::ZBP)) * 32;
+    state.zpsm = GsLocalMemory::PSMZ32 | static_cast<uword>(context.zbuf.extract_field(GsRegister_Zbuf::PSM));
+    state.zmsk = context.zbuf.extract_field(GsRegister_Zbuf::ZMSK);
+
+    state.ate = context.test.extract_field(GsRegister_Test::ATE);
+    state.atst = static_cast<uword>(context.test.extract_field(GsRegister_Test::ATST));
+    state.aref = static_cast<uword>(context.test.extract_field(GsRegister_Test::AREF));
+    state.afail = static_cast<uword>(context.test.extract_field(GsRegister_Test::AFAIL));
+    state.date = context.test.extract_field(GsRegister_Test::DATE);
+    state.datm = context.test.extract_field(GsRegister_Test::DATM);
+    state.zte = context.test.extract_field(GsRegister_Test::ZTE);
+    state.ztst = static_cast<uword>(context.test.extract_field(GsRegister_Test::ZTST));
+
+    state.alpha_a = static_cast<uword>(context.alpha.extract_field(GsRegister_Alpha::A));
+    state.alpha_b = static_cast<uword>(context.alpha.extract_field(GsRegister_Alpha::B));
+    state.alpha_c = static_cast<uword>(context.alpha.extract_field(GsRegister_Alpha::C));
+    state.alpha_d = static_cast<uword>(context.alpha.extract_field(GsRegister_Alpha::D));
+    state.alpha_fix = static_cast<uword>(context.alpha.extract_field(GsRegister_Alpha::FIX));
+    state.pabe = r.gs.pabe.extract_field(GsRegister_Enable::ENABLE);
+    state.colclamp = r.gs.colclamp.extract_field(GsRegister_Enable::ENABLE);
+    state.fba = context.fba.extract_field(GsRegister_Enable::ENABLE);
+
+    state.scissor_x0 = static_cast<int>(context.scissor.extract_field(GsRegister_Scissor::SCAX0));
+    state.scissor_x1 = static_cast<int>(context.scissor.extract_field(GsRegister_Scissor::SCAX1));
+    state.scissor_y0 = static_cast<int>(context.scissor.extract_field(GsRegister_Scissor::SCAY0));
+    state.scissor_y1 = static_cast<int>(context.scissor.extract_field(GsRegister_Scissor::SCAY1));
+
+    state.tbp0 = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::TBP0));
+    state.tbw = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::TBW));
+    state.tpsm = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::PSM));
+    state.tw = std::min<uword>(static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::TW)), 10);
+    state.th = std::min<uword>(static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::TH)), 10);
+    state.tcc = context.tex0.extract_field(GsRegister_Tex0::TCC);
+    state.tfx = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::TFX));
+    state.cpsm = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::CPSM));
+
+    // K is signed 7.4 fixed point.
+    state.lcm = context.tex1.extract_field(GsRegister_Tex1::LCM);
+    state.mxl = std::min<uword>(static_cast<uword>(context.tex1.extract_field(GsRegister_Tex1::MXL)), GsDrawState::MAX_MIPMAP_LEVEL);
+    state.mmag_linear = context.tex1.extract_field(GsRegister_Tex1::MMAG);
+    state.mmin = static_cast<uword>(context.tex1.extract_field(GsRegister_Tex1::MMIN));
+    state.l = static_cast<uword>(context.tex1.extract_field(GsRegister_Tex1::L));
+    state.k = static_cast<float>(static_cast<sword>(static_cast<uword>(context.tex1.extract_field(GsRegister_Tex1::K)) << 20) >> 20) / 16.0f;
+
+    // Mipmap levels. With MTBA set, levels 1 -> 3 follow on from the base
+    // texture in memory, each half the size (and width) of the last.
+    const Bitfield miptbp_tbp[3] = {GsRegister_Miptbp::TBP1, GsRegister_Miptbp::TBP2, GsRegister_Miptbp::TBP3};
+    const Bitfield miptbp_tbw[3] = {GsRegister_Miptbp::TBW1, GsRegister_Miptbp::TBW2, GsRegister_Miptbp::TBW3};
+    for (int i = 0; i < 3; i++)
+    {
+        state.mip_tbp[i] = static_cast<uword>(context.miptbp1.extract_field(miptbp_tbp[i]));
+        state.mip_tbw[i] = static_cast<uword>(context.miptbp1.extract_field(miptbp_tbw[i]));
+        state.mip_tbp[i + 3] = static_cast<uword>(context.miptbp2.extract_field(miptbp_tbp[i]));
+        state.mip_tbw[i + 3] = static_cast<uword>(context.miptbp2.extract_field(miptbp_tbw[i]));
+    }
+    if (context.tex1.extract_field(GsRegister_Tex1::MTBA))
+    {
+        uword tbp = state.tbp0;
+        uword tbw = state.tbw;
+        uword tw = state.tw;
+        uword th = state.th;
+        for (int i = 0; i < 3; i++)
+        {
+            // Level sizes are in bytes, the base pointers in blocks (256 bytes).
+            tbp += ((1u << tw) * (1u << th) * texel_storage_bits(state.tpsm) / 8) / 256;
+            tbw = (tbw > 1) ? (tbw / 2) : tbw;
+            tw = (tw > 0) ? (tw - 1) : 0;
+            th = (th > 0) ? (th - 1) : 0;
+            state.mip_tbp[i] = tbp;
+            state.mip_tbw[i] = tbw;
+        }
+    }
+
+    state.wms = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::WMS));
+    state.wmt = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::WMT));
+    state.minu = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::MINU));
+    state.maxu = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::MAXU));
+    state.minv = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::MINV));
+    state.maxv = static_cast<uword>(context.clamp.extract_field(GsRegister_Clamp::MAXV));
+
+    state.ta0 = static_cast<uword>(r.gs.texa.extract_field(GsRegister_Texa::TA0));
+    state.ta1 = static_cast<uword>(r.gs.texa.extract_field(GsRegister_Texa::TA1));
+    state.aem = r.gs.texa.extract_field(GsRegister_Texa::AEM);
+    state.fogcol = static_cast<uword>(r.gs.fogcol.read_udword() & 0xFFFFFF);
+
+    // CLUT entries used by the texture (CSA selects 16 of them for 4-bit textures).
+    std::fill(std::begin(state.clut), std::end(state.clut), 0);
+    if (is_8bit_indexed(state.tpsm))
+    {
+        std::copy(r.gs.core_state.clut, r.gs.core_state.clut + 256, state.clut);
+    }
+    else if (is_4bit_indexed(state.tpsm))
+    {
+        const uword csa = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::CSA));
+        const uword offset = ((state.cpsm == GsLocalMemory::PSMCT32) ? (csa & 0xF) : csa) * 16;
+        std::copy(r.gs.core_state.clut + offset, r.gs.core_state.clut + offset + 16, state.clut);
+    }
+
+    // Primitives pending may only draw to one frame/Z buffer layout (see GsRasterizer).
+    if (state.fbp != draw_state.fbp || state.fbw != draw_state.fbw || state.fpsm != draw_state.fpsm
+        || state.zbp != draw_state.zbp || state.zpsm != draw_state.zpsm)
+        rasterizer->flush();
+
+    draw_state = state;
+    rasterizer->set_draw_state(draw_state);
+    is_draw_state_dirty = false;
+}
+
+void CGsCore::load_clut(GsContext& context)
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    const uword cbp = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::CBP));
+    bool load = false;
+    switch (context.tex0.extract_field(GsRegister_Tex0::CLD))
+    {
+    case 1:
+        load = true;
+        break;
+    case 2:
+        load = true;
+        state.clut_cbp0 = cbp;
+        break;
+    case 3:
+        load = true;
+        state.clut_cbp1 = cbp;
+        break;
+    case 4:
+        load = (cbp != state.clut_cbp0);
+        state.clut_cbp0 = cbp;
+        break;
+    case 5:
+        load = (cbp != state.clut_cbp1);
+        state.clut_cbp1 = cbp;
+        break;
+    default:
+        break;
+    }
+
+    const uword psm = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::PSM));
+    if (!load || !(is_4bit_indexed(psm) || is_8bit_indexed(psm)))
+        return;
+
+    // The CLUT may have just been drawn to.
+    rasterizer->flush();
+
+    const uword cpsm = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::CPSM));
+    const uword csa = static_cast<uword>(context.tex0.extract_field(GsRegister_Tex0::CSA));
+    const bool csm2 = context.tex0.extract_field(GsRegister_Tex0::CSM);
+    const bool is_4bit = is_4bit_indexed(psm);
+    const int number_entries = is_4bit ? 16 : 256;
+    const uword offset = is_4bit ? (((cpsm == GsLocalMemory::PSMCT32) ? (csa & 0xF) : csa) * 16) : 0;
+
+    for (int i = 0; i < number_entries; i++)
+    {
+        // CSM1 arranges the entries in 8x2 pixel blocks (16x16 pixels for 256 entries,
+        // with the rows of 16 entries swapped in the middle), CSM2 arranges them in a line.
+        uword x, y, bw;
+        if (csm2)
+        {
+            x = static_cast<uword>(r.gs.texclut.extract_field(GsRegister_Texclut::COU)) * 16 + i;
+            y = static_cast<uword>(r.gs.texclut.extract_field(GsRegister_Texclut::COV));
+            bw = static_cast<uword>(r.gs.texclut.extract_field(GsRegister_Texclut::CBW));
+        }
+        else
+        {
+            x = (i & 0x7) + ((i & 0x10) ? 8 : 0);
+            y = ((i >> 3) & 0x1) + (i >> 5) * 2;
+            bw = 1;
+        }
+
+        state.clut[offset + i] = r.gs.memory.read_pixel(cpsm, cbp, bw, x, y);
+    }
+}
+
+void CGsCore::start_transmission()
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    // Finish off a previous host -> local transmission which didn't get all of its data.
+    if (state.transfer_active)
+        write_transmission_rows(true);
+
+    state.transfer_active = false;
+    state.readback_active = false;
+    state.transfer_buffer.clear();
+    switch (r.gs.trxdir.extract_field(GsRegister_Trxdir::XDIR))
+    {
+    case GsRegister_Trxdir::HOST_TO_LOCAL:
+    {
+        // The destination may have been drawn to, or be used by pending primitives.
+        rasterizer->flush();
+        const uword dpsm = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DPSM));
+        state.transfer_active = GsLocalMemory::transfer_bits_per_pixel(dpsm)
+                                && r.gs.trxreg.extract_field(GsRegister_Trxreg::RRW)
+                                && r.gs.trxreg.extract_field(GsRegister_Trxreg::RRH);
+        state.transfer_y = 0;
+        break;
+    }
+    case GsRegister_Trxdir::LOCAL_TO_LOCAL:
+    {
+        rasterizer->flush();
+        transmit_local_to_local();
+        break;
+    }
+    case GsRegister_Trxdir::LOCAL_TO_HOST:
+    {
+        rasterizer->flush();
+        start_readback();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void CGsCore::write_hwreg(const GsRegisterWrite* writes, const size_t count)
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    r.gs.hwreg.write_udword(writes[count - 1].data);
+    if (!state.transfer_active)
+        return;
+
+    const size_t offset = state.transfer_buffer.size();
+    state.transfer_buffer.resize(offset + count * NUMBER_BYTES_IN_DWORD);
+    for (size_t i = 0; i < count; i++)
+        std::memcpy(state.transfer_buffer.data() + offset + i * NUMBER_BYTES_IN_DWORD, &writes[i].data, NUMBER_BYTES_IN_DWORD);
+    write_transmission_rows(false);
+}
+
+void CGsCore::write_transmission_rows(const bool is_final)
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    const uword dbp = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DBP));
+    const uword dbw = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DBW));
+    const uword dpsm = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DPSM));
+    const uword dsax = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::DSAX));
+    const uword dsay = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::DSAY));
+    const uword width = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRW));
+    const uword height = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRH));
+    const int bits = GsLocalMemory::transfer_bits_per_pixel(dpsm);
+    const size_t row_bits = static_cast<size_t>(width) * bits;
+
+    const uword rows_remaining = height - state.transfer_y;
+    uword rows = static_cast<uword>(std::min<size_t>(state.transfer_buffer.size() * 8 / row_bits, rows_remaining));
+    if (rows < rows_remaining && !is_final)
+    {
+        uword block_width, block_height;
+        GsLocalMemory::get_block_size(dpsm, block_width, block_height);
+        const uword past_boundary = (dsay + state.transfer_y + rows) % block_height;
+        rows = (rows > past_boundary) ? (rows - past_boundary) : 0;
+    }
+
+    // Keep the rows byte aligned within the buffer (4-bit formats with odd widths).
+    if (row_bits % 8)
+        rows &= ~1;
+
+    if (rows)
+    {
+        r.gs.memory.write_pixels(dpsm, dbp, dbw, dsax, (dsay + state.transfer_y) & 0x7FF, width, rows, state.transfer_buffer.data());
+        state.transfer_buffer.erase(state.transfer_buffer.begin(), state.transfer_buffer.begin() + (rows * row_bits) / 8);
+        state.transfer_y += rows;
+    }
+
+    if (state.transfer_y >= height)
+    {
+        // Anything past the end is padding.
+        state.transfer_active = false;
+        state.transfer_buffer.clear();
+    }
+    else if (is_final)
+    {
+        // The pixels of the last (incomplete) row, and any odd row left over above.
+        size_t pixels = std::min<size_t>(state.transfer_buffer.size() * 8 / bits, static_cast<size_t>(width) * 2);
+        const uword y = (dsay + state.transfer_y) & 0x7FF;
+        const uword first_row_pixels = static_cast<uword>(std::min<size_t>(pixels, width));
+        r.gs.memory.write_pixels(dpsm, dbp, dbw, dsax, y, first_row_pixels, 1, state.transfer_buffer.data());
+        if (pixels > width && (state.transfer_y + 1) < height)
+        {
+            std::vector<ubyte> row(state.transfer_buffer.begin() + (row_bits / 8), state.transfer_buffer.end());
+            if (row_bits % 8)
+            {
+                // The second row starts half way through a byte.
+                for (size_t i = 0; i + 1 < state.transfer_buffer.size() - (row_bits / 8); i++)
+                    row[i] = static_cast<ubyte>((row[i] >> 4) | (row[i + 1] << 4));
+                row.back() >>= 4;
+            }
+            r.gs.memory.write_pixels(dpsm, dbp, dbw, dsax, (y + 1) & 0x7FF, static_cast<uword>(pixels - width), 1, row.data());
+        }
+        state.transfer_active = false;
+        state.transfer_buffer.clear();
+    }
+}
+
+void CGsCore::transmit_local_to_local()
+{
+    auto& r = core->get_resources();
+
+    const uword sbp = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SBP));
+    const uword sbw = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SBW));
+    const uword spsm = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SPSM));
+    const uword dbp = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DBP));
+    const uword dbw = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DBW));
+    const uword dpsm = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::DPSM));
+    const uword ssax = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::SSAX));
+    const uword ssay = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::SSAY));
+    const uword dsax = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::DSAX));
+    const uword dsay = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::DSAY));
+    const uword width = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRW));
+    const uword height = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRH));
+
+    // Read everything first, so overlapping areas copy as a whole (regardless of TRXPOS.DIR).
+    // Formats with the same transfer size can go through the bulk transfer functions.
+    const int bits = GsLocalMemory::transfer_bits_per_pixel(spsm);
+    if (bits && bits == GsLocalMemory::transfer_bits_per_pixel(dpsm))
+    {
+        std::vector<ubyte> data((static_cast<size_t>(width) * height * bits + 7) / 8);
+        r.gs.memory.read_pixels(spsm, sbp, sbw, ssax, ssay, width, height, data.data());
+        r.gs.memory.write_pixels(dpsm, dbp, dbw, dsax, dsay, width, height, data.data());
+        return;
+    }
+
+    std::vector<uword> pixels(width * height);
+    for (uword y = 0; y < height; y++)
+        for (uword x = 0; x < width; x++)
+            pixels[y * width + x] = r.gs.memory.read_pixel(spsm, sbp, sbw, (ssax + x) & 0x7FF, (ssay + y) & 0x7FF);
+
+    for (uword y = 0; y < height; y++)
+        for (uword x = 0; x < width; x++)
+            r.gs.memory.write_pixel(dpsm, dbp, dbw, (dsax + x) & 0x7FF, (dsay + y) & 0x7FF, pixels[y * width + x]);
+}
+
+void CGsCore::start_readback()
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    const uword sbp = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SBP));
+    const uword sbw = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SBW));
+    const uword spsm = static_cast<uword>(r.gs.bitbltbuf.extract_field(GsRegister_Bitbltbuf::SPSM));
+    const uword ssax = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::SSAX));
+    const uword ssay = static_cast<uword>(r.gs.trxpos.extract_field(GsRegister_Trxpos::SSAY));
+    const uword width = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRW));
+    const uword height = static_cast<uword>(r.gs.trxreg.extract_field(GsRegister_Trxreg::RRH));
+    const int bits = GsLocalMemory::transfer_bits_per_pixel(spsm);
+
+    // The data is sent in whole qwords, padded at the end.
+    const size_t size = (static_cast<size_t>(width) * height * bits + 7) / 8;
+    state.transfer_buffer.assign((size + NUMBER_BYTES_IN_QWORD - 1) & ~static_cast<size_t>(NUMBER_BYTES_IN_QWORD - 1), 0);
+    r.gs.memory.read_pixels(spsm, sbp, sbw, ssax, ssay, width, height, state.transfer_buffer.data());
+    state.transfer_buffer_position = 0;
+    state.readback_active = !state.transfer_buffer.empty();
+}
+
+void CGsCore::send_readback()
+{
+    auto& r = core->get_resources();
+    auto& state = r.gs.core_state;
+
+    // The data goes out through the VIF1 FIFO to the DMAC (channel 1, from
+    // memory direction), once the host has switched VIF1 around (STAT.FDR).
+    if (!r.ee.vpu.vif.unit_1.stat.extract_field(VifUnitRegister_Stat::FDR))
+        return;
+
+    while (state.transfer_buffer_position < state.transfer_buffer.size() && r.fifo_vif1.has_write_available(NUMBER_BYTES_IN_QWORD))
+    {
+        r.fifo_vif1.write(state.transfer_buffer.data() + state.transfer_buffer_position, NUMBER_BYTES_IN_QWORD);
+        state.transfer_buffer_position += NUMBER_BYTES_IN_QWORD;
+    }
+
+    if (state.transfer_buffer_position >= state.transfer_buffer.size())
+    {
+        state.readback_active = false;
+        state.transfer_buffer.clear();
+    }
+}
+
+void CGsCore::raise_event(const Bitfield csr_field, const Bitfield imr_field)
+{
+    auto& r = core->get_resources();
+
+    {
+        auto _lock = r.gs.csr.scope_lock();
+        r.gs.csr.insert_field(csr_field, 1);
+    }
+
+    if (!r.gs.imr.extract_field(imr_field))
+    {
+        auto _lock = r.ee.intc.stat.scope_lock();
+        r.ee.intc.stat.insert_field(EeIntcRegister_Stat::GS, 1);
+    }
+}
+
+void CGsCore::start_gs_thread()
+{
+    if (!core->get_options().gs_thread || gs_thread.joinable())
+        return;
+
+    core->get_resources().gs.command_ring.is_asynchronous.store(true, std::memory_order_release);
+    gs_thread = std::thread(std::bind(&CGsCore::gs_thread_main, this));
+}
+
+void CGsCore::stop_gs_thread()
+{
+    if (!gs_thread.joinable())
+        return;
+
+    auto& ring = core->get_resources().gs.command_ring;
+    ring.request_exit();
+    gs_thread.join();
+    ring.is_asynchronous.store(false, std::memory_order_release);
+}
+
+void CGsCore::gs_thread_main()
+{
+    auto& r = core->get_resources();
+    auto& ring = r.gs.command_ring;
+
+    GsRegisterWriteBatch batch;
+    while (!ring.is_exit_requested())
+    {
+        try
+        {
+            if (!ring.try_pop(batch))
+            {
+                // Out of work: make everything drawn visible before
+                // reporting the batches as completed, then wait for more.
+                rasterizer->flush();
+                ring.complete();
+                ring.wait_for_batch();
+                continue;
+            }
+
+            write_registers(batch.writes, batch.number_writes);
+
+            if (r.gs.core_state.readback_active)
+            {
+                ring.park();
+            }
+            else if (ring.is_sync_requested())
+            {
+                rasterizer->flush();
+                ring.complete();
+            }
+        }
+        catch (const std::exception& error)
+        {
+            // Add exception to the queue for the controller to deal with, and
+            // complete the batches so nothing waits on them forever.
+            std::string error_str(error.what());
+            gs_thread_error_queue.push(error_str);
+            ring.complete();
+        }
+    }
+}
@@ -1,16 +1,103 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <Queues.hpp>
+
+#include "Common/Types/Bitfield.hpp"
 #include "Controller/CController.hpp"
+#include "Controller/Gs/Core/GsRasterizer.hpp"
+#include "Resources/Gs/RGs.hpp"
 
+/// The GS core, which processes the general register writes sent by the GIF
+/// (see RGs::command_ring): drawing primitives through the software
+/// rasterizer, host <-> local and local -> local transmissions, and events.
+/// Drawing is deferred (batched) by the rasterizer until a flush, which
+/// happens at the end of each time slice, or before anything else needs to
+/// access the local memory.
+/// When enabled (see CoreOptions::gs_thread), the register writes are
+/// processed by a dedicated GS thread instead of in step with the controller,
+/// which flushes whenever it runs out of work, see GsCommandRing.
 class CGsCore : public CController
 {
 public:
     CGsCore(Core* core);
+    ~CGsCore();
 
     void handle_event(const ControllerEvent& event) override;
 
     /// Converts a time duration into the number of ticks that would have occurred.
     int time_to_ticks(const double time_us);
 
+    /// Processes the register write batches sent by the GIF, one write per tick.
     int time_step(const int ticks_available);
+
+    /// Writes a batch of general registers in order.
+    void write_registers(const GsRegisterWrite* writes, const size_t count);
+
+    /// Writes a general register, performing any associated action.
+    void write_register(const ubyte address, const udword data);
+
+    /// Adds a vertex to the vertex queue, drawing the primitive (when
+    /// drawing_kick is set) once there are enough vertices for it.
+    /// The Z value of xyz is already extracted (see XYZF2/3 vs XYZ2/3).
+    void kick_vertex(const udword xyz, const ubyte f, const bool drawing_kick);
+
+    /// Sets up and adds the primitive of the vertices in the queue to the rasterizer.
+    void draw_primitive(const udword type);
+
+    /// Converts the latched vertex registers to a rasterizer vertex.
+    GsVertex make_vertex(const GsVertexRegisters& vertex, GsContext& context, const bool fst);
+
+    /// Builds the draw state from the registers and sets it on the rasterizer.
+    /// Flushes the rasterizer first if the frame or Z buffer changed.
+    void update_draw_state();
+
+    /// Loads the CLUT buffer after a TEX0/TEX2 write, according to TEX0.CLD.
+    /// See GS Users Manual page 33.
+    void load_clut(GsContext& context);
+
+    /// Transmission functions (TRXDIR, HWREG). Consecutive HWREG writes (IMAGE
+    /// data) are appended to the transmission buffer together.
+    void start_transmission();
+    void write_hwreg(const GsRegisterWrite* writes, const size_t count);
+    void transmit_local_to_local();
+    void start_readback();
+
+    /// Writes the buffered host -> local transmission rows to memory. Rows
+    /// are held back until they reach a block boundary (so the next write
+    /// starts on one), unless is_final is set, which also writes any partial
+    /// row and ends the transmission.
+    void write_transmission_rows(const bool is_final);
+
+    /// Sends the local -> host transmission data to the VIF1 FIFO, as far as
+    /// there is space for it. See start_readback().
+    void send_readback();
+
+    /// Sets the CSR event bit, and raises the GS interrupt if not masked by IMR.
+    void raise_event(const Bitfield csr_field, const Bitfield imr_field);
+
+    /// Starts the GS thread, if it is enabled and not already running.
+    /// This is done on the first event, like the VU1 thread.
+    void start_gs_thread();
+    void stop_gs_thread();
+
+    /// GS thread entry point, processes the register write batches as they
+    /// arrive. Parks while a local -> host transmission is sent out by the
+    /// controller (see handle_event()), as that needs the VIF1 FIFO.
+    void gs_thread_main();
+
+private:
+    std::unique_ptr<GsRasterizer> rasterizer;
+
+    /// GS thread, and the errors raised on it (rethrown by the controller).
+    std::thread gs_thread;
+    MpscQueue<std::string, 32> gs_thread_error_queue;
+
+    /// Set when a drawing environment register has changed since the draw
+    /// state was last built, and the frame/Z buffer layout of that state.
+    bool is_draw_state_dirty;
+    GsDrawState draw_state;
 };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+
+#include "Common/Types/Primitive.hpp"
+
+/// A decoded snapshot of the GS drawing environment, taken when a primitive
+/// is kicked (only rebuilt after the environment registers have changed).
+/// Primitives reference the snapshot they were drawn with, so the registers
+/// can keep changing while the rasterizer has primitives pending.
+/// All buffer base pointers are in units of blocks (64 words), and buffer
+/// widths in units of 64 pixels, see GsLocalMemory.
+struct GsDrawState
+{
+    /// PRIM (or PRMODE when PRMODECONT.AC = 0) attributes.
+    bool iip;
+    bool tme;
+    bool fge;
+    bool abe;
+    bool fst;
+
+    /// FRAME.
+    uword fbp;
+    uword fbw;
+    uword fpsm;
+    uword fbmsk;
+
+    /// ZBUF (the PSM has the Z bits set, ie: PSMZ32).
+    uword zbp;
+    uword zpsm;
+    bool zmsk;
+
+    /// TEST.
+    bool ate;
+    uword atst;
+    uword aref;
+    uword afail;
+    bool date;
+    bool datm;
+    bool zte;
+    uword ztst;
+
+    /// ALPHA, PABE, COLCLAMP and FBA.
+    uword alpha_a;
+    uword alpha_b;
+    uword alpha_c;
+    uword alpha_d;
+    uword alpha_fix;
+    bool pabe;
+    bool colclamp;
+    bool fba;
+
+    /// SCISSOR (inclusive window coordinates).
+    int scissor_x0;
+    int scissor_x1;
+    int scissor_y0;
+    int scissor_y1;
+
+    /// TEX0 (TW/TH are log2 of the texture size).
+    uword tbp0;
+    uword tbw;
+    uword tpsm;
+    uword tw;
+    uword th;
+    bool tcc;
+    uword tfx;
+    uword cpsm;
+
+    /// TEX1 filter and LOD settings (MXL is at most MAX_MIPMAP_LEVEL).
+    bool lcm;
+    uword mxl;
+    bool mmag_linear;
+    uword mmin;
+    uword l;
+    float k;
+
+    /// Base pointer and width of the mipmap levels 1 -> MXL, from MIPTBP1/2
+    /// (or laid out after the base texture when TEX1.MTBA = 1).
+    static constexpr int MAX_MIPMAP_LEVEL = 6;
+    uword mip_tbp[MAX_MIPMAP_LEVEL];
+    uword mip_tbw[MAX_MIPMAP_LEVEL];
+
+    /// CLAMP.
+    uword wms;
+    uword wmt;
+    uword minu;
+    uword maxu;
+    uword minv;
+    uword maxv;
+
+    /// TEXA.
+    uword ta0;
+    uword ta1;
+    bool aem;
+
+    /// FOGCOL (RGB packed as in RGBAQ).
+    uword fogcol;
+
+    /// CLUT entries used by an indexed texture (TEX0.CSA applied for 4-bit),
+    /// in the CLUT PSM format.
+    uword clut[256];
+
+    /// Returns the LOD of a pixel with the given Q: K when LCM = 1, otherwise
+    /// K + log2(1/|Q|) * 2^L. The magnification filter (MMAG) is used when
+    /// the LOD is 0 or less, and the minification filter (MMIN) otherwise.
+    /// See GS Users Manual page 117.
+    float get_lod(const float q) const
+    {
+        if (lcm)
+            return k;
+        return k - std::log2(std::fabs(q) > 0.0f ? std::fabs(q) : 1.0f) * static_cast<float>(1 << l);
+    }
+};
@@ -0,0 +1,458 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Controller/Gs/Core/GsPixelPipeline.hpp"
+
+namespace
+{
+int clamp_colour(const int value)
+{
+    return std::min(std::max(value, 0), 255);
+}
+
+/// Returns if the buffer format stores 16-bit pixels (CT16, CT16S, Z16, Z16S).
+bool is_16bit(const uword psm)
+{
+    return (psm & 0x2) != 0;
+}
+
+/// Returns if the buffer format stores 24-bit pixels in words (CT24, Z24).
+bool is_24bit(const uword psm)
+{
+    return (psm & 0xF) == 0x1;
+}
+
+/// Returns the word (32-bit formats) or hword (16-bit formats) address of a
+/// frame or Z buffer pixel.
+uword buffer_address(const uword psm, const uword bp, const uword bw, const uword x, const uword y)
+{
+    switch (psm)
+    {
+    case GsLocalMemory::PSMZ32:
+    case GsLocalMemory::PSMZ24:
+        return GsLocalMemory::address_32z(bp, bw, x, y);
+    case GsLocalMemory::PSMCT16:
+        return GsLocalMemory::address_16(GsSwizzle::PAGE_TABLE_16, bp, bw, x, y);
+    case GsLocalMemory::PSMCT16S:
+        return GsLocalMemory::address_16(GsSwizzle::PAGE_TABLE_16S, bp, bw, x, y);
+    case GsLocalMemory::PSMZ16:
+        return GsLocalMemory::address_16(GsSwizzle::PAGE_TABLE_16Z, bp, bw, x, y);
+    case GsLocalMemory::PSMZ16S:
+        return GsLocalMemory::address_16(GsSwizzle::PAGE_TABLE_16SZ, bp, bw, x, y);
+    default:
+        return GsLocalMemory::address_32(bp, bw, x, y);
+    }
+}
+
+/// Expands a 16-bit (RGBA5551) colour to 32-bit, with the alpha from TEXA.
+uword expand_16bit(const GsDrawState& state, const uword value)
+{
+    const uword r = (value & 0x1F) << 3;
+    const uword g = ((value >> 5) & 0x1F) << 3;
+    const uword b = ((value >> 10) & 0x1F) << 3;
+    uword a;
+    if (value & 0x8000)
+        a = state.ta1;
+    else
+        a = (state.aem && !(value & 0x7FFF)) ? 0 : state.ta0;
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+/// Expands a texture value of the texture format to 32-bit RGBA.
+uword expand_texel(const GsDrawState& state, const uword value)
+{
+    switch (state.tpsm)
+    {
+    case GsLocalMemory::PSMCT32:
+    case GsLocalMemory::PSMZ32:
+        return value;
+    case GsLocalMemory::PSMCT24:
+    case GsLocalMemory::PSMZ24:
+    {
+        const uword a = (state.aem && !value) ? 0 : state.ta0;
+        return value | (a << 24);
+    }
+    case GsLocalMemory::PSMCT16:
+    case GsLocalMemory::PSMCT16S:
+    case GsLocalMemory::PSMZ16:
+    case GsLocalMemory::PSMZ16S:
+        return expand_16bit(state, value);
+    default:
+    {
+        // Indexed formats (the value is at most 8 bits).
+        const uword entry = state.clut[value & 0xFF];
+        return (state.cpsm == GsLocalMemory::PSMCT32) ? entry : expand_16bit(state, entry);
+    }
+    }
+}
+
+/// Applies a texture wrap mode (CLAMP.WMS/WMT) to a texel coordinate.
+int wrap_coordinate(const int value, const uword mode, const int size, const uword min, const uword max)
+{
+    switch (mode)
+    {
+    case 0: // REPEAT.
+        return value & (size - 1);
+    case 1: // CLAMP.
+        return std::min(std::max(value, 0), size - 1);
+    case 2: // REGION_CLAMP.
+        return std::min(std::max(value, static_cast<int>(min)), static_cast<int>(max));
+    default: // REGION_REPEAT.
+        return (value & static_cast<int>(min)) | static_cast<int>(max);
+    }
+}
+
+bool alpha_test(const uword atst, const uword a, const uword aref)
+{
+    switch (atst)
+    {
+    case 0: // NEVER.
+        return false;
+    case 1: // ALWAYS.
+        return true;
+    case 2: // LESS.
+        return a < aref;
+    case 3: // LEQUAL.
+        return a <= aref;
+    case 4: // EQUAL.
+        return a == aref;
+    case 5: // GEQUAL.
+        return a >= aref;
+    case 6: // GREATER.
+        return a > aref;
+    default: // NOTEQUAL.
+        return a != aref;
+    }
+}
+} // namespace
+
+namespace GsPixelPipeline
+{
+TextureLevel get_texture_level(const GsDrawState& state, const int level)
+{
+    if (!level)
+        return {0, state.tbp0, state.tbw, state.tw, state.th};
+
+    const uword shift = static_cast<uword>(level);
+    return {level,
+            state.mip_tbp[level - 1],
+            state.mip_tbw[level - 1],
+            (state.tw > shift) ? (state.tw - shift) : 0,
+            (state.th > shift) ? (state.th - shift) : 0};
+}
+
+uword read_texel(GsLocalMemory& memory, const GsDrawState& state, const TextureLevel& texture, int u, int v)
+{
+    // The REGION_CLAMP bounds are given for the base texture.
+    const uword minu = (state.wms == 2) ? (state.minu >> texture.level) : state.minu;
+    const uword maxu = (state.wms == 2) ? (state.maxu >> texture.level) : state.maxu;
+    const uword minv = (state.wmt == 2) ? (state.minv >> texture.level) : state.minv;
+    const uword maxv = (state.wmt == 2) ? (state.maxv >> texture.level) : state.maxv;
+    u = wrap_coordinate(u, state.wms, 1 << texture.tw, minu, maxu);
+    v = wrap_coordinate(v, state.wmt, 1 << texture.th, minv, maxv);
+    return expand_texel(state, memory.read_pixel(state.tpsm, texture.tbp, texture.tbw, u, v));
+}
+
+uword sample_texture(GsLocalMemory& memory, const GsDrawState& state, const TextureLevel& texture, const float u, const float v, const bool bilinear)
+{
+    if (!bilinear)
+        return read_texel(memory, state, texture, static_cast<int>(std::floor(u)), static_cast<int>(std::floor(v)));
+
+    // Bilinear: blend the 4 nearest texels (texel centers are at +0.5).
+    const float u0 = u - 0.5f;
+    const float v0 = v - 0.5f;
+    const int iu = static_cast<int>(std::floor(u0));
+    const int iv = static_cast<int>(std::floor(v0));
+    const int fu = static_cast<int>((u0 - iu) * 256.0f);
+    const int fv = static_cast<int>((v0 - iv) * 256.0f);
+
+    const uword t00 = read_texel(memory, state, texture, iu, iv);
+    const uword t10 = read_texel(memory, state, texture, iu + 1, iv);
+    const uword t01 = read_texel(memory, state, texture, iu, iv + 1);
+    const uword t11 = read_texel(memory, state, texture, iu + 1, iv + 1);
+
+    uword result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const int c00 = (t00 >> shift) & 0xFF;
+        const int c10 = (t10 >> shift) & 0xFF;
+        const int c01 = (t01 >> shift) & 0xFF;
+        const int c11 = (t11 >> shift) & 0xFF;
+        const int top = c00 * 256 + (c10 - c00) * fu;
+        const int bottom = c01 * 256 + (c11 - c01) * fu;
+        const int c = (top * 256 + (bottom - top) * fv) >> 16;
+        result |= static_cast<uword>(c & 0xFF) << shift;
+    }
+    return result;
+}
+
+uword filter_texture(GsLocalMemory& memory, const GsDrawState& state, const float u, const float v, float lod)
+{
+    if (lod <= 0.0f)
+        return sample_texture(memory, state, get_texture_level(state, 0), u, v, state.mmag_linear);
+
+    // MMIN: 0 NEAREST, 1 LINEAR, 2 NEAREST_MIPMAP_NEAREST, 3 NEAREST_MIPMAP_LINEAR,
+    // 4 LINEAR_MIPMAP_NEAREST, 5 LINEAR_MIPMAP_LINEAR (others are reserved).
+    const bool bilinear = (state.mmin == 1) || (state.mmin == 4) || (state.mmin == 5);
+    if (state.mmin < 2 || state.mmin > 5 || !state.mxl)
+        return sample_texture(memory, state, get_texture_level(state, 0), u, v, bilinear);
+
+    const auto sample_level = [&](const int level) {
+        const float scale = 1.0f / static_cast<float>(1 << level);
+        return sample_texture(memory, state, get_texture_level(state, level), u * scale, v * scale, bilinear);
+    };
+
+    lod = std::min(lod, static_cast<float>(state.mxl));
+    if ((state.mmin == 2) || (state.mmin == 4))
+        return sample_level(static_cast<int>(lod + 0.5f));
+
+    // *_MIPMAP_LINEAR: blend the two nearest levels by the fraction of the LOD.
+    const int level = static_cast<int>(lod);
+    const int f = static_cast<int>((lod - static_cast<float>(level)) * 256.0f);
+    const uword t0 = sample_level(level);
+    if (!f)
+        return t0;
+    const uword t1 = sample_level(level + 1);
+
+    uword result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const int c0 = (t0 >> shift) & 0xFF;
+        const int c1 = (t1 >> shift) & 0xFF;
+        result |= static_cast<uword>((c0 * 256 + (c1 - c0) * f) >> 8) << shift;
+    }
+    return result;
+}
+
+void texture_pixel(GsLocalMemory& memory, const GsDrawState& state, const Span& span, const int i, int& r, int& g, int& b, int& a)
+{
+    const float fi = static_cast<float>(i);
+    float u = span.values[ATTR_S] + span.steps[ATTR_S] * fi;
+    float v = span.values[ATTR_T] + span.steps[ATTR_T] * fi;
+    float q = 1.0f;
+    if (!state.fst)
+    {
+        q = span.values[ATTR_Q] + span.steps[ATTR_Q] * fi;
+        if (q == 0.0f)
+            q = 1.0f;
+        u = u / q * static_cast<float>(1 << state.tw);
+        v = v / q * static_cast<float>(1 << state.th);
+    }
+
+    const uword texel = filter_texture(memory, state, u, v, state.get_lod(q));
+    const int tr = texel & 0xFF;
+    const int tg = (texel >> 8) & 0xFF;
+    const int tb = (texel >> 16) & 0xFF;
+    const int ta = texel >> 24;
+
+    switch (state.tfx)
+    {
+    case 0: // MODULATE.
+        r = std::min((tr * r) >> 7, 255);
+        g = std::min((tg * g) >> 7, 255);
+        b = std::min((tb * b) >> 7, 255);
+        if (state.tcc)
+            a = std::min((ta * a) >> 7, 255);
+        break;
+    case 1: // DECAL.
+        r = tr;
+        g = tg;
+        b = tb;
+        if (state.tcc)
+            a = ta;
+        break;
+    default: // HIGHLIGHT, HIGHLIGHT2.
+        r = std::min(((tr * r) >> 7) + a, 255);
+        g = std::min(((tg * g) >> 7) + a, 255);
+        b = std::min(((tb * b) >> 7) + a, 255);
+        if (state.tcc)
+            a = (state.tfx == 2) ? std::min(ta + a, 255) : ta;
+        break;
+    }
+}
+
+void fog_pixel(const GsDrawState& state, const Span& span, const int i, int& r, int& g, int& b)
+{
+    const int fog_r = state.fogcol & 0xFF;
+    const int fog_g = (state.fogcol >> 8) & 0xFF;
+    const int fog_b = (state.fogcol >> 16) & 0xFF;
+    const int f = clamp_colour(static_cast<int>(span.values[ATTR_F] + span.steps[ATTR_F] * static_cast<float>(i)));
+    r = (f * r + (255 - f) * fog_r) >> 8;
+    g = (f * g + (255 - f) * fog_g) >> 8;
+    b = (f * b + (255 - f) * fog_b) >> 8;
+}
+
+void shade_span(GsLocalMemory& memory, const GsDrawState& state, const Span& span)
+{
+    const bool frame_16bit = is_16bit(state.fpsm);
+    const bool frame_24bit = is_24bit(state.fpsm);
+    const bool z_16bit = is_16bit(state.zpsm);
+    const uword z_mask = z_16bit ? 0xFFFF : (is_24bit(state.zpsm) ? 0xFFFFFF : 0xFFFFFFFF);
+
+    // Frame buffer mask, in the frame format.
+    uword fbmsk = state.fbmsk;
+    if (frame_16bit)
+        fbmsk = ((fbmsk >> 3) & 0x1F) | ((fbmsk >> 6) & 0x3E0) | ((fbmsk >> 9) & 0x7C00) | ((fbmsk >> 16) & 0x8000);
+    else if (frame_24bit)
+        fbmsk |= 0xFF000000;
+
+    const bool blend = state.abe;
+    const uword y = static_cast<uword>(span.y);
+
+    for (int i = 0; i < span.count; i++)
+    {
+        const uword x = static_cast<uword>(span.x + i);
+        const float fi = static_cast<float>(i);
+
+        int r = clamp_colour(static_cast<int>(span.values[ATTR_R] + span.steps[ATTR_R] * fi));
+        int g = clamp_colour(static_cast<int>(span.values[ATTR_G] + span.steps[ATTR_G] * fi));
+        int b = clamp_colour(static_cast<int>(span.values[ATTR_B] + span.steps[ATTR_B] * fi));
+        int a = clamp_colour(static_cast<int>(span.values[ATTR_A] + span.steps[ATTR_A] * fi));
+
+        // Texture mapping and texture function (TFX).
+        if (state.tme)
+            texture_pixel(memory, state, span, i, r, g, b, a);
+
+        // Fogging.
+        if (state.fge)
+            fog_pixel(state, span, i, r, g, b);
+
+        // Alpha test.
+        bool write_frame = true;
+        bool write_alpha = true;
+        bool write_z = state.zte && !state.zmsk;
+        if (state.ate && !alpha_test(state.atst, a, state.aref))
+        {
+            switch (state.afail)
+            {
+            case 0: // KEEP.
+                continue;
+            case 1: // FB_ONLY.
+                write_z = false;
+                break;
+            case 2: // ZB_ONLY.
+                write_frame = false;
+                break;
+            default: // RGB_ONLY.
+                write_z = false;
+                write_alpha = false;
+                break;
+            }
+        }
+
+        // Destination alpha test.
+        const uword frame_address = buffer_address(state.fpsm, state.fbp, state.fbw, x, y);
+        const uword dst = frame_16bit ? memory.hwords()[frame_address] : memory.words()[frame_address];
+        if (state.date && !frame_24bit)
+        {
+            const bool dst_alpha_bit = (dst >> (frame_16bit ? 15 : 31)) & 0x1;
+            if (dst_alpha_bit != state.datm)
+                continue;
+        }
+
+        // Depth test.
+        uword z_address = 0;
+        uword z = 0;
+        if (state.zte)
+        {
+            const double z_value = std::min(std::max(span.z + span.z_step * i, 0.0), static_cast<double>(z_mask));
+            z = static_cast<uword>(z_value);
+            z_address = buffer_address(state.zpsm, state.zbp, state.fbw, x, y);
+            const uword z_dst = (z_16bit ? memory.hwords()[z_address] : memory.words()[z_address]) & z_mask;
+
+            bool pass;
+            switch (state.ztst)
+            {
+            case 0: // NEVER.
+                pass = false;
+                break;
+            case 1: // ALWAYS.
+                pass = true;
+                break;
+            case 2: // GEQUAL.
+                pass = z >= z_dst;
+                break;
+            default: // GREATER.
+                pass = z > z_dst;
+                break;
+            }
+
+            if (!pass)
+                continue;
+        }
+
+        if (write_frame)
+        {
+            // Alpha blending: ((A - B) * C >> 7) + D.
+            if (blend && !(state.pabe && !(a & 0x80)))
+            {
+                int dr, dg, db, da;
+                if (frame_16bit)
+                {
+                    dr = (dst & 0x1F) << 3;
+                    dg = ((dst >> 5) & 0x1F) << 3;
+                    db = ((dst >> 10) & 0x1F) << 3;
+                    da = (dst & 0x8000) ? 0x80 : 0;
+                }
+                else
+                {
+                    dr = dst & 0xFF;
+                    dg = (dst >> 8) & 0xFF;
+                    db = (dst >> 16) & 0xFF;
+                    da = frame_24bit ? 0x80 : (dst >> 24);
+                }
+
+                const int sources_r[3] = {r, dr, 0};
+                const int sources_g[3] = {g, dg, 0};
+                const int sources_b[3] = {b, db, 0};
+                const int alphas[3] = {a, da, static_cast<int>(state.alpha_fix)};
+                const int c = alphas[std::min<uword>(state.alpha_c, 2)];
+                const uword sa = std::min<uword>(state.alpha_a, 2);
+                const uword sb = std::min<uword>(state.alpha_b, 2);
+                const uword sd = std::min<uword>(state.alpha_d, 2);
+
+                r = (((sources_r[sa] - sources_r[sb]) * c) >> 7) + sources_r[sd];
+                g = (((sources_g[sa] - sources_g[sb]) * c) >> 7) + sources_g[sd];
+                b = (((sources_b[sa] - sources_b[sb]) * c) >> 7) + sources_b[sd];
+
+                if (state.colclamp)
+                {
+                    r = clamp_colour(r);
+                    g = clamp_colour(g);
+                    b = clamp_colour(b);
+                }
+                else
+                {
+                    r &= 0xFF;
+                    g &= 0xFF;
+                    b &= 0xFF;
+                }
+            }
+
+            if (state.fba)
+                a |= 0x80;
+
+            if (frame_16bit)
+            {
+                const uword mask = fbmsk | (write_alpha ? 0 : 0x8000);
+                const uword value = (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10) | ((a >> 7) << 15);
+                memory.hwords()[frame_address] = static_cast<uhword>((dst & mask) | (value & ~mask));
+            }
+            else
+            {
+                const uword mask = fbmsk | (write_alpha ? 0 : 0xFF000000);
+                const uword value = static_cast<uword>(r) | (g << 8) | (b << 16) | (static_cast<uword>(a) << 24);
+                memory.words()[frame_address] = (dst & mask) | (value & ~mask);
+            }
+        }
+
+        if (write_z)
+        {
+            if (z_16bit)
+                memory.hwords()[z_address] = static_cast<uhword>(z);
+            else
+                memory.words()[z_address] = (memory.words()[z_address] & ~z_mask) | z;
+        }
+    }
+}
+} // namespace GsPixelPipeline
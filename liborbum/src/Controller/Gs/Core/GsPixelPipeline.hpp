@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Common/Types/Primitive.hpp"
+#include "Controller/Gs/Core/GsDrawState.hpp"
+#include "Resources/Gs/GsLocalMemory.hpp"
+
+/// GS pixel pipeline, which shades and writes horizontal spans of pixels
+/// produced by the rasterizer (see GsRasterizer):
+/// texture mapping -> fog -> alpha test -> destination alpha test -> depth test
+/// -> alpha blending -> colour clamp -> FBA -> frame/Z buffer writes (with masks).
+/// See GS Users Manual page 63 onwards.
+namespace GsPixelPipeline
+{
+/// Interpolated attributes of a span. When PRIM.FST is set, S and T hold
+/// the U and V texel coordinates, and Q is 1.
+enum Attribute
+{
+    ATTR_R,
+    ATTR_G,
+    ATTR_B,
+    ATTR_A,
+    ATTR_F,
+    ATTR_S,
+    ATTR_T,
+    ATTR_Q,
+    NUMBER_ATTRIBUTES
+};
+
+/// A horizontal run of pixels, with the attribute values at the first pixel
+/// and their steps per pixel (0 for constant attributes, ie: flat shading).
+/// Z is kept in double precision, as it needs 32 bits of integer precision.
+struct Span
+{
+    int x;
+    int y;
+    int count;
+    float values[NUMBER_ATTRIBUTES];
+    float steps[NUMBER_ATTRIBUTES];
+    double z;
+    double z_step;
+};
+
+/// Span shading function (interpreted, or specialised to a draw state).
+using SpanFunction = void (*)(GsLocalMemory& memory, const GsDrawState& state, const Span& span);
+
+/// Generic span shading function, which branches on the draw state per pixel.
+void shade_span(GsLocalMemory& memory, const GsDrawState& state, const Span& span);
+
+/// Texture mapping with the texture function (TFX), and fogging, applied to
+/// the colour of pixel i of the span. Also called by compiled pipelines (see
+/// GsPixelPipelineCompiler), which don't specialise these stages.
+void texture_pixel(GsLocalMemory& memory, const GsDrawState& state, const Span& span, const int i, int& r, int& g, int& b, int& a);
+void fog_pixel(const GsDrawState& state, const Span& span, const int i, int& r, int& g, int& b);
+
+/// A level of the texture: level 0 is the TEX0 texture, levels 1 -> MXL
+/// the mipmaps (see GsDrawState::mip_tbp). TW/TH are log2 of the level size.
+struct TextureLevel
+{
+    int level;
+    uword tbp;
+    uword tbw;
+    uword tw;
+    uword th;
+};
+
+/// Returns the texture level given.
+TextureLevel get_texture_level(const GsDrawState& state, const int level);
+
+/// Reads the texel of the texture level at the (integer) coordinates given,
+/// after applying the wrap modes, and expands it to 32-bit RGBA (through the
+/// CLUT, TEXA).
+uword read_texel(GsLocalMemory& memory, const GsDrawState& state, const TextureLevel& texture, int u, int v);
+
+/// Samples the texture level at the texel coordinates (of that level) given,
+/// nearest or bilinear, returning 32-bit RGBA.
+uword sample_texture(GsLocalMemory& memory, const GsDrawState& state, const TextureLevel& texture, float u, float v, bool bilinear);
+
+/// Samples the texture at the texel coordinates (of the base texture) given,
+/// with the filter and mipmap level(s) selected by the LOD (see GsDrawState::get_lod()).
+/// See GS Users Manual page 117.
+uword filter_texture(GsLocalMemory& memory, const GsDrawState& state, float u, float v, float lod);
+} // namespace GsPixelPipeline
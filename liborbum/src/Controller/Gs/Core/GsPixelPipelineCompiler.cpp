@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "Common/Types/Jit/X64Emitter.hpp"
+#include "Controller/Gs/Core/GsPixelPipelineCompiler.hpp"
+
+#if defined(ENV_UNIX) && defined(__x86_64__)
+#define GS_PIPELINE_COMPILER_SUPPORTED 1
+#else
+#define GS_PIPELINE_COMPILER_SUPPORTED 0
+#endif
+
+using namespace GsPixelPipeline;
+
+namespace
+{
+using Reg = X64Emitter::Reg;
+using Xmm = X64Emitter::Xmm;
+using Cond = X64Emitter::Cond;
+using AluOp = X64Emitter::AluOp;
+using ShiftOp = X64Emitter::ShiftOp;
+
+/// Per span constants, set up by setup_span() on the stack of the compiled
+/// span function and addressed through RBX.
+struct alignas(16) SpanSetup
+{
+    /// R, G, B, A at the first pixel, and their steps.
+    float colour_values[4];
+    float colour_steps[4];
+
+    /// Colour byte mask, for blending results without COLCLAMP.
+    uword byte_mask[4];
+
+    double z;
+    double z_step;
+    double z_min;
+    double z_max;
+
+    /// Frame and Z buffer addressing for the row of the span (32-bit formats):
+    /// address = (row_base + (x / 64) * 2048 + row_offsets[x % 64]) & (NUMBER_WORDS - 1).
+    uword* words;
+    const uhword* frame_row_offsets;
+    const uhword* z_row_offsets;
+    uword frame_row_base;
+    uword z_row_base;
+
+    /// FBMSK in the frame format, AREF and FIX.
+    uword fbmsk;
+    uword aref;
+    uword alpha_fix;
+
+    sword x;
+    sword count;
+
+    /// Interpreter stage arguments.
+    GsLocalMemory* memory;
+    const GsDrawState* state;
+    const Span* span;
+};
+
+/// Stack space reserved for the setup, keeping the stack 16-byte aligned
+/// after the 6 callee saved register pushes.
+constexpr uword SETUP_STACK_SIZE = ((sizeof(SpanSetup) + 15) & ~15) + 8;
+
+constexpr sword offset(const size_t value)
+{
+    return static_cast<sword>(value);
+}
+
+bool is_z_table(const uword psm)
+{
+    return psm == GsLocalMemory::PSMZ32 || psm == GsLocalMemory::PSMZ24;
+}
+
+/// Called on entry to the compiled span functions.
+void setup_span(GsLocalMemory& memory, const GsDrawState& state, const Span& span, SpanSetup* setup)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        setup->colour_values[i] = span.values[ATTR_R + i];
+        setup->colour_steps[i] = span.steps[ATTR_R + i];
+        setup->byte_mask[i] = 0xFF;
+    }
+
+    setup->z = span.z;
+    setup->z_step = span.z_step;
+    setup->z_min = 0.0;
+    setup->z_max = ((state.zpsm & 0xF) == 0x1) ? 0xFFFFFF : 0xFFFFFFFF;
+
+    const uword y = static_cast<uword>(span.y);
+    const uword page_row = y / GsSwizzle::PAGE_TABLE_32.HEIGHT;
+    const uword page_y = y % GsSwizzle::PAGE_TABLE_32.HEIGHT;
+    const uword page_size = GsSwizzle::PAGE_TABLE_32.WIDTH * GsSwizzle::PAGE_TABLE_32.HEIGHT;
+    setup->words = memory.words();
+    setup->frame_row_offsets = (is_z_table(state.fpsm) ? GsSwizzle::PAGE_TABLE_32Z : GsSwizzle::PAGE_TABLE_32).offsets[page_y];
+    setup->z_row_offsets = (is_z_table(state.zpsm) ? GsSwizzle::PAGE_TABLE_32Z : GsSwizzle::PAGE_TABLE_32).offsets[page_y];
+    setup->frame_row_base = (state.fbp << 6) + page_row * state.fbw * page_size;
+    setup->z_row_base = (state.zbp << 6) + page_row * state.fbw * page_size;
+
+    setup->fbmsk = ((state.fpsm & 0xF) == 0x1) ? (state.fbmsk | 0xFF000000) : state.fbmsk;
+    setup->aref = state.aref;
+    setup->alpha_fix = state.alpha_fix;
+
+    setup->x = span.x;
+    setup->count = span.count;
+
+    setup->memory = &memory;
+    setup->state = &state;
+    setup->span = &span;
+}
+
+/// Interpreter stages, called from compiled code with the packed RGBA colour.
+uword texture_stage(const SpanSetup* setup, const int i, const uword colour)
+{
+    int r = colour & 0xFF;
+    int g = (colour >> 8) & 0xFF;
+    int b = (colour >> 16) & 0xFF;
+    int a = colour >> 24;
+    texture_pixel(*setup->memory, *setup->state, *setup->span, i, r, g, b, a);
+    return static_cast<uword>(r) | (g << 8) | (b << 16) | (static_cast<uword>(a) << 24);
+}
+
+uword fog_stage(const SpanSetup* setup, const int i, const uword colour)
+{
+    int r = colour & 0xFF;
+    int g = (colour >> 8) & 0xFF;
+    int b = (colour >> 16) & 0xFF;
+    fog_pixel(*setup->state, *setup->span, i, r, g, b);
+    return static_cast<uword>(r) | (g << 8) | (b << 16) | (colour & 0xFF000000);
+}
+
+/// Emits: dst = (row_base + (x / 64) * 2048 + row_offsets[x % 64]) & (NUMBER_WORDS - 1),
+/// with x in R14 (clobbers RAX, R10).
+void emit_buffer_address(X64Emitter& emitter, const Reg dst, const sword row_base_offset, const sword row_offsets_offset)
+{
+    emitter.mov_r32_r32(Reg::RAX, Reg::R14);
+    emitter.shift_r32_imm8(ShiftOp::SHR, Reg::RAX, 6);
+    emitter.shift_r32_imm8(ShiftOp::SHL, Reg::RAX, 11);
+    emitter.alu_r32_m32(AluOp::ADD, Reg::RAX, Reg::RBX, row_base_offset);
+    emitter.mov_r32_r32(dst, Reg::R14);
+    emitter.alu_r32_imm32(AluOp::AND, dst, 63);
+    emitter.mov_r64_m64(Reg::R10, Reg::RBX, row_offsets_offset);
+    emitter.load_base_index(X64Emitter::Width::Hword, dst, Reg::R10, dst, 1);
+    emitter.alu_r32_r32(AluOp::ADD, dst, Reg::RAX);
+    emitter.alu_r32_imm32(AluOp::AND, dst, GsLocalMemory::NUMBER_WORDS - 1);
+}
+
+/// Emits a call to an interpreter stage: colour (RBP) = stage(setup, i, colour).
+void emit_stage_call(X64Emitter& emitter, const void* function)
+{
+    emitter.mov_r64_r64(Reg::RDI, Reg::RBX);
+    emitter.mov_r32_r32(Reg::RSI, Reg::R12);
+    emitter.mov_r32_r32(Reg::RDX, Reg::RBP);
+    emitter.call(function);
+    emitter.mov_r32_r32(Reg::RBP, Reg::RAX);
+}
+} // namespace
+
+GsPixelPipelineCompiler::GsPixelPipelineCompiler() :
+    code_memory(GS_PIPELINE_COMPILER_SUPPORTED ? CODE_MEMORY_SIZE : 0),
+    hits(0),
+    misses(0),
+    number_interpreted(0),
+    number_compiled(0),
+    number_code_flushes(0),
+    compile_time_ns(0)
+{
+}
+
+SpanFunction GsPixelPipelineCompiler::get_span_function(const GsDrawState& state)
+{
+    Key key;
+    if (!code_memory.is_valid() || !make_key(state, key))
+    {
+        number_interpreted++;
+        return &GsPixelPipeline::shade_span;
+    }
+
+    auto it = pipelines.find(key);
+    if (it != pipelines.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    const auto start = std::chrono::steady_clock::now();
+    SpanFunction function = compile(state);
+    compile_time_ns += static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    if (!function)
+        return &GsPixelPipeline::shade_span;
+
+    number_compiled++;
+    pipelines[key] = function;
+    return function;
+}
+
+void GsPixelPipelineCompiler::reset()
+{
+    code_memory.reset();
+    pipelines.clear();
+    number_code_flushes++;
+}
+
+bool GsPixelPipelineCompiler::make_key(const GsDrawState& state, Key& key)
+{
+    // 32-bit (and 24-bit) frame and Z buffers only.
+    const bool is_frame_supported = state.fpsm == GsLocalMemory::PSMCT32 || state.fpsm == GsLocalMemory::PSMCT24 || is_z_table(state.fpsm);
+    if (!is_frame_supported || (state.zte && !is_z_table(state.zpsm)))
+        return false;
+
+    const bool frame_24bit = (state.fpsm & 0xF) == 0x1;
+    const bool ate = state.ate && state.atst != 1;
+    const bool date = state.date && !frame_24bit;
+
+    key = 0;
+    key |= static_cast<Key>(state.tme) << 0;
+    key |= static_cast<Key>(state.fge) << 1;
+    key |= static_cast<Key>(frame_24bit) << 2;
+    key |= static_cast<Key>(state.fba) << 3;
+    if (state.zte)
+    {
+        key |= 1 << 4;
+        key |= (state.ztst & 0x3) << 5;
+        key |= static_cast<Key>(state.zmsk) << 7;
+        key |= static_cast<Key>((state.zpsm & 0xF) == 0x1) << 8;
+    }
+    if (ate)
+    {
+        key |= 1 << 9;
+        key |= (state.atst & 0x7) << 10;
+        key |= (state.afail & 0x3) << 13;
+    }
+    if (date)
+    {
+        key |= 1 << 15;
+        key |= static_cast<Key>(state.datm) << 16;
+    }
+    if (state.abe)
+    {
+        key |= 1 << 17;
+        key |= std::min<uword>(state.alpha_a, 2) << 18;
+        key |= std::min<uword>(state.alpha_b, 2) << 20;
+        key |= std::min<uword>(state.alpha_c, 2) << 22;
+        key |= std::min<uword>(state.alpha_d, 2) << 24;
+        key |= static_cast<Key>(state.pabe) << 26;
+        key |= static_cast<Key>(state.colclamp) << 27;
+    }
+    return true;
+}
+
+SpanFunction GsPixelPipelineCompiler::compile(const GsDrawState& state)
+{
+    if (code_memory.get_free_size() < MAX_PIPELINE_CODE_SIZE)
+        return nullptr;
+
+    const bool frame_24bit = (state.fpsm & 0xF) == 0x1;
+    const bool z_24bit = (state.zpsm & 0xF) == 0x1;
+    const bool ate = state.ate && state.atst != 1;
+    const bool date = state.date && !frame_24bit;
+    const bool write_z = state.zte && !state.zmsk;
+
+    // Alpha test fail actions needing per pixel flags: R8D is added to the
+    // frame mask (all set = no frame write), R9D = 0 disables the Z write.
+    const bool uses_frame_flag = ate && (state.afail == 2 || state.afail == 3);
+    const bool uses_z_flag = ate && write_z && (state.afail == 1 || state.afail == 3);
+
+    X64Emitter emitter(code_memory.get_free_pointer(), MAX_PIPELINE_CODE_SIZE);
+    std::vector<size_t> next_fixups;
+
+    // Registers: RBX = setup, R12D = pixel index, R13D = count, R14D = x,
+    // R15 = local memory words, EBP = colour (RGBA), ECX = frame address,
+    // EDX = frame value, ESI = Z, EDI = Z address.
+    emitter.push(Reg::RBX);
+    emitter.push(Reg::RBP);
+    emitter.push(Reg::R12);
+    emitter.push(Reg::R13);
+    emitter.push(Reg::R14);
+    emitter.push(Reg::R15);
+    emitter.alu_r64_imm32(AluOp::SUB, Reg::RSP, SETUP_STACK_SIZE);
+    emitter.mov_r64_r64(Reg::RBX, Reg::RSP);
+
+    // setup_span(memory, state, span, setup), with the arguments as passed in.
+    emitter.mov_r64_r64(Reg::RCX, Reg::RBX);
+    emitter.call(reinterpret_cast<const void*>(&setup_span));
+
+    emitter.alu_r32_r32(AluOp::XOR, Reg::R12, Reg::R12);
+    emitter.mov_r32_m32(Reg::R13, Reg::RBX, offset(offsetof(SpanSetup, count)));
+    emitter.mov_r32_m32(Reg::R14, Reg::RBX, offset(offsetof(SpanSetup, x)));
+    emitter.mov_r64_m64(Reg::R15, Reg::RBX, offset(offsetof(SpanSetup, words)));
+    emitter.test_r32_r32(Reg::R13, Reg::R13);
+    const size_t empty_fixup = emitter.jcc(Cond::LE);
+
+    const size_t loop_position = emitter.get_position();
+
+    // Colour: clamp(int(value + step * i)) for R, G, B, A.
+    emitter.cvtsi2ss_xmm_r32(Xmm::XMM0, Reg::R12);
+    emitter.shufps(Xmm::XMM0, Xmm::XMM0, 0x00);
+    emitter.mulps_xmm_m128(Xmm::XMM0, Reg::RBX, offset(offsetof(SpanSetup, colour_steps)));
+    emitter.addps_xmm_m128(Xmm::XMM0, Reg::RBX, offset(offsetof(SpanSetup, colour_values)));
+    emitter.cvttps2dq(Xmm::XMM0, Xmm::XMM0);
+    emitter.packssdw(Xmm::XMM0, Xmm::XMM0);
+    emitter.packuswb(Xmm::XMM0, Xmm::XMM0);
+    emitter.movd_r32_xmm(Reg::RBP, Xmm::XMM0);
+
+    if (state.tme)
+        emit_stage_call(emitter, reinterpret_cast<const void*>(&texture_stage));
+    if (state.fge)
+        emit_stage_call(emitter, reinterpret_cast<const void*>(&fog_stage));
+
+    // Alpha test.
+    if (ate)
+    {
+        if (uses_frame_flag)
+            emitter.alu_r32_r32(AluOp::XOR, Reg::R8, Reg::R8);
+        if (uses_z_flag)
+            emitter.mov_r32_imm32(Reg::R9, 1);
+
+        size_t pass_fixup = 0;
+        if (state.atst != 0)
+        {
+            // LESS, LEQUAL, EQUAL, GEQUAL, GREATER, NOTEQUAL.
+            const Cond PASS_CONDS[8] = {Cond::E, Cond::E, Cond::B, Cond::BE, Cond::E, Cond::AE, Cond::A, Cond::NE};
+            emitter.mov_r32_r32(Reg::RAX, Reg::RBP);
+            emitter.shift_r32_imm8(ShiftOp::SHR, Reg::RAX, 24);
+            emitter.alu_r32_m32(AluOp::CMP, Reg::RAX, Reg::RBX, offset(offsetof(SpanSetup, aref)));
+            pass_fixup = emitter.jcc(PASS_CONDS[state.atst & 0x7]);
+        }
+
+        switch (state.afail)
+        {
+        case 0: // KEEP.
+            next_fixups.push_back(emitter.jmp());
+            break;
+        case 1: // FB_ONLY.
+            if (uses_z_flag)
+                emitter.mov_r32_imm32(Reg::R9, 0);
+            break;
+        case 2: // ZB_ONLY.
+            emitter.mov_r32_imm32(Reg::R8, 0xFFFFFFFF);
+            break;
+        default: // RGB_ONLY.
+            if (uses_z_flag)
+                emitter.mov_r32_imm32(Reg::R9, 0);
+            emitter.mov_r32_imm32(Reg::R8, 0xFF000000);
+            break;
+        }
+
+        if (state.atst != 0)
+            emitter.bind(pass_fixup, emitter.get_position());
+    }
+
+    // Frame address and value, destination alpha test.
+    emit_buffer_address(emitter, Reg::RCX, offset(offsetof(SpanSetup, frame_row_base)), offset(offsetof(SpanSetup, frame_row_offsets)));
+    emitter.load_base_index(X64Emitter::Width::Word, Reg::RDX, Reg::R15, Reg::RCX, 2);
+    if (date)
+    {
+        emitter.test_r32_r32(Reg::RDX, Reg::RDX);
+        next_fixups.push_back(emitter.jcc(state.datm ? Cond::NS : Cond::S));
+    }
+
+    // Depth test (NEVER skips everything after).
+    bool is_pixel_drawn = true;
+    if (state.zte)
+    {
+        if (state.ztst == 0)
+        {
+            next_fixups.push_back(emitter.jmp());
+            is_pixel_drawn = false;
+        }
+        else
+        {
+            emitter.cvtsi2sd_xmm_r32(Xmm::XMM1, Reg::R12);
+            emitter.mulsd_xmm_m64(Xmm::XMM1, Reg::RBX, offset(offsetof(SpanSetup, z_step)));
+            emitter.addsd_xmm_m64(Xmm::XMM1, Reg::RBX, offset(offsetof(SpanSetup, z)));
+            emitter.maxsd_xmm_m64(Xmm::XMM1, Reg::RBX, offset(offsetof(SpanSetup, z_min)));
+            emitter.minsd_xmm_m64(Xmm::XMM1, Reg::RBX, offset(offsetof(SpanSetup, z_max)));
+            emitter.cvttsd2si_r64_xmm(Reg::RSI, Xmm::XMM1);
+            emit_buffer_address(emitter, Reg::RDI, offset(offsetof(SpanSetup, z_row_base)), offset(offsetof(SpanSetup, z_row_offsets)));
+
+            if (state.ztst != 1)
+            {
+                emitter.load_base_index(X64Emitter::Width::Word, Reg::RAX, Reg::R15, Reg::RDI, 2);
+                if (z_24bit)
+                    emitter.alu_r32_imm32(AluOp::AND, Reg::RAX, 0xFFFFFF);
+                emitter.alu_r32_r32(AluOp::CMP, Reg::RSI, Reg::RAX);
+                next_fixups.push_back(emitter.jcc((state.ztst == 2) ? Cond::B : Cond::BE));
+            }
+        }
+    }
+
+    if (is_pixel_drawn)
+    {
+        size_t skip_frame_fixup = 0;
+        const bool can_skip_frame = uses_frame_flag && state.afail == 2;
+        if (can_skip_frame)
+        {
+            emitter.test_r32_r32(Reg::R8, Reg::R8);
+            skip_frame_fixup = emitter.jcc(Cond::NE);
+        }
+
+        // Alpha blending: ((A - B) * C >> 7) + D, on the colour components
+        // unpacked to 32-bit lanes (the products are done with PMADDWD, the
+        // differences and C fitting in 16 bits).
+        if (state.abe)
+        {
+            size_t skip_blend_fixup = 0;
+            if (state.pabe)
+            {
+                emitter.test_r32_r32(Reg::RBP, Reg::RBP);
+                skip_blend_fixup = emitter.jcc(Cond::NS);
+            }
+
+            const uword sa = std::min<uword>(state.alpha_a, 2);
+            const uword sb = std::min<uword>(state.alpha_b, 2);
+            const uword sc = std::min<uword>(state.alpha_c, 2);
+            const uword sd = std::min<uword>(state.alpha_d, 2);
+            const Xmm SOURCES[3] = {Xmm::XMM0, Xmm::XMM1, Xmm::XMM7};
+
+            emitter.pxor(Xmm::XMM7, Xmm::XMM7);
+            emitter.movd_xmm_r32(Xmm::XMM0, Reg::RBP);
+            emitter.punpcklbw(Xmm::XMM0, Xmm::XMM7);
+            emitter.punpcklwd(Xmm::XMM0, Xmm::XMM7);
+            emitter.movd_xmm_r32(Xmm::XMM1, Reg::RDX);
+            emitter.punpcklbw(Xmm::XMM1, Xmm::XMM7);
+            emitter.punpcklwd(Xmm::XMM1, Xmm::XMM7);
+
+            emitter.movdqa(Xmm::XMM2, SOURCES[sa]);
+            emitter.psubd(Xmm::XMM2, SOURCES[sb]);
+
+            switch (sc)
+            {
+            case 0: // Source alpha.
+                emitter.mov_r32_r32(Reg::RAX, Reg::RBP);
+                emitter.shift_r32_imm8(ShiftOp::SHR, Reg::RAX, 24);
+                break;
+            case 1: // Destination alpha.
+                if (frame_24bit)
+                {
+                    emitter.mov_r32_imm32(Reg::RAX, 0x80);
+                }
+                else
+                {
+                    emitter.mov_r32_r32(Reg::RAX, Reg::RDX);
+                    emitter.shift_r32_imm8(ShiftOp::SHR, Reg::RAX, 24);
+                }
+                break;
+            default: // FIX.
+                emitter.mov_r32_m32(Reg::RAX, Reg::RBX, offset(offsetof(SpanSetup, alpha_fix)));
+                break;
+            }
+            emitter.movd_xmm_r32(Xmm::XMM3, Reg::RAX);
+            emitter.pshufd(Xmm::XMM3, Xmm::XMM3, 0x00);
+            emitter.pmaddwd(Xmm::XMM2, Xmm::XMM3);
+            emitter.psrad(Xmm::XMM2, 7);
+            if (sd != 2)
+                emitter.paddd(Xmm::XMM2, SOURCES[sd]);
+
+            // COLCLAMP: saturate to 0 -> 255, otherwise keep the low 8 bits.
+            if (!state.colclamp)
+                emitter.pand_xmm_m128(Xmm::XMM2, Reg::RBX, offset(offsetof(SpanSetup, byte_mask)));
+            emitter.packssdw(Xmm::XMM2, Xmm::XMM2);
+            emitter.packuswb(Xmm::XMM2, Xmm::XMM2);
+            emitter.movd_r32_xmm(Reg::RAX, Xmm::XMM2);
+            emitter.alu_r32_imm32(AluOp::AND, Reg::RAX, 0x00FFFFFF);
+            emitter.alu_r32_imm32(AluOp::AND, Reg::RBP, 0xFF000000);
+            emitter.alu_r32_r32(AluOp::OR, Reg::RBP, Reg::RAX);
+
+            if (state.pabe)
+                emitter.bind(skip_blend_fixup, emitter.get_position());
+        }
+
+        if (state.fba)
+            emitter.alu_r32_imm32(AluOp::OR, Reg::RBP, 0x80000000);
+
+        // Frame write: value ^ ((value ^ dst) & mask).
+        emitter.mov_r32_m32(Reg::RAX, Reg::RBX, offset(offsetof(SpanSetup, fbmsk)));
+        if (uses_frame_flag && !can_skip_frame)
+            emitter.alu_r32_r32(AluOp::OR, Reg::RAX, Reg::R8);
+        emitter.mov_r32_r32(Reg::R11, Reg::RDX);
+        emitter.alu_r32_r32(AluOp::XOR, Reg::R11, Reg::RBP);
+        emitter.alu_r32_r32(AluOp::AND, Reg::R11, Reg::RAX);
+        emitter.alu_r32_r32(AluOp::XOR, Reg::R11, Reg::RBP);
+        emitter.store_base_index(X64Emitter::Width::Word, Reg::R15, Reg::RCX, Reg::R11, 2);
+
+        if (can_skip_frame)
+            emitter.bind(skip_frame_fixup, emitter.get_position());
+
+        // Z write (Z24 keeps the upper 8 bits, re-read as the frame might share the memory).
+        if (write_z)
+        {
+            if (uses_z_flag)
+            {
+                emitter.test_r32_r32(Reg::R9, Reg::R9);
+                next_fixups.push_back(emitter.jcc(Cond::E));
+            }
+
+            if (z_24bit)
+            {
+                emitter.load_base_index(X64Emitter::Width::Word, Reg::RAX, Reg::R15, Reg::RDI, 2);
+                emitter.alu_r32_imm32(AluOp::AND, Reg::RAX, 0xFF000000);
+                emitter.alu_r32_r32(AluOp::OR, Reg::RAX, Reg::RSI);
+                emitter.store_base_index(X64Emitter::Width::Word, Reg::R15, Reg::RDI, Reg::RAX, 2);
+            }
+            else
+            {
+                emitter.store_base_index(X64Emitter::Width::Word, Reg::R15, Reg::RDI, Reg::RSI, 2);
+            }
+        }
+    }
+
+    // Next pixel.
+    const size_t next_position = emitter.get_position();
+    for (const size_t fixup : next_fixups)
+        emitter.bind(fixup, next_position);
+    emitter.alu_r32_imm32(AluOp::ADD, Reg::R12, 1);
+    emitter.alu_r32_imm32(AluOp::ADD, Reg::R14, 1);
+    emitter.alu_r32_r32(AluOp::CMP, Reg::R12, Reg::R13);
+    emitter.bind(emitter.jcc(Cond::L), loop_position);
+
+    // Epilogue.
+    emitter.bind(empty_fixup, emitter.get_position());
+    emitter.alu_r64_imm32(AluOp::ADD, Reg::RSP, SETUP_STACK_SIZE);
+    emitter.pop(Reg::R15);
+    emitter.pop(Reg::R14);
+    emitter.pop(Reg::R13);
+    emitter.pop(Reg::R12);
+    emitter.pop(Reg::RBP);
+    emitter.pop(Reg::RBX);
+    emitter.ret();
+
+    if (emitter.has_overflowed())
+        return nullptr;
+
+    code_memory.commit(emitter.get_position());
+    return reinterpret_cast<SpanFunction>(emitter.get_code());
+}
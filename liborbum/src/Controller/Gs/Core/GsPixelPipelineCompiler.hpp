@@ -0,0 +1,86 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Common/Types/Jit/ExecutableMemory.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Controller/Gs/Core/GsDrawState.hpp"
+#include "Controller/Gs/Core/GsPixelPipeline.hpp"
+
+/// Compiles the GS pixel pipeline (see GsPixelPipeline::shade_span) into host
+/// x86-64 code specialised to a draw state, so the per pixel branching on the
+/// TEST, ALPHA, PABE, COLCLAMP, FBA and FRAME/ZBUF formats is resolved once
+/// per draw state instead of per pixel.
+/// Compiled span functions are cached by a key of the draw state fields the
+/// code depends on (see make_key()), so draw states which only differ in
+/// buffer pointers, AREF, FIX etc share code, and repeated draws reuse it.
+/// Texture mapping and fogging are not specialised: compiled code calls the
+/// interpreter stages for those (see GsPixelPipeline::texture_pixel()).
+/// Draw states with 16-bit frame or Z buffers use the interpreter, as do
+/// hosts other than x86-64 Unix (SysV ABI), or if the executable memory could
+/// not be allocated.
+/// Only used by the thread setting the draw states (see GsRasterizer), the
+/// compiled code can run on any thread.
+class GsPixelPipelineCompiler
+{
+public:
+    /// Size of the host code buffer. Once full, all compiled code is discarded (see reset()).
+    static constexpr size_t CODE_MEMORY_SIZE = 1024 * 1024;
+
+    /// Upper bound of the code size of a pipeline.
+    static constexpr size_t MAX_PIPELINE_CODE_SIZE = 1024;
+
+    GsPixelPipelineCompiler();
+
+    /// Returns the span function for the draw state: the cached compiled code,
+    /// compiling it on first use, or the interpreter when not supported.
+    /// The caller must make sure there is space for a new pipeline first, see is_full().
+    GsPixelPipeline::SpanFunction get_span_function(const GsDrawState& state);
+
+    /// Returns if the code memory might not fit another pipeline, in which
+    /// case reset() needs to be called once no compiled code is in use.
+    bool is_full() const
+    {
+        return code_memory.is_valid() && (code_memory.get_free_size() < MAX_PIPELINE_CODE_SIZE);
+    }
+
+    /// Discards all compiled code.
+    void reset();
+
+    /// Compiler statistics. Lookups are the get_span_function() calls for
+    /// supported draw states (hits + misses), interpreted are the calls for
+    /// unsupported draw states.
+    size_t get_number_pipelines() const { return pipelines.size(); }
+    size_t get_hits() const { return hits; }
+    size_t get_misses() const { return misses; }
+    size_t get_number_interpreted() const { return number_interpreted; }
+    size_t get_number_compiled() const { return number_compiled; }
+    size_t get_number_code_flushes() const { return number_code_flushes; }
+    double get_compile_time_us() const { return compile_time_ns / 1.0e3; }
+    size_t get_code_memory_used() const { return code_memory.get_used_size(); }
+
+private:
+    /// Packed draw state fields the compiled code depends on. Fields which
+    /// have no effect in a state (ie: ZTST when ZTE = 0) are left as 0.
+    using Key = uword;
+
+    /// Makes the key for the draw state, returning false if it isn't supported.
+    static bool make_key(const GsDrawState& state, Key& key);
+
+    /// Emits the span function for the draw state into the code memory,
+    /// returning nullptr on failure.
+    GsPixelPipeline::SpanFunction compile(const GsDrawState& state);
+
+    /// Host code buffer.
+    ExecutableMemory code_memory;
+
+    /// Compiled span functions.
+    std::unordered_map<Key, GsPixelPipeline::SpanFunction> pipelines;
+
+    size_t hits;
+    size_t misses;
+    size_t number_interpreted;
+    size_t number_compiled;
+    size_t number_code_flushes;
+    size_t compile_time_ns;
+};
@@ -0,0 +1,472 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+#include "Controller/Gs/Core/GsRasterizer.hpp"
+
+using namespace GsPixelPipeline;
+
+namespace
+{
+/// Number of primitives pending after which a flush is forced.
+constexpr size_t MAX_PENDING_PRIMITIVES = 1 << 16;
+
+/// Converts a 12.4 fixed point coordinate to the first pixel (center) at or after it.
+int ceil_pixel(const sword value)
+{
+    return (value + 15) >> 4;
+}
+} // namespace
+
+GsRasterizer::GsRasterizer(GsLocalMemory& memory, const int number_threads, const bool compile_pipelines) :
+    memory(memory),
+    compile_pipelines(compile_pipelines),
+    tile_primitives(NUMBER_TILES),
+    flush_generation(0),
+    next_tile(0),
+    workers_finished(0),
+    exit(false)
+#if defined(BUILD_DEBUG)
+    ,
+    number_flushes(0),
+    number_primitives(0),
+    number_tile_bins(0),
+    number_tiles_drawn(0)
+#endif
+{
+    for (int i = 1; i < number_threads; i++)
+        workers.emplace_back(std::bind(&GsRasterizer::worker_main, this));
+}
+
+GsRasterizer::~GsRasterizer()
+{
+    exit.store(true, std::memory_order_release);
+    start_event.notify();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void GsRasterizer::set_draw_state(const GsDrawState& state)
+{
+    // Compiled code can only be discarded once no pending primitive uses it.
+    if (compile_pipelines && pipeline_compiler.is_full())
+    {
+        flush();
+        pipeline_compiler.reset();
+    }
+
+    // Replace the current state if no primitive uses it yet.
+    if (states.empty() || (!primitives.empty() && primitives.back().state_index == states.size() - 1))
+        states.emplace_back();
+    states.back().state = state;
+    states.back().shade_span = compile_pipelines ? pipeline_compiler.get_span_function(state) : &GsPixelPipeline::shade_span;
+}
+
+bool GsRasterizer::begin_primitive(Primitive& primitive, const Coverage coverage, const GsVertex& attribute_vertex, int x0, int y0, int x1, int y1)
+{
+    if (states.empty())
+        throw std::runtime_error("GS rasterizer primitive added without a draw state.");
+
+    const GsDrawState& state = states.back().state;
+    primitive.coverage = coverage;
+    primitive.state_index = states.size() - 1;
+
+    primitive.x0 = std::max({x0, state.scissor_x0, 0});
+    primitive.y0 = std::max({y0, state.scissor_y0, 0});
+    primitive.x1 = std::min({x1, state.scissor_x1, WINDOW_SIZE - 1});
+    primitive.y1 = std::min({y1, state.scissor_y1, WINDOW_SIZE - 1});
+    if (primitive.x0 > primitive.x1 || primitive.y0 > primitive.y1)
+        return false;
+
+    // Constant attributes by default.
+    primitive.origin_x = 0.0f;
+    primitive.origin_y = 0.0f;
+    for (int i = 0; i < NUMBER_ATTRIBUTES; i++)
+    {
+        primitive.base[i] = attribute_vertex.attributes[i];
+        primitive.dx[i] = 0.0f;
+        primitive.dy[i] = 0.0f;
+    }
+    primitive.z_base = attribute_vertex.z;
+    primitive.z_dx = 0.0;
+    primitive.z_dy = 0.0;
+
+    return true;
+}
+
+void GsRasterizer::add_point(const GsVertex& v0)
+{
+    const int x = (v0.x + 8) >> 4;
+    const int y = (v0.y + 8) >> 4;
+
+    Primitive primitive;
+    if (!begin_primitive(primitive, Coverage::Rectangle, v0, x, y, x, y))
+        return;
+
+    primitives.push_back(primitive);
+    bin_primitive(static_cast<uword>(primitives.size() - 1));
+}
+
+void GsRasterizer::add_line(const GsVertex& v0, const GsVertex& v1)
+{
+    const bool x_major = std::abs(v1.x - v0.x) >= std::abs(v1.y - v0.y);
+    const GsVertex* a = &v0;
+    const GsVertex* b = &v1;
+    if ((x_major && v1.x < v0.x) || (!x_major && v1.y < v0.y))
+        std::swap(a, b);
+
+    const sword a_major = x_major ? a->x : a->y;
+    const sword b_major = x_major ? b->x : b->y;
+    const sword a_minor = x_major ? a->y : a->x;
+    const sword b_minor = x_major ? b->y : b->x;
+    if (a_major == b_major)
+        return;
+
+    // Pixels are drawn along the major axis, from the start (inclusive) to the end (exclusive).
+    const float major_length = static_cast<float>(b_major - a_major) / 16.0f;
+    const float slope = static_cast<float>(b_minor - a_minor) / 16.0f / major_length;
+    const float minor_start = static_cast<float>(a_minor) / 16.0f - slope * static_cast<float>(a_major) / 16.0f;
+    const int major_0 = ceil_pixel(a_major);
+    const int major_1 = ceil_pixel(b_major) - 1;
+    if (major_0 > major_1)
+        return;
+    const int minor_0 = static_cast<int>(std::floor(minor_start + slope * major_0 + 0.5f));
+    const int minor_1 = static_cast<int>(std::floor(minor_start + slope * major_1 + 0.5f));
+
+    Primitive primitive;
+    const bool covers = x_major
+        ? begin_primitive(primitive, Coverage::Line, v1, major_0, std::min(minor_0, minor_1), major_1, std::max(minor_0, minor_1))
+        : begin_primitive(primitive, Coverage::Line, v1, std::min(minor_0, minor_1), major_0, std::max(minor_0, minor_1), major_1);
+    if (!covers)
+        return;
+
+    primitive.line_x_major = x_major;
+    primitive.line_minor_start = minor_start;
+    primitive.line_slope = slope;
+
+    // Attributes are interpolated along the major axis only.
+    const GsDrawState& state = states.back().state;
+    primitive.origin_x = static_cast<float>(a->x) / 16.0f;
+    primitive.origin_y = static_cast<float>(a->y) / 16.0f;
+    float* gradient = x_major ? primitive.dx : primitive.dy;
+    for (int i = 0; i < NUMBER_ATTRIBUTES; i++)
+    {
+        if (i <= ATTR_A && !state.iip)
+            continue;
+        primitive.base[i] = a->attributes[i];
+        gradient[i] = (b->attributes[i] - a->attributes[i]) / major_length;
+    }
+    primitive.z_base = a->z;
+    (x_major ? primitive.z_dx : primitive.z_dy) = (b->z - a->z) / major_length;
+
+    primitives.push_back(primitive);
+    bin_primitive(static_cast<uword>(primitives.size() - 1));
+}
+
+void GsRasterizer::add_triangle(const GsVertex& v0, const GsVertex& v1, const GsVertex& v2)
+{
+    // Make the edge equations positive inside the triangle.
+    const GsVertex* v[3] = {&v0, &v1, &v2};
+    const sdword area = static_cast<sdword>(v1.x - v0.x) * (v2.y - v0.y) - static_cast<sdword>(v2.x - v0.x) * (v1.y - v0.y);
+    if (area == 0)
+        return;
+    if (area < 0)
+        std::swap(v[1], v[2]);
+
+    const sword min_x = std::min({v0.x, v1.x, v2.x});
+    const sword max_x = std::max({v0.x, v1.x, v2.x});
+    const sword min_y = std::min({v0.y, v1.y, v2.y});
+    const sword max_y = std::max({v0.y, v1.y, v2.y});
+
+    Primitive primitive;
+    if (!begin_primitive(primitive, Coverage::Triangle, v2, ceil_pixel(min_x), ceil_pixel(min_y), max_x >> 4, max_y >> 4))
+        return;
+
+    // Edge equations, evaluated at pixel centers (x * 16, y * 16).
+    // Pixels on an edge are only drawn for top or left edges.
+    for (int i = 0; i < 3; i++)
+    {
+        const GsVertex& a = *v[i];
+        const GsVertex& b = *v[(i + 1) % 3];
+        const sdword dx = b.x - a.x;
+        const sdword dy = b.y - a.y;
+        const bool is_top_left = (dy < 0) || (dy == 0 && dx > 0);
+        primitive.edge_a[i] = -dy * 16;
+        primitive.edge_b[i] = dx * 16;
+        primitive.edge_c[i] = dy * a.x - dx * a.y - (is_top_left ? 0 : 1);
+    }
+
+    // Attribute planes.
+    const GsDrawState& state = states.back().state;
+    const float x0 = static_cast<float>(v0.x) / 16.0f;
+    const float y0 = static_cast<float>(v0.y) / 16.0f;
+    const float x10 = static_cast<float>(v1.x - v0.x) / 16.0f;
+    const float y10 = static_cast<float>(v1.y - v0.y) / 16.0f;
+    const float x20 = static_cast<float>(v2.x - v0.x) / 16.0f;
+    const float y20 = static_cast<float>(v2.y - v0.y) / 16.0f;
+    const double inverse_area = 256.0 / static_cast<double>(area);
+
+    primitive.origin_x = x0;
+    primitive.origin_y = y0;
+    for (int i = 0; i < NUMBER_ATTRIBUTES; i++)
+    {
+        if (i <= ATTR_A && !state.iip)
+            continue;
+        const float a10 = v1.attributes[i] - v0.attributes[i];
+        const float a20 = v2.attributes[i] - v0.attributes[i];
+        primitive.base[i] = v0.attributes[i];
+        primitive.dx[i] = static_cast<float>((a10 * y20 - a20 * y10) * inverse_area);
+        primitive.dy[i] = static_cast<float>((a20 * x10 - a10 * x20) * inverse_area);
+    }
+    const double z10 = v1.z - v0.z;
+    const double z20 = v2.z - v0.z;
+    primitive.z_base = v0.z;
+    primitive.z_dx = (z10 * y20 - z20 * y10) * inverse_area;
+    primitive.z_dy = (z20 * x10 - z10 * x20) * inverse_area;
+
+    primitives.push_back(primitive);
+    bin_primitive(static_cast<uword>(primitives.size() - 1));
+}
+
+void GsRasterizer::add_sprite(const GsVertex& v0, const GsVertex& v1)
+{
+    const sword min_x = std::min(v0.x, v1.x);
+    const sword max_x = std::max(v0.x, v1.x);
+    const sword min_y = std::min(v0.y, v1.y);
+    const sword max_y = std::max(v0.y, v1.y);
+    if (min_x == max_x || min_y == max_y)
+        return;
+
+    Primitive primitive;
+    if (!begin_primitive(primitive, Coverage::Rectangle, v1, ceil_pixel(min_x), ceil_pixel(min_y), ceil_pixel(max_x) - 1, ceil_pixel(max_y) - 1))
+        return;
+
+    // Texture coordinates are interpolated from v0 to v1, S/U along X and T/V along Y.
+    primitive.origin_x = static_cast<float>(v0.x) / 16.0f;
+    primitive.origin_y = static_cast<float>(v0.y) / 16.0f;
+    primitive.base[ATTR_S] = v0.attributes[ATTR_S];
+    primitive.base[ATTR_T] = v0.attributes[ATTR_T];
+    primitive.dx[ATTR_S] = (v1.attributes[ATTR_S] - v0.attributes[ATTR_S]) * 16.0f / static_cast<float>(v1.x - v0.x);
+    primitive.dy[ATTR_T] = (v1.attributes[ATTR_T] - v0.attributes[ATTR_T]) * 16.0f / static_cast<float>(v1.y - v0.y);
+
+    primitives.push_back(primitive);
+    bin_primitive(static_cast<uword>(primitives.size() - 1));
+}
+
+void GsRasterizer::bin_primitive(const uword index)
+{
+    const Primitive& primitive = primitives[index];
+    const int tile_x0 = primitive.x0 >> TILE_SIZE_LOG2;
+    const int tile_y0 = primitive.y0 >> TILE_SIZE_LOG2;
+    const int tile_x1 = primitive.x1 >> TILE_SIZE_LOG2;
+    const int tile_y1 = primitive.y1 >> TILE_SIZE_LOG2;
+
+    for (int tile_y = tile_y0; tile_y <= tile_y1; tile_y++)
+    {
+        for (int tile_x = tile_x0; tile_x <= tile_x1; tile_x++)
+        {
+            if (primitive.coverage == Coverage::Triangle && !is_triangle_in_tile(primitive, tile_x << TILE_SIZE_LOG2, tile_y << TILE_SIZE_LOG2))
+                continue;
+
+            const uword tile = tile_y * NUMBER_TILES_X + tile_x;
+            auto& bin = tile_primitives[tile];
+            if (bin.empty())
+                touched_tiles.push_back(tile);
+            bin.push_back(index);
+
+#if defined(BUILD_DEBUG)
+            number_tile_bins++;
+#endif
+        }
+    }
+
+#if defined(BUILD_DEBUG)
+    number_primitives++;
+#endif
+
+    if (primitives.size() >= MAX_PENDING_PRIMITIVES)
+        flush();
+}
+
+bool GsRasterizer::is_triangle_in_tile(const Primitive& primitive, const int tile_x0, const int tile_y0)
+{
+    // Trivially reject the tile if its corner furthest inside any edge is outside it.
+    for (int i = 0; i < 3; i++)
+    {
+        const sdword x = tile_x0 + ((primitive.edge_a[i] > 0) ? (TILE_SIZE - 1) : 0);
+        const sdword y = tile_y0 + ((primitive.edge_b[i] > 0) ? (TILE_SIZE - 1) : 0);
+        if (primitive.edge_a[i] * x + primitive.edge_b[i] * y + primitive.edge_c[i] < 0)
+            return false;
+    }
+    return true;
+}
+
+void GsRasterizer::flush()
+{
+    if (primitives.empty())
+        return;
+
+    // Only wake the workers when there is more than one tile to share.
+    if (workers.empty() || touched_tiles.size() < 2)
+    {
+        next_tile.store(0, std::memory_order_relaxed);
+        draw_tiles();
+    }
+    else
+    {
+        next_tile.store(0, std::memory_order_relaxed);
+        workers_finished.store(0, std::memory_order_relaxed);
+        flush_generation.fetch_add(1, std::memory_order_release);
+        start_event.notify();
+
+        draw_tiles();
+
+        const int number_workers = static_cast<int>(workers.size());
+        finish_event.wait_until([this, number_workers] { return workers_finished.load(std::memory_order_acquire) == number_workers; });
+    }
+
+    for (const uword tile : touched_tiles)
+        tile_primitives[tile].clear();
+    touched_tiles.clear();
+    primitives.clear();
+
+    // Keep the current state for the primitives added after this.
+    states.erase(states.begin(), states.end() - 1);
+
+#if defined(BUILD_DEBUG)
+    number_flushes++;
+#endif
+}
+
+void GsRasterizer::draw_tiles()
+{
+    const size_t number_tiles = touched_tiles.size();
+    while (true)
+    {
+        const size_t index = next_tile.fetch_add(1, std::memory_order_relaxed);
+        if (index >= number_tiles)
+            break;
+        draw_tile(touched_tiles[index]);
+    }
+}
+
+void GsRasterizer::draw_tile(const uword tile)
+{
+    const int tile_x0 = (tile % NUMBER_TILES_X) << TILE_SIZE_LOG2;
+    const int tile_y0 = (tile / NUMBER_TILES_X) << TILE_SIZE_LOG2;
+
+    for (const uword index : tile_primitives[tile])
+    {
+        const Primitive& primitive = primitives[index];
+        const int x0 = std::max(primitive.x0, tile_x0);
+        const int y0 = std::max(primitive.y0, tile_y0);
+        const int x1 = std::min(primitive.x1, tile_x0 + TILE_SIZE - 1);
+        const int y1 = std::min(primitive.y1, tile_y0 + TILE_SIZE - 1);
+        if (x0 <= x1 && y0 <= y1)
+            draw_primitive(primitive, states[primitive.state_index], x0, y0, x1, y1);
+    }
+
+#if defined(BUILD_DEBUG)
+    number_tiles_drawn.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+void GsRasterizer::draw_primitive(const Primitive& primitive, const DrawState& state, const int x0, const int y0, const int x1, const int y1)
+{
+    switch (primitive.coverage)
+    {
+    case Coverage::Rectangle:
+    {
+        for (int y = y0; y <= y1; y++)
+            emit_span(primitive, state, memory, x0, y, x1 - x0 + 1);
+        break;
+    }
+    case Coverage::Triangle:
+    {
+        for (int y = y0; y <= y1; y++)
+        {
+            sdword e0 = primitive.edge_a[0] * x0 + primitive.edge_b[0] * y + primitive.edge_c[0];
+            sdword e1 = primitive.edge_a[1] * x0 + primitive.edge_b[1] * y + primitive.edge_c[1];
+            sdword e2 = primitive.edge_a[2] * x0 + primitive.edge_b[2] * y + primitive.edge_c[2];
+
+            // The covered pixels of a row are contiguous.
+            int start = -1;
+            int x = x0;
+            for (; x <= x1; x++)
+            {
+                const bool inside = (e0 | e1 | e2) >= 0;
+                if (inside && start < 0)
+                    start = x;
+                else if (!inside && start >= 0)
+                    break;
+                e0 += primitive.edge_a[0];
+                e1 += primitive.edge_a[1];
+                e2 += primitive.edge_a[2];
+            }
+
+            if (start >= 0)
+                emit_span(primitive, state, memory, start, y, x - start);
+        }
+        break;
+    }
+    case Coverage::Line:
+    {
+        const int major_0 = primitive.line_x_major ? x0 : y0;
+        const int major_1 = primitive.line_x_major ? x1 : y1;
+        const int minor_0 = primitive.line_x_major ? y0 : x0;
+        const int minor_1 = primitive.line_x_major ? y1 : x1;
+        for (int major = major_0; major <= major_1; major++)
+        {
+            const int minor = static_cast<int>(std::floor(primitive.line_minor_start + primitive.line_slope * major + 0.5f));
+            if (minor < minor_0 || minor > minor_1)
+                continue;
+            if (primitive.line_x_major)
+                emit_span(primitive, state, memory, major, minor, 1);
+            else
+                emit_span(primitive, state, memory, minor, major, 1);
+        }
+        break;
+    }
+    }
+}
+
+void GsRasterizer::emit_span(const Primitive& primitive, const DrawState& state, GsLocalMemory& memory, const int x, const int y, const int count)
+{
+    Span span;
+    span.x = x;
+    span.y = y;
+    span.count = count;
+
+    const float offset_x = static_cast<float>(x) - primitive.origin_x;
+    const float offset_y = static_cast<float>(y) - primitive.origin_y;
+    for (int i = 0; i < NUMBER_ATTRIBUTES; i++)
+    {
+        span.values[i] = primitive.base[i] + primitive.dx[i] * offset_x + primitive.dy[i] * offset_y;
+        span.steps[i] = primitive.dx[i];
+    }
+    span.z = primitive.z_base + primitive.z_dx * offset_x + primitive.z_dy * offset_y;
+    span.z_step = primitive.z_dx;
+
+    state.shade_span(memory, state.state, span);
+}
+
+void GsRasterizer::worker_main()
+{
+    // Generation 0 is never drawn, see flush().
+    uword generation = 0;
+    while (true)
+    {
+        start_event.wait_until([this, generation] {
+            return exit.load(std::memory_order_acquire) || flush_generation.load(std::memory_order_acquire) != generation;
+        });
+        if (exit.load(std::memory_order_acquire))
+            return;
+
+        generation = flush_generation.load(std::memory_order_acquire);
+        draw_tiles();
+
+        workers_finished.fetch_add(1, std::memory_order_acq_rel);
+        finish_event.notify();
+    }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Parking.hpp>
+
+#include "Common/Types/Primitive.hpp"
+#include "Controller/Gs/Core/GsDrawState.hpp"
+#include "Controller/Gs/Core/GsPixelPipeline.hpp"
+#include "Controller/Gs/Core/GsPixelPipelineCompiler.hpp"
+#include "Resources/Gs/GsLocalMemory.hpp"
+
+/// A vertex in window coordinates, as set up by the GS core.
+/// X and Y are 12.4 fixed point (XYZ minus XYOFFSET), attributes are indexed
+/// by GsPixelPipeline::Attribute.
+struct GsVertex
+{
+    sword x;
+    sword y;
+    double z;
+    float attributes[GsPixelPipeline::NUMBER_ATTRIBUTES];
+};
+
+/// Tile-binned software GS rasterizer.
+/// Primitives are set up as they are added (edge equations and attribute
+/// gradients), and binned into the 32x32 pixel tiles they cover. Nothing is
+/// drawn until flush(), which distributes the covered tiles across a pool of
+/// threads - each tile draws all of its primitives in order, so the results
+/// are the same as drawing everything in order on one thread.
+/// Tiles map to different frame/Z buffer memory as long as the buffers don't
+/// overlap each other (ie: the caller flushes on FRAME/ZBUF changes).
+/// Spans are shaded by pixel pipelines compiled for each draw state when
+/// enabled (see GsPixelPipelineCompiler), or by the interpreter.
+/// Independent of the rest of the core, so it can be driven (and benchmarked)
+/// with just a GsLocalMemory.
+class GsRasterizer
+{
+public:
+    static constexpr int TILE_SIZE_LOG2 = 5;
+    static constexpr int TILE_SIZE = 1 << TILE_SIZE_LOG2;
+    static constexpr int WINDOW_SIZE = 2048;
+    static constexpr int NUMBER_TILES_X = WINDOW_SIZE / TILE_SIZE;
+    static constexpr int NUMBER_TILES = NUMBER_TILES_X * NUMBER_TILES_X;
+
+    /// Creates the rasterizer with the number of threads used for drawing
+    /// (including the caller of flush()), at least 1, and if the pixel
+    /// pipelines should be compiled.
+    GsRasterizer(GsLocalMemory& memory, const int number_threads, const bool compile_pipelines);
+    ~GsRasterizer();
+
+    /// Sets the draw state used for the primitives added after this.
+    void set_draw_state(const GsDrawState& state);
+
+    /// Adds a primitive, using the current draw state.
+    /// Colours are taken from the last vertex for flat shading (PRIM.IIP = 0),
+    /// and sprites take all attributes except the texture coordinates from the last vertex.
+    void add_point(const GsVertex& v0);
+    void add_line(const GsVertex& v0, const GsVertex& v1);
+    void add_triangle(const GsVertex& v0, const GsVertex& v1, const GsVertex& v2);
+    void add_sprite(const GsVertex& v0, const GsVertex& v1);
+
+    /// Draws all pending primitives, returning when they have been written to memory.
+    void flush();
+
+    /// Returns the number of primitives pending (added since the last flush).
+    size_t get_number_pending() const
+    {
+        return primitives.size();
+    }
+
+    int get_number_threads() const
+    {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    const GsPixelPipelineCompiler& get_pipeline_compiler() const
+    {
+        return pipeline_compiler;
+    }
+
+#if defined(BUILD_DEBUG)
+    size_t get_number_flushes() const { return number_flushes; }
+    size_t get_number_primitives() const { return number_primitives; }
+    size_t get_number_tile_bins() const { return number_tile_bins; }
+    size_t get_number_tiles_drawn() const { return number_tiles_drawn; }
+#endif
+
+private:
+    /// How the pixels covered by a primitive are found.
+    enum class Coverage
+    {
+        Triangle,
+        Rectangle,
+        Line
+    };
+
+    /// A set up primitive. Attributes are planes: value(x, y) = base +
+    /// dx * (x - origin_x) + dy * (y - origin_y), in pixel units.
+    struct Primitive
+    {
+        Coverage coverage;
+        size_t state_index;
+
+        /// Covered pixel bounds (inclusive), clipped to the scissor area.
+        int x0, y0, x1, y1;
+
+        /// Triangle edge equations, in 1/16 pixel units: inside when
+        /// edge_a * x + edge_b * y + edge_c >= 0 (x, y in pixels) for all edges.
+        sdword edge_a[3];
+        sdword edge_b[3];
+        sdword edge_c[3];
+
+        /// Line major axis (true = X), and its minor coordinate start and slope.
+        bool line_x_major;
+        float line_minor_start;
+        float line_slope;
+
+        float origin_x;
+        float origin_y;
+        float base[GsPixelPipeline::NUMBER_ATTRIBUTES];
+        float dx[GsPixelPipeline::NUMBER_ATTRIBUTES];
+        float dy[GsPixelPipeline::NUMBER_ATTRIBUTES];
+        double z_base;
+        double z_dx;
+        double z_dy;
+    };
+
+    struct DrawState
+    {
+        GsDrawState state;
+        GsPixelPipeline::SpanFunction shade_span;
+    };
+
+    GsLocalMemory& memory;
+
+    /// Pixel pipeline compiler, only used from set_draw_state().
+    bool compile_pipelines;
+    GsPixelPipelineCompiler pipeline_compiler;
+
+    std::vector<DrawState> states;
+    std::vector<Primitive> primitives;
+
+    /// Primitive indices binned per tile, and the list of tiles with any primitives.
+    std::vector<std::vector<uword>> tile_primitives;
+    std::vector<uword> touched_tiles;
+
+    /// Worker threads (number_threads - 1), woken by a new flush generation.
+    std::vector<std::thread> workers;
+    std::atomic<uword> flush_generation;
+    std::atomic<size_t> next_tile;
+    std::atomic<int> workers_finished;
+    std::atomic<bool> exit;
+    Parking::Event start_event;
+    Parking::Event finish_event;
+
+#if defined(BUILD_DEBUG)
+    size_t number_flushes;
+    size_t number_primitives;
+    size_t number_tile_bins;
+    std::atomic<size_t> number_tiles_drawn;
+#endif
+
+    /// Initialises the common parts of a primitive, returning false if it
+    /// covers no pixels within the scissor area (which is then dropped).
+    bool begin_primitive(Primitive& primitive, const Coverage coverage, const GsVertex& attribute_vertex, int x0, int y0, int x1, int y1);
+
+    /// Bins the primitive (the last added) into the tiles it covers.
+    void bin_primitive(const uword index);
+
+    /// Returns if a triangle might cover any pixels of the tile.
+    static bool is_triangle_in_tile(const Primitive& primitive, const int tile_x0, const int tile_y0);
+
+    /// Draws tiles until there are none left, for the current flush.
+    void draw_tiles();
+    void draw_tile(const uword tile);
+
+    /// Emits spans of a primitive within the (inclusive) area given.
+    void draw_primitive(const Primitive& primitive, const DrawState& state, int x0, int y0, int x1, int y1);
+    static void emit_span(const Primitive& primitive, const DrawState& state, GsLocalMemory& memory, const int x, const int y, const int count);
+
+    void worker_main();
+};
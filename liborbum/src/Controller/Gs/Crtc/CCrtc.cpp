@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -6,9 +7,25 @@
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 
+namespace
+{
+/// Single HBlank event. The amount has to be set explicitly, as brace
+/// initialisation would set the first union member (time_us) instead.
+ControllerEvent make_hblank_event()
+{
+    ControllerEvent event{ControllerEvent::Type::HBlank, {}};
+    event.data.amount = 1;
+    return event;
+}
+} // namespace
+
 CCrtc::CCrtc(Core* core) :
-    CController(core)
+    CController(core),
+    row(0)
 {
+    // The first scanline starts with the active pixels (half of the scanline).
+    next_hblank_cycle = static_cast<double>(core->get_scheduler().get_current_cycle()) + scanline_cycles() / 2;
+    core->get_scheduler().schedule_at(ControllerType::Type::Crtc, make_hblank_event(), static_cast<udword>(next_hblank_cycle));
 }
 
 void CCrtc::handle_event(const ControllerEvent& event)
@@ -17,9 +34,13 @@ void CCrtc::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
-        while (ticks_remaining > 0)
-            ticks_remaining -= time_step(ticks_remaining);
+        // Nothing to do - driven by scheduled events.
+        break;
+    }
+    case ControllerEvent::Type::HBlank:
+    {
+        for (int i = 0; i < event.data.amount; i++)
+            handle_hblank();
         break;
     }
     default:
@@ -29,79 +50,124 @@ void CCrtc::handle_event(const ControllerEvent& event)
     }
 }
 
-int CCrtc::time_to_ticks(const double time_us)
+double CCrtc::scanline_cycles() const
 {
-    int ticks = static_cast<int>(time_us / 1.0e6 * Constants::GS::CRTC::PCRTC_CLK_SPEED_DEFAULT * core->get_options().system_bias_crtc);
-
-    if (ticks < 10)
-    {
-        static bool warned = false;
-        if (!warned)
-        {
-            BOOST_LOG(Core::get_logger()) << "CRTC ticks too low - increase time delta";
-            warned = true;
-        }
-    }
-
-    return ticks;
+    // A scanline is the active pixels (resX = 640) followed by the same period of horizontal blank.
+    const double pixel_clock_speed = Constants::GS::CRTC::PCRTC_CLK_SPEED_DEFAULT * core->get_options().system_bias_crtc;
+    return (640 * 2) / pixel_clock_speed * EventScheduler::MASTER_CLK_SPEED;
 }
 
-int CCrtc::time_step(const int ticks_available)
+void CCrtc::handle_hblank()
 {
     auto& r = core->get_resources();
 
-    // TODO: quick hack to get started...
-    static int col = 0;
-    static int row = 0;
+    // Send HBlank start.
+    auto hblank_event = make_hblank_event();
+    core->enqueue_controller_event(ControllerType::Type::EeTimers, hblank_event);
+    core->enqueue_controller_event(ControllerType::Type::IopTimers, hblank_event);
 
-    if (col == -1)
+    // Copy scanline to host render.
+    // core->render_scan_line(&raw_row_pixels);
+
+    if (row == -1)
     {
-        // Send HBlank end.
+        auto _ee_lock = r.ee.intc.stat.scope_lock();
+        auto _iop_lock = r.iop.intc.stat.scope_lock();
+
+        // Send VBlank end.
+        r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBOF, 1);
+        r.iop.intc.stat.insert_field(IopIntcRegister_Stat::EVBLANK, 1);
+        //BOOST_LOG(Core::get_logger()) << "EVBLANK fired!";
     }
 
-    col++;
+    row++;
 
-    if (col > 639)
+    if (row > 223)
     {
-        col = -640;
-
-        // Send HBlank start.
-        auto hblank_event = ControllerEvent{ControllerEvent::Type::HBlank, 1};
-        core->enqueue_controller_event(ControllerType::Type::EeTimers, hblank_event);
-        core->enqueue_controller_event(ControllerType::Type::IopTimers, hblank_event);
-
-        // Copy scanline to host render.
-        // core->render_scan_line(&raw_row_pixels);
+        row = -224;
 
-        if (row == -1)
-        {
-            auto _ee_lock = r.ee.intc.stat.scope_lock();
-            auto _iop_lock = r.iop.intc.stat.scope_lock();
+        auto _ee_lock = r.ee.intc.stat.scope_lock();
+        auto _iop_lock = r.iop.intc.stat.scope_lock();
 
-            // Send VBlank end.
-            r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBOF, 1);
-            r.iop.intc.stat.insert_field(IopIntcRegister_Stat::EVBLANK, 1);
-            //BOOST_LOG(Core::get_logger()) << "EVBLANK fired!";
-        }
+        // Send VBlank start.
+        r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBON, 1);
+        r.iop.intc.stat.insert_field(IopIntcRegister_Stat::VBLANK, 1);
+        //BOOST_LOG(Core::get_logger()) << "VBLANK fired!";
 
-        row++;
+        scan_out();
+    }
 
-        if (row > 223)
-        {
-            row = -224;
+    // Schedule the next HBlank.
+    next_hblank_cycle += scanline_cycles();
+    core->get_scheduler().schedule_at(ControllerType::Type::Crtc, make_hblank_event(), static_cast<udword>(next_hblank_cycle));
+}
 
-            auto _ee_lock = r.ee.intc.stat.scope_lock();
-            auto _iop_lock = r.iop.intc.stat.scope_lock();
+void CCrtc::scan_out()
+{
+    auto& r = core->get_resources();
 
-            // Send VBlank start.
-            r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBON, 1);
-            r.iop.intc.stat.insert_field(IopIntcRegister_Stat::VBLANK, 1);
-            //BOOST_LOG(Core::get_logger()) << "VBLANK fired!";
+    GsRegister_Dispfb* dispfb;
+    GsRegister_Display* display;
+    if (r.gs.pmode.extract_field(GsRegister_Pmode::EN1))
+    {
+        dispfb = &r.gs.dispfb1;
+        display = &r.gs.display1;
+    }
+    else if (r.gs.pmode.extract_field(GsRegister_Pmode::EN2))
+    {
+        dispfb = &r.gs.dispfb2;
+        display = &r.gs.display2;
+    }
+    else
+    {
+        return;
+    }
 
-            // Tell core to render frame.
-            // core->render_frame();
+    const uword fbp = static_cast<uword>(dispfb->extract_field(GsRegister_Dispfb::FBP)) * 32;
+    const uword fbw = static_cast<uword>(dispfb->extract_field(GsRegister_Dispfb::FBW));
+    const uword psm = static_cast<uword>(dispfb->extract_field(GsRegister_Dispfb::PSM));
+    const uword dbx = static_cast<uword>(dispfb->extract_field(GsRegister_Dispfb::DBX));
+    const uword dby = static_cast<uword>(dispfb->extract_field(GsRegister_Dispfb::DBY));
+    const uword magh = static_cast<uword>(display->extract_field(GsRegister_Display::MAGH)) + 1;
+    const uword magv = static_cast<uword>(display->extract_field(GsRegister_Display::MAGV)) + 1;
+    const uword width = std::min<uword>((static_cast<uword>(display->extract_field(GsRegister_Display::DW)) + 1) / magh, 2048);
+    const uword height = std::min<uword>((static_cast<uword>(display->extract_field(GsRegister_Display::DH)) + 1) / magv, 2048);
+
+    // Only the colour formats can be displayed.
+    const int bits = GsLocalMemory::transfer_bits_per_pixel(psm);
+    if (!bits || (psm & 0x30))
+        return;
+
+    // Wait for the GS to draw everything it has been sent so far.
+    r.gs.command_ring.sync();
+
+    const size_t number_pixels = static_cast<size_t>(width) * height;
+    scan_out_data.resize(number_pixels * bits / 8);
+    r.gs.memory.read_pixels(psm, fbp, fbw, dbx, dby, width, height, scan_out_data.data());
+
+    auto& frame_buffer = r.gs.crtc.frame_buffer;
+    frame_buffer.resize(number_pixels);
+    const ubyte* data = scan_out_data.data();
+    for (size_t i = 0; i < number_pixels; i++)
+    {
+        switch (bits)
+        {
+        case 32:
+            frame_buffer[i] = data[i * 4] | (data[i * 4 + 1] << 8) | (data[i * 4 + 2] << 16) | 0xFF000000;
+            break;
+        case 24:
+            frame_buffer[i] = data[i * 3] | (data[i * 3 + 1] << 8) | (data[i * 3 + 2] << 16) | 0xFF000000;
+            break;
+        default:
+        {
+            const uword value = data[i * 2] | (data[i * 2 + 1] << 8);
+            frame_buffer[i] = ((value & 0x1F) << 3) | (((value >> 5) & 0x1F) << 11) | (((value >> 10) & 0x1F) << 19) | 0xFF000000;
+            break;
+        }
         }
     }
 
-    return 1;
+    r.gs.crtc.frame_width = width;
+    r.gs.crtc.frame_height = height;
+    r.gs.crtc.frame_count++;
 }
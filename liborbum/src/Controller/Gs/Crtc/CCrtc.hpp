@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+
+#include "Common/Types/Primitive.hpp"
 #include "Controller/CController.hpp"
 
 class Core;
@@ -10,6 +13,8 @@ class Core;
 /// SCPH-39001 service manual.
 /// TODO: I have no idea how this works, it is based of guessed logic and pixel clock speed from resX and fH.
 ///       Read through the GS mode selector docs above / general info on CRTC's.
+/// The CRTC is driven by the event scheduler: it schedules a HBlank event to
+/// itself for the start of each horizontal blank, rather than being ticked per pixel.
 class CCrtc : public CController
 {
 public:
@@ -17,11 +22,32 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
-    /// Converts a time duration into the number of ticks that would have occurred.
-    int time_to_ticks(const double time_us);
+    bool is_time_driven() const override
+    {
+        return false;
+    }
+
+    /// Returns the number of master cycles (see EventScheduler) per scanline.
+    double scanline_cycles() const;
 
-    /// Steps through the CRTC, incrementing the number of pixels based on the CRTC configuration.
-    /// When a row of pixels has been completed (scanline), copy's the row to the VM buffer and sends a HBlank clock event to EE/IOP Timers.
+    /// Handles the start of a horizontal blank (end of a scanline of pixels), sending a HBlank clock event to EE/IOP Timers.
     /// When a whole frame/field has been completed, calls the VM render function and sends a VBlank start/end interrupt to the EE/IOP Intc.
-    int time_step(const int ticks_available);
-};
\ No newline at end of file
+    /// Schedules the next HBlank.
+    void handle_hblank();
+
+    /// Reads the displayed area of the frame buffer out of GS local memory
+    /// into the host frame buffer (RCrtc::frame_buffer), converted to 32-bit.
+    /// Only one read circuit is shown (circuit 1 if enabled, otherwise circuit
+    /// 2) - the merge circuit (PMODE.ALP, MMOD) isn't emulated.
+    void scan_out();
+
+private:
+    /// Current scanline (negative = vertical blank).
+    int row;
+
+    /// Master cycle of the next HBlank (fractional to avoid drift).
+    double next_hblank_cycle;
+
+    /// Frame buffer data read by scan_out(), in the transfer format.
+    std::vector<ubyte> scan_out_data;
+};
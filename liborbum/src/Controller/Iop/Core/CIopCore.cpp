@@ -21,12 +21,6 @@ std::atomic_bool DEBUG_IN_CONTROLLER_IOPCORE = false;
 CIopCore::CIopCore(Core* core) :
     CController(core)
 {
-    auto translation_fallback = [this](const uptr virtual_address, const MmuRwAccess rw_access) {
-        return translate_address_fallback(virtual_address, rw_access);
-    };
-
-    translation_cache_data.set_fallback_lookup(translation_fallback);
-    translation_cache_inst.set_fallback_lookup(translation_fallback);
 }
 
 CIopCore::~CIopCore()
@@ -36,6 +30,11 @@ CIopCore::~CIopCore()
     BOOST_LOG(Core::get_logger()) << boost::format("IOP Core exiting @ Cycle = 0x%llX, PC = 0x%08X.")
                                          % DEBUG_LOOP_COUNTER
                                          % r.iop.core.r3000.pc.read_uword();
+    BOOST_LOG(Core::get_logger()) << boost::format("IOP Core translation cache: data hits = %d, data misses = %d, inst hits = %d, inst misses = %d.")
+                                         % translation_cache_data.get_hits()
+                                         % translation_cache_data.get_misses()
+                                         % translation_cache_inst.get_hits()
+                                         % translation_cache_inst.get_misses();
 #endif
 }
 
@@ -93,7 +92,7 @@ void CIopCore::handle_interrupt_check()
     // Interrupt exceptions are only taken when conditions are correct.
     if (!cop0.status.interrupts_masked)
     {
-        uword ip_cause = cop0.cause.extract_field(IopCoreCop0Register_Cause::IP);
+        uword ip_cause = cop0.cause.get_irq_lines();
         uword im_status = cop0.status.extract_field(IopCoreCop0Register_Status::IM);
         if (ip_cause & im_status)
         {
@@ -107,6 +106,33 @@ void CIopCore::handle_interrupt_check()
     }
 }
 
+bool CIopCore::is_interrupt_pending()
+{
+    auto& r = core->get_resources();
+    auto& cop0 = r.iop.core.cop0;
+
+    if (cop0.cause.get_irq_lines() & cop0.status.extract_field(IopCoreCop0Register_Status::IM))
+        return true;
+
+    auto _lock = r.iop.intc.stat.scope_lock();
+    return (r.iop.intc.stat.read_uword() & r.iop.intc.mask.read_uword()) != 0;
+}
+
+int CIopCore::ticks_to_next_event(const int ticks_remaining)
+{
+    // The time slice ends at the current scheduler cycle, and events up to it
+    // were delivered at the start - only events scheduled since can fall within it.
+    auto& scheduler = core->get_scheduler();
+    const udword slice_end_cycle = scheduler.get_current_cycle();
+    udword next_event_cycle;
+    if (!scheduler.get_next_event_cycle(next_event_cycle) || next_event_cycle >= slice_end_cycle)
+        return ticks_remaining;
+
+    const double time_after_event_us = EventScheduler::cycles_to_time(slice_end_cycle - next_event_cycle);
+    const int ticks_after_event = static_cast<int>(time_after_event_us / 1.0e6 * Constants::IOP::IOPCore::IOPCORE_CLK_SPEED * core->get_options().system_bias_iopcore);
+    return std::max(0, ticks_remaining - ticks_after_event);
+}
+
 #if defined(BUILD_DEBUG)
 void CIopCore::debug_print_interrupt_info()
 {
@@ -212,7 +238,7 @@ void CIopCore::debug_print_ksprintf()
 
     if (pc == 0x86D0)
     {
-        auto& memory = r.iop.main_memory.get_memory();
+        const ubyte* memory = r.iop.main_memory.get_memory();
 
         // Get format string ($a2), replace all newline characters.
         const uptr format_ptr = r.iop.core.r3000.gpr[6].read_uword();
@@ -334,9 +360,8 @@ void CIopCore::handle_exception(const IopCoreException exception)
         pc.offset(-static_cast<sword>(Constants::MIPS::SIZE_MIPS_INSTRUCTION));
     }
 
-    // Flush translation caches (context change).
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
+    // No need to flush the translation caches - the context change is handled
+    // by the translation context tag (see COP0.Status).
 }
 
 std::optional<uptr> CIopCore::translate_address_data(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -364,10 +389,12 @@ std::optional<uptr> CIopCore::translate_address_data(const uptr virtual_address,
 
     // Check if a write is being performed with isolate cache turned on - don't run through the cache.
     auto& status = r.iop.core.cop0.status;
-    if (rw_access == WRITE && status.extract_field(IopCoreCop0Register_Status::ISC))
+    if (rw_access == WRITE && status.isolate_cache)
         return translate_address_fallback(virtual_address, rw_access);
 
-    return translation_cache_data.lookup(virtual_address, rw_access);
+    return translation_cache_data.lookup(virtual_address, rw_access, status.translation_context, [this](const uptr virtual_address, const MmuRwAccess rw_access) {
+        return translate_address_fallback(virtual_address, rw_access);
+    });
 }
 
 std::optional<uptr> CIopCore::translate_address_inst(const uptr virtual_address)
@@ -393,7 +420,10 @@ std::optional<uptr> CIopCore::translate_address_inst(const uptr virtual_address)
     }
 #endif
 
-    return translation_cache_inst.lookup(virtual_address, READ);
+    auto& r = core->get_resources();
+    return translation_cache_inst.lookup(virtual_address, READ, r.iop.core.cop0.status.translation_context, [this](const uptr virtual_address, const MmuRwAccess rw_access) {
+        return translate_address_fallback(virtual_address, rw_access);
+    });
 }
 
 std::optional<uptr> CIopCore::translate_address_fallback(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -2,12 +2,11 @@
 
 #include <optional>
 
-#include <Caches.hpp>
-
 #include "Common/Types/Mips/MmuAccess.hpp"
 #include "Common/Types/Primitive.hpp"
 #include "Common/Types/TranslationCache/TranslationCache.hpp"
 #include "Controller/CController.hpp"
+#include "Resources/Iop/Core/IopCoreCop0Registers.hpp"
 #include "Resources/Iop/Core/IopCoreException.hpp"
 
 class Core;
@@ -46,8 +45,20 @@ protected:
     bool handle_no_over_or_underflow_32_check(const sword x, const sword y);
 
     /// Checks if any of the interrupt lines have an IRQ pending, and raises an interrupt exception.
+    /// The IRQ lines are raised/cleared by the interrupt sources as their state changes, so this
+    /// is cheap enough to call before every instruction (a lock free load, plus the Status register).
     void handle_interrupt_check();
 
+    /// Returns if an interrupt is pending, either on the COP0 IRQ lines (not yet
+    /// taken), or at the INTC (not yet passed on to the COP0).
+    /// Idle loop skips (see MipsIdleLoop) stop here, as the interrupt ends the loop.
+    bool is_interrupt_pending();
+
+    /// Returns the number of ticks out of the ticks remaining in the time slice
+    /// that run before the next scheduled event (see EventScheduler).
+    /// Idle loop skips stop here, as the event may change the memory polled.
+    int ticks_to_next_event(const int ticks_remaining);
+
 #if defined(BUILD_DEBUG)
     /// Prints debug information about interrupt sources.
     void debug_print_interrupt_info();
@@ -67,9 +78,10 @@ protected:
     std::optional<uptr> translate_address_inst(const uptr virtual_address);
 
     /// Address translation cache, see translate_address().
-    /// Note: caches will be flushed when the operating context changes (visibility).
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_data;
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_inst;
+    /// Entries are tagged by the COP0 translation context, so they remain valid
+    /// across exceptions (the IOP has no TLB, so they are never flushed).
+    TranslationCache<IopCoreCop0Register_Status::NUMBER_TRANSLATION_CONTEXTS> translation_cache_data;
+    TranslationCache<IopCoreCop0Register_Status::NUMBER_TRANSLATION_CONTEXTS> translation_cache_inst;
 
 private:
     /// Converts a time duration into the number of ticks that would have occurred.
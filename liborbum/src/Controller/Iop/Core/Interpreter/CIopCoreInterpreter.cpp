@@ -10,6 +10,17 @@ CIopCoreInterpreter::CIopCoreInterpreter(Core* core) :
 {
 }
 
+CIopCoreInterpreter::~CIopCoreInterpreter()
+{
+#if defined(BUILD_DEBUG)
+    BOOST_LOG(Core::get_logger()) << boost::format("IOP Core idle loops: skips = %d, ticks skipped = %d.")
+                                         % idle_loop_stats.get_number_skips()
+                                         % idle_loop_stats.get_ticks_skipped();
+    for (const auto& [pc, entry] : idle_loop_stats.get_top_entries(8))
+        BOOST_LOG(Core::get_logger()) << boost::format("    PC = 0x%08X: skips = %d, ticks skipped = %d.") % pc % entry.number_skips % entry.ticks_skipped;
+#endif
+}
+
 int CIopCoreInterpreter::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
@@ -54,6 +65,7 @@ int CIopCoreInterpreter::time_step(const int ticks_available)
 #endif
 
     // Run the instruction.
+    const bool is_delay_slot = r.iop.core.r3000.bdelay.is_branch_pending();
     auto impl_index = inst.get_info()->impl_index;
     (this->*IOP_INSTRUCTION_TABLE[impl_index])(inst);
 
@@ -65,10 +77,80 @@ int CIopCoreInterpreter::time_step(const int ticks_available)
     DEBUG_LOOP_COUNTER++;
 #endif
 
+    // Fast-forward if a short backwards branch was just taken, closing an idle loop.
+    if (is_delay_slot)
+    {
+        const uptr next_pc_address = r.iop.core.r3000.pc.read_uword();
+        if ((next_pc_address <= pc_address) && ((pc_address - next_pc_address) < MipsIdleLoop::MAX_LOOP_LENGTH * Constants::MIPS::SIZE_MIPS_INSTRUCTION))
+            return 3 + handle_idle_loop_skip(next_pc_address, pc_address, physical_address, ticks_available - 3);
+    }
+
     // Return the number of cycles completed.
     return 3; // TODO: fix CPI's. inst.get_info()->cpi;
 }
 
+int CIopCoreInterpreter::handle_idle_loop_skip(const uptr start_address, const uptr end_address, const uptr end_physical_address, const int ticks_remaining)
+{
+    auto& r = core->get_resources();
+
+    if (!core->get_options().idle_loop_skip || ticks_remaining <= 0)
+        return 0;
+
+    // Loops crossing a page boundary are not considered, as the physical
+    // address range might not be contiguous.
+    const uptr start_physical_address = end_physical_address - (end_address - start_address);
+    if ((start_physical_address >> BusWriteTracker::PAGE_BITS) != (end_physical_address >> BusWriteTracker::PAGE_BITS))
+        return 0;
+
+    BusWriteTracker* tracker = r.iop.bus.get_write_tracker();
+    const bool is_tracked = tracker && tracker->is_tracked(start_physical_address);
+
+    // Analyse the loop if not done already (or the code was written to since).
+    auto it = idle_loops.find(start_physical_address);
+    if ((it == idle_loops.end())
+        || (it->second.end_physical_address != end_physical_address)
+        || (is_tracked && (it->second.page_generation != tracker->generation(start_physical_address))))
+    {
+        // The page is marked as watched before it is read, see BusWriteTracker.
+        IdleLoopEntry entry;
+        entry.end_physical_address = end_physical_address;
+        entry.page_generation = is_tracked ? tracker->watch(start_physical_address) : 0;
+
+        const size_t count = (end_address - start_address) / Constants::MIPS::SIZE_MIPS_INSTRUCTION + 1;
+        uword raw_instructions[MipsIdleLoop::MAX_LOOP_LENGTH];
+        for (size_t i = 0; i < count; i++)
+            raw_instructions[i] = r.iop.bus.read_uword(BusContext::Iop, start_physical_address + static_cast<uptr>(i * Constants::MIPS::SIZE_MIPS_INSTRUCTION));
+        entry.is_idle_loop = MipsIdleLoop::is_idle_loop(raw_instructions, count, start_physical_address, entry.loads);
+
+        it = idle_loops.insert_or_assign(start_physical_address, entry).first;
+    }
+
+    if (!it->second.is_idle_loop)
+        return 0;
+
+    // Only loops polling main memory are skipped, see MipsIdleLoop::Loads.
+    const MipsIdleLoop::Loads& loads = it->second.loads;
+    for (size_t i = 0; i < loads.count; i++)
+    {
+        const uptr virtual_address = r.iop.core.r3000.gpr[loads.loads[i].base].read_uword() + loads.loads[i].offset;
+        const std::optional<uptr> physical_address = translate_address_data(virtual_address, READ);
+        if (!physical_address || *physical_address >= Constants::IOP::IOPMemory::SIZE_IOP_MEMORY)
+            return 0;
+    }
+
+    // A pending interrupt ends the loop straight away.
+    if (is_interrupt_pending())
+        return 0;
+
+    // Stop at the next scheduled event, so it is handled on time.
+    const int ticks = ticks_to_next_event(ticks_remaining);
+    if (ticks <= 0)
+        return 0;
+
+    idle_loop_stats.record(start_address, ticks);
+    return ticks;
+}
+
 void CIopCoreInterpreter::INSTRUCTION_UNKNOWN(const IopCoreInstruction inst)
 {
     // Unknown instruction, log if debug is enabled.
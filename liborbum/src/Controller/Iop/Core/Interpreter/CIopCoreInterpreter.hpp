@@ -1,6 +1,10 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "Common/Constants.hpp"
+#include "Common/Types/Mips/MipsIdleLoop.hpp"
+#include "Common/Types/Primitive.hpp"
 #include "Controller/Iop/Core/CIopCore.hpp"
 #include "Resources/Iop/Core/IopCoreInstruction.hpp"
 
@@ -13,10 +17,34 @@ class CIopCoreInterpreter : public CIopCore
 {
 public:
     CIopCoreInterpreter(Core* core);
+    ~CIopCoreInterpreter();
 
     /// Steps through the IOP Core state, executing instructions.
     int time_step(const int ticks_available) override;
 
+    /// Returns the number of ticks to fast-forward by, if the branch just taken
+    /// (from the delay slot at the end address) closes an idle loop (see MipsIdleLoop).
+    /// Skips up to the end of the time slice or the next scheduled event, and
+    /// not at all if an interrupt is pending or the loop reads outside of main memory.
+    int handle_idle_loop_skip(const uptr start_address, const uptr end_address, const uptr end_physical_address, const int ticks_remaining);
+
+    /// Idle loop analysis result, see idle_loops.
+    struct IdleLoopEntry
+    {
+        uptr end_physical_address;
+        uword page_generation;
+        bool is_idle_loop;
+        MipsIdleLoop::Loads loads;
+    };
+
+    /// Cached idle loop analysis results, keyed by the loop start physical address.
+    /// Entries within main memory are invalidated by writes (see BusWriteTracker),
+    /// code outside of it is in ROM.
+    std::unordered_map<uptr, IdleLoopEntry> idle_loops;
+
+    /// Idle loop skip statistics, per loop start PC.
+    MipsIdleLoop::Stats idle_loop_stats;
+
     /// Unknown instruction function - does nothing when executed. Used for any instructions with implementation index 0 (ie: reserved, unknown or otherwise).
     /// If the BUILD_DEBUG macro is enabled, can be used to debug an unknown opcode by logging a message.
     void INSTRUCTION_UNKNOWN(const IopCoreInstruction inst);
@@ -20,6 +20,10 @@ void CIopDmac::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
+        // Nothing to transfer - skip the time slice.
+        if (is_idle())
+            break;
+
         int ticks_remaining = time_to_ticks(event.data.time_us);
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
@@ -105,6 +109,22 @@ int CIopDmac::time_step(const int ticks_available)
     return 1;
 }
 
+bool CIopDmac::is_idle()
+{
+    auto& r = core->get_resources();
+
+    if (!r.iop.dmac.gctrl.read_uword())
+        return true;
+
+    for (auto& channel : r.iop.dmac.channels)
+    {
+        if (r.iop.dmac.pcrw.is_channel_enabled(&channel) && channel.chcr->extract_field(IopDmacChannelRegister_Chcr::START))
+            return false;
+    }
+
+    return true;
+}
+
 bool CIopDmac::transfer_normal_burst(IopDmacChannel& channel)
 {
     // Perform pre-start checks.
@@ -26,6 +26,10 @@ public:
     /// If a channel is enabled for transfer, data units (32-bit) are sent.
     int time_step(const int ticks_available);
 
+    /// Returns if no channel has a transfer started (or DMA is disabled), in
+    /// which case the time slice is skipped rather than ticked through.
+    bool is_idle();
+
     /////////////////////////////////
     // DMAC Logical Mode Functions //
     /////////////////////////////////
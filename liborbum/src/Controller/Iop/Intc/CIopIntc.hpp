@@ -2,10 +2,10 @@
 
 #include "Controller/CController.hpp"
 
-/// Checks the CTRL master register and STAT register for any pending interrupts. If there are, AND's STAT with the MASK register and checks for any
-/// interrupts to send to the IOP Core to process.
-/// TODO: Verify the clock speed. Assumed to be IOP clock speed (~37 MHz), as the max reported bus rate is 137 MB/s and width is 32-bit.
-/// See https://en.wikipedia.org/wiki/PlayStation_technical_specifications and https://en.wikipedia.org/wiki/PlayStation_2_technical_specifications.
+/// The IOP INTC sends an interrupt to the IOP Core on the INT2 line when the CTRL master register is set and any of the STAT bits
+/// are set that are not masked by the MASK register.
+/// The INT2 line is updated by the STAT, MASK and CTRL registers whenever they are written to (see IopIntcRegister_Stat),
+/// so interrupts are delivered as soon as they are raised and the INTC does not need to be run.
 class CIopIntc : public CController
 {
 public:
@@ -13,10 +13,8 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
-    /// Converts a time duration into the number of ticks that would have occurred.
-    int time_to_ticks(const double time_us);
-
-    /// Checks through the INTC STAT and MASK bits and sends an interrupt
-    /// to the IOP Core on the INT2 line.
-    int time_step(const int ticks_available);
+    bool is_time_driven() const override
+    {
+        return false;
+    }
 };
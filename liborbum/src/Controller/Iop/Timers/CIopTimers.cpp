@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Controller/Iop/Timers/CIopTimers.hpp"
 
 #include "Core.hpp"
@@ -6,17 +8,24 @@
 CIopTimers::CIopTimers(Core* core) :
     CController(core)
 {
+    auto& r = core->get_resources();
+
+    for (auto& unit : r.iop.timers.units)
+    {
+        unit->count.set_master_cycle_source(core->get_scheduler().get_cycle_counter());
+        scheduled_cycles[unit->unit_id] = 0;
+    }
 }
 
 void CIopTimers::handle_event(const ControllerEvent& event)
 {
+    auto& r = core->get_resources();
+
     switch (event.type)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks = time_to_ticks(event.data.time_us);
-        for (int i = 0; i < ticks; i++)
-            tick_timer(ControllerEvent::Type::Time);
+        update_units();
         break;
     }
     case ControllerEvent::Type::HBlank:
@@ -25,6 +34,11 @@ void CIopTimers::handle_event(const ControllerEvent& event)
             tick_timer(ControllerEvent::Type::HBlank);
         break;
     }
+    case ControllerEvent::Type::Scheduled:
+    {
+        handle_timer_events(r.iop.timers.units[event.data.id]);
+        break;
+    }
     default:
     {
         throw std::runtime_error("CIopTimers event handler not implemented - please fix!");
@@ -32,21 +46,26 @@ void CIopTimers::handle_event(const ControllerEvent& event)
     }
 }
 
-int CIopTimers::time_to_ticks(const double time_us)
+void CIopTimers::update_units()
 {
-    int ticks = static_cast<int>(time_us / 1.0e6 * Constants::IOP::IOPBUS_CLK_SPEED * core->get_options().system_bias_ioptimers);
+    auto& r = core->get_resources();
 
-    if (ticks < 10)
+    for (auto& unit : r.iop.timers.units)
     {
-        static bool warned = false;
-        if (!warned)
+        auto _lock = unit->mode.scope_lock();
+
+        if (handle_timer_write_latch(unit))
+            continue;
+
+        // Derived units need to be restarted when the count or compare value is written to.
+        if (unit->count.is_counting())
         {
-            BOOST_LOG(Core::get_logger()) << "IopTimers ticks too low - increase time delta";
-            warned = true;
+            bool count_written = unit->count.is_rebased_and_reset();
+            bool compare_written = unit->compare.read_uword() != unit->count.get_compare();
+            if (count_written || compare_written)
+                program_timer(unit);
         }
     }
-
-    return ticks;
 }
 
 void CIopTimers::tick_timer(const ControllerEvent::Type ce_type)
@@ -58,15 +77,9 @@ void CIopTimers::tick_timer(const ControllerEvent::Type ce_type)
     {
         auto _lock = unit->mode.scope_lock();
 
-        auto[prescale, event_type] = unit->mode.get_properties(unit->unit_id);
+        handle_timer_write_latch(unit);
 
-        // Check if we need to perform reset proceedures.
-        if (unit->mode.write_latch)
-        {
-            // Reset the count register.
-            unit->count.reset_prescale(prescale);
-            unit->mode.write_latch = false;
-        }
+        auto[prescale, event_type] = unit->mode.get_properties(unit->unit_id);
 
         // Count only if the timer is "enabled", and mode is equal to the event source.
         if (!unit->mode.is_enabled() || ce_type != event_type)
@@ -90,6 +103,81 @@ void CIopTimers::tick_timer(const ControllerEvent::Type ce_type)
     }
 }
 
+bool CIopTimers::handle_timer_write_latch(IopTimersUnit_Base* unit)
+{
+    if (!unit->mode.write_latch)
+        return false;
+
+    auto[prescale, event_type] = unit->mode.get_properties(unit->unit_id);
+
+    // Reset the count register.
+    unit->count.reset_prescale(prescale);
+    program_timer(unit);
+
+    unit->mode.write_latch = false;
+    return true;
+}
+
+void CIopTimers::program_timer(IopTimersUnit_Base* unit)
+{
+    auto[prescale, event_type] = unit->mode.get_properties(unit->unit_id);
+
+    // HLINE clocked units are ticked (see tick_timer()).
+    if (!unit->mode.is_enabled() || event_type != ControllerEvent::Type::Time)
+    {
+        unit->count.stop_counting();
+        return;
+    }
+
+    bool gated_tick = unit->mode.extract_field(IopTimersUnitRegister_Mode::SYNC_ENABLE) > 0;
+    if (gated_tick)
+        throw std::runtime_error("IOP Timers sync mode (gate) = 1, but not implemented.");
+
+    const double clk_speed = Constants::IOP::IOPBUS_CLK_SPEED * core->get_options().system_bias_ioptimers / prescale;
+    bool reset_on_target = unit->mode.extract_field(IopTimersUnitRegister_Mode::RESET_MODE) > 0;
+    unit->count.start_counting(clk_speed / EventScheduler::MASTER_CLK_SPEED, unit->compare.read_uword(), reset_on_target);
+    unit->count.is_rebased_and_reset();
+
+    schedule_timer_event(unit);
+}
+
+void CIopTimers::handle_timer_events(IopTimersUnit_Base* unit)
+{
+    auto _lock = unit->mode.scope_lock();
+
+    bool has_reached_target, has_overflowed;
+    unit->count.check_events(has_reached_target, has_overflowed);
+
+    // The count resets are part of the derived count, only the flags need setting.
+    if (has_overflowed)
+        unit->mode.insert_field(IopTimersUnitRegister_Mode::REACH_OF, 1);
+    if (has_reached_target)
+        unit->mode.insert_field(IopTimersUnitRegister_Mode::REACH_TARGET, 1);
+    handle_timer_interrupt(unit, has_overflowed, has_reached_target);
+
+    schedule_timer_event(unit);
+}
+
+void CIopTimers::schedule_timer_event(IopTimersUnit_Base* unit)
+{
+    udword cycle = unit->count.get_next_event_cycle();
+    if (cycle == LazyCountRegister::NO_EVENT)
+        return;
+
+    // An event that is still pending and not later than the next condition
+    // will check the unit in time (and schedule again) - stale events are harmless.
+    auto& scheduler = core->get_scheduler();
+    const udword current_cycle = scheduler.get_current_cycle();
+    udword& scheduled_cycle = scheduled_cycles[unit->unit_id];
+    if ((scheduled_cycle > current_cycle) && (scheduled_cycle <= cycle))
+        return;
+
+    scheduled_cycle = std::max(cycle, current_cycle + 1);
+    ControllerEvent event{ControllerEvent::Type::Scheduled, {}};
+    event.data.id = unit->unit_id;
+    scheduler.schedule_at(ControllerType::Type::IopTimers, event, scheduled_cycle);
+}
+
 void CIopTimers::handle_timer_interrupt(IopTimersUnit_Base* unit, const bool has_overflowed, const bool has_reached_target)
 {
     auto& r = core->get_resources();
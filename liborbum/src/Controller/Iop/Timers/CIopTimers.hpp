@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/Constants.hpp"
+#include "Common/Types/Primitive.hpp"
 #include "Controller/CController.hpp"
 #include "Controller/ControllerEvent.hpp"
 #include "Resources/Iop/Timers/IopTimersUnits.hpp"
@@ -7,6 +9,8 @@
 /// IOPTimers updates TIM0, TIM1, TIM2, TIM3, TIM4, TIM5.
 /// If interrupt conditions are met, sets the corresponding interrupt bit in the IOP INTC.
 /// The IOP Timers are dynamic and can be updated on the IOP system clock, pixel clock or HLINE clocks.
+/// Units following the system clock are not ticked: their count is derived on demand from the
+/// master cycle count, and the target/overflow conditions are scheduled as future events.
 class CIopTimers : public CController
 {
 public:
@@ -14,12 +18,25 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
-    /// Converts a time duration into the number of ticks that would have occurred.
-    int time_to_ticks(const double time_us);
+    /// Handles any unit mode, count or compare writes since the last time slice.
+    void update_units();
 
-    /// Updates the timers with the specified clock source type.
+    /// Updates the timers with the specified clock source type (HLINE).
     void tick_timer(const ControllerEvent::Type ce_type);
 
+    /// Resets the unit if the mode register was written to.
+    /// Returns true if it was reset.
+    bool handle_timer_write_latch(IopTimersUnit_Base* unit);
+
+    /// (Re)starts or stops deriving the unit count from the master cycle count, according to its mode.
+    void program_timer(IopTimersUnit_Base* unit);
+
+    /// Checks a derived unit for target/overflow conditions since the last check, and schedules the next one.
+    void handle_timer_events(IopTimersUnit_Base* unit);
+
+    /// Schedules an event for when the next target/overflow condition occurs on a derived unit.
+    void schedule_timer_event(IopTimersUnit_Base* unit);
+
     /// Checks the timer status and count values for interrupt conditions.
     void handle_timer_interrupt(IopTimersUnit_Base* unit, const bool has_overflowed, const bool has_reached_target);
 
@@ -30,4 +47,8 @@ public:
     /// Checks for target conditions and handles certain conditions.
     /// Returns if a timer target event happened.
     bool handle_timer_target(IopTimersUnit_Base* unit);
+
+private:
+    /// Master cycle of the last event scheduled for each unit, see schedule_timer_event().
+    udword scheduled_cycles[Constants::IOP::Timers::NUMBER_TIMERS];
 };
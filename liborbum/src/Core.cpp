@@ -19,6 +19,7 @@
 
 #include "Controller/Cdvd/CCdvd.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
+#include "Controller/Ee/Core/Recompiler/CEeCoreRecompiler.hpp"
 #include "Controller/Ee/Dmac/CEeDmac.hpp"
 #include "Controller/Ee/Gif/CGif.hpp"
 #include "Controller/Ee/Intc/CEeIntc.hpp"
@@ -26,6 +27,7 @@
 #include "Controller/Ee/Timers/CEeTimers.hpp"
 #include "Controller/Ee/Vpu/Vif/CVif.hpp"
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
+#include "Controller/Ee/Vpu/Vu/Recompiler/CVuRecompiler.hpp"
 #include "Controller/Gs/Core/CGsCore.hpp"
 #include "Controller/Gs/Crtc/CCrtc.hpp"
 #include "Controller/Iop/Core/Interpreter/CIopCoreInterpreter.hpp"
@@ -70,7 +72,18 @@ CoreOptions CoreOptions::make_default()
         1.0,
         1.0,
         1.0,
-        1.0};
+        1.0,
+
+        false,
+        false,
+        false,
+        true,
+        false,
+        false,
+        false,
+        false,
+
+        0};
 }
 
 CoreApi::CoreApi(const CoreOptions& options)
@@ -100,6 +113,12 @@ void CoreApi::save_state()
 
 Core::Core(const CoreOptions& options) :
     options(options)
+#if defined(BUILD_DEBUG)
+    ,
+    debug_sync_runs(0),
+    debug_sync_submit_time_us(0.0),
+    debug_sync_wait_time_us(0.0)
+#endif
 {
     // Initialise logging.
     init_logging();
@@ -110,6 +129,16 @@ Core::Core(const CoreOptions& options) :
     resources = std::make_unique<RResources>();
     initialise_resources(resources);
 
+    // Optionally access plain memory on the EE/IOP buses through the host MMU.
+    if (options.fastmem)
+    {
+        // Each bus falls back independently (ie: if the arena could not be reserved).
+        if (!get_resources().ee.bus.enable_fastmem())
+            BOOST_LOG(get_logger()) << "Fastmem not available for the EE bus - using the bus page tables";
+        if (!get_resources().iop.bus.enable_fastmem())
+            BOOST_LOG(get_logger()) << "Fastmem not available for the IOP bus - using the bus page tables";
+    }
+
     // Initialise roms (boot_rom (required), rom1, rom2, erom).
     const std::string roms_dir_path = options.roms_dir_path;
     const std::string boot_rom_file_name = options.boot_rom_file_name;
@@ -126,14 +155,20 @@ Core::Core(const CoreOptions& options) :
         get_resources().erom.read_from_file(roms_dir_path + erom_file_name, Constants::EE::ROM::SIZE_EROM);
 
     // Initialise controllers.
-    controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreInterpreter>(this);
+    if (options.eecore_recompiler)
+        controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreRecompiler>(this);
+    else
+        controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreInterpreter>(this);
     controllers[ControllerType::Type::EeDmac] = std::make_unique<CEeDmac>(this);
     controllers[ControllerType::Type::EeTimers] = std::make_unique<CEeTimers>(this);
     controllers[ControllerType::Type::EeIntc] = std::make_unique<CEeIntc>(this);
     controllers[ControllerType::Type::Gif] = std::make_unique<CGif>(this);
     controllers[ControllerType::Type::Ipu] = std::make_unique<CIpu>(this);
     controllers[ControllerType::Type::Vif] = std::make_unique<CVif>(this);
-    controllers[ControllerType::Type::Vu] = std::make_unique<CVuInterpreter>(this);
+    if (options.vu_recompiler)
+        controllers[ControllerType::Type::Vu] = std::make_unique<CVuRecompiler>(this);
+    else
+        controllers[ControllerType::Type::Vu] = std::make_unique<CVuInterpreter>(this);
     controllers[ControllerType::Type::IopCore] = std::make_unique<CIopCoreInterpreter>(this);
     controllers[ControllerType::Type::IopDmac] = std::make_unique<CIopDmac>(this);
     controllers[ControllerType::Type::IopTimers] = std::make_unique<CIopTimers>(this);
@@ -146,13 +181,41 @@ Core::Core(const CoreOptions& options) :
     controllers[ControllerType::Type::Sio2] = std::make_unique<CSio2>(this);
 
     // Task executor.
-    task_executor = std::make_unique<TaskExecutor>(options.number_workers);
+    if (options.work_stealing_executor)
+        work_stealing_executor = std::make_unique<WorkStealingTaskExecutor>(options.number_workers);
+    else
+        task_executor = std::make_unique<TaskExecutor>(options.number_workers);
 
     BOOST_LOG(get_logger()) << "Core initialised";
 }
 
 Core::~Core()
 {
+#if defined(BUILD_DEBUG)
+    auto debug_print_bus_statistics = [](const char* name, const size_t fast_path_accesses, const size_t slow_path_accesses) {
+        const size_t total_accesses = fast_path_accesses + slow_path_accesses;
+        BOOST_LOG(get_logger()) << boost::format("%s bus: accesses = %d, fast path = %.2f%%.")
+                                       % name
+                                       % total_accesses
+                                       % (total_accesses ? (100.0 * fast_path_accesses / total_accesses) : 0.0);
+    };
+
+    debug_print_bus_statistics("EE", get_resources().ee.bus.get_fast_path_accesses(), get_resources().ee.bus.get_slow_path_accesses());
+    debug_print_bus_statistics("IOP", get_resources().iop.bus.get_fast_path_accesses(), get_resources().iop.bus.get_slow_path_accesses());
+
+    if (debug_sync_runs)
+    {
+        BOOST_LOG(get_logger()) << boost::format("%s executor: runs = %d, avg submit time = %.3f us, avg wait time = %.3f us.")
+                                       % (work_stealing_executor ? "Work stealing" : "Default")
+                                       % debug_sync_runs
+                                       % (debug_sync_submit_time_us / debug_sync_runs)
+                                       % (debug_sync_wait_time_us / debug_sync_runs);
+    }
+
+    BOOST_LOG(get_logger()) << boost::format("Controller event queue: contention = %d.") % controller_event_queue.get_contention_count();
+    BOOST_LOG(get_logger()) << boost::format("Event scheduler: master cycles = %d, events scheduled = %d.") % scheduler.get_current_cycle() % scheduler.get_number_events_scheduled();
+#endif
+
     BOOST_LOG(get_logger()) << "Core shutting down";
 }
 
@@ -165,6 +228,13 @@ void Core::run()
 {
     try
     {
+        // Enqueue the scheduled events that are due, then end this run at the
+        // next scheduled event so it is delivered on time at the start of the next.
+        scheduler.deliver_due_events([this](const EventScheduler::ScheduledEvent& scheduled_event) {
+            enqueue_controller_event(scheduled_event.target, scheduled_event.event);
+        });
+        const double time_slice_us = scheduler.get_time_to_next_event(MIN_TIME_SLICE_US, options.time_slice_per_run_us);
+
 #if defined(BUILD_DEBUG)
         static double DEBUG_TIME_ELAPSED = 0.0;
         static double DEBUG_TIME_LOGGED = 0.0;
@@ -184,35 +254,28 @@ void Core::run()
             DEBUG_TIME_LOGGED = DEBUG_TIME_ELAPSED;
             DEBUG_T1 = DEBUG_T2;
         }
-        DEBUG_TIME_ELAPSED += options.time_slice_per_run_us;
+        DEBUG_TIME_ELAPSED += time_slice_us;
 #endif
 
-        // Enqueue time events (always done on each run).
-        auto event = ControllerEvent{ControllerEvent::Type::Time, options.time_slice_per_run_us};
+        // Enqueue time events (always done on each run), for the controllers that need them.
+        auto event = ControllerEvent{ControllerEvent::Type::Time, time_slice_us};
         for (int i = 0; i < static_cast<int>(ControllerType::Type::COUNT); i++) // TODO: find better syntax..
         {
             auto controller = static_cast<ControllerType::Type>(i);
-            enqueue_controller_event(controller, event);
+            if (controllers[controller] && controllers[controller]->is_time_driven())
+                enqueue_controller_event(controller, event);
         }
 
-        // Package events into tasks and send to workers.
-        EventEntry entry;
-        while (controller_event_queue.try_pop(entry))
-        {
-            auto task = [this, entry]() {
-                if (controllers[entry.t])
-                    controllers[entry.t]->handle_event_marshall_(entry.e);
-            };
-
-            task_executor->enqueue_task(task);
-        }
+        // The scheduler runs at the end of the time slice while the controllers run.
+        scheduler.advance(time_slice_us);
 
-        // Dispatch all tasks and wait for resynchronisation.
-        task_executor->dispatch();
-        task_executor->wait_for_idle();
+        if (work_stealing_executor)
+            run_controller_tasks(*work_stealing_executor);
+        else
+            run_controller_tasks(*task_executor);
 
 #if defined(BUILD_DEBUG)
-        if (!task_executor->task_sync.running_task_queue.is_empty() || task_executor->task_sync.thread_busy_counter.busy_counter)
+        if (task_executor && (!task_executor->task_sync.running_task_queue.is_empty() || task_executor->task_sync.thread_busy_counter.busy_counter))
             throw std::runtime_error("Task queue was not empty!");
 #endif
     }
@@ -223,6 +286,42 @@ void Core::run()
     }
 }
 
+template <typename ExecutorTy>
+void Core::run_controller_tasks(ExecutorTy& executor)
+{
+#if defined(BUILD_DEBUG)
+    const auto DEBUG_T1 = std::chrono::high_resolution_clock::now();
+#endif
+
+    // Package events into tasks and send to workers.
+    EventEntry entry;
+    while (controller_event_queue.try_pop(entry))
+    {
+        auto task = [this, entry]() {
+            if (controllers[entry.t])
+                controllers[entry.t]->handle_event_marshall_(entry.e);
+        };
+
+        executor.enqueue_task(task);
+    }
+
+    // Dispatch all tasks and wait for resynchronisation.
+    executor.dispatch();
+
+#if defined(BUILD_DEBUG)
+    const auto DEBUG_T2 = std::chrono::high_resolution_clock::now();
+#endif
+
+    executor.wait_for_idle();
+
+#if defined(BUILD_DEBUG)
+    const auto DEBUG_T3 = std::chrono::high_resolution_clock::now();
+    debug_sync_runs++;
+    debug_sync_submit_time_us += std::chrono::duration<double, std::micro>(DEBUG_T2 - DEBUG_T1).count();
+    debug_sync_wait_time_us += std::chrono::duration<double, std::micro>(DEBUG_T3 - DEBUG_T2).count();
+#endif
+}
+
 void Core::dump_all_memory() const
 {
     const std::string dumps_dir_path = options.dumps_dir_path;
@@ -256,6 +355,9 @@ void Core::save_state()
     if (!fout)
         throw std::runtime_error("Unable to write file");
 
+    // Let the GS thread finish what it has been sent first.
+    get_resources().gs.command_ring.sync();
+
     cereal::JSONOutputArchive oarchive(fout);
     oarchive(get_resources());
 }
@@ -15,9 +15,11 @@
 #include <Macros.hpp>
 #include <Queues.hpp>
 #include <TaskExecutor.hpp>
+#include <WorkStealingTaskExecutor.hpp>
 
 #include "Controller/ControllerEvent.hpp"
 #include "Controller/ControllerType.hpp"
+#include "Controller/EventScheduler.hpp"
 
 #ifdef orbum_EXPORTS
 #define CORE_API SHARED_EXPORT
@@ -40,6 +42,13 @@ struct CORE_API CoreOptions
     // - us = microseconds.
     // - Boot ROM is required, other roms are optional -> empty string will cause it to not be loaded.
     // - Speed biases are a ratio, 1.0x is normal speed.
+    // - The EE Core recompiler falls back to the interpreter on unsupported hosts (only x86-64 Unix currently).
+    // - The work stealing executor replaces the default (queue based) task executor, using the same number_workers.
+    // - Idle loop skipping fast-forwards the EE/IOP cores through busy-wait loops - disable for accuracy testing.
+    // - The VU1 thread runs VU1 micro programs asynchronously to everything else, instead of in step with the VU controller.
+    // - The VU recompiler falls back to the interpreter on unsupported hosts, like the EE Core recompiler.
+    // - The GS rasterizer draws with number_gs_threads threads (the GS controller worker plus helpers), 0 = one per host core.
+    // - The GS pipeline compiler falls back to the interpreter for unsupported draw states and hosts, like the recompilers.
 
     /* Log dir path.             */ const char* logs_dir_path;
     /* Roms dir path.            */ const char* roms_dir_path;
@@ -72,6 +81,17 @@ struct CORE_API CoreOptions
     /* CRTC speed bias.          */ double system_bias_crtc;
     /* SIO0 speed bias.          */ double system_bias_sio0;
     /* SIO2 speed bias.          */ double system_bias_sio2;
+
+    /* Use EE Core recompiler.   */ bool eecore_recompiler;
+    /* Use fastmem (EE/IOP bus). */ bool fastmem;
+    /* Work stealing executor.   */ bool work_stealing_executor;
+    /* Skip EE/IOP idle loops.   */ bool idle_loop_skip;
+    /* Run VU1 on own thread.    */ bool vu1_thread;
+    /* Use VU recompiler.        */ bool vu_recompiler;
+    /* Run GS on own thread.     */ bool gs_thread;
+    /* Use GS pipeline compiler. */ bool gs_pipeline_compiler;
+
+    /* Number of GS threads.     */ size_t number_gs_threads;
 };
 
 /// Exported Core class interface.
@@ -117,9 +137,11 @@ public:
         return options;
     }
 
-    /// Returns the task executor.
-    TaskExecutor& get_task_executor() const
+    /// Returns the task executor in use (see CoreOptions::work_stealing_executor).
+    TaskExecutorBase& get_task_executor() const
     {
+        if (work_stealing_executor)
+            return *work_stealing_executor;
         return *task_executor;
     }
 
@@ -129,6 +151,12 @@ public:
         return *resources;
     }
 
+    /// Returns the event scheduler, used to schedule controller events at a future master cycle.
+    EventScheduler& get_scheduler()
+    {
+        return scheduler;
+    }
+
     /// Enqueues a controller event that is dispatched on the next synchronised run.
     void enqueue_controller_event(const ControllerType::Type c_type, const ControllerEvent& event)
     {
@@ -154,13 +182,34 @@ private:
         ControllerType::Type t;
         ControllerEvent e;
     };
-    MpmcQueue<EventEntry, 128> controller_event_queue;
+    MpscQueue<EventEntry, 128> controller_event_queue;
+
+    /// Scheduled controller events, delivered at the start of the run beginning at their cycle.
+    EventScheduler scheduler;
+
+    /// Shortest run when ending a run at the next scheduled event, which keeps
+    /// the slow clocked controllers (ie: SIO at 2 MHz) at a tick or more per run.
+    static constexpr double MIN_TIME_SLICE_US = 1.0;
 
     /// Controllers.
     EnumMap<ControllerType::Type, std::unique_ptr<CController>> controllers;
 
-    /// Task executor.
+    /// Task executor. Only one of these is used, see CoreOptions::work_stealing_executor.
     std::unique_ptr<TaskExecutor> task_executor;
+    std::unique_ptr<WorkStealingTaskExecutor> work_stealing_executor;
+
+    /// Enqueues the pending controller events as tasks, and runs them to completion.
+    template <typename ExecutorTy>
+    void run_controller_tasks(ExecutorTy& executor);
+
+#if defined(BUILD_DEBUG)
+    /// Synchronisation cost statistics, used to compare the executors.
+    /// Submit time covers packaging the events into tasks and dispatching them,
+    /// wait time covers waiting for the workers to finish (includes the task run times).
+    size_t debug_sync_runs;
+    double debug_sync_submit_time_us;
+    double debug_sync_wait_time_us;
+#endif
 
 public:
     /// Save the current emulator state. JSON is used for debugging purposes
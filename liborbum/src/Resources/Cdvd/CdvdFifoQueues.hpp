@@ -14,6 +14,8 @@ public:
     /// Scope locked for the entire duration.
     ubyte read_ubyte() override;
     void write_ubyte(const ubyte data) override;
+    void read(ubyte* buffer, const size_t length) override;
+    void write(const ubyte* buffer, const size_t length) override;
 
     /// Reference to the NS_RDY_DIN register.
     CdvdRegister_Ns_Rdy_Din* ns_rdy_din;
@@ -9,6 +9,7 @@ EeCoreCop0Register_Status::EeCoreCop0Register_Status() :
     SizedWordRegister(INITIAL_VALUE),
     interrupts_masked(true),
     operating_context(MipsCoprocessor0::OperatingContext::Kernel),
+    translation_context(1), // Kernel, ERL = 1.
     count_interrupts_enabled(false)
 {
 }
@@ -35,6 +36,13 @@ void EeCoreCop0Register_Status::handle_operating_context_update()
         operating_context = MipsCoprocessor0::OperatingContext::Supervisor;
     else
         throw std::runtime_error("EE COP0 could not determine CPU operating context! Please debug.");
+
+    if (operating_context == MipsCoprocessor0::OperatingContext::Kernel)
+        translation_context = (ERL == 1) ? 1 : 0;
+    else if (operating_context == MipsCoprocessor0::OperatingContext::Supervisor)
+        translation_context = 2;
+    else
+        translation_context = 3;
 }
 
 void EeCoreCop0Register_Status::handle_count_interrupt_state_update()
@@ -52,36 +60,30 @@ void EeCoreCop0Register_Status::write_uword(const uword value)
 }
 
 EeCoreCop0Register_Cause::EeCoreCop0Register_Cause() :
-    irq_lines{false}
+    irq_lines(0)
 {
 }
 
 void EeCoreCop0Register_Cause::clear_all_irq()
 {
-    for (auto& line : irq_lines)
-        line = false;
+    irq_lines.store(0, std::memory_order_release);
 }
 
 void EeCoreCop0Register_Cause::set_irq_line(const int irq)
 {
-    irq_lines[irq] = true;
+    irq_lines.fetch_or(1 << irq, std::memory_order_release);
 }
 
 void EeCoreCop0Register_Cause::clear_irq_line(const int irq)
 {
-    irq_lines[irq] = false;
+    irq_lines.fetch_and(~(1 << irq), std::memory_order_release);
 }
 
 uword EeCoreCop0Register_Cause::read_uword()
 {
     uword value = SizedWordRegister::read_uword();
 
-    uword ip = 0;
-    for (int i = 0; i < 8; i++)
-        if (irq_lines[i])
-            ip |= (1 << i);
-
-    value = IP.insert_into(value, ip);
+    value = IP.insert_into(value, get_irq_lines());
 
     // Maybe no point in writing it back...
     SizedWordRegister::write_uword(value);
@@ -105,5 +107,6 @@ EeCoreCop0Register_Compare::EeCoreCop0Register_Compare() :
 
 void EeCoreCop0Register_Compare::write_uword(const uword value)
 {
-    cause->clear_irq_line(8);
+    SizedWordRegister::write_uword(value);
+    cause->clear_irq_line(7);
 }
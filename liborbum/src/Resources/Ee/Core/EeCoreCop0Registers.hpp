@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <cereal/cereal.hpp>
 #include <cereal/types/polymorphic.hpp>
 
@@ -104,6 +106,13 @@ public:
     /// Current cached COP0 operating context state.
     MipsCoprocessor0::OperatingContext operating_context;
 
+    /// Current cached address translation context, used to tag the EE Core
+    /// translation cache entries (see TranslationCache). Virtual addresses
+    /// translate differently depending on the operating context, and also on
+    /// the ERL bit within the kernel context (kuseg unmapped).
+    static constexpr int NUMBER_TRANSLATION_CONTEXTS = 4;
+    int translation_context;
+
     /// Current cached Count register interrupt state.
     bool count_interrupts_enabled;
 
@@ -112,7 +121,7 @@ private:
     /// Does so by checking the master ERL, EXL, EIE and IE bit.
     void handle_interrupts_masked_update();
 
-    /// Updates the operation context state.
+    /// Updates the operation context state, and the translation context state.
     /// Uses the KSU, ERL and EXL bits.
     void handle_operating_context_update();
 
@@ -127,6 +136,7 @@ public:
             cereal::base_class<SizedWordRegister>(this),
             CEREAL_NVP(interrupts_masked),
             CEREAL_NVP(operating_context),
+            CEREAL_NVP(translation_context),
             CEREAL_NVP(count_interrupts_enabled)
         );
     }
@@ -158,21 +168,30 @@ public:
     /// Clears the given IRQ line.
     void clear_irq_line(const int irq);
 
+    /// Returns the IRQ line flags (IP field value) without touching the
+    /// register, for the per-block interrupt check. Lock free.
+    uword get_irq_lines() const
+    {
+        return irq_lines.load(std::memory_order_acquire);
+    }
+
     /// Syncs the register state with the IRQ flags and returns the register value.
     uword read_uword() override;
 
 private:
-    /// IRQ line flags.
-    bool irq_lines[8];
+    /// IRQ line flags, bit n = line n (set by other threads).
+    std::atomic<uword> irq_lines;
 
 public:
     template<class Archive>
     void serialize(Archive & archive)
     {
+        uword lines = irq_lines.load();
         archive(
             cereal::base_class<SizedWordRegister>(this),
-            CEREAL_NVP(irq_lines)
+            cereal::make_nvp("irq_lines", lines)
         );
+        irq_lines.store(lines);
     }
 };
 
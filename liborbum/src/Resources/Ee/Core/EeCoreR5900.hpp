@@ -4,8 +4,8 @@
 
 #include "Common/Constants.hpp"
 #include "Common/Types/Mips/BranchDelaySlot.hpp"
+#include "Common/Types/Register/AlignedQwordRegister.hpp"
 #include "Common/Types/Register/PcRegisters.hpp"
-#include "Common/Types/Register/SizedQwordRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
 
 /// The R5900 is the EE Core's CPU.
@@ -28,18 +28,28 @@ public:
     /// The upper 64-bits are only used when specific instructions are run, such as
     /// using the EE Core specific multimedia instructions (parallel instructions). Example: PADDB.
     /// See EE Core Users Manual, pg 60.
-    SizedQwordRegister gpr[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
+    /// The GPR's form a flat, aligned register file (see AlignedQwordRegister).
+    /// GPR $zero is not write protected: the instructions that write it are allowed
+    /// to, and it is reset to 0 after every instruction (see reset_zero_register()).
+    AlignedQwordRegister gpr[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
 
     /// The HI and LO registers. See EE Core Users manual, pg 60.
     /// These registers are used to hold the results of integer multiply and divide operations.
-    SizedQwordRegister hi;
-    SizedQwordRegister lo;
+    AlignedQwordRegister hi;
+    AlignedQwordRegister lo;
 
     /// The Shift Amount (SA) register. See EE Core Users manual, pg 61.
     /// The SA register is used for holding funnel shift instruction results.
     /// See the EE Core instruction QFSRV for more details (SA is only used for this instruction).
     SizedWordRegister sa;
 
+    /// Resets GPR $zero to 0, discarding any instruction writes to it.
+    /// Cheaper than checking for it on every GPR write.
+    void reset_zero_register()
+    {
+        gpr[0].write_uqword(uqword());
+    }
+
 public:
     template<class Archive>
     void serialize(Archive & archive)
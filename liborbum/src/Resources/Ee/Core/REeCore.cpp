@@ -3,6 +3,6 @@
 #include "Common/Constants.hpp"
 
 REeCore::REeCore() :
-    scratchpad_memory(Constants::EE::EECore::ScratchpadMemory::SIZE_SCRATCHPAD_MEMORY)
+    scratchpad_memory(Constants::EE::EECore::ScratchpadMemory::SIZE_SCRATCHPAD_MEMORY, 0, false, true)
 {
 }
\ No newline at end of file
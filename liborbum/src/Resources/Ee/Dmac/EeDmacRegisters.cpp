@@ -1,4 +1,10 @@
 #include "Resources/Ee/Dmac/EeDmacRegisters.hpp"
+#include "Resources/Ee/Core/EeCoreCop0Registers.hpp"
+
+EeDmacRegister_Stat::EeDmacRegister_Stat() :
+    cause(nullptr)
+{
+}
 
 void EeDmacRegister_Stat::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
 {
@@ -15,7 +21,28 @@ void EeDmacRegister_Stat::byte_bus_write_uword(const BusContext context, const u
         temp = revBits | clrBits;
     }
 
-    SizedWordRegister::write_uword(temp);
+    write_uword(temp);
+}
+
+void EeDmacRegister_Stat::write_ubyte(const size_t offset, const ubyte value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_ubyte(offset, value);
+    handle_interrupt_update();
+}
+
+void EeDmacRegister_Stat::write_uhword(const size_t offset, const uhword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uhword(offset, value);
+    handle_interrupt_update();
+}
+
+void EeDmacRegister_Stat::write_uword(const uword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uword(value);
+    handle_interrupt_update();
 }
 
 bool EeDmacRegister_Stat::is_interrupt_pending()
@@ -31,4 +58,14 @@ bool EeDmacRegister_Stat::is_interrupt_pending()
         return true;
 
     return false;
+}
+
+void EeDmacRegister_Stat::handle_interrupt_update()
+{
+    auto _lock = scope_lock();
+
+    if (is_interrupt_pending())
+        cause->set_irq_line(3);
+    else
+        cause->clear_irq_line(3);
 }
\ No newline at end of file
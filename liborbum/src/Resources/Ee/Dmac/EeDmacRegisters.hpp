@@ -4,6 +4,8 @@
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Common/Types/ScopeLock.hpp"
 
+class EeCoreCop0Register_Cause;
+
 // The DMAC D_CTRL register, which contains various settings needed for the DMAC.
 // TODO: Need to implement cycle stealing? Wouldn't think so...
 class EeDmacRegister_Ctrl : public SizedWordRegister
@@ -18,6 +20,8 @@ public:
 };
 
 // The DMAC D_STAT register, aka interrupt status register.
+// Writes set or clear the EE Core INT1 line (COP0.Cause.IP[3]) according to
+// the interrupt condition, so it is delivered on change rather than polled.
 class EeDmacRegister_Stat : public SizedWordRegister, public ScopeLock
 {
 public:
@@ -50,16 +54,30 @@ public:
     static constexpr Bitfield CHANNEL_CIS_KEYS[Constants::EE::DMAC::NUMBER_DMAC_CHANNELS] = {CIS0, CIS1, CIS2, CIS3, CIS4, CIS5, CIS6, CIS7, CIS8, CIS9};
     static constexpr Bitfield CHANNEL_CIM_KEYS[Constants::EE::DMAC::NUMBER_DMAC_CHANNELS] = {CIM0, CIM1, CIM2, CIM3, CIM4, CIM5, CIM6, CIM7, CIM8, CIM9};
 
+    EeDmacRegister_Stat();
+
     /// (EE context only.)
     /// When 1 is written to the CIS0-9, SIS, MEIS or BEIS bits, they are cleared (set to 0).
     /// When 1 is written to the CIM0-9, SIM or MEIM bits, they are reversed.
     /// Scope locked for entire duration.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
 
+    /// Writes update the EE Core INT1 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
     /// Returns the current interrupt condition state.
     /// If either the same STAT and MASK bits are set, or there is a bus error, an interrupt occurs.
     /// See the algorithm listed at the end of page 65 of the EE Users Manual.
     bool is_interrupt_pending();
+
+    /// Sets or clears the EE Core INT1 line based on the interrupt condition state.
+    /// See EE Core Users Manual page 73-75 for the EE Core details. Note that on page 75, there is a typo, where the INTx lines are mixed up on bits 10 and 11 (verified through running through bios code).
+    /// Scope locked.
+    void handle_interrupt_update();
+
+    EeCoreCop0Register_Cause* cause;
 };
 
 // The DMAC D_PCR register, aka priority control register.
@@ -31,6 +31,12 @@ public:
     uword read_uword(const size_t offset) override;
     void write_uword(const size_t offset, const uword value) override;
 
+    /// Needs to go through the overriden methods above.
+    ubyte* byte_bus_host_memory() override
+    {
+        return nullptr;
+    }
+
 private:
 #if DEBUG_LOG_SIO_MESSAGES
     // Varibles below needed for SIO messages output through the SIO_TXFIFO register.
@@ -68,6 +74,12 @@ public:
     uword read_uword(const size_t offset) override;
     void write_uword(const size_t offset, const uword value) override;
 
+    /// Needs to go through the overriden methods above.
+    ubyte* byte_bus_host_memory() override
+    {
+        return nullptr;
+    }
+
 private:
     // Variables below needed by logic. Used by the BIOS to initialize/test the RDRAM. See old PCSX2 code (Hw.h/HwRead.cpp/HwWrite.cpp).
     int rdram_sdevid = 0;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/ScopeLock.hpp"
+
+/// Qword buffer feeding a GIF path from another controller: VU1 XGKICK
+/// packets for PATH1 and VIF1 DIRECT/DIRECTHL data for PATH2.
+/// It grows as needed, so producers never have to stall waiting for the GIF
+/// (which may not get to run again until the producer has finished its time
+/// slice). Producers and the GIF may be on different threads.
+class GifPathBuffer : public ScopeLock
+{
+public:
+    GifPathBuffer() :
+        read_position(0)
+    {
+    }
+
+    /// Appends data to the buffer.
+    void write(const ubyte* buffer, const size_t length)
+    {
+        auto _lock = scope_lock();
+        data.insert(data.end(), buffer, buffer + length);
+    }
+
+    /// Takes up to max_qwords whole qwords out of the buffer, returning the number taken.
+    size_t read(ubyte* buffer, const size_t max_qwords)
+    {
+        auto _lock = scope_lock();
+        const size_t qwords = std::min(max_qwords, (data.size() - read_position) / NUMBER_BYTES_IN_QWORD);
+        std::memcpy(buffer, data.data() + read_position, qwords * NUMBER_BYTES_IN_QWORD);
+        read_position += qwords * NUMBER_BYTES_IN_QWORD;
+
+        // Compact once the consumed part dominates, so reads stay cheap.
+        if (read_position == data.size())
+        {
+            data.clear();
+            read_position = 0;
+        }
+        else if (read_position > data.size() / 2)
+        {
+            data.erase(data.begin(), data.begin() + read_position);
+            read_position = 0;
+        }
+
+        return qwords;
+    }
+
+    /// Returns if there is at least one whole qword available.
+    bool has_read_available()
+    {
+        auto _lock = scope_lock();
+        return (data.size() - read_position) >= NUMBER_BYTES_IN_QWORD;
+    }
+
+    /// Empties the buffer.
+    void initialize()
+    {
+        auto _lock = scope_lock();
+        data.clear();
+        read_position = 0;
+    }
+
+private:
+    std::vector<ubyte> data;
+    size_t read_position;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(data),
+            CEREAL_NVP(read_position)
+        );
+    }
+};
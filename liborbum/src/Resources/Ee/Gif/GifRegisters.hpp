@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Common/Types/Register/SizedWordRegister.hpp"
+
+/// GIF registers.
+/// See EE Users Manual page 150 onwards.
+
+class GifRegister_Ctrl : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield RST = Bitfield(0, 1);
+    static constexpr Bitfield PSE = Bitfield(3, 1);
+};
+
+class GifRegister_Mode : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield M3R = Bitfield(0, 1);
+    static constexpr Bitfield IMT = Bitfield(2, 1);
+};
+
+/// The GIF STAT register, which is maintained by the GIF (see CGif::update_stat()).
+/// M3P is set by the VIF1 MSKPATH3 VIFcode.
+class GifRegister_Stat : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield M3R = Bitfield(0, 1);
+    static constexpr Bitfield M3P = Bitfield(1, 1);
+    static constexpr Bitfield IMT = Bitfield(2, 1);
+    static constexpr Bitfield PSE = Bitfield(3, 1);
+    static constexpr Bitfield IP3 = Bitfield(5, 1);
+    static constexpr Bitfield P3Q = Bitfield(6, 1);
+    static constexpr Bitfield P2Q = Bitfield(7, 1);
+    static constexpr Bitfield P1Q = Bitfield(8, 1);
+    static constexpr Bitfield OPH = Bitfield(9, 1);
+    static constexpr Bitfield APATH = Bitfield(10, 2);
+    static constexpr Bitfield DIR = Bitfield(12, 1);
+    static constexpr Bitfield FQC = Bitfield(24, 5);
+};
+
+class GifRegister_Cnt : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield LOOPCNT = Bitfield(0, 15);
+    static constexpr Bitfield REGCNT = Bitfield(16, 4);
+    static constexpr Bitfield VUADDR = Bitfield(20, 10);
+};
+
+class GifRegister_P3cnt : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield P3CNT = Bitfield(0, 15);
+};
+
+class GifRegister_P3tag : public SizedWordRegister
+{
+public:
+    static constexpr Bitfield LOOPCNT = Bitfield(0, 15);
+    static constexpr Bitfield EOP = Bitfield(15, 1);
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Bitfield.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// A GIFtag, as explained on page 150 of the EE Users Manual.
+/// Leads each block of data sent through a GIF path, describing how the data
+/// following it is written to the GS.
+class Giftag
+{
+public:
+    static constexpr Bitfield NLOOP = Bitfield(0, 15); // For tag0.
+    static constexpr Bitfield EOP = Bitfield(15, 1);   // For tag0.
+    static constexpr Bitfield PRE = Bitfield(46, 1);   // For tag0.
+    static constexpr Bitfield PRIM = Bitfield(47, 11); // For tag0.
+    static constexpr Bitfield FLG = Bitfield(58, 2);   // For tag0.
+    static constexpr Bitfield NREG = Bitfield(60, 4);  // For tag0.
+
+    /// Data formats (FLG).
+    static constexpr uword FLG_PACKED = 0;
+    static constexpr uword FLG_REGLIST = 1;
+    static constexpr uword FLG_IMAGE = 2;
+
+    /// Construct a blank GIFtag.
+    Giftag() :
+        tag0(0),
+        tag1(0)
+    {
+    }
+
+    /// Construct the tag with the raw values.
+    /// - tag0 is for bits 0-63.
+    /// - tag1 is for bits 64-127 (REGS).
+    Giftag(const udword tag0, const udword tag1) :
+        tag0(tag0),
+        tag1(tag1)
+    {
+    }
+
+    /// Field extraction functions.
+    /// See Bitfields above for the actual definitions.
+    uword nloop() const
+    {
+        return static_cast<uword>(NLOOP.extract_from(tag0));
+    }
+
+    bool eop() const
+    {
+        return EOP.extract_from(tag0) > 0;
+    }
+
+    bool pre() const
+    {
+        return PRE.extract_from(tag0) > 0;
+    }
+
+    udword prim() const
+    {
+        return PRIM.extract_from(tag0);
+    }
+
+    /// Returns the data format, with the undefined FLG value (3) treated as IMAGE.
+    uword flg() const
+    {
+        const uword flg = static_cast<uword>(FLG.extract_from(tag0));
+        return (flg == 3) ? FLG_IMAGE : flg;
+    }
+
+    /// Returns the number of register descriptors (NREG of 0 means 16).
+    uword nreg() const
+    {
+        const uword nreg = static_cast<uword>(NREG.extract_from(tag0));
+        return nreg ? nreg : 16;
+    }
+
+    /// Returns the register descriptor at the index given (REGS).
+    ubyte reg(const uword index) const
+    {
+        return static_cast<ubyte>((tag1 >> (index * 4)) & 0xF);
+    }
+
+    /// GIFtag values.
+    /// All functions above extract information from these.
+    udword tag0;
+    udword tag1;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(tag0),
+            CEREAL_NVP(tag1)
+        );
+    }
+};
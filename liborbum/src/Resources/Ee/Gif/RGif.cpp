@@ -2,6 +2,7 @@
 
 RGif::RGif() :
     memory_3030(0x10, 0, true),
-    memory_30b0(0x750, 0, true)
+    memory_30b0(0x750, 0, true),
+    active_path(0)
 {
 }
@@ -4,26 +4,82 @@
 
 #include "Common/Types/Memory/ArrayByteMemory.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
+#include "Resources/Ee/Gif/GifPathBuffer.hpp"
+#include "Resources/Ee/Gif/GifRegisters.hpp"
+#include "Resources/Ee/Gif/Giftag.hpp"
+
+/// Processing state of a GIF path: the GIFtag being processed and the
+/// position within its data.
+/// See EE Users Manual page 150 onwards.
+struct GifPathState
+{
+    GifPathState() :
+        loops_remaining(0),
+        register_index(0),
+        q(0x3F800000),
+        is_packet_active(false)
+    {
+    }
+
+    /// Current GIFtag, and the number of loops (NLOOP) and the register
+    /// descriptor within the current loop left to process. A new tag is read
+    /// once there are no loops remaining.
+    Giftag tag;
+    uword loops_remaining;
+    uword register_index;
+
+    /// Q value written along with RGBAQ in PACKED mode, which is set by ST
+    /// (f32 bits, reset to 1.0 at each GIFtag).
+    uword q;
+
+    /// Set from the first GIFtag of a packet until the end of the data of
+    /// the GIFtag with EOP set. Paths are only switched between packets.
+    bool is_packet_active;
+
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(tag),
+            CEREAL_NVP(loops_remaining),
+            CEREAL_NVP(register_index),
+            CEREAL_NVP(q),
+            CEREAL_NVP(is_packet_active)
+        );
+    }
+};
 
 class RGif
 {
 public:
     RGif();
 
+    static constexpr int NUMBER_PATHS = 3;
+
     /// GIF memory mapped registers. See page 21 of EE Users Manual.
-    SizedWordRegister ctrl;
-    SizedWordRegister mode;
-    SizedWordRegister stat;
+    GifRegister_Ctrl ctrl;
+    GifRegister_Mode mode;
+    GifRegister_Stat stat;
     ArrayByteMemory memory_3030;
     SizedWordRegister tag0;
     SizedWordRegister tag1;
     SizedWordRegister tag2;
     SizedWordRegister tag3;
-    SizedWordRegister cnt;
-    SizedWordRegister p3cnt;
-    SizedWordRegister p3tag;
+    GifRegister_Cnt cnt;
+    GifRegister_P3cnt p3cnt;
+    GifRegister_P3tag p3tag;
     ArrayByteMemory memory_30b0;
 
+    /// PATH1 -> PATH3 processing state (index 0 -> 2), and the path currently
+    /// transferring a packet (1 -> 3, 0 for none).
+    GifPathState paths[NUMBER_PATHS];
+    int active_path;
+
+    /// PATH1 (VU1 XGKICK) and PATH2 (VIF1 DIRECT/DIRECTHL) input.
+    /// PATH3 comes from the DMAC (channel 2) through the GIF FIFO (RResources::fifo_gif).
+    GifPathBuffer path1_buffer;
+    GifPathBuffer path2_buffer;
+
 public:
     template<class Archive>
     void serialize(Archive & archive)
@@ -40,7 +96,11 @@ public:
             CEREAL_NVP(cnt),
             CEREAL_NVP(p3cnt),
             CEREAL_NVP(p3tag),
-            CEREAL_NVP(memory_30b0)
+            CEREAL_NVP(memory_30b0),
+            CEREAL_NVP(paths),
+            CEREAL_NVP(active_path),
+            CEREAL_NVP(path1_buffer),
+            CEREAL_NVP(path2_buffer)
         );
     }
 };
@@ -1,4 +1,42 @@
 #include "Resources/Ee/Intc/EeIntcRegisters.hpp"
+#include "Resources/Ee/Core/EeCoreCop0Registers.hpp"
+
+EeIntcRegister_Mask::EeIntcRegister_Mask() :
+    stat(nullptr)
+{
+}
+
+void EeIntcRegister_Mask::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
+{
+    if (context == BusContext::Ee)
+        write_uword(read_uword() ^ value);
+    else
+        write_uword(value);
+}
+
+void EeIntcRegister_Mask::write_ubyte(const size_t offset, const ubyte value)
+{
+    SizedWordRegister::write_ubyte(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void EeIntcRegister_Mask::write_uhword(const size_t offset, const uhword value)
+{
+    SizedWordRegister::write_uhword(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void EeIntcRegister_Mask::write_uword(const uword value)
+{
+    SizedWordRegister::write_uword(value);
+    stat->handle_interrupt_update();
+}
+
+EeIntcRegister_Stat::EeIntcRegister_Stat() :
+    mask(nullptr),
+    cause(nullptr)
+{
+}
 
 void EeIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
 {
@@ -8,13 +46,37 @@ void EeIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const u
     if (context == BusContext::Ee)
         temp = read_uword() & (~value);
 
-    SizedWordRegister::write_uword(temp);
+    write_uword(temp);
 }
 
-void EeIntcRegister_Mask::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
+void EeIntcRegister_Stat::write_ubyte(const size_t offset, const ubyte value)
 {
-    if (context == BusContext::Ee)
-        SizedWordRegister::write_uword(read_uword() ^ value);
+    auto _lock = scope_lock();
+    SizedWordRegister::write_ubyte(offset, value);
+    handle_interrupt_update();
+}
+
+void EeIntcRegister_Stat::write_uhword(const size_t offset, const uhword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uhword(offset, value);
+    handle_interrupt_update();
+}
+
+void EeIntcRegister_Stat::write_uword(const uword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uword(value);
+    handle_interrupt_update();
+}
+
+void EeIntcRegister_Stat::handle_interrupt_update()
+{
+    // Done under the lock so the last writer (of either register) always decides the line state.
+    auto _lock = scope_lock();
+
+    if (read_uword() & mask->read_uword())
+        cause->set_irq_line(2);
     else
-        SizedWordRegister::write_uword(value);
+        cause->clear_irq_line(2);
 }
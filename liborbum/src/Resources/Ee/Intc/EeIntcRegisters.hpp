@@ -5,8 +5,12 @@
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Common/Types/ScopeLock.hpp"
 
+class EeCoreCop0Register_Cause;
+class EeIntcRegister_Stat;
+
 /// The EE INTC I_MASK register, which holds a set of flags determining if the interrupt source is masked.
 /// Bits are reversed by writing 1 (through EE context).
+/// Writes update the EE Core INT0 line, see EeIntcRegister_Stat.
 class EeIntcRegister_Mask : public SizedWordRegister
 {
 public:
@@ -26,14 +30,26 @@ public:
     static constexpr Bitfield SFIFO = Bitfield(13, 1);
     static constexpr Bitfield VU0WD = Bitfield(14, 1);
 
+    EeIntcRegister_Mask();
+
     /// (EE) Reverses any bits written to.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+
+    /// Writes update the EE Core INT0 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
+    EeIntcRegister_Stat* stat;
 };
 
 /// The EE INTC I_STAT register, which holds a set of flags determining if a component caused an interrupt.
 /// Bits are cleared by writing 1 (through EE context).
 /// The INTC is edge triggered (ie: only need to pulse line). See EE Users Manual page 28.
 /// STAT writes needs to be scope locked by the peripherals.
+/// Interrupts are delivered on change rather than polled: any STAT or MASK
+/// write sets or clears the EE Core INT0 line (COP0.Cause.IP[2]) according
+/// to STAT & MASK, so the INTC does not need to be run.
 class EeIntcRegister_Stat : public SizedWordRegister, public ScopeLock
 {
 public:
@@ -58,7 +74,21 @@ public:
     static constexpr Bitfield VU_KEYS[Constants::EE::VPU::VU::NUMBER_VU_CORES] = {VU0, VU1};
     static constexpr Bitfield TIM_KEYS[Constants::EE::Timers::NUMBER_TIMERS] = {TIM0, TIM1, TIM2, TIM3};
 
+    EeIntcRegister_Stat();
+
     /// (EE context) Clears any bits written to.
     /// Scope locked.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+
+    /// Writes update the EE Core INT0 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
+    /// Sets or clears the EE Core INT0 line based on STAT & MASK.
+    /// Scope locked.
+    void handle_interrupt_update();
+
+    EeIntcRegister_Mask* mask;
+    EeCoreCop0Register_Cause* cause;
 };
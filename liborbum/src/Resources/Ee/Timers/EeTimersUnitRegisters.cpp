@@ -4,6 +4,7 @@
 #include "Resources/Ee/Timers/REeTimers.hpp"
 
 EeTimersUnitRegister_Count::EeTimersUnitRegister_Count() :
+    LazyCountRegister(static_cast<udword>(VALUE_UHWORD_MAX) + 1),
     is_overflowed(false),
     prescale_target(1),
     prescale_count(0)
@@ -12,6 +13,8 @@ EeTimersUnitRegister_Count::EeTimersUnitRegister_Count() :
 
 void EeTimersUnitRegister_Count::increment(const uhword value)
 {
+    auto _lock = scope_lock();
+
     // Update only if the prescale threshold has been reached.
     prescale_count += static_cast<int>(value);
     if (prescale_count >= prescale_target)
@@ -43,6 +46,8 @@ bool EeTimersUnitRegister_Count::is_overflowed_and_reset()
 
 void EeTimersUnitRegister_Count::reset_prescale(const int prescale_target)
 {
+    auto _lock = scope_lock();
+
     write_uword(0);
 
     this->prescale_target = prescale_target;
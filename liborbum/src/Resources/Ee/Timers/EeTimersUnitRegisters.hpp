@@ -3,6 +3,7 @@
 #include <cereal/cereal.hpp>
 #include <cereal/types/polymorphic.hpp>
 
+#include "Common/Types/Register/LazyCountRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Common/Types/ScopeLock.hpp"
 #include "Controller/ControllerEvent.hpp"
@@ -10,9 +11,10 @@
 using ControllerEventType = ControllerEvent::Type;
 
 /// The Timer Count register type. See EE Users Manual page 37.
-/// Provides the increment function, which also wraps the uword value around once overflow (> uhword) happens (an internal flag is set).
-/// This register is only accessed by the Timers controller, it doesn't need any sync support.
-class EeTimersUnitRegister_Count : public SizedWordRegister
+/// When following a bus clock, the count is derived on demand from the master cycle count (see LazyCountRegister).
+/// Otherwise (H-BLNK), provides the increment function, which also wraps the uword value around once overflow (> uhword) happens (an internal flag is set).
+/// Accesses are scope locked, as the count is read by the CPU bus while the Timers controller reprograms it.
+class EeTimersUnitRegister_Count : public LazyCountRegister
 {
 public:
     EeTimersUnitRegister_Count();
@@ -41,7 +43,7 @@ public:
     void serialize(Archive & archive)
     {
         archive(
-            cereal::base_class<SizedWordRegister>(this),
+            cereal::base_class<LazyCountRegister>(this),
             CEREAL_NVP(is_overflowed),
             CEREAL_NVP(prescale_target),
             CEREAL_NVP(prescale_count)
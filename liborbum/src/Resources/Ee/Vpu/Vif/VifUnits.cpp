@@ -2,6 +2,14 @@
 
 VifUnit_Base::VifUnit_Base(const int core_id) :
     core_id(core_id),
-    dma_fifo_queue(nullptr)
+    dma_fifo_queue(nullptr),
+    vu_unit(nullptr),
+    packet_position(NUMBER_WORDS_IN_QWORD),
+    data_words_remaining(0),
+    data_address(0),
+    unpack_buffer{0},
+    unpack_buffer_size(0),
+    unpack_cycle(0),
+    unpack_vectors_remaining(0)
 {
 }
@@ -3,8 +3,11 @@
 #include <cereal/cereal.hpp>
 
 #include "Common/Types/FifoQueue/DmaFifoQueue.hpp"
+#include "Common/Types/Primitive.hpp"
 #include "Resources/Ee/Vpu/Vif/VifUnitRegisters.hpp"
 
+class VuUnit_Base;
+
 // A base class for a VIF core.
 class VifUnit_Base
 {
@@ -17,6 +20,28 @@ public:
     /// DMA FIFO queue.
     DmaFifoQueue<>* dma_fifo_queue;
 
+    /// The VU unit this VIF unit feeds (VIF0 -> VU0, VIF1 -> VU1).
+    VuUnit_Base* vu_unit;
+
+    /// The DMA unit of data currently being processed, and the number of
+    /// words in it already processed. Processing stops part way through when
+    /// the VIF is waiting on the VU (STAT.VEW), and resumes from here.
+    uqword packet;
+    int packet_position;
+
+    /// Number of data words still to be received for the current VIFcode
+    /// (held in CODE), and the VU memory address the next one is written to.
+    uword data_words_remaining;
+    uword data_address;
+
+    /// UNPACK state: input bytes of a vector split across DMA units, the
+    /// current write cycle (see CYCLE) and the number of vectors still to be
+    /// written. See VifUnpack.
+    ubyte unpack_buffer[2 * NUMBER_BYTES_IN_QWORD];
+    int unpack_buffer_size;
+    uword unpack_cycle;
+    uword unpack_vectors_remaining;
+
     /// VIF registers. See page 124 of EE Users Manual.
     SizedWordRegister r0;
     SizedWordRegister r1;
@@ -69,7 +94,15 @@ public:
             CEREAL_NVP(code),
             CEREAL_NVP(stat),
             CEREAL_NVP(fbrst),
-            CEREAL_NVP(err)
+            CEREAL_NVP(err),
+            CEREAL_NVP(packet),
+            CEREAL_NVP(packet_position),
+            CEREAL_NVP(data_words_remaining),
+            CEREAL_NVP(data_address),
+            CEREAL_NVP(unpack_buffer),
+            CEREAL_NVP(unpack_buffer_size),
+            CEREAL_NVP(unpack_cycle),
+            CEREAL_NVP(unpack_vectors_remaining)
         );
     }
 };
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Common/Types/Register/SizedWordRegister.hpp"
+#include "Common/Types/ScopeLock.hpp"
 
 /// The VPU STAT register.
 /// See VU Users Manual page 203.
-class VpuRegister_Stat : public SizedWordRegister
+/// The VBSn bits are updated by the VU micro program executors (see VuMicroSync).
+class VpuRegister_Stat : public SizedWordRegister, public ScopeLock
 {
 public:
     static constexpr Bitfield VBS0 = Bitfield(0, 1);
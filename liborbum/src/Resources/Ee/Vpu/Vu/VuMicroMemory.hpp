@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+
+#include <cereal/cereal.hpp>
+#include <cereal/access.hpp>
+#include <cereal/types/polymorphic.hpp>
+
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+
+/// VU micro (instruction) memory.
+/// Each write bumps a generation counter, which the VU recompiler uses to
+/// tell when its cached programs need to be revalidated (see VuProgramCache),
+/// instead of checking the memory contents on every program start.
+/// Writes can come from the VIF (MPG) or the EE bus, from any thread.
+class VuMicroMemory : public ArrayByteMemory
+{
+public:
+    VuMicroMemory(const size_t size) :
+        ArrayByteMemory(size),
+        generation(0)
+    {
+    }
+
+    void initialize() override
+    {
+        ArrayByteMemory::initialize();
+        notify_write();
+    }
+
+    void write_ubyte(const size_t offset, const ubyte value) override
+    {
+        ArrayByteMemory::write_ubyte(offset, value);
+        notify_write();
+    }
+
+    void write_uhword(const size_t offset, const uhword value) override
+    {
+        ArrayByteMemory::write_uhword(offset, value);
+        notify_write();
+    }
+
+    void write_uword(const size_t offset, const uword value) override
+    {
+        ArrayByteMemory::write_uword(offset, value);
+        notify_write();
+    }
+
+    void write_udword(const size_t offset, const udword value) override
+    {
+        ArrayByteMemory::write_udword(offset, value);
+        notify_write();
+    }
+
+    void write_uqword(const size_t offset, const uqword value) override
+    {
+        ArrayByteMemory::write_uqword(offset, value);
+        notify_write();
+    }
+
+    /// Returns the write generation, which changes whenever the memory is written to.
+    uword get_generation() const
+    {
+        return generation.load(std::memory_order_acquire);
+    }
+
+    /// Needs to go through the overriden methods above.
+    ubyte* byte_bus_host_memory() override
+    {
+        return nullptr;
+    }
+
+    int byte_bus_host_memory_fd() const override
+    {
+        return -1;
+    }
+
+private:
+    void notify_write()
+    {
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    std::atomic<uword> generation;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            cereal::base_class<ArrayByteMemory>(this)
+        );
+
+        // Loading replaces the contents.
+        notify_write();
+    }
+};
+
+CEREAL_SPECIALIZE_FOR_ALL_ARCHIVES(VuMicroMemory, cereal::specialization::member_serialize);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+
+#include <Parking.hpp>
+
+#include "Common/Types/Bitfield.hpp"
+#include "Resources/Ee/Vpu/VpuRegisters.hpp"
+
+/// Micro mode run state of a VU unit.
+/// Micro programs are started by the VIF (MSCAL, MSCNT, MSCALF) and run
+/// until the instruction pair following the one with the E bit set.
+/// A program may run on a separate thread to the controller which started it
+/// (see CoreOptions::vu1_thread), in which case everything else must call
+/// wait_for_finish() before accessing the state of the unit (VIF FLUSH*,
+/// VU1 register accesses through the VU0 bus, GIF PATH1).
+/// The VPU STAT.VBSn bit mirrors the running state, so the EE can poll it (CFC2).
+/// See VU Users Manual page 59 and 203.
+class VuMicroSync
+{
+public:
+    VuMicroSync() :
+        is_asynchronous(false),
+        is_end_pending(false),
+        stat(nullptr),
+        running(false),
+        exit(false)
+    {
+    }
+
+    /// Set when the micro programs are run by a dedicated thread, rather
+    /// than in step with the VU controller.
+    std::atomic<bool> is_asynchronous;
+
+    /// Set by the executor when the E bit has been seen, ending the
+    /// program after the next instruction pair. Only used by the executing thread.
+    bool is_end_pending;
+
+    /// Reference to the VPU STAT register, and the VBS bit of this unit.
+    VpuRegister_Stat* stat;
+    Bitfield stat_vbs;
+
+    bool is_running() const
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    /// Starts the micro program at the current PC (which must be set beforehand).
+    void start()
+    {
+        {
+            auto _lock = stat->scope_lock();
+            stat->insert_field(stat_vbs, 1);
+        }
+
+        is_end_pending = false;
+        running.store(true, std::memory_order_release);
+        start_event.notify();
+    }
+
+    /// Ends the micro program, called by the executor.
+    void finish()
+    {
+        {
+            auto _lock = stat->scope_lock();
+            stat->insert_field(stat_vbs, 0);
+        }
+
+        running.store(false, std::memory_order_release);
+        finish_event.notify();
+    }
+
+    /// Blocks until the micro program has finished, if it is running asynchronously.
+    /// Otherwise returns immediately, as the program is run in step with everything else.
+    void wait_for_finish()
+    {
+        if (!is_asynchronous.load(std::memory_order_acquire))
+            return;
+        finish_event.wait_until([this] { return !is_running(); });
+    }
+
+    /// Blocks until a micro program is started, for the asynchronous executor.
+    /// Returns false if the executor should exit instead.
+    bool wait_for_start()
+    {
+        start_event.wait_until([this] { return is_running() || exit.load(std::memory_order_acquire); });
+        return !exit.load(std::memory_order_acquire);
+    }
+
+    /// Makes the asynchronous executor exit (see wait_for_start()), which
+    /// may be part way through a program.
+    void request_exit()
+    {
+        exit.store(true, std::memory_order_release);
+        start_event.notify();
+    }
+
+    bool is_exit_requested() const
+    {
+        return exit.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<bool> running;
+    std::atomic<bool> exit;
+    Parking::Event start_event;
+    Parking::Event finish_event;
+};
@@ -42,8 +42,53 @@ void VuUnitRegister_Status::set_d_flag_sticky(const uword value)
     insert_field(D, value);
 }
 
+VuUnitRegister_Status::VuUnitRegister_Status() :
+    mac(nullptr)
+{
+}
+
+ubyte VuUnitRegister_Status::read_ubyte(const size_t offset)
+{
+    mac->flush();
+    return SizedWordRegister::read_ubyte(offset);
+}
+
+void VuUnitRegister_Status::write_ubyte(const size_t offset, const ubyte value)
+{
+    mac->flush();
+    SizedWordRegister::write_ubyte(offset, value);
+}
+
+uhword VuUnitRegister_Status::read_uhword(const size_t offset)
+{
+    mac->flush();
+    return SizedWordRegister::read_uhword(offset);
+}
+
+void VuUnitRegister_Status::write_uhword(const size_t offset, const uhword value)
+{
+    mac->flush();
+    SizedWordRegister::write_uhword(offset, value);
+}
+
+uword VuUnitRegister_Status::read_uword()
+{
+    mac->flush();
+    return SizedWordRegister::read_uword();
+}
+
+void VuUnitRegister_Status::write_uword(const uword value)
+{
+    mac->flush();
+    SizedWordRegister::write_uword(value);
+}
+
 VuUnitRegister_Mac::VuUnitRegister_Mac() :
-    status(nullptr)
+    status(nullptr),
+    pending_flags(0),
+    pending_sticky_flags(0),
+    is_flags_pending(false),
+    is_pending(false)
 {
 }
 
@@ -85,7 +130,151 @@ void VuUnitRegister_Mac::clear_vector_field(const VuVectorField::Field field)
     update_vector_field(field, {false, false, false, false});
 }
 
+void VuUnitRegister_Mac::flush()
+{
+    if (!is_pending)
+        return;
+
+    // Cleared first, as the Status register accesses below flush again.
+    is_pending = false;
+
+    // Update the relevant Status flags (Z, S, U, O) and their sticky flags.
+    // If only the sticky flags were updated, the MAC register and the other
+    // Status flags are left as-is.
+    const auto summarise = [](const uhword flags) -> uword {
+        return ((flags & 0x000F) ? 0x1 : 0)
+               | ((flags & 0x00F0) ? 0x2 : 0)
+               | ((flags & 0x0F00) ? 0x4 : 0)
+               | ((flags & 0xF000) ? 0x8 : 0);
+    };
+    uword status_value = status->read_uword();
+    if (is_flags_pending)
+    {
+        is_flags_pending = false;
+        SizedWordRegister::write_uword(pending_flags);
+        status_value = (status_value & ~0xFU) | summarise(pending_flags);
+    }
+    status->write_uword(status_value | (summarise(pending_sticky_flags) << 6));
+    pending_sticky_flags = 0;
+}
+
+void VuUnitRegister_Mac::initialize()
+{
+    pending_flags = 0;
+    pending_sticky_flags = 0;
+    is_flags_pending = false;
+    is_pending = false;
+    SizedWordRegister::initialize();
+}
+
+ubyte VuUnitRegister_Mac::read_ubyte(const size_t offset)
+{
+    flush();
+    return SizedWordRegister::read_ubyte(offset);
+}
+
+void VuUnitRegister_Mac::write_ubyte(const size_t offset, const ubyte value)
+{
+    flush();
+    SizedWordRegister::write_ubyte(offset, value);
+}
+
+uhword VuUnitRegister_Mac::read_uhword(const size_t offset)
+{
+    flush();
+    return SizedWordRegister::read_uhword(offset);
+}
+
+void VuUnitRegister_Mac::write_uhword(const size_t offset, const uhword value)
+{
+    flush();
+    SizedWordRegister::write_uhword(offset, value);
+}
+
+uword VuUnitRegister_Mac::read_uword()
+{
+    flush();
+    return SizedWordRegister::read_uword();
+}
+
+void VuUnitRegister_Mac::write_uword(const uword value)
+{
+    flush();
+    SizedWordRegister::write_uword(value);
+}
+
 void VuUnitRegister_Clipping::shift_judgement()
 {
     write_uword((read_uword() << 6) & 0x00FFFFFF);
 }
+
+VuUnitRegister_Clipping::VuUnitRegister_Clipping() :
+    pending(),
+    number_pending(0)
+{
+}
+
+void VuUnitRegister_Clipping::flush()
+{
+    if (!number_pending)
+        return;
+
+    uword value = SizedWordRegister::read_uword();
+    for (size_t i = 0; i < number_pending; i++)
+    {
+        // Same as shift_judgement(), followed by setting the {NEG/POS}{X/Y/Z}_0 bits.
+        const Judgement& judgement = pending[i];
+        const uword bits = ((judgement.x < -judgement.w) ? 0x01 : 0)
+                           | ((judgement.x > judgement.w) ? 0x02 : 0)
+                           | ((judgement.y < -judgement.w) ? 0x04 : 0)
+                           | ((judgement.y > judgement.w) ? 0x08 : 0)
+                           | ((judgement.z < -judgement.w) ? 0x10 : 0)
+                           | ((judgement.z > judgement.w) ? 0x20 : 0);
+        value = ((value << 6) | bits) & 0x00FFFFFF;
+    }
+    SizedWordRegister::write_uword(value);
+
+    number_pending = 0;
+}
+
+void VuUnitRegister_Clipping::initialize()
+{
+    number_pending = 0;
+    SizedWordRegister::initialize();
+}
+
+ubyte VuUnitRegister_Clipping::read_ubyte(const size_t offset)
+{
+    flush();
+    return SizedWordRegister::read_ubyte(offset);
+}
+
+void VuUnitRegister_Clipping::write_ubyte(const size_t offset, const ubyte value)
+{
+    flush();
+    SizedWordRegister::write_ubyte(offset, value);
+}
+
+uhword VuUnitRegister_Clipping::read_uhword(const size_t offset)
+{
+    flush();
+    return SizedWordRegister::read_uhword(offset);
+}
+
+void VuUnitRegister_Clipping::write_uhword(const size_t offset, const uhword value)
+{
+    flush();
+    SizedWordRegister::write_uhword(offset, value);
+}
+
+uword VuUnitRegister_Clipping::read_uword()
+{
+    flush();
+    return SizedWordRegister::read_uword();
+}
+
+void VuUnitRegister_Clipping::write_uword(const uword value)
+{
+    number_pending = 0;
+    SizedWordRegister::write_uword(value);
+}
@@ -4,8 +4,13 @@
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Resources/Ee/Vpu/Vu/VuVectorField.hpp"
 
+class VuUnitRegister_Mac;
+
 /// The VU unit Status flags register.
 /// See VU Users Manual page 39.
+/// The Z, S, U and O flags (and their sticky flags) are derived from the MAC
+/// flags, which are updated lazily - see VuUnitRegister_Mac. Any access to
+/// this register materialises the pending flags first.
 class VuUnitRegister_Status : public SizedWordRegister
 {
 public:
@@ -32,6 +37,23 @@ public:
     void set_o_flag_sticky(const uword value);
     void set_i_flag_sticky(const uword value);
     void set_d_flag_sticky(const uword value);
+
+    VuUnitRegister_Status();
+
+    /// Materialise the pending MAC flags before accessing the register.
+    ubyte read_ubyte(const size_t offset) override;
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    uhword read_uhword(const size_t offset) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    uword read_uword() override;
+    void write_uword(const uword value) override;
+
+    /// A reference to the VU MAC flags register, which holds the pending flag updates.
+    VuUnitRegister_Mac* mac;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive);
 };
 
 /// The VU unit MAC flags register.
@@ -70,11 +92,75 @@ public:
     void update_vector_field(const VuVectorField::Field field, const FpuFlags& flags);
     void clear_vector_field(const VuVectorField::Field field);
 
+    /// Updates all of the flags for all of the vector fields at once, from a
+    /// value in the MAC register layout (ie: generated by VuVector::to_ps2()).
+    /// The Status flags are set if the flag is set for any of the fields.
+    /// The update is deferred: only the flags are recorded, and the MAC and
+    /// Status registers are written when either of them is next accessed (by
+    /// the flag instructions, CFC2 or a bus read), as most results are never
+    /// inspected. The sticky flags are accumulated in the meantime.
+    void update_vector_fields(const uhword flags)
+    {
+        pending_flags = flags;
+        pending_sticky_flags |= flags;
+        is_flags_pending = true;
+        is_pending = true;
+    }
+
+    /// Only accumulates the sticky Status flags, leaving the MAC register (and
+    /// the non-sticky Status flags) as-is. Used when the result flags are
+    /// known to be overwritten before they are read (see VuFlagLiveness).
+    void update_sticky_fields(const uhword flags)
+    {
+        pending_sticky_flags |= flags;
+        is_pending = true;
+    }
+
+    /// Writes the pending flag updates to the MAC and Status registers.
+    void flush();
+
+    /// Materialise the pending flags before accessing the register.
+    void initialize() override;
+    ubyte read_ubyte(const size_t offset) override;
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    uhword read_uhword(const size_t offset) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    uword read_uword() override;
+    void write_uword(const uword value) override;
+
     /// A reference to the VU status flags register, which fields are changed when various MAC register write conditions occur.
     /// See VU Users Manual page 39.
     VuUnitRegister_Status* status;
+
+private:
+    /// Flags of the last (deferred) update, in the MAC register layout.
+    uhword pending_flags;
+
+    /// All flags set since the last flush, for the sticky Status flags.
+    uhword pending_sticky_flags;
+
+    /// Set if pending_flags holds an update which is yet to be written.
+    bool is_flags_pending;
+
+    /// Set if there is any update yet to be written (including sticky flags only).
+    bool is_pending;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        flush();
+        SizedWordRegister::serialize(archive);
+    }
 };
 
+template<class Archive>
+void VuUnitRegister_Status::serialize(Archive & archive)
+{
+    mac->flush();
+    SizedWordRegister::serialize(archive);
+}
+
 /// The VU unit Clipping flags register.
 /// See VU Users Manual page 39.
 /// Bitfields are organsied by {Neg/Pos}{X/Y/Z}_{digit below} for:
@@ -82,6 +168,9 @@ public:
 /// - Previous judgement = 1.
 /// - 2nd previous judgement = 2.
 /// - 3rd previous judgement = 3.
+/// Judgements made by the CLIP instruction are deferred in the same way as
+/// the MAC flags: the inputs of the last few judgements are recorded, and
+/// the register is updated when it is next accessed.
 class VuUnitRegister_Clipping : public SizedWordRegister
 {
 public:
@@ -115,6 +204,55 @@ public:
     // See VU Users Manual page 75 & 202.
     // Designed to be used in the CLIP instruction first, then set the clipping results.
     void shift_judgement();
+
+    /// Maximum number of judgements held in the register (and pending).
+    static constexpr size_t NUMBER_JUDGEMENTS = 4;
+
+    VuUnitRegister_Clipping();
+
+    /// Records a (deferred) judgement of the x, y and z values given against
+    /// +/- w, where w is already an absolute value (see CLIP).
+    void add_judgement(const f32 x, const f32 y, const f32 z, const f32 w)
+    {
+        if (number_pending == NUMBER_JUDGEMENTS)
+            flush();
+        pending[number_pending++] = {x, y, z, w};
+    }
+
+    /// Writes the pending judgements to the register.
+    void flush();
+
+    /// Materialise the pending judgements before accessing the register.
+    /// Full writes discard them instead, as they would be overwritten.
+    void initialize() override;
+    ubyte read_ubyte(const size_t offset) override;
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    uhword read_uhword(const size_t offset) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    uword read_uword() override;
+    void write_uword(const uword value) override;
+
+private:
+    /// Inputs of a pending judgement.
+    struct Judgement
+    {
+        f32 x;
+        f32 y;
+        f32 z;
+        f32 w;
+    };
+
+    /// Pending judgements, oldest first.
+    Judgement pending[NUMBER_JUDGEMENTS];
+    size_t number_pending;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        flush();
+        SizedWordRegister::serialize(archive);
+    }
 };
 
 /// The VU unit CMSAR register.
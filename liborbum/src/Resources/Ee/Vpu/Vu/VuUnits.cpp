@@ -3,7 +3,6 @@
 #include "Common/Types/Bus/ByteBus.hpp"
 #include "Common/Types/Memory/ArrayByteMemory.hpp"
 #include "Common/Types/Register/SizedHwordRegister.hpp"
-#include "Common/Types/Register/SizedQwordRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Resources/Ee/Core/EeCoreCop0.hpp"
 #include "Resources/Ee/Core/EeCoreCop0Registers.hpp"
@@ -15,6 +14,8 @@ VuUnit_Base::VuUnit_Base(const int core_id) :
        SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister(),
        SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister(),
        SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister(), SizedHwordRegister()},
+    instruction_memory(nullptr),
+    data_memory(nullptr),
     bus(8) // TODO: fine tune.
 {
 }
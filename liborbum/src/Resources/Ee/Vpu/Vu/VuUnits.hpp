@@ -8,11 +8,13 @@
 #include "Common/Types/Memory/ArrayByteMemory.hpp"
 #include "Common/Types/Mips/MipsCoprocessor.hpp"
 #include "Common/Types/Primitive.hpp"
+#include "Common/Types/Register/AlignedQwordRegister.hpp"
 #include "Common/Types/Register/MapperHwordWordRegister.hpp"
 #include "Common/Types/Register/PcRegisters.hpp"
 #include "Common/Types/Register/SizedHwordRegister.hpp"
-#include "Common/Types/Register/SizedQwordRegister.hpp"
 #include "Controller/Ee/Vpu/Vu/VuBranchDelaySlot.hpp"
+#include "Resources/Ee/Vpu/Vu/VuMicroMemory.hpp"
+#include "Resources/Ee/Vpu/Vu/VuMicroSync.hpp"
 #include "Resources/Ee/Vpu/Vu/VuUnitRegisters.hpp"
 
 class EeCoreCop0;
@@ -28,13 +30,14 @@ public:
 
     /// VU floating point registers (VF) (128-bit) and integer registers (VI) (16-bit).
     /// The first VI register is a constant 0 register.
+    /// The VF registers form a flat, aligned register file (see AlignedQwordRegister).
     /// See VU Users Manual page 18.
-    SizedQwordRegister vf[Constants::EE::VPU::VU::NUMBER_VF_REGISTERS];
+    AlignedQwordRegister vf[Constants::EE::VPU::VU::NUMBER_VF_REGISTERS];
     SizedHwordRegister vi[Constants::EE::VPU::VU::NUMBER_VI_REGISTERS];
 
     /// ACC register. Used by instructions such as ADDA and MULA.
     /// See VU Users Manual page 33.
-    SizedQwordRegister acc;
+    AlignedQwordRegister acc;
 
     /// I register. Used to store immediate values.
     /// See VU Users Manual page 33.
@@ -69,6 +72,17 @@ public:
     /// See VU Users Manual page 202.
     VuUnitRegister_Cmsar cmsar;
 
+    /// Micro mode run state, see VuMicroSync.
+    VuMicroSync micro_sync;
+
+    /// Reference to the micro memory of the unit (defined in the derived classes),
+    /// which the micro program instructions are fetched from.
+    VuMicroMemory* instruction_memory;
+
+    /// Reference to the data memory of the unit (defined in the derived classes),
+    /// which the VIF unpacks data into.
+    ArrayByteMemory* data_memory;
+
     /// VU0 contains a physical memory map of its real working space (& mirrors) and the VU1 registers.
     /// For VU1, it is just a direct map of its real working space (needed to keep it OOP friendly).
     /// See EE Users Manual page 84.
@@ -78,6 +92,10 @@ public:
     /// Used by different things, eg: ccr registers for VU0 and bus mappings for VU1.
     MapperHwordWordRegister vi_32[Constants::EE::VPU::VU::NUMBER_VI_REGISTERS];
 
+    /// Mappers for the VF registers to QwordRegisters.
+    /// Used for bus mappings for VU1.
+    MapperAlignedQwordRegister vf_128[Constants::EE::VPU::VU::NUMBER_VF_REGISTERS];
+
 public:
     template<class Archive>
     void serialize(Archive & archive)
@@ -111,7 +129,7 @@ public:
     bool is_usable() override;
 
     /// VU memory, defined on page 18 of the VU Users Manual.
-    ArrayByteMemory memory_micro; // 4 KiB.
+    VuMicroMemory memory_micro;   // 4 KiB.
     ArrayByteMemory memory_mem;   // 4 KiB.
 
     /// The CCR (control registers) array (32) needed for the CTC2 and CFC2 EE Core instructions.
@@ -142,7 +160,7 @@ public:
     VuUnit_Vu1(const int core_id);
 
     /// VU memory, defined on page 18 of the VU Users Manual.
-    ArrayByteMemory memory_micro; // 16 KiB.
+    VuMicroMemory memory_micro;   // 16 KiB.
     ArrayByteMemory memory_mem;   // 16 KiB.
 
 public:
@@ -1,8 +1,28 @@
 #pragma once
 
+#include <vector>
+
+#include "Common/Types/Primitive.hpp"
+
 /// CRTC resources.
 class RCrtc
 {
+public:
+    RCrtc() :
+        frame_width(0),
+        frame_height(0),
+        frame_count(0)
+    {
+    }
+
+    /// Host frame buffer, holding the last frame scanned out of GS local memory
+    /// (see CCrtc::scan_out()) as row major 32-bit pixels (R, G, B, A bytes).
+    /// Output only, so not part of the saved state.
+    std::vector<uword> frame_buffer;
+    uword frame_width;
+    uword frame_height;
+    udword frame_count;
+
 public:
     template<class Archive>
     void serialize(Archive & archive)
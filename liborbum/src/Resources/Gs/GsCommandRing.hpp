@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <cereal/cereal.hpp>
+
+#include <Parking.hpp>
+#include <Queues.hpp>
+
+#include "Common/Types/Primitive.hpp"
+
+/// A GS general register write, as sent through the GIF.
+struct GsRegisterWrite
+{
+    /// General register address (see RGs), ie: 0x00 = PRIM.
+    ubyte address;
+    udword data;
+};
+
+/// A batch of GS general register writes, in order. The GIF sends writes in
+/// batches to keep the per write queue overhead down.
+struct GsRegisterWriteBatch
+{
+    static constexpr size_t MAX_WRITES = 128;
+
+    size_t number_writes;
+    GsRegisterWrite writes[MAX_WRITES];
+};
+
+/// Command ring carrying the register write batches from the GIF (the only
+/// producer) to the GS core (the only consumer).
+/// The GS core either runs in step with the GS controller, or on a dedicated
+/// thread (see CoreOptions::gs_thread), in which case it only synchronises
+/// with the rest of the system when the GS state is observed:
+///  - EE reads of CSR and SIGLBLID (the results of SIGNAL, FINISH and LABEL),
+///    and the CRTC scan-out, call sync() first.
+///  - Local -> host transmissions park the GS thread until the GS controller
+///    has sent the data out (see CGsCore::send_readback()).
+/// Occupancy and stall statistics are kept for both sides.
+class GsCommandRing
+{
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    GsCommandRing() :
+        is_asynchronous(false),
+        number_pushed(0),
+        number_popped(0),
+        number_completed(0),
+        sync_target(0),
+        parked(false),
+        exit(false),
+        number_push_stalls(0),
+        number_syncs(0),
+        sync_time_ns(0),
+        number_parks(0),
+        max_occupancy(0),
+        total_occupancy(0)
+    {
+    }
+
+    /// Set while the batches are consumed by the GS thread.
+    std::atomic<bool> is_asynchronous;
+
+    /// (Producer) Adds a batch, returning false if the ring is full.
+    bool try_push(const GsRegisterWriteBatch& batch)
+    {
+        if (!queue.try_push(batch))
+        {
+            number_push_stalls.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const size_t pushed = number_pushed.fetch_add(1, std::memory_order_acq_rel) + 1;
+        const size_t occupancy = pushed - number_popped.load(std::memory_order_acquire);
+        total_occupancy.fetch_add(occupancy, std::memory_order_relaxed);
+        if (occupancy > max_occupancy.load(std::memory_order_relaxed))
+            max_occupancy.store(occupancy, std::memory_order_relaxed);
+        push_event.notify();
+        return true;
+    }
+
+    /// (Consumer) Takes the next batch, returning false if there is none.
+    bool try_pop(GsRegisterWriteBatch& batch)
+    {
+        if (!queue.try_pop(batch))
+            return false;
+        number_popped.fetch_add(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    /// (Consumer) Blocks until a batch is available, returning false if the
+    /// GS thread should exit instead.
+    bool wait_for_batch()
+    {
+        push_event.wait_until([this] { return queue.has_read_available() || is_exit_requested(); });
+        return !is_exit_requested();
+    }
+
+    /// (Consumer) Marks all the batches taken so far as completed, which
+    /// must only be done once their drawing has been flushed to memory.
+    void complete()
+    {
+        number_completed.store(number_popped.load(std::memory_order_relaxed), std::memory_order_release);
+        complete_event.notify();
+    }
+
+    /// (Consumer) Returns if a sync() is waiting on the batches taken so far,
+    /// so they should be completed without waiting for the ring to empty.
+    bool is_sync_requested() const
+    {
+        const size_t target = sync_target.load(std::memory_order_acquire);
+        return number_completed.load(std::memory_order_relaxed) < target && number_popped.load(std::memory_order_relaxed) >= target;
+    }
+
+    /// (Consumer) Completes the batches taken so far and blocks while a
+    /// local -> host transmission is sent out by the GS controller.
+    void park()
+    {
+        number_parks.fetch_add(1, std::memory_order_relaxed);
+        parked.store(true, std::memory_order_release);
+        complete();
+        unpark_event.wait_until([this] { return !is_parked() || is_exit_requested(); });
+    }
+
+    /// Returns if the GS thread is parked (see park()), in which case the GS
+    /// core state is owned by the GS controller.
+    bool is_parked() const
+    {
+        return parked.load(std::memory_order_acquire);
+    }
+
+    /// Lets the GS thread continue after a local -> host transmission.
+    void unpark()
+    {
+        parked.store(false, std::memory_order_release);
+        unpark_event.notify();
+    }
+
+    /// Blocks until the GS thread has completed all the batches pushed so
+    /// far (or is parked). Returns immediately when not asynchronous.
+    void sync()
+    {
+        if (!is_asynchronous.load(std::memory_order_acquire))
+            return;
+
+        const size_t target = number_pushed.load(std::memory_order_acquire);
+        auto is_synced = [this, target] { return number_completed.load(std::memory_order_acquire) >= target || is_parked(); };
+        if (is_synced())
+            return;
+
+        const auto start = std::chrono::steady_clock::now();
+        size_t requested = sync_target.load(std::memory_order_relaxed);
+        while (requested < target && !sync_target.compare_exchange_weak(requested, target, std::memory_order_acq_rel))
+            ;
+        push_event.notify();
+        complete_event.wait_until(is_synced);
+
+        number_syncs.fetch_add(1, std::memory_order_relaxed);
+        sync_time_ns.fetch_add(static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+    }
+
+    /// Makes the GS thread exit (see wait_for_batch() and park()).
+    void request_exit()
+    {
+        exit.store(true, std::memory_order_release);
+        push_event.notify();
+        unpark_event.notify();
+    }
+
+    bool is_exit_requested() const
+    {
+        return exit.load(std::memory_order_acquire);
+    }
+
+    /// Statistics.
+    /// Occupancy is in batches, sampled on each push. Push stalls are the
+    /// pushes refused because the ring was full (the GIF stalls), and syncs
+    /// are the calls to sync() which had to wait for the GS thread.
+    size_t get_number_pushed() const { return number_pushed.load(std::memory_order_relaxed); }
+    size_t get_number_push_stalls() const { return number_push_stalls.load(std::memory_order_relaxed); }
+    size_t get_max_occupancy() const { return max_occupancy.load(std::memory_order_relaxed); }
+    double get_average_occupancy() const
+    {
+        const size_t pushed = get_number_pushed();
+        return pushed ? (static_cast<double>(total_occupancy.load(std::memory_order_relaxed)) / pushed) : 0.0;
+    }
+    size_t get_number_syncs() const { return number_syncs.load(std::memory_order_relaxed); }
+    double get_sync_time_us() const { return sync_time_ns.load(std::memory_order_relaxed) / 1.0e3; }
+    size_t get_number_parks() const { return number_parks.load(std::memory_order_relaxed); }
+
+private:
+    SpscQueue<GsRegisterWriteBatch, CAPACITY> queue;
+
+    /// Batches pushed by the GIF, taken by the GS core, and completed by the
+    /// GS thread (see complete()).
+    std::atomic<size_t> number_pushed;
+    std::atomic<size_t> number_popped;
+    std::atomic<size_t> number_completed;
+
+    /// Highest number of pushed batches a sync() is waiting on. Requests are
+    /// outstanding until number_completed reaches it, so completing earlier
+    /// batches never drops a request made in the meantime.
+    std::atomic<size_t> sync_target;
+    std::atomic<bool> parked;
+    std::atomic<bool> exit;
+    Parking::Event push_event;
+    Parking::Event complete_event;
+    Parking::Event unpark_event;
+
+    std::atomic<size_t> number_push_stalls;
+    std::atomic<size_t> number_syncs;
+    std::atomic<size_t> sync_time_ns;
+    std::atomic<size_t> number_parks;
+    std::atomic<size_t> max_occupancy;
+    std::atomic<size_t> total_occupancy;
+
+public:
+    /// The GS thread must be synced beforehand (see Core::save_state()).
+    template<class Archive>
+    void save(Archive & archive) const
+    {
+        archive(CEREAL_NVP(queue));
+    }
+
+    template<class Archive>
+    void load(Archive & archive)
+    {
+        archive(CEREAL_NVP(queue));
+
+        // Push the loaded batches again so the counters match.
+        std::vector<GsRegisterWriteBatch> batches;
+        GsRegisterWriteBatch batch;
+        while (queue.try_pop(batch))
+            batches.push_back(batch);
+
+        number_pushed.store(0, std::memory_order_relaxed);
+        number_popped.store(0, std::memory_order_relaxed);
+        number_completed.store(0, std::memory_order_relaxed);
+        sync_target.store(0, std::memory_order_relaxed);
+        for (const auto& loaded_batch : batches)
+            try_push(loaded_batch);
+    }
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Register/SizedDwordRegister.hpp"
+#include "Resources/Gs/GsRegisters.hpp"
+
+/// GS drawing environment context registers (the _1 and _2 sets), selected
+/// for drawing by PRIM.CTXT (or PRMODE.CTXT).
+/// TEX2 has no storage of its own - it writes the PSM and CLUT fields of TEX0.
+/// See GS Users Manual page 45.
+class GsContext
+{
+public:
+    GsRegister_Xyoffset xyoffset;
+    GsRegister_Tex0 tex0;
+    GsRegister_Tex1 tex1;
+    GsRegister_Clamp clamp;
+    GsRegister_Miptbp miptbp1;
+    GsRegister_Miptbp miptbp2;
+    GsRegister_Scissor scissor;
+    GsRegister_Alpha alpha;
+    GsRegister_Test test;
+    GsRegister_Enable fba;
+    GsRegister_Frame frame;
+    GsRegister_Zbuf zbuf;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(xyoffset),
+            CEREAL_NVP(tex0),
+            CEREAL_NVP(tex1),
+            CEREAL_NVP(clamp),
+            CEREAL_NVP(miptbp1),
+            CEREAL_NVP(miptbp2),
+            CEREAL_NVP(scissor),
+            CEREAL_NVP(alpha),
+            CEREAL_NVP(test),
+            CEREAL_NVP(fba),
+            CEREAL_NVP(frame),
+            CEREAL_NVP(zbuf)
+        );
+    }
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Raw register values making up a GS vertex, latched on a XYZ(F)2/3 write.
+struct GsVertexRegisters
+{
+    udword xyz;
+    udword rgbaq;
+    udword st;
+    udword uv;
+    ubyte f;
+
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(xyz),
+            CEREAL_NVP(rgbaq),
+            CEREAL_NVP(st),
+            CEREAL_NVP(uv),
+            CEREAL_NVP(f)
+        );
+    }
+};
+
+/// Internal GS core state which isn't visible through registers: the vertex
+/// queue, the host <-> local transmission state and the CLUT buffer.
+/// See GS Users Manual page 26 (vertex queue), 33 (CLUT buffer) and 58 (transmission).
+class GsCoreState
+{
+public:
+    GsCoreState() :
+        number_vertices(0),
+        transfer_active(false),
+        readback_active(false),
+        transfer_y(0),
+        transfer_buffer_position(0),
+        clut_cbp0(0),
+        clut_cbp1(0),
+        clut{}
+    {
+    }
+
+    /// Vertex queue, up to 3 vertices are needed for a primitive.
+    GsVertexRegisters vertices[3];
+    int number_vertices;
+
+    /// Host <-> local transmission state, which is started by the TRXDIR write.
+    /// Host -> local (TRXDIR = 0): HWREG data is buffered until whole rows can
+    /// be written in bulk (see GsLocalMemory::write_pixels()), the row count
+    /// written so far being relative to TRXPOS.DSAY.
+    /// Local -> host (TRXDIR = 1): the whole area is read into the buffer by
+    /// the TRXDIR write, then sent out from the position given as the host
+    /// takes it.
+    bool transfer_active;
+    bool readback_active;
+    uword transfer_y;
+    std::vector<ubyte> transfer_buffer;
+    size_t transfer_buffer_position;
+
+    /// CLUT buffer, loaded from local memory by TEX0/TEX2 writes (TEX0.CLD).
+    /// Holds 256 32-bit entries or 512 16-bit entries (each stored in a word).
+    /// CBP0/CBP1 are the buffer base pointers compared against for CLD = 4/5.
+    uword clut_cbp0;
+    uword clut_cbp1;
+    uword clut[512];
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(vertices),
+            CEREAL_NVP(number_vertices),
+            CEREAL_NVP(transfer_active),
+            CEREAL_NVP(readback_active),
+            CEREAL_NVP(transfer_y),
+            CEREAL_NVP(transfer_buffer),
+            CEREAL_NVP(transfer_buffer_position),
+            CEREAL_NVP(clut_cbp0),
+            CEREAL_NVP(clut_cbp1),
+            CEREAL_NVP(clut)
+        );
+    }
+};
@@ -0,0 +1,308 @@
+#include <cstring>
+
+#include "Resources/Gs/GsLocalMemory.hpp"
+
+namespace
+{
+/// Transmission area size, positions wrap around at this.
+constexpr uword TRANSMISSION_AREA_SIZE = 2048;
+
+/// Reads/writes the pixel at the index given of packed transfer data.
+uword read_transfer_pixel(const ubyte* data, const size_t index, const int bits)
+{
+    switch (bits)
+    {
+    case 32:
+    {
+        uword value;
+        std::memcpy(&value, data + index * 4, 4);
+        return value;
+    }
+    case 24:
+    {
+        const ubyte* bytes = data + index * 3;
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+    }
+    case 16:
+    {
+        uhword value;
+        std::memcpy(&value, data + index * 2, 2);
+        return value;
+    }
+    case 8:
+        return data[index];
+    default:
+        return (data[index >> 1] >> ((index & 0x1) * 4)) & 0xF;
+    }
+}
+
+void write_transfer_pixel(ubyte* data, const size_t index, const int bits, const uword value)
+{
+    switch (bits)
+    {
+    case 32:
+        std::memcpy(data + index * 4, &value, 4);
+        break;
+    case 24:
+    {
+        ubyte* bytes = data + index * 3;
+        bytes[0] = static_cast<ubyte>(value);
+        bytes[1] = static_cast<ubyte>(value >> 8);
+        bytes[2] = static_cast<ubyte>(value >> 16);
+        break;
+    }
+    case 16:
+    {
+        const uhword hword = static_cast<uhword>(value);
+        std::memcpy(data + index * 2, &hword, 2);
+        break;
+    }
+    case 8:
+        data[index] = static_cast<ubyte>(value);
+        break;
+    default:
+    {
+        const int shift = (index & 0x1) * 4;
+        ubyte& byte = data[index >> 1];
+        byte = static_cast<ubyte>((byte & ~(0xF << shift)) | ((value & 0xF) << shift));
+        break;
+    }
+    }
+}
+
+/// Splits a rectangle into the whole blocks within it (when the rows allow
+/// byte addressing of the blocks), and the pixels around them.
+/// pixel_function(x, y, index) is called for each edge pixel (wrapped
+/// position, pixel index within the data), and block_function(x, y, offset)
+/// for each block (block position, byte offset of its first row within the data).
+template <typename PixelFunction, typename BlockFunction>
+void split_rectangle(const uword block_width, const uword block_height, const int bits,
+                     const uword x, const uword y, const uword width, const uword height,
+                     PixelFunction pixel_function, BlockFunction block_function)
+{
+    uword x0 = (x + block_width - 1) & ~(block_width - 1);
+    uword x1 = (x + width) & ~(block_width - 1);
+    uword y0 = (y + block_height - 1) & ~(block_height - 1);
+    uword y1 = (y + height) & ~(block_height - 1);
+
+    const bool is_bulk = (x + width <= TRANSMISSION_AREA_SIZE) && (y + height <= TRANSMISSION_AREA_SIZE)
+                         && (x0 < x1) && (y0 < y1)
+                         && (((width * bits) % 8) == 0) && ((((x0 - x) * bits) % 8) == 0);
+    if (!is_bulk)
+    {
+        x0 = x1 = x;
+        y0 = y1 = y;
+    }
+
+    for (uword row = 0; row < height; row++)
+    {
+        const uword pixel_y = y + row;
+        const bool is_block_row = (pixel_y >= y0) && (pixel_y < y1);
+        for (uword column = 0; column < width; column++)
+        {
+            const uword pixel_x = x + column;
+            if (is_block_row && (pixel_x == x0))
+            {
+                column = x1 - x - 1;
+                continue;
+            }
+            pixel_function(pixel_x & (TRANSMISSION_AREA_SIZE - 1), pixel_y & (TRANSMISSION_AREA_SIZE - 1), static_cast<size_t>(row) * width + column);
+        }
+    }
+
+    for (uword block_y = y0; block_y < y1; block_y += block_height)
+        for (uword block_x = x0; block_x < x1; block_x += block_width)
+            block_function(block_x, block_y, ((static_cast<size_t>(block_y - y) * width + (block_x - x)) * bits) / 8);
+}
+} // namespace
+
+void GsLocalMemory::write_pixels(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const uword width, const uword height, const ubyte* data)
+{
+    const int bits = transfer_bits_per_pixel(psm);
+    if (!bits)
+        return;
+
+    uword block_width, block_height;
+    get_block_size(psm, block_width, block_height);
+    const size_t pitch = (static_cast<size_t>(width) * bits) / 8;
+
+    split_rectangle(
+        block_width, block_height, bits, x, y, width, height,
+        [&](const uword pixel_x, const uword pixel_y, const size_t index) {
+            write_pixel(psm, bp, bw, pixel_x, pixel_y, read_transfer_pixel(data, index, bits));
+        },
+        [&](const uword block_x, const uword block_y, const size_t offset) {
+            write_block(psm, bp, bw, block_x, block_y, data + offset, pitch);
+        });
+}
+
+void GsLocalMemory::read_pixels(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const uword width, const uword height, ubyte* data)
+{
+    const int bits = transfer_bits_per_pixel(psm);
+    if (!bits)
+        return;
+
+    uword block_width, block_height;
+    get_block_size(psm, block_width, block_height);
+    const size_t pitch = (static_cast<size_t>(width) * bits) / 8;
+
+    split_rectangle(
+        block_width, block_height, bits, x, y, width, height,
+        [&](const uword pixel_x, const uword pixel_y, const size_t index) {
+            write_transfer_pixel(data, index, bits, read_pixel(psm, bp, bw, pixel_x, pixel_y));
+        },
+        [&](const uword block_x, const uword block_y, const size_t offset) {
+            read_block(psm, bp, bw, block_x, block_y, data + offset, pitch);
+        });
+}
+
+void GsLocalMemory::get_block_size(const uword psm, uword& width, uword& height)
+{
+    switch (psm)
+    {
+    case PSMCT16:
+    case PSMCT16S:
+    case PSMZ16:
+    case PSMZ16S:
+        width = GsSwizzle::BLOCK_WIDTH_16;
+        height = GsSwizzle::BLOCK_HEIGHT_16;
+        break;
+    case PSMT8:
+        width = GsSwizzle::BLOCK_WIDTH_8;
+        height = GsSwizzle::BLOCK_HEIGHT_8;
+        break;
+    case PSMT4:
+        width = GsSwizzle::BLOCK_WIDTH_4;
+        height = GsSwizzle::BLOCK_HEIGHT_4;
+        break;
+    default:
+        width = GsSwizzle::BLOCK_WIDTH_32;
+        height = GsSwizzle::BLOCK_HEIGHT_32;
+        break;
+    }
+}
+
+void GsLocalMemory::write_block(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const ubyte* rows, const size_t pitch)
+{
+    // Formats sharing the 32-bit layout with fewer bits are expanded into
+    // words first, then merged in under a mask.
+    uword expanded[64];
+    uword mask = 0;
+    switch (psm)
+    {
+    case PSMCT32:
+        GsSwizzle::write_block_32(words() + address_32(bp, bw, x, y), rows, pitch, 0xFFFFFFFF);
+        return;
+    case PSMZ32:
+        GsSwizzle::write_block_32(words() + address_32z(bp, bw, x, y), rows, pitch, 0xFFFFFFFF);
+        return;
+    case PSMCT16:
+        GsSwizzle::write_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMCT16S:
+        GsSwizzle::write_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16S, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMZ16:
+        GsSwizzle::write_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16Z, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMZ16S:
+        GsSwizzle::write_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16SZ, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMT8:
+        GsSwizzle::write_block_8(get_memory() + address_8(bp, bw, x, y), rows, pitch);
+        return;
+    case PSMT4:
+        GsSwizzle::write_block_4(get_memory() + (address_4(bp, bw, x, y) >> 1), rows, pitch);
+        return;
+    case PSMCT24:
+    case PSMZ24:
+        for (uword i = 0; i < 64; i++)
+            expanded[i] = read_transfer_pixel(rows + (i >> 3) * pitch, i & 0x7, 24);
+        mask = 0x00FFFFFF;
+        break;
+    case PSMT8H:
+        for (uword i = 0; i < 64; i++)
+            expanded[i] = rows[(i >> 3) * pitch + (i & 0x7)] << 24;
+        mask = 0xFF000000;
+        break;
+    case PSMT4HL:
+        for (uword i = 0; i < 64; i++)
+            expanded[i] = read_transfer_pixel(rows + (i >> 3) * pitch, i & 0x7, 4) << 24;
+        mask = 0x0F000000;
+        break;
+    case PSMT4HH:
+        for (uword i = 0; i < 64; i++)
+            expanded[i] = read_transfer_pixel(rows + (i >> 3) * pitch, i & 0x7, 4) << 28;
+        mask = 0xF0000000;
+        break;
+    default:
+        return;
+    }
+
+    const uword address = (psm == PSMZ24) ? address_32z(bp, bw, x, y) : address_32(bp, bw, x, y);
+    GsSwizzle::write_block_32(words() + address, reinterpret_cast<const ubyte*>(expanded), 8 * NUMBER_BYTES_IN_WORD, mask);
+}
+
+void GsLocalMemory::read_block(const uword psm, const uword bp, const uword bw, const uword x, const uword y, ubyte* rows, const size_t pitch)
+{
+    uword expanded[64];
+    switch (psm)
+    {
+    case PSMCT32:
+        GsSwizzle::read_block_32(words() + address_32(bp, bw, x, y), rows, pitch);
+        return;
+    case PSMZ32:
+        GsSwizzle::read_block_32(words() + address_32z(bp, bw, x, y), rows, pitch);
+        return;
+    case PSMCT16:
+        GsSwizzle::read_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMCT16S:
+        GsSwizzle::read_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16S, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMZ16:
+        GsSwizzle::read_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16Z, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMZ16S:
+        GsSwizzle::read_block_16(hwords() + address_16(GsSwizzle::PAGE_TABLE_16SZ, bp, bw, x, y), rows, pitch);
+        return;
+    case PSMT8:
+        GsSwizzle::read_block_8(get_memory() + address_8(bp, bw, x, y), rows, pitch);
+        return;
+    case PSMT4:
+        GsSwizzle::read_block_4(get_memory() + (address_4(bp, bw, x, y) >> 1), rows, pitch);
+        return;
+    case PSMCT24:
+    case PSMT8H:
+    case PSMT4HL:
+    case PSMT4HH:
+        GsSwizzle::read_block_32(words() + address_32(bp, bw, x, y), reinterpret_cast<ubyte*>(expanded), 8 * NUMBER_BYTES_IN_WORD);
+        break;
+    case PSMZ24:
+        GsSwizzle::read_block_32(words() + address_32z(bp, bw, x, y), reinterpret_cast<ubyte*>(expanded), 8 * NUMBER_BYTES_IN_WORD);
+        break;
+    default:
+        return;
+    }
+
+    // Pack the words back down to the transfer format.
+    for (uword i = 0; i < 64; i++)
+    {
+        ubyte* row = rows + (i >> 3) * pitch;
+        switch (psm)
+        {
+        case PSMT8H:
+            row[i & 0x7] = static_cast<ubyte>(expanded[i] >> 24);
+            break;
+        case PSMT4HL:
+            write_transfer_pixel(row, i & 0x7, 4, expanded[i] >> 24);
+            break;
+        case PSMT4HH:
+            write_transfer_pixel(row, i & 0x7, 4, expanded[i] >> 28);
+            break;
+        default:
+            write_transfer_pixel(row, i & 0x7, 24, expanded[i]);
+            break;
+        }
+    }
+}
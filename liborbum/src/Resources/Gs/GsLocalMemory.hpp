@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cereal/cereal.hpp>
+#include <cereal/access.hpp>
+#include <cereal/types/polymorphic.hpp>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Gs/GsSwizzle.hpp"
+
+/// GS local memory (4 MiB), used for the frame, Z and texture buffers.
+/// Buffers are arranged in pages (8 KiB) of blocks (256 bytes) of columns
+/// (64 bytes), with the pixels swizzled within each level depending on the
+/// pixel storage format (PSM). Buffer base pointers (BP) are in units of
+/// blocks and buffer widths (BW) in units of 64 pixels.
+/// The pixel address functions return addresses in units of the pixel size
+/// (words for 32-bit formats, hwords for 16-bit, bytes for 8-bit and nibbles
+/// for 4-bit), which wrap around the end of memory. See GsSwizzle for the
+/// arrangements, and write_pixels()/read_pixels() for bulk transfers.
+/// See GS Users Manual page 150 onwards (Appendix A).
+class GsLocalMemory : public ArrayByteMemory
+{
+public:
+    GsLocalMemory() :
+        ArrayByteMemory(Constants::SIZE_4MB)
+    {
+    }
+
+    /// Pixel storage formats.
+    static constexpr uword PSMCT32 = 0x00;
+    static constexpr uword PSMCT24 = 0x01;
+    static constexpr uword PSMCT16 = 0x02;
+    static constexpr uword PSMCT16S = 0x0A;
+    static constexpr uword PSMT8 = 0x13;
+    static constexpr uword PSMT4 = 0x14;
+    static constexpr uword PSMT8H = 0x1B;
+    static constexpr uword PSMT4HL = 0x24;
+    static constexpr uword PSMT4HH = 0x2C;
+    static constexpr uword PSMZ32 = 0x30;
+    static constexpr uword PSMZ24 = 0x31;
+    static constexpr uword PSMZ16 = 0x32;
+    static constexpr uword PSMZ16S = 0x3A;
+
+    static constexpr uword NUMBER_WORDS = Constants::SIZE_4MB / NUMBER_BYTES_IN_WORD;
+
+    /// Returns the number of bits of memory a pixel of the format occupies
+    /// for transfers (24-bit formats are packed), or 0 for invalid formats.
+    static int transfer_bits_per_pixel(const uword psm)
+    {
+        switch (psm)
+        {
+        case PSMCT32:
+        case PSMZ32:
+            return 32;
+        case PSMCT24:
+        case PSMZ24:
+            return 24;
+        case PSMCT16:
+        case PSMCT16S:
+        case PSMZ16:
+        case PSMZ16S:
+            return 16;
+        case PSMT8:
+        case PSMT8H:
+            return 8;
+        case PSMT4:
+        case PSMT4HL:
+        case PSMT4HH:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    /// Pixel address functions for each layout, using the swizzle page tables.
+    /// 32-bit formats: 64x32 pixel pages of 8x8 pixel blocks.
+    static uword address_32(const uword bp, const uword bw, const uword x, const uword y)
+    {
+        return page_address(GsSwizzle::PAGE_TABLE_32, bp << 6, bw, x, y) & (NUMBER_WORDS - 1);
+    }
+
+    static uword address_32z(const uword bp, const uword bw, const uword x, const uword y)
+    {
+        return page_address(GsSwizzle::PAGE_TABLE_32Z, bp << 6, bw, x, y) & (NUMBER_WORDS - 1);
+    }
+
+    /// 16-bit formats: 64x64 pixel pages of 16x8 pixel blocks, with the page
+    /// table of the format (PAGE_TABLE_16/16S/16Z/16SZ).
+    static uword address_16(const GsSwizzle::PageTable<64, 64>& table, const uword bp, const uword bw, const uword x, const uword y)
+    {
+        return page_address(table, bp << 7, bw, x, y) & (NUMBER_WORDS * 2 - 1);
+    }
+
+    /// 8-bit formats: 128x64 pixel pages of 16x16 pixel blocks.
+    static uword address_8(const uword bp, const uword bw, const uword x, const uword y)
+    {
+        return page_address(GsSwizzle::PAGE_TABLE_8, bp << 8, bw >> 1, x, y) & (NUMBER_WORDS * 4 - 1);
+    }
+
+    /// 4-bit formats: 128x128 pixel pages of 32x16 pixel blocks.
+    static uword address_4(const uword bp, const uword bw, const uword x, const uword y)
+    {
+        return page_address(GsSwizzle::PAGE_TABLE_4, bp << 9, bw >> 1, x, y) & (NUMBER_WORDS * 8 - 1);
+    }
+
+    /// Reads a pixel of the format given, returned in the low bits.
+    uword read_pixel(const uword psm, const uword bp, const uword bw, const uword x, const uword y)
+    {
+        switch (psm)
+        {
+        case PSMCT32:
+            return words()[address_32(bp, bw, x, y)];
+        case PSMCT24:
+            return words()[address_32(bp, bw, x, y)] & 0xFFFFFF;
+        case PSMZ32:
+            return words()[address_32z(bp, bw, x, y)];
+        case PSMZ24:
+            return words()[address_32z(bp, bw, x, y)] & 0xFFFFFF;
+        case PSMCT16:
+            return hwords()[address_16(GsSwizzle::PAGE_TABLE_16, bp, bw, x, y)];
+        case PSMCT16S:
+            return hwords()[address_16(GsSwizzle::PAGE_TABLE_16S, bp, bw, x, y)];
+        case PSMZ16:
+            return hwords()[address_16(GsSwizzle::PAGE_TABLE_16Z, bp, bw, x, y)];
+        case PSMZ16S:
+            return hwords()[address_16(GsSwizzle::PAGE_TABLE_16SZ, bp, bw, x, y)];
+        case PSMT8:
+            return get_memory()[address_8(bp, bw, x, y)];
+        case PSMT4:
+        {
+            const uword address = address_4(bp, bw, x, y);
+            return (get_memory()[address >> 1] >> ((address & 0x1) * 4)) & 0xF;
+        }
+        case PSMT8H:
+            return words()[address_32(bp, bw, x, y)] >> 24;
+        case PSMT4HL:
+            return (words()[address_32(bp, bw, x, y)] >> 24) & 0xF;
+        case PSMT4HH:
+            return words()[address_32(bp, bw, x, y)] >> 28;
+        default:
+            return 0;
+        }
+    }
+
+    /// Writes a pixel of the format given (from the low bits), leaving any
+    /// other bits sharing the storage (ie: 24-bit and the H formats) unchanged.
+    void write_pixel(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const uword value)
+    {
+        switch (psm)
+        {
+        case PSMCT32:
+            words()[address_32(bp, bw, x, y)] = value;
+            break;
+        case PSMCT24:
+            merge(words()[address_32(bp, bw, x, y)], value, 0x00FFFFFF);
+            break;
+        case PSMZ32:
+            words()[address_32z(bp, bw, x, y)] = value;
+            break;
+        case PSMZ24:
+            merge(words()[address_32z(bp, bw, x, y)], value, 0x00FFFFFF);
+            break;
+        case PSMCT16:
+            hwords()[address_16(GsSwizzle::PAGE_TABLE_16, bp, bw, x, y)] = static_cast<uhword>(value);
+            break;
+        case PSMCT16S:
+            hwords()[address_16(GsSwizzle::PAGE_TABLE_16S, bp, bw, x, y)] = static_cast<uhword>(value);
+            break;
+        case PSMZ16:
+            hwords()[address_16(GsSwizzle::PAGE_TABLE_16Z, bp, bw, x, y)] = static_cast<uhword>(value);
+            break;
+        case PSMZ16S:
+            hwords()[address_16(GsSwizzle::PAGE_TABLE_16SZ, bp, bw, x, y)] = static_cast<uhword>(value);
+            break;
+        case PSMT8:
+            get_memory()[address_8(bp, bw, x, y)] = static_cast<ubyte>(value);
+            break;
+        case PSMT4:
+        {
+            const uword address = address_4(bp, bw, x, y);
+            const int shift = (address & 0x1) * 4;
+            ubyte& byte = get_memory()[address >> 1];
+            byte = static_cast<ubyte>((byte & ~(0xF << shift)) | ((value & 0xF) << shift));
+            break;
+        }
+        case PSMT8H:
+            merge(words()[address_32(bp, bw, x, y)], value << 24, 0xFF000000);
+            break;
+        case PSMT4HL:
+            merge(words()[address_32(bp, bw, x, y)], value << 24, 0x0F000000);
+            break;
+        case PSMT4HH:
+            merge(words()[address_32(bp, bw, x, y)], value << 28, 0xF0000000);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /// Writes/reads a rectangle of pixels in the transfer format: rows of
+    /// packed pixels (see transfer_bits_per_pixel(), 4-bit pixels lowest nibble
+    /// first) without any padding, like the HWREG/IMAGE transmission data.
+    /// Pixel positions wrap around at 2048, like transmissions.
+    /// Whole blocks within the rectangle are converted with the bulk block
+    /// routines, and the edges pixel by pixel, so the order pixels are written
+    /// in differs from a transmission (only visible if the area overlaps
+    /// itself in memory, ie: is wider than the buffer).
+    void write_pixels(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const uword width, const uword height, const ubyte* data);
+    void read_pixels(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const uword width, const uword height, ubyte* data);
+
+    /// Returns the block size (in pixels) of the layout used by the format.
+    static void get_block_size(const uword psm, uword& width, uword& height);
+
+    uword* words()
+    {
+        return reinterpret_cast<uword*>(get_memory());
+    }
+
+    uhword* hwords()
+    {
+        return reinterpret_cast<uhword*>(get_memory());
+    }
+
+private:
+    /// Returns the address of a pixel given the page table of the layout, the
+    /// base address and the buffer width in pages (unmasked).
+    template <int Width, int Height>
+    static uword page_address(const GsSwizzle::PageTable<Width, Height>& table, const uword base, const uword pages_per_row, const uword x, const uword y)
+    {
+        const uword page = (y / Height) * pages_per_row + (x / Width);
+        return base + page * (Width * Height) + table.offsets[y % Height][x % Width];
+    }
+
+    /// Bulk transfer of one block (block aligned position), see write_pixels()/read_pixels().
+    void write_block(const uword psm, const uword bp, const uword bw, const uword x, const uword y, const ubyte* rows, const size_t pitch);
+    void read_block(const uword psm, const uword bp, const uword bw, const uword x, const uword y, ubyte* rows, const size_t pitch);
+
+    static void merge(uword& word, const uword value, const uword mask)
+    {
+        word = (word & ~mask) | (value & mask);
+    }
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            cereal::base_class<ArrayByteMemory>(this)
+        );
+    }
+};
+
+CEREAL_SPECIALIZE_FOR_ALL_ARCHIVES(GsLocalMemory, cereal::specialization::member_serialize);
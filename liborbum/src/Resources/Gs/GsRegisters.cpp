@@ -0,0 +1,82 @@
+#include "Resources/Gs/GsRegisters.hpp"
+#include "Resources/Gs/GsCommandRing.hpp"
+
+namespace
+{
+/// CSR event bits (SIGNAL, FINISH, HSINT, VSINT, EDWINT), cleared by writing 1.
+constexpr udword CSR_EVENT_BITS = 0x1F;
+} // namespace
+
+GsRegister_Prmodecont::GsRegister_Prmodecont() :
+    SizedDwordRegister(0x1)
+{
+}
+
+
+GsRegister_Csr::GsRegister_Csr() :
+    command_ring(nullptr)
+{
+}
+
+uword GsRegister_Csr::byte_bus_read_uword(const BusContext context, const usize offset)
+{
+    if (context == BusContext::Ee && command_ring)
+        command_ring->sync();
+    return SizedDwordRegister::byte_bus_read_uword(context, offset);
+}
+
+udword GsRegister_Csr::byte_bus_read_udword(const BusContext context, const usize offset)
+{
+    if (context == BusContext::Ee && command_ring)
+        command_ring->sync();
+    return SizedDwordRegister::byte_bus_read_udword(context, offset);
+}
+
+void GsRegister_Csr::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
+{
+    if (context != BusContext::Ee)
+    {
+        SizedDwordRegister::byte_bus_write_uword(context, offset, value);
+        return;
+    }
+
+    auto _lock = scope_lock();
+    if (offset == 0)
+        write_udword(read_udword() & ~(static_cast<udword>(value) & CSR_EVENT_BITS));
+}
+
+void GsRegister_Csr::byte_bus_write_udword(const BusContext context, const usize offset, const udword value)
+{
+    if (context != BusContext::Ee)
+    {
+        SizedDwordRegister::byte_bus_write_udword(context, offset, value);
+        return;
+    }
+
+    auto _lock = scope_lock();
+    write_udword(read_udword() & ~(value & CSR_EVENT_BITS));
+}
+
+GsRegister_Siglblid::GsRegister_Siglblid() :
+    command_ring(nullptr)
+{
+}
+
+uword GsRegister_Siglblid::byte_bus_read_uword(const BusContext context, const usize offset)
+{
+    if (context == BusContext::Ee && command_ring)
+        command_ring->sync();
+    return SizedDwordRegister::byte_bus_read_uword(context, offset);
+}
+
+udword GsRegister_Siglblid::byte_bus_read_udword(const BusContext context, const usize offset)
+{
+    if (context == BusContext::Ee && command_ring)
+        command_ring->sync();
+    return SizedDwordRegister::byte_bus_read_udword(context, offset);
+}
+
+GsRegister_Imr::GsRegister_Imr() :
+    SizedDwordRegister(0x7F00)
+{
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+#include "Common/Types/Register/SizedDwordRegister.hpp"
+#include "Common/Types/ScopeLock.hpp"
+
+class GsCommandRing;
+
+/// GS general register addresses, as written through the GIF.
+/// A+D (0x0E) and NOP (0x0F) are GIF PACKED mode descriptors rather than registers.
+/// See GS Users Manual page 94.
+struct GsRegisterAddress
+{
+    static constexpr ubyte PRIM = 0x00;
+    static constexpr ubyte RGBAQ = 0x01;
+    static constexpr ubyte ST = 0x02;
+    static constexpr ubyte UV = 0x03;
+    static constexpr ubyte XYZF2 = 0x04;
+    static constexpr ubyte XYZ2 = 0x05;
+    static constexpr ubyte TEX0_1 = 0x06;
+    static constexpr ubyte TEX0_2 = 0x07;
+    static constexpr ubyte CLAMP_1 = 0x08;
+    static constexpr ubyte CLAMP_2 = 0x09;
+    static constexpr ubyte FOG = 0x0A;
+    static constexpr ubyte XYZF3 = 0x0C;
+    static constexpr ubyte XYZ3 = 0x0D;
+    static constexpr ubyte AD = 0x0E;
+    static constexpr ubyte NOP = 0x0F;
+    static constexpr ubyte TEX1_1 = 0x14;
+    static constexpr ubyte TEX1_2 = 0x15;
+    static constexpr ubyte TEX2_1 = 0x16;
+    static constexpr ubyte TEX2_2 = 0x17;
+    static constexpr ubyte XYOFFSET_1 = 0x18;
+    static constexpr ubyte XYOFFSET_2 = 0x19;
+    static constexpr ubyte PRMODECONT = 0x1A;
+    static constexpr ubyte PRMODE = 0x1B;
+    static constexpr ubyte TEXCLUT = 0x1C;
+    static constexpr ubyte SCANMSK = 0x22;
+    static constexpr ubyte MIPTBP1_1 = 0x34;
+    static constexpr ubyte MIPTBP1_2 = 0x35;
+    static constexpr ubyte MIPTBP2_1 = 0x36;
+    static constexpr ubyte MIPTBP2_2 = 0x37;
+    static constexpr ubyte TEXA = 0x3B;
+    static constexpr ubyte FOGCOL = 0x3D;
+    static constexpr ubyte TEXFLUSH = 0x3F;
+    static constexpr ubyte SCISSOR_1 = 0x40;
+    static constexpr ubyte SCISSOR_2 = 0x41;
+    static constexpr ubyte ALPHA_1 = 0x42;
+    static constexpr ubyte ALPHA_2 = 0x43;
+    static constexpr ubyte DIMX = 0x44;
+    static constexpr ubyte DTHE = 0x45;
+    static constexpr ubyte COLCLAMP = 0x46;
+    static constexpr ubyte TEST_1 = 0x47;
+    static constexpr ubyte TEST_2 = 0x48;
+    static constexpr ubyte PABE = 0x49;
+    static constexpr ubyte FBA_1 = 0x4A;
+    static constexpr ubyte FBA_2 = 0x4B;
+    static constexpr ubyte FRAME_1 = 0x4C;
+    static constexpr ubyte FRAME_2 = 0x4D;
+    static constexpr ubyte ZBUF_1 = 0x4E;
+    static constexpr ubyte ZBUF_2 = 0x4F;
+    static constexpr ubyte BITBLTBUF = 0x50;
+    static constexpr ubyte TRXPOS = 0x51;
+    static constexpr ubyte TRXREG = 0x52;
+    static constexpr ubyte TRXDIR = 0x53;
+    static constexpr ubyte HWREG = 0x54;
+    static constexpr ubyte SIGNAL = 0x60;
+    static constexpr ubyte FINISH = 0x61;
+    static constexpr ubyte LABEL = 0x62;
+};
+
+/// GS general purpose registers, written through the GIF (not bus mapped).
+/// See GS Users Manual page 94 onwards.
+
+class GsRegister_Prim : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield PRIM = Bitfield(0, 3);
+    static constexpr Bitfield IIP = Bitfield(3, 1);
+    static constexpr Bitfield TME = Bitfield(4, 1);
+    static constexpr Bitfield FGE = Bitfield(5, 1);
+    static constexpr Bitfield ABE = Bitfield(6, 1);
+    static constexpr Bitfield AA1 = Bitfield(7, 1);
+    static constexpr Bitfield FST = Bitfield(8, 1);
+    static constexpr Bitfield CTXT = Bitfield(9, 1);
+    static constexpr Bitfield FIX = Bitfield(10, 1);
+
+    /// Primitive types (PRIM field).
+    static constexpr udword POINT = 0;
+    static constexpr udword LINE = 1;
+    static constexpr udword LINE_STRIP = 2;
+    static constexpr udword TRIANGLE = 3;
+    static constexpr udword TRIANGLE_STRIP = 4;
+    static constexpr udword TRIANGLE_FAN = 5;
+    static constexpr udword SPRITE = 6;
+};
+
+/// PRMODE has the same attribute fields as PRIM (IIP -> FIX), without the type.
+using GsRegister_Prmode = GsRegister_Prim;
+
+/// PRMODECONT.AC is initially set (PRIM attributes used).
+class GsRegister_Prmodecont : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield AC = Bitfield(0, 1);
+
+    GsRegister_Prmodecont();
+};
+
+class GsRegister_Rgbaq : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield R = Bitfield(0, 8);
+    static constexpr Bitfield G = Bitfield(8, 8);
+    static constexpr Bitfield B = Bitfield(16, 8);
+    static constexpr Bitfield A = Bitfield(24, 8);
+    static constexpr Bitfield Q = Bitfield(32, 32);
+};
+
+class GsRegister_St : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield S = Bitfield(0, 32);
+    static constexpr Bitfield T = Bitfield(32, 32);
+};
+
+class GsRegister_Uv : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield U = Bitfield(0, 14);
+    static constexpr Bitfield V = Bitfield(16, 14);
+};
+
+/// XYZF2/XYZF3 (24-bit Z with fog) and XYZ2/XYZ3 (32-bit Z).
+class GsRegister_Xyz : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield X = Bitfield(0, 16);
+    static constexpr Bitfield Y = Bitfield(16, 16);
+    static constexpr Bitfield Z = Bitfield(32, 32);
+    static constexpr Bitfield ZF = Bitfield(32, 24);
+    static constexpr Bitfield F = Bitfield(56, 8);
+};
+
+class GsRegister_Fog : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield F = Bitfield(56, 8);
+};
+
+class GsRegister_Tex0 : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield TBP0 = Bitfield(0, 14);
+    static constexpr Bitfield TBW = Bitfield(14, 6);
+    static constexpr Bitfield PSM = Bitfield(20, 6);
+    static constexpr Bitfield TW = Bitfield(26, 4);
+    static constexpr Bitfield TH = Bitfield(30, 4);
+    static constexpr Bitfield TCC = Bitfield(34, 1);
+    static constexpr Bitfield TFX = Bitfield(35, 2);
+    static constexpr Bitfield CBP = Bitfield(37, 14);
+    static constexpr Bitfield CPSM = Bitfield(51, 4);
+    static constexpr Bitfield CSM = Bitfield(55, 1);
+    static constexpr Bitfield CSA = Bitfield(56, 5);
+    static constexpr Bitfield CLD = Bitfield(61, 3);
+};
+
+/// TEX2 writes the PSM and CLUT fields of TEX0 only (same positions).
+using GsRegister_Tex2 = GsRegister_Tex0;
+
+class GsRegister_Clamp : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield WMS = Bitfield(0, 2);
+    static constexpr Bitfield WMT = Bitfield(2, 2);
+    static constexpr Bitfield MINU = Bitfield(4, 10);
+    static constexpr Bitfield MAXU = Bitfield(14, 10);
+    static constexpr Bitfield MINV = Bitfield(24, 10);
+    static constexpr Bitfield MAXV = Bitfield(34, 10);
+};
+
+class GsRegister_Tex1 : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield LCM = Bitfield(0, 1);
+    static constexpr Bitfield MXL = Bitfield(2, 3);
+    static constexpr Bitfield MMAG = Bitfield(5, 1);
+    static constexpr Bitfield MMIN = Bitfield(6, 3);
+    static constexpr Bitfield MTBA = Bitfield(9, 1);
+    static constexpr Bitfield L = Bitfield(19, 2);
+    static constexpr Bitfield K = Bitfield(32, 12);
+};
+
+/// MIPTBP1 (mipmap levels 1 -> 3) and MIPTBP2 (levels 4 -> 6).
+class GsRegister_Miptbp : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield TBP1 = Bitfield(0, 14);
+    static constexpr Bitfield TBW1 = Bitfield(14, 6);
+    static constexpr Bitfield TBP2 = Bitfield(20, 14);
+    static constexpr Bitfield TBW2 = Bitfield(34, 6);
+    static constexpr Bitfield TBP3 = Bitfield(40, 14);
+    static constexpr Bitfield TBW3 = Bitfield(54, 6);
+};
+
+class GsRegister_Xyoffset : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield OFX = Bitfield(0, 16);
+    static constexpr Bitfield OFY = Bitfield(32, 16);
+};
+
+class GsRegister_Texclut : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield CBW = Bitfield(0, 6);
+    static constexpr Bitfield COU = Bitfield(6, 6);
+    static constexpr Bitfield COV = Bitfield(12, 10);
+};
+
+class GsRegister_Texa : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield TA0 = Bitfield(0, 8);
+    static constexpr Bitfield AEM = Bitfield(15, 1);
+    static constexpr Bitfield TA1 = Bitfield(32, 8);
+};
+
+class GsRegister_Fogcol : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield FCR = Bitfield(0, 8);
+    static constexpr Bitfield FCG = Bitfield(8, 8);
+    static constexpr Bitfield FCB = Bitfield(16, 8);
+};
+
+class GsRegister_Scissor : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield SCAX0 = Bitfield(0, 11);
+    static constexpr Bitfield SCAX1 = Bitfield(16, 11);
+    static constexpr Bitfield SCAY0 = Bitfield(32, 11);
+    static constexpr Bitfield SCAY1 = Bitfield(48, 11);
+};
+
+class GsRegister_Alpha : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield A = Bitfield(0, 2);
+    static constexpr Bitfield B = Bitfield(2, 2);
+    static constexpr Bitfield C = Bitfield(4, 2);
+    static constexpr Bitfield D = Bitfield(6, 2);
+    static constexpr Bitfield FIX = Bitfield(32, 8);
+};
+
+/// Single bit enable registers: COLCLAMP, DTHE, PABE and FBA.
+class GsRegister_Enable : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield ENABLE = Bitfield(0, 1);
+};
+
+class GsRegister_Test : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield ATE = Bitfield(0, 1);
+    static constexpr Bitfield ATST = Bitfield(1, 3);
+    static constexpr Bitfield AREF = Bitfield(4, 8);
+    static constexpr Bitfield AFAIL = Bitfield(12, 2);
+    static constexpr Bitfield DATE = Bitfield(14, 1);
+    static constexpr Bitfield DATM = Bitfield(15, 1);
+    static constexpr Bitfield ZTE = Bitfield(16, 1);
+    static constexpr Bitfield ZTST = Bitfield(17, 2);
+};
+
+class GsRegister_Frame : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield FBP = Bitfield(0, 9);
+    static constexpr Bitfield FBW = Bitfield(16, 6);
+    static constexpr Bitfield PSM = Bitfield(24, 6);
+    static constexpr Bitfield FBMSK = Bitfield(32, 32);
+};
+
+class GsRegister_Zbuf : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield ZBP = Bitfield(0, 9);
+    static constexpr Bitfield PSM = Bitfield(24, 4);
+    static constexpr Bitfield ZMSK = Bitfield(32, 1);
+};
+
+class GsRegister_Bitbltbuf : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield SBP = Bitfield(0, 14);
+    static constexpr Bitfield SBW = Bitfield(16, 6);
+    static constexpr Bitfield SPSM = Bitfield(24, 6);
+    static constexpr Bitfield DBP = Bitfield(32, 14);
+    static constexpr Bitfield DBW = Bitfield(48, 6);
+    static constexpr Bitfield DPSM = Bitfield(56, 6);
+};
+
+class GsRegister_Trxpos : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield SSAX = Bitfield(0, 11);
+    static constexpr Bitfield SSAY = Bitfield(16, 11);
+    static constexpr Bitfield DSAX = Bitfield(32, 11);
+    static constexpr Bitfield DSAY = Bitfield(48, 11);
+    static constexpr Bitfield DIR = Bitfield(59, 2);
+};
+
+class GsRegister_Trxreg : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield RRW = Bitfield(0, 12);
+    static constexpr Bitfield RRH = Bitfield(32, 12);
+};
+
+class GsRegister_Trxdir : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield XDIR = Bitfield(0, 2);
+
+    /// Transmission directions (XDIR field).
+    static constexpr udword HOST_TO_LOCAL = 0;
+    static constexpr udword LOCAL_TO_HOST = 1;
+    static constexpr udword LOCAL_TO_LOCAL = 2;
+    static constexpr udword DEACTIVATED = 3;
+};
+
+/// SIGNAL and LABEL.
+class GsRegister_Signal : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield ID = Bitfield(0, 32);
+    static constexpr Bitfield IDMSK = Bitfield(32, 32);
+};
+
+/// GS privileged registers with fields needed by the GS core.
+/// See EE Users Manual page 26 onwards.
+
+class GsRegister_Pmode : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield EN1 = Bitfield(0, 1);
+    static constexpr Bitfield EN2 = Bitfield(1, 1);
+    static constexpr Bitfield CRTMD = Bitfield(2, 3);
+    static constexpr Bitfield MMOD = Bitfield(5, 1);
+    static constexpr Bitfield AMOD = Bitfield(6, 1);
+    static constexpr Bitfield SLBG = Bitfield(7, 1);
+    static constexpr Bitfield ALP = Bitfield(8, 8);
+};
+
+/// DISPFB1 and DISPFB2 (read circuit frame buffer settings).
+/// FBP is in units of pages (2048 words).
+class GsRegister_Dispfb : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield FBP = Bitfield(0, 9);
+    static constexpr Bitfield FBW = Bitfield(9, 6);
+    static constexpr Bitfield PSM = Bitfield(15, 5);
+    static constexpr Bitfield DBX = Bitfield(32, 11);
+    static constexpr Bitfield DBY = Bitfield(43, 11);
+};
+
+/// DISPLAY1 and DISPLAY2 (read circuit display area settings).
+class GsRegister_Display : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield DX = Bitfield(0, 12);
+    static constexpr Bitfield DY = Bitfield(12, 11);
+    static constexpr Bitfield MAGH = Bitfield(23, 4);
+    static constexpr Bitfield MAGV = Bitfield(27, 2);
+    static constexpr Bitfield DW = Bitfield(32, 12);
+    static constexpr Bitfield DH = Bitfield(44, 11);
+};
+
+/// The GS CSR register, which holds the GS events (SIGNAL, FINISH, ...) raised.
+/// Event bits are cleared by writing 1 (through EE context), other bits are read only.
+class GsRegister_Csr : public SizedDwordRegister, public ScopeLock
+{
+public:
+    static constexpr Bitfield SIGNAL = Bitfield(0, 1);
+    static constexpr Bitfield FINISH = Bitfield(1, 1);
+    static constexpr Bitfield HSINT = Bitfield(2, 1);
+    static constexpr Bitfield VSINT = Bitfield(3, 1);
+    static constexpr Bitfield EDWINT = Bitfield(4, 1);
+    static constexpr Bitfield FLUSH = Bitfield(8, 1);
+    static constexpr Bitfield RESET = Bitfield(9, 1);
+    static constexpr Bitfield NFIELD = Bitfield(12, 1);
+    static constexpr Bitfield FIELD = Bitfield(13, 1);
+    static constexpr Bitfield FIFO = Bitfield(14, 2);
+    static constexpr Bitfield REV = Bitfield(16, 8);
+    static constexpr Bitfield ID = Bitfield(24, 8);
+
+    GsRegister_Csr();
+
+    /// Reference to the GS command ring, which is synced before EE reads so
+    /// they see the events of all the register writes sent to the GS so far.
+    GsCommandRing* command_ring;
+
+    /// (EE context) Syncs with the GS core before reading.
+    uword byte_bus_read_uword(const BusContext context, const usize offset) override;
+    udword byte_bus_read_udword(const BusContext context, const usize offset) override;
+
+    /// (EE context) Clears any event bits written to.
+    /// Scope locked.
+    void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+    void byte_bus_write_udword(const BusContext context, const usize offset, const udword value) override;
+};
+
+/// The GS IMR register, which masks the GS events from raising an interrupt.
+/// All events are initially masked.
+class GsRegister_Imr : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield SIGMSK = Bitfield(8, 1);
+    static constexpr Bitfield FINISHMSK = Bitfield(9, 1);
+    static constexpr Bitfield HSMSK = Bitfield(10, 1);
+    static constexpr Bitfield VSMSK = Bitfield(11, 1);
+    static constexpr Bitfield EDWMSK = Bitfield(12, 1);
+
+    GsRegister_Imr();
+};
+
+/// The GS SIGLBLID register, holding the IDs set by SIGNAL and LABEL.
+class GsRegister_Siglblid : public SizedDwordRegister
+{
+public:
+    static constexpr Bitfield SIGID = Bitfield(0, 32);
+    static constexpr Bitfield LBLID = Bitfield(32, 32);
+
+    GsRegister_Siglblid();
+
+    /// Reference to the GS command ring, see GsRegister_Csr.
+    GsCommandRing* command_ring;
+
+    /// (EE context) Syncs with the GS core before reading.
+    uword byte_bus_read_uword(const BusContext context, const usize offset) override;
+    udword byte_bus_read_udword(const BusContext context, const usize offset) override;
+};
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "Common/Simd.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// GS local memory swizzling: the arrangement of pixels within pages for each
+/// pixel storage format, and bulk routines which convert whole blocks between
+/// the swizzled arrangement and linear rows of pixels.
+///
+/// The page tables are generated at compile time from the block arrangements
+/// (GS Users Manual page 150 onwards), and map a pixel position within a page
+/// to its address within the page, in units of the pixel size. Blocks are
+/// contiguous in memory and the arrangement within every block is the same,
+/// so the first block of a page table also describes any block.
+///
+/// The block routines work on one block (256 bytes), with the linear rows
+/// given by a pointer and a row pitch in bytes:
+///  - 32-bit layout (8x8 pixels): each column holds 2 rows, with every qword
+///    made of a pixel pair from each row. Also used by the 24-bit and the
+///    8H/4HL/4HH formats, which merge into the word under a mask.
+///  - 16-bit layout (16x8 pixels): as above, except each word holds the
+///    pixels x and x + 8 of a row.
+///  - 8-bit (16x16 pixels) and 4-bit (32x16 pixels) layouts: the rows are
+///    rotated within the columns, so these go through the page table.
+/// The 32-bit and 16-bit routines map onto SSE2 when the host has it, with an
+/// equivalent scalar version otherwise (see Simd.hpp).
+namespace GsSwizzle
+{
+/// Block arrangements within a page, indexed by the block row and column.
+inline constexpr ubyte BLOCK_TABLE_32[4][8] =
+    {
+        {0, 1, 4, 5, 16, 17, 20, 21},
+        {2, 3, 6, 7, 18, 19, 22, 23},
+        {8, 9, 12, 13, 24, 25, 28, 29},
+        {10, 11, 14, 15, 26, 27, 30, 31}};
+
+inline constexpr ubyte BLOCK_TABLE_32Z[4][8] =
+    {
+        {24, 25, 28, 29, 8, 9, 12, 13},
+        {26, 27, 30, 31, 10, 11, 14, 15},
+        {16, 17, 20, 21, 0, 1, 4, 5},
+        {18, 19, 22, 23, 2, 3, 6, 7}};
+
+inline constexpr ubyte BLOCK_TABLE_16[8][4] =
+    {
+        {0, 2, 8, 10},
+        {1, 3, 9, 11},
+        {4, 6, 12, 14},
+        {5, 7, 13, 15},
+        {16, 18, 24, 26},
+        {17, 19, 25, 27},
+        {20, 22, 28, 30},
+        {21, 23, 29, 31}};
+
+inline constexpr ubyte BLOCK_TABLE_16S[8][4] =
+    {
+        {0, 2, 16, 18},
+        {1, 3, 17, 19},
+        {8, 10, 24, 26},
+        {9, 11, 25, 27},
+        {4, 6, 20, 22},
+        {5, 7, 21, 23},
+        {12, 14, 28, 30},
+        {13, 15, 29, 31}};
+
+inline constexpr ubyte BLOCK_TABLE_16Z[8][4] =
+    {
+        {24, 26, 16, 18},
+        {25, 27, 17, 19},
+        {28, 30, 20, 22},
+        {29, 31, 21, 23},
+        {8, 10, 0, 2},
+        {9, 11, 1, 3},
+        {12, 14, 4, 6},
+        {13, 15, 5, 7}};
+
+inline constexpr ubyte BLOCK_TABLE_16SZ[8][4] =
+    {
+        {24, 26, 8, 10},
+        {25, 27, 9, 11},
+        {16, 18, 0, 2},
+        {17, 19, 1, 3},
+        {28, 30, 12, 14},
+        {29, 31, 13, 15},
+        {20, 22, 4, 6},
+        {21, 23, 5, 7}};
+
+inline constexpr ubyte BLOCK_TABLE_8[4][8] =
+    {
+        {0, 1, 4, 5, 16, 17, 20, 21},
+        {2, 3, 6, 7, 18, 19, 22, 23},
+        {8, 9, 12, 13, 24, 25, 28, 29},
+        {10, 11, 14, 15, 26, 27, 30, 31}};
+
+inline constexpr ubyte BLOCK_TABLE_4[8][4] =
+    {
+        {0, 2, 8, 10},
+        {1, 3, 9, 11},
+        {4, 6, 12, 14},
+        {5, 7, 13, 15},
+        {16, 18, 24, 26},
+        {17, 19, 25, 27},
+        {20, 22, 28, 30},
+        {21, 23, 29, 31}};
+
+/// Pixel address within a page (in units of the pixel size), indexed by the
+/// pixel row and column within the page.
+template <int Width, int Height>
+struct PageTable
+{
+    static constexpr int WIDTH = Width;
+    static constexpr int HEIGHT = Height;
+
+    uhword offsets[Height][Width];
+};
+
+/// Word within a block for the 32-bit (and 16-bit) layouts: 4 columns of
+/// 2 rows, each row alternating between pairs of pixels.
+constexpr uword column_word(const uword x, const uword y)
+{
+    return ((y >> 1) & 0x3) * 16 + ((x >> 1) & 0x3) * 4 + (y & 0x1) * 2 + (x & 0x1);
+}
+
+/// Word within a column for the 8-bit and 4-bit layouts, where the first
+/// or second pair of rows (alternating by column) is rotated by 4 pixels.
+constexpr uword column_word_rotated(const uword x, const uword y, const uword column)
+{
+    const uword rotated_x = (x + 4 * (((y >> 1) & 0x1) ^ (column & 0x1))) & 0x7;
+    return (rotated_x >> 1) * 4 + (y & 0x1) * 2 + (rotated_x & 0x1);
+}
+
+/// 32-bit layout: 64x32 pixel pages of 8x8 pixel blocks.
+constexpr PageTable<64, 32> make_page_table_32(const ubyte (&blocks)[4][8])
+{
+    PageTable<64, 32> table{};
+    for (uword y = 0; y < 32; y++)
+        for (uword x = 0; x < 64; x++)
+            table.offsets[y][x] = static_cast<uhword>((blocks[y >> 3][x >> 3] << 6) + column_word(x, y));
+    return table;
+}
+
+/// 16-bit layout: 64x64 pixel pages of 16x8 pixel blocks. Each column word
+/// holds the pixels x and x + 8.
+constexpr PageTable<64, 64> make_page_table_16(const ubyte (&blocks)[8][4])
+{
+    PageTable<64, 64> table{};
+    for (uword y = 0; y < 64; y++)
+        for (uword x = 0; x < 64; x++)
+            table.offsets[y][x] = static_cast<uhword>((blocks[y >> 3][x >> 4] << 7) + (column_word(x, y) << 1) + ((x >> 3) & 0x1));
+    return table;
+}
+
+/// 8-bit layout: 128x64 pixel pages of 16x16 pixel blocks. Each column word
+/// holds 4 pixels from 2 rows.
+constexpr PageTable<128, 64> make_page_table_8()
+{
+    PageTable<128, 64> table{};
+    for (uword y = 0; y < 64; y++)
+    {
+        for (uword x = 0; x < 128; x++)
+        {
+            const uword column = (y >> 2) & 0x3;
+            const uword byte = ((x >> 3) & 0x1) * 2 + ((y >> 1) & 0x1);
+            table.offsets[y][x] = static_cast<uhword>((BLOCK_TABLE_8[y >> 4][x >> 4] << 8) + column * 64 + column_word_rotated(x, y, column) * 4 + byte);
+        }
+    }
+    return table;
+}
+
+/// 4-bit layout: 128x128 pixel pages of 32x16 pixel blocks, arranged like the 8-bit layout.
+constexpr PageTable<128, 128> make_page_table_4()
+{
+    PageTable<128, 128> table{};
+    for (uword y = 0; y < 128; y++)
+    {
+        for (uword x = 0; x < 128; x++)
+        {
+            const uword column = (y >> 2) & 0x3;
+            const uword nibble = ((x >> 3) & 0x3) * 2 + ((y >> 1) & 0x1);
+            table.offsets[y][x] = static_cast<uhword>((BLOCK_TABLE_4[y >> 4][x >> 5] << 9) + column * 128 + column_word_rotated(x, y, column) * 8 + nibble);
+        }
+    }
+    return table;
+}
+
+inline constexpr PageTable<64, 32> PAGE_TABLE_32 = make_page_table_32(BLOCK_TABLE_32);
+inline constexpr PageTable<64, 32> PAGE_TABLE_32Z = make_page_table_32(BLOCK_TABLE_32Z);
+inline constexpr PageTable<64, 64> PAGE_TABLE_16 = make_page_table_16(BLOCK_TABLE_16);
+inline constexpr PageTable<64, 64> PAGE_TABLE_16S = make_page_table_16(BLOCK_TABLE_16S);
+inline constexpr PageTable<64, 64> PAGE_TABLE_16Z = make_page_table_16(BLOCK_TABLE_16Z);
+inline constexpr PageTable<64, 64> PAGE_TABLE_16SZ = make_page_table_16(BLOCK_TABLE_16SZ);
+inline constexpr PageTable<128, 64> PAGE_TABLE_8 = make_page_table_8();
+inline constexpr PageTable<128, 128> PAGE_TABLE_4 = make_page_table_4();
+
+/// Block sizes in pixels for each layout.
+static constexpr int BLOCK_WIDTH_32 = 8;
+static constexpr int BLOCK_HEIGHT_32 = 8;
+static constexpr int BLOCK_WIDTH_16 = 16;
+static constexpr int BLOCK_HEIGHT_16 = 8;
+static constexpr int BLOCK_WIDTH_8 = 16;
+static constexpr int BLOCK_HEIGHT_8 = 16;
+static constexpr int BLOCK_WIDTH_4 = 32;
+static constexpr int BLOCK_HEIGHT_4 = 16;
+
+/// Writes an 8x8 pixel block of 32-bit rows into the 32-bit layout.
+/// Only the bits set in mask are changed (all for the 32-bit formats).
+inline void write_block_32(uword* block, const ubyte* rows, const size_t pitch, const uword mask)
+{
+#if defined(SIMD_SSE2)
+    const __m128i lanes_mask = _mm_set1_epi32(static_cast<int>(mask));
+    const bool merge = (mask != 0xFFFFFFFF);
+    for (int column = 0; column < 4; column++)
+    {
+        const ubyte* row0 = rows + (column * 2) * pitch;
+        const ubyte* row1 = row0 + pitch;
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 16));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 16));
+        __m128i qwords[4] = {
+            _mm_unpacklo_epi64(a0, b0),
+            _mm_unpackhi_epi64(a0, b0),
+            _mm_unpacklo_epi64(a1, b1),
+            _mm_unpackhi_epi64(a1, b1)};
+
+        __m128i* dst = reinterpret_cast<__m128i*>(block + column * 16);
+        for (int i = 0; i < 4; i++)
+        {
+            if (merge)
+            {
+                const __m128i old = _mm_loadu_si128(dst + i);
+                qwords[i] = _mm_or_si128(_mm_and_si128(qwords[i], lanes_mask), _mm_andnot_si128(lanes_mask, old));
+            }
+            _mm_storeu_si128(dst + i, qwords[i]);
+        }
+    }
+#else
+    for (uword y = 0; y < 8; y++)
+    {
+        for (uword x = 0; x < 8; x++)
+        {
+            uword value;
+            std::memcpy(&value, rows + y * pitch + x * 4, 4);
+            uword& word = block[column_word(x, y)];
+            word = (word & ~mask) | (value & mask);
+        }
+    }
+#endif
+}
+
+/// Reads an 8x8 pixel block of the 32-bit layout into 32-bit rows.
+inline void read_block_32(const uword* block, ubyte* rows, const size_t pitch)
+{
+#if defined(SIMD_SSE2)
+    for (int column = 0; column < 4; column++)
+    {
+        const __m128i* src = reinterpret_cast<const __m128i*>(block + column * 16);
+        const __m128i q0 = _mm_loadu_si128(src);
+        const __m128i q1 = _mm_loadu_si128(src + 1);
+        const __m128i q2 = _mm_loadu_si128(src + 2);
+        const __m128i q3 = _mm_loadu_si128(src + 3);
+
+        ubyte* row0 = rows + (column * 2) * pitch;
+        ubyte* row1 = row0 + pitch;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row0), _mm_unpacklo_epi64(q0, q1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row0 + 16), _mm_unpacklo_epi64(q2, q3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row1), _mm_unpackhi_epi64(q0, q1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row1 + 16), _mm_unpackhi_epi64(q2, q3));
+    }
+#else
+    for (uword y = 0; y < 8; y++)
+        for (uword x = 0; x < 8; x++)
+            std::memcpy(rows + y * pitch + x * 4, &block[column_word(x, y)], 4);
+#endif
+}
+
+/// Writes a 16x8 pixel block of 16-bit rows into the 16-bit layout.
+inline void write_block_16(uhword* block, const ubyte* rows, const size_t pitch)
+{
+#if defined(SIMD_SSE2)
+    for (int column = 0; column < 4; column++)
+    {
+        // Pair up the pixels x and x + 8 into words, then arrange like the 32-bit layout.
+        const ubyte* row0 = rows + (column * 2) * pitch;
+        const ubyte* row1 = row0 + pitch;
+        const __m128i a_left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+        const __m128i a_right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 16));
+        const __m128i b_left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+        const __m128i b_right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 16));
+        const __m128i a0 = _mm_unpacklo_epi16(a_left, a_right);
+        const __m128i a1 = _mm_unpackhi_epi16(a_left, a_right);
+        const __m128i b0 = _mm_unpacklo_epi16(b_left, b_right);
+        const __m128i b1 = _mm_unpackhi_epi16(b_left, b_right);
+
+        __m128i* dst = reinterpret_cast<__m128i*>(block + column * 32);
+        _mm_storeu_si128(dst, _mm_unpacklo_epi64(a0, b0));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(a0, b0));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi64(a1, b1));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi64(a1, b1));
+    }
+#else
+    for (uword y = 0; y < 8; y++)
+        for (uword x = 0; x < 16; x++)
+            std::memcpy(&block[PAGE_TABLE_16.offsets[y][x]], rows + y * pitch + x * 2, 2);
+#endif
+}
+
+/// Reads a 16x8 pixel block of the 16-bit layout into 16-bit rows.
+inline void read_block_16(const uhword* block, ubyte* rows, const size_t pitch)
+{
+#if defined(SIMD_SSE2)
+    for (int column = 0; column < 4; column++)
+    {
+        const __m128i* src = reinterpret_cast<const __m128i*>(block + column * 32);
+        const __m128i q0 = _mm_loadu_si128(src);
+        const __m128i q1 = _mm_loadu_si128(src + 1);
+        const __m128i q2 = _mm_loadu_si128(src + 2);
+        const __m128i q3 = _mm_loadu_si128(src + 3);
+        const __m128i a0 = _mm_unpacklo_epi64(q0, q1);
+        const __m128i a1 = _mm_unpacklo_epi64(q2, q3);
+        const __m128i b0 = _mm_unpackhi_epi64(q0, q1);
+        const __m128i b1 = _mm_unpackhi_epi64(q2, q3);
+
+        // Split the words back into the pixels x (low hwords) and x + 8 (high
+        // hwords). Sign extending first makes the saturating pack exact.
+        ubyte* row0 = rows + (column * 2) * pitch;
+        ubyte* row1 = row0 + pitch;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row0), _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a0, 16), 16), _mm_srai_epi32(_mm_slli_epi32(a1, 16), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row0 + 16), _mm_packs_epi32(_mm_srai_epi32(a0, 16), _mm_srai_epi32(a1, 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row1), _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(b0, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b1, 16), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row1 + 16), _mm_packs_epi32(_mm_srai_epi32(b0, 16), _mm_srai_epi32(b1, 16)));
+    }
+#else
+    for (uword y = 0; y < 8; y++)
+        for (uword x = 0; x < 16; x++)
+            std::memcpy(rows + y * pitch + x * 2, &block[PAGE_TABLE_16.offsets[y][x]], 2);
+#endif
+}
+
+/// Writes/reads a 16x16 pixel block of 8-bit rows to/from the 8-bit layout.
+inline void write_block_8(ubyte* block, const ubyte* rows, const size_t pitch)
+{
+    for (uword y = 0; y < 16; y++)
+        for (uword x = 0; x < 16; x++)
+            block[PAGE_TABLE_8.offsets[y][x]] = rows[y * pitch + x];
+}
+
+inline void read_block_8(const ubyte* block, ubyte* rows, const size_t pitch)
+{
+    for (uword y = 0; y < 16; y++)
+        for (uword x = 0; x < 16; x++)
+            rows[y * pitch + x] = block[PAGE_TABLE_8.offsets[y][x]];
+}
+
+/// Writes/reads a 32x16 pixel block of 4-bit rows (lowest nibble first) to/from the 4-bit layout.
+inline void write_block_4(ubyte* block, const ubyte* rows, const size_t pitch)
+{
+    for (uword y = 0; y < 16; y++)
+    {
+        for (uword x = 0; x < 32; x++)
+        {
+            const uword value = (rows[y * pitch + (x >> 1)] >> ((x & 0x1) * 4)) & 0xF;
+            const uword offset = PAGE_TABLE_4.offsets[y][x];
+            const int shift = (offset & 0x1) * 4;
+            ubyte& byte = block[offset >> 1];
+            byte = static_cast<ubyte>((byte & ~(0xF << shift)) | (value << shift));
+        }
+    }
+}
+
+inline void read_block_4(const ubyte* block, ubyte* rows, const size_t pitch)
+{
+    for (uword y = 0; y < 16; y++)
+    {
+        for (uword x = 0; x < 32; x += 2)
+        {
+            const uword offset0 = PAGE_TABLE_4.offsets[y][x];
+            const uword offset1 = PAGE_TABLE_4.offsets[y][x + 1];
+            const uword value0 = (block[offset0 >> 1] >> ((offset0 & 0x1) * 4)) & 0xF;
+            const uword value1 = (block[offset1 >> 1] >> ((offset1 & 0x1) * 4)) & 0xF;
+            rows[y * pitch + (x >> 1)] = static_cast<ubyte>(value0 | (value1 << 4));
+        }
+    }
+}
+} // namespace GsSwizzle
@@ -5,6 +5,11 @@
 #include "Common/Types/Memory/ArrayByteMemory.hpp"
 #include "Common/Types/Register/SizedDwordRegister.hpp"
 #include "Resources/Gs/Crtc/RCrtc.hpp"
+#include "Resources/Gs/GsCommandRing.hpp"
+#include "Resources/Gs/GsContext.hpp"
+#include "Resources/Gs/GsCoreState.hpp"
+#include "Resources/Gs/GsLocalMemory.hpp"
+#include "Resources/Gs/GsRegisters.hpp"
 
 /// Graphics synthesizer (GS) resources.
 class RGs
@@ -15,19 +20,63 @@ public:
     /// (P)CRTC resources.
     RCrtc crtc;
 
+    /// GS local memory (frame, Z and texture buffers).
+    GsLocalMemory memory;
+
+    /// GS general register writes sent by the GIF, in order (see GsCommandRing).
+    GsCommandRing command_ring;
+
+    /// GS general registers, defined on page 94 onwards of the GS Users Manual.
+    /// These are not bus mapped, and are only written through the GIF (see command_ring).
+    /// Addresses are listed for each register.
+    GsRegister_Prim prim;             // 0x00.
+    GsRegister_Rgbaq rgbaq;           // 0x01.
+    GsRegister_St st;                 // 0x02.
+    GsRegister_Uv uv;                 // 0x03.
+    GsRegister_Xyz xyzf2;             // 0x04.
+    GsRegister_Xyz xyz2;              // 0x05.
+    GsRegister_Fog fog;               // 0x0A.
+    GsRegister_Xyz xyzf3;             // 0x0C.
+    GsRegister_Xyz xyz3;              // 0x0D.
+    GsRegister_Prmodecont prmodecont; // 0x1A.
+    GsRegister_Prmode prmode;         // 0x1B.
+    GsRegister_Texclut texclut;       // 0x1C.
+    SizedDwordRegister scanmsk;       // 0x22.
+    GsRegister_Texa texa;             // 0x3B.
+    GsRegister_Fogcol fogcol;         // 0x3D.
+    SizedDwordRegister texflush;      // 0x3F.
+    SizedDwordRegister dimx;          // 0x44.
+    GsRegister_Enable dthe;           // 0x45.
+    GsRegister_Enable colclamp;       // 0x46.
+    GsRegister_Enable pabe;           // 0x49.
+    GsRegister_Bitbltbuf bitbltbuf;   // 0x50.
+    GsRegister_Trxpos trxpos;         // 0x51.
+    GsRegister_Trxreg trxreg;         // 0x52.
+    GsRegister_Trxdir trxdir;         // 0x53.
+    SizedDwordRegister hwreg;         // 0x54.
+    GsRegister_Signal signal;         // 0x60.
+    SizedDwordRegister finish;        // 0x61.
+    GsRegister_Signal label;          // 0x62.
+
+    /// Context 1 and 2 registers (0x06 -> 0x4F, see GsContext).
+    GsContext contexts[2];
+
+    /// Internal GS core state (vertex queue, transmission, CLUT buffer).
+    GsCoreState core_state;
+
     /// GS privileged registers, defined on page 26 onwards of the EE Users Manual. All start from PS2 physical address 0x12000000 to 0x14000000.
     // 0x12000000.
-    SizedDwordRegister pmode;
+    GsRegister_Pmode pmode;
     SizedDwordRegister smode1;
     SizedDwordRegister smode2;
     SizedDwordRegister srfsh;
     SizedDwordRegister synch1;
     SizedDwordRegister synch2;
     SizedDwordRegister syncv;
-    SizedDwordRegister dispfb1;
-    SizedDwordRegister display1;
-    SizedDwordRegister dispfb2;
-    SizedDwordRegister display2;
+    GsRegister_Dispfb dispfb1;
+    GsRegister_Display display1;
+    GsRegister_Dispfb dispfb2;
+    GsRegister_Display display2;
     SizedDwordRegister extbuf;
     SizedDwordRegister extdata;
     SizedDwordRegister extwrite;
@@ -35,12 +84,12 @@ public:
     ArrayByteMemory memory_00f0;
 
     // 0x12001000.
-    SizedDwordRegister csr;
-    SizedDwordRegister imr;
+    GsRegister_Csr csr;
+    GsRegister_Imr imr;
     ArrayByteMemory memory_1020;
     SizedDwordRegister busdir;
     ArrayByteMemory memory_1050;
-    SizedDwordRegister siglblid;
+    GsRegister_Siglblid siglblid;
     ArrayByteMemory memory_1090;
     ArrayByteMemory memory_1100;
 
@@ -53,6 +102,38 @@ public:
     {
         archive(
             CEREAL_NVP(crtc),
+            CEREAL_NVP(memory),
+            CEREAL_NVP(command_ring),
+            CEREAL_NVP(prim),
+            CEREAL_NVP(rgbaq),
+            CEREAL_NVP(st),
+            CEREAL_NVP(uv),
+            CEREAL_NVP(xyzf2),
+            CEREAL_NVP(xyz2),
+            CEREAL_NVP(fog),
+            CEREAL_NVP(xyzf3),
+            CEREAL_NVP(xyz3),
+            CEREAL_NVP(prmodecont),
+            CEREAL_NVP(prmode),
+            CEREAL_NVP(texclut),
+            CEREAL_NVP(scanmsk),
+            CEREAL_NVP(texa),
+            CEREAL_NVP(fogcol),
+            CEREAL_NVP(texflush),
+            CEREAL_NVP(dimx),
+            CEREAL_NVP(dthe),
+            CEREAL_NVP(colclamp),
+            CEREAL_NVP(pabe),
+            CEREAL_NVP(bitbltbuf),
+            CEREAL_NVP(trxpos),
+            CEREAL_NVP(trxreg),
+            CEREAL_NVP(trxdir),
+            CEREAL_NVP(hwreg),
+            CEREAL_NVP(signal),
+            CEREAL_NVP(finish),
+            CEREAL_NVP(label),
+            CEREAL_NVP(contexts),
+            CEREAL_NVP(core_state),
             CEREAL_NVP(pmode),
             CEREAL_NVP(smode1),
             CEREAL_NVP(smode2),
@@ -5,7 +5,9 @@
 IopCoreCop0Register_Status::IopCoreCop0Register_Status() :
     SizedWordRegister(INITIAL_VALUE),
     interrupts_masked(true),
-    operating_context(MipsCoprocessor0::OperatingContext::Kernel)
+    operating_context(MipsCoprocessor0::OperatingContext::Kernel),
+    translation_context(0),
+    isolate_cache(false)
 {
 }
 
@@ -38,6 +40,9 @@ void IopCoreCop0Register_Status::handle_operating_context_update()
         operating_context = MipsCoprocessor0::OperatingContext::Kernel;
     else
         throw std::runtime_error("IOP COP0 could not determine CPU operating context! Please debug.");
+
+    translation_context = static_cast<int>(KUc);
+    isolate_cache = extract_field(IopCoreCop0Register_Status::ISC) > 0;
 }
 
 void IopCoreCop0Register_Status::write_uword(const uword value)
@@ -48,36 +53,30 @@ void IopCoreCop0Register_Status::write_uword(const uword value)
 }
 
 IopCoreCop0Register_Cause::IopCoreCop0Register_Cause() :
-    irq_lines{false}
+    irq_lines(0)
 {
 }
 
 void IopCoreCop0Register_Cause::clear_all_irq()
 {
-    for (auto& line : irq_lines)
-        line = false;
+    irq_lines.store(0, std::memory_order_release);
 }
 
 void IopCoreCop0Register_Cause::set_irq_line(const int irq)
 {
-    irq_lines[irq] = true;
+    irq_lines.fetch_or(1 << irq, std::memory_order_release);
 }
 
 void IopCoreCop0Register_Cause::clear_irq_line(const int irq)
 {
-    irq_lines[irq] = false;
+    irq_lines.fetch_and(~(1 << irq), std::memory_order_release);
 }
 
 uword IopCoreCop0Register_Cause::read_uword()
 {
     uword value = SizedWordRegister::read_uword();
 
-    uword ip = 0;
-    for (int i = 0; i < 8; i++)
-        if (irq_lines[i])
-            ip |= (1 << i);
-
-    value = IP.insert_into(value, ip);
+    value = IP.insert_into(value, get_irq_lines());
 
     // Maybe no point in writing it back...
     SizedWordRegister::write_uword(value);
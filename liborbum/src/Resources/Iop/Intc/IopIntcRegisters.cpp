@@ -1,4 +1,10 @@
 #include "Resources/Iop/Intc/IopIntcRegisters.hpp"
+#include "Resources/Iop/Core/IopCoreCop0Registers.hpp"
+
+IopIntcRegister_Ctrl::IopIntcRegister_Ctrl() :
+    stat(nullptr)
+{
+}
 
 uword IopIntcRegister_Ctrl::byte_bus_read_uword(const BusContext context, const usize offset)
 {
@@ -10,6 +16,54 @@ uword IopIntcRegister_Ctrl::byte_bus_read_uword(const BusContext context, const
     return temp;
 }
 
+void IopIntcRegister_Ctrl::write_ubyte(const size_t offset, const ubyte value)
+{
+    SizedWordRegister::write_ubyte(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void IopIntcRegister_Ctrl::write_uhword(const size_t offset, const uhword value)
+{
+    SizedWordRegister::write_uhword(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void IopIntcRegister_Ctrl::write_uword(const uword value)
+{
+    SizedWordRegister::write_uword(value);
+    stat->handle_interrupt_update();
+}
+
+IopIntcRegister_Mask::IopIntcRegister_Mask() :
+    stat(nullptr)
+{
+}
+
+void IopIntcRegister_Mask::write_ubyte(const size_t offset, const ubyte value)
+{
+    SizedWordRegister::write_ubyte(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void IopIntcRegister_Mask::write_uhword(const size_t offset, const uhword value)
+{
+    SizedWordRegister::write_uhword(offset, value);
+    stat->handle_interrupt_update();
+}
+
+void IopIntcRegister_Mask::write_uword(const uword value)
+{
+    SizedWordRegister::write_uword(value);
+    stat->handle_interrupt_update();
+}
+
+IopIntcRegister_Stat::IopIntcRegister_Stat() :
+    ctrl(nullptr),
+    mask(nullptr),
+    cause(nullptr)
+{
+}
+
 void IopIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
 {
     auto _lock = scope_lock();
@@ -22,3 +76,35 @@ void IopIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const
 
     write_uword(temp);
 }
+
+void IopIntcRegister_Stat::write_ubyte(const size_t offset, const ubyte value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_ubyte(offset, value);
+    handle_interrupt_update();
+}
+
+void IopIntcRegister_Stat::write_uhword(const size_t offset, const uhword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uhword(offset, value);
+    handle_interrupt_update();
+}
+
+void IopIntcRegister_Stat::write_uword(const uword value)
+{
+    auto _lock = scope_lock();
+    SizedWordRegister::write_uword(value);
+    handle_interrupt_update();
+}
+
+void IopIntcRegister_Stat::handle_interrupt_update()
+{
+    // Done under the lock so the last writer (of any register) always decides the line state.
+    auto _lock = scope_lock();
+
+    if ((ctrl->read_uword() > 0) && (read_uword() & mask->read_uword()))
+        cause->set_irq_line(2);
+    else
+        cause->clear_irq_line(2);
+}
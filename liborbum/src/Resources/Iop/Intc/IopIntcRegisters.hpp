@@ -4,19 +4,33 @@
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Common/Types/ScopeLock.hpp"
 
+class IopCoreCop0Register_Cause;
+class IopIntcRegister_Stat;
+
 /// IOP INTC I_CTRL register.
 /// Functionality is largely unknown, however upon reading (through IOP), the register value is set to 0.
 /// Seems to be the master control for masking interrupts.
 /// See https://fossies.org/linux/audacious-plugins/src/psf/peops2/registers.h (line 249), and PCSX2's IopHwRead/Write.cpp.
+/// Writes update the IOP Core INT2 line, see IopIntcRegister_Stat.
 class IopIntcRegister_Ctrl : public SizedWordRegister
 {
 public:
+    IopIntcRegister_Ctrl();
+
     /// Returns the register value, and sets it to 0 after (IOP context only).
     uword byte_bus_read_uword(const BusContext context, const usize offset) override;
+
+    /// Writes update the IOP Core INT2 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
+    IopIntcRegister_Stat* stat;
 };
 
 /// The IOP INTC I_MASK register, which holds a set of flags determining if the interrupt source is masked.
 /// Names from here, not sure if accurate: https://github.com/kode54/Highly_Experimental/blob/master/Core/iop.c.
+/// Writes update the IOP Core INT2 line, see IopIntcRegister_Stat.
 class IopIntcRegister_Mask : public SizedWordRegister
 {
 public:
@@ -46,6 +60,15 @@ public:
     static constexpr Bitfield EXTR = Bitfield(23, 1);
     static constexpr Bitfield FWRE = Bitfield(24, 1);
     static constexpr Bitfield FDMA = Bitfield(25, 1);
+
+    IopIntcRegister_Mask();
+
+    /// Writes update the IOP Core INT2 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
+    IopIntcRegister_Stat* stat;
 };
 
 /// The IOP INTC I_STAT register, which holds a set of flags determining if a component caused an interrupt.
@@ -53,6 +76,9 @@ public:
 /// Names from here, not sure if accurate: https://github.com/kode54/Highly_Experimental/blob/master/Core/iop.c.
 /// (Assumed) The INTC is edge triggered (ie: only need to pulse line), see the EE INTC equivilant.
 /// STAT writes needs to be scope locked by the peripherals.
+/// Interrupts are delivered on change rather than polled: any STAT, MASK or
+/// CTRL write sets or clears the IOP Core INT2 line (COP0.Cause.IP[2])
+/// according to CTRL and STAT & MASK, so the INTC does not need to be run.
 class IopIntcRegister_Stat : public SizedWordRegister, public ScopeLock
 {
 public:
@@ -86,7 +112,22 @@ public:
     static constexpr Bitfield IRQ_KEYS[Constants::IOP::INTC::NUMBER_IRQ_LINES] = {VBLANK, GPU, CDROM, DMAC, TMR0, TMR1, TMR2, SIO0, SIO1, SPU, PIO, EVBLANK, DVD, PCMCIA, TMR3, TMR4, TMR5, SIO2, HTR0, HTR1, HTR2, HTR3, USB, EXTR, FWRE, FDMA};
     static constexpr Bitfield TMR_KEYS[Constants::IOP::Timers::NUMBER_TIMERS] = {TMR0, TMR1, TMR2, TMR3, TMR4, TMR5};
 
+    IopIntcRegister_Stat();
+
     /// AND's the new value with old value (IOP context only).
     /// Scope locked.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+
+    /// Writes update the IOP Core INT2 line.
+    void write_ubyte(const size_t offset, const ubyte value) override;
+    void write_uhword(const size_t offset, const uhword value) override;
+    void write_uword(const uword value) override;
+
+    /// Sets or clears the IOP Core INT2 line based on CTRL and STAT & MASK.
+    /// Scope locked.
+    void handle_interrupt_update();
+
+    IopIntcRegister_Ctrl* ctrl;
+    IopIntcRegister_Mask* mask;
+    IopCoreCop0Register_Cause* cause;
 };
\ No newline at end of file
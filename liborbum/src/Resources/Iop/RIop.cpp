@@ -2,7 +2,7 @@
 
 RIop::RIop() :
     bus(16),
-    main_memory(Constants::IOP::IOPMemory::SIZE_IOP_MEMORY),
+    main_memory(Constants::IOP::IOPMemory::SIZE_IOP_MEMORY, 0, false, true),
     parallel_port(Constants::IOP::ParallelPort::SIZE_PARALLEL_PORT)
 {
 }
\ No newline at end of file
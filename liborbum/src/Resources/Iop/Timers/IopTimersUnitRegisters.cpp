@@ -5,6 +5,7 @@
 #include "Core.hpp"
 
 IopTimersUnitRegister_Count::IopTimersUnitRegister_Count(const bool b32_mode) :
+    LazyCountRegister(b32_mode ? (static_cast<udword>(VALUE_UWORD_MAX) + 1) : (static_cast<udword>(VALUE_UHWORD_MAX) + 1)),
     is_using_32b_mode(b32_mode),
     is_overflowed(false),
     prescale_target(1),
@@ -14,6 +15,8 @@ IopTimersUnitRegister_Count::IopTimersUnitRegister_Count(const bool b32_mode) :
 
 void IopTimersUnitRegister_Count::increment(const uword value)
 {
+    auto _lock = scope_lock();
+
     if (!is_using_32b_mode)
         increment_16(value);
     else
@@ -29,6 +32,8 @@ bool IopTimersUnitRegister_Count::is_overflowed_and_reset()
 
 void IopTimersUnitRegister_Count::reset_prescale(const int prescale_target)
 {
+    auto _lock = scope_lock();
+
     write_uword(0);
 
     this->prescale_target = prescale_target;
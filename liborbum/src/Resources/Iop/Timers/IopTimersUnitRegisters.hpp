@@ -5,6 +5,7 @@
 #include <cereal/cereal.hpp>
 #include <cereal/types/polymorphic.hpp>
 
+#include "Common/Types/Register/LazyCountRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
 #include "Common/Types/ScopeLock.hpp"
 #include "Controller/ControllerEvent.hpp"
@@ -13,8 +14,9 @@ using ControllerEventType = ControllerEvent::Type;
 
 /// Timer count register.
 /// Can either operate in 16-bit mode (timers 0 -> 2) or 32-bit mode (timers 3 -> 5).
-/// This register is only accessed by the Timers controller, it doesn't need any sync support.
-class IopTimersUnitRegister_Count : public SizedWordRegister
+/// When following the bus clock, the count is derived on demand from the master cycle count (see LazyCountRegister).
+/// Accesses are scope locked, as the count is read by the CPU bus while the Timers controller reprograms it.
+class IopTimersUnitRegister_Count : public LazyCountRegister
 {
 public:
     IopTimersUnitRegister_Count(const bool b32_mode);
@@ -52,7 +54,7 @@ public:
     void serialize(Archive & archive)
     {
         archive(
-            cereal::base_class<SizedWordRegister>(this),
+            cereal::base_class<LazyCountRegister>(this),
             CEREAL_NVP(is_overflowed),
             CEREAL_NVP(prescale_target),
             CEREAL_NVP(prescale_count)
@@ -1,10 +1,10 @@
 #include "Resources/RResources.hpp"
 
 RResources::RResources() :
-    boot_rom(Constants::EE::ROM::SIZE_BOOT_ROM, 0, true),
-    rom1(Constants::EE::ROM::SIZE_ROM1, 0, true),
-    erom(Constants::EE::ROM::SIZE_EROM, 0, true),
-    rom2(Constants::EE::ROM::SIZE_ROM2, 0, true),
+    boot_rom(Constants::EE::ROM::SIZE_BOOT_ROM, 0, true, true),
+    rom1(Constants::EE::ROM::SIZE_ROM1, 0, true, true),
+    erom(Constants::EE::ROM::SIZE_EROM, 0, true, true),
+    rom2(Constants::EE::ROM::SIZE_ROM2, 0, true, true),
     sbus_f260(0, true)
 {
 }
@@ -27,6 +27,13 @@ void initialise_spu2(RResources* r)
     r->spu2.core_1.admas.core_id = &r->spu2.core_1.core_id;
 }
 
+void initialise_gs(RResources* r)
+{
+    // Registers synced with the GS core before being read by the EE.
+    r->gs.csr.command_ring = &r->gs.command_ring;
+    r->gs.siglblid.command_ring = &r->gs.command_ring;
+}
+
 void initialise_ee_timers(RResources* r)
 {
     r->ee.timers.units[0].unit_id = &r->ee.timers.unit_0.unit_id;
@@ -53,8 +60,17 @@ void initialise_ee_timers(RResources* r)
     r->ee.timers.units[1].hold = &r->ee.timers.unit_1.hold;
 }
 
+void initialise_ee_intc(RResources* r)
+{
+    r->ee.intc.mask.stat = &r->ee.intc.stat;
+    r->ee.intc.stat.mask = &r->ee.intc.mask;
+    r->ee.intc.stat.cause = &r->ee.core.cop0.cause;
+}
+
 void initialise_ee_dmac(RResources* r)
 {
+    r->ee.dmac.stat.cause = &r->ee.core.cop0.cause;
+
     // Init SIF sbus references.
     r->ee.dmac.channel_sif0.chcr.sbus_f240 = &r->sbus_f240;
     r->ee.dmac.channel_sif1.chcr.sbus_f240 = &r->sbus_f240;
@@ -143,6 +159,13 @@ void initialise_ee_vpu(RResources* r)
         r->ee.vpu.vu.unit_1.vi_32[i].hword_register = &r->ee.vpu.vu.unit_1.vi[i];
     }
 
+    // Init vf_128 wrappers.
+    for (int i = 0; i < Constants::EE::VPU::VU::NUMBER_VF_REGISTERS; i++)
+    {
+        r->ee.vpu.vu.unit_0.vf_128[i].qword_register = &r->ee.vpu.vu.unit_0.vf[i];
+        r->ee.vpu.vu.unit_1.vf_128[i].qword_register = &r->ee.vpu.vu.unit_1.vf[i];
+    }
+
     // Init unit_0.ccr registers.
     r->ee.vpu.vu.unit_0.ccr[0] = &r->ee.vpu.vu.unit_0.vi_32[0];
     r->ee.vpu.vu.unit_0.ccr[1] = &r->ee.vpu.vu.unit_0.vi_32[1];
@@ -186,7 +209,7 @@ void initialise_ee_vpu(RResources* r)
 
         // VU1.vf Registers, see VU Users Manual page 222.
         for (auto i = 0; i < Constants::EE::VPU::VU::NUMBER_VF_REGISTERS; i++)
-            r->ee.vpu.vu.unit_0.bus.map(0x4000 + i * NUMBER_BYTES_IN_QWORD, &r->ee.vpu.vu.unit_1.vf[i]);
+            r->ee.vpu.vu.unit_0.bus.map(0x4000 + i * NUMBER_BYTES_IN_QWORD, &r->ee.vpu.vu.unit_1.vf_128[i]);
 
         // VU1.vi Registers. Aligned on 128-bit boundaries, accessed by 32-bit r/w, but upper 16-bits discarded!
         // NOT mapped as the true register size of 16-bit. See EE Users Manual page 84.
@@ -213,9 +236,25 @@ void initialise_ee_vpu(RResources* r)
     // Init VU0 COP0.
     r->ee.vpu.vu.unit_0.cop0 = &r->ee.core.cop0;
 
-    // Init MAC registers.
+    // Init MAC and Status registers (linked for the deferred flag updates).
     r->ee.vpu.vu.unit_0.mac.status = &r->ee.vpu.vu.unit_0.status;
     r->ee.vpu.vu.unit_1.mac.status = &r->ee.vpu.vu.unit_1.status;
+    r->ee.vpu.vu.unit_0.status.mac = &r->ee.vpu.vu.unit_0.mac;
+    r->ee.vpu.vu.unit_1.status.mac = &r->ee.vpu.vu.unit_1.mac;
+
+    // Init micro mode resources.
+    r->ee.vpu.vu.unit_0.instruction_memory = &r->ee.vpu.vu.unit_0.memory_micro;
+    r->ee.vpu.vu.unit_1.instruction_memory = &r->ee.vpu.vu.unit_1.memory_micro;
+    r->ee.vpu.vu.unit_0.data_memory = &r->ee.vpu.vu.unit_0.memory_mem;
+    r->ee.vpu.vu.unit_1.data_memory = &r->ee.vpu.vu.unit_1.memory_mem;
+    r->ee.vpu.vu.unit_0.micro_sync.stat = &r->ee.vpu.stat;
+    r->ee.vpu.vu.unit_0.micro_sync.stat_vbs = VpuRegister_Stat::VBS0;
+    r->ee.vpu.vu.unit_1.micro_sync.stat = &r->ee.vpu.stat;
+    r->ee.vpu.vu.unit_1.micro_sync.stat_vbs = VpuRegister_Stat::VBS1;
+
+    // Init VIF -> VU unit references.
+    r->ee.vpu.vif.unit_0.vu_unit = &r->ee.vpu.vu.unit_0;
+    r->ee.vpu.vif.unit_1.vu_unit = &r->ee.vpu.vu.unit_1;
 }
 
 void initialise_iop_dmac(RResources* r)
@@ -326,6 +365,9 @@ void initialise_ee(RResources* r)
             r->ee.bus.map(0x1A000000, &r->ee.unknown_1a000000);
         }
 
+        // Track writes to the physical address space (512MB), used by the EE Core block cache.
+        r->ee.bus.enable_write_tracking(Constants::SIZE_512MB);
+
         // EE Registers.
         {
             // MISC EE registers.
@@ -616,6 +658,9 @@ void initialise_iop(RResources* r)
             r->iop.bus.map(0x1F800000, &r->iop.core.scratchpad_memory);
         }
 
+        // Track writes to main memory, used by the IOP Core idle loop detection.
+        r->iop.bus.enable_write_tracking(Constants::IOP::IOPMemory::SIZE_IOP_MEMORY);
+
         // IOP Registers.
         {
             // Misc IOP Registers.
@@ -1713,6 +1758,15 @@ void initialise_iop_core(RResources* r)
     r->iop.core.cop0.registers[16] = &r->iop.core.cop0.erreg;
 }
 
+void initialise_iop_intc(RResources* r)
+{
+    r->iop.intc.ctrl.stat = &r->iop.intc.stat;
+    r->iop.intc.mask.stat = &r->iop.intc.stat;
+    r->iop.intc.stat.ctrl = &r->iop.intc.ctrl;
+    r->iop.intc.stat.mask = &r->iop.intc.mask;
+    r->iop.intc.stat.cause = &r->iop.core.cop0.cause;
+}
+
 void initialise_iop_timers(RResources* r)
 {
     r->iop.timers.units[0] = &r->iop.timers.unit_0;
@@ -1809,11 +1863,13 @@ void initialise_resources(const std::unique_ptr<RResources>& r)
 {
     initialise_ee_core(r.get());
     initialise_ee_timers(r.get());
+    initialise_ee_intc(r.get());
     initialise_ee_dmac(r.get());
     initialise_ee_vpu(r.get());
 
     initialise_iop_core(r.get());
     initialise_iop_dmac(r.get());
+    initialise_iop_intc(r.get());
     initialise_iop_timers(r.get());
     initialise_iop_sio2(r.get());
     initialise_iop_sio0(r.get());
@@ -1822,6 +1878,8 @@ void initialise_resources(const std::unique_ptr<RResources>& r)
 
     initialise_spu2(r.get());
 
+    initialise_gs(r.get());
+
     initialise_ee(r.get());
     initialise_iop(r.get());
 }
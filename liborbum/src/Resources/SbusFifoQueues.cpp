@@ -25,4 +25,27 @@ void SbusFifoQueue_Sif2::write_ubyte(const ubyte data)
 
     // Signal data is available.
     sbus_f300->write_uword(sbus_f300->read_uword() & (~0x04000000));
-}
\ No newline at end of file
+}
+
+void SbusFifoQueue_Sif2::read(ubyte* buffer, const size_t length)
+{
+    auto _lock = scope_lock();
+
+    DmaFifoQueue::read(buffer, length);
+
+    // Check if the FIFO queue is empty.
+    if (is_empty())
+        sbus_f300->write_uword(sbus_f300->read_uword() | 0x04000000);
+    else
+        sbus_f300->write_uword(sbus_f300->read_uword() & (~0x04000000));
+}
+
+void SbusFifoQueue_Sif2::write(const ubyte* buffer, const size_t length)
+{
+    auto _lock = scope_lock();
+
+    DmaFifoQueue::write(buffer, length);
+
+    // Signal data is available.
+    sbus_f300->write_uword(sbus_f300->read_uword() & (~0x04000000));
+}
@@ -14,6 +14,8 @@ public:
     /// Based upon PCSX2's "sif2.cpp".
     ubyte read_ubyte() override;
     void write_ubyte(const ubyte data) override;
+    void read(ubyte* buffer, const size_t length) override;
+    void write(const ubyte* buffer, const size_t length) override;
 
     /// Reference to the SBUS_F300 register.
     SbusRegister_F300* sbus_f300;
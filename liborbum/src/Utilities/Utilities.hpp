@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <limits>
+#include <string>
 
 #include "Common/Constants.hpp"
 #include "Common/Types/FpuFlags.hpp"
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Common/Types/Primitive.hpp"
+
+/// Lists of the EeCoreMmi kernels (see Controller/Ee/Core/EeCoreMmi.hpp), by signature.
+#define EE_CORE_MMI_BINARY_KERNELS(X) \
+    X(paddb)                          \
+    X(paddh)                          \
+    X(paddw)                          \
+    X(paddsb)                         \
+    X(paddsh)                         \
+    X(paddsw)                         \
+    X(paddub)                         \
+    X(padduh)                         \
+    X(padduw)                         \
+    X(psubb)                          \
+    X(psubh)                          \
+    X(psubw)                          \
+    X(psubsb)                         \
+    X(psubsh)                         \
+    X(psubsw)                         \
+    X(psubub)                         \
+    X(psubuh)                         \
+    X(psubuw)                         \
+    X(padsbh)                         \
+    X(pmaxh)                          \
+    X(pmaxw)                          \
+    X(pminh)                          \
+    X(pminw)                          \
+    X(pceqb)                          \
+    X(pceqh)                          \
+    X(pceqw)                          \
+    X(pcgtb)                          \
+    X(pcgth)                          \
+    X(pcgtw)                          \
+    X(pextlb)                         \
+    X(pextlh)                         \
+    X(pextlw)                         \
+    X(pextub)                         \
+    X(pextuh)                         \
+    X(pextuw)                         \
+    X(ppacb)                          \
+    X(ppach)                          \
+    X(ppacw)                          \
+    X(pcpyld)                         \
+    X(pcpyud)                         \
+    X(pinteh)                         \
+    X(pinth)
+
+#define EE_CORE_MMI_UNARY_KERNELS(X) \
+    X(pcpyh)                         \
+    X(pexch)                         \
+    X(pexcw)                         \
+    X(pexeh)                         \
+    X(pexew)                         \
+    X(prevh)                         \
+    X(prot3w)
+
+/// Shift kernels, with the maximum shift amount.
+#define EE_CORE_MMI_SHIFT_KERNELS(X) \
+    X(psllh, 15)                     \
+    X(psrlh, 15)                     \
+    X(psrah, 15)                     \
+    X(psllw, 31)                     \
+    X(psrlw, 31)                     \
+    X(psraw, 31)
+
+#define EE_CORE_MMI_DECLARE_BINARY(name) uqword name(const uqword& a, const uqword& b);
+#define EE_CORE_MMI_DECLARE_UNARY(name) uqword name(const uqword& b);
+#define EE_CORE_MMI_DECLARE_SHIFT(name, max_shamt) uqword name(const uqword& b, const int shamt);
+
+/// The templated kernels (PMADDH/PMSUBH accumulate onto (HI,LO)) are declared by their instruction names.
+#define EE_CORE_MMI_DECLARE_KERNELS                                              \
+    EE_CORE_MMI_BINARY_KERNELS(EE_CORE_MMI_DECLARE_BINARY)                       \
+    EE_CORE_MMI_UNARY_KERNELS(EE_CORE_MMI_DECLARE_UNARY)                         \
+    EE_CORE_MMI_SHIFT_KERNELS(EE_CORE_MMI_DECLARE_SHIFT)                         \
+    uqword pmaddh(const uqword& a, const uqword& b, uqword& lo, uqword& hi);     \
+    uqword pmsubh(const uqword& a, const uqword& b, uqword& lo, uqword& hi);     \
+    uqword phmadh(const uqword& a, const uqword& b);                             \
+    uqword phmsbh(const uqword& a, const uqword& b);
+
+/// The kernels as built for SSE2 hosts (see EeCoreMmiKernelsSse2.cpp).
+namespace EeCoreMmiSse2
+{
+EE_CORE_MMI_DECLARE_KERNELS
+}
+
+/// The kernels as built for other hosts (see EeCoreMmiKernelsScalar.cpp).
+namespace EeCoreMmiScalar
+{
+EE_CORE_MMI_DECLARE_KERNELS
+}
@@ -0,0 +1,55 @@
+// Defines the kernels declared in EeCoreMmiKernels.hpp in the namespace
+// EE_CORE_MMI_KERNELS_NAMESPACE, using EeCoreMmi as configured by the
+// including translation unit (see Common/Simd.hpp). EeCoreMmi is included
+// into an unnamed namespace, so the SSE2 and scalar builds of its inline
+// functions don't clash at link time.
+
+#include <cstring>
+#include <limits>
+
+#include "Common/Simd.hpp"
+
+#include "EeCoreMmiKernels.hpp"
+
+namespace
+{
+#include "Controller/Ee/Core/EeCoreMmi.hpp"
+}
+
+namespace EE_CORE_MMI_KERNELS_NAMESPACE
+{
+#define EE_CORE_MMI_DEFINE_BINARY(name) \
+    uqword name(const uqword& a, const uqword& b) { return EeCoreMmi::name(a, b); }
+#define EE_CORE_MMI_DEFINE_UNARY(name) \
+    uqword name(const uqword& b) { return EeCoreMmi::name(b); }
+#define EE_CORE_MMI_DEFINE_SHIFT(name, max_shamt) \
+    uqword name(const uqword& b, const int shamt) { return EeCoreMmi::name(b, shamt); }
+
+EE_CORE_MMI_BINARY_KERNELS(EE_CORE_MMI_DEFINE_BINARY)
+EE_CORE_MMI_UNARY_KERNELS(EE_CORE_MMI_DEFINE_UNARY)
+EE_CORE_MMI_SHIFT_KERNELS(EE_CORE_MMI_DEFINE_SHIFT)
+
+uqword pmaddh(const uqword& a, const uqword& b, uqword& lo, uqword& hi)
+{
+    return EeCoreMmi::pmaddh<false>(a, b, lo, hi);
+}
+
+uqword pmsubh(const uqword& a, const uqword& b, uqword& lo, uqword& hi)
+{
+    return EeCoreMmi::pmaddh<true>(a, b, lo, hi);
+}
+
+uqword phmadh(const uqword& a, const uqword& b)
+{
+    return EeCoreMmi::phmadh<false>(a, b);
+}
+
+uqword phmsbh(const uqword& a, const uqword& b)
+{
+    return EeCoreMmi::phmadh<true>(a, b);
+}
+
+#undef EE_CORE_MMI_DEFINE_BINARY
+#undef EE_CORE_MMI_DEFINE_UNARY
+#undef EE_CORE_MMI_DEFINE_SHIFT
+} // namespace EE_CORE_MMI_KERNELS_NAMESPACE
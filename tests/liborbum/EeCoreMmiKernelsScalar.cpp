@@ -0,0 +1,3 @@
+#define SIMD_SCALAR
+#define EE_CORE_MMI_KERNELS_NAMESPACE EeCoreMmiScalar
+#include "EeCoreMmiKernels.inl"
@@ -0,0 +1,6 @@
+#define EE_CORE_MMI_KERNELS_NAMESPACE EeCoreMmiSse2
+#include "EeCoreMmiKernels.inl"
+
+#if !defined(SIMD_SSE2)
+#error "The SSE2 kernels are not available on this host."
+#endif
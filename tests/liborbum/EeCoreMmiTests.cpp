@@ -0,0 +1,229 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "EeCoreMmiKernels.hpp"
+
+/// Checks the SSE2 build of each EeCoreMmi kernel against the scalar build,
+/// for inputs made up of the saturation and sign boundary values of each lane
+/// width, followed by randomised inputs biased towards those values.
+/// A few known results are checked against both builds as well.
+
+namespace
+{
+/// Boundary lane values, for lanes of 8, 16 and 32 bits.
+const std::vector<uword> EDGE_VALUES_8 = {0x00, 0x01, 0x7E, 0x7F, 0x80, 0x81, 0xFE, 0xFF};
+const std::vector<uword> EDGE_VALUES_16 = {0x0000, 0x0001, 0x7FFF, 0x8000, 0x8001, 0xFFFF, 0x00FF, 0xFF00};
+const std::vector<uword> EDGE_VALUES_32 = {0x00000000, 0x00000001, 0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFFFFFF, 0x0000FFFF, 0xFFFF0000};
+
+/// Number of randomised inputs per kernel.
+constexpr size_t NUMBER_RANDOM_INPUTS = 100000;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Returns a qword with each lane (of the width given) set to edges[(index + i) % size],
+/// so that all lane positions see all of the boundary values.
+uqword make_edge_qword(const size_t width, const size_t index)
+{
+    const std::vector<uword>& edges = (width == 8) ? EDGE_VALUES_8 : ((width == 16) ? EDGE_VALUES_16 : EDGE_VALUES_32);
+    uqword q;
+    for (size_t i = 0; i < 128 / width; i++)
+    {
+        const uword value = edges[(index + i) % edges.size()];
+        if (width == 8)
+            q.ub[i] = ubyte(value);
+        else if (width == 16)
+            q.uh[i] = uhword(value);
+        else
+            q.uw[i] = value;
+    }
+    return q;
+}
+
+/// Returns a random qword, with each byte/hword/word lane having an even
+/// chance of being a boundary value instead.
+uqword make_random_qword()
+{
+    uqword q(random(), random());
+    const size_t width = size_t(8) << (random() % 3);
+    const std::vector<uword>& edges = (width == 8) ? EDGE_VALUES_8 : ((width == 16) ? EDGE_VALUES_16 : EDGE_VALUES_32);
+    for (size_t i = 0; i < 128 / width; i++)
+    {
+        if (random() & 1)
+            continue;
+        const uword value = edges[random() % edges.size()];
+        if (width == 8)
+            q.ub[i] = ubyte(value);
+        else if (width == 16)
+            q.uh[i] = uhword(value);
+        else
+            q.uw[i] = value;
+    }
+    return q;
+}
+
+/// All of the pairs of edge qwords for each width, then random pairs.
+std::vector<std::pair<uqword, uqword>> make_inputs()
+{
+    std::vector<std::pair<uqword, uqword>> inputs;
+    for (const size_t width : {8, 16, 32})
+    {
+        for (size_t i = 0; i < EDGE_VALUES_8.size(); i++)
+            for (size_t j = 0; j < EDGE_VALUES_8.size(); j++)
+                inputs.emplace_back(make_edge_qword(width, i), make_edge_qword(width, j));
+    }
+    for (size_t i = 0; i < NUMBER_RANDOM_INPUTS; i++)
+        inputs.emplace_back(make_random_qword(), make_random_qword());
+    return inputs;
+}
+
+bool operator==(const uqword& x, const uqword& y)
+{
+    return (x.lo == y.lo) && (x.hi == y.hi);
+}
+
+void print_qword(const char* name, const uqword& q)
+{
+    std::printf("  %-8s %08X_%08X_%08X_%08X\n", name, q.uw[3], q.uw[2], q.uw[1], q.uw[0]);
+}
+
+/// Records the check, printing the details on the first few failures.
+void check(const char* kernel, const uqword& a, const uqword& b, const uqword& sse2, const uqword& scalar)
+{
+    number_checks++;
+    if (sse2 == scalar)
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf("%s: SSE2 and scalar results differ.\n", kernel);
+        print_qword("a", a);
+        print_qword("b", b);
+        print_qword("sse2", sse2);
+        print_qword("scalar", scalar);
+    }
+}
+
+void check_expected(const char* kernel, const uqword& result, const uqword& expected)
+{
+    number_checks++;
+    if (result == expected)
+        return;
+
+    number_failures++;
+    std::printf("%s: unexpected result.\n", kernel);
+    print_qword("result", result);
+    print_qword("expected", expected);
+}
+
+void test_sse2_against_scalar(const std::vector<std::pair<uqword, uqword>>& inputs)
+{
+    for (const auto& input : inputs)
+    {
+        const uqword& a = input.first;
+        const uqword& b = input.second;
+
+#define EE_CORE_MMI_CHECK_BINARY(name) \
+    check(#name, a, b, EeCoreMmiSse2::name(a, b), EeCoreMmiScalar::name(a, b));
+#define EE_CORE_MMI_CHECK_UNARY(name) \
+    check(#name, b, b, EeCoreMmiSse2::name(b), EeCoreMmiScalar::name(b));
+
+        EE_CORE_MMI_BINARY_KERNELS(EE_CORE_MMI_CHECK_BINARY)
+        EE_CORE_MMI_UNARY_KERNELS(EE_CORE_MMI_CHECK_UNARY)
+        EE_CORE_MMI_CHECK_BINARY(phmadh)
+        EE_CORE_MMI_CHECK_BINARY(phmsbh)
+
+#undef EE_CORE_MMI_CHECK_BINARY
+#undef EE_CORE_MMI_CHECK_UNARY
+
+        // Shift by every amount, the shifted out bits and sign fill differ at the boundaries.
+#define EE_CORE_MMI_CHECK_SHIFT(name, max_shamt)                                             \
+    for (int shamt = 0; shamt <= max_shamt; shamt++)                                         \
+        check(#name, b, uqword(udword(shamt)), EeCoreMmiSse2::name(b, shamt), EeCoreMmiScalar::name(b, shamt));
+
+        EE_CORE_MMI_SHIFT_KERNELS(EE_CORE_MMI_CHECK_SHIFT)
+
+#undef EE_CORE_MMI_CHECK_SHIFT
+
+        // Accumulate onto (HI,LO) made up of the operands, checking all 3 results.
+        {
+            uqword lo_sse2 = a, hi_sse2 = b, lo_scalar = a, hi_scalar = b;
+            check("pmaddh", a, b, EeCoreMmiSse2::pmaddh(a, b, lo_sse2, hi_sse2), EeCoreMmiScalar::pmaddh(a, b, lo_scalar, hi_scalar));
+            check("pmaddh.lo", a, b, lo_sse2, lo_scalar);
+            check("pmaddh.hi", a, b, hi_sse2, hi_scalar);
+        }
+        {
+            uqword lo_sse2 = b, hi_sse2 = a, lo_scalar = b, hi_scalar = a;
+            check("pmsubh", a, b, EeCoreMmiSse2::pmsubh(a, b, lo_sse2, hi_sse2), EeCoreMmiScalar::pmsubh(a, b, lo_scalar, hi_scalar));
+            check("pmsubh.lo", a, b, lo_sse2, lo_scalar);
+            check("pmsubh.hi", a, b, hi_sse2, hi_scalar);
+        }
+    }
+}
+
+/// Known results at the saturation and sign boundaries, for both builds.
+void test_expected_results()
+{
+    const uqword bytes_7f(0x7F7F7F7F7F7F7F7F);
+    const uqword bytes_80(0x8080808080808080);
+    const uqword bytes_01(0x0101010101010101);
+    const uqword bytes_ff(0xFFFFFFFFFFFFFFFF);
+    const uqword hwords_7fff(0x7FFF7FFF7FFF7FFF);
+    const uqword hwords_8000(0x8000800080008000);
+    const uqword words_7fffffff(0x7FFFFFFF7FFFFFFF);
+    const uqword words_80000000(0x8000000080000000);
+    const uqword words_1(0x0000000100000001);
+    const uqword zero(0);
+
+#define EE_CORE_MMI_CHECK_EXPECTED(name, a, b, expected)                    \
+    check_expected(#name " (sse2)", EeCoreMmiSse2::name(a, b), expected);   \
+    check_expected(#name " (scalar)", EeCoreMmiScalar::name(a, b), expected);
+
+    // Signed saturation.
+    EE_CORE_MMI_CHECK_EXPECTED(paddsb, bytes_7f, bytes_01, bytes_7f)
+    EE_CORE_MMI_CHECK_EXPECTED(psubsb, bytes_80, bytes_01, bytes_80)
+    EE_CORE_MMI_CHECK_EXPECTED(paddsh, hwords_7fff, hwords_7fff, hwords_7fff)
+    EE_CORE_MMI_CHECK_EXPECTED(psubsh, hwords_8000, hwords_7fff, hwords_8000)
+    EE_CORE_MMI_CHECK_EXPECTED(paddsw, words_7fffffff, words_1, words_7fffffff)
+    EE_CORE_MMI_CHECK_EXPECTED(psubsw, words_80000000, words_1, words_80000000)
+    EE_CORE_MMI_CHECK_EXPECTED(paddsw, words_80000000, words_80000000, words_80000000)
+    EE_CORE_MMI_CHECK_EXPECTED(psubsw, words_7fffffff, words_80000000, words_7fffffff)
+
+    // Unsigned saturation.
+    EE_CORE_MMI_CHECK_EXPECTED(paddub, bytes_ff, bytes_01, bytes_ff)
+    EE_CORE_MMI_CHECK_EXPECTED(psubub, zero, bytes_01, zero)
+    EE_CORE_MMI_CHECK_EXPECTED(padduw, bytes_ff, words_1, bytes_ff)
+    EE_CORE_MMI_CHECK_EXPECTED(psubuw, words_1, words_80000000, zero)
+
+    // Signed comparisons: 0x80.. is the smallest value, not the largest.
+    EE_CORE_MMI_CHECK_EXPECTED(pcgtb, bytes_80, bytes_7f, zero)
+    EE_CORE_MMI_CHECK_EXPECTED(pcgtb, bytes_7f, bytes_80, bytes_ff)
+    EE_CORE_MMI_CHECK_EXPECTED(pcgtw, words_80000000, words_7fffffff, zero)
+    EE_CORE_MMI_CHECK_EXPECTED(pmaxh, hwords_8000, hwords_7fff, hwords_7fff)
+    EE_CORE_MMI_CHECK_EXPECTED(pminw, words_80000000, words_7fffffff, words_80000000)
+    EE_CORE_MMI_CHECK_EXPECTED(pmaxw, words_80000000, zero, zero)
+
+#undef EE_CORE_MMI_CHECK_EXPECTED
+}
+} // namespace
+
+int main()
+{
+    test_sse2_against_scalar(make_inputs());
+    test_expected_results();
+
+    std::printf("EeCoreMmi: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Controller/Gs/Core/GsPixelPipeline.hpp"
+#include "Controller/Gs/Core/GsPixelPipelineCompiler.hpp"
+#include "Resources/Gs/GsLocalMemory.hpp"
+
+/// Checks the pipelines compiled by GsPixelPipelineCompiler against the
+/// interpreter (GsPixelPipeline::shade_span), by shading the same spans into
+/// the same starting memory with both and comparing the memory afterwards.
+/// The draw states cover each of the fields the compiled code is specialised
+/// on (see GsPixelPipelineCompiler::make_key()): the frame and Z formats,
+/// depth test, alpha test and fail modes, destination alpha test, all of the
+/// blend equations with PABE and COLCLAMP, FBA, texture mapping and fogging,
+/// along with random FBMSK, AREF, FIX, colours and depths (including
+/// colours and depths out of range, which are clamped).
+
+namespace
+{
+/// Number of randomised draw states, and spans drawn with each.
+constexpr size_t NUMBER_RANDOM_STATES = 3000;
+constexpr size_t NUMBER_SPANS_PER_STATE = 8;
+
+/// Buffers are kept within the start of memory, so only that much needs to
+/// be reset and compared for each state. Buffer base pointers are in blocks,
+/// 32 blocks per page.
+constexpr size_t TEST_MEMORY_SIZE = 512 * 1024;
+constexpr uword NUMBER_TEST_PAGES = TEST_MEMORY_SIZE / 8192;
+
+/// Frame buffer width (in units of 64 pixels), and the span area.
+constexpr uword FBW = 2;
+constexpr int AREA_WIDTH = 128;
+constexpr int AREA_HEIGHT = 64;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Returns a random float in the range given.
+float random_float(const float min, const float max)
+{
+    return min + (max - min) * static_cast<float>(random() % 65536) / 65536.0f;
+}
+
+/// Returns a draw state with random settings for each pipeline stage.
+/// Buffers are placed in separate pages (the 4 pages of the frame and Z
+/// buffers, and 1 for the texture).
+GsDrawState make_random_state()
+{
+    GsDrawState state{};
+
+    const uword frame_formats[] = {GsLocalMemory::PSMCT32, GsLocalMemory::PSMCT24, GsLocalMemory::PSMZ32, GsLocalMemory::PSMZ24};
+    const uword z_formats[] = {GsLocalMemory::PSMZ32, GsLocalMemory::PSMZ24};
+    const uword pages[] = {0, 4, 8, 12};
+    const uword frame_page = pages[random() % 4];
+    uword z_page = pages[random() % 4];
+    if (z_page == frame_page)
+        z_page = (frame_page + 4) % 16;
+
+    state.fbp = frame_page * 32;
+    state.fbw = FBW;
+    state.fpsm = frame_formats[random() % 4];
+    state.fbmsk = (random() % 2) ? 0 : static_cast<uword>(random() & random());
+
+    state.zbp = z_page * 32;
+    state.zpsm = z_formats[random() % 2];
+    state.zmsk = (random() % 4) == 0;
+
+    state.ate = random() % 2;
+    state.atst = random() % 8;
+    state.aref = random() % 256;
+    state.afail = random() % 4;
+    state.date = random() % 2;
+    state.datm = random() % 2;
+    state.zte = random() % 2;
+    state.ztst = random() % 4;
+
+    state.abe = random() % 2;
+    state.alpha_a = random() % 4;
+    state.alpha_b = random() % 4;
+    state.alpha_c = random() % 4;
+    state.alpha_d = random() % 4;
+    state.alpha_fix = random() % 256;
+    state.pabe = random() % 2;
+    state.colclamp = random() % 2;
+    state.fba = random() % 2;
+
+    state.scissor_x1 = AREA_WIDTH - 1;
+    state.scissor_y1 = AREA_HEIGHT - 1;
+
+    // A 32-bit texture with nearest sampling, in the page after the buffers.
+    state.tme = random() % 4 == 0;
+    state.fst = random() % 2;
+    state.tbp0 = 16 * 32;
+    state.tbw = 1;
+    state.tpsm = GsLocalMemory::PSMCT32;
+    state.tw = 3 + random() % 3;
+    state.th = 3 + random() % 3;
+    state.tcc = random() % 2;
+    state.tfx = random() % 4;
+    state.lcm = true;
+    state.wms = random() % 2;
+    state.wmt = random() % 2;
+    state.maxu = (1 << state.tw) - 1;
+    state.maxv = (1 << state.th) - 1;
+
+    state.fge = random() % 4 == 0;
+    state.fogcol = static_cast<uword>(random()) & 0xFFFFFF;
+
+    return state;
+}
+
+/// Returns a random span within the area, with colours and depths going
+/// somewhat out of range.
+GsPixelPipeline::Span make_random_span(const GsDrawState& state)
+{
+    using namespace GsPixelPipeline;
+
+    Span span{};
+    span.count = 1 + random() % 48;
+    span.x = random() % (AREA_WIDTH - span.count + 1);
+    span.y = random() % AREA_HEIGHT;
+
+    const bool flat = random() % 4 == 0;
+    for (int i = ATTR_R; i <= ATTR_F; i++)
+    {
+        span.values[i] = random_float(-16.0f, 272.0f);
+        span.steps[i] = flat ? 0.0f : random_float(-8.0f, 8.0f);
+    }
+
+    if (state.fst)
+    {
+        span.values[ATTR_S] = random_float(-64.0f, 64.0f);
+        span.values[ATTR_T] = random_float(-64.0f, 64.0f);
+        span.values[ATTR_Q] = 1.0f;
+    }
+    else
+    {
+        span.values[ATTR_S] = random_float(-2.0f, 2.0f);
+        span.values[ATTR_T] = random_float(-2.0f, 2.0f);
+        span.values[ATTR_Q] = random_float(0.5f, 2.0f);
+        span.steps[ATTR_Q] = random_float(-0.01f, 0.01f);
+    }
+    span.steps[ATTR_S] = random_float(-1.0f, 1.0f);
+    span.steps[ATTR_T] = random_float(-1.0f, 1.0f);
+
+    // Depths from below 0 to past the 32-bit maximum, and about the 24-bit maximum.
+    const double z_max = (random() % 2) ? 4294967295.0 : 16777215.0;
+    span.z = z_max * random_float(-0.1f, 1.1f);
+    span.z_step = flat ? 0.0 : z_max * random_float(-0.01f, 0.01f);
+    return span;
+}
+
+void print_state(const GsDrawState& state)
+{
+    std::printf("  FPSM = 0x%X, FBMSK = %08X, ZPSM = 0x%X, ZTE = %d, ZTST = %u, ZMSK = %d\n", state.fpsm, state.fbmsk, state.zpsm, state.zte, state.ztst, state.zmsk);
+    std::printf("  ATE = %d, ATST = %u, AREF = %u, AFAIL = %u, DATE = %d, DATM = %d\n", state.ate, state.atst, state.aref, state.afail, state.date, state.datm);
+    std::printf("  ABE = %d, A/B/C/D = %u/%u/%u/%u, FIX = %u, PABE = %d, COLCLAMP = %d, FBA = %d\n", state.abe, state.alpha_a, state.alpha_b, state.alpha_c, state.alpha_d, state.alpha_fix, state.pabe, state.colclamp, state.fba);
+    std::printf("  TME = %d, FST = %d, TFX = %u, TCC = %d, FGE = %d\n", state.tme, state.fst, state.tfx, state.tcc, state.fge);
+}
+
+void test_compiled_against_interpreted()
+{
+    static GsLocalMemory initial, interpreted, compiled;
+    std::vector<ubyte> random_memory(TEST_MEMORY_SIZE);
+
+    GsPixelPipelineCompiler compiler;
+    size_t number_compiled_states = 0;
+
+    for (size_t i = 0; i < NUMBER_RANDOM_STATES; i++)
+    {
+        const GsDrawState state = make_random_state();
+        if (compiler.is_full())
+            compiler.reset();
+        const GsPixelPipeline::SpanFunction function = compiler.get_span_function(state);
+        if (function == &GsPixelPipeline::shade_span)
+            continue;
+        number_compiled_states++;
+
+        // New memory every so often, otherwise carry on from the last state
+        // so the buffers see values written by the pipeline too.
+        if (i % 16 == 0)
+        {
+            for (auto& byte : random_memory)
+                byte = static_cast<ubyte>(random());
+            std::memcpy(initial.get_memory(), random_memory.data(), TEST_MEMORY_SIZE);
+        }
+        std::memcpy(interpreted.get_memory(), initial.get_memory(), TEST_MEMORY_SIZE);
+        std::memcpy(compiled.get_memory(), initial.get_memory(), TEST_MEMORY_SIZE);
+
+        for (size_t j = 0; j < NUMBER_SPANS_PER_STATE; j++)
+        {
+            const GsPixelPipeline::Span span = make_random_span(state);
+            GsPixelPipeline::shade_span(interpreted, state, span);
+            function(compiled, state, span);
+        }
+
+        number_checks++;
+        if (std::memcmp(interpreted.get_memory(), compiled.get_memory(), TEST_MEMORY_SIZE) != 0)
+        {
+            if (number_failures++ < 20)
+            {
+                std::printf("State %zu: compiled and interpreted results differ.\n", i);
+                print_state(state);
+                size_t reported = 0;
+                for (size_t k = 0; (k < TEST_MEMORY_SIZE / 4) && (reported < 4); k++)
+                {
+                    if (interpreted.words()[k] != compiled.words()[k])
+                    {
+                        std::printf("  word 0x%zX: compiled = %08X, interpreted = %08X\n", k, compiled.words()[k], interpreted.words()[k]);
+                        reported++;
+                    }
+                }
+            }
+        }
+        std::memcpy(initial.get_memory(), interpreted.get_memory(), TEST_MEMORY_SIZE);
+    }
+
+    // Most of the states are supported, so this would only be low if the
+    // compiler wasn't available.
+    number_checks++;
+    if (number_compiled_states < NUMBER_RANDOM_STATES / 2)
+    {
+        number_failures++;
+        std::printf("Only %zu of %zu states were compiled.\n", number_compiled_states, NUMBER_RANDOM_STATES);
+    }
+}
+
+/// 16-bit frame and Z buffers are left to the interpreter.
+void test_unsupported_states()
+{
+    GsPixelPipelineCompiler compiler;
+    GsDrawState state{};
+    state.fpsm = GsLocalMemory::PSMCT16;
+    number_checks++;
+    if (compiler.get_span_function(state) != &GsPixelPipeline::shade_span)
+    {
+        number_failures++;
+        std::printf("PSMCT16 frame: compiled, expected the interpreter.\n");
+    }
+
+    state.fpsm = GsLocalMemory::PSMCT32;
+    state.zte = true;
+    state.zpsm = GsLocalMemory::PSMZ16;
+    number_checks++;
+    if (compiler.get_span_function(state) != &GsPixelPipeline::shade_span)
+    {
+        number_failures++;
+        std::printf("PSMZ16 Z buffer: compiled, expected the interpreter.\n");
+    }
+}
+} // namespace
+
+int main()
+{
+    test_compiled_against_interpreted();
+    test_unsupported_states();
+
+    std::printf("GsPixelPipeline: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Common/Types/Primitive.hpp"
+
+/// The GsSwizzle block routines (see Resources/Gs/GsSwizzle.hpp), as built
+/// for each host.
+#define GS_SWIZZLE_DECLARE_KERNELS                                                             \
+    void write_block_32(uword* block, const ubyte* rows, const size_t pitch, const uword mask); \
+    void read_block_32(const uword* block, ubyte* rows, const size_t pitch);                    \
+    void write_block_16(uhword* block, const ubyte* rows, const size_t pitch);                  \
+    void read_block_16(const uhword* block, ubyte* rows, const size_t pitch);
+
+/// The block routines as built for SSE2 hosts (see GsSwizzleKernelsSse2.cpp).
+namespace GsSwizzleSse2
+{
+GS_SWIZZLE_DECLARE_KERNELS
+}
+
+/// The block routines as built for other hosts (see GsSwizzleKernelsScalar.cpp).
+namespace GsSwizzleScalar
+{
+GS_SWIZZLE_DECLARE_KERNELS
+}
@@ -0,0 +1,41 @@
+// Defines the block routines declared in GsSwizzleKernels.hpp in the
+// namespace GS_SWIZZLE_KERNELS_NAMESPACE, using GsSwizzle as configured by
+// the including translation unit (see Common/Simd.hpp). GsSwizzle is
+// included into an unnamed namespace, so the SSE2 and scalar builds of its
+// inline functions don't clash at link time.
+
+#include <cstddef>
+#include <cstring>
+
+#include "Common/Simd.hpp"
+#include "Common/Types/Primitive.hpp"
+
+#include "GsSwizzleKernels.hpp"
+
+namespace
+{
+#include "Resources/Gs/GsSwizzle.hpp"
+}
+
+namespace GS_SWIZZLE_KERNELS_NAMESPACE
+{
+void write_block_32(uword* block, const ubyte* rows, const size_t pitch, const uword mask)
+{
+    GsSwizzle::write_block_32(block, rows, pitch, mask);
+}
+
+void read_block_32(const uword* block, ubyte* rows, const size_t pitch)
+{
+    GsSwizzle::read_block_32(block, rows, pitch);
+}
+
+void write_block_16(uhword* block, const ubyte* rows, const size_t pitch)
+{
+    GsSwizzle::write_block_16(block, rows, pitch);
+}
+
+void read_block_16(const uhword* block, ubyte* rows, const size_t pitch)
+{
+    GsSwizzle::read_block_16(block, rows, pitch);
+}
+} // namespace GS_SWIZZLE_KERNELS_NAMESPACE
@@ -0,0 +1,3 @@
+#define SIMD_SCALAR
+#define GS_SWIZZLE_KERNELS_NAMESPACE GsSwizzleScalar
+#include "GsSwizzleKernels.inl"
@@ -0,0 +1,6 @@
+#define GS_SWIZZLE_KERNELS_NAMESPACE GsSwizzleSse2
+#include "GsSwizzleKernels.inl"
+
+#if !defined(SIMD_SSE2)
+#error "The SSE2 kernels are not available on this host."
+#endif
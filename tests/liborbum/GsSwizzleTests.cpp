@@ -0,0 +1,506 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Resources/Gs/GsLocalMemory.hpp"
+#include "Resources/Gs/GsSwizzle.hpp"
+
+#include "GsSwizzleKernels.hpp"
+
+/// Checks the GS local memory arrangements and transfers:
+///  - The SSE2 build of the GsSwizzle block routines against the scalar
+///    build, and both against the page tables, for the full word and the
+///    24-bit and 8H/4HL/4HH masked merges.
+///  - The page tables against the column arrangements and a few fixed
+///    addresses of the block and page arrangements, taken from the GS Users
+///    Manual (page 150 onwards) rather than the code which generates them.
+///  - GsLocalMemory::write_pixels()/read_pixels() against transferring each
+///    pixel on its own, for all of the pixel storage formats, with aligned,
+///    odd sized, page edge and wrapping rectangles. The formats sharing a
+///    word with other pixels must leave the bits outside of their own alone.
+
+namespace
+{
+/// Number of randomised block routine runs, and transfer rectangles per format.
+constexpr size_t NUMBER_RANDOM_BLOCKS = 2000;
+constexpr size_t NUMBER_RANDOM_RECTANGLES = 24;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+void fill_random(void* data, const size_t size)
+{
+    ubyte* bytes = static_cast<ubyte*>(data);
+    for (size_t i = 0; i < size; i++)
+        bytes[i] = static_cast<ubyte>(random());
+}
+
+/// Records the check, printing the message on the first few failures.
+template <typename... Args>
+void check(const bool is_ok, const char* format, Args... args)
+{
+    number_checks++;
+    if (is_ok)
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf(format, args...);
+        std::printf("\n");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Block routines.
+
+/// Masks of the formats using the 32-bit layout (32, 24, 8H, 4HL and 4HH).
+const uword MASKS_32[] = {0xFFFFFFFF, 0x00FFFFFF, 0xFF000000, 0x0F000000, 0xF0000000};
+
+void test_block_32()
+{
+    for (size_t i = 0; i < NUMBER_RANDOM_BLOCKS; i++)
+    {
+        // Rows are at least 32 bytes, and not necessarily aligned.
+        const size_t pitch = 32 + random() % 24;
+        const size_t offset = random() % 16;
+        std::vector<ubyte> rows(offset + 8 * pitch);
+        fill_random(rows.data(), rows.size());
+        uword initial[64];
+        fill_random(initial, sizeof(initial));
+
+        for (const uword mask : MASKS_32)
+        {
+            uword sse2[64], scalar[64], expected[64];
+            std::memcpy(sse2, initial, sizeof(initial));
+            std::memcpy(scalar, initial, sizeof(initial));
+            std::memcpy(expected, initial, sizeof(initial));
+            GsSwizzleSse2::write_block_32(sse2, rows.data() + offset, pitch, mask);
+            GsSwizzleScalar::write_block_32(scalar, rows.data() + offset, pitch, mask);
+            for (uword y = 0; y < 8; y++)
+            {
+                for (uword x = 0; x < 8; x++)
+                {
+                    uword value;
+                    std::memcpy(&value, rows.data() + offset + y * pitch + x * 4, 4);
+                    uword& word = expected[GsSwizzle::PAGE_TABLE_32.offsets[y][x]];
+                    word = (word & ~mask) | (value & mask);
+                }
+            }
+            check(std::memcmp(sse2, scalar, sizeof(sse2)) == 0, "write_block_32 (mask = %08X): SSE2 and scalar results differ.", mask);
+            check(std::memcmp(scalar, expected, sizeof(scalar)) == 0, "write_block_32 (mask = %08X): differs from the page table.", mask);
+        }
+
+        // Reading leaves the row padding alone.
+        std::vector<ubyte> sse2 = rows, scalar = rows, expected = rows;
+        GsSwizzleSse2::read_block_32(initial, sse2.data() + offset, pitch);
+        GsSwizzleScalar::read_block_32(initial, scalar.data() + offset, pitch);
+        for (uword y = 0; y < 8; y++)
+            for (uword x = 0; x < 8; x++)
+                std::memcpy(expected.data() + offset + y * pitch + x * 4, &initial[GsSwizzle::PAGE_TABLE_32.offsets[y][x]], 4);
+        check(sse2 == scalar, "read_block_32: SSE2 and scalar results differ.");
+        check(scalar == expected, "read_block_32: differs from the page table.");
+    }
+}
+
+void test_block_16()
+{
+    for (size_t i = 0; i < NUMBER_RANDOM_BLOCKS; i++)
+    {
+        const size_t pitch = 32 + random() % 24;
+        const size_t offset = random() % 16;
+        std::vector<ubyte> rows(offset + 8 * pitch);
+        fill_random(rows.data(), rows.size());
+        uhword initial[128];
+        fill_random(initial, sizeof(initial));
+
+        uhword sse2[128], scalar[128], expected[128];
+        std::memcpy(sse2, initial, sizeof(initial));
+        std::memcpy(scalar, initial, sizeof(initial));
+        GsSwizzleSse2::write_block_16(sse2, rows.data() + offset, pitch);
+        GsSwizzleScalar::write_block_16(scalar, rows.data() + offset, pitch);
+        for (uword y = 0; y < 8; y++)
+            for (uword x = 0; x < 16; x++)
+                std::memcpy(&expected[GsSwizzle::PAGE_TABLE_16.offsets[y][x]], rows.data() + offset + y * pitch + x * 2, 2);
+        check(std::memcmp(sse2, scalar, sizeof(sse2)) == 0, "write_block_16: SSE2 and scalar results differ.");
+        check(std::memcmp(scalar, expected, sizeof(scalar)) == 0, "write_block_16: differs from the page table.");
+
+        std::vector<ubyte> sse2_rows = rows, scalar_rows = rows, expected_rows = rows;
+        GsSwizzleSse2::read_block_16(initial, sse2_rows.data() + offset, pitch);
+        GsSwizzleScalar::read_block_16(initial, scalar_rows.data() + offset, pitch);
+        for (uword y = 0; y < 8; y++)
+            for (uword x = 0; x < 16; x++)
+                std::memcpy(expected_rows.data() + offset + y * pitch + x * 2, &initial[GsSwizzle::PAGE_TABLE_16.offsets[y][x]], 2);
+        check(sse2_rows == scalar_rows, "read_block_16: SSE2 and scalar results differ.");
+        check(scalar_rows == expected_rows, "read_block_16: differs from the page table.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Arrangements from the GS Users Manual.
+
+/// Pixel address within a column (in units of the pixel size), indexed by
+/// the pixel row and column within the column. The 8-bit and 4-bit layouts
+/// alternate between 2 arrangements for even and odd columns.
+constexpr uword COLUMN_32[2][8] =
+    {
+        {0, 1, 4, 5, 8, 9, 12, 13},
+        {2, 3, 6, 7, 10, 11, 14, 15}};
+
+constexpr uword COLUMN_16[2][16] =
+    {
+        {0, 2, 8, 10, 16, 18, 24, 26, 1, 3, 9, 11, 17, 19, 25, 27},
+        {4, 6, 12, 14, 20, 22, 28, 30, 5, 7, 13, 15, 21, 23, 29, 31}};
+
+constexpr uword COLUMN_8[2][4][16] =
+    {
+        {
+            {0, 4, 16, 20, 32, 36, 48, 52, 2, 6, 18, 22, 34, 38, 50, 54},
+            {8, 12, 24, 28, 40, 44, 56, 60, 10, 14, 26, 30, 42, 46, 58, 62},
+            {33, 37, 49, 53, 1, 5, 17, 21, 35, 39, 51, 55, 3, 7, 19, 23},
+            {41, 45, 57, 61, 9, 13, 25, 29, 43, 47, 59, 63, 11, 15, 27, 31},
+        },
+        {
+            {32, 36, 48, 52, 0, 4, 16, 20, 34, 38, 50, 54, 2, 6, 18, 22},
+            {40, 44, 56, 60, 8, 12, 24, 28, 42, 46, 58, 62, 10, 14, 26, 30},
+            {1, 5, 17, 21, 33, 37, 49, 53, 3, 7, 19, 23, 35, 39, 51, 55},
+            {9, 13, 25, 29, 41, 45, 57, 61, 11, 15, 27, 31, 43, 47, 59, 63},
+        }};
+
+constexpr uword COLUMN_4[2][4][32] =
+    {
+        {
+            {0, 8, 32, 40, 64, 72, 96, 104, 2, 10, 34, 42, 66, 74, 98, 106, 4, 12, 36, 44, 68, 76, 100, 108, 6, 14, 38, 46, 70, 78, 102, 110},
+            {16, 24, 48, 56, 80, 88, 112, 120, 18, 26, 50, 58, 82, 90, 114, 122, 20, 28, 52, 60, 84, 92, 116, 124, 22, 30, 54, 62, 86, 94, 118, 126},
+            {65, 73, 97, 105, 1, 9, 33, 41, 67, 75, 99, 107, 3, 11, 35, 43, 69, 77, 101, 109, 5, 13, 37, 45, 71, 79, 103, 111, 7, 15, 39, 47},
+            {81, 89, 113, 121, 17, 25, 49, 57, 83, 91, 115, 123, 19, 27, 51, 59, 85, 93, 117, 125, 21, 29, 53, 61, 87, 95, 119, 127, 23, 31, 55, 63},
+        },
+        {
+            {64, 72, 96, 104, 0, 8, 32, 40, 66, 74, 98, 106, 2, 10, 34, 42, 68, 76, 100, 108, 4, 12, 36, 44, 70, 78, 102, 110, 6, 14, 38, 46},
+            {80, 88, 112, 120, 16, 24, 48, 56, 82, 90, 114, 122, 18, 26, 50, 58, 84, 92, 116, 124, 20, 28, 52, 60, 86, 94, 118, 126, 22, 30, 54, 62},
+            {1, 9, 33, 41, 65, 73, 97, 105, 3, 11, 35, 43, 67, 75, 99, 107, 5, 13, 37, 45, 69, 77, 101, 109, 7, 15, 39, 47, 71, 79, 103, 111},
+            {17, 25, 49, 57, 81, 89, 113, 121, 19, 27, 51, 59, 83, 91, 115, 123, 21, 29, 53, 61, 85, 93, 117, 125, 23, 31, 55, 63, 87, 95, 119, 127},
+        }};
+
+/// Checks the first block of each page table against the column
+/// arrangements (4 columns per block, one after the other).
+void test_column_arrangements()
+{
+    for (uword y = 0; y < 8; y++)
+    {
+        for (uword x = 0; x < 8; x++)
+        {
+            const uword expected = (y >> 1) * 16 + COLUMN_32[y & 0x1][x];
+            check(GsSwizzle::PAGE_TABLE_32.offsets[y][x] == expected, "PSMCT32 (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_32.offsets[y][x], expected);
+            check(GsSwizzle::PAGE_TABLE_32Z.offsets[y][x] == 24 * 64 + expected, "PSMZ32 (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_32Z.offsets[y][x], 24 * 64 + expected);
+        }
+    }
+
+    for (uword y = 0; y < 8; y++)
+    {
+        for (uword x = 0; x < 16; x++)
+        {
+            const uword expected = (y >> 1) * 32 + COLUMN_16[y & 0x1][x];
+            check(GsSwizzle::PAGE_TABLE_16.offsets[y][x] == expected, "PSMCT16 (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_16.offsets[y][x], expected);
+            check(GsSwizzle::PAGE_TABLE_16S.offsets[y][x] == expected, "PSMCT16S (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_16S.offsets[y][x], expected);
+        }
+    }
+
+    for (uword y = 0; y < 16; y++)
+    {
+        for (uword x = 0; x < 16; x++)
+        {
+            const uword column = y >> 2;
+            const uword expected = column * 64 + COLUMN_8[column & 0x1][y & 0x3][x];
+            check(GsSwizzle::PAGE_TABLE_8.offsets[y][x] == expected, "PSMT8 (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_8.offsets[y][x], expected);
+        }
+    }
+
+    for (uword y = 0; y < 16; y++)
+    {
+        for (uword x = 0; x < 32; x++)
+        {
+            const uword column = y >> 2;
+            const uword expected = column * 128 + COLUMN_4[column & 0x1][y & 0x3][x];
+            check(GsSwizzle::PAGE_TABLE_4.offsets[y][x] == expected, "PSMT4 (%u, %u): address %u, expected %u.", x, y, GsSwizzle::PAGE_TABLE_4.offsets[y][x], expected);
+        }
+    }
+}
+
+/// A pixel address, in units of the pixel size.
+struct Address
+{
+    const char* name;
+    uword address;
+    uword expected;
+};
+
+/// Checks fixed addresses of the block and page arrangements, worked out by
+/// hand from the block numbers in the manual (64 words, 128 hwords, 256 bytes
+/// or 512 nibbles per block, 32 blocks per page).
+void test_fixed_addresses()
+{
+    const auto& table_16 = GsSwizzle::PAGE_TABLE_16;
+    const auto& table_16s = GsSwizzle::PAGE_TABLE_16S;
+    const auto& table_16z = GsSwizzle::PAGE_TABLE_16Z;
+    const auto& table_16sz = GsSwizzle::PAGE_TABLE_16SZ;
+
+    const Address addresses[] = {
+        // PSMCT32: blocks 1, 2 and 31, the last pixel of the page, then pages 1 and 2 of a 2 page wide buffer at block 32.
+        {"PSMCT32 (8, 0)", GsLocalMemory::address_32(0, 1, 8, 0), 64},
+        {"PSMCT32 (0, 8)", GsLocalMemory::address_32(0, 1, 0, 8), 128},
+        {"PSMCT32 (56, 24)", GsLocalMemory::address_32(0, 1, 56, 24), 31 * 64},
+        {"PSMCT32 (63, 31)", GsLocalMemory::address_32(0, 1, 63, 31), 2047},
+        {"PSMCT32 BP 32 (64, 0)", GsLocalMemory::address_32(32, 2, 64, 0), 2048 + 2048},
+        {"PSMCT32 BP 32 (0, 32)", GsLocalMemory::address_32(32, 2, 0, 32), 2048 + 2 * 2048},
+
+        // PSMZ32: blocks 24 and 25 come first.
+        {"PSMZ32 (0, 0)", GsLocalMemory::address_32z(0, 1, 0, 0), 24 * 64},
+        {"PSMZ32 (8, 0)", GsLocalMemory::address_32z(0, 1, 8, 0), 25 * 64},
+        {"PSMZ32 (32, 0)", GsLocalMemory::address_32z(0, 1, 32, 0), 8 * 64},
+
+        // PSMCT16/16S/Z16/Z16S: blocks run down before across.
+        {"PSMCT16 (8, 0)", GsLocalMemory::address_16(table_16, 0, 1, 8, 0), 1},
+        {"PSMCT16 (0, 8)", GsLocalMemory::address_16(table_16, 0, 1, 0, 8), 128},
+        {"PSMCT16 (16, 0)", GsLocalMemory::address_16(table_16, 0, 1, 16, 0), 2 * 128},
+        {"PSMCT16 (48, 56)", GsLocalMemory::address_16(table_16, 0, 1, 48, 56), 31 * 128},
+        {"PSMCT16 (0, 64)", GsLocalMemory::address_16(table_16, 0, 1, 0, 64), 4096},
+        {"PSMCT16S (16, 8)", GsLocalMemory::address_16(table_16s, 0, 1, 16, 8), 3 * 128},
+        {"PSMCT16S (0, 32)", GsLocalMemory::address_16(table_16s, 0, 1, 0, 32), 4 * 128},
+        {"PSMCT16S (32, 0)", GsLocalMemory::address_16(table_16s, 0, 1, 32, 0), 16 * 128},
+        {"PSMZ16 (0, 0)", GsLocalMemory::address_16(table_16z, 0, 1, 0, 0), 24 * 128},
+        {"PSMZ16 (32, 32)", GsLocalMemory::address_16(table_16z, 0, 1, 32, 32), 0},
+        {"PSMZ16S (32, 0)", GsLocalMemory::address_16(table_16sz, 0, 1, 32, 0), 8 * 128},
+        {"PSMZ16S (32, 16)", GsLocalMemory::address_16(table_16sz, 0, 1, 32, 16), 0},
+
+        // PSMT8: 2 buffer width units per page.
+        {"PSMT8 (0, 2)", GsLocalMemory::address_8(0, 2, 0, 2), 33},
+        {"PSMT8 (4, 2)", GsLocalMemory::address_8(0, 2, 4, 2), 1},
+        {"PSMT8 (16, 0)", GsLocalMemory::address_8(0, 2, 16, 0), 256},
+        {"PSMT8 (0, 16)", GsLocalMemory::address_8(0, 2, 0, 16), 2 * 256},
+        {"PSMT8 (112, 48)", GsLocalMemory::address_8(0, 2, 112, 48), 31 * 256},
+        {"PSMT8 (0, 64)", GsLocalMemory::address_8(0, 2, 0, 64), 8192},
+        {"PSMT8 (128, 0)", GsLocalMemory::address_8(0, 4, 128, 0), 8192},
+
+        // PSMT4.
+        {"PSMT4 (0, 2)", GsLocalMemory::address_4(0, 2, 0, 2), 65},
+        {"PSMT4 (8, 0)", GsLocalMemory::address_4(0, 2, 8, 0), 2},
+        {"PSMT4 (0, 16)", GsLocalMemory::address_4(0, 2, 0, 16), 512},
+        {"PSMT4 (32, 0)", GsLocalMemory::address_4(0, 2, 32, 0), 2 * 512},
+        {"PSMT4 (96, 112)", GsLocalMemory::address_4(0, 2, 96, 112), 31 * 512},
+        {"PSMT4 (0, 128)", GsLocalMemory::address_4(0, 2, 0, 128), 16384},
+
+        // Addresses wrap around the end of memory.
+        {"PSMCT32 BP 16383 (8, 0)", GsLocalMemory::address_32(16383, 1, 8, 0), 0},
+    };
+
+    for (const Address& address : addresses)
+        check(address.address == address.expected, "%s: address %u, expected %u.", address.name, address.address, address.expected);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Transfers.
+
+struct Format
+{
+    const char* name;
+    uword psm;
+    uword page_width;
+    uword page_height;
+
+    /// Bits of each word written by the format (0 if not a 32-bit layout format).
+    uword mask;
+};
+
+const Format FORMATS[] = {
+    {"PSMCT32", GsLocalMemory::PSMCT32, 64, 32, 0xFFFFFFFF},
+    {"PSMCT24", GsLocalMemory::PSMCT24, 64, 32, 0x00FFFFFF},
+    {"PSMCT16", GsLocalMemory::PSMCT16, 64, 64, 0},
+    {"PSMCT16S", GsLocalMemory::PSMCT16S, 64, 64, 0},
+    {"PSMT8", GsLocalMemory::PSMT8, 128, 64, 0},
+    {"PSMT4", GsLocalMemory::PSMT4, 128, 128, 0},
+    {"PSMT8H", GsLocalMemory::PSMT8H, 64, 32, 0xFF000000},
+    {"PSMT4HL", GsLocalMemory::PSMT4HL, 64, 32, 0x0F000000},
+    {"PSMT4HH", GsLocalMemory::PSMT4HH, 64, 32, 0xF0000000},
+    {"PSMZ32", GsLocalMemory::PSMZ32, 64, 32, 0xFFFFFFFF},
+    {"PSMZ24", GsLocalMemory::PSMZ24, 64, 32, 0x00FFFFFF},
+    {"PSMZ16", GsLocalMemory::PSMZ16, 64, 64, 0},
+    {"PSMZ16S", GsLocalMemory::PSMZ16S, 64, 64, 0},
+};
+
+struct Rectangle
+{
+    uword bp;
+    uword bw;
+    uword x;
+    uword y;
+    uword width;
+    uword height;
+};
+
+/// Returns the pixel at the index given of packed transfer data.
+uword get_transfer_pixel(const std::vector<ubyte>& data, const size_t index, const int bits)
+{
+    const size_t bit = index * bits;
+    uword value = 0;
+    for (int i = 0; i < bits; i += 4)
+        value |= ((data[(bit + i) >> 3] >> ((bit + i) & 0x7)) & 0xF) << i;
+    return value;
+}
+
+void set_transfer_pixel(std::vector<ubyte>& data, const size_t index, const int bits, const uword value)
+{
+    const size_t bit = index * bits;
+    for (int i = 0; i < bits; i += 4)
+    {
+        ubyte& byte = data[(bit + i) >> 3];
+        const int shift = (bit + i) & 0x7;
+        byte = static_cast<ubyte>((byte & ~(0xF << shift)) | (((value >> i) & 0xF) << shift));
+    }
+}
+
+/// Memory is compared word by word, to report the first few differences.
+void check_memory(const char* what, const Format& format, const Rectangle& r, GsLocalMemory& memory, GsLocalMemory& expected)
+{
+    const bool is_ok = std::memcmp(memory.get_memory(), expected.get_memory(), Constants::SIZE_4MB) == 0;
+    check(is_ok, "%s %s (BP = %u, BW = %u, %u, %u, %u x %u): memory differs.", format.name, what, r.bp, r.bw, r.x, r.y, r.width, r.height);
+    if (is_ok || (number_failures > 20))
+        return;
+
+    size_t reported = 0;
+    for (size_t i = 0; (i < GsLocalMemory::NUMBER_WORDS) && (reported < 4); i++)
+    {
+        if (memory.words()[i] != expected.words()[i])
+        {
+            std::printf("  word 0x%zX: %08X, expected %08X\n", i, memory.words()[i], expected.words()[i]);
+            reported++;
+        }
+    }
+}
+
+void test_transfer(const Format& format, const Rectangle& r, const std::vector<ubyte>& initial, GsLocalMemory& memory, GsLocalMemory& expected)
+{
+    const int bits = GsLocalMemory::transfer_bits_per_pixel(format.psm);
+    const size_t number_pixels = static_cast<size_t>(r.width) * r.height;
+    std::vector<ubyte> data((number_pixels * bits + 7) / 8);
+    fill_random(data.data(), data.size());
+
+    // Writing in bulk against pixel by pixel, in transmission order.
+    std::memcpy(memory.get_memory(), initial.data(), initial.size());
+    std::memcpy(expected.get_memory(), initial.data(), initial.size());
+    memory.write_pixels(format.psm, r.bp, r.bw, r.x, r.y, r.width, r.height, data.data());
+    for (uword row = 0; row < r.height; row++)
+        for (uword column = 0; column < r.width; column++)
+            expected.write_pixel(format.psm, r.bp, r.bw, (r.x + column) & 2047, (r.y + row) & 2047, get_transfer_pixel(data, static_cast<size_t>(row) * r.width + column, bits));
+    check_memory("write_pixels", format, r, memory, expected);
+
+    // The masked merges leave the rest of each word alone.
+    if (format.mask && (format.mask != 0xFFFFFFFF))
+    {
+        const uword* words = memory.words();
+        const uword* initial_words = reinterpret_cast<const uword*>(initial.data());
+        bool is_ok = true;
+        for (size_t i = 0; i < GsLocalMemory::NUMBER_WORDS; i++)
+            is_ok = is_ok && ((words[i] & ~format.mask) == (initial_words[i] & ~format.mask));
+        check(is_ok, "%s write_pixels (BP = %u, BW = %u, %u, %u, %u x %u): changed bits outside of the mask.", format.name, r.bp, r.bw, r.x, r.y, r.width, r.height);
+    }
+
+    // Reading in bulk against pixel by pixel, including any padding in the last byte.
+    std::vector<ubyte> read(data.size() + 1, 0xA5);
+    std::vector<ubyte> expected_read = read;
+    memory.read_pixels(format.psm, r.bp, r.bw, r.x, r.y, r.width, r.height, read.data());
+    for (uword row = 0; row < r.height; row++)
+        for (uword column = 0; column < r.width; column++)
+            set_transfer_pixel(expected_read, static_cast<size_t>(row) * r.width + column, bits, memory.read_pixel(format.psm, r.bp, r.bw, (r.x + column) & 2047, (r.y + row) & 2047));
+    check(read == expected_read, "%s read_pixels (BP = %u, BW = %u, %u, %u, %u x %u): data differs.", format.name, r.bp, r.bw, r.x, r.y, r.width, r.height);
+
+    // What was written reads back (the buffer doesn't overlap itself).
+    check(std::memcmp(read.data(), data.data(), (number_pixels * bits) / 8) == 0, "%s read_pixels (BP = %u, BW = %u, %u, %u, %u x %u): doesn't read back what was written.", format.name, r.bp, r.bw, r.x, r.y, r.width, r.height);
+}
+
+void test_transfers()
+{
+    std::vector<ubyte> initial(Constants::SIZE_4MB);
+    fill_random(initial.data(), initial.size());
+    static GsLocalMemory memory, expected;
+
+    for (const Format& format : FORMATS)
+    {
+        const uword w = format.page_width;
+        const uword h = format.page_height;
+
+        // The buffer width is in units of 64 pixels, which the 8-bit and
+        // 4-bit formats use in pairs (a page is 128 pixels wide).
+        const uword bw_step = w / 64;
+        std::vector<Rectangle> rectangles = {
+            {0, 2 * bw_step, 0, 0, w, h},                           // Exactly one page.
+            {0, 2 * bw_step, 0, 0, 2 * w, 2 * h},                   // 2 x 2 pages.
+            {100, 2 * bw_step, w - 3, h - 5, 7, 9},                 // Across the corner of 4 pages.
+            {100, 4 * bw_step, w - 40, h - 24, w + 11, h + 17},     // Page edges, with whole blocks in between.
+            {7, 2 * bw_step, 1, 3, 37, 19},                         // Odd width and height.
+            {7, 2 * bw_step, 5, 0, 1, h + 3},                       // A single column.
+            {7, 2 * bw_step, 0, 9, 2 * w, 1},                       // A single row.
+            {16383, 2 * bw_step, 0, 0, w, 8},                       // Wrapping around the end of memory.
+            {0, 32, 2048 - 24, 2048 - 20, 56, 40},                  // Wrapping around the transmission area.
+        };
+
+        for (size_t i = 0; i < NUMBER_RANDOM_RECTANGLES; i++)
+        {
+            Rectangle r;
+            r.bp = static_cast<uword>(random() % 16384);
+            r.bw = bw_step * (1 + static_cast<uword>(random() % 4));
+            r.width = 1 + static_cast<uword>(random() % (r.bw * 64));
+            r.height = 1 + static_cast<uword>(random() % 160);
+            r.x = static_cast<uword>(random() % (r.bw * 64 - r.width + 1));
+            r.y = static_cast<uword>(random() % 256);
+            rectangles.push_back(r);
+        }
+
+        for (const Rectangle& r : rectangles)
+            test_transfer(format, r, initial, memory, expected);
+    }
+}
+
+/// The H formats share the words of the 32-bit layout, at the same position.
+void test_masked_formats()
+{
+    static GsLocalMemory memory;
+    std::fill(memory.words(), memory.words() + GsLocalMemory::NUMBER_WORDS, 0x12345678);
+
+    memory.write_pixel(GsLocalMemory::PSMT8H, 0, 1, 8, 0, 0xAB);
+    check(memory.words()[64] == 0xAB345678, "PSMT8H (8, 0): word %08X, expected AB345678.", memory.words()[64]);
+    memory.write_pixel(GsLocalMemory::PSMT4HL, 0, 1, 1, 0, 0xC);
+    check(memory.words()[1] == 0x1C345678, "PSMT4HL (1, 0): word %08X, expected 1C345678.", memory.words()[1]);
+    memory.write_pixel(GsLocalMemory::PSMT4HH, 0, 1, 1, 0, 0xD);
+    check(memory.words()[1] == 0xDC345678, "PSMT4HH (1, 0): word %08X, expected DC345678.", memory.words()[1]);
+    memory.write_pixel(GsLocalMemory::PSMCT24, 0, 1, 1, 0, 0xFFEEDDCC);
+    check(memory.words()[1] == 0xDCEEDDCC, "PSMCT24 (1, 0): word %08X, expected DCEEDDCC.", memory.words()[1]);
+
+    check(memory.read_pixel(GsLocalMemory::PSMT4HL, 0, 1, 1, 0) == 0xC, "PSMT4HL (1, 0): read %X, expected C.", memory.read_pixel(GsLocalMemory::PSMT4HL, 0, 1, 1, 0));
+    check(memory.read_pixel(GsLocalMemory::PSMT4HH, 0, 1, 1, 0) == 0xD, "PSMT4HH (1, 0): read %X, expected D.", memory.read_pixel(GsLocalMemory::PSMT4HH, 0, 1, 1, 0));
+    check(memory.read_pixel(GsLocalMemory::PSMT8H, 0, 1, 1, 0) == 0xDC, "PSMT8H (1, 0): read %X, expected DC.", memory.read_pixel(GsLocalMemory::PSMT8H, 0, 1, 1, 0));
+}
+} // namespace
+
+int main()
+{
+    test_block_32();
+    test_block_16();
+    test_column_arrangements();
+    test_fixed_addresses();
+    test_masked_formats();
+    test_transfers();
+
+    std::printf("GsSwizzle: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
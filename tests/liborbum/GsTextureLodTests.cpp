@@ -0,0 +1,276 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "Controller/Gs/Core/GsDrawState.hpp"
+#include "Controller/Gs/Core/GsPixelPipeline.hpp"
+#include "Resources/Gs/GsLocalMemory.hpp"
+
+/// Checks the texture LOD calculation and the mipmap level and filter
+/// selection (see GsDrawState::get_lod() and GsPixelPipeline::filter_texture()),
+/// against known results worked out from the GS Users Manual (page 117):
+///  - LOD = K (LCM = 1), or K + log2(1/|Q|) * 2^L (LCM = 0).
+///  - LOD <= 0 uses MMAG on the base texture, otherwise MMIN, with the
+///    *_MIPMAP_NEAREST filters rounding to the nearest level, the
+///    *_MIPMAP_LINEAR filters blending the 2 nearest levels, and the LOD
+///    limited to MXL.
+///  - Each level halves the texture size and the texel coordinates, and the
+///    REGION_CLAMP bounds.
+///  - Pixels of a span select their levels by their own Q.
+/// The levels are filled with a different solid colour each, except where
+/// the texels within a level are checked.
+
+namespace
+{
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// Base texture size (log2), and the number of mipmap levels set up.
+constexpr uword TW = 6;
+constexpr uword TH = 6;
+constexpr int NUMBER_LEVELS = 1 + GsDrawState::MAX_MIPMAP_LEVEL;
+
+/// Solid colour of each level: each component is 0x10 * (level + 1), apart
+/// from the alpha which is 0x80.
+uword level_colour(const int level)
+{
+    const uword c = 0x10 * static_cast<uword>(level + 1);
+    return c | (c << 8) | (c << 16) | 0x80000000;
+}
+
+/// Level colour blended towards the next level by f / 256.
+uword blended_colour(const int level, const int f)
+{
+    const int c0 = 0x10 * (level + 1);
+    const int c1 = 0x10 * (level + 2);
+    const uword c = static_cast<uword>((c0 * 256 + (c1 - c0) * f) >> 8);
+    return c | (c << 8) | (c << 16) | 0x80000000;
+}
+
+void check_expected(const char* name, const uword result, const uword expected)
+{
+    number_checks++;
+    if (result == expected)
+        return;
+
+    number_failures++;
+    std::printf("%s: result = %08X, expected = %08X\n", name, result, expected);
+}
+
+void check_expected_lod(const char* name, const float result, const float expected)
+{
+    number_checks++;
+    if (result == expected)
+        return;
+
+    number_failures++;
+    std::printf("%s: LOD = %f, expected = %f\n", name, result, expected);
+}
+
+/// A 32-bit 64x64 texture, with levels 1 -> 6 in the pages after it.
+GsDrawState make_state()
+{
+    GsDrawState state{};
+    state.tme = true;
+    state.tbp0 = 0;
+    state.tbw = 1;
+    state.tpsm = GsLocalMemory::PSMCT32;
+    state.tw = TW;
+    state.th = TH;
+    state.tcc = true;
+    state.tfx = 1; // DECAL, so the pixel colour is the texel.
+    state.lcm = true;
+    state.mxl = GsDrawState::MAX_MIPMAP_LEVEL;
+    for (int level = 1; level < NUMBER_LEVELS; level++)
+    {
+        state.mip_tbp[level - 1] = 64 * static_cast<uword>(level);
+        state.mip_tbw[level - 1] = 1;
+    }
+    state.wms = 1; // CLAMP.
+    state.wmt = 1;
+    return state;
+}
+
+void fill_levels(GsLocalMemory& memory, const GsDrawState& state)
+{
+    for (int level = 0; level < NUMBER_LEVELS; level++)
+    {
+        const GsPixelPipeline::TextureLevel texture = GsPixelPipeline::get_texture_level(state, level);
+        for (uword v = 0; v < (1u << texture.th); v++)
+            for (uword u = 0; u < (1u << texture.tw); u++)
+                memory.write_pixel(state.tpsm, texture.tbp, texture.tbw, u, v, level_colour(level));
+    }
+}
+
+void test_lod()
+{
+    GsDrawState state{};
+    state.lcm = true;
+    state.k = 2.5f;
+    check_expected_lod("LCM = 1", state.get_lod(0.125f), 2.5f);
+
+    state.lcm = false;
+    state.k = 0.0f;
+    state.l = 0;
+    check_expected_lod("Q = 1", state.get_lod(1.0f), 0.0f);
+    check_expected_lod("Q = 0.25", state.get_lod(0.25f), 2.0f);
+    check_expected_lod("Q = -0.25", state.get_lod(-0.25f), 2.0f);
+    check_expected_lod("Q = 4", state.get_lod(4.0f), -2.0f);
+    check_expected_lod("Q = 0", state.get_lod(0.0f), 0.0f);
+
+    state.l = 2;
+    check_expected_lod("Q = 0.5, L = 2", state.get_lod(0.5f), 4.0f);
+
+    state.k = -1.5f;
+    check_expected_lod("Q = 0.5, L = 2, K = -1.5", state.get_lod(0.5f), 2.5f);
+}
+
+void test_levels()
+{
+    GsDrawState state = make_state();
+
+    const GsPixelPipeline::TextureLevel base = GsPixelPipeline::get_texture_level(state, 0);
+    check_expected("level 0 TBP", base.tbp, 0);
+    check_expected("level 0 TW", base.tw, TW);
+
+    const GsPixelPipeline::TextureLevel level_3 = GsPixelPipeline::get_texture_level(state, 3);
+    check_expected("level 3 TBP", level_3.tbp, 64 * 3);
+    check_expected("level 3 TW", level_3.tw, TW - 3);
+    check_expected("level 3 TH", level_3.th, TH - 3);
+
+    // Levels don't go below 1x1.
+    state.tw = 2;
+    const GsPixelPipeline::TextureLevel level_4 = GsPixelPipeline::get_texture_level(state, 4);
+    check_expected("level 4 of 4x64 TW", level_4.tw, 0);
+    check_expected("level 4 of 4x64 TH", level_4.th, TH - 4);
+}
+
+/// A filter and LOD, and the expected result.
+struct Case
+{
+    const char* name;
+    uword mmin;
+    bool mmag_linear;
+    uword mxl;
+    float lod;
+    uword expected;
+};
+
+void test_filter_selection()
+{
+    static GsLocalMemory memory;
+    const GsDrawState initial = make_state();
+    fill_levels(memory, initial);
+
+    const Case cases[] = {
+        // LOD <= 0 magnifies the base texture, whichever MMIN.
+        {"MMAG nearest, LOD 0", 2, false, 6, 0.0f, level_colour(0)},
+        {"MMAG linear, LOD -2", 5, true, 6, -2.0f, level_colour(0)},
+
+        // NEAREST and LINEAR always use the base texture.
+        {"NEAREST, LOD 3", 0, false, 6, 3.0f, level_colour(0)},
+        {"LINEAR, LOD 3", 1, false, 6, 3.0f, level_colour(0)},
+
+        // *_MIPMAP_NEAREST rounds to the nearest level.
+        {"NEAREST_MIPMAP_NEAREST, LOD 0.4", 2, false, 6, 0.4f, level_colour(0)},
+        {"NEAREST_MIPMAP_NEAREST, LOD 0.6", 2, false, 6, 0.6f, level_colour(1)},
+        {"NEAREST_MIPMAP_NEAREST, LOD 1.5", 2, false, 6, 1.5f, level_colour(2)},
+        {"NEAREST_MIPMAP_NEAREST, LOD 2.49", 2, false, 6, 2.49f, level_colour(2)},
+        {"LINEAR_MIPMAP_NEAREST, LOD 5.8", 4, false, 6, 5.8f, level_colour(6)},
+
+        // *_MIPMAP_LINEAR blends the 2 nearest levels by the LOD fraction.
+        {"NEAREST_MIPMAP_LINEAR, LOD 1", 3, false, 6, 1.0f, level_colour(1)},
+        {"NEAREST_MIPMAP_LINEAR, LOD 1.5", 3, false, 6, 1.5f, blended_colour(1, 128)},
+        {"NEAREST_MIPMAP_LINEAR, LOD 0.25", 3, false, 6, 0.25f, blended_colour(0, 64)},
+        {"LINEAR_MIPMAP_LINEAR, LOD 4.75", 5, false, 6, 4.75f, blended_colour(4, 192)},
+
+        // The LOD is limited to MXL, and there are no mipmaps with MXL = 0.
+        {"NEAREST_MIPMAP_NEAREST, LOD 10, MXL 3", 2, false, 3, 10.0f, level_colour(3)},
+        {"NEAREST_MIPMAP_LINEAR, LOD 3.7, MXL 3", 3, false, 3, 3.7f, level_colour(3)},
+        {"NEAREST_MIPMAP_NEAREST, LOD 2, MXL 0", 2, false, 0, 2.0f, level_colour(0)},
+
+        // Reserved MMIN values use the base texture.
+        {"MMIN 6, LOD 2", 6, false, 6, 2.0f, level_colour(0)},
+    };
+
+    for (const Case& c : cases)
+    {
+        GsDrawState state = initial;
+        state.mmin = c.mmin;
+        state.mmag_linear = c.mmag_linear;
+        state.mxl = c.mxl;
+
+        // Sampled away from the edges, so bilinear filtering sees the same colour.
+        check_expected(c.name, GsPixelPipeline::filter_texture(memory, state, 20.0f, 28.0f, c.lod), c.expected);
+    }
+}
+
+/// Texel coordinates (of the base texture) are scaled down to the level.
+void test_level_coordinates()
+{
+    static GsLocalMemory memory;
+    GsDrawState state = make_state();
+
+    // Each texel of level 1 holds its coordinates.
+    const GsPixelPipeline::TextureLevel level_1 = GsPixelPipeline::get_texture_level(state, 1);
+    for (uword v = 0; v < (1u << level_1.th); v++)
+        for (uword u = 0; u < (1u << level_1.tw); u++)
+            memory.write_pixel(state.tpsm, level_1.tbp, level_1.tbw, u, v, u | (v << 8));
+
+    state.mmin = 2;
+    check_expected("level 1 texel of (20, 42)", GsPixelPipeline::filter_texture(memory, state, 20.0f, 42.0f, 1.0f), 10 | (21 << 8));
+    check_expected("level 1 texel of (63, 1)", GsPixelPipeline::filter_texture(memory, state, 63.0f, 1.0f, 1.0f), 31 | (0 << 8));
+
+    // REGION_CLAMP bounds are given for the base texture.
+    state.wms = 2;
+    state.minu = 8;
+    state.maxu = 15;
+    state.wmt = 2;
+    state.minv = 16;
+    state.maxv = 47;
+    check_expected("level 1 REGION_CLAMP of (40, 0)", GsPixelPipeline::filter_texture(memory, state, 40.0f, 0.0f, 1.0f), 7 | (8 << 8));
+    check_expected("level 1 REGION_CLAMP of (0, 60)", GsPixelPipeline::filter_texture(memory, state, 0.0f, 60.0f, 1.0f), 4 | (23 << 8));
+}
+
+/// Each pixel of a span selects its level by its own interpolated Q (LCM = 0).
+void test_span_pixels()
+{
+    static GsLocalMemory memory;
+    GsDrawState state = make_state();
+    fill_levels(memory, state);
+    state.lcm = false;
+    state.k = 0.0f;
+    state.l = 0;
+    state.mmin = 2;
+
+    // Q = 1, 0.75, 0.5, 0.25: LOD 0, 0.415, 1 and 2.
+    using namespace GsPixelPipeline;
+    Span span{};
+    span.count = 4;
+    span.values[ATTR_S] = 0.25f;
+    span.values[ATTR_T] = 0.25f;
+    span.values[ATTR_Q] = 1.0f;
+    span.steps[ATTR_Q] = -0.25f;
+    span.values[ATTR_A] = 0x80;
+
+    const uword expected[4] = {level_colour(0), level_colour(0), level_colour(1), level_colour(2)};
+    for (int i = 0; i < span.count; i++)
+    {
+        int r = 0x80, g = 0x80, b = 0x80, a = 0x80;
+        texture_pixel(memory, state, span, i, r, g, b, a);
+        const uword result = static_cast<uword>(r) | (g << 8) | (b << 16) | (static_cast<uword>(a) << 24);
+        check_expected("span pixel", result, expected[i]);
+    }
+}
+} // namespace
+
+int main()
+{
+    test_lod();
+    test_levels();
+    test_filter_selection();
+    test_level_coordinates();
+    test_span_pixels();
+
+    std::printf("GsTextureLod: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
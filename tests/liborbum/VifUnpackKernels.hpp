@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Common/Types/Primitive.hpp"
+
+/// UNPACK state, as VifUnpack::Job (see Controller/Ee/Vpu/Vif/VifUnpack.hpp),
+/// which is a different type in each build.
+struct VifUnpackJob
+{
+    ubyte* memory;
+    uword memory_mask;
+    uword address;
+    uword cl;
+    uword wl;
+    uword cycle;
+    uword vectors_remaining;
+    uword row[NUMBER_WORDS_IN_QWORD];
+    uword col[NUMBER_WORDS_IN_QWORD];
+    uword mask;
+};
+
+/// Runs the UNPACK kernel for the settings given (see VifUnpack::get_kernel()),
+/// returning the number of bytes consumed. Returns false through is_valid
+/// (with nothing done) if there is no kernel for the settings.
+#define VIF_UNPACK_DECLARE_KERNELS \
+    size_t unpack(const int vnvl, const bool usn, const int mode, const bool masked, VifUnpackJob& job, const ubyte* data, const size_t size, bool& is_valid);
+
+/// The kernels as built for SSE2 hosts (see VifUnpackKernelsSse2.cpp).
+namespace VifUnpackSse2
+{
+VIF_UNPACK_DECLARE_KERNELS
+}
+
+/// The kernels as built for other hosts (see VifUnpackKernelsScalar.cpp).
+namespace VifUnpackScalar
+{
+VIF_UNPACK_DECLARE_KERNELS
+}
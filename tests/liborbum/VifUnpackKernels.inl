@@ -0,0 +1,50 @@
+// Defines the kernel wrapper declared in VifUnpackKernels.hpp in the
+// namespace VIF_UNPACK_KERNELS_NAMESPACE, using VifUnpack as configured by
+// the including translation unit (see Common/Simd.hpp). VifUnpack is
+// included into an unnamed namespace, so the SSE2 and scalar builds of its
+// inline functions don't clash at link time.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "Common/Simd.hpp"
+
+#include "VifUnpackKernels.hpp"
+
+namespace
+{
+#include "Controller/Ee/Vpu/Vif/VifUnpack.hpp"
+}
+
+namespace VIF_UNPACK_KERNELS_NAMESPACE
+{
+size_t unpack(const int vnvl, const bool usn, const int mode, const bool masked, VifUnpackJob& job, const ubyte* data, const size_t size, bool& is_valid)
+{
+    const VifUnpack::Kernel kernel = VifUnpack::get_kernel(vnvl, usn, mode, masked);
+    is_valid = (kernel != nullptr);
+    if (!is_valid)
+        return 0;
+
+    VifUnpack::Job kernel_job;
+    kernel_job.memory = job.memory;
+    kernel_job.memory_mask = job.memory_mask;
+    kernel_job.address = job.address;
+    kernel_job.cl = job.cl;
+    kernel_job.wl = job.wl;
+    kernel_job.cycle = job.cycle;
+    kernel_job.vectors_remaining = job.vectors_remaining;
+    std::memcpy(kernel_job.row, job.row, sizeof(job.row));
+    std::memcpy(kernel_job.col, job.col, sizeof(job.col));
+    kernel_job.mask = job.mask;
+
+    const size_t consumed = kernel(kernel_job, data, size);
+
+    job.address = kernel_job.address;
+    job.cycle = kernel_job.cycle;
+    job.vectors_remaining = kernel_job.vectors_remaining;
+    std::memcpy(job.row, kernel_job.row, sizeof(job.row));
+    return consumed;
+}
+} // namespace VIF_UNPACK_KERNELS_NAMESPACE
@@ -0,0 +1,3 @@
+#define SIMD_SCALAR
+#define VIF_UNPACK_KERNELS_NAMESPACE VifUnpackScalar
+#include "VifUnpackKernels.inl"
@@ -0,0 +1,6 @@
+#define VIF_UNPACK_KERNELS_NAMESPACE VifUnpackSse2
+#include "VifUnpackKernels.inl"
+
+#if !defined(SIMD_SSE2)
+#error "The SSE2 kernels are not available on this host."
+#endif
@@ -0,0 +1,324 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "VifUnpackKernels.hpp"
+
+/// Checks the SSE2 build of each VifUnpack kernel against the scalar build,
+/// for all of the formats, sign extension, modes and masking, with random
+/// write cycle settings, registers, mask and input (including input running
+/// out part way through, and the kernel being resumed with the rest).
+/// A few known results are checked against both builds as well.
+
+namespace
+{
+/// VU data memory size used (in qwords), the address wraps around at the end.
+constexpr size_t NUMBER_MEMORY_QWORDS = 64;
+constexpr uword MEMORY_MASK = NUMBER_MEMORY_QWORDS * NUMBER_BYTES_IN_QWORD - 1;
+
+/// Number of randomised jobs per kernel.
+constexpr size_t NUMBER_RANDOM_JOBS = 200;
+
+/// Row and column register values used by the known results.
+constexpr uword ROW[NUMBER_WORDS_IN_QWORD] = {100, 200, 300, 400};
+constexpr uword COL[NUMBER_WORDS_IN_QWORD] = {1000, 2000, 3000, 4000};
+
+/// Value memory is filled with for the known results (left by protected fields).
+constexpr uword FILL = 0xEEEEEEEE;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Returns the size of an input vector in bytes (see VifUnpack::vector_size()).
+size_t vector_size(const int vnvl)
+{
+    return (vnvl == 0xF) ? 2 : (((vnvl >> 2) + 1) * (4 >> (vnvl & 0x3)));
+}
+
+/// Memory and job state of one build, for comparing after each kernel call.
+struct State
+{
+    std::vector<uword> memory;
+    VifUnpackJob job;
+    size_t consumed;
+};
+
+bool operator==(const State& x, const State& y)
+{
+    return (x.memory == y.memory)
+           && (x.consumed == y.consumed)
+           && (x.job.address == y.job.address)
+           && (x.job.cycle == y.job.cycle)
+           && (x.job.vectors_remaining == y.job.vectors_remaining)
+           && (std::memcmp(x.job.row, y.job.row, sizeof(x.job.row)) == 0);
+}
+
+void print_state(const char* name, const State& state)
+{
+    std::printf("  %-8s consumed = %zu, address = 0x%X, cycle = %u, remaining = %u, row = %08X_%08X_%08X_%08X\n",
+                name, state.consumed, state.job.address, state.job.cycle, state.job.vectors_remaining,
+                state.job.row[3], state.job.row[2], state.job.row[1], state.job.row[0]);
+}
+
+/// Records the check, printing the details on the first few failures.
+void check(const char* what, const int vnvl, const bool usn, const int mode, const bool masked, const State& sse2, const State& scalar)
+{
+    number_checks++;
+    if (sse2 == scalar)
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf("%s (VNVL = 0x%X, USN = %d, MODE = %d, M = %d): SSE2 and scalar results differ.\n", what, vnvl, usn, mode, masked);
+        print_state("sse2", sse2);
+        print_state("scalar", scalar);
+        for (size_t i = 0; i < sse2.memory.size(); i++)
+        {
+            if (sse2.memory[i] != scalar.memory[i])
+                std::printf("  memory word %zu: sse2 = %08X, scalar = %08X\n", i, sse2.memory[i], scalar.memory[i]);
+        }
+    }
+}
+
+/// Runs the kernel on both builds from the same state, in 2 parts split at
+/// the input offset given, checking the builds against each other after each part.
+void run_random_job(const int vnvl, const bool usn, const int mode, const bool masked)
+{
+    State initial;
+    initial.memory.resize(NUMBER_MEMORY_QWORDS * NUMBER_WORDS_IN_QWORD);
+    for (auto& word : initial.memory)
+        word = static_cast<uword>(random());
+
+    VifUnpackJob& job = initial.job;
+    job.memory_mask = MEMORY_MASK;
+    job.address = static_cast<uword>(random() % NUMBER_MEMORY_QWORDS) * NUMBER_BYTES_IN_QWORD;
+    job.cl = 1 + static_cast<uword>(random() % 6);
+    job.wl = 1 + static_cast<uword>(random() % 6);
+    job.cycle = static_cast<uword>(random() % job.wl);
+    job.vectors_remaining = static_cast<uword>(random() % 24);
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        job.row[i] = static_cast<uword>(random());
+        job.col[i] = static_cast<uword>(random());
+    }
+    job.mask = static_cast<uword>(random());
+    initial.consumed = 0;
+
+    // Enough input for all of the vectors about 3/4 of the time.
+    const size_t size = vector_size(vnvl) * (random() % (job.vectors_remaining * 4 / 3 + 2));
+    std::vector<ubyte> data(size);
+    for (auto& byte : data)
+        byte = static_cast<ubyte>(random());
+    const size_t split = size ? (random() % (size + 1)) : 0;
+
+    State sse2 = initial;
+    State scalar = initial;
+    bool is_sse2_valid = false, is_scalar_valid = false;
+    for (int part = 0; part < 2; part++)
+    {
+        const size_t offset = part ? sse2.consumed : 0;
+        const size_t length = part ? (size - offset) : split;
+        sse2.job.memory = reinterpret_cast<ubyte*>(sse2.memory.data());
+        scalar.job.memory = reinterpret_cast<ubyte*>(scalar.memory.data());
+        sse2.consumed = offset + VifUnpackSse2::unpack(vnvl, usn, mode, masked, sse2.job, data.data() + offset, length, is_sse2_valid);
+        scalar.consumed = offset + VifUnpackScalar::unpack(vnvl, usn, mode, masked, scalar.job, data.data() + offset, length, is_scalar_valid);
+        check(part ? "resumed" : "first part", vnvl, usn, mode, masked, sse2, scalar);
+
+        if (is_sse2_valid != is_scalar_valid)
+        {
+            number_failures++;
+            std::printf("VNVL = 0x%X: kernel validity differs.\n", vnvl);
+        }
+        if (!is_sse2_valid)
+            return;
+    }
+}
+
+void test_sse2_against_scalar()
+{
+    for (int vnvl = 0; vnvl < 16; vnvl++)
+        for (const bool usn : {false, true})
+            for (int mode = 0; mode < 4; mode++)
+                for (const bool masked : {false, true})
+                    for (size_t i = 0; i < NUMBER_RANDOM_JOBS; i++)
+                        run_random_job(vnvl, usn, mode, masked);
+}
+
+/// Settings for a known result.
+struct Case
+{
+    const char* name;
+    int vnvl;
+    bool usn;
+    int mode;
+    bool masked;
+    uword cl;
+    uword wl;
+    uword vectors;
+    uword mask;
+    std::vector<ubyte> data;
+
+    /// The expected memory, from address 0, and row register afterwards.
+    std::vector<uword> expected;
+    std::vector<uword> expected_row;
+};
+
+/// Returns the words given as input bytes.
+std::vector<ubyte> words(const std::vector<uword>& values)
+{
+    std::vector<ubyte> data(values.size() * sizeof(uword));
+    std::memcpy(data.data(), values.data(), data.size());
+    return data;
+}
+
+void check_expected(const Case& c, const char* build, const State& state, const size_t size)
+{
+    number_checks++;
+
+    bool is_ok = (state.consumed == size) && (state.job.vectors_remaining == 0);
+    for (size_t i = 0; i < c.expected.size(); i++)
+        is_ok = is_ok && (state.memory[i] == c.expected[i]);
+    for (size_t i = 0; i < c.expected_row.size(); i++)
+        is_ok = is_ok && (state.job.row[i] == c.expected_row[i]);
+    if (is_ok)
+        return;
+
+    number_failures++;
+    std::printf("%s (%s): unexpected result.\n", c.name, build);
+    print_state("result", state);
+    for (size_t i = 0; i < c.expected.size(); i++)
+        std::printf("  memory word %zu: result = %08X, expected = %08X\n", i, state.memory[i], c.expected[i]);
+}
+
+void run_expected(const Case& c)
+{
+    State initial;
+    initial.memory.assign(NUMBER_MEMORY_QWORDS * NUMBER_WORDS_IN_QWORD, FILL);
+    VifUnpackJob& job = initial.job;
+    job.memory_mask = MEMORY_MASK;
+    job.address = 0;
+    job.cl = c.cl;
+    job.wl = c.wl;
+    job.cycle = 0;
+    job.vectors_remaining = c.vectors;
+    std::memcpy(job.row, ROW, sizeof(ROW));
+    std::memcpy(job.col, COL, sizeof(COL));
+    job.mask = c.mask;
+    initial.consumed = 0;
+
+    bool is_valid;
+    State sse2 = initial;
+    sse2.job.memory = reinterpret_cast<ubyte*>(sse2.memory.data());
+    sse2.consumed = VifUnpackSse2::unpack(c.vnvl, c.usn, c.mode, c.masked, sse2.job, c.data.data(), c.data.size(), is_valid);
+    check_expected(c, "sse2", sse2, c.data.size());
+
+    State scalar = initial;
+    scalar.job.memory = reinterpret_cast<ubyte*>(scalar.memory.data());
+    scalar.consumed = VifUnpackScalar::unpack(c.vnvl, c.usn, c.mode, c.masked, scalar.job, c.data.data(), c.data.size(), is_valid);
+    check_expected(c, "scalar", scalar, c.data.size());
+}
+
+/// Known results, for both builds. See EE Users Manual page 120 onwards.
+void test_expected_results()
+{
+    constexpr int S_8 = 0x2;
+    constexpr int V2_16 = 0x5;
+    constexpr int V4_32 = 0xC;
+    constexpr int V4_5 = 0xF;
+
+    // Mask settings for a write cycle, given for the x, y, z and w fields.
+    const auto mask_cycle = [](const uword x, const uword y, const uword z, const uword w) {
+        return x | (y << 2) | (z << 4) | (w << 6);
+    };
+
+    const Case cases[] = {
+        // V4-5: RGBA 5:5:5:1, each 5-bit element shifted up by 3 and A up by 7.
+        {"V4-5", V4_5, true, 0, false, 1, 1, 2, 0, {0x23, 0xFC, 0xFF, 0x7F}, {24, 8, 248, 128, 248, 248, 248, 0}, {}},
+
+        // Sign extension of S and V2 formats. S formats are broadcast, V2 written as xyxy.
+        {"S-8 signed", S_8, false, 0, false, 1, 1, 1, 0, {0x80}, {0xFFFFFF80, 0xFFFFFF80, 0xFFFFFF80, 0xFFFFFF80}, {}},
+        {"S-8 unsigned", S_8, true, 0, false, 1, 1, 1, 0, {0x80}, {0x80, 0x80, 0x80, 0x80}, {}},
+        {"V2-16 signed", V2_16, false, 0, false, 1, 1, 1, 0, {0xFF, 0xFF, 0x02, 0x00}, {0xFFFFFFFF, 2, 0xFFFFFFFF, 2}, {}},
+        {"V2-16 unsigned", V2_16, true, 0, false, 1, 1, 1, 0, {0xFF, 0xFF, 0x02, 0x00}, {0xFFFF, 2, 0xFFFF, 2}, {}},
+
+        // Offset mode: the row is added to each vector, and not changed.
+        {"offset", V4_32, false, 1, false, 1, 1, 2, 0, words({1, 2, 3, 4, 5, 6, 7, 8}), {101, 202, 303, 404, 105, 206, 307, 408}, {100, 200, 300, 400}},
+
+        // Difference mode: the row is added to each vector, and set to the result.
+        {"difference", V4_32, false, 2, false, 1, 1, 2, 0, words({1, 2, 3, 4, 1, 1, 1, 1}), {101, 202, 303, 404, 102, 203, 304, 405}, {102, 203, 304, 405}},
+
+        // The undefined mode is treated as no mode.
+        {"undefined mode", V4_32, false, 3, false, 1, 1, 1, 0, words({1, 2, 3, 4}), {1, 2, 3, 4}, {100, 200, 300, 400}},
+
+        // Skipping (CL > WL): WL qwords are written out of every CL.
+        {"skipping", V4_32, false, 0, false, 3, 1, 2, 0, words({1, 2, 3, 4, 5, 6, 7, 8}), {1, 2, 3, 4, FILL, FILL, FILL, FILL, FILL, FILL, FILL, FILL, 5, 6, 7, 8}, {}},
+
+        // Filling (CL < WL): the write cycles past CL read no input, and write the row.
+        {"filling", V4_32, false, 0, false, 1, 3, 3, 0, words({1, 2, 3, 4}), {1, 2, 3, 4, 100, 200, 300, 400, 100, 200, 300, 400}, {}},
+
+        // Masking, for write cycles 1 -> 6 (CL = WL = 6): data, row, column
+        // (C2), then the 4th mask row of column (C3), row, protected and data
+        // fields for write cycles 4 and on.
+        {"mask", S_8, true, 0, true, 6, 6, 6, mask_cycle(0, 0, 0, 0) | (mask_cycle(1, 1, 1, 1) << 8) | (mask_cycle(2, 2, 2, 2) << 16) | (mask_cycle(2, 1, 3, 0) << 24), {1, 2, 3, 4, 5, 6},
+         {1, 1, 1, 1,
+          100, 200, 300, 400,
+          3000, 3000, 3000, 3000,
+          4000, 200, FILL, 4,
+          4000, 200, FILL, 5,
+          4000, 200, FILL, 6},
+         {}},
+
+        // Masked filling: the data fields of a filling write are written with the row.
+        {"masked filling", V4_32, false, 0, true, 1, 2, 2, mask_cycle(0, 0, 0, 0) | (mask_cycle(0, 2, 3, 0) << 8), words({1, 2, 3, 4}), {1, 2, 3, 4, 100, 2000, FILL, 400}, {}},
+
+        // Masked difference mode: only the data fields update the row.
+        {"masked difference", V4_32, false, 2, true, 1, 1, 1, mask_cycle(0, 1, 2, 3), words({1, 2, 3, 4}), {101, 200, 1000, FILL}, {101, 200, 300, 400}},
+    };
+
+    for (const Case& c : cases)
+        run_expected(c);
+
+    // Running out of input part way through a vector, then resuming.
+    {
+        const std::vector<ubyte> data = words({1, 2, 3, 4, 5, 6, 7, 8});
+        for (const bool sse2 : {true, false})
+        {
+            std::vector<uword> memory(NUMBER_MEMORY_QWORDS * NUMBER_WORDS_IN_QWORD, FILL);
+            VifUnpackJob job = {reinterpret_cast<ubyte*>(memory.data()), MEMORY_MASK, 0, 1, 1, 0, 2, {}, {}, 0};
+            bool is_valid;
+            const auto unpack = sse2 ? &VifUnpackSse2::unpack : &VifUnpackScalar::unpack;
+            const size_t first = unpack(V4_32, false, 0, false, job, data.data(), 24, is_valid);
+            const bool is_first_ok = (first == 16) && (job.vectors_remaining == 1) && (memory[4] == FILL);
+            const size_t second = unpack(V4_32, false, 0, false, job, data.data() + first, data.size() - first, is_valid);
+            const bool is_second_ok = (second == 16) && (job.vectors_remaining == 0) && (memory[4] == 5) && (memory[7] == 8);
+
+            number_checks++;
+            if (!is_first_ok || !is_second_ok)
+            {
+                number_failures++;
+                std::printf("resume (%s): unexpected result (consumed %zu then %zu).\n", sse2 ? "sse2" : "scalar", first, second);
+            }
+        }
+    }
+}
+} // namespace
+
+int main()
+{
+    test_sse2_against_scalar();
+    test_expected_results();
+
+    std::printf("VifUnpack: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
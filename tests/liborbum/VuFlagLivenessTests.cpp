@@ -0,0 +1,491 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Controller/Ee/Vpu/Vu/VuFlagLiveness.hpp"
+#include "Resources/Ee/Vpu/Vu/VuInstruction.hpp"
+#include "Resources/Ee/Vpu/Vu/VuUnitRegisters.hpp"
+
+/// Checks the lazy VU flag registers and the flag liveness pass:
+///  - The deferred MAC/Status/Clipping updates against an eagerly updated
+///    model of the registers, over random interleavings of flag updates,
+///    CLIP judgements, reads and (partial) writes.
+///  - Running random micro program blocks with the dead flag updates
+///    skipped (see VuFlagLiveness::analyse()) against running them with all
+///    of the updates, comparing every flag read made by the block and the
+///    registers at the end of the block. The instructions are classified
+///    here by mnemonic, independently of the implementation indexes the
+///    pass uses.
+///  - The block lengths (see VuFlagLiveness::get_block_length()).
+
+namespace
+{
+/// Number of random operations on the registers, and random blocks run.
+constexpr size_t NUMBER_RANDOM_OPERATIONS = 2000000;
+constexpr size_t NUMBER_RANDOM_BLOCKS = 20000;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Returns a random float, biased towards small values so judgements go both ways.
+f32 random_float()
+{
+    return static_cast<f32>(static_cast<sword>(random() % 2001) - 1000) / 100.0f;
+}
+
+/// Records the check, printing the message on the first few failures.
+template <typename... Args>
+void check(const bool is_ok, const char* format, Args... args)
+{
+    number_checks++;
+    if (is_ok)
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf(format, args...);
+        std::printf("\n");
+    }
+}
+
+/// A VU unit's flag registers, linked up like RResources does.
+struct FlagRegisters
+{
+    VuUnitRegister_Mac mac;
+    VuUnitRegister_Status status;
+    VuUnitRegister_Clipping clipping;
+
+    FlagRegisters()
+    {
+        mac.status = &status;
+        status.mac = &mac;
+    }
+
+    FlagRegisters(const FlagRegisters&) = delete;
+    FlagRegisters& operator=(const FlagRegisters&) = delete;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Lazy registers against eager registers.
+
+/// Returns the Z, S, U, O summary of MAC flags, in the Status register layout.
+uword summarise(const uword flags)
+{
+    return ((flags & 0x000F) ? 0x1 : 0)
+           | ((flags & 0x00F0) ? 0x2 : 0)
+           | ((flags & 0x0F00) ? 0x4 : 0)
+           | ((flags & 0xF000) ? 0x8 : 0);
+}
+
+/// The flag registers as the VU Users Manual describes them (page 39),
+/// updated straight away.
+struct EagerRegisters
+{
+    uword mac = 0;
+    uword status = 0;
+    uword clipping = 0;
+
+    void update_vector_fields(const uhword flags)
+    {
+        mac = flags;
+        status = (status & ~0xFU) | summarise(flags) | (summarise(flags) << 6);
+    }
+
+    void add_judgement(const f32 x, const f32 y, const f32 z, const f32 w)
+    {
+        const uword bits = ((x < -w) ? 0x01 : 0)
+                           | ((x > w) ? 0x02 : 0)
+                           | ((y < -w) ? 0x04 : 0)
+                           | ((y > w) ? 0x08 : 0)
+                           | ((z < -w) ? 0x10 : 0)
+                           | ((z > w) ? 0x20 : 0);
+        clipping = ((clipping << 6) | bits) & 0x00FFFFFF;
+    }
+};
+
+void test_lazy_registers()
+{
+    FlagRegisters lazy;
+    EagerRegisters eager;
+
+    for (size_t i = 0; i < NUMBER_RANDOM_OPERATIONS; i++)
+    {
+        // Mostly updates, as in micro programs.
+        const udword operation = random() % 32;
+        if (operation < 12)
+        {
+            const uhword flags = static_cast<uhword>(random() & random());
+            lazy.mac.update_vector_fields(flags);
+            eager.update_vector_fields(flags);
+        }
+        else if (operation < 20)
+        {
+            const f32 x = random_float(), y = random_float(), z = random_float(), w = std::abs(random_float());
+            lazy.clipping.add_judgement(x, y, z, w);
+            eager.add_judgement(x, y, z, w);
+        }
+        else if (operation < 22)
+        {
+            const uword mac = lazy.mac.read_uword();
+            check(mac == eager.mac, "Operation %zu: MAC %04X, expected %04X.", i, mac, eager.mac);
+        }
+        else if (operation < 24)
+        {
+            const uword status = lazy.status.read_uword();
+            check(status == eager.status, "Operation %zu: Status %03X, expected %03X.", i, status, eager.status);
+        }
+        else if (operation < 25)
+        {
+            // Sub-word reads, ie: through the bus.
+            const uword status = lazy.status.read_ubyte(0);
+            check(status == (eager.status & 0xFF), "Operation %zu: Status byte %02X, expected %02X.", i, status, eager.status & 0xFF);
+            const uword mac = lazy.mac.read_uhword(0);
+            check(mac == (eager.mac & 0xFFFF), "Operation %zu: MAC hword %04X, expected %04X.", i, mac, eager.mac & 0xFFFF);
+        }
+        else if (operation < 27)
+        {
+            const uword clipping = (random() % 2) ? lazy.clipping.read_uword() : lazy.clipping.read_uhword(0) | (lazy.clipping.read_uhword(1) << 16);
+            check(clipping == eager.clipping, "Operation %zu: Clipping %06X, expected %06X.", i, clipping, eager.clipping);
+        }
+        else if (operation < 28)
+        {
+            // FSSET: a partial write of the sticky flags.
+            const uword sticky = static_cast<uword>(random()) & 0xFC0;
+            lazy.status.write_uword((lazy.status.read_uword() & 0x3F) | sticky);
+            eager.status = (eager.status & 0x3F) | sticky;
+        }
+        else if (operation < 29)
+        {
+            // CTC2 to Status and MAC (a byte write for the Status).
+            const ubyte status = static_cast<ubyte>(random());
+            lazy.status.write_ubyte(0, status);
+            eager.status = (eager.status & ~0xFFU) | status;
+            const uword mac = static_cast<uword>(random()) & 0xFFFF;
+            lazy.mac.write_uword(mac);
+            eager.mac = mac;
+        }
+        else if (operation < 30)
+        {
+            // FCSET, which discards pending judgements.
+            const uword clipping = static_cast<uword>(random()) & 0xFFFFFF;
+            lazy.clipping.write_uword(clipping);
+            eager.clipping = clipping;
+        }
+        else if (operation < 31)
+        {
+            // A partial Clipping write, which must apply pending judgements first.
+            const uhword clipping = static_cast<uhword>(random());
+            lazy.clipping.write_uhword(0, clipping);
+            eager.clipping = (eager.clipping & 0xFFFF0000) | clipping;
+        }
+        else
+        {
+            // Sticky-only updates, which have no effect on the MAC register.
+            const uhword flags = static_cast<uhword>(random() & random());
+            lazy.mac.update_sticky_fields(flags);
+            eager.status |= summarise(flags) << 6;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Flag liveness.
+
+/// Instruction classes, from the mnemonics (see VU Users Manual page 39).
+enum class Upper
+{
+    MAC, // Writes the MAC and Status flags.
+    CLIP,
+    OTHER
+};
+
+enum class Lower
+{
+    READS_MAC,
+    FSSET,
+    READS_CLIPPING,
+    FCSET,
+    BRANCH,
+    OTHER
+};
+
+bool starts_with(const std::string& value, const char* prefix)
+{
+    return value.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+Upper classify_upper(const std::string& mnemonic)
+{
+    for (const char* prefix : {"ADD", "SUB", "MUL", "MADD", "MSUB", "OPMULA", "OPMSUB"})
+        if (starts_with(mnemonic, prefix))
+            return Upper::MAC;
+    return (mnemonic == "CLIP") ? Upper::CLIP : Upper::OTHER;
+}
+
+Lower classify_lower(const std::string& mnemonic)
+{
+    if (mnemonic == "FSSET")
+        return Lower::FSSET;
+    if (mnemonic == "FSAND" || mnemonic == "FSEQ" || mnemonic == "FSOR" || mnemonic == "FMAND" || mnemonic == "FMEQ" || mnemonic == "FMOR")
+        return Lower::READS_MAC;
+    if (mnemonic == "FCAND" || mnemonic == "FCEQ" || mnemonic == "FCOR" || mnemonic == "FCGET")
+        return Lower::READS_CLIPPING;
+    if (mnemonic == "FCSET")
+        return Lower::FCSET;
+    if (mnemonic == "B" || mnemonic == "BAL" || mnemonic == "JR" || mnemonic == "JALR" || starts_with(mnemonic, "IB"))
+        return Lower::BRANCH;
+    return Lower::OTHER;
+}
+
+/// Encodings of each class of instruction, found by decoding random words.
+struct InstructionPools
+{
+    std::vector<uword> upper[3];
+    std::vector<uword> lower[6];
+};
+
+InstructionPools make_instruction_pools()
+{
+    InstructionPools pools;
+    for (size_t i = 0; i < 200000; i++)
+    {
+        // Upper instructions without the I, E, M, D and T bits (these are set separately).
+        const uword upper = static_cast<uword>(random()) & 0x07FFFFFF;
+        const uword lower = static_cast<uword>(random());
+        try
+        {
+            pools.upper[static_cast<int>(classify_upper(VuInstruction(upper).upper_lookup().mnemonic))].push_back(upper);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        try
+        {
+            pools.lower[static_cast<int>(classify_lower(VuInstruction(lower).lower_lookup().mnemonic))].push_back(lower);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+    return pools;
+}
+
+uword pick(const std::vector<uword>& pool)
+{
+    return pool[random() % pool.size()];
+}
+
+/// Returns a random block, ending in a branch (and its delay slot) or the E
+/// bit some of the time. Lower immediates (I bit) use flag instruction encodings,
+/// to check they aren't mistaken for the instructions.
+std::vector<udword> make_random_block(const InstructionPools& pools)
+{
+    const size_t length = 1 + random() % VuFlagLiveness::MAX_BLOCK_LENGTH;
+    std::vector<udword> pairs(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        const udword upper_class = random() % 8;
+        uword upper = pick(pools.upper[upper_class < 4 ? 0 : (upper_class < 6 ? 1 : 2)]);
+
+        const udword lower_class = random() % 16;
+        uword lower;
+        if (lower_class < 2)
+            lower = pick(pools.lower[static_cast<int>(Lower::READS_MAC)]);
+        else if (lower_class < 3)
+            lower = pick(pools.lower[static_cast<int>(Lower::FSSET)]);
+        else if (lower_class < 5)
+            lower = pick(pools.lower[static_cast<int>(Lower::READS_CLIPPING)]);
+        else if (lower_class < 6)
+            lower = pick(pools.lower[static_cast<int>(Lower::FCSET)]);
+        else
+            lower = pick(pools.lower[static_cast<int>(Lower::OTHER)]);
+
+        if (random() % 16 == 0)
+        {
+            upper |= VuFlagLiveness::UPPER_I_BIT;
+            lower = pick(pools.lower[static_cast<int>(random() % 2 ? Lower::READS_MAC : Lower::READS_CLIPPING)]);
+        }
+
+        pairs[i] = (static_cast<udword>(upper) << 32) | lower;
+    }
+
+    const udword ending = random() % 3;
+    if (ending == 0 && length >= 2)
+    {
+        const udword upper = (pairs[length - 2] >> 32) & ~VuFlagLiveness::UPPER_I_BIT;
+        pairs[length - 2] = (upper << 32) | pick(pools.lower[static_cast<int>(Lower::BRANCH)]);
+    }
+    else if (ending == 1 && length >= 2)
+        pairs[length - 2] |= static_cast<udword>(VuFlagLiveness::UPPER_E_BIT) << 32;
+
+    return pairs;
+}
+
+/// An operation made by the block, with its value: flag updates, judgements,
+/// and flag writes (which are the same for both runs), or flag reads.
+struct Operation
+{
+    uword mac_flags;
+    f32 judgement[4];
+    uword written;
+};
+
+/// Runs the block on the registers given, skipping the dead flag updates
+/// if liveness is given, and returns the flag values read by the block
+/// (then at the end of the block).
+std::vector<uword> run_block(const std::vector<udword>& pairs, const std::vector<Operation>& operations, const VuFlagLiveness::Liveness* liveness, FlagRegisters& registers)
+{
+    std::vector<uword> reads;
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        const Operation& operation = operations[i];
+        switch (classify_upper(VuFlagLiveness::get_upper(pairs[i]).upper_lookup().mnemonic))
+        {
+        case Upper::MAC:
+            if (!liveness || liveness[i].mac_live)
+                registers.mac.update_vector_fields(static_cast<uhword>(operation.mac_flags));
+            else
+                registers.mac.update_sticky_fields(static_cast<uhword>(operation.mac_flags));
+            break;
+        case Upper::CLIP:
+            if (!liveness || liveness[i].clipping_live)
+                registers.clipping.add_judgement(operation.judgement[0], operation.judgement[1], operation.judgement[2], operation.judgement[3]);
+            break;
+        default:
+            break;
+        }
+
+        if (!VuFlagLiveness::has_lower(pairs[i]))
+            continue;
+
+        switch (classify_lower(VuFlagLiveness::get_lower(pairs[i]).lower_lookup().mnemonic))
+        {
+        case Lower::READS_MAC:
+            reads.push_back(registers.mac.read_uword());
+            reads.push_back(registers.status.read_uword());
+            break;
+        case Lower::FSSET:
+            registers.status.write_uword((registers.status.read_uword() & 0x3F) | (operation.written & 0xFC0));
+            break;
+        case Lower::READS_CLIPPING:
+            reads.push_back(registers.clipping.read_uword());
+            break;
+        case Lower::FCSET:
+            registers.clipping.write_uword(operation.written & 0xFFFFFF);
+            break;
+        default:
+            break;
+        }
+    }
+
+    reads.push_back(registers.mac.read_uword());
+    reads.push_back(registers.status.read_uword());
+    reads.push_back(registers.clipping.read_uword());
+    return reads;
+}
+
+void test_liveness()
+{
+    const InstructionPools pools = make_instruction_pools();
+    for (const auto& pool : pools.upper)
+        check(!pool.empty(), "Missing upper instruction encodings.");
+    for (const auto& pool : pools.lower)
+        check(!pool.empty(), "Missing lower instruction encodings.");
+    if (number_failures)
+        return;
+
+    size_t number_dead_mac = 0, number_dead_clipping = 0;
+    for (size_t i = 0; i < NUMBER_RANDOM_BLOCKS; i++)
+    {
+        std::vector<udword> pairs = make_random_block(pools);
+        pairs.resize(VuFlagLiveness::get_block_length(pairs.data(), pairs.size()));
+
+        std::vector<Operation> operations(pairs.size());
+        for (auto& operation : operations)
+        {
+            operation.mac_flags = static_cast<uword>(random() & random()) & 0xFFFF;
+            for (int j = 0; j < 3; j++)
+                operation.judgement[j] = random_float();
+            operation.judgement[3] = std::abs(random_float());
+            operation.written = static_cast<uword>(random());
+        }
+
+        VuFlagLiveness::Liveness liveness[VuFlagLiveness::MAX_BLOCK_LENGTH];
+        VuFlagLiveness::analyse(pairs.data(), pairs.size(), liveness);
+        for (size_t j = 0; j < pairs.size(); j++)
+        {
+            number_dead_mac += !liveness[j].mac_live;
+            number_dead_clipping += !liveness[j].clipping_live;
+        }
+
+        // Both runs start from the same (random) register values.
+        FlagRegisters all, skipped;
+        const uword initial[3] = {static_cast<uword>(random()) & 0xFFFF, static_cast<uword>(random()) & 0xFFF, static_cast<uword>(random()) & 0xFFFFFF};
+        for (FlagRegisters* registers : {&all, &skipped})
+        {
+            registers->mac.write_uword(initial[0]);
+            registers->status.write_uword(initial[1]);
+            registers->clipping.write_uword(initial[2]);
+        }
+
+        const std::vector<uword> expected = run_block(pairs, operations, nullptr, all);
+        const std::vector<uword> result = run_block(pairs, operations, liveness, skipped);
+        check(result == expected, "Block %zu (%zu pairs): flag reads differ with the dead updates skipped.", i, pairs.size());
+    }
+
+    // The pass should find plenty of dead updates in random code.
+    check(number_dead_mac > NUMBER_RANDOM_BLOCKS && number_dead_clipping > NUMBER_RANDOM_BLOCKS / 10,
+          "Only %zu dead MAC updates and %zu dead CLIPs found.", number_dead_mac, number_dead_clipping);
+}
+
+/// Blocks end after the delay slot of a branch, or the pair after the E bit.
+void test_block_length()
+{
+    const InstructionPools pools = make_instruction_pools();
+    const uword nop = pick(pools.lower[static_cast<int>(Lower::OTHER)]);
+    const udword upper_nop = static_cast<udword>(pick(pools.upper[static_cast<int>(Upper::OTHER)])) << 32;
+
+    for (size_t position = 0; position < 80; position++)
+    {
+        std::vector<udword> pairs(100, upper_nop | nop);
+        const size_t expected = std::min<size_t>(position + 2, VuFlagLiveness::MAX_BLOCK_LENGTH);
+
+        pairs[position] = upper_nop | pick(pools.lower[static_cast<int>(Lower::BRANCH)]);
+        check(VuFlagLiveness::get_block_length(pairs.data(), pairs.size()) == expected, "Branch at %zu: unexpected block length.", position);
+
+        pairs[position] = upper_nop | (static_cast<udword>(VuFlagLiveness::UPPER_E_BIT) << 32) | nop;
+        check(VuFlagLiveness::get_block_length(pairs.data(), pairs.size()) == expected, "E bit at %zu: unexpected block length.", position);
+
+        // A branch encoding used as an immediate doesn't end the block.
+        pairs[position] = upper_nop | (static_cast<udword>(VuFlagLiveness::UPPER_I_BIT) << 32) | pick(pools.lower[static_cast<int>(Lower::BRANCH)]);
+        check(VuFlagLiveness::get_block_length(pairs.data(), pairs.size()) == VuFlagLiveness::MAX_BLOCK_LENGTH, "Immediate at %zu: unexpected block length.", position);
+
+        // Running out of pairs.
+        check(VuFlagLiveness::get_block_length(pairs.data(), 3) == 3, "3 pairs: unexpected block length.");
+    }
+}
+} // namespace
+
+int main()
+{
+    test_lazy_registers();
+    test_liveness();
+    test_block_length();
+
+    std::printf("VuFlagLiveness: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Common/Types/Primitive.hpp"
+
+/// Lists of the VuVector operations (see Controller/Ee/Vpu/Vu/VuVector.hpp),
+/// by signature. Vectors are passed as the raw bits of the 4 fields.
+#define VU_VECTOR_BINARY_KERNELS(X) \
+    X(add)                          \
+    X(sub)                          \
+    X(mul)                          \
+    X(max)                          \
+    X(min)
+
+#define VU_VECTOR_UNARY_KERNELS(X) \
+    X(abs)                         \
+    X(shuffle_yzx)                 \
+    X(shuffle_zxy)
+
+#define VU_VECTOR_DECLARE_BINARY(name) uqword name(const uqword& a, const uqword& b);
+#define VU_VECTOR_DECLARE_UNARY(name) uqword name(const uqword& a);
+
+/// to_ps2() returns the MAC flags through mac_flags, store() writes the
+/// dest fields of value over reg.
+#define VU_VECTOR_DECLARE_KERNELS                           \
+    VU_VECTOR_BINARY_KERNELS(VU_VECTOR_DECLARE_BINARY)      \
+    VU_VECTOR_UNARY_KERNELS(VU_VECTOR_DECLARE_UNARY)        \
+    uqword to_ps2(const uqword& a, uhword& mac_flags);      \
+    uqword store(const uqword& reg, const uqword& value, const ubyte dest);
+
+/// The operations as built for SSE2 hosts (see VuVectorKernelsSse2.cpp).
+namespace VuVectorSse2
+{
+VU_VECTOR_DECLARE_KERNELS
+}
+
+/// The operations as built for other hosts (see VuVectorKernelsScalar.cpp).
+namespace VuVectorScalar
+{
+VU_VECTOR_DECLARE_KERNELS
+}
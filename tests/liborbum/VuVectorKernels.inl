@@ -0,0 +1,62 @@
+// Defines the operations declared in VuVectorKernels.hpp in the namespace
+// VU_VECTOR_KERNELS_NAMESPACE, using VuVector as configured by the including
+// translation unit (see Common/Simd.hpp). VuVector is included into an
+// unnamed namespace, so the SSE2 and scalar builds of its inline functions
+// don't clash at link time. Its own includes are made outside of it first.
+
+#include <cstring>
+
+#include "Common/Constants.hpp"
+#include "Common/Simd.hpp"
+#include "Common/Types/FpuFlags.hpp"
+#include "Common/Types/Register/AlignedQwordRegister.hpp"
+#include "Utilities/Utilities.hpp"
+
+#include "VuVectorKernels.hpp"
+
+namespace
+{
+#include "Controller/Ee/Vpu/Vu/VuVector.hpp"
+}
+
+namespace VU_VECTOR_KERNELS_NAMESPACE
+{
+#define VU_VECTOR_DEFINE_BINARY(name)                                                         \
+    uqword name(const uqword& a, const uqword& b)                                             \
+    {                                                                                         \
+        const AlignedQwordRegister reg_a(a), reg_b(b);                                        \
+        AlignedQwordRegister result;                                                          \
+        VuVector::store(result, VuVector::name(VuVector::load(reg_a), VuVector::load(reg_b))); \
+        return result.read_uqword();                                                          \
+    }
+#define VU_VECTOR_DEFINE_UNARY(name)                                   \
+    uqword name(const uqword& a)                                       \
+    {                                                                  \
+        const AlignedQwordRegister reg_a(a);                           \
+        AlignedQwordRegister result;                                   \
+        VuVector::store(result, VuVector::name(VuVector::load(reg_a))); \
+        return result.read_uqword();                                   \
+    }
+
+VU_VECTOR_BINARY_KERNELS(VU_VECTOR_DEFINE_BINARY)
+VU_VECTOR_UNARY_KERNELS(VU_VECTOR_DEFINE_UNARY)
+
+uqword to_ps2(const uqword& a, uhword& mac_flags)
+{
+    const AlignedQwordRegister reg_a(a);
+    AlignedQwordRegister result;
+    VuVector::store(result, VuVector::to_ps2(VuVector::load(reg_a), mac_flags));
+    return result.read_uqword();
+}
+
+uqword store(const uqword& reg, const uqword& value, const ubyte dest)
+{
+    AlignedQwordRegister result(reg);
+    const AlignedQwordRegister reg_value(value);
+    VuVector::store(result, VuVector::load(reg_value), dest);
+    return result.read_uqword();
+}
+
+#undef VU_VECTOR_DEFINE_BINARY
+#undef VU_VECTOR_DEFINE_UNARY
+} // namespace VU_VECTOR_KERNELS_NAMESPACE
@@ -0,0 +1,3 @@
+#define SIMD_SCALAR
+#define VU_VECTOR_KERNELS_NAMESPACE VuVectorScalar
+#include "VuVectorKernels.inl"
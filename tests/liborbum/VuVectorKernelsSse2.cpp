@@ -0,0 +1,6 @@
+#define VU_VECTOR_KERNELS_NAMESPACE VuVectorSse2
+#include "VuVectorKernels.inl"
+
+#if !defined(SIMD_SSE2)
+#error "The SSE2 operations are not available on this host."
+#endif
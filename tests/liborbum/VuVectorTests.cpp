@@ -0,0 +1,288 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Common/Constants.hpp"
+#include "Utilities/Utilities.hpp"
+
+#include "VuVectorKernels.hpp"
+
+/// Checks the SSE2 build of the VuVector operations against the scalar
+/// build, and the formatting of both builds (to_ps2()) against to_ps2_float(),
+/// for vectors made up of the special float values (NaN, +/-Inf, denormals,
+/// +/-0 and +/-Fmax) followed by randomised vectors biased towards those values.
+/// A few known results are checked against both builds as well.
+
+namespace
+{
+constexpr uword FMAX_POS = Constants::EE::EECore::FPU::FMAX_POS;
+constexpr uword FMAX_NEG = Constants::EE::EECore::FPU::FMAX_NEG;
+constexpr uword ZERO_POS = Constants::EE::EECore::FPU::ZERO_POS;
+constexpr uword ZERO_NEG = Constants::EE::EECore::FPU::ZERO_NEG;
+
+/// Special field values (raw bits).
+const std::vector<uword> EDGE_VALUES = {
+    ZERO_POS, ZERO_NEG,         // +/-0.
+    0x00000001, 0x80000001,     // Smallest denormals.
+    0x007FFFFF, 0x807FFFFF,     // Largest denormals.
+    0x00800000, 0x80800000,     // Smallest normals.
+    FMAX_POS, FMAX_NEG,         // Maximum magnitude.
+    0x7F800000, 0xFF800000,     // +/-Inf.
+    0x7FC00000, 0xFFC00000,     // Quiet NaN's.
+    0x7F800001, 0xFFBFFFFF,     // Signalling NaN's.
+    0x3F800000, 0xBF800000,     // +/-1.
+    0x3F000000, 0x7F000000};    // 0.5, 2^127.
+
+/// Number of randomised inputs.
+constexpr size_t NUMBER_RANDOM_INPUTS = 100000;
+
+size_t number_checks = 0;
+size_t number_failures = 0;
+
+/// xorshift64, fixed seed so failures are reproducible.
+udword random_state = 0x9E3779B97F4A7C15;
+udword random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+uqword make_vector(const uword x, const uword y, const uword z, const uword w)
+{
+    uqword q;
+    q.uw[0] = x;
+    q.uw[1] = y;
+    q.uw[2] = z;
+    q.uw[3] = w;
+    return q;
+}
+
+/// Returns a vector with each field set to edges[(index + i) % size], so
+/// that all field positions see all of the special values.
+uqword make_edge_vector(const size_t index)
+{
+    uqword q;
+    for (size_t i = 0; i < 4; i++)
+        q.uw[i] = EDGE_VALUES[(index + i) % EDGE_VALUES.size()];
+    return q;
+}
+
+/// Returns a random vector, with each field having an even chance of being
+/// a special value instead. Random exponents are kept near the middle of the
+/// range half of the time, so the arithmetic doesn't always overflow.
+uqword make_random_vector()
+{
+    uqword q;
+    for (size_t i = 0; i < 4; i++)
+    {
+        uword value = static_cast<uword>(random());
+        if (random() & 1)
+            value = EDGE_VALUES[random() % EDGE_VALUES.size()];
+        else if (random() & 1)
+            value = (value & 0x807FFFFF) | ((0x70 + (value >> 24) % 0x20) << 23);
+        q.uw[i] = value;
+    }
+    return q;
+}
+
+/// All of the pairs of edge vectors, then random pairs.
+std::vector<std::pair<uqword, uqword>> make_inputs()
+{
+    std::vector<std::pair<uqword, uqword>> inputs;
+    for (size_t i = 0; i < EDGE_VALUES.size(); i++)
+        for (size_t j = 0; j < EDGE_VALUES.size(); j++)
+            inputs.emplace_back(make_edge_vector(i), make_edge_vector(j));
+    for (size_t i = 0; i < NUMBER_RANDOM_INPUTS; i++)
+        inputs.emplace_back(make_random_vector(), make_random_vector());
+    return inputs;
+}
+
+bool operator==(const uqword& x, const uqword& y)
+{
+    return (x.lo == y.lo) && (x.hi == y.hi);
+}
+
+void print_vector(const char* name, const uqword& q)
+{
+    std::printf("  %-8s x = %08X, y = %08X, z = %08X, w = %08X\n", name, q.uw[0], q.uw[1], q.uw[2], q.uw[3]);
+}
+
+/// Records the check, printing the details on the first few failures.
+void check(const char* operation, const uqword& a, const uqword& b, const uqword& sse2, const uqword& scalar, const uhword sse2_flags = 0, const uhword scalar_flags = 0)
+{
+    number_checks++;
+    if ((sse2 == scalar) && (sse2_flags == scalar_flags))
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf("%s: SSE2 and scalar results differ.\n", operation);
+        print_vector("a", a);
+        print_vector("b", b);
+        print_vector("sse2", sse2);
+        print_vector("scalar", scalar);
+        std::printf("  flags    sse2 = %04X, scalar = %04X\n", sse2_flags, scalar_flags);
+    }
+}
+
+void check_expected(const char* operation, const uqword& result, const uqword& expected, const uhword flags, const uhword expected_flags)
+{
+    number_checks++;
+    if ((result == expected) && (flags == expected_flags))
+        return;
+
+    if (number_failures++ < 20)
+    {
+        std::printf("%s: unexpected result.\n", operation);
+        print_vector("result", result);
+        print_vector("expected", expected);
+        std::printf("  flags    result = %04X, expected = %04X\n", flags, expected_flags);
+    }
+}
+
+/// Formats each field with to_ps2_float(), gathering the MAC flags in the dest layout.
+uqword to_ps2_expected(const uqword& a, uhword& mac_flags)
+{
+    uqword result;
+    mac_flags = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        f32 value;
+        std::memcpy(&value, &a.uw[i], sizeof(value));
+        FpuFlags flags;
+        value = to_ps2_float(value, flags);
+        std::memcpy(&result.uw[i], &value, sizeof(value));
+        const int field = 0x8 >> i;
+        mac_flags |= (flags.ZF ? field : 0) | (flags.SF ? field << 4 : 0) | (flags.UF ? field << 8 : 0) | (flags.OF ? field << 12 : 0);
+    }
+    return result;
+}
+
+/// Formats the value with both builds, checking them against to_ps2_float().
+void check_to_ps2(const char* operation, const uqword& value)
+{
+    uhword sse2_flags, scalar_flags, expected_flags;
+    const uqword sse2 = VuVectorSse2::to_ps2(value, sse2_flags);
+    const uqword scalar = VuVectorScalar::to_ps2(value, scalar_flags);
+    const uqword expected = to_ps2_expected(value, expected_flags);
+    check_expected(operation, sse2, expected, sse2_flags, expected_flags);
+    check_expected(operation, scalar, expected, scalar_flags, expected_flags);
+}
+
+/// Formats the results of both builds, and checks them against each other.
+void check_formatted(const char* operation, const uqword& a, const uqword& b, const uqword& sse2, const uqword& scalar)
+{
+    uhword sse2_flags, scalar_flags;
+    const uqword sse2_result = VuVectorSse2::to_ps2(sse2, sse2_flags);
+    const uqword scalar_result = VuVectorScalar::to_ps2(scalar, scalar_flags);
+    check(operation, a, b, sse2_result, scalar_result, sse2_flags, scalar_flags);
+}
+
+/// Formats the value with both builds, checking them against the expected result.
+void check_formatted_expected(const char* operation, const uqword& sse2, const uqword& scalar, const uqword& expected, const uhword expected_flags)
+{
+    uhword sse2_flags, scalar_flags;
+    const uqword sse2_result = VuVectorSse2::to_ps2(sse2, sse2_flags);
+    const uqword scalar_result = VuVectorScalar::to_ps2(scalar, scalar_flags);
+    check_expected(operation, sse2_result, expected, sse2_flags, expected_flags);
+    check_expected(operation, scalar_result, expected, scalar_flags, expected_flags);
+}
+
+void test_sse2_against_scalar(const std::vector<std::pair<uqword, uqword>>& inputs)
+{
+    for (const auto& input : inputs)
+    {
+        const uqword& a = input.first;
+        const uqword& b = input.second;
+
+        // Formatting of the inputs themselves.
+        check_to_ps2("to_ps2", a);
+
+        // The arithmetic results are only compared once formatted (as done by
+        // the VU), since the NaN produced when both operands are NaN's depends
+        // on the operand order the compiler picked for the scalar build.
+        check_to_ps2("to_ps2(add)", VuVectorSse2::add(a, b));
+        check_to_ps2("to_ps2(sub)", VuVectorSse2::sub(a, b));
+        check_to_ps2("to_ps2(mul)", VuVectorSse2::mul(a, b));
+        check_formatted("add", a, b, VuVectorSse2::add(a, b), VuVectorScalar::add(a, b));
+        check_formatted("sub", a, b, VuVectorSse2::sub(a, b), VuVectorScalar::sub(a, b));
+        check_formatted("mul", a, b, VuVectorSse2::mul(a, b), VuVectorScalar::mul(a, b));
+
+        // Max/min keep the operand order of std::max/std::min, including for NaN's and +/-0.
+        check("max", a, b, VuVectorSse2::max(a, b), VuVectorScalar::max(a, b));
+        check("min", a, b, VuVectorSse2::min(a, b), VuVectorScalar::min(a, b));
+
+#define VU_VECTOR_CHECK_UNARY(name) \
+    check(#name, a, a, VuVectorSse2::name(a), VuVectorScalar::name(a));
+
+        VU_VECTOR_UNARY_KERNELS(VU_VECTOR_CHECK_UNARY)
+
+#undef VU_VECTOR_CHECK_UNARY
+
+        for (ubyte dest = 0; dest < 16; dest++)
+            check("store", a, b, VuVectorSse2::store(a, b, dest), VuVectorScalar::store(a, b, dest));
+    }
+}
+
+/// Known results for the special values, for both builds.
+void test_expected_results()
+{
+    const uword one = 0x3F800000;
+    const uword two = 0x40000000;
+
+    struct Case
+    {
+        const char* name;
+        uqword value;
+        uqword expected;
+        uhword expected_flags;
+    };
+
+    const Case cases[] = {
+        // NaN's clamp to +/-Fmax with the O flag. The sign is the S flag (value < 0),
+        // which is never set for a NaN.
+        {"NaN", make_vector(0x7FC00000, 0xFFC00000, 0x7F800001, one), make_vector(FMAX_POS, FMAX_POS, FMAX_POS, one), 0xE000},
+        // +/-Inf clamp to +/-Fmax with the O flag (and S for -Inf).
+        {"Inf", make_vector(0x7F800000, 0xFF800000, one, one), make_vector(FMAX_POS, FMAX_NEG, one, one), 0xC040},
+        // Denormals flush to +/-0 with the U flag (and S when negative), but not the Z flag.
+        {"denormal", make_vector(0x00000001, 0x807FFFFF, one, one), make_vector(ZERO_POS, ZERO_NEG, one, one), 0x0C40},
+        // +/-0 keep their sign with the Z flag, -0 is not negative (no S flag).
+        {"zero", make_vector(ZERO_POS, ZERO_NEG, one, 0xBF800000), make_vector(ZERO_POS, ZERO_NEG, one, 0xBF800000), 0x001C},
+        // +/-Fmax are valid PS2 floats, left as is.
+        {"Fmax", make_vector(FMAX_POS, FMAX_NEG, 0x00800000, one), make_vector(FMAX_POS, FMAX_NEG, 0x00800000, one), 0x0040}};
+
+    for (const Case& c : cases)
+    {
+        check_formatted_expected(c.name, c.value, c.value, c.expected, c.expected_flags);
+    }
+
+    // Maximum magnitude results clamp instead of overflowing to +/-Inf.
+    {
+        const uqword fmax = make_vector(FMAX_POS, FMAX_NEG, FMAX_POS, one);
+        const uqword factor = make_vector(FMAX_POS, FMAX_POS, two, one);
+        const uqword expected = make_vector(FMAX_POS, FMAX_NEG, FMAX_POS, one);
+        check_formatted_expected("mul(Fmax)", VuVectorSse2::mul(fmax, factor), VuVectorScalar::mul(fmax, factor), expected, 0xE040);
+        const uqword expected_add = make_vector(FMAX_POS, FMAX_NEG, FMAX_POS, two);
+        check_formatted_expected("add(Fmax)", VuVectorSse2::add(fmax, fmax), VuVectorScalar::add(fmax, fmax), expected_add, 0xE040);
+    }
+
+    // Results underflowing to denormals flush to 0 with the U flag.
+    {
+        const uqword small = make_vector(0x00800000, 0x80800000, one, one);
+        const uqword half = make_vector(0x3F000000, 0x3F000000, one, one);
+        check_formatted_expected("mul(underflow)", VuVectorSse2::mul(small, half), VuVectorScalar::mul(small, half), make_vector(ZERO_POS, ZERO_NEG, one, one), 0x0C40);
+    }
+}
+} // namespace
+
+int main()
+{
+    test_sse2_against_scalar(make_inputs());
+    test_expected_results();
+
+    std::printf("VuVector: %zu checks, %zu failures.\n", number_checks, number_failures);
+    return number_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
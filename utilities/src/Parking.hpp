@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#include <Macros.hpp>
+
+#if defined(ENV_UNIX) && defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+/// Parking primitives, used to put threads to sleep after spinning for a while.
+/// Uses futexes on Linux, otherwise falls back to yielding.
+namespace Parking
+{
+/// Number of spin iterations before parking.
+/// Spinning is pointless (harmful even) on a single core host.
+inline int spin_count()
+{
+    static const int count = (std::thread::hardware_concurrency() > 1) ? 4096 : 0;
+    return count;
+}
+
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#endif
+}
+
+/// Blocks while the word is equal to the expected value, or until the timeout
+/// expires (a negative timeout waits indefinitely). May return spuriously.
+inline void wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected, const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1))
+{
+#if defined(ENV_UNIX) && defined(__linux__)
+    if (timeout.count() < 0)
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+    else
+    {
+        struct timespec relative_timeout;
+        relative_timeout.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        relative_timeout.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &relative_timeout, nullptr, 0);
+    }
+#else
+    (void)timeout;
+    if (word.load(std::memory_order_acquire) == expected)
+        std::this_thread::yield();
+#endif
+}
+
+/// Wakes all threads blocked on the word.
+inline void wake_all(std::atomic<std::uint32_t>& word)
+{
+#if defined(ENV_UNIX) && defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+/// Spins and then parks until the word differs from the given value.
+/// Returns the new value.
+inline std::uint32_t wait_for_change(std::atomic<std::uint32_t>& word, const std::uint32_t value)
+{
+    const int count = spin_count();
+    for (int i = 0; i < count; i++)
+    {
+        const std::uint32_t current = word.load(std::memory_order_acquire);
+        if (current != value)
+            return current;
+        cpu_relax();
+    }
+
+    std::uint32_t current;
+    while ((current = word.load(std::memory_order_acquire)) == value)
+        wait(word, value);
+    return current;
+}
+
+/// Wait/notify event for lock-free structures, where the waiting side blocks
+/// on a condition becoming true. Notifying is cheap when nobody is waiting
+/// (no syscall), as waiters flag themselves before parking, and only the
+/// first notify after that wakes them.
+/// The notifier must make the condition true before calling notify().
+class Event
+{
+public:
+    Event() :
+        sequence(0),
+        has_waiters(false)
+    {
+    }
+
+    /// Wakes any waiting threads.
+    void notify()
+    {
+        // Pairs with the waiter flagging itself before rechecking the
+        // condition - either the waiter sees the new state, or we see the flag.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (has_waiters.load(std::memory_order_relaxed) && has_waiters.exchange(false, std::memory_order_seq_cst))
+        {
+            sequence.fetch_add(1, std::memory_order_seq_cst);
+            wake_all(sequence);
+        }
+    }
+
+    /// Blocks until the condition returns true, or until the timeout expires
+    /// (a negative timeout waits indefinitely). Returns the last condition result.
+    template <typename ConditionFn>
+    bool wait_until(ConditionFn&& condition, const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1))
+    {
+        if (condition())
+            return true;
+        if (!timeout.count())
+            return false;
+
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::nanoseconds(0) : timeout);
+
+        // Spin for a while first.
+        const int count = spin_count();
+        for (int i = 0; i < count; i++)
+        {
+            cpu_relax();
+            if (condition())
+                return true;
+        }
+
+        while (true)
+        {
+            // Any notify after the sequence is read makes the wait return immediately.
+            const std::uint32_t current_sequence = sequence.load(std::memory_order_seq_cst);
+            has_waiters.store(true, std::memory_order_seq_cst);
+            if (condition())
+                return true;
+
+            std::chrono::nanoseconds remaining(-1);
+            if (!infinite)
+            {
+                remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+                if (remaining.count() <= 0)
+                    return condition();
+            }
+
+            wait(sequence, current_sequence, remaining);
+
+            if (condition())
+                return true;
+        }
+    }
+
+private:
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<bool> has_waiters;
+};
+} // namespace Parking
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 #include <condition_variable>
 
@@ -10,9 +16,7 @@
 
 #include <cereal/cereal.hpp>
 
-// TODO: the Mpsc/Spmc/Spsc classes are just Mpmc aliases...
-//       In order to support the "events" a mutex is needed
-//       anyway, even for simple cases like the Spsc queue.
+#include <Parking.hpp>
 
 /// MPMC blocking/try queue.
 /// Thread safe for all producers and consumers.
@@ -174,17 +178,267 @@ public:
     }
 };
 
+/// Bounded lock-free blocking/try queue, for a fixed producer/consumer shape.
+/// Based on Vyukov's bounded queue: each cell has a sequence number that
+/// tells producers and consumers whether it is free or filled for the current
+/// lap. A side that has only one thread just stores its position, while a
+/// side with multiple threads claims positions with a CAS.
+/// Blocking operations spin on the condition then park (see Parking::Event),
+/// so non-blocking operations never make a syscall unless a thread is waiting.
+template <typename ItemTy, size_t capacity, bool MultiProducer, bool MultiConsumer>
+class LockFreeQueue
+{
+public:
+    using SizeTy = size_t;
+
+    static constexpr std::chrono::nanoseconds ZERO_TIMEOUT = std::chrono::nanoseconds(0);
+    static constexpr std::chrono::nanoseconds INFINITE_TIMEOUT = std::chrono::nanoseconds(-1);
+
+    LockFreeQueue() :
+        enqueue_position(0),
+        dequeue_position(0),
+        cells(new Cell[capacity])
+#if defined(BUILD_DEBUG)
+        ,
+        contention_count(0)
+#endif
+    {
+        reset();
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /// Returns if at least n items are available for reading.
+    /// Exact when called from the consumer side of a single producer queue,
+    /// otherwise includes items still being written by other producers.
+    bool has_read_available(const SizeTy n_items = 1) const
+    {
+        return read_available() >= n_items;
+    }
+
+    /// Returns if at least n items are available for writing.
+    /// Conservative when called from the producer side (consumers may free more).
+    bool has_write_available(const SizeTy n_items = 1) const
+    {
+        return (capacity - read_available()) >= n_items;
+    }
+
+    bool is_empty() const
+    {
+        return !has_read_available();
+    }
+
+    bool is_full() const
+    {
+        return !has_write_available();
+    }
+
+    void wait_for_empty()
+    {
+        pop_event.wait_until([this] { return is_empty(); });
+    }
+
+    void wait_for_full()
+    {
+        push_event.wait_until([this] { return is_full(); });
+    }
+
+    /// Blocks until at least one item is available or the timeout expires.
+    bool wait_for_read_available(const std::chrono::nanoseconds timeout = INFINITE_TIMEOUT)
+    {
+        return push_event.wait_until([this] { return !is_empty(); }, timeout);
+    }
+
+    void pop(ItemTy& item)
+    {
+        push_event.wait_until([this, &item] { return try_pop_(item); });
+    }
+
+    bool try_pop(ItemTy& item, const std::chrono::nanoseconds timeout = ZERO_TIMEOUT)
+    {
+        return push_event.wait_until([this, &item] { return try_pop_(item); }, timeout);
+    }
+
+    void push(const ItemTy& item)
+    {
+        pop_event.wait_until([this, &item] { return try_push_(item); });
+    }
+
+    bool try_push(const ItemTy& item, const std::chrono::nanoseconds timeout = ZERO_TIMEOUT)
+    {
+        return pop_event.wait_until([this, &item] { return try_push_(item); }, timeout);
+    }
+
+    /// Not thread safe.
+    void reset()
+    {
+        for (SizeTy i = 0; i < capacity; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        enqueue_position.store(0, std::memory_order_relaxed);
+        dequeue_position.store(0, std::memory_order_relaxed);
+    }
+
+#if defined(BUILD_DEBUG)
+    /// Returns the number of times a CAS had to be retried due to another
+    /// thread on the same side.
+    size_t get_contention_count() const
+    {
+        return contention_count.load(std::memory_order_relaxed);
+    }
+#endif
+
+private:
+    struct Cell
+    {
+        std::atomic<SizeTy> sequence;
+        ItemTy item;
+    };
+
+    SizeTy read_available() const
+    {
+        const SizeTy dequeue = dequeue_position.load(std::memory_order_acquire);
+        const SizeTy enqueue = enqueue_position.load(std::memory_order_acquire);
+        return (enqueue > dequeue) ? (enqueue - dequeue) : 0;
+    }
+
+    /// Non-blocking push/pop attempts, which notify the push/pop event on success.
+    bool try_push_(const ItemTy& item)
+    {
+        SizeTy position = enqueue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells[position % capacity];
+            const SizeTy sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference < 0)
+                return false; // Full.
+
+            if (difference == 0)
+            {
+                // Only claim the cell up front when there are other producers,
+                // otherwise the position is published after the item (which
+                // keeps has_read_available() exact for the consumer).
+                if (!MultiProducer)
+                    break;
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+                count_contention();
+            }
+            else
+            {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        if (!MultiProducer)
+            enqueue_position.store(position + 1, std::memory_order_release);
+
+        push_event.notify();
+        return true;
+    }
+
+    bool try_pop_(ItemTy& item)
+    {
+        SizeTy position = dequeue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells[position % capacity];
+            const SizeTy sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference < 0)
+                return false; // Empty.
+
+            if (difference == 0)
+            {
+                if (!MultiConsumer)
+                    break;
+                if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+                count_contention();
+            }
+            else
+            {
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(cell->item);
+        cell->sequence.store(position + capacity, std::memory_order_release);
+        if (!MultiConsumer)
+            dequeue_position.store(position + 1, std::memory_order_release);
+
+        pop_event.notify();
+        return true;
+    }
+
+    void count_contention()
+    {
+#if defined(BUILD_DEBUG)
+        contention_count.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    alignas(64) std::atomic<SizeTy> enqueue_position;
+    alignas(64) std::atomic<SizeTy> dequeue_position;
+    std::unique_ptr<Cell[]> cells;
+
+    /// Signalled after each push (consumers wait on this) and after each pop
+    /// (producers wait on this).
+    Parking::Event push_event;
+    Parking::Event pop_event;
+
+#if defined(BUILD_DEBUG)
+    std::atomic<size_t> contention_count;
+#endif
+
+public:
+    template<class Archive>
+    void save(Archive & archive) const
+    {
+        const SizeTy dequeue = dequeue_position.load(std::memory_order_acquire);
+        size_t length = read_available();
+        std::vector<ItemTy> vec(length);
+
+        for (size_t i = 0; i < length; i++)
+            vec[i] = cells[(dequeue + i) % capacity].item;
+
+        archive(CEREAL_NVP(length));
+        archive.saveBinaryValue(vec.data(), vec.size(), "data");
+    }
+
+    template<class Archive>
+    void load(Archive & archive)
+    {
+        reset();
+
+        size_t length;
+        archive(CEREAL_NVP(length));
+
+        std::vector<ItemTy> vec(length);
+
+        archive.loadBinaryValue(vec.data(), vec.size(), "data");
+
+        for (const auto& item : vec)
+            try_push_(item);
+    }
+};
+
 /// MPSC blocking/try queue.
 /// Thread safe for all producers and only one consumer allowed.
 template <typename ItemTy, size_t capacity>
-using MpscQueue = MpmcQueue<ItemTy, capacity>;
+using MpscQueue = LockFreeQueue<ItemTy, capacity, true, false>;
 
 /// SPMC blocking/try queue.
 /// Thread safe for all consumers and only one producer allowed.
 template <typename ItemTy, size_t capacity>
-using SpmcQueue = MpmcQueue<ItemTy, capacity>;
+using SpmcQueue = LockFreeQueue<ItemTy, capacity, false, true>;
 
 /// SPSC blocking/try queue.
-/// No thread safety - only 1 producer and 1 consumer allowed.
+/// Only 1 producer and 1 consumer allowed (may be different threads).
 template <typename ItemTy, size_t capacity>
-using SpscQueue = MpmcQueue<ItemTy, capacity>;
+using SpscQueue = LockFreeQueue<ItemTy, capacity, false, false>;
@@ -10,10 +10,9 @@
 #include <string>
 #include <thread>
 
+#include <Parking.hpp>
 #include <Queues.hpp>
 
-#include <condition_variable>
-
 struct BusyCounter
 {
     BusyCounter() :
@@ -23,24 +22,18 @@ struct BusyCounter
 
     void operator++(int)
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter++;
-        lock.unlock();
-        busy_counter_cv.notify_all();
+        busy_counter.fetch_add(1, std::memory_order_acq_rel);
     }
 
     void operator--(int)
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter--;
-        lock.unlock();
-        busy_counter_cv.notify_all();
+        if (busy_counter.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            idle_event.notify();
     }
 
     void wait_for_idle()
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter_cv.wait(lock, [this] { return !busy_counter; });
+        idle_event.wait_until([this] { return !busy_counter.load(std::memory_order_acquire); });
     }
 
 private:
@@ -48,9 +41,8 @@ private:
     friend class Core;
 #endif
 
-    int busy_counter;
-    std::mutex busy_counter_mtx;
-    std::condition_variable busy_counter_cv;
+    std::atomic<int> busy_counter;
+    Parking::Event idle_event;
 };
 
 /// Executor/Thread synchronisation resources.
@@ -96,8 +88,15 @@ private:
     {
         while (!task_sync.exit && !local_exit)
         {
+            if (!task_sync.running_task_queue.wait_for_read_available(TIMEOUT))
+                continue;
+
+            // Mark as busy before popping, so the executor never sees an empty
+            // queue and idle workers while a task is in flight.
+            task_sync.thread_busy_counter++;
+
             std::function<void()> task_fn;
-            if (task_sync.running_task_queue.try_pop(task_fn, TIMEOUT, [this] { task_sync.thread_busy_counter++; }))
+            if (task_sync.running_task_queue.try_pop(task_fn))
             {
                 try
                 {
@@ -109,8 +108,9 @@ private:
                     std::string error_str(error.what());
                     task_sync.thread_error_queue.push(error_str);
                 }
-                task_sync.thread_busy_counter--;
             }
+
+            task_sync.thread_busy_counter--;
         }
     }
 
@@ -121,8 +121,21 @@ private:
     std::thread thread;
 };
 
+/// Common interface of the task executors (TaskExecutor, WorkStealingTaskExecutor),
+/// for users which don't depend on which one is in use.
+/// The executors are final, so calls through the concrete type are not virtual.
+class TaskExecutorBase
+{
+public:
+    virtual ~TaskExecutorBase() = default;
+
+    virtual void enqueue_task(const std::function<void()>& fn) = 0;
+    virtual void dispatch() = 0;
+    virtual void wait_for_idle() = 0;
+};
+
 /// Thread pool task executor.
-class TaskExecutor
+class TaskExecutor final : public TaskExecutorBase
 {
 public:
     TaskExecutor(const size_t thread_pool_size)
@@ -131,17 +144,17 @@ public:
             workers.push_back(std::make_unique<Worker>(task_sync));
     }
 
-    ~TaskExecutor()
+    ~TaskExecutor() override
     {
         task_sync.exit = true;
     }
 
-    void enqueue_task(const std::function<void()>& fn)
+    void enqueue_task(const std::function<void()>& fn) override
     {
         task_sync.pending_task_queue.push(fn);
     }
 
-    void dispatch()
+    void dispatch() override
     {
         while (!task_sync.pending_task_queue.is_empty())
         {
@@ -151,7 +164,7 @@ public:
         }
     }
 
-    void wait_for_idle()
+    void wait_for_idle() override
     {
         // Wait for empty running task queue.
         task_sync.running_task_queue.wait_for_empty();
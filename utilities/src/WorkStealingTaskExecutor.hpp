@@ -0,0 +1,312 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Parking.hpp>
+#include <TaskExecutor.hpp>
+
+/// Type erased void() functor with inline storage - never allocates.
+/// Functors that do not fit are rejected at compile time.
+class SmallTask
+{
+public:
+    static constexpr size_t STORAGE_SIZE = 64;
+
+    SmallTask() :
+        invoke_fn(nullptr),
+        destroy_fn(nullptr)
+    {
+    }
+
+    ~SmallTask()
+    {
+        reset();
+    }
+
+    SmallTask(const SmallTask&) = delete;
+    SmallTask& operator=(const SmallTask&) = delete;
+
+    void operator()()
+    {
+        invoke_fn(storage);
+    }
+
+    /// Destroys the current functor (if any).
+    void reset()
+    {
+        if (destroy_fn)
+            destroy_fn(storage);
+        invoke_fn = nullptr;
+        destroy_fn = nullptr;
+    }
+
+    /// Constructs a new functor in place, replacing the current one.
+    template <typename Fn>
+    void emplace(Fn&& fn)
+    {
+        using FnTy = typename std::decay<Fn>::type;
+        static_assert(sizeof(FnTy) <= STORAGE_SIZE, "Task functor too large for the inline storage.");
+        static_assert(alignof(FnTy) <= alignof(std::max_align_t), "Task functor alignment not supported.");
+
+        reset();
+        new (storage) FnTy(std::forward<Fn>(fn));
+        invoke_fn = [](void* object) { (*static_cast<FnTy*>(object))(); };
+        destroy_fn = [](void* object) { static_cast<FnTy*>(object)->~FnTy(); };
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+    void (*invoke_fn)(void*);
+    void (*destroy_fn)(void*);
+};
+
+/// Bounded Chase-Lev work stealing deque of task indices.
+/// The owner pushes and pops at the bottom, other threads steal from the top.
+/// push() must only be called by the owner (or while the owner is idle).
+class WorkStealingDeque
+{
+public:
+    WorkStealingDeque(const size_t capacity) :
+        top(0),
+        bottom(0),
+        mask(capacity - 1),
+        items(new std::atomic<std::uint32_t>[capacity])
+    {
+        if (capacity & mask)
+            throw std::runtime_error("WorkStealingDeque capacity must be a power of 2.");
+    }
+
+    /// Returns false if the deque is full.
+    bool push(const std::uint32_t item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        if ((b - t) > static_cast<std::int64_t>(mask))
+            return false;
+
+        items[b & mask].store(item, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(std::uint32_t& item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // Empty.
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = items[b & mask].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last item - race against stealers.
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    bool steal(std::uint32_t& item)
+    {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return false;
+
+        item = items[t & mask].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<std::int64_t> top;
+    alignas(64) std::atomic<std::int64_t> bottom;
+    const size_t mask;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> items;
+};
+
+/// Work stealing thread pool task executor, with the same interface as
+/// TaskExecutor (enqueue_task(), dispatch(), wait_for_idle()).
+/// Designed for frequent, short synchronisation periods:
+/// - Tasks are stored inline in a preallocated pool (see SmallTask), nothing is allocated per task.
+/// - On dispatch, tasks are distributed round robin over per-worker deques, and
+///   workers steal from each other once their own deque is empty.
+/// - Idle workers spin for a while before parking (futex) on the dispatch epoch.
+/// - wait_for_idle() waits on an atomic countdown of the active workers.
+/// Tasks may only be enqueued and dispatched from a single (the owning) thread.
+class WorkStealingTaskExecutor final : public TaskExecutorBase
+{
+public:
+    /// Maximum number of tasks per dispatch.
+    static constexpr size_t MAX_TASKS = 256;
+
+    WorkStealingTaskExecutor(const size_t thread_pool_size) :
+        tasks(MAX_TASKS),
+        number_tasks(0),
+        epoch(0),
+        active_workers(0),
+        exit(false),
+        has_error(false)
+    {
+        for (size_t i = 0; i < thread_pool_size; i++)
+            deques.push_back(std::make_unique<WorkStealingDeque>(MAX_TASKS));
+        for (size_t i = 0; i < thread_pool_size; i++)
+            threads.emplace_back(&WorkStealingTaskExecutor::main_thread_, this, i);
+    }
+
+    ~WorkStealingTaskExecutor() override
+    {
+        exit.store(true, std::memory_order_release);
+        epoch.fetch_add(1, std::memory_order_release);
+        Parking::wake_all(epoch);
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    template <typename Fn>
+    void enqueue_task(Fn&& fn)
+    {
+        if (number_tasks >= MAX_TASKS)
+            throw std::runtime_error("WorkStealingTaskExecutor: too many tasks enqueued.");
+        tasks[number_tasks++].emplace(std::forward<Fn>(fn));
+    }
+
+    void enqueue_task(const std::function<void()>& fn) override
+    {
+        enqueue_task<const std::function<void()>&>(fn);
+    }
+
+    void dispatch() override
+    {
+        if (!number_tasks)
+            return;
+
+        // No workers - run on the calling thread.
+        if (threads.empty())
+        {
+            for (size_t i = 0; i < number_tasks; i++)
+                run_task(static_cast<std::uint32_t>(i));
+            number_tasks = 0;
+            return;
+        }
+
+        // All workers are idle at this point (see wait_for_idle()), so it is
+        // safe to push on their behalf.
+        for (size_t i = 0; i < number_tasks; i++)
+            deques[i % deques.size()]->push(static_cast<std::uint32_t>(i));
+
+        active_workers.store(static_cast<std::uint32_t>(threads.size()), std::memory_order_relaxed);
+        epoch.fetch_add(1, std::memory_order_release);
+        Parking::wake_all(epoch);
+    }
+
+    void wait_for_idle() override
+    {
+        std::uint32_t remaining = active_workers.load(std::memory_order_acquire);
+        while (remaining)
+            remaining = Parking::wait_for_change(active_workers, remaining);
+
+        for (size_t i = 0; i < number_tasks; i++)
+            tasks[i].reset();
+        number_tasks = 0;
+
+        // Rethrow the first error on the current thread.
+        if (has_error.load(std::memory_order_acquire))
+        {
+            has_error.store(false, std::memory_order_relaxed);
+            error_claimed.clear(std::memory_order_relaxed);
+            throw std::runtime_error(error_str);
+        }
+    }
+
+private:
+    void main_thread_(const size_t index)
+    {
+        std::uint32_t seen_epoch = 0;
+        while (true)
+        {
+            seen_epoch = Parking::wait_for_change(epoch, seen_epoch);
+            if (exit.load(std::memory_order_acquire))
+                return;
+
+            // Run own tasks first, then try to steal from the others.
+            std::uint32_t task_index;
+            while (true)
+            {
+                if (deques[index]->pop(task_index))
+                {
+                    run_task(task_index);
+                    continue;
+                }
+
+                bool stolen = false;
+                for (size_t i = 1; i < deques.size() && !stolen; i++)
+                    stolen = deques[(index + i) % deques.size()]->steal(task_index);
+                if (!stolen)
+                    break;
+
+                run_task(task_index);
+            }
+
+            // Countdown barrier - the last worker wakes the waiting thread.
+            if (active_workers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Parking::wake_all(active_workers);
+        }
+    }
+
+    void run_task(const std::uint32_t task_index)
+    {
+        try
+        {
+            tasks[task_index]();
+        }
+        catch (const std::exception& error)
+        {
+            // Only the first error is kept, see wait_for_idle().
+            if (!error_claimed.test_and_set(std::memory_order_acq_rel))
+            {
+                error_str = error.what();
+                has_error.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    std::vector<SmallTask> tasks;
+    size_t number_tasks;
+
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+    std::vector<std::thread> threads;
+
+    /// Dispatch epoch, incremented on each dispatch (workers park on this).
+    std::atomic<std::uint32_t> epoch;
+
+    /// Number of workers still running tasks for the current epoch.
+    std::atomic<std::uint32_t> active_workers;
+
+    std::atomic<bool> exit;
+
+    std::atomic_flag error_claimed = ATOMIC_FLAG_INIT;
+    std::atomic<bool> has_error;
+    std::string error_str;
+};